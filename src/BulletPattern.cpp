@@ -0,0 +1,314 @@
+//
+//  BulletPattern.cpp
+//  SuperTerminal Framework - Bullet Pattern Emitters
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "BulletPattern.h"
+#include "FixedTimestep.h"
+#include <algorithm>
+#include <cmath>
+
+static const float TWO_PI = 6.28318530718f;
+
+BulletPatternField::BulletPatternField(SimulationRandom& random, size_t maxBullets)
+    : m_random(random), m_maxBullets(maxBullets) {
+    m_bullets.reserve(std::min(maxBullets, DEFAULT_MAX_BULLETS));
+}
+
+// =============================================================================
+// Emitters
+// =============================================================================
+
+uint32_t BulletPatternField::createEmitter(const BulletPatternDesc& desc, float x, float y) {
+    Emitter emitter;
+    emitter.id = m_nextEmitterId++;
+    if (m_nextEmitterId == 0) m_nextEmitterId = 1;
+    emitter.desc = desc;
+    emitter.desc.count = std::max<uint16_t>(1, desc.count);
+    emitter.desc.interval = std::max(MIN_INTERVAL, desc.interval);
+    emitter.x = x;
+    emitter.y = y;
+    emitter.targetX = x + 1.0f;
+    emitter.targetY = y;
+    emitter.angle = desc.angle;
+    emitter.rotationSpeed = desc.rotationSpeed;
+    emitter.speed = desc.speed;
+    emitter.timer = std::max(0.0f, desc.delay);
+    emitter.volleysFired = 0;
+    emitter.paused = false;
+    m_emitters.push_back(emitter);
+    return emitter.id;
+}
+
+BulletPatternField::Emitter* BulletPatternField::findEmitter(uint32_t emitterId) {
+    for (Emitter& emitter : m_emitters) {
+        if (emitter.id == emitterId) return &emitter;
+    }
+    return nullptr;
+}
+
+const BulletPatternField::Emitter* BulletPatternField::findEmitter(uint32_t emitterId) const {
+    for (const Emitter& emitter : m_emitters) {
+        if (emitter.id == emitterId) return &emitter;
+    }
+    return nullptr;
+}
+
+bool BulletPatternField::destroyEmitter(uint32_t emitterId) {
+    auto it = std::find_if(m_emitters.begin(), m_emitters.end(),
+                           [emitterId](const Emitter& e) { return e.id == emitterId; });
+    if (it == m_emitters.end()) {
+        return false;
+    }
+    m_emitters.erase(it);
+    return true;
+}
+
+bool BulletPatternField::setEmitterPosition(uint32_t emitterId, float x, float y) {
+    Emitter* emitter = findEmitter(emitterId);
+    if (!emitter) return false;
+    emitter->x = x;
+    emitter->y = y;
+    return true;
+}
+
+bool BulletPatternField::setEmitterTarget(uint32_t emitterId, float x, float y) {
+    Emitter* emitter = findEmitter(emitterId);
+    if (!emitter) return false;
+    emitter->targetX = x;
+    emitter->targetY = y;
+    return true;
+}
+
+bool BulletPatternField::setEmitterPaused(uint32_t emitterId, bool paused) {
+    Emitter* emitter = findEmitter(emitterId);
+    if (!emitter) return false;
+    emitter->paused = paused;
+    return true;
+}
+
+bool BulletPatternField::isEmitterActive(uint32_t emitterId) const {
+    const Emitter* emitter = findEmitter(emitterId);
+    return emitter && !emitter->paused;
+}
+
+// =============================================================================
+// Simulation
+// =============================================================================
+
+void BulletPatternField::advanceRotation(Emitter& emitter, float seconds) {
+    // Exact for constant angular acceleration
+    emitter.angle += emitter.rotationSpeed * seconds + 0.5f * emitter.desc.rotationAccel * seconds * seconds;
+    emitter.rotationSpeed += emitter.desc.rotationAccel * seconds;
+    if (emitter.angle > TWO_PI || emitter.angle < -TWO_PI) {
+        emitter.angle = std::fmod(emitter.angle, TWO_PI);
+    }
+}
+
+void BulletPatternField::moveBullet(PatternBullet& bullet, float dt) {
+    if (bullet.turnRate != 0.0f) {
+        float c = std::cos(bullet.turnRate * dt);
+        float s = std::sin(bullet.turnRate * dt);
+        float dx = bullet.dirX * c - bullet.dirY * s;
+        float dy = bullet.dirX * s + bullet.dirY * c;
+        bullet.dirX = dx;
+        bullet.dirY = dy;
+    }
+    if (bullet.acceleration != 0.0f) {
+        bullet.speed = std::min(bullet.maxSpeed, std::max(bullet.minSpeed, bullet.speed + bullet.acceleration * dt));
+    }
+    bullet.x += bullet.dirX * bullet.speed * dt;
+    bullet.y += bullet.dirY * bullet.speed * dt;
+    bullet.life -= dt;
+}
+
+void BulletPatternField::spawn(const Emitter& emitter, float angle, float remaining) {
+    if (m_bullets.size() >= m_maxBullets) {
+        m_totalDropped++;
+        return;
+    }
+
+    const BulletPatternDesc& desc = emitter.desc;
+    if (desc.jitter > 0.0f) {
+        angle += m_random.range(-desc.jitter, desc.jitter);
+    }
+
+    PatternBullet bullet;
+    bullet.x = emitter.x;
+    bullet.y = emitter.y;
+    bullet.dirX = std::cos(angle);
+    bullet.dirY = std::sin(angle);
+    bullet.speed = std::min(desc.maxSpeed, std::max(desc.minSpeed, emitter.speed));
+    bullet.acceleration = desc.acceleration;
+    bullet.turnRate = desc.turnRate;
+    bullet.minSpeed = desc.minSpeed;
+    bullet.maxSpeed = desc.maxSpeed;
+    bullet.life = desc.lifetime;
+    bullet.radius = desc.radius;
+    bullet.color = desc.color;
+    bullet.emitter = emitter.id;
+    bullet.owner = desc.owner;
+    bullet.damage = desc.damage;
+
+    // Fired part way through the step: draw from the muzzle, simulate the rest
+    bullet.previousX = bullet.x;
+    bullet.previousY = bullet.y;
+    moveBullet(bullet, remaining);
+
+    m_bullets.push_back(bullet);
+    m_totalSpawned++;
+}
+
+void BulletPatternField::fireVolley(Emitter& emitter, float remaining) {
+    const BulletPatternDesc& desc = emitter.desc;
+    int count = desc.count;
+
+    switch (desc.shape) {
+        case BulletPatternShape::Ring:
+        case BulletPatternShape::Spiral: {
+            float step = TWO_PI / count;
+            for (int i = 0; i < count; i++) {
+                spawn(emitter, emitter.angle + step * i, remaining);
+            }
+            break;
+        }
+
+        case BulletPatternShape::Fan:
+        case BulletPatternShape::Aimed: {
+            float centre = emitter.angle;
+            if (desc.shape == BulletPatternShape::Aimed) {
+                float dx = emitter.targetX - emitter.x;
+                float dy = emitter.targetY - emitter.y;
+                centre = (dx != 0.0f || dy != 0.0f) ? std::atan2(dy, dx) : emitter.angle;
+                centre += emitter.angle - desc.angle;   // Rotation still applies
+            }
+            if (count == 1) {
+                spawn(emitter, centre, remaining);
+                break;
+            }
+            float step = desc.spread / (count - 1);
+            float first = centre - desc.spread * 0.5f;
+            for (int i = 0; i < count; i++) {
+                spawn(emitter, first + step * i, remaining);
+            }
+            break;
+        }
+    }
+
+    emitter.speed += desc.speedStep;
+}
+
+void BulletPatternField::update(float dt) {
+    if (!(dt > 0.0f)) {
+        return;
+    }
+
+    // Existing bullets first; bullets fired this step move by their share only
+    size_t write = 0;
+    for (size_t read = 0; read < m_bullets.size(); read++) {
+        PatternBullet& bullet = m_bullets[read];
+        bullet.previousX = bullet.x;
+        bullet.previousY = bullet.y;
+        moveBullet(bullet, dt);
+        if (bullet.life <= 0.0f || bullet.x < m_minX || bullet.x > m_maxX ||
+            bullet.y < m_minY || bullet.y > m_maxY) {
+            continue;
+        }
+        if (write != read) {
+            m_bullets[write] = bullet;
+        }
+        write++;
+    }
+    m_bullets.resize(write);
+
+    for (size_t i = 0; i < m_emitters.size(); ) {
+        Emitter& emitter = m_emitters[i];
+        if (emitter.paused) {
+            i++;
+            continue;
+        }
+
+        float remaining = dt;
+        bool finished = false;
+        while (emitter.timer <= remaining) {
+            advanceRotation(emitter, emitter.timer);
+            remaining -= emitter.timer;
+            fireVolley(emitter, remaining);
+            emitter.timer = emitter.desc.interval;
+            if (emitter.desc.volleys > 0 && ++emitter.volleysFired >= emitter.desc.volleys) {
+                finished = true;
+                break;
+            }
+        }
+
+        if (finished) {
+            m_emitters.erase(m_emitters.begin() + i);
+            continue;
+        }
+        advanceRotation(emitter, remaining);
+        emitter.timer -= remaining;
+        i++;
+    }
+}
+
+int BulletPatternField::collideCircle(float x, float y, float radius, uint16_t ignoreOwner, bool remove) {
+    int hits = 0;
+    size_t write = 0;
+    for (size_t read = 0; read < m_bullets.size(); read++) {
+        const PatternBullet& bullet = m_bullets[read];
+        float dx = bullet.x - x;
+        float dy = bullet.y - y;
+        float reach = radius + bullet.radius;
+        bool hit = (ignoreOwner == 0 || bullet.owner != ignoreOwner) && dx * dx + dy * dy <= reach * reach;
+        if (hit) {
+            hits++;
+            if (remove) continue;
+        }
+        if (write != read) {
+            m_bullets[write] = bullet;
+        }
+        write++;
+    }
+    m_bullets.resize(write);
+    m_totalHits += hits;
+    return hits;
+}
+
+void BulletPatternField::setWorldBounds(float width, float height, float margin) {
+    m_minX = -margin;
+    m_minY = -margin;
+    m_maxX = width + margin;
+    m_maxY = height + margin;
+}
+
+void BulletPatternField::setMaxBullets(size_t maxBullets) {
+    m_maxBullets = maxBullets;
+    if (m_bullets.size() > maxBullets) {
+        m_bullets.resize(maxBullets);
+    }
+}
+
+BulletPatternStats BulletPatternField::getStats() const {
+    BulletPatternStats stats;
+    stats.totalSpawned = m_totalSpawned;
+    stats.totalDropped = m_totalDropped;
+    stats.totalHits = m_totalHits;
+    stats.liveBullets = (uint32_t)m_bullets.size();
+    stats.activeEmitters = 0;
+    for (const Emitter& emitter : m_emitters) {
+        if (!emitter.paused) stats.activeEmitters++;
+    }
+    return stats;
+}
+
+void BulletPatternField::clearBullets() {
+    m_bullets.clear();
+}
+
+void BulletPatternField::clear() {
+    m_bullets.clear();
+    m_emitters.clear();
+}
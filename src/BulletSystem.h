@@ -14,11 +14,15 @@
 #include <unordered_map>
 #include <memory>
 #include <Metal/Metal.h>
+#include <atomic>
 #include <chrono>
+#include <mutex>
+#include "BulletPattern.h"
 
 #pragma mark - Forward Declarations
 // Forward declarations to avoid header dependencies
 class SpriteLayer;
+class SimulationRandom;
 
 #pragma mark - Bullet Types and Constants
 
@@ -159,12 +163,30 @@ private:
     BulletSystemStats stats;
     std::chrono::high_resolution_clock::time_point last_update_time;
     
+    // Seeded "bullets" stream from the simulation scheduler (spread)
+    SimulationRandom& random;
+    
     // Sprite management (current mode)
     std::queue<uint16_t> available_sprite_ids;
     std::vector<uint16_t> allocated_sprite_ids;
     
-    // Future: Instanced rendering resources
-    id<MTLBuffer> instance_buffer;
+    // Pattern emitters and their bullets; scripts call in from the Lua
+    // thread while the simulation step and renderer run on the main thread
+    BulletPatternField patterns;
+    std::mutex pattern_mutex;
+    // World size: culls sprite bullets and maps pattern bullets onto the
+    // viewport (set from the Lua thread, read on the main thread)
+    std::atomic<float> world_width;
+    std::atomic<float> world_height;
+    
+    // Instanced rendering resources (pattern bullets). One instance buffer
+    // per frame in flight; the semaphore holds the CPU back from rewriting
+    // a buffer the GPU is still reading
+    static const int kMaxFramesInFlight = 3;
+    id<MTLBuffer> instance_buffers[kMaxFramesInFlight];
+    size_t instance_capacities[kMaxFramesInFlight];
+    int instance_frame;
+    dispatch_semaphore_t instance_semaphore;
     id<MTLRenderPipelineState> instanced_pipeline;
     id<MTLTexture> bullet_texture_atlas;
     
@@ -196,16 +218,27 @@ public:
     bool destroy_bullet(uint32_t bullet_id);
     void clear_all_bullets();
     
-    // Update and rendering
+    // Update and rendering (update is one fixed simulation step)
     void update(float delta_time);
     void render_sprites(void* encoder);  // Current sprite-based rendering
-    void render_instanced(void* encoder); // Future instanced rendering
+    void render_instanced(void* encoder, void* command_buffer); // Pattern bullets
     
     // Collision detection
     std::vector<BulletCollision> check_sprite_collisions(uint16_t sprite_id);
     std::vector<BulletCollision> check_area_collisions(float x, float y, float radius);
     std::vector<BulletCollision> check_all_collisions();  // Check all active bullets
     
+    // Pattern emitters (ring, spiral, fan, aimed)
+    uint32_t create_pattern(const BulletPatternDesc& desc, float x, float y);
+    bool destroy_pattern(uint32_t pattern_id);
+    bool move_pattern(uint32_t pattern_id, float x, float y);
+    bool aim_pattern(uint32_t pattern_id, float x, float y);
+    bool pause_pattern(uint32_t pattern_id, bool paused);
+    bool is_pattern_active(uint32_t pattern_id);
+    int check_pattern_hits(float x, float y, float radius, uint16_t ignore_owner);
+    BulletPatternStats get_pattern_stats();
+    void clear_patterns();
+    
     // Bullet queries
     bool is_bullet_active(uint32_t bullet_id);
     BulletData* get_bullet_data(uint32_t bullet_id);
@@ -258,6 +291,18 @@ extern "C" {
     // Configuration
     void bullet_set_world_bounds(float width, float height);
     void bullet_set_max_count(uint32_t max_bullets);
+    
+    // Pattern emitters - spawn and move bullets natively each simulation step
+    uint32_t bullet_pattern_create(const BulletPatternDesc* desc, float x, float y);
+    bool bullet_pattern_destroy(uint32_t pattern_id);
+    bool bullet_pattern_move(uint32_t pattern_id, float x, float y);
+    bool bullet_pattern_aim(uint32_t pattern_id, float target_x, float target_y);
+    bool bullet_pattern_pause(uint32_t pattern_id, bool paused);
+    bool bullet_pattern_is_active(uint32_t pattern_id);
+    int bullet_pattern_check_hits(float x, float y, float radius, uint16_t ignore_owner);
+    void bullet_pattern_get_stats(BulletPatternStats* stats);
+    void bullet_pattern_clear();
+    void bullet_system_render_patterns(void* encoder, void* command_buffer);
 }
 
 #pragma mark - Bullet Type Definitions for Different Weapons
@@ -7,6 +7,8 @@
 //
 
 #include "BulletSystem.h"
+#include "FixedTimestep.h"
+#import <simd/simd.h>
 #include <iostream>
 #include <cmath>
 #include <algorithm>
@@ -27,6 +29,7 @@ extern "C" {
 
 #pragma mark - Global Instance
 static BulletSystem* g_bullet_system = nullptr;
+static int g_bullet_step_handle = 0;
 
 #pragma mark - Bullet Presets
 namespace BulletPresets {
@@ -95,7 +98,14 @@ BulletSystem::BulletSystem(uint32_t max_bullets) :
     sprite_layer(nullptr),
     metal_device(nullptr),
     command_queue(nullptr),
-    instance_buffer(nullptr),
+    random(simulation_scheduler().getRandom("bullets")),
+    patterns(simulation_scheduler().getRandom("bullet_patterns")),
+    world_width(1024.0f),
+    world_height(768.0f),
+    instance_buffers{},
+    instance_capacities{},
+    instance_frame(0),
+    instance_semaphore(dispatch_semaphore_create(kMaxFramesInFlight)),
     instanced_pipeline(nullptr),
     bullet_texture_atlas(nullptr)
 {
@@ -115,6 +125,7 @@ BulletSystem::BulletSystem(uint32_t max_bullets) :
 
 BulletSystem::~BulletSystem() {
     shutdown();
+    dispatch_release(instance_semaphore);
 }
 
 bool BulletSystem::initialize(void* device, void* sprites) {
@@ -147,15 +158,7 @@ void BulletSystem::shutdown() {
     clear_all_bullets();
 
     // Release Metal resources
-    if (instance_buffer) {
-        [instance_buffer release];
-        instance_buffer = nullptr;
-    }
-
-    if (instanced_pipeline) {
-        [instanced_pipeline release];
-        instanced_pipeline = nullptr;
-    }
+    cleanup_instanced_rendering();
 
     if (bullet_texture_atlas) {
         [bullet_texture_atlas release];
@@ -255,7 +258,7 @@ uint32_t BulletSystem::fire_bullet(const BulletFireParams& params) {
 
     // Apply spread if specified
     if (params.spread_angle > 0.0f) {
-        float spread = (static_cast<float>(rand()) / RAND_MAX - 0.5f) * params.spread_angle;
+        float spread = (random.nextFloat() - 0.5f) * params.spread_angle;
         float cos_spread = std::cos(spread);
         float sin_spread = std::sin(spread);
 
@@ -388,13 +391,12 @@ void BulletSystem::update_bullet_rendering(Bullet& bullet) {
 }
 
 bool BulletSystem::is_bullet_off_screen(const Bullet& bullet) {
-    // TODO: Use actual world bounds instead of hardcoded values
-    const float SCREEN_WIDTH = 1024.0f;
-    const float SCREEN_HEIGHT = 768.0f;
     const float MARGIN = 100.0f;  // Allow bullets slightly off-screen
+    float width = world_width.load();
+    float height = world_height.load();
 
-    return (bullet.data.x < -MARGIN || bullet.data.x > SCREEN_WIDTH + MARGIN ||
-            bullet.data.y < -MARGIN || bullet.data.y > SCREEN_HEIGHT + MARGIN);
+    return (bullet.data.x < -MARGIN || bullet.data.x > width + MARGIN ||
+            bullet.data.y < -MARGIN || bullet.data.y > height + MARGIN);
 }
 
 void BulletSystem::update(float delta_time) {
@@ -442,6 +444,10 @@ void BulletSystem::update(float delta_time) {
         stats.active_bullets++;
         i++;
     }
+
+    // Pattern bullets are plain data; no sprite work per bullet
+    std::lock_guard<std::mutex> lock(pattern_mutex);
+    patterns.update(delta_time);
 }
 
 bool BulletSystem::destroy_bullet(uint32_t bullet_id) {
@@ -503,6 +509,55 @@ void BulletSystem::clear_all_bullets() {
 
     stats.active_bullets = 0;
     stats.total_destroyed += bullets.size();
+
+    clear_patterns();
+}
+
+#pragma mark - Pattern Emitters
+
+uint32_t BulletSystem::create_pattern(const BulletPatternDesc& desc, float x, float y) {
+    std::lock_guard<std::mutex> lock(pattern_mutex);
+    return patterns.createEmitter(desc, x, y);
+}
+
+bool BulletSystem::destroy_pattern(uint32_t pattern_id) {
+    std::lock_guard<std::mutex> lock(pattern_mutex);
+    return patterns.destroyEmitter(pattern_id);
+}
+
+bool BulletSystem::move_pattern(uint32_t pattern_id, float x, float y) {
+    std::lock_guard<std::mutex> lock(pattern_mutex);
+    return patterns.setEmitterPosition(pattern_id, x, y);
+}
+
+bool BulletSystem::aim_pattern(uint32_t pattern_id, float x, float y) {
+    std::lock_guard<std::mutex> lock(pattern_mutex);
+    return patterns.setEmitterTarget(pattern_id, x, y);
+}
+
+bool BulletSystem::pause_pattern(uint32_t pattern_id, bool paused) {
+    std::lock_guard<std::mutex> lock(pattern_mutex);
+    return patterns.setEmitterPaused(pattern_id, paused);
+}
+
+bool BulletSystem::is_pattern_active(uint32_t pattern_id) {
+    std::lock_guard<std::mutex> lock(pattern_mutex);
+    return patterns.isEmitterActive(pattern_id);
+}
+
+int BulletSystem::check_pattern_hits(float x, float y, float radius, uint16_t ignore_owner) {
+    std::lock_guard<std::mutex> lock(pattern_mutex);
+    return patterns.collideCircle(x, y, radius, ignore_owner, true);
+}
+
+BulletPatternStats BulletSystem::get_pattern_stats() {
+    std::lock_guard<std::mutex> lock(pattern_mutex);
+    return patterns.getStats();
+}
+
+void BulletSystem::clear_patterns() {
+    std::lock_guard<std::mutex> lock(pattern_mutex);
+    patterns.clear();
 }
 
 std::vector<BulletCollision> BulletSystem::check_sprite_collisions(uint16_t sprite_id) {
@@ -605,8 +660,15 @@ uint32_t BulletSystem::get_active_bullet_count() const {
 }
 
 void BulletSystem::set_world_bounds(float width, float height) {
-    // TODO: Store world bounds and use for off-screen detection
     std::cout << "BulletSystem: Set world bounds to " << width << "x" << height << std::endl;
+
+    if (width > 0.0f && height > 0.0f) {
+        world_width = width;
+        world_height = height;
+    }
+
+    std::lock_guard<std::mutex> lock(pattern_mutex);
+    patterns.setWorldBounds(width, height);
 }
 
 void BulletSystem::set_max_bullets(uint32_t max) {
@@ -622,9 +684,180 @@ void BulletSystem::render_sprites(void* encoder) {
     stats.render_calls_per_frame = 1;  // One call per frame for sprite mode
 }
 
-void BulletSystem::render_instanced(void* encoder) {
-    // TODO: Implement instanced rendering for high bullet counts
-    // This will be used when switching to RENDER_INSTANCED mode
+// Per-instance data for pattern bullets (matches the shader below)
+struct PatternBulletInstance {
+    simd_float2 position;
+    float radius;
+    uint32_t color;     // RGBA
+};
+
+static NSString* const kPatternBulletShader = @""
+    "#include <metal_stdlib>\n"
+    "using namespace metal;\n"
+    "\n"
+    "struct PatternBulletInstance {\n"
+    "    float2 position;\n"
+    "    float radius;\n"
+    "    uint color;\n"
+    "};\n"
+    "\n"
+    "struct PatternBulletOut {\n"
+    "    float4 position [[position]];\n"
+    "    float2 local;\n"
+    "    float4 color;\n"
+    "};\n"
+    "\n"
+    "constant float2 kCorners[6] = {\n"
+    "    float2(-1, -1), float2(1, -1), float2(1, 1),\n"
+    "    float2(-1, -1), float2(1, 1), float2(-1, 1)\n"
+    "};\n"
+    "\n"
+    "vertex PatternBulletOut pattern_bullet_vertex(uint vid [[vertex_id]],\n"
+    "                                              uint iid [[instance_id]],\n"
+    "                                              const device PatternBulletInstance* bullets [[buffer(0)]],\n"
+    "                                              constant float2& worldSize [[buffer(1)]]) {\n"
+    "    PatternBulletInstance bullet = bullets[iid];\n"
+    "    float2 local = kCorners[vid];\n"
+    "    float2 p = bullet.position + local * bullet.radius;\n"
+    "    PatternBulletOut out;\n"
+    "    // World coordinates stretched over the viewport, top-left origin (as sprites)\n"
+    "    out.position = float4(p.x / worldSize.x * 2.0 - 1.0, 1.0 - p.y / worldSize.y * 2.0, 0.0, 1.0);\n"
+    "    out.local = local;\n"
+    "    uint4 rgba = uint4(bullet.color >> 24, bullet.color >> 16, bullet.color >> 8, bullet.color) & 0xFFu;\n"
+    "    out.color = float4(rgba) / 255.0;\n"
+    "    return out;\n"
+    "}\n"
+    "\n"
+    "fragment float4 pattern_bullet_fragment(PatternBulletOut in [[stage_in]]) {\n"
+    "    float edge = 1.0 - smoothstep(0.7, 1.0, length(in.local));\n"
+    "    return float4(in.color.rgb, in.color.a * edge);\n"
+    "}\n";
+
+bool BulletSystem::init_instanced_rendering() {
+    if (instanced_pipeline) {
+        return true;
+    }
+    if (!metal_device) {
+        return false;
+    }
+
+    id<MTLDevice> device = (__bridge id<MTLDevice>)metal_device;
+    NSError* error = nil;
+    id<MTLLibrary> library = [device newLibraryWithSource:kPatternBulletShader options:nil error:&error];
+    if (!library) {
+        std::cout << "BulletSystem: ERROR - Pattern bullet shader failed: "
+                  << (error ? error.localizedDescription.UTF8String : "unknown") << std::endl;
+        return false;
+    }
+
+    id<MTLFunction> vertexFunction = [library newFunctionWithName:@"pattern_bullet_vertex"];
+    id<MTLFunction> fragmentFunction = [library newFunctionWithName:@"pattern_bullet_fragment"];
+
+    MTLRenderPipelineDescriptor* pipelineDesc = [[MTLRenderPipelineDescriptor alloc] init];
+    pipelineDesc.vertexFunction = vertexFunction;
+    pipelineDesc.fragmentFunction = fragmentFunction;
+    pipelineDesc.colorAttachments[0].pixelFormat = MTLPixelFormatBGRA8Unorm;
+    pipelineDesc.colorAttachments[0].blendingEnabled = YES;
+    pipelineDesc.colorAttachments[0].sourceRGBBlendFactor = MTLBlendFactorSourceAlpha;
+    pipelineDesc.colorAttachments[0].destinationRGBBlendFactor = MTLBlendFactorOneMinusSourceAlpha;
+    pipelineDesc.colorAttachments[0].sourceAlphaBlendFactor = MTLBlendFactorOne;
+    pipelineDesc.colorAttachments[0].destinationAlphaBlendFactor = MTLBlendFactorOneMinusSourceAlpha;
+
+    instanced_pipeline = [device newRenderPipelineStateWithDescriptor:pipelineDesc error:&error];
+
+    [pipelineDesc release];
+    [vertexFunction release];
+    [fragmentFunction release];
+    [library release];
+
+    if (!instanced_pipeline) {
+        std::cout << "BulletSystem: ERROR - Pattern bullet pipeline failed: "
+                  << (error ? error.localizedDescription.UTF8String : "unknown") << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void BulletSystem::cleanup_instanced_rendering() {
+    // Drain the frames still in flight before releasing their buffers
+    for (int i = 0; i < kMaxFramesInFlight; i++) {
+        dispatch_semaphore_wait(instance_semaphore, DISPATCH_TIME_FOREVER);
+    }
+    for (int i = 0; i < kMaxFramesInFlight; i++) {
+        if (instance_buffers[i]) {
+            [instance_buffers[i] release];
+            instance_buffers[i] = nullptr;
+        }
+        instance_capacities[i] = 0;
+        dispatch_semaphore_signal(instance_semaphore);
+    }
+
+    if (instanced_pipeline) {
+        [instanced_pipeline release];
+        instanced_pipeline = nullptr;
+    }
+}
+
+void BulletSystem::render_instanced(void* encoder, void* command_buffer) {
+    // Pattern bullets: one instanced draw for every live bullet
+    if (!encoder || !command_buffer || !init_instanced_rendering()) {
+        return;
+    }
+
+    // Claim a ring slot; blocks only while every slot is still on the GPU
+    dispatch_semaphore_wait(instance_semaphore, DISPATCH_TIME_FOREVER);
+
+    float alpha = (float)simulation_get_alpha();
+    std::lock_guard<std::mutex> lock(pattern_mutex);
+
+    const std::vector<PatternBullet>& live = patterns.getBullets();
+    if (live.empty()) {
+        dispatch_semaphore_signal(instance_semaphore);
+        return;
+    }
+
+    int slot = instance_frame;
+    if (live.size() > instance_capacities[slot]) {
+        if (instance_buffers[slot]) {
+            [instance_buffers[slot] release];
+        }
+        instance_capacities[slot] = std::max(live.size(), instance_capacities[slot] * 2);
+        id<MTLDevice> device = (__bridge id<MTLDevice>)metal_device;
+        instance_buffers[slot] = [device newBufferWithLength:sizeof(PatternBulletInstance) * instance_capacities[slot]
+                                                     options:MTLResourceStorageModeShared];
+        if (!instance_buffers[slot]) {
+            instance_capacities[slot] = 0;
+            dispatch_semaphore_signal(instance_semaphore);
+            return;
+        }
+    }
+    instance_frame = (instance_frame + 1) % kMaxFramesInFlight;
+
+    PatternBulletInstance* instances = (PatternBulletInstance*)[instance_buffers[slot] contents];
+    for (size_t i = 0; i < live.size(); i++) {
+        const PatternBullet& bullet = live[i];
+        instances[i].position = simd_make_float2(bullet.previousX + (bullet.x - bullet.previousX) * alpha,
+                                                 bullet.previousY + (bullet.y - bullet.previousY) * alpha);
+        instances[i].radius = bullet.radius;
+        instances[i].color = bullet.color;
+    }
+    simd_float2 worldSize = simd_make_float2(world_width.load(), world_height.load());
+
+    // Hand the slot back once the GPU has finished with this frame
+    dispatch_semaphore_t semaphore = instance_semaphore;
+    id<MTLCommandBuffer> commandBuffer = (__bridge id<MTLCommandBuffer>)command_buffer;
+    [commandBuffer addCompletedHandler:^(id<MTLCommandBuffer> completed) {
+        dispatch_semaphore_signal(semaphore);
+    }];
+
+    id<MTLRenderCommandEncoder> metalEncoder = (__bridge id<MTLRenderCommandEncoder>)encoder;
+    [metalEncoder setRenderPipelineState:instanced_pipeline];
+    [metalEncoder setVertexBuffer:instance_buffers[slot] offset:0 atIndex:0];
+    [metalEncoder setVertexBytes:&worldSize length:sizeof(worldSize) atIndex:1];
+    [metalEncoder drawPrimitives:MTLPrimitiveTypeTriangle
+                     vertexStart:0
+                     vertexCount:6
+                   instanceCount:live.size()];
 }
 
 #pragma mark - C Interface Implementation
@@ -636,11 +869,24 @@ bool bullet_system_initialize(void* metal_device, void* sprite_layer) {
     }
 
     g_bullet_system = new BulletSystem();
-    return g_bullet_system->initialize(metal_device, sprite_layer);
+    if (!g_bullet_system->initialize(metal_device, sprite_layer)) {
+        return false;
+    }
+
+    // Bullets move on the fixed simulation step driven by the render loop
+    g_bullet_step_handle = simulation_scheduler().registerStep("bullets", SIM_STEP_ORDER_BULLETS,
+        [](float dt, uint64_t) {
+            if (g_bullet_system) {
+                g_bullet_system->update(dt);
+            }
+        });
+    return true;
 }
 
 void bullet_system_shutdown() {
     if (g_bullet_system) {
+        simulation_scheduler().unregisterStep(g_bullet_step_handle);
+        g_bullet_step_handle = 0;
         delete g_bullet_system;
         g_bullet_system = nullptr;
     }
@@ -743,3 +989,55 @@ void bullet_set_max_count(uint32_t max_bullets) {
         g_bullet_system->set_max_bullets(max_bullets);
     }
 }
+
+uint32_t bullet_pattern_create(const BulletPatternDesc* desc, float x, float y) {
+    if (!g_bullet_system || !desc) return 0;
+    return g_bullet_system->create_pattern(*desc, x, y);
+}
+
+bool bullet_pattern_destroy(uint32_t pattern_id) {
+    if (!g_bullet_system) return false;
+    return g_bullet_system->destroy_pattern(pattern_id);
+}
+
+bool bullet_pattern_move(uint32_t pattern_id, float x, float y) {
+    if (!g_bullet_system) return false;
+    return g_bullet_system->move_pattern(pattern_id, x, y);
+}
+
+bool bullet_pattern_aim(uint32_t pattern_id, float target_x, float target_y) {
+    if (!g_bullet_system) return false;
+    return g_bullet_system->aim_pattern(pattern_id, target_x, target_y);
+}
+
+bool bullet_pattern_pause(uint32_t pattern_id, bool paused) {
+    if (!g_bullet_system) return false;
+    return g_bullet_system->pause_pattern(pattern_id, paused);
+}
+
+bool bullet_pattern_is_active(uint32_t pattern_id) {
+    if (!g_bullet_system) return false;
+    return g_bullet_system->is_pattern_active(pattern_id);
+}
+
+int bullet_pattern_check_hits(float x, float y, float radius, uint16_t ignore_owner) {
+    if (!g_bullet_system) return 0;
+    return g_bullet_system->check_pattern_hits(x, y, radius, ignore_owner);
+}
+
+void bullet_pattern_get_stats(BulletPatternStats* stats) {
+    if (!g_bullet_system || !stats) return;
+    *stats = g_bullet_system->get_pattern_stats();
+}
+
+void bullet_pattern_clear() {
+    if (g_bullet_system) {
+        g_bullet_system->clear_patterns();
+    }
+}
+
+void bullet_system_render_patterns(void* encoder, void* command_buffer) {
+    if (g_bullet_system) {
+        g_bullet_system->render_instanced(encoder, command_buffer);
+    }
+}
@@ -9,6 +9,8 @@
 #include "BulletSystemLua.h"
 #include "BulletSystem.h"
 #include <lua.hpp>
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
 #pragma mark - Bullet Type Constants
@@ -278,6 +280,181 @@ static int l_bullet_set_max_count(lua_State* L) {
     return 0;
 }
 
+#pragma mark - Pattern Emitters
+
+static float pattern_option(lua_State* L, int table, const char* name, float fallback) {
+    lua_getfield(L, table, name);
+    float value = lua_isnil(L, -1) ? fallback : (float)luaL_checknumber(L, -1);
+    lua_pop(L, 1);
+    return value;
+}
+
+/**
+ * Start a bullet pattern emitter
+ * Usage: pattern_id = bullet_pattern(shape, x, y, options)
+ * shape = "ring" | "spiral" | "fan" | "aimed"
+ * options = { count=12, interval=0.1, delay=0, volleys=0 (forever), angle=0, rotation_speed=0,
+ *             rotation_accel=0, spread=0.5, jitter=0, speed=200, speed_step=0, acceleration=0,
+ *             min_speed=0, max_speed=2000, turn=0, lifetime=6, radius=4, color=0xFFFFFFFF,
+ *             damage=1, owner=0, target_x, target_y }
+ * Angles are radians, 0 = right, positive = clockwise on screen
+ */
+static int l_bullet_pattern(lua_State* L) {
+    const char* shape = luaL_checkstring(L, 1);
+    float x = (float)luaL_checknumber(L, 2);
+    float y = (float)luaL_checknumber(L, 3);
+    
+    BulletPatternDesc desc;
+    if (strcmp(shape, "ring") == 0) {
+        desc.shape = BulletPatternShape::Ring;
+    } else if (strcmp(shape, "spiral") == 0) {
+        desc.shape = BulletPatternShape::Spiral;
+        desc.rotationSpeed = 1.0f;
+    } else if (strcmp(shape, "fan") == 0) {
+        desc.shape = BulletPatternShape::Fan;
+        desc.count = 5;
+    } else if (strcmp(shape, "aimed") == 0) {
+        desc.shape = BulletPatternShape::Aimed;
+        desc.count = 3;
+        desc.spread = 0.3f;
+    } else {
+        return luaL_error(L, "bullet_pattern: unknown shape '%s' (ring, spiral, fan, aimed)", shape);
+    }
+    
+    float target_x = x + 1.0f;
+    float target_y = y;
+    bool has_target = false;
+    
+    if (lua_gettop(L) >= 4 && lua_istable(L, 4)) {
+        desc.count = (uint16_t)std::max(1.0f, pattern_option(L, 4, "count", desc.count));
+        desc.interval = pattern_option(L, 4, "interval", desc.interval);
+        desc.delay = pattern_option(L, 4, "delay", desc.delay);
+        desc.volleys = (int)pattern_option(L, 4, "volleys", desc.volleys);
+        desc.angle = pattern_option(L, 4, "angle", desc.angle);
+        desc.rotationSpeed = pattern_option(L, 4, "rotation_speed", desc.rotationSpeed);
+        desc.rotationAccel = pattern_option(L, 4, "rotation_accel", desc.rotationAccel);
+        desc.spread = pattern_option(L, 4, "spread", desc.spread);
+        desc.jitter = pattern_option(L, 4, "jitter", desc.jitter);
+        desc.speed = pattern_option(L, 4, "speed", desc.speed);
+        desc.speedStep = pattern_option(L, 4, "speed_step", desc.speedStep);
+        desc.acceleration = pattern_option(L, 4, "acceleration", desc.acceleration);
+        desc.minSpeed = pattern_option(L, 4, "min_speed", desc.minSpeed);
+        desc.maxSpeed = pattern_option(L, 4, "max_speed", desc.maxSpeed);
+        desc.turnRate = pattern_option(L, 4, "turn", desc.turnRate);
+        desc.lifetime = pattern_option(L, 4, "lifetime", desc.lifetime);
+        desc.radius = pattern_option(L, 4, "radius", desc.radius);
+        desc.damage = (uint8_t)pattern_option(L, 4, "damage", desc.damage);
+        desc.owner = (uint16_t)pattern_option(L, 4, "owner", desc.owner);
+        
+        lua_getfield(L, 4, "color");
+        if (!lua_isnil(L, -1)) desc.color = (uint32_t)luaL_checknumber(L, -1);
+        lua_pop(L, 1);
+        
+        lua_getfield(L, 4, "target_x");
+        has_target = !lua_isnil(L, -1);
+        lua_pop(L, 1);
+        target_x = pattern_option(L, 4, "target_x", target_x);
+        target_y = pattern_option(L, 4, "target_y", target_y);
+    }
+    
+    uint32_t pattern_id = bullet_pattern_create(&desc, x, y);
+    if (pattern_id && has_target) {
+        bullet_pattern_aim(pattern_id, target_x, target_y);
+    }
+    
+    lua_pushinteger(L, pattern_id);
+    return 1;
+}
+
+/**
+ * Move an emitter
+ * Usage: bullet_pattern_move(pattern_id, x, y)
+ */
+static int l_bullet_pattern_move(lua_State* L) {
+    uint32_t pattern_id = (uint32_t)luaL_checkinteger(L, 1);
+    float x = (float)luaL_checknumber(L, 2);
+    float y = (float)luaL_checknumber(L, 3);
+    lua_pushboolean(L, bullet_pattern_move(pattern_id, x, y));
+    return 1;
+}
+
+/**
+ * Point an aimed emitter at a target (read at each volley)
+ * Usage: bullet_pattern_aim(pattern_id, target_x, target_y)
+ */
+static int l_bullet_pattern_aim(lua_State* L) {
+    uint32_t pattern_id = (uint32_t)luaL_checkinteger(L, 1);
+    float x = (float)luaL_checknumber(L, 2);
+    float y = (float)luaL_checknumber(L, 3);
+    lua_pushboolean(L, bullet_pattern_aim(pattern_id, x, y));
+    return 1;
+}
+
+/**
+ * Pause / resume / stop an emitter (its bullets keep flying)
+ * Usage: bullet_pattern_pause(pattern_id), bullet_pattern_resume(pattern_id), bullet_pattern_stop(pattern_id)
+ */
+static int l_bullet_pattern_pause(lua_State* L) {
+    uint32_t pattern_id = (uint32_t)luaL_checkinteger(L, 1);
+    lua_pushboolean(L, bullet_pattern_pause(pattern_id, true));
+    return 1;
+}
+
+static int l_bullet_pattern_resume(lua_State* L) {
+    uint32_t pattern_id = (uint32_t)luaL_checkinteger(L, 1);
+    lua_pushboolean(L, bullet_pattern_pause(pattern_id, false));
+    return 1;
+}
+
+static int l_bullet_pattern_stop(lua_State* L) {
+    uint32_t pattern_id = (uint32_t)luaL_checkinteger(L, 1);
+    lua_pushboolean(L, bullet_pattern_destroy(pattern_id));
+    return 1;
+}
+
+/**
+ * Check whether an emitter is still firing
+ * Usage: active = bullet_pattern_active(pattern_id)
+ */
+static int l_bullet_pattern_active(lua_State* L) {
+    uint32_t pattern_id = (uint32_t)luaL_checkinteger(L, 1);
+    lua_pushboolean(L, bullet_pattern_is_active(pattern_id));
+    return 1;
+}
+
+/**
+ * Remove pattern bullets touching a circle and count them
+ * Usage: hits = bullet_pattern_hits(x, y, radius, ignore_owner)
+ */
+static int l_bullet_pattern_hits(lua_State* L) {
+    float x = (float)luaL_checknumber(L, 1);
+    float y = (float)luaL_checknumber(L, 2);
+    float radius = (float)luaL_checknumber(L, 3);
+    uint16_t ignore_owner = (uint16_t)luaL_optinteger(L, 4, 0);
+    lua_pushinteger(L, bullet_pattern_check_hits(x, y, radius, ignore_owner));
+    return 1;
+}
+
+/**
+ * Get live pattern bullet count
+ * Usage: count = bullet_pattern_count()
+ */
+static int l_bullet_pattern_count(lua_State* L) {
+    BulletPatternStats stats = {};
+    bullet_pattern_get_stats(&stats);
+    lua_pushinteger(L, stats.liveBullets);
+    return 1;
+}
+
+/**
+ * Remove all emitters and pattern bullets
+ * Usage: bullet_pattern_clear()
+ */
+static int l_bullet_pattern_clear(lua_State* L) {
+    bullet_pattern_clear();
+    return 0;
+}
+
 #pragma mark - Bullet System Table Functions
 
 /**
@@ -407,6 +584,37 @@ void register_bullet_system_lua_api(lua_State* L) {
     lua_pushcfunction(L, l_bullet_set_max_count);
     lua_setglobal(L, "bullet_set_max_count");
     
+    // Pattern emitters
+    lua_pushcfunction(L, l_bullet_pattern);
+    lua_setglobal(L, "bullet_pattern");
+    
+    lua_pushcfunction(L, l_bullet_pattern_move);
+    lua_setglobal(L, "bullet_pattern_move");
+    
+    lua_pushcfunction(L, l_bullet_pattern_aim);
+    lua_setglobal(L, "bullet_pattern_aim");
+    
+    lua_pushcfunction(L, l_bullet_pattern_pause);
+    lua_setglobal(L, "bullet_pattern_pause");
+    
+    lua_pushcfunction(L, l_bullet_pattern_resume);
+    lua_setglobal(L, "bullet_pattern_resume");
+    
+    lua_pushcfunction(L, l_bullet_pattern_stop);
+    lua_setglobal(L, "bullet_pattern_stop");
+    
+    lua_pushcfunction(L, l_bullet_pattern_active);
+    lua_setglobal(L, "bullet_pattern_active");
+    
+    lua_pushcfunction(L, l_bullet_pattern_hits);
+    lua_setglobal(L, "bullet_pattern_hits");
+    
+    lua_pushcfunction(L, l_bullet_pattern_count);
+    lua_setglobal(L, "bullet_pattern_count");
+    
+    lua_pushcfunction(L, l_bullet_pattern_clear);
+    lua_setglobal(L, "bullet_pattern_clear");
+    
     // Register bullet type constants as globals
     lua_pushinteger(L, BULLET_NORMAL_LUA);
     lua_setglobal(L, "BULLET_NORMAL");
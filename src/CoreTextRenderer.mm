@@ -14,7 +14,13 @@
 #import <simd/simd.h>
 #include "TextCommon.h"
 #include "CoreTextRenderer.h"
+#include "ScrollbackIndex.h"
+#include "FrameArena.h"
 #import "TextGridManager.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
 
 
 // Global CRT effect states
@@ -47,9 +53,47 @@ static LayerState g_editor_state = {TEXT_MODE_80x50, 0, 0};    // Layer 6 - defa
 // Current text mode (shared for now, but layers can have independent modes)
 static TextMode g_current_text_mode = TEXT_MODE_64x44;
 
+// Scrollback search state for the terminal layer (Layer 5)
+// Rows are marked dirty as they are printed and re-shadowed lazily on search
+static ScrollbackIndex g_terminalSearchIndex(BUFFER_HEIGHT);
+static std::vector<ScrollbackMatch> g_terminalSearchHighlights;
+static int g_terminalSearchCurrent = -1;   // Index into highlights of the current match
+static std::string g_terminalSearchQuery;
+static bool g_terminalSearchIgnoreCase = false;
+static std::mutex g_terminalSearchMutex;
+static const simd_float4 kSearchHighlightPaper = {0.45f, 0.40f, 0.05f, 1.0f};
+static const simd_float4 kSearchCurrentPaper = {0.95f, 0.75f, 0.10f, 1.0f};
+
+// Keep search state aligned when the scrollback discards its oldest lines
+// (caller holds g_terminalSearchMutex)
+static void terminal_search_drop_lines(int lines) {
+    g_terminalSearchIndex.dropFront(lines);
+
+    std::vector<ScrollbackMatch> kept;
+    int current = -1;
+    for (size_t i = 0; i < g_terminalSearchHighlights.size(); i++) {
+        ScrollbackMatch match = g_terminalSearchHighlights[i];
+        match.line -= lines;
+        if (match.line < 0) continue;
+        if ((int)i == g_terminalSearchCurrent) current = (int)kept.size();
+        kept.push_back(match);
+    }
+    g_terminalSearchHighlights.swap(kept);
+    g_terminalSearchCurrent = current;
+}
+
 // External function to check REPL mode state
 extern "C" bool editor_is_repl_mode(void);
 extern "C" bool editor_is_active(void);
+extern "C" uint32_t superterminal_get_script_generation(void);
+
+// Script run that last wrote to the terminal layer or changed its colours
+// (0 = nothing since the last release)
+static std::atomic<uint32_t> g_terminalWriteGeneration{0};
+
+static void terminal_mark_written() {
+    g_terminalWriteGeneration.store(superterminal_get_script_generation());
+}
 
 // Glyph cache entry
 struct GlyphCacheEntry {
@@ -844,11 +888,25 @@ struct GlyphCacheEntry {
         self.textGrid[index].inkColor = self.currentInk;
         self.textGrid[index].paperColor = clearPaper;
     }
+
+    // Every visible row moved, so the search index re-reads them all
+    if (!self.isEditorLayer) {
+        std::lock_guard<std::mutex> searchLock(g_terminalSearchMutex);
+        for (int y = 0; y < GRID_HEIGHT; y++) {
+            g_terminalSearchIndex.markDirty(y);
+        }
+    }
 }
 
 - (void)print:(NSString*)text {
     NSUInteger length = [text length];
 
+    // Terminal output feeds the scrollback search index
+    std::unique_lock<std::mutex> searchLock(g_terminalSearchMutex, std::defer_lock);
+    if (!self.isEditorLayer) {
+        searchLock.lock();
+    }
+
     // Process character by character for proper terminal behavior
     for (NSUInteger i = 0; i < length; i++) {
         unichar ch = [text characterAtIndex:i];
@@ -871,6 +929,10 @@ struct GlyphCacheEntry {
                        0,
                        scrollAmount * BUFFER_WIDTH * sizeof(struct TextCell));
 
+                if (!self.isEditorLayer) {
+                    terminal_search_drop_lines(scrollAmount);
+                }
+
                 // Adjust cursor and viewport
                 self.cursorY = BUFFER_HEIGHT - scrollAmount;
                 if (self.viewportStartLine >= scrollAmount) {
@@ -894,6 +956,9 @@ struct GlyphCacheEntry {
             self.textGrid[index].character = ch;
             self.textGrid[index].inkColor = self.currentInk;
             self.textGrid[index].paperColor = self.currentPaper;
+            if (!self.isEditorLayer) {
+                g_terminalSearchIndex.markDirty(self.cursorY);
+            }
 
             // Advance cursor
             self.cursorX++;
@@ -912,6 +977,9 @@ struct GlyphCacheEntry {
                     memset(self.textGrid + (BUFFER_HEIGHT - scrollAmount) * BUFFER_WIDTH,
                            0,
                            scrollAmount * BUFFER_WIDTH * sizeof(struct TextCell));
+                    if (!self.isEditorLayer) {
+                        terminal_search_drop_lines(scrollAmount);
+                    }
                     self.cursorY = BUFFER_HEIGHT - scrollAmount;
                     if (self.viewportStartLine >= scrollAmount) {
                         self.viewportStartLine -= scrollAmount;
@@ -971,6 +1039,13 @@ struct GlyphCacheEntry {
     memset(self.textGrid, 0, BUFFER_WIDTH * BUFFER_HEIGHT * sizeof(struct TextCell));
     NSLog(@"CoreText: Buffer zeroed");
 
+    if (!self.isEditorLayer) {
+        std::lock_guard<std::mutex> searchLock(g_terminalSearchMutex);
+        g_terminalSearchIndex.clear();
+        g_terminalSearchHighlights.clear();
+        g_terminalSearchCurrent = -1;
+    }
+
     // Only initialize visible viewport with spaces (for rendering)
     int visibleCells = BUFFER_WIDTH * (self.viewportHeight > 0 ? self.viewportHeight : 60);
     NSLog(@"CoreText: Initializing %d visible cells", visibleCells);
@@ -1069,6 +1144,26 @@ struct GlyphCacheEntry {
     #define SEXTANT_BASE 0x1FB00
     #define SEXTANT_MAX  0x1FB3F
 
+    // Search highlights visible in this frame (1 = match, 2 = current match),
+    // built in frame scratch rather than the heap
+    FrameArenaScope frameScope;
+    FrameVector<uint8_t> highlightMask;
+    if (!self.isEditorLayer) {
+        std::lock_guard<std::mutex> searchLock(g_terminalSearchMutex);
+        for (size_t i = 0; i < g_terminalSearchHighlights.size(); i++) {
+            const ScrollbackMatch& match = g_terminalSearchHighlights[i];
+            if (match.line < bufferStartLine || match.line >= bufferEndLine) continue;
+            if (highlightMask.empty()) {
+                highlightMask.assign((size_t)(bufferEndLine - bufferStartLine) * BUFFER_WIDTH, 0);
+            }
+            uint8_t value = ((int)i == g_terminalSearchCurrent) ? 2 : 1;
+            int rowBase = (match.line - bufferStartLine) * BUFFER_WIDTH;
+            for (int col = match.column; col < match.column + match.length && col < BUFFER_WIDTH; col++) {
+                highlightMask[rowBase + col] = value;
+            }
+        }
+    }
+
     for (int bufferY = bufferStartLine; bufferY < bufferEndLine; bufferY++) {
         int screenY_idx = bufferY - bufferStartLine;  // Convert to screen coordinates
         if (screenY_idx < startRow || screenY_idx >= endRow) continue;
@@ -1204,10 +1299,16 @@ struct GlyphCacheEntry {
 
             // Skip background quad entirely if paper is transparent (alpha = 0)
             // This allows layers below to show through
-            if (cell->paperColor.w > 0.0f) {
+            simd_float4 cellPaper = cell->paperColor;
+            if (!highlightMask.empty()) {
+                uint8_t mark = highlightMask[screenY_idx * BUFFER_WIDTH + x];
+                if (mark) cellPaper = (mark == 2) ? kSearchCurrentPaper : kSearchHighlightPaper;
+            }
+
+            if (cellPaper.w > 0.0f) {
                 // Render full-cell background quad with paper color
                 // Use negative alpha as signal to shader that this is a background-only quad
-                simd_float4 bgPaperColor = cell->paperColor;
+                simd_float4 bgPaperColor = cellPaper;
                 // Negate the alpha to signal background-only rendering (preserve RGB values)
                 bgPaperColor.w = -fabs(bgPaperColor.w);
 
@@ -1278,6 +1379,10 @@ struct GlyphCacheEntry {
             float quadH = entry.atlasRect.size.height;
 
             simd_float4 paperColor = cell->paperColor;
+            if (!highlightMask.empty()) {
+                uint8_t mark = highlightMask[screenY_idx * BUFFER_WIDTH + x];
+                if (mark) paperColor = (mark == 2) ? kSearchCurrentPaper : kSearchHighlightPaper;
+            }
 
             // Debug logging disabled to reduce verbosity
             // (Enable if needed for debugging glyph rendering issues)
@@ -2018,6 +2123,7 @@ extern "C" {
     void coretext_terminal_print(const char* text) {
         @autoreleasepool {
             if (g_terminalTextLayer && text) {
+                terminal_mark_written();
                 NSString* nsText = [NSString stringWithUTF8String:text];
                 [g_terminalTextLayer print:nsText];
             }
@@ -2027,6 +2133,7 @@ extern "C" {
     void coretext_terminal_print_at(int x, int y, const char* text) {
         @autoreleasepool {
             if (g_terminalTextLayer && text) {
+                terminal_mark_written();
                 NSString* nsText = [NSString stringWithUTF8String:text];
                 [g_terminalTextLayer printAt:x y:y text:nsText];
             }
@@ -2049,6 +2156,23 @@ extern "C" {
         }
     }
 
+    // Clear the terminal and restore default colours if a run up to this
+    // generation wrote to it; the glyph atlas and scrollback buffer are kept
+    int coretext_terminal_release_generation(uint32_t generation) {
+        @autoreleasepool {
+            uint32_t written = g_terminalWriteGeneration.load();
+            if (!g_terminalTextLayer || written == 0 || written > generation) {
+                return 0;
+            }
+            [g_terminalTextLayer clear];
+            [g_terminalTextLayer home];
+            [g_terminalTextLayer setColor:simd_make_float4(1.0f, 1.0f, 1.0f, 1.0f)
+                                    paper:simd_make_float4(0.0f, 0.0f, 0.0f, 0.0f)];
+            g_terminalWriteGeneration.store(0);
+            return 1;
+        }
+    }
+
     void coretext_terminal_render(void* encoder, float width, float height) {
         @autoreleasepool {
             if (g_terminalTextLayer) {
@@ -2326,6 +2450,7 @@ extern "C" {
                                      float paper_r, float paper_g, float paper_b, float paper_a) {
         @autoreleasepool {
             if (g_terminalTextLayer) {
+                terminal_mark_written();
                 simd_float4 ink = simd_make_float4(ink_r, ink_g, ink_b, ink_a);
                 simd_float4 paper = simd_make_float4(paper_r, paper_g, paper_b, paper_a);
                 [g_terminalTextLayer setColor:ink paper:paper];
@@ -2336,6 +2461,7 @@ extern "C" {
     void coretext_terminal_set_ink(float r, float g, float b, float a) {
         @autoreleasepool {
             if (g_terminalTextLayer) {
+                terminal_mark_written();
                 simd_float4 ink = simd_make_float4(r, g, b, a);
                 [g_terminalTextLayer setInk:ink];
             }
@@ -2345,6 +2471,7 @@ extern "C" {
     void coretext_terminal_set_paper(float r, float g, float b, float a) {
         @autoreleasepool {
             if (g_terminalTextLayer) {
+                terminal_mark_written();
                 simd_float4 paper = simd_make_float4(r, g, b, a);
                 [g_terminalTextLayer setPaper:paper];
             }
@@ -2358,6 +2485,9 @@ extern "C" {
 
             if (targetLayer && x >= 0 && x < GRID_WIDTH && y >= 0 && y < GRID_HEIGHT) {
                 int index = y * GRID_WIDTH + x;
+                if (layer == 5) {
+                    terminal_mark_written();
+                }
 
                 float ink_r = ((ink_colour >> 16) & 0xFF) / 255.0f;
                 float ink_g = ((ink_colour >> 8) & 0xFF) / 255.0f;
@@ -2382,6 +2512,9 @@ extern "C" {
 
             if (targetLayer && x >= 0 && x < GRID_WIDTH && y >= 0 && y < GRID_HEIGHT) {
                 int index = y * GRID_WIDTH + x;
+                if (layer == 5) {
+                    terminal_mark_written();
+                }
 
                 float r = ((ink_colour >> 16) & 0xFF) / 255.0f;
                 float g = ((ink_colour >> 8) & 0xFF) / 255.0f;
@@ -2400,6 +2533,9 @@ extern "C" {
 
             if (targetLayer && x >= 0 && x < GRID_WIDTH && y >= 0 && y < GRID_HEIGHT) {
                 int index = y * GRID_WIDTH + x;
+                if (layer == 5) {
+                    terminal_mark_written();
+                }
 
                 float r = ((paper_colour >> 16) & 0xFF) / 255.0f;
                 float g = ((paper_colour >> 8) & 0xFF) / 255.0f;
@@ -2478,6 +2614,9 @@ extern "C" {
         @autoreleasepool {
             struct TextCell* grid = coretext_get_grid_pointer(layer);
             if (!grid) return;
+            if (layer == 5) {
+                terminal_mark_written();
+            }
 
             // Convert colors to float4
             simd_float4 inkColor = simd_make_float4(
@@ -2510,6 +2649,13 @@ extern "C" {
                     grid[index].paperColor = paperColor;
                 }
             }
+
+            if (layer == 5) {
+                std::lock_guard<std::mutex> searchLock(g_terminalSearchMutex);
+                for (int row = y; row < y2; row++) {
+                    g_terminalSearchIndex.markDirty(row);
+                }
+            }
         }
     }
 
@@ -2714,6 +2860,7 @@ extern "C" {
 
         int index = cell_y * grid_width + cell_x;
         struct TextCell* cell = &grid[index];
+        terminal_mark_written();
 
         // Get current pattern (default to empty if not sextant)
         uint32_t pattern = 0;
@@ -2731,6 +2878,10 @@ extern "C" {
         // Set new sextant character
         uint32_t new_char = SEXTANT_BASE + pattern;
         cell->character = new_char;
+        {
+            std::lock_guard<std::mutex> searchLock(g_terminalSearchMutex);
+            g_terminalSearchIndex.markDirty(cell_y);
+        }
 
         // Set ink/paper colors from current state
         CoreTextLayer* layer = g_terminalTextLayer;
@@ -2879,6 +3030,138 @@ extern "C" {
         }
     }
 
+    // Scrollback search
+    // Bring dirty rows of the terminal grid into the index (caller holds the search lock)
+    static void terminal_search_refresh_locked(CoreTextLayer* layer) {
+        struct TextCell* grid = layer.textGrid;
+        if (!grid || !g_terminalSearchIndex.hasDirtyLines()) return;
+
+        g_terminalSearchIndex.refreshDirty([grid](int line) {
+            uint32_t codepoints[BUFFER_WIDTH];
+            const struct TextCell* row = grid + line * BUFFER_WIDTH;
+            for (int x = 0; x < BUFFER_WIDTH; x++) {
+                codepoints[x] = row[x].character;
+            }
+            g_terminalSearchIndex.setLineCodepoints(line, codepoints, BUFFER_WIDTH);
+        });
+    }
+
+    // Recompute the highlighted match set when the query changes
+    static void terminal_search_set_query_locked(const char* query, bool ignore_case) {
+        if (g_terminalSearchQuery == query && g_terminalSearchIgnoreCase == ignore_case) return;
+
+        g_terminalSearchQuery = query;
+        g_terminalSearchIgnoreCase = ignore_case;
+        g_terminalSearchHighlights = g_terminalSearchIndex.findAll(query, ignore_case, 1000);
+        g_terminalSearchCurrent = -1;
+    }
+
+    // Mark the match as current, adding it if it lies beyond the highlight cap
+    static void terminal_search_select_locked(const ScrollbackMatch& match) {
+        for (size_t i = 0; i < g_terminalSearchHighlights.size(); i++) {
+            const ScrollbackMatch& m = g_terminalSearchHighlights[i];
+            if (m.line == match.line && m.column == match.column) {
+                g_terminalSearchCurrent = (int)i;
+                return;
+            }
+        }
+        g_terminalSearchHighlights.push_back(match);
+        g_terminalSearchCurrent = (int)g_terminalSearchHighlights.size() - 1;
+    }
+
+    static void terminal_search_reveal(CoreTextLayer* layer, int line) {
+        int top = [layer getViewportLine];
+        int height = [layer getViewportHeight];
+        if (line < top || line >= top + height) {
+            [layer scrollToLine:line - height / 2];
+        }
+    }
+
+    static bool terminal_search_step(const char* query, bool ignore_case, bool backwards,
+                                     int* out_line, int* out_column) {
+        @autoreleasepool {
+            CoreTextLayer* layer = g_terminalTextLayer;
+            if (!layer || !query || !query[0]) return false;
+
+            ScrollbackMatch match;
+            bool found;
+            {
+                std::lock_guard<std::mutex> searchLock(g_terminalSearchMutex);
+                terminal_search_refresh_locked(layer);
+
+                bool sameQuery = (g_terminalSearchQuery == query && g_terminalSearchIgnoreCase == ignore_case);
+                terminal_search_set_query_locked(query, ignore_case);
+
+                // Continue from the current match, otherwise from the viewport
+                int fromLine = [layer getViewportLine];
+                int fromColumn = 0;
+                if (sameQuery && g_terminalSearchCurrent >= 0) {
+                    const ScrollbackMatch& current = g_terminalSearchHighlights[g_terminalSearchCurrent];
+                    fromLine = current.line;
+                    fromColumn = backwards ? current.column : current.column + 1;
+                } else if (backwards) {
+                    fromLine += [layer getViewportHeight] - 1;
+                    fromColumn = -1;
+                }
+
+                found = backwards
+                    ? g_terminalSearchIndex.findPrevious(query, fromLine, fromColumn, ignore_case, true, match)
+                    : g_terminalSearchIndex.findNext(query, fromLine, fromColumn, ignore_case, true, match);
+                if (found) {
+                    terminal_search_select_locked(match);
+                }
+            }
+
+            if (!found) return false;
+
+            terminal_search_reveal(layer, match.line);
+            if (out_line) *out_line = match.line;
+            if (out_column) *out_column = match.column;
+            return true;
+        }
+    }
+
+    bool text_find_next(const char* query, bool ignore_case, int* out_line, int* out_column) {
+        return terminal_search_step(query, ignore_case, false, out_line, out_column);
+    }
+
+    bool text_find_previous(const char* query, bool ignore_case, int* out_line, int* out_column) {
+        return terminal_search_step(query, ignore_case, true, out_line, out_column);
+    }
+
+    int text_find_all(const char* query, bool ignore_case) {
+        @autoreleasepool {
+            CoreTextLayer* layer = g_terminalTextLayer;
+            if (!layer || !query) return 0;
+
+            std::lock_guard<std::mutex> searchLock(g_terminalSearchMutex);
+            terminal_search_refresh_locked(layer);
+            g_terminalSearchQuery = query;
+            g_terminalSearchIgnoreCase = ignore_case;
+            g_terminalSearchHighlights = g_terminalSearchIndex.findAll(query, ignore_case);
+            g_terminalSearchCurrent = -1;
+            return (int)g_terminalSearchHighlights.size();
+        }
+    }
+
+    bool text_get_find_match(int index, int* out_line, int* out_column, int* out_length) {
+        std::lock_guard<std::mutex> searchLock(g_terminalSearchMutex);
+        if (index < 0 || index >= (int)g_terminalSearchHighlights.size()) return false;
+
+        const ScrollbackMatch& match = g_terminalSearchHighlights[index];
+        if (out_line) *out_line = match.line;
+        if (out_column) *out_column = match.column;
+        if (out_length) *out_length = match.length;
+        return true;
+    }
+
+    void text_find_clear(void) {
+        std::lock_guard<std::mutex> searchLock(g_terminalSearchMutex);
+        g_terminalSearchHighlights.clear();
+        g_terminalSearchCurrent = -1;
+        g_terminalSearchQuery.clear();
+    }
+
     // Clear all chunky pixels (set all cells to empty sextant pattern)
     void chunky_clear(void) {
         // Log function entry
@@ -2891,6 +3174,7 @@ extern "C" {
 
         struct TextCell* grid = coretext_get_grid_buffer(5);  // Terminal layer
         if (!grid) return;
+        terminal_mark_written();
 
         int grid_width = coretext_get_grid_width();
         int grid_height = coretext_get_grid_height();
@@ -2908,6 +3192,11 @@ extern "C" {
                 grid[index].paperColor = paper;
             }
         }
+
+        std::lock_guard<std::mutex> searchLock(g_terminalSearchMutex);
+        for (int y = 0; y < grid_height; y++) {
+            g_terminalSearchIndex.markDirty(y);
+        }
     }
 
     // Draw a chunky pixel line using Bresenham's algorithm
@@ -0,0 +1,207 @@
+//
+//  EditorEditBatch.cpp
+//  SuperTerminal Framework - Batched Editor Edits
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "EditorEditBatch.h"
+#include <algorithm>
+#include <numeric>
+
+// ============================================================================
+// Building
+// ============================================================================
+
+void EditorEditBatch::insert(EditorPosition at, const std::string& text) {
+    m_edits.push_back(EditorEdit{at, at, text});
+}
+
+void EditorEditBatch::erase(EditorPosition start, EditorPosition end) {
+    m_edits.push_back(EditorEdit{start, end, std::string()});
+}
+
+void EditorEditBatch::replace(EditorPosition start, EditorPosition end, const std::string& text) {
+    m_edits.push_back(EditorEdit{start, end, text});
+}
+
+EditorEditBatch EditorEditBatch::replaceAll(const std::vector<std::string>& lines,
+                                            const std::string& find,
+                                            const std::string& replacement) {
+    EditorEditBatch batch;
+    if (find.empty() || find.find('\n') != std::string::npos) {
+        return batch;
+    }
+
+    for (int y = 0; y < (int)lines.size(); y++) {
+        size_t pos = lines[y].find(find);
+        while (pos != std::string::npos) {
+            batch.replace(EditorPosition{y, (int)pos},
+                          EditorPosition{y, (int)(pos + find.length())}, replacement);
+            pos = lines[y].find(find, pos + find.length());
+        }
+    }
+    return batch;
+}
+
+// ============================================================================
+// Applying
+// ============================================================================
+
+static EditorPosition clampPosition(EditorPosition p, const std::vector<std::string>& lines) {
+    p.line = std::max(0, std::min(p.line, (int)lines.size() - 1));
+    p.column = std::max(0, std::min(p.column, (int)lines[p.line].length()));
+    return p;
+}
+
+// Clamp edits to the document and order them by start position
+static std::vector<EditorEdit> orderEdits(const std::vector<EditorEdit>& source,
+                                          const std::vector<std::string>& lines,
+                                          std::vector<size_t>& order) {
+    std::vector<EditorEdit> edits = source;
+    for (auto& edit : edits) {
+        edit.start = clampPosition(edit.start, lines);
+        edit.end = clampPosition(edit.end, lines);
+        if (edit.end < edit.start) std::swap(edit.start, edit.end);
+    }
+    order.resize(edits.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return edits[a].start < edits[b].start;
+    });
+    return edits;
+}
+
+// Whether the source text in [start, end) is exactly `text`
+static bool rangeEquals(const std::vector<std::string>& lines,
+                        EditorPosition start, EditorPosition end, const std::string& text) {
+    size_t offset = 0;
+    for (int y = start.line; y <= end.line; y++) {
+        size_t from = (y == start.line) ? start.column : 0;
+        size_t to = (y == end.line) ? end.column : lines[y].length();
+        if (text.compare(offset, to - from, lines[y], from, to - from) != 0) {
+            return false;
+        }
+        offset += to - from;
+        if (y < end.line) {
+            if (offset >= text.length() || text[offset] != '\n') {
+                return false;
+            }
+            offset++;
+        }
+    }
+    return offset == text.length();
+}
+
+bool EditorEditBatch::changes(const std::vector<std::string>& lines) const {
+    if (lines.empty()) {
+        // apply() starts from a single empty line
+        for (const auto& edit : m_edits) {
+            if (!edit.text.empty()) return true;
+        }
+        return false;
+    }
+
+    std::vector<size_t> order;
+    std::vector<EditorEdit> edits = orderEdits(m_edits, lines, order);
+
+    // Same overlap rule as apply(): dropped edits change nothing
+    EditorPosition lastEnd{-1, 0};
+    bool first = true;
+    for (size_t index : order) {
+        const EditorEdit& edit = edits[index];
+        if (!first && edit.start < lastEnd) {
+            continue;
+        }
+        first = false;
+        if (!rangeEquals(lines, edit.start, edit.end, edit.text)) {
+            return true;
+        }
+        lastEnd = edit.end;
+    }
+    return false;
+}
+
+EditorBatchResult EditorEditBatch::apply(std::vector<std::string>& lines) const {
+    EditorBatchResult result;
+    result.carets.resize(m_edits.size());
+    if (m_edits.empty()) {
+        return result;
+    }
+    if (lines.empty()) {
+        lines.push_back("");
+    }
+
+    std::vector<size_t> order;
+    std::vector<EditorEdit> edits = orderEdits(m_edits, lines, order);
+
+    const int oldLineCount = (int)lines.size();
+    std::vector<std::string> out;
+    out.reserve(lines.size());
+    std::string current;                    // Output line under construction
+    EditorPosition source;                  // Next unconsumed source position
+
+    // Copy source text from `source` up to `to`; whole untouched lines are moved
+    auto copyTo = [&](EditorPosition to) {
+        while (source.line < to.line) {
+            if (source.column == 0 && current.empty()) {
+                out.push_back(std::move(lines[source.line]));
+            } else {
+                current.append(lines[source.line], source.column, std::string::npos);
+                out.push_back(std::move(current));
+                current.clear();
+            }
+            source.line++;
+            source.column = 0;
+        }
+        current.append(lines[source.line], source.column, to.column - source.column);
+        source.column = to.column;
+    };
+
+    EditorPosition lastEnd{-1, 0};
+    EditorPosition lastCaret;
+    bool first = true;
+    for (size_t index : order) {
+        const EditorEdit& edit = edits[index];
+        if (!first && edit.start < lastEnd) {
+            // Overlaps the previous edit's replaced range
+            result.carets[index] = lastCaret;
+            result.dropped++;
+            continue;
+        }
+        if (first) {
+            result.firstLine = edit.start.line;
+            first = false;
+        }
+
+        copyTo(edit.start);
+
+        size_t from = 0;
+        size_t newline;
+        while ((newline = edit.text.find('\n', from)) != std::string::npos) {
+            current.append(edit.text, from, newline - from);
+            out.push_back(std::move(current));
+            current.clear();
+            from = newline + 1;
+        }
+        current.append(edit.text, from, std::string::npos);
+
+        // Skip the replaced source range
+        source = edit.end;
+        lastEnd = edit.end;
+        lastCaret = EditorPosition{(int)out.size(), (int)current.length()};
+        result.carets[index] = lastCaret;
+        result.oldLastLine = edit.end.line;
+        result.newLastLine = lastCaret.line;
+        result.applied++;
+    }
+
+    // Remainder of the document
+    copyTo(EditorPosition{oldLineCount - 1, (int)lines[oldLineCount - 1].length()});
+    out.push_back(std::move(current));
+
+    lines.swap(out);
+    result.lineDelta = (int)lines.size() - oldLineCount;
+    return result;
+}
@@ -0,0 +1,83 @@
+//
+//  EditorEditBatch.h
+//  SuperTerminal Framework - Batched Editor Edits
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+//  Collects many range replacements against the editor's line vector and
+//  applies them in a single forward pass over the document. Multi-cursor
+//  typing and replace-all are built on this so N edits cost one rebuild,
+//  one undo record and one dirty-range update instead of N.
+//
+
+#ifndef EditorEditBatch_h
+#define EditorEditBatch_h
+
+#include <string>
+#include <vector>
+
+// Line/column position in the document (columns are bytes)
+struct EditorPosition {
+    int line = 0;
+    int column = 0;
+
+    bool operator<(const EditorPosition& other) const {
+        return line < other.line || (line == other.line && column < other.column);
+    }
+    bool operator==(const EditorPosition& other) const {
+        return line == other.line && column == other.column;
+    }
+};
+
+// Replace [start, end) with text; text may contain '\n'
+struct EditorEdit {
+    EditorPosition start;
+    EditorPosition end;
+    std::string text;
+};
+
+// Outcome of EditorEditBatch::apply
+struct EditorBatchResult {
+    int applied = 0;            // Edits applied
+    int dropped = 0;            // Edits skipped because they overlapped an earlier one
+    int firstLine = 0;          // First line touched
+    int oldLastLine = -1;       // Last touched line before the batch
+    int newLastLine = -1;       // Last touched line after the batch
+    int lineDelta = 0;          // Change in document line count
+
+    // Position just after each edit's inserted text, in the order the edits
+    // were added (a dropped edit shares the caret of the edit it overlapped)
+    std::vector<EditorPosition> carets;
+
+    bool changed() const { return applied > 0; }
+};
+
+class EditorEditBatch {
+public:
+    void insert(EditorPosition at, const std::string& text);
+    void erase(EditorPosition start, EditorPosition end);
+    void replace(EditorPosition start, EditorPosition end, const std::string& text);
+
+    size_t size() const { return m_edits.size(); }
+    bool empty() const { return m_edits.empty(); }
+    void clear() { m_edits.clear(); }
+
+    // Apply every edit in one pass. Positions refer to the document before
+    // the batch; edits are sorted by start, ties keep insertion order.
+    EditorBatchResult apply(std::vector<std::string>& lines) const;
+
+    // Whether apply() would change the text: false when every edit that
+    // survives the overlap check replaces a range with identical text
+    bool changes(const std::vector<std::string>& lines) const;
+
+    // Build a batch replacing every non-overlapping occurrence of `find`
+    // (single line, case sensitive)
+    static EditorEditBatch replaceAll(const std::vector<std::string>& lines,
+                                      const std::string& find, const std::string& replacement);
+
+private:
+    std::vector<EditorEdit> m_edits;
+};
+
+#endif /* EditorEditBatch_h */
@@ -0,0 +1,145 @@
+//
+//  EditorLineIndex.cpp
+//  SuperTerminal Framework - Editor Long-Line Index
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "EditorLineIndex.h"
+#include <algorithm>
+
+// ============================================================================
+// Structure updates
+// ============================================================================
+
+void EditorLineIndex::reset(const std::vector<std::string>& lines) {
+    m_lines.clear();
+    m_lengthCounts.clear();
+    m_lines.resize(lines.size());
+    for (size_t i = 0; i < lines.size(); i++) {
+        m_lines[i].length = (int)lines[i].length();
+        addLength(m_lines[i].length);
+    }
+}
+
+void EditorLineIndex::lineChanged(int line, const std::string& text) {
+    if (line < 0) return;
+    if (line >= (int)m_lines.size()) {
+        // Lines appended past the end without an insert notification
+        for (int i = (int)m_lines.size(); i <= line; i++) {
+            m_lines.emplace_back();
+            addLength(0);
+        }
+    }
+
+    LineInfo& info = m_lines[line];
+    removeLength(info.length);
+    info.length = (int)text.length();
+    info.checkpoints.clear();
+    addLength(info.length);
+}
+
+void EditorLineIndex::linesInserted(int at, const std::vector<std::string>& lines, int count) {
+    if (count <= 0) return;
+    at = std::max(0, std::min(at, (int)m_lines.size()));
+
+    std::vector<LineInfo> inserted(count);
+    for (int i = 0; i < count; i++) {
+        int source = at + i;
+        inserted[i].length = source < (int)lines.size() ? (int)lines[source].length() : 0;
+        addLength(inserted[i].length);
+    }
+    m_lines.insert(m_lines.begin() + at, inserted.begin(), inserted.end());
+}
+
+void EditorLineIndex::linesErased(int at, int count) {
+    if (at < 0 || at >= (int)m_lines.size() || count <= 0) return;
+    int end = std::min(at + count, (int)m_lines.size());
+    for (int i = at; i < end; i++) {
+        removeLength(m_lines[i].length);
+    }
+    m_lines.erase(m_lines.begin() + at, m_lines.begin() + end);
+}
+
+int EditorLineIndex::maxLineLength() const {
+    return m_lengthCounts.empty() ? 0 : m_lengthCounts.rbegin()->first;
+}
+
+void EditorLineIndex::addLength(int length) {
+    m_lengthCounts[length]++;
+}
+
+void EditorLineIndex::removeLength(int length) {
+    auto it = m_lengthCounts.find(length);
+    if (it != m_lengthCounts.end() && --it->second == 0) {
+        m_lengthCounts.erase(it);
+    }
+}
+
+// ============================================================================
+// Lexer checkpoints
+// ============================================================================
+
+EditorLexState EditorLineIndex::step(EditorLexState state, const std::string& text, int pos) {
+    if (state.inComment) {
+        return state;
+    }
+
+    char c = text[pos];
+    bool escaped = pos > 0 && text[pos - 1] == '\\';
+
+    if (state.inDoubleString) {
+        if (c == '"' && !escaped) state.inDoubleString = false;
+    } else if (state.inSingleString) {
+        if (c == '\'' && !escaped) state.inSingleString = false;
+    } else if (c == '-' && pos + 1 < (int)text.length() && text[pos + 1] == '-') {
+        state.inComment = true;
+    } else if (c == '"' && !escaped) {
+        state.inDoubleString = true;
+    } else if (c == '\'' && !escaped) {
+        state.inSingleString = true;
+    }
+    return state;
+}
+
+EditorLexState EditorLineIndex::stateAt(int line, const std::string& text, int column) {
+    column = std::max(0, std::min(column, (int)text.length()));
+    if (line < 0) {
+        EditorLexState state;
+        for (int pos = 0; pos < column; pos++) state = step(state, text, pos);
+        return state;
+    }
+    if (line >= (int)m_lines.size() || m_lines[line].length != (int)text.length()) {
+        lineChanged(line, text);
+    }
+
+    // Extend the checkpoint list lazily, only as far as this column needs
+    std::vector<EditorLexState>& checkpoints = m_lines[line].checkpoints;
+    if (checkpoints.empty()) {
+        checkpoints.push_back(EditorLexState{});
+    }
+    int needed = column / CHECKPOINT_INTERVAL;
+    while ((int)checkpoints.size() <= needed) {
+        int from = ((int)checkpoints.size() - 1) * CHECKPOINT_INTERVAL;
+        EditorLexState state = checkpoints.back();
+        for (int pos = from; pos < from + CHECKPOINT_INTERVAL; pos++) {
+            state = step(state, text, pos);
+        }
+        checkpoints.push_back(state);
+    }
+
+    EditorLexState state = checkpoints[needed];
+    for (int pos = needed * CHECKPOINT_INTERVAL; pos < column; pos++) {
+        state = step(state, text, pos);
+    }
+    return state;
+}
+
+size_t EditorLineIndex::checkpointCount() const {
+    size_t count = 0;
+    for (const auto& info : m_lines) {
+        count += info.checkpoints.size();
+    }
+    return count;
+}
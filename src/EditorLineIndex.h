@@ -0,0 +1,75 @@
+//
+//  EditorLineIndex.h
+//  SuperTerminal Framework - Editor Long-Line Index
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+//  Side index over the editor's line vector. Caches syntax-lexer checkpoints
+//  every CHECKPOINT_INTERVAL columns so rendering a horizontally scrolled
+//  viewport starts next to the scroll offset instead of at column 0, and
+//  keeps the longest line length up to date without rescanning the document.
+//
+
+#ifndef EditorLineIndex_h
+#define EditorLineIndex_h
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Lua highlighting state carried across columns of one line
+struct EditorLexState {
+    bool inDoubleString = false;
+    bool inSingleString = false;
+    bool inComment = false;
+
+    bool inString() const { return inDoubleString || inSingleString; }
+    bool operator==(const EditorLexState& other) const {
+        return inDoubleString == other.inDoubleString &&
+               inSingleString == other.inSingleString &&
+               inComment == other.inComment;
+    }
+};
+
+class EditorLineIndex {
+public:
+    static const int CHECKPOINT_INTERVAL = 1024;
+
+    // Structure updates (mirror every change made to the line vector)
+    void reset(const std::vector<std::string>& lines);
+    void lineChanged(int line, const std::string& text);
+    void linesInserted(int at, const std::vector<std::string>& lines, int count);
+    void linesErased(int at, int count);
+
+    // Longest line in the document, O(1)
+    int maxLineLength() const;
+    int lineCount() const { return (int)m_lines.size(); }
+
+    // Highlighting state just before `column` of `text` (the contents of
+    // `line`). Reuses the nearest checkpoint; a line whose length no longer
+    // matches the index is treated as changed.
+    EditorLexState stateAt(int line, const std::string& text, int column);
+
+    // Advance over text[pos]: returns the state used to colour that column,
+    // which is also the state before pos + 1
+    static EditorLexState step(EditorLexState state, const std::string& text, int pos);
+
+    // Total checkpoints currently cached (for tests)
+    size_t checkpointCount() const;
+
+private:
+    struct LineInfo {
+        int length = 0;
+        std::vector<EditorLexState> checkpoints;   // [k] = state before k * INTERVAL
+    };
+
+    std::vector<LineInfo> m_lines;
+    std::map<int, int> m_lengthCounts;             // length -> number of lines
+
+    void addLength(int length);
+    void removeLength(int length);
+};
+
+#endif /* EditorLineIndex_h */
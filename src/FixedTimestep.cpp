@@ -0,0 +1,253 @@
+//
+//  FixedTimestep.cpp
+//  SuperTerminal Framework - Fixed Timestep Simulation Scheduler
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "FixedTimestep.h"
+#include <algorithm>
+#include <cmath>
+
+// =============================================================================
+// SimulationRandom
+// =============================================================================
+
+static uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static inline uint32_t rotl32(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+SimulationRandom::SimulationRandom(uint64_t seedValue) {
+    seed(seedValue);
+}
+
+void SimulationRandom::seed(uint64_t seedValue) {
+    uint64_t state = seedValue;
+    uint64_t a = splitMix64(state);
+    uint64_t b = splitMix64(state);
+    m_state[0] = (uint32_t)a;
+    m_state[1] = (uint32_t)(a >> 32);
+    m_state[2] = (uint32_t)b;
+    m_state[3] = (uint32_t)(b >> 32);
+}
+
+uint32_t SimulationRandom::nextU32() {
+    uint32_t result = rotl32(m_state[1] * 5, 7) * 9;
+    uint32_t t = m_state[1] << 9;
+    m_state[2] ^= m_state[0];
+    m_state[3] ^= m_state[1];
+    m_state[1] ^= m_state[2];
+    m_state[0] ^= m_state[3];
+    m_state[2] ^= t;
+    m_state[3] = rotl32(m_state[3], 11);
+    return result;
+}
+
+float SimulationRandom::nextFloat() {
+    // 24 random mantissa bits, exact in float
+    return (float)(nextU32() >> 8) * (1.0f / 16777216.0f);
+}
+
+float SimulationRandom::range(float minValue, float maxValue) {
+    return minValue + (maxValue - minValue) * nextFloat();
+}
+
+// =============================================================================
+// FixedTimestepScheduler
+// =============================================================================
+
+FixedTimestepScheduler::FixedTimestepScheduler() = default;
+
+int FixedTimestepScheduler::registerStep(const std::string& name, int order, StepFunction step) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    int handle = m_nextHandle++;
+    auto position = std::upper_bound(m_steps.begin(), m_steps.end(), order,
+                                     [](int value, const Entry& e) { return value < e.order; });
+    m_steps.insert(position, Entry{handle, order, name, std::move(step)});
+    return handle;
+}
+
+bool FixedTimestepScheduler::unregisterStep(int handle) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = std::find_if(m_steps.begin(), m_steps.end(),
+                           [handle](const Entry& e) { return e.handle == handle; });
+    if (it == m_steps.end()) {
+        return false;
+    }
+    m_steps.erase(it);
+    return true;
+}
+
+size_t FixedTimestepScheduler::getStepCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_steps.size();
+}
+
+int FixedTimestepScheduler::advance(double frameSeconds) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Negative, NaN and huge deltas (debugger pause, app nap) are clamped
+    if (!(frameSeconds > 0.0)) {
+        frameSeconds = 0.0;
+    }
+    if (frameSeconds > m_maxFrameDelta) {
+        m_droppedTime += frameSeconds - m_maxFrameDelta;
+        frameSeconds = m_maxFrameDelta;
+    }
+
+    m_accumulator += frameSeconds;
+
+    int steps = 0;
+    while (m_accumulator >= m_stepSeconds && steps < m_maxCatchUpSteps) {
+        runStepLocked();
+        m_accumulator -= m_stepSeconds;
+        steps++;
+    }
+
+    if (m_accumulator >= m_stepSeconds) {
+        // Keep the partial step so alpha stays meaningful
+        double kept = std::fmod(m_accumulator, m_stepSeconds);
+        m_droppedTime += m_accumulator - kept;
+        m_accumulator = kept;
+    }
+
+    return steps;
+}
+
+void FixedTimestepScheduler::step() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    runStepLocked();
+}
+
+void FixedTimestepScheduler::runStepLocked() {
+    float dt = (float)m_stepSeconds;
+    for (Entry& entry : m_steps) {
+        entry.function(dt, m_stepIndex);
+    }
+    m_stepIndex++;
+}
+
+double FixedTimestepScheduler::getAlpha() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::min(1.0, std::max(0.0, m_accumulator / m_stepSeconds));
+}
+
+uint64_t FixedTimestepScheduler::getStepIndex() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stepIndex;
+}
+
+double FixedTimestepScheduler::getSimulationTime() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (double)m_stepIndex * m_stepSeconds;
+}
+
+double FixedTimestepScheduler::getDroppedTime() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_droppedTime;
+}
+
+void FixedTimestepScheduler::setStepRate(double stepsPerSecond) {
+    if (!(stepsPerSecond > 0.0)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stepSeconds = 1.0 / stepsPerSecond;
+    m_accumulator = 0.0;
+}
+
+double FixedTimestepScheduler::getStepSeconds() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stepSeconds;
+}
+
+void FixedTimestepScheduler::setMaxCatchUpSteps(int steps) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxCatchUpSteps = std::max(1, steps);
+}
+
+void FixedTimestepScheduler::setMaxFrameDelta(double seconds) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxFrameDelta = std::max(m_stepSeconds, seconds);
+}
+
+void FixedTimestepScheduler::reset(uint64_t seed) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_seed = seed;
+    m_accumulator = 0.0;
+    m_droppedTime = 0.0;
+    m_stepIndex = 0;
+    for (auto& stream : m_random) {
+        stream.second.seed(streamSeed(seed, stream.first));
+    }
+}
+
+uint64_t FixedTimestepScheduler::getSeed() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_seed;
+}
+
+SimulationRandom& FixedTimestepScheduler::getRandom(const std::string& stream) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_random.find(stream);
+    if (it == m_random.end()) {
+        it = m_random.emplace(stream, SimulationRandom(streamSeed(m_seed, stream))).first;
+    }
+    return it->second;
+}
+
+uint64_t FixedTimestepScheduler::streamSeed(uint64_t seed, const std::string& stream) {
+    // FNV-1a of the stream name; std::hash is not stable across libraries
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (unsigned char c : stream) {
+        hash = (hash ^ c) * 0x100000001B3ull;
+    }
+    return seed ^ hash;
+}
+
+// =============================================================================
+// Process-wide scheduler and C API
+// =============================================================================
+
+FixedTimestepScheduler& simulation_scheduler() {
+    static FixedTimestepScheduler scheduler;
+    return scheduler;
+}
+
+extern "C" {
+
+int simulation_advance(float frame_seconds) {
+    return simulation_scheduler().advance(frame_seconds);
+}
+
+double simulation_get_alpha() {
+    return simulation_scheduler().getAlpha();
+}
+
+uint64_t simulation_get_step_index() {
+    return simulation_scheduler().getStepIndex();
+}
+
+void simulation_set_step_rate(float steps_per_second) {
+    simulation_scheduler().setStepRate(steps_per_second);
+}
+
+void simulation_set_max_catch_up_steps(int steps) {
+    simulation_scheduler().setMaxCatchUpSteps(steps);
+}
+
+void simulation_reset(uint64_t seed) {
+    simulation_scheduler().reset(seed);
+}
+
+}
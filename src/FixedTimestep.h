@@ -0,0 +1,137 @@
+//
+//  FixedTimestep.h
+//  SuperTerminal Framework - Fixed Timestep Simulation Scheduler
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+//  Central simulation clock. The render loop feeds wall-clock frame deltas
+//  into an accumulator, and registered subsystems (particles, bullets, sprite
+//  effects) step with a constant dt. Step count therefore depends only on
+//  elapsed time, never on frame rate, and state after N steps is identical
+//  across runs given the same seed and the same per-step input.
+//
+//  Rendering uses getAlpha() (0..1, fraction of a step left in the
+//  accumulator) to interpolate between the previous and current step.
+//
+
+#ifndef FixedTimestep_h
+#define FixedTimestep_h
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Seeded generator for simulation code. xoshiro128** with a splitmix64
+// seeding step; no platform or library dependent distributions, so the same
+// seed yields the same floats everywhere.
+class SimulationRandom {
+public:
+    explicit SimulationRandom(uint64_t seed = 1);
+
+    void seed(uint64_t seed);
+    uint32_t nextU32();
+    float nextFloat();                          // [0, 1)
+    float range(float minValue, float maxValue); // [min, max)
+
+private:
+    uint32_t m_state[4];
+};
+
+// Step order of the built-in subsystems (lower runs first)
+enum SimulationStepOrder {
+    SIM_STEP_ORDER_BULLETS = 100,
+    SIM_STEP_ORDER_PARTICLES = 200,
+    SIM_STEP_ORDER_SPRITE_ANIMATION = 250,
+    SIM_STEP_ORDER_SPRITE_EFFECTS = 300
+};
+
+class FixedTimestepScheduler {
+public:
+    // dt is the fixed step in seconds; stepIndex counts from 0 since reset
+    using StepFunction = std::function<void(float dt, uint64_t stepIndex)>;
+
+    static constexpr double DEFAULT_STEP_RATE = 60.0;
+    static constexpr int DEFAULT_MAX_CATCH_UP_STEPS = 5;
+    static constexpr double DEFAULT_MAX_FRAME_DELTA = 0.25;
+
+    FixedTimestepScheduler();
+
+    // Lower order steps first; equal order keeps registration order.
+    // Returns a handle for unregisterStep (never 0). Must not be called from
+    // inside a step callback.
+    int registerStep(const std::string& name, int order, StepFunction step);
+    bool unregisterStep(int handle);
+    size_t getStepCount() const;
+
+    // Feed one rendered frame's wall-clock delta; runs 0..maxCatchUpSteps
+    // steps and returns how many ran. Time beyond the cap is dropped so a
+    // stall does not turn into a spiral of catch-up frames.
+    int advance(double frameSeconds);
+
+    // Run exactly one step regardless of the accumulator (tests, replays)
+    void step();
+
+    // Fraction of a step waiting in the accumulator, for interpolation
+    double getAlpha() const;
+
+    uint64_t getStepIndex() const;              // Steps run since reset
+    double getSimulationTime() const;           // stepIndex x step
+    double getDroppedTime() const;              // Wall time discarded by the cap
+
+    void setStepRate(double stepsPerSecond);
+    double getStepSeconds() const;
+    void setMaxCatchUpSteps(int steps);
+    void setMaxFrameDelta(double seconds);
+
+    // Reseeds every random stream and rewinds the clock
+    void reset(uint64_t seed);
+    uint64_t getSeed() const;
+
+    // Named generator, seeded from the master seed and the name. The
+    // reference stays valid for the scheduler's lifetime; look it up once
+    // at init, not from inside a step callback.
+    SimulationRandom& getRandom(const std::string& stream);
+
+private:
+    struct Entry {
+        int handle;
+        int order;
+        std::string name;
+        StepFunction function;
+    };
+
+    mutable std::mutex m_mutex;
+    std::vector<Entry> m_steps;
+    std::map<std::string, SimulationRandom> m_random;
+    int m_nextHandle = 1;
+
+    double m_stepSeconds = 1.0 / DEFAULT_STEP_RATE;
+    int m_maxCatchUpSteps = DEFAULT_MAX_CATCH_UP_STEPS;
+    double m_maxFrameDelta = DEFAULT_MAX_FRAME_DELTA;
+
+    double m_accumulator = 0.0;
+    double m_droppedTime = 0.0;
+    uint64_t m_stepIndex = 0;
+    uint64_t m_seed = 1;
+
+    void runStepLocked();
+    static uint64_t streamSeed(uint64_t seed, const std::string& stream);
+};
+
+// Process-wide scheduler driven by the render loop
+FixedTimestepScheduler& simulation_scheduler();
+
+extern "C" {
+    int simulation_advance(float frame_seconds);
+    double simulation_get_alpha();
+    uint64_t simulation_get_step_index();
+    void simulation_set_step_rate(float steps_per_second);
+    void simulation_set_max_catch_up_steps(int steps);
+    void simulation_reset(uint64_t seed);
+}
+
+#endif /* FixedTimestep_h */
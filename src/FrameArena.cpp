@@ -0,0 +1,177 @@
+//
+//  FrameArena.cpp
+//  SuperTerminal Framework - Per-Frame Bump Allocator
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "FrameArena.h"
+#include <algorithm>
+#include <cstdlib>
+
+static size_t alignOffset(const uint8_t* base, size_t offset, size_t alignment) {
+    uintptr_t address = reinterpret_cast<uintptr_t>(base) + offset;
+    uintptr_t aligned = (address + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    return offset + (size_t)(aligned - address);
+}
+
+FrameArena::FrameArena(size_t capacity, bool growOnOverflow)
+    : m_growOnOverflow(growOnOverflow) {
+    capacity = std::min(capacity, MAX_CAPACITY);
+    if (capacity > 0) {
+        m_block = static_cast<uint8_t*>(std::malloc(capacity));
+        m_capacity = m_block ? capacity : 0;
+    }
+    m_overflow.reserve(16);
+}
+
+FrameArena::~FrameArena() {
+    releaseOverflow(0);
+    std::free(m_block);
+}
+
+FrameArena& FrameArena::forThread() {
+    static thread_local FrameArena arena;
+    return arena;
+}
+
+// =============================================================================
+// Allocation
+// =============================================================================
+
+void* FrameArena::allocate(size_t size, size_t alignment) {
+    if (size == 0) {
+        size = 1;
+    }
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        alignment = DEFAULT_ALIGNMENT;
+    }
+
+    if (m_block) {
+        size_t offset = alignOffset(m_block, m_used, alignment);
+        if (offset <= m_capacity && size <= m_capacity - offset) {
+            m_lastOffset = offset;
+            m_used = offset + size;
+            size_t live = m_used + m_overflowBytes;
+            m_frameHighWater = std::max(m_frameHighWater, live);
+            m_highWater = std::max(m_highWater, live);
+            return m_block + offset;
+        }
+    }
+    return allocateOverflow(size, alignment);
+}
+
+void* FrameArena::allocateOverflow(size_t size, size_t alignment) {
+    // malloc already satisfies the default alignment; pad for anything larger
+    size_t padding = alignment > DEFAULT_ALIGNMENT ? alignment : 0;
+    if (size > SIZE_MAX - padding) {
+        throw std::bad_alloc();
+    }
+    void* memory = std::malloc(size + padding);
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    m_overflow.push_back({memory, size});
+
+    m_overflowBytes += size;
+    m_frameOverflowBytes += size;
+    m_totalOverflows++;
+    size_t live = m_used + m_overflowBytes;
+    m_frameHighWater = std::max(m_frameHighWater, live);
+    m_highWater = std::max(m_highWater, live);
+
+    uint8_t* start = static_cast<uint8_t*>(memory);
+    return start + (alignOffset(start, 0, alignment));
+}
+
+void FrameArena::deallocate(void* pointer, size_t size) {
+    if (!owns(pointer)) {
+        return;     // Overflow memory is released at reset/rewind
+    }
+    size_t offset = static_cast<size_t>(static_cast<uint8_t*>(pointer) - m_block);
+    if (offset == m_lastOffset && offset + std::max<size_t>(size, 1) == m_used) {
+        m_used = offset;
+        m_lastOffset = SIZE_MAX;
+    }
+}
+
+bool FrameArena::owns(const void* pointer) const {
+    const uint8_t* p = static_cast<const uint8_t*>(pointer);
+    return m_block && p >= m_block && p < m_block + m_capacity;
+}
+
+// =============================================================================
+// Scopes and frame reset
+// =============================================================================
+
+FrameArena::Marker FrameArena::mark() const {
+    Marker marker;
+    marker.used = m_used;
+    marker.overflowBlocks = m_overflow.size();
+    marker.overflowBytes = m_overflowBytes;
+    return marker;
+}
+
+void FrameArena::rewind(const Marker& marker) {
+    if (marker.used > m_used || marker.overflowBlocks > m_overflow.size()) {
+        return;     // Arena was reset since the marker was taken
+    }
+    m_used = marker.used;
+    m_lastOffset = SIZE_MAX;
+    releaseOverflow(marker.overflowBlocks);
+    m_overflowBytes = marker.overflowBytes;
+
+    // An outermost scope closing is the frame boundary for threads that
+    // never call reset()
+    if (m_used == 0 && m_overflow.empty()) {
+        growIfOverflowed();
+    }
+}
+
+void FrameArena::reset() {
+    m_lastFrameHighWater = m_frameHighWater;
+    m_lastFrameOverflowBytes = m_frameOverflowBytes;
+
+    releaseOverflow(0);
+    m_overflowBytes = 0;
+    m_used = 0;
+    m_lastOffset = SIZE_MAX;
+    growIfOverflowed();
+
+    m_frameHighWater = 0;
+    m_frames++;
+}
+
+void FrameArena::growIfOverflowed() {
+    if (m_frameOverflowBytes == 0) {
+        return;
+    }
+    m_frameOverflowBytes = 0;
+    if (!m_growOnOverflow || m_capacity >= MAX_CAPACITY) {
+        return;
+    }
+
+    size_t target = std::max<size_t>(m_capacity, 4096);
+    while (target < m_frameHighWater && target < MAX_CAPACITY) {
+        target *= 2;
+    }
+    target = std::min(target, MAX_CAPACITY);
+    if (target <= m_capacity) {
+        return;
+    }
+
+    uint8_t* block = static_cast<uint8_t*>(std::malloc(target));
+    if (block) {
+        std::free(m_block);
+        m_block = block;
+        m_capacity = target;
+    }
+}
+
+void FrameArena::releaseOverflow(size_t keepBlocks) {
+    while (m_overflow.size() > keepBlocks) {
+        std::free(m_overflow.back().memory);
+        m_overflow.pop_back();
+    }
+}
@@ -0,0 +1,161 @@
+//
+//  FrameArena.h
+//  SuperTerminal Framework - Per-Frame Bump Allocator
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+//  Linear allocator for scratch data that only lives until the end of the
+//  current frame: grouping tables, highlight masks, per-callback audio
+//  scratch. Allocation is a pointer bump inside one block; nothing is freed
+//  individually (except the most recent allocation, so a growing vector can
+//  reclaim its old storage). The owning thread calls reset() at frame end.
+//
+//  When a frame needs more than the block holds, the excess comes from the
+//  heap and is counted as overflow; reset() frees it and grows the block to
+//  the high-water mark so the next frame fits. Code that runs on a thread
+//  without a frame loop (the audio callback) brackets its work in a
+//  FrameArenaScope instead of calling reset().
+//
+//  One arena per thread via forThread(); an arena is not thread-safe.
+//  Containers built on FrameArenaAllocator must not outlive the frame (or
+//  scope) they were created in.
+//
+
+#ifndef FrameArena_h
+#define FrameArena_h
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <new>
+#include <vector>
+
+class FrameArena {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 256 * 1024;
+    static constexpr size_t MAX_CAPACITY = 64 * 1024 * 1024;   // Growth stops here
+    static constexpr size_t DEFAULT_ALIGNMENT = alignof(std::max_align_t);
+
+    // Position to rewind to; see FrameArenaScope
+    struct Marker {
+        size_t used = 0;
+        size_t overflowBlocks = 0;
+        size_t overflowBytes = 0;
+    };
+
+    explicit FrameArena(size_t capacity = DEFAULT_CAPACITY, bool growOnOverflow = true);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // The calling thread's arena, created on first use
+    static FrameArena& forThread();
+
+    void* allocate(size_t size, size_t alignment = DEFAULT_ALIGNMENT);
+
+    // Only reclaims the most recent allocation; anything else waits for reset()
+    void deallocate(void* pointer, size_t size);
+
+    bool owns(const void* pointer) const;
+
+    Marker mark() const;
+    void rewind(const Marker& marker);
+
+    // End of frame: drop every allocation, free overflow and, if the frame
+    // overflowed, grow the block to cover the high-water mark
+    void reset();
+
+    size_t getCapacity() const { return m_capacity; }
+    size_t getUsed() const { return m_used + m_overflowBytes; }
+    size_t getHighWater() const { return m_highWater; }             // Most bytes live at once, ever
+    size_t getFrameHighWater() const { return m_lastFrameHighWater; }   // ... in the frame last reset
+    size_t getOverflowCount() const { return m_totalOverflows; }    // Heap fallbacks, ever
+    size_t getLastFrameOverflowBytes() const { return m_lastFrameOverflowBytes; }
+    uint64_t getFrameCount() const { return m_frames; }
+
+private:
+    struct OverflowBlock {
+        void* memory;
+        size_t size;
+    };
+
+    uint8_t* m_block = nullptr;
+    size_t m_capacity = 0;
+    size_t m_used = 0;
+    size_t m_lastOffset = SIZE_MAX;     // Start of the most recent in-block allocation
+    bool m_growOnOverflow;
+
+    std::vector<OverflowBlock> m_overflow;
+    size_t m_overflowBytes = 0;
+
+    size_t m_highWater = 0;
+    size_t m_frameHighWater = 0;
+    size_t m_lastFrameHighWater = 0;
+    size_t m_frameOverflowBytes = 0;    // Since the last reset (or growth check)
+    size_t m_lastFrameOverflowBytes = 0;
+    size_t m_totalOverflows = 0;
+    uint64_t m_frames = 0;
+
+    void* allocateOverflow(size_t size, size_t alignment);
+    void releaseOverflow(size_t keepBlocks);
+    void growIfOverflowed();
+};
+
+// Rewinds an arena to where it was when the scope opened
+class FrameArenaScope {
+public:
+    explicit FrameArenaScope(FrameArena& arena = FrameArena::forThread())
+        : m_arena(arena), m_marker(arena.mark()) {}
+    ~FrameArenaScope() { m_arena.rewind(m_marker); }
+
+    FrameArenaScope(const FrameArenaScope&) = delete;
+    FrameArenaScope& operator=(const FrameArenaScope&) = delete;
+
+private:
+    FrameArena& m_arena;
+    FrameArena::Marker m_marker;
+};
+
+// STL allocator over a FrameArena (the calling thread's by default)
+template <typename T>
+class FrameArenaAllocator {
+public:
+    using value_type = T;
+
+    FrameArenaAllocator() noexcept : m_arena(&FrameArena::forThread()) {}
+    explicit FrameArenaAllocator(FrameArena& arena) noexcept : m_arena(&arena) {}
+    template <typename U>
+    FrameArenaAllocator(const FrameArenaAllocator<U>& other) noexcept : m_arena(other.arena()) {}
+
+    T* allocate(size_t count) {
+        if (count > SIZE_MAX / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(m_arena->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* pointer, size_t count) noexcept {
+        m_arena->deallocate(pointer, count * sizeof(T));
+    }
+
+    FrameArena* arena() const noexcept { return m_arena; }
+
+    template <typename U>
+    bool operator==(const FrameArenaAllocator<U>& other) const noexcept { return m_arena == other.arena(); }
+    template <typename U>
+    bool operator!=(const FrameArenaAllocator<U>& other) const noexcept { return m_arena != other.arena(); }
+
+private:
+    FrameArena* m_arena;
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameArenaAllocator<T>>;
+
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+using FrameMap = std::map<Key, Value, Compare, FrameArenaAllocator<std::pair<const Key, Value>>>;
+
+#endif /* FrameArena_h */
@@ -11,6 +11,7 @@ extern "C" {
 #include <lauxlib.h>
 }
 #include <dispatch/dispatch.h>
+#include "TraceEvents.h"
 #include <chrono>
 #include <thread>
 #include <iostream>
@@ -36,6 +37,7 @@ static bool is_cancelled() {
 
 // Cancellable sleep with polling
 static bool cancellable_sleep_ms(uint64_t milliseconds, uint64_t poll_interval_ms = 10) {
+    TRACE_SCOPE("lua", "script wait");
     auto start = std::chrono::steady_clock::now();
     
     while (true) {
@@ -10,6 +10,7 @@
 
 #include "SuperTerminal.h"
 #include "../SpriteEffectSystem.h"
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <cstring>
@@ -18,6 +19,7 @@
 #include <atomic>
 #include <thread>
 #include <chrono>
+#include <vector>
 #include "CommandQueue.h"
 #include "GlobalShutdown.h"
 #include <setjmp.h>
@@ -29,6 +31,9 @@ extern "C" {
 
 // REPL function declarations
 void repl_notify_state_reset();
+
+// Wakes script threads blocked on mouse input
+void input_system_interrupt_mouse_waits(void);
 }
 
 using namespace SuperTerminal;
@@ -67,6 +72,13 @@ extern "C" {
     void text_set_autoscroll(bool enabled);
     bool text_get_autoscroll();
     
+    // Forward declarations for scrollback search functions
+    bool text_find_next(const char* query, bool ignore_case, int* out_line, int* out_column);
+    bool text_find_previous(const char* query, bool ignore_case, int* out_line, int* out_column);
+    int text_find_all(const char* query, bool ignore_case);
+    bool text_get_find_match(int index, int* out_line, int* out_column, int* out_length);
+    void text_find_clear(void);
+    
     // Status bar update functions
     void superterminal_update_status(const char* status);
     void superterminal_update_script_name(const char* scriptName);
@@ -203,6 +215,10 @@ static int lua_text_get_viewport_line(lua_State* L);
 static int lua_text_get_viewport_height(lua_State* L);
 static int lua_text_set_autoscroll(lua_State* L);
 static int lua_text_get_autoscroll(lua_State* L);
+static int lua_text_find(lua_State* L);
+static int lua_text_find_previous(lua_State* L);
+static int lua_text_find_all(lua_State* L);
+static int lua_text_find_clear(lua_State* L);
 
 static int lua_superterminal_set_color(lua_State* L);
 static int lua_superterminal_end_of_script(lua_State* L);
@@ -235,7 +251,15 @@ static int lua_superterminal_emphaticExit(lua_State* L);
 static int lua_superterminal_mouse_get_position(lua_State* L);
 static int lua_superterminal_mouse_is_pressed(lua_State* L);
 static int lua_superterminal_mouse_wait_click(lua_State* L);
+static int lua_superterminal_mouse_poll_events(lua_State* L);
+static int lua_superterminal_mouse_wait_event(lua_State* L);
 static int lua_superterminal_sprite_mouse_over(lua_State* L);
+static int lua_superterminal_sprite_mouse_pick(lua_State* L);
+static int lua_superterminal_mouse_get_sprite_position(lua_State* L);
+static int lua_superterminal_sprite_pick(lua_State* L);
+static int lua_superterminal_sprite_pick_all(lua_State* L);
+static int lua_superterminal_sprite_pick_rect(lua_State* L);
+static int lua_superterminal_sprite_hit_test(lua_State* L);
 static int lua_superterminal_mouse_screen_to_text(lua_State* L);
 
 
@@ -271,6 +295,25 @@ static int lua_superterminal_overlay_show(lua_State* L);
 static int lua_superterminal_overlay_hide(lua_State* L);
 static int lua_superterminal_overlay_is_visible(lua_State* L);
 static int lua_superterminal_overlay_present(lua_State* L);
+static int lua_superterminal_overlay_widget_panel(lua_State* L);
+static int lua_superterminal_overlay_widget_label(lua_State* L);
+static int lua_superterminal_overlay_widget_bar(lua_State* L);
+static int lua_superterminal_overlay_widget_image(lua_State* L);
+static int lua_superterminal_overlay_widget_remove(lua_State* L);
+static int lua_superterminal_overlay_widget_clear(lua_State* L);
+static int lua_superterminal_overlay_widget_set_position(lua_State* L);
+static int lua_superterminal_overlay_widget_set_size(lua_State* L);
+static int lua_superterminal_overlay_widget_set_visible(lua_State* L);
+static int lua_superterminal_overlay_widget_set_z(lua_State* L);
+static int lua_superterminal_overlay_widget_set_color(lua_State* L);
+static int lua_superterminal_overlay_widget_set_back_color(lua_State* L);
+static int lua_superterminal_overlay_widget_set_border(lua_State* L);
+static int lua_superterminal_overlay_widget_set_text(lua_State* L);
+static int lua_superterminal_overlay_widget_set_font_size(lua_State* L);
+static int lua_superterminal_overlay_widget_set_value(lua_State* L);
+static int lua_superterminal_overlay_widget_set_vertical(lua_State* L);
+static int lua_superterminal_overlay_widget_set_image(lua_State* L);
+static int lua_superterminal_overlay_widget_invalidate(lua_State* L);
 static int lua_superterminal_set_blend_mode(lua_State* L);
 static int lua_superterminal_set_blur_filter(lua_State* L);
 static int lua_superterminal_set_drop_shadow(lua_State* L);
@@ -334,6 +377,20 @@ static int lua_superterminal_sprite_check_collision(lua_State* L);
 static int lua_superterminal_sprite_check_point_collision(lua_State* L);
 static int lua_superterminal_sprite_get_size(lua_State* L);
 
+// Sprite atlas animation API bindings
+static int lua_superterminal_sprite_atlas_grid(lua_State* L);
+static int lua_superterminal_sprite_clip(lua_State* L);
+static int lua_superterminal_sprite_clip_frame_duration(lua_State* L);
+static int lua_superterminal_sprite_clip_event(lua_State* L);
+static int lua_superterminal_sprite_play(lua_State* L);
+static int lua_superterminal_sprite_stop(lua_State* L);
+static int lua_superterminal_sprite_anim_pause(lua_State* L);
+static int lua_superterminal_sprite_anim_resume(lua_State* L);
+static int lua_superterminal_sprite_anim_speed(lua_State* L);
+static int lua_superterminal_sprite_anim_frame(lua_State* L);
+static int lua_superterminal_sprite_anim_playing(lua_State* L);
+static int lua_superterminal_sprite_anim_poll(lua_State* L);
+
 // Frame synchronization API bindings
 static int lua_superterminal_wait_frame(lua_State* L);
 
@@ -359,11 +416,24 @@ static int lua_superterminal_tile_set_viewport(lua_State* L);
 static int lua_superterminal_tile_center_viewport(lua_State* L);
 static int lua_superterminal_tile_clear_map(lua_State* L);
 static int lua_superterminal_tile_create_map(lua_State* L);
+static int lua_superterminal_tile_animation(lua_State* L);
+static int lua_superterminal_tile_animation_frame_duration(lua_State* L);
+static int lua_superterminal_tile_animation_remove(lua_State* L);
+static int lua_superterminal_tile_animation_clear(lua_State* L);
+static int lua_superterminal_tile_animation_pause(lua_State* L);
+static int lua_superterminal_tile_animation_frame(lua_State* L);
 static int lua_superterminal_tiles_clear(lua_State* L);
 static int lua_superterminal_tiles_shutdown(lua_State* L);
 static int lua_superterminal_sprites_clear(lua_State* L);
 static int lua_superterminal_sprites_shutdown(lua_State* L);
 
+// Trace capture API bindings
+static int lua_superterminal_trace_start(lua_State* L);
+static int lua_superterminal_trace_stop(lua_State* L);
+static int lua_superterminal_trace_is_active(lua_State* L);
+static int lua_superterminal_trace_clear(lua_State* L);
+static int lua_superterminal_trace_dump(lua_State* L);
+
 // Layer control API bindings
 static int lua_superterminal_layer_set_enabled(lua_State* L);
 static int lua_superterminal_layer_is_enabled(lua_State* L);
@@ -650,6 +720,10 @@ extern "C" void register_superterminal_api(lua_State* L) {
     lua_register(L, "text_get_viewport_height", lua_text_get_viewport_height);
     lua_register(L, "text_set_autoscroll", lua_text_set_autoscroll);
     lua_register(L, "text_get_autoscroll", lua_text_get_autoscroll);
+    lua_register(L, "text_find", lua_text_find);
+    lua_register(L, "text_find_previous", lua_text_find_previous);
+    lua_register(L, "text_find_all", lua_text_find_all);
+    lua_register(L, "text_find_clear", lua_text_find_clear);
     
     lua_register(L, "set_color", lua_superterminal_set_color);
     lua_register(L, "set_ink", lua_superterminal_set_ink);
@@ -694,7 +768,15 @@ extern "C" void register_superterminal_api(lua_State* L) {
     lua_register(L, "mouse_get_position", lua_superterminal_mouse_get_position);
     lua_register(L, "mouse_is_pressed", lua_superterminal_mouse_is_pressed);
     lua_register(L, "mouse_wait_click", lua_superterminal_mouse_wait_click);
+    lua_register(L, "mouse_poll_events", lua_superterminal_mouse_poll_events);
+    lua_register(L, "mouse_wait_event", lua_superterminal_mouse_wait_event);
     lua_register(L, "sprite_mouse_over", lua_superterminal_sprite_mouse_over);
+    lua_register(L, "sprite_mouse_pick", lua_superterminal_sprite_mouse_pick);
+    lua_register(L, "mouse_get_sprite_position", lua_superterminal_mouse_get_sprite_position);
+    lua_register(L, "sprite_pick", lua_superterminal_sprite_pick);
+    lua_register(L, "sprite_pick_all", lua_superterminal_sprite_pick_all);
+    lua_register(L, "sprite_pick_rect", lua_superterminal_sprite_pick_rect);
+    lua_register(L, "sprite_hit_test", lua_superterminal_sprite_hit_test);
     lua_register(L, "mouse_screen_to_text", lua_superterminal_mouse_screen_to_text);
 
 
@@ -763,6 +845,25 @@ extern "C" void register_superterminal_api(lua_State* L) {
     lua_register(L, "overlay_hide", lua_superterminal_overlay_hide);
     lua_register(L, "overlay_is_visible", lua_superterminal_overlay_is_visible);
     lua_register(L, "overlay_present", lua_superterminal_overlay_present);
+    lua_register(L, "overlay_widget_panel", lua_superterminal_overlay_widget_panel);
+    lua_register(L, "overlay_widget_label", lua_superterminal_overlay_widget_label);
+    lua_register(L, "overlay_widget_bar", lua_superterminal_overlay_widget_bar);
+    lua_register(L, "overlay_widget_image", lua_superterminal_overlay_widget_image);
+    lua_register(L, "overlay_widget_remove", lua_superterminal_overlay_widget_remove);
+    lua_register(L, "overlay_widget_clear", lua_superterminal_overlay_widget_clear);
+    lua_register(L, "overlay_widget_set_position", lua_superterminal_overlay_widget_set_position);
+    lua_register(L, "overlay_widget_set_size", lua_superterminal_overlay_widget_set_size);
+    lua_register(L, "overlay_widget_set_visible", lua_superterminal_overlay_widget_set_visible);
+    lua_register(L, "overlay_widget_set_z", lua_superterminal_overlay_widget_set_z);
+    lua_register(L, "overlay_widget_set_color", lua_superterminal_overlay_widget_set_color);
+    lua_register(L, "overlay_widget_set_back_color", lua_superterminal_overlay_widget_set_back_color);
+    lua_register(L, "overlay_widget_set_border", lua_superterminal_overlay_widget_set_border);
+    lua_register(L, "overlay_widget_set_text", lua_superterminal_overlay_widget_set_text);
+    lua_register(L, "overlay_widget_set_font_size", lua_superterminal_overlay_widget_set_font_size);
+    lua_register(L, "overlay_widget_set_value", lua_superterminal_overlay_widget_set_value);
+    lua_register(L, "overlay_widget_set_vertical", lua_superterminal_overlay_widget_set_vertical);
+    lua_register(L, "overlay_widget_set_image", lua_superterminal_overlay_widget_set_image);
+    lua_register(L, "overlay_widget_invalidate", lua_superterminal_overlay_widget_invalidate);
     
     // Console output
     lua_register(L, "console", lua_superterminal_console);
@@ -810,6 +911,20 @@ extern "C" void register_superterminal_api(lua_State* L) {
     lua_register(L, "sprite_check_point_collision", lua_superterminal_sprite_check_point_collision);
     lua_register(L, "sprite_get_size", lua_superterminal_sprite_get_size);
     
+    // Sprite atlas animation functions
+    lua_register(L, "sprite_atlas_grid", lua_superterminal_sprite_atlas_grid);
+    lua_register(L, "sprite_clip", lua_superterminal_sprite_clip);
+    lua_register(L, "sprite_clip_frame_duration", lua_superterminal_sprite_clip_frame_duration);
+    lua_register(L, "sprite_clip_event", lua_superterminal_sprite_clip_event);
+    lua_register(L, "sprite_play", lua_superterminal_sprite_play);
+    lua_register(L, "sprite_stop", lua_superterminal_sprite_stop);
+    lua_register(L, "sprite_anim_pause", lua_superterminal_sprite_anim_pause);
+    lua_register(L, "sprite_anim_resume", lua_superterminal_sprite_anim_resume);
+    lua_register(L, "sprite_anim_speed", lua_superterminal_sprite_anim_speed);
+    lua_register(L, "sprite_anim_frame", lua_superterminal_sprite_anim_frame);
+    lua_register(L, "sprite_anim_playing", lua_superterminal_sprite_anim_playing);
+    lua_register(L, "sprite_anim_poll", lua_superterminal_sprite_anim_poll);
+    
     // Frame synchronization functions
     lua_register(L, "wait_frame", lua_superterminal_wait_frame);
     
@@ -822,11 +937,24 @@ extern "C" void register_superterminal_api(lua_State* L) {
     lua_register(L, "tile_center_viewport", lua_superterminal_tile_center_viewport);
     lua_register(L, "tile_clear_map", lua_superterminal_tile_clear_map);
     lua_register(L, "tile_create_map", lua_superterminal_tile_create_map);
+    lua_register(L, "tile_animation", lua_superterminal_tile_animation);
+    lua_register(L, "tile_animation_frame_duration", lua_superterminal_tile_animation_frame_duration);
+    lua_register(L, "tile_animation_remove", lua_superterminal_tile_animation_remove);
+    lua_register(L, "tile_animation_clear", lua_superterminal_tile_animation_clear);
+    lua_register(L, "tile_animation_pause", lua_superterminal_tile_animation_pause);
+    lua_register(L, "tile_animation_frame", lua_superterminal_tile_animation_frame);
     lua_register(L, "tiles_clear", lua_superterminal_tiles_clear);
     lua_register(L, "tiles_shutdown", lua_superterminal_tiles_shutdown);
     lua_register(L, "sprites_clear", lua_superterminal_sprites_clear);
     lua_register(L, "sprites_shutdown", lua_superterminal_sprites_shutdown);
     
+    // Trace capture functions
+    lua_register(L, "trace_start", lua_superterminal_trace_start);
+    lua_register(L, "trace_stop", lua_superterminal_trace_stop);
+    lua_register(L, "trace_is_active", lua_superterminal_trace_is_active);
+    lua_register(L, "trace_clear", lua_superterminal_trace_clear);
+    lua_register(L, "trace_dump", lua_superterminal_trace_dump);
+    
     // Layer control functions
     lua_register(L, "layer_set_enabled", lua_superterminal_layer_set_enabled);
     lua_register(L, "layer_is_enabled", lua_superterminal_layer_is_enabled);
@@ -1906,6 +2034,7 @@ void stop_lua_script_bulletproof() {
         }
     }
     g_lua_should_interrupt = true;
+    input_system_interrupt_mouse_waits();
     
     // Step 2: Wait briefly for graceful shutdown
     auto start = std::chrono::steady_clock::now();
@@ -3019,6 +3148,60 @@ static int lua_text_get_autoscroll(lua_State* L) {
     return 1;
 }
 
+// Scrollback search: text_find(query [, ignore_case]) -> line, column or nil
+static int lua_text_find(lua_State* L) {
+    const char* query = luaL_checkstring(L, 1);
+    bool ignore_case = lua_toboolean(L, 2);
+    int line = 0, column = 0;
+    if (!text_find_next(query, ignore_case, &line, &column)) {
+        lua_pushnil(L);
+        return 1;
+    }
+    lua_pushinteger(L, line);
+    lua_pushinteger(L, column);
+    return 2;
+}
+
+static int lua_text_find_previous(lua_State* L) {
+    const char* query = luaL_checkstring(L, 1);
+    bool ignore_case = lua_toboolean(L, 2);
+    int line = 0, column = 0;
+    if (!text_find_previous(query, ignore_case, &line, &column)) {
+        lua_pushnil(L);
+        return 1;
+    }
+    lua_pushinteger(L, line);
+    lua_pushinteger(L, column);
+    return 2;
+}
+
+// text_find_all(query [, ignore_case]) -> { {line=, column=, length=}, ... }
+static int lua_text_find_all(lua_State* L) {
+    const char* query = luaL_checkstring(L, 1);
+    bool ignore_case = lua_toboolean(L, 2);
+    int count = text_find_all(query, ignore_case);
+
+    lua_createtable(L, count, 0);
+    for (int i = 0; i < count; i++) {
+        int line = 0, column = 0, length = 0;
+        if (!text_get_find_match(i, &line, &column, &length)) break;
+        lua_createtable(L, 0, 3);
+        lua_pushinteger(L, line);
+        lua_setfield(L, -2, "line");
+        lua_pushinteger(L, column);
+        lua_setfield(L, -2, "column");
+        lua_pushinteger(L, length);
+        lua_setfield(L, -2, "length");
+        lua_rawseti(L, -2, i + 1);
+    }
+    return 1;
+}
+
+static int lua_text_find_clear(lua_State* L) {
+    text_find_clear();
+    return 0;
+}
+
 static int lua_superterminal_set_color(lua_State* L) {
     uint32_t fg = luaL_checkinteger(L, 1);
     uint32_t bg = luaL_checkinteger(L, 2);
@@ -3094,6 +3277,53 @@ static int lua_superterminal_mouse_wait_click(lua_State* L) {
     return 3;
 }
 
+// Mouse event as {type = "press"|"release"|"move"|"wheel", button, x, y, dx, dy, time}
+static void lua_push_mouse_event(lua_State* L, const MouseEventInfo& event) {
+    static const char* types[] = {"press", "release", "move", "wheel"};
+    lua_createtable(L, 0, 7);
+    lua_pushstring(L, types[event.type & 3]);
+    lua_setfield(L, -2, "type");
+    lua_pushinteger(L, event.button);
+    lua_setfield(L, -2, "button");
+    lua_pushnumber(L, event.x);
+    lua_setfield(L, -2, "x");
+    lua_pushnumber(L, event.y);
+    lua_setfield(L, -2, "y");
+    lua_pushnumber(L, event.delta_x);
+    lua_setfield(L, -2, "dx");
+    lua_pushnumber(L, event.delta_y);
+    lua_setfield(L, -2, "dy");
+    lua_pushnumber(L, event.time);
+    lua_setfield(L, -2, "time");
+}
+
+// mouse_poll_events([max]) -> {events, oldest first}
+static int lua_superterminal_mouse_poll_events(lua_State* L) {
+    int maxEvents = (int)luaL_optinteger(L, 1, 256);
+    maxEvents = std::max(0, std::min(maxEvents, 256));
+    MouseEventInfo events[256];
+    int count = mouse_poll_events(events, maxEvents);
+
+    lua_createtable(L, count, 0);
+    for (int i = 0; i < count; i++) {
+        lua_push_mouse_event(L, events[i]);
+        lua_rawseti(L, -2, i + 1);
+    }
+    return 1;
+}
+
+// mouse_wait_event([timeout_ms]) -> event | nil on timeout or interrupt
+static int lua_superterminal_mouse_wait_event(lua_State* L) {
+    int timeoutMs = (int)luaL_optinteger(L, 1, -1);
+    MouseEventInfo event;
+    if (!mouse_wait_event(&event, timeoutMs)) {
+        lua_pushnil(L);
+        return 1;
+    }
+    lua_push_mouse_event(L, event);
+    return 1;
+}
+
 static int lua_superterminal_sprite_mouse_over(lua_State* L) {
     uint16_t sprite_id = luaL_checkinteger(L, 1);
     bool over = sprite_mouse_over(sprite_id);
@@ -3101,6 +3331,78 @@ static int lua_superterminal_sprite_mouse_over(lua_State* L) {
     return 1;
 }
 
+// Push a picked sprite id, or nil when nothing was hit
+static int lua_push_picked_sprite(lua_State* L, uint16_t sprite_id) {
+    if (sprite_id == 0) {
+        lua_pushnil(L);
+    } else {
+        lua_pushinteger(L, sprite_id);
+    }
+    return 1;
+}
+
+// Push picked sprite ids as an array, topmost first
+static int lua_push_picked_sprites(lua_State* L, const uint16_t* ids, int count) {
+    lua_newtable(L);
+    for (int i = 0; i < count; i++) {
+        lua_pushinteger(L, ids[i]);
+        lua_rawseti(L, -2, i + 1);
+    }
+    return 1;
+}
+
+// sprite_mouse_pick() -> topmost sprite id under the cursor | nil
+static int lua_superterminal_sprite_mouse_pick(lua_State* L) {
+    return lua_push_picked_sprite(L, sprite_mouse_pick());
+}
+
+static int lua_superterminal_mouse_get_sprite_position(lua_State* L) {
+    float x, y;
+    mouse_get_sprite_position(&x, &y);
+    lua_pushnumber(L, x);
+    lua_pushnumber(L, y);
+    return 2;
+}
+
+// sprite_pick(x, y, [pixel_accurate]) -> topmost sprite id | nil
+static int lua_superterminal_sprite_pick(lua_State* L) {
+    float x = luaL_checknumber(L, 1);
+    float y = luaL_checknumber(L, 2);
+    bool pixelAccurate = lua_toboolean(L, 3);
+    return lua_push_picked_sprite(L, sprite_pick(x, y, pixelAccurate));
+}
+
+// sprite_pick_all(x, y, [pixel_accurate]) -> {ids, topmost first}
+static int lua_superterminal_sprite_pick_all(lua_State* L) {
+    float x = luaL_checknumber(L, 1);
+    float y = luaL_checknumber(L, 2);
+    bool pixelAccurate = lua_toboolean(L, 3);
+    uint16_t ids[1024];
+    int count = std::min(sprite_pick_all(x, y, pixelAccurate, ids, 1024), 1024);
+    return lua_push_picked_sprites(L, ids, count);
+}
+
+// sprite_pick_rect(x, y, width, height) -> {ids, topmost first}
+static int lua_superterminal_sprite_pick_rect(lua_State* L) {
+    float x = luaL_checknumber(L, 1);
+    float y = luaL_checknumber(L, 2);
+    float width = luaL_checknumber(L, 3);
+    float height = luaL_checknumber(L, 4);
+    uint16_t ids[1024];
+    int count = std::min(sprite_pick_rect(x, y, width, height, ids, 1024), 1024);
+    return lua_push_picked_sprites(L, ids, count);
+}
+
+// sprite_hit_test(id, x, y, [pixel_accurate]) -> bool
+static int lua_superterminal_sprite_hit_test(lua_State* L) {
+    uint16_t sprite_id = luaL_checkinteger(L, 1);
+    float x = luaL_checknumber(L, 2);
+    float y = luaL_checknumber(L, 3);
+    bool pixelAccurate = lua_toboolean(L, 4);
+    lua_pushboolean(L, sprite_hit_test(sprite_id, x, y, pixelAccurate));
+    return 1;
+}
+
 static int lua_superterminal_mouse_screen_to_text(lua_State* L) {
     float screen_x = luaL_checknumber(L, 1);
     float screen_y = luaL_checknumber(L, 2);
@@ -3634,6 +3936,85 @@ static int lua_superterminal_tile_create_map(lua_State* L) {
     return 0;
 }
 
+// tile_animation(base_tile, {frame tiles...}, frame_seconds)
+// Cells holding base_tile cycle through the frames; the map is unchanged
+static int lua_superterminal_tile_animation(lua_State* L) {
+    uint16_t baseTile = luaL_checkinteger(L, 1);
+    luaL_checktype(L, 2, LUA_TTABLE);
+    float frameDuration = luaL_checknumber(L, 3);
+
+    int frameCount = (int)lua_objlen(L, 2);
+    std::vector<uint16_t> frames;
+    frames.reserve(frameCount);
+    for (int i = 0; i < frameCount; i++) {
+        lua_rawgeti(L, 2, i + 1); // Lua is 1-indexed
+        if (!lua_isnumber(L, -1)) {
+            return luaL_error(L, "tile_animation: frames must be tile ids");
+        }
+        frames.push_back((uint16_t)lua_tointeger(L, -1));
+        lua_pop(L, 1);
+    }
+    lua_pushboolean(L, tile_animation_define(baseTile, frames.data(), frameCount, frameDuration));
+    return 1;
+}
+
+static int lua_superterminal_tile_animation_frame_duration(lua_State* L) {
+    uint16_t baseTile = luaL_checkinteger(L, 1);
+    int frameIndex = luaL_checkinteger(L, 2);
+    float seconds = luaL_checknumber(L, 3);
+    lua_pushboolean(L, tile_animation_set_frame_duration(baseTile, frameIndex, seconds));
+    return 1;
+}
+
+static int lua_superterminal_tile_animation_remove(lua_State* L) {
+    uint16_t baseTile = luaL_checkinteger(L, 1);
+    lua_pushboolean(L, tile_animation_remove(baseTile));
+    return 1;
+}
+
+static int lua_superterminal_tile_animation_clear(lua_State* L) {
+    tile_animation_clear();
+    return 0;
+}
+
+static int lua_superterminal_tile_animation_pause(lua_State* L) {
+    tile_animation_set_paused(lua_toboolean(L, 1));
+    return 0;
+}
+
+static int lua_superterminal_tile_animation_frame(lua_State* L) {
+    uint16_t tileId = luaL_checkinteger(L, 1);
+    lua_pushinteger(L, tile_animation_get_frame(tileId));
+    return 1;
+}
+
+// Trace capture functions
+static int lua_superterminal_trace_start(lua_State* L) {
+    trace_start();
+    return 0;
+}
+
+static int lua_superterminal_trace_stop(lua_State* L) {
+    trace_stop();
+    return 0;
+}
+
+static int lua_superterminal_trace_is_active(lua_State* L) {
+    lua_pushboolean(L, trace_is_active());
+    return 1;
+}
+
+static int lua_superterminal_trace_clear(lua_State* L) {
+    trace_clear();
+    return 0;
+}
+
+static int lua_superterminal_trace_dump(lua_State* L) {
+    const char* path = luaL_checkstring(L, 1);
+    lua_pushboolean(L, trace_dump(path));
+    return 1;
+}
+
 // Layer control functions
 static int lua_superterminal_layer_set_enabled(lua_State* L) {
     int layer = luaL_checkinteger(L, 1);
@@ -4006,6 +4387,123 @@ static int lua_superterminal_sprite_get_size(lua_State* L) {
     return 2;
 }
 
+// sprite_atlas_grid(atlas_id, sprite_id, frame_w, frame_h, [margin], [spacing])
+// Cuts the loaded sprite's texture into a grid; returns the frame count
+static int lua_superterminal_sprite_atlas_grid(lua_State* L) {
+    uint32_t atlasId = luaL_checkinteger(L, 1);
+    uint16_t spriteId = luaL_checkinteger(L, 2);
+    int frameWidth = luaL_checkinteger(L, 3);
+    int frameHeight = luaL_checkinteger(L, 4);
+    int margin = luaL_optinteger(L, 5, 0);
+    int spacing = luaL_optinteger(L, 6, 0);
+    int width, height;
+    sprite_get_size(spriteId, &width, &height);
+    lua_pushinteger(L, sprite_atlas_define_grid(atlasId, width, height, frameWidth, frameHeight, margin, spacing));
+    return 1;
+}
+
+// sprite_clip(clip_id, atlas_id, first, last, frame_seconds, [mode])
+// Frames are 0-based; mode is "loop" (default), "once" or "pingpong"
+static int lua_superterminal_sprite_clip(lua_State* L) {
+    uint32_t clipId = luaL_checkinteger(L, 1);
+    uint32_t atlasId = luaL_checkinteger(L, 2);
+    int firstFrame = luaL_checkinteger(L, 3);
+    int lastFrame = luaL_checkinteger(L, 4);
+    float frameDuration = luaL_checknumber(L, 5);
+    const char* modeName = luaL_optstring(L, 6, "loop");
+    int mode;
+    if (strcmp(modeName, "once") == 0) {
+        mode = 0;
+    } else if (strcmp(modeName, "loop") == 0) {
+        mode = 1;
+    } else if (strcmp(modeName, "pingpong") == 0) {
+        mode = 2;
+    } else {
+        return luaL_error(L, "sprite_clip: unknown mode '%s' (once, loop, pingpong)", modeName);
+    }
+    lua_pushboolean(L, sprite_clip_define(clipId, atlasId, firstFrame, lastFrame, frameDuration, mode));
+    return 1;
+}
+
+static int lua_superterminal_sprite_clip_frame_duration(lua_State* L) {
+    uint32_t clipId = luaL_checkinteger(L, 1);
+    int clipFrame = luaL_checkinteger(L, 2);
+    float seconds = luaL_checknumber(L, 3);
+    lua_pushboolean(L, sprite_clip_set_frame_duration(clipId, clipFrame, seconds));
+    return 1;
+}
+
+static int lua_superterminal_sprite_clip_event(lua_State* L) {
+    uint32_t clipId = luaL_checkinteger(L, 1);
+    int clipFrame = luaL_checkinteger(L, 2);
+    int eventId = luaL_checkinteger(L, 3);
+    lua_pushboolean(L, sprite_clip_add_event(clipId, clipFrame, eventId));
+    return 1;
+}
+
+// sprite_play(sprite_id, clip_id, [speed]) - restarts only if the clip changed
+static int lua_superterminal_sprite_play(lua_State* L) {
+    uint16_t spriteId = luaL_checkinteger(L, 1);
+    uint32_t clipId = luaL_checkinteger(L, 2);
+    float speed = luaL_optnumber(L, 3, 1.0);
+    lua_pushboolean(L, sprite_animation_play(spriteId, clipId, speed, false));
+    return 1;
+}
+
+static int lua_superterminal_sprite_stop(lua_State* L) {
+    uint16_t spriteId = luaL_checkinteger(L, 1);
+    sprite_animation_stop(spriteId);
+    return 0;
+}
+
+static int lua_superterminal_sprite_anim_pause(lua_State* L) {
+    uint16_t spriteId = luaL_checkinteger(L, 1);
+    sprite_animation_pause(spriteId, true);
+    return 0;
+}
+
+static int lua_superterminal_sprite_anim_resume(lua_State* L) {
+    uint16_t spriteId = luaL_checkinteger(L, 1);
+    sprite_animation_pause(spriteId, false);
+    return 0;
+}
+
+static int lua_superterminal_sprite_anim_speed(lua_State* L) {
+    uint16_t spriteId = luaL_checkinteger(L, 1);
+    float speed = luaL_checknumber(L, 2);
+    sprite_animation_set_speed(spriteId, speed);
+    return 0;
+}
+
+static int lua_superterminal_sprite_anim_frame(lua_State* L) {
+    uint16_t spriteId = luaL_checkinteger(L, 1);
+    lua_pushinteger(L, sprite_animation_get_frame(spriteId));
+    return 1;
+}
+
+static int lua_superterminal_sprite_anim_playing(lua_State* L) {
+    uint16_t spriteId = luaL_checkinteger(L, 1);
+    lua_pushboolean(L, sprite_animation_is_playing(spriteId));
+    return 1;
+}
+
+// sprite_anim_poll() -> sprite_id, clip_id, kind ("frame"/"loop"/"finished"), event_id | nil
+static int lua_superterminal_sprite_anim_poll(lua_State* L) {
+    static const char* kinds[] = {"frame", "loop", "finished"};
+    uint16_t spriteId;
+    uint32_t clipId;
+    int type, eventId;
+    if (!sprite_animation_poll_event(&spriteId, &clipId, &type, &eventId)) {
+        lua_pushnil(L);
+        return 1;
+    }
+    lua_pushinteger(L, spriteId);
+    lua_pushinteger(L, clipId);
+    lua_pushstring(L, kinds[type]);
+    lua_pushinteger(L, eventId);
+    return 4;
+}
+
 static int lua_superterminal_wait_frame(lua_State* L) {
     // wait_frame() blocks until next frame - frame sync should be thread-safe
     // Don't use command queue as it would cause deadlock
@@ -4251,4 +4749,160 @@ static int lua_superterminal_overlay_is_visible(lua_State* L) {
 static int lua_superterminal_overlay_present(lua_State* L) {
     overlay_present();
     return 0;
+}
+
+// Retained overlay widgets: the create functions return a widget ID (0 on
+// error), setters return true if the widget exists
+
+static int lua_superterminal_overlay_widget_panel(lua_State* L) {
+    uint32_t parent = (uint32_t)luaL_checkinteger(L, 1);
+    float x = luaL_checknumber(L, 2);
+    float y = luaL_checknumber(L, 3);
+    float w = luaL_checknumber(L, 4);
+    float h = luaL_checknumber(L, 5);
+    lua_pushinteger(L, overlay_widget_panel(parent, x, y, w, h));
+    return 1;
+}
+
+static int lua_superterminal_overlay_widget_label(lua_State* L) {
+    uint32_t parent = (uint32_t)luaL_checkinteger(L, 1);
+    float x = luaL_checknumber(L, 2);
+    float y = luaL_checknumber(L, 3);
+    float w = luaL_checknumber(L, 4);
+    float h = luaL_checknumber(L, 5);
+    const char* text = luaL_checkstring(L, 6);
+    float fontSize = luaL_optnumber(L, 7, 16.0);
+    lua_pushinteger(L, overlay_widget_label(parent, x, y, w, h, text, fontSize));
+    return 1;
+}
+
+static int lua_superterminal_overlay_widget_bar(lua_State* L) {
+    uint32_t parent = (uint32_t)luaL_checkinteger(L, 1);
+    float x = luaL_checknumber(L, 2);
+    float y = luaL_checknumber(L, 3);
+    float w = luaL_checknumber(L, 4);
+    float h = luaL_checknumber(L, 5);
+    float value = luaL_optnumber(L, 6, 1.0);
+    lua_pushinteger(L, overlay_widget_bar(parent, x, y, w, h, value));
+    return 1;
+}
+
+static int lua_superterminal_overlay_widget_image(lua_State* L) {
+    uint32_t parent = (uint32_t)luaL_checkinteger(L, 1);
+    float x = luaL_checknumber(L, 2);
+    float y = luaL_checknumber(L, 3);
+    float w = luaL_checknumber(L, 4);
+    float h = luaL_checknumber(L, 5);
+    uint16_t imageId = (uint16_t)luaL_checkinteger(L, 6);
+    lua_pushinteger(L, overlay_widget_image(parent, x, y, w, h, imageId));
+    return 1;
+}
+
+static int lua_superterminal_overlay_widget_remove(lua_State* L) {
+    uint32_t id = (uint32_t)luaL_checkinteger(L, 1);
+    lua_pushboolean(L, overlay_widget_remove(id));
+    return 1;
+}
+
+static int lua_superterminal_overlay_widget_clear(lua_State* L) {
+    overlay_widget_clear();
+    return 0;
+}
+
+static int lua_superterminal_overlay_widget_set_position(lua_State* L) {
+    uint32_t id = (uint32_t)luaL_checkinteger(L, 1);
+    float x = luaL_checknumber(L, 2);
+    float y = luaL_checknumber(L, 3);
+    lua_pushboolean(L, overlay_widget_set_position(id, x, y));
+    return 1;
+}
+
+static int lua_superterminal_overlay_widget_set_size(lua_State* L) {
+    uint32_t id = (uint32_t)luaL_checkinteger(L, 1);
+    float w = luaL_checknumber(L, 2);
+    float h = luaL_checknumber(L, 3);
+    lua_pushboolean(L, overlay_widget_set_size(id, w, h));
+    return 1;
+}
+
+static int lua_superterminal_overlay_widget_set_visible(lua_State* L) {
+    uint32_t id = (uint32_t)luaL_checkinteger(L, 1);
+    bool visible = lua_toboolean(L, 2);
+    lua_pushboolean(L, overlay_widget_set_visible(id, visible));
+    return 1;
+}
+
+static int lua_superterminal_overlay_widget_set_z(lua_State* L) {
+    uint32_t id = (uint32_t)luaL_checkinteger(L, 1);
+    int z = (int)luaL_checkinteger(L, 2);
+    lua_pushboolean(L, overlay_widget_set_z(id, z));
+    return 1;
+}
+
+static int lua_superterminal_overlay_widget_set_color(lua_State* L) {
+    uint32_t id = (uint32_t)luaL_checkinteger(L, 1);
+    float r = luaL_checknumber(L, 2);
+    float g = luaL_checknumber(L, 3);
+    float b = luaL_checknumber(L, 4);
+    float a = luaL_optnumber(L, 5, 1.0);
+    lua_pushboolean(L, overlay_widget_set_color(id, r, g, b, a));
+    return 1;
+}
+
+static int lua_superterminal_overlay_widget_set_back_color(lua_State* L) {
+    uint32_t id = (uint32_t)luaL_checkinteger(L, 1);
+    float r = luaL_checknumber(L, 2);
+    float g = luaL_checknumber(L, 3);
+    float b = luaL_checknumber(L, 4);
+    float a = luaL_optnumber(L, 5, 1.0);
+    lua_pushboolean(L, overlay_widget_set_back_color(id, r, g, b, a));
+    return 1;
+}
+
+static int lua_superterminal_overlay_widget_set_border(lua_State* L) {
+    uint32_t id = (uint32_t)luaL_checkinteger(L, 1);
+    float width = luaL_checknumber(L, 2);
+    lua_pushboolean(L, overlay_widget_set_border(id, width));
+    return 1;
+}
+
+static int lua_superterminal_overlay_widget_set_text(lua_State* L) {
+    uint32_t id = (uint32_t)luaL_checkinteger(L, 1);
+    const char* text = luaL_checkstring(L, 2);
+    lua_pushboolean(L, overlay_widget_set_text(id, text));
+    return 1;
+}
+
+static int lua_superterminal_overlay_widget_set_font_size(lua_State* L) {
+    uint32_t id = (uint32_t)luaL_checkinteger(L, 1);
+    float fontSize = luaL_checknumber(L, 2);
+    lua_pushboolean(L, overlay_widget_set_font_size(id, fontSize));
+    return 1;
+}
+
+static int lua_superterminal_overlay_widget_set_value(lua_State* L) {
+    uint32_t id = (uint32_t)luaL_checkinteger(L, 1);
+    float value = luaL_checknumber(L, 2);
+    lua_pushboolean(L, overlay_widget_set_value(id, value));
+    return 1;
+}
+
+static int lua_superterminal_overlay_widget_set_vertical(lua_State* L) {
+    uint32_t id = (uint32_t)luaL_checkinteger(L, 1);
+    bool vertical = lua_toboolean(L, 2);
+    lua_pushboolean(L, overlay_widget_set_vertical(id, vertical));
+    return 1;
+}
+
+static int lua_superterminal_overlay_widget_set_image(lua_State* L) {
+    uint32_t id = (uint32_t)luaL_checkinteger(L, 1);
+    uint16_t imageId = (uint16_t)luaL_checkinteger(L, 2);
+    lua_pushboolean(L, overlay_widget_set_image(id, imageId));
+    return 1;
+}
+
+static int lua_superterminal_overlay_widget_invalidate(lua_State* L) {
+    uint32_t id = (uint32_t)luaL_checkinteger(L, 1);
+    lua_pushboolean(L, overlay_widget_invalidate(id));
+    return 1;
 }
\ No newline at end of file
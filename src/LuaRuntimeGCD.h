@@ -72,6 +72,31 @@ bool lua_gcd_exec_file(const char* filename);
  */
 bool lua_gcd_exec_repl(const char* lua_code);
 
+/**
+ * Callbacks for streaming REPL execution. Both receive the context pointer
+ * passed to lua_gcd_exec_repl_streaming and are called on the executing thread.
+ */
+typedef void (*lua_gcd_repl_output_fn)(const char* line, void* context);
+typedef bool (*lua_gcd_repl_cancel_fn)(void* context);
+
+/**
+ * Execute Lua code in the persistent REPL state, streaming output.
+ * Every print() from the chunk is passed to output as it happens (and still
+ * printed to the text screen). should_cancel is polled from the Lua
+ * instruction hook; returning true aborts the chunk with an error.
+ * Safe to call from any thread; REPL calls are serialised.
+ *
+ * @param lua_code Chunk to evaluate
+ * @param output Optional line callback
+ * @param should_cancel Optional cancellation check
+ * @param context Passed to both callbacks
+ * @return true if execution succeeded, false on error or cancellation
+ */
+bool lua_gcd_exec_repl_streaming(const char* lua_code,
+                                 lua_gcd_repl_output_fn output,
+                                 lua_gcd_repl_cancel_fn should_cancel,
+                                 void* context);
+
 // ============================================================================
 // MARK: - Script Control
 // ============================================================================
@@ -92,6 +117,14 @@ bool lua_gcd_stop_script(void);
  */
 bool lua_gcd_is_script_running(void);
 
+/**
+ * Make sure a script Lua state (standard libraries and SuperTerminal APIs
+ * registered) is ready for the next lua_gcd_exec. One is normally built
+ * while the queue is idle after each script; this queues one if it is
+ * missing. Each script still gets its own state, so no globals carry over.
+ */
+void lua_gcd_prepare_script_state(void);
+
 /**
  * Get the name of the currently running script.
  * 
@@ -9,6 +9,7 @@
 #import <Foundation/Foundation.h>
 #import <dispatch/dispatch.h>
 #include "LuaRuntimeGCD.h"
+#include "TraceEvents.h"
 
 extern "C" {
 #include <lua.h>
@@ -38,6 +39,7 @@ extern "C" void register_assets_lua_bindings(lua_State* L);
 
 // Forward declaration for GCD-aware blocking operations
 extern "C" void register_lua_blocking_ops_gcd(lua_State* L);
+extern "C" void input_system_interrupt_mouse_waits(void);
 
 // ============================================================================
 // MARK: - Global State
@@ -61,10 +63,18 @@ static std::atomic<bool> g_script_running{false};
 static std::atomic<uint64_t> g_script_generation{0};
 static std::atomic<uint64_t> g_abandoned_generation{0};
 
+// Script state built ahead of the next run (only touched on the Lua queue)
+static lua_State* g_prepared_state = nullptr;
+
 // REPL persistent state
 static lua_State* g_repl_lua = nullptr;
 static std::mutex g_repl_mutex;
 
+// Streaming callbacks for the REPL chunk currently executing (set under g_repl_mutex)
+static lua_gcd_repl_output_fn g_repl_output = nullptr;
+static lua_gcd_repl_cancel_fn g_repl_should_cancel = nullptr;
+static void* g_repl_callback_context = nullptr;
+
 // Error tracking
 static std::string g_last_error;
 static std::mutex g_error_mutex;
@@ -141,6 +151,48 @@ static void lua_cancellation_hook(lua_State* L, lua_Debug* ar) {
     }
 }
 
+static void lua_repl_cancellation_hook(lua_State* L, lua_Debug* ar) {
+    if (g_repl_should_cancel && g_repl_should_cancel(g_repl_callback_context)) {
+        luaL_error(L, "REPL command cancelled");
+    }
+}
+
+// ============================================================================
+// MARK: - REPL print
+// ============================================================================
+
+// print() for the REPL state: streams the line to the REPL output callback,
+// then forwards it to the original print (upvalue 1) for the text screen
+static int lua_repl_print(lua_State* L) {
+    int n = lua_gettop(L);
+    std::string line;
+
+    lua_getglobal(L, "tostring");
+    for (int i = 1; i <= n; i++) {
+        lua_pushvalue(L, -1);
+        lua_pushvalue(L, i);
+        lua_call(L, 1, 1);
+        const char* text = lua_tostring(L, -1);
+        if (i > 1) {
+            line += '\t';
+        }
+        line += text ? text : "";
+        lua_pop(L, 1);
+    }
+    lua_pop(L, 1);
+
+    if (g_repl_output) {
+        g_repl_output(line.c_str(), g_repl_callback_context);
+    }
+
+    if (lua_isfunction(L, lua_upvalueindex(1))) {
+        lua_pushvalue(L, lua_upvalueindex(1));
+        lua_pushlstring(L, line.data(), line.size());
+        lua_call(L, 1, 0);
+    }
+    return 0;
+}
+
 // ============================================================================
 // MARK: - Lua Panic Handler
 // ============================================================================
@@ -160,6 +212,65 @@ static int lua_panic_handler(lua_State* L) {
 // MARK: - Script Execution
 // ============================================================================
 
+// Fresh script state: standard libraries plus the SuperTerminal APIs.
+// Building it is most of a script's startup cost, so it is done ahead of time.
+static lua_State* create_script_state() {
+    TRACE_SCOPE("lua", "create state");
+    lua_State* L = luaL_newstate();
+    if (!L) {
+        return nullptr;
+    }
+
+    // Set panic handler
+    lua_atpanic(L, lua_panic_handler);
+
+    // Open standard libraries
+    luaL_openlibs(L);
+
+    // Register SuperTerminal APIs
+    try {
+        TRACE_SCOPE("lua", "register APIs");
+        log_debug("Registering SuperTerminal API...");
+        register_superterminal_api(L);
+
+        log_debug("Registering particle system API...");
+        register_particle_system_lua_api(L);
+
+        log_debug("Registering audio bindings...");
+        register_audio_lua_bindings(L);
+
+        log_debug("Registering assets bindings...");
+        register_assets_lua_bindings(L);
+
+        log_debug("Registering GCD-aware blocking operations...");
+        register_lua_blocking_ops_gcd(L);
+
+    } catch (const std::exception& e) {
+        log_debug("Warning: Failed to register some APIs: %s", e.what());
+    }
+
+    return L;
+}
+
+// Build the next run's state if none is waiting (Lua queue only)
+static void prepare_script_state() {
+    if (!g_prepared_state) {
+        g_prepared_state = create_script_state();
+        log_debug("Prepared script state %s", g_prepared_state ? "ready" : "failed");
+    }
+}
+
+// Hand the prepared state to a starting script (Lua queue only). States are
+// never reused across runs, so nothing one script defines leaks into the next.
+static lua_State* take_script_state() {
+    lua_State* L = g_prepared_state;
+    g_prepared_state = nullptr;
+    if (!L) {
+        L = create_script_state();
+    }
+    return L;
+}
+
 // RAII guard to ensure g_script_running is always reset
 struct ScriptRunningGuard {
     uint64_t my_generation;
@@ -196,6 +307,8 @@ static void execute_lua_script(const std::string& script_code, const std::string
 
     // Use RAII guard to ensure g_script_running is always reset
     ScriptRunningGuard guard;
+    TRACE_THREAD_NAME("Lua script queue");
+    TRACE_SCOPE("lua", "script");
 
     fprintf(stderr, "[GCD] ScriptRunningGuard created, g_script_running should be true now\n");
     fflush(stderr);
@@ -205,41 +318,14 @@ static void execute_lua_script(const std::string& script_code, const std::string
         g_current_script_name = script_name;
     }
 
-    // Create new Lua state for this script
-    lua_State* L = luaL_newstate();
+    // Start from the state prepared while the queue was idle, if there is one
+    lua_State* L = take_script_state();
     if (!L) {
         set_error("Failed to create Lua state");
         g_failed_scripts++;
         return;
     }
 
-    // Set panic handler
-    lua_atpanic(L, lua_panic_handler);
-
-    // Open standard libraries
-    luaL_openlibs(L);
-
-    // Register SuperTerminal APIs
-    try {
-        log_debug("Registering SuperTerminal API...");
-        register_superterminal_api(L);
-
-        log_debug("Registering particle system API...");
-        register_particle_system_lua_api(L);
-
-        log_debug("Registering audio bindings...");
-        register_audio_lua_bindings(L);
-
-        log_debug("Registering assets bindings...");
-        register_assets_lua_bindings(L);
-
-        log_debug("Registering GCD-aware blocking operations...");
-        register_lua_blocking_ops_gcd(L);
-
-    } catch (const std::exception& e) {
-        log_debug("Warning: Failed to register some APIs: %s", e.what());
-    }
-
     // Set cancellation hook
     int hook_freq = g_hook_frequency.load();
     lua_sethook(L, lua_cancellation_hook, LUA_MASKCOUNT, hook_freq);
@@ -247,7 +333,11 @@ static void execute_lua_script(const std::string& script_code, const std::string
 
     // Execute the script
     log_debug("Running luaL_dostring...");
-    int result = luaL_dostring(L, script_code.c_str());
+    int result;
+    {
+        TRACE_SCOPE("lua", "run chunk");
+        result = luaL_dostring(L, script_code.c_str());
+    }
 
     // Check if script was cancelled by checking if it's still running
     bool was_cancelled = !g_script_running.load();
@@ -321,6 +411,11 @@ bool lua_gcd_initialize(void) {
     g_initialized = true;
     log_debug("Lua GCD runtime initialized successfully");
 
+    // The first Run Script starts from a ready state too
+    dispatch_async(g_lua_queue, ^{
+        prepare_script_state();
+    });
+
     return true;
 }
 
@@ -341,6 +436,10 @@ void lua_gcd_shutdown(void) {
 
     // Wait for queue to drain
     dispatch_sync(g_lua_queue, ^{
+        if (g_prepared_state) {
+            lua_close(g_prepared_state);
+            g_prepared_state = nullptr;
+        }
         log_debug("Queue drained");
     });
 
@@ -413,6 +512,8 @@ bool lua_gcd_exec(const char* lua_code, const char* script_name) {
         DISPATCH_BLOCK_INHERIT_QOS_CLASS,
         ^{
             execute_lua_script(code, name);
+            // Script is no longer running; build the next run's state while idle
+            prepare_script_state();
         }
     );
 
@@ -464,6 +565,13 @@ bool lua_gcd_exec_file(const char* filename) {
 }
 
 bool lua_gcd_exec_repl(const char* lua_code) {
+    return lua_gcd_exec_repl_streaming(lua_code, nullptr, nullptr, nullptr);
+}
+
+bool lua_gcd_exec_repl_streaming(const char* lua_code,
+                                 lua_gcd_repl_output_fn output,
+                                 lua_gcd_repl_cancel_fn should_cancel,
+                                 void* context) {
     using namespace LuaGCD;
 
     if (!g_initialized.load()) {
@@ -507,10 +615,28 @@ bool lua_gcd_exec_repl(const char* lua_code) {
         } catch (...) {
             log_debug("Warning: Failed to register some REPL APIs");
         }
+
+        // Stream print() to the REPL and let long chunks be interrupted
+        lua_getglobal(g_repl_lua, "print");
+        lua_pushcclosure(g_repl_lua, lua_repl_print, 1);
+        lua_setglobal(g_repl_lua, "print");
+        lua_sethook(g_repl_lua, lua_repl_cancellation_hook, LUA_MASKCOUNT, g_hook_frequency.load());
     }
 
+    g_repl_output = output;
+    g_repl_should_cancel = should_cancel;
+    g_repl_callback_context = context;
+
     // Execute code
-    int result = luaL_dostring(g_repl_lua, lua_code);
+    int result;
+    {
+        TRACE_SCOPE("lua", "REPL chunk");
+        result = luaL_dostring(g_repl_lua, lua_code);
+    }
+
+    g_repl_output = nullptr;
+    g_repl_should_cancel = nullptr;
+    g_repl_callback_context = nullptr;
 
     if (result != LUA_OK) {
         const char* error = lua_tostring(g_repl_lua, -1);
@@ -547,12 +673,28 @@ bool lua_gcd_stop_script(void) {
     // Clear the running flag so new scripts can start immediately
     g_script_running = false;
 
+    // Release a script blocked in a mouse wait right away
+    input_system_interrupt_mouse_waits();
+
     fprintf(stderr, "[GCD] Script abandoned - new scripts can run immediately\n");
     fflush(stderr);
 
     return true;
 }
 
+void lua_gcd_prepare_script_state(void) {
+    using namespace LuaGCD;
+
+    if (!g_initialized.load() || !g_lua_queue) {
+        return;
+    }
+
+    // Queued behind a stopped script still unwinding, ahead of the next one
+    dispatch_async(g_lua_queue, ^{
+        prepare_script_state();
+    });
+}
+
 bool lua_gcd_is_script_running(void) {
     // A script is "running" if the flag is set AND it hasn't been abandoned
     bool flag_running = LuaGCD::g_script_running.load();
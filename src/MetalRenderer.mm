@@ -13,6 +13,7 @@
 #import <simd/simd.h>
 #include "TextCommon.h"
 #include "CoreTextRenderer.h"
+#include "FrameArena.h"
 // ParticleSystemC.h removed - C API declarations now in ParticleSystem.h (forward declared above)
 #include <mutex>
 #include <condition_variable>
@@ -26,8 +27,9 @@ extern "C" {
     void audio_check_emergency_shutdown(); // Check audio system emergency shutdown
     void editor_update(); // Update text editor system
     bool command_queue_process_single(); // Process single command from queue
-    void particle_system_update(float delta_time); // Update particle physics (v2 - main loop)
+    int simulation_advance(float frame_seconds); // Advance fixed-step simulation (particles, bullets)
     void particle_system_render(void* encoder, simd_float4x4 projectionMatrix); // Render particles (v2)
+    void bullet_system_render_patterns(void* encoder, void* command_buffer); // Render pattern bullets (instanced)
 
     // Editor cursor functions
     bool editor_is_active(void);
@@ -36,6 +38,7 @@ extern "C" {
 
     // REPL Console functions
     bool repl_is_active();
+    bool repl_is_initialized();
     void repl_update(float delta_time);
     void repl_render();
 
@@ -121,7 +124,7 @@ extern "C" bool superterminal_layer_is_enabled(int layer);
 - (void)renderEditorTextLayer:(id<MTLRenderCommandEncoder>)encoder viewport:(CGSize)viewport;
 - (void)renderGraphicsLayer:(id<MTLRenderCommandEncoder>)encoder viewport:(CGSize)viewport;
 - (void)renderSpriteLayer:(id<MTLRenderCommandEncoder>)encoder viewport:(CGSize)viewport;
-- (void)renderParticleLayer:(id<MTLRenderCommandEncoder>)encoder viewport:(CGSize)viewport;
+- (void)renderParticleLayer:(id<MTLRenderCommandEncoder>)encoder commandBuffer:(id<MTLCommandBuffer>)commandBuffer viewport:(CGSize)viewport;
 - (void)renderOverlayLayer:(id<MTLRenderCommandEncoder>)encoder viewport:(CGSize)viewport;
 
 @end
@@ -357,7 +360,7 @@ extern "C" void metal_renderer_wait_frame() {
     // LAYER 8: Render particle layer (frontmost layer for explosions and effects)
     if (superterminal_layer_is_enabled(8)) {
         // NSLog(@"MetalRenderer: Rendering Layer 8 (particle layer)");
-        [self renderParticleLayer:renderEncoder viewport:CGSizeMake(self.metalView.drawableSize.width, self.metalView.drawableSize.height)];
+        [self renderParticleLayer:renderEncoder commandBuffer:commandBuffer viewport:CGSizeMake(self.metalView.drawableSize.width, self.metalView.drawableSize.height)];
         // NSLog(@"MetalRenderer: Layer 8 (particle) render complete");
     } else {
         // NSLog(@"MetalRenderer: Particle layer DISABLED - skipping");
@@ -388,6 +391,15 @@ extern "C" void metal_renderer_wait_frame() {
     }];
 
     [commandBuffer commit];
+
+    // Frame scratch from this thread is dead now; report if it spilled to the heap
+    FrameArena& frameArena = FrameArena::forThread();
+    frameArena.reset();
+    if (frameArena.getLastFrameOverflowBytes() > 0) {
+        NSLog(@"MetalRenderer: Frame arena overflowed by %zu bytes (peak %zu, capacity now %zu)",
+              frameArena.getLastFrameOverflowBytes(), frameArena.getFrameHighWater(),
+              frameArena.getCapacity());
+    }
 }
 
 // MARK: - MTKViewDelegate
@@ -486,12 +498,13 @@ extern "C" void metal_renderer_wait_frame() {
     float delta_time = std::chrono::duration<float>(current_time - last_frame_time).count();
     last_frame_time = current_time;
 
-    if (repl_is_active()) {
+    // Also while hidden, so output from a running REPL command is drained
+    if (repl_is_initialized()) {
         repl_update(delta_time);
     }
 
-    // Update particle system physics (v2 - simplified, runs in main loop)
-    particle_system_update(delta_time);
+    // Advance the fixed-timestep simulation (particles, bullets, sprite effects)
+    simulation_advance(delta_time);
 
     // Update frame-based music player timing
     music_update_frame();
@@ -535,7 +548,7 @@ extern "C" void metal_renderer_wait_frame() {
     sprite_layer_render((__bridge void*)encoder, viewport.width, viewport.height);
 }
 
-- (void)renderParticleLayer:(id<MTLRenderCommandEncoder>)encoder viewport:(CGSize)viewport {
+- (void)renderParticleLayer:(id<MTLRenderCommandEncoder>)encoder commandBuffer:(id<MTLCommandBuffer>)commandBuffer viewport:(CGSize)viewport {
     // Render Layer 8: Particle layer (frontmost layer for explosions and effects)
     // NSLog(@"MetalRenderer: renderParticleLayer called with viewport %.0fx%.0f", viewport.width, viewport.height);
 
@@ -547,6 +560,7 @@ extern "C" void metal_renderer_wait_frame() {
         simd_make_float4(-1.0f, 1.0f, 0.0f, 1.0f)
     };
 
+    bullet_system_render_patterns((__bridge void*)encoder, (__bridge void*)commandBuffer);
     particle_system_render((__bridge void*)encoder, projectionMatrix);
 }
 
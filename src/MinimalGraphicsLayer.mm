@@ -9,9 +9,15 @@
 #import <Foundation/Foundation.h>
 #import <Metal/Metal.h>
 #import <simd/simd.h>
+#include <atomic>
 #include <vector>
 #include <map>
 
+extern "C" uint32_t superterminal_get_script_generation(void);
+
+// Script run that last queued drawing here (0 = nothing since the last release)
+static std::atomic<uint32_t> g_drawGeneration{0};
+
 #ifdef USE_SKIA
 #include "skia.h"
 #include "include/effects/SkGradientShader.h"
@@ -655,6 +661,9 @@ static void applyFiltersToPaint(SkPaint& paint) {
     if (command.type == GRAPHICS_CMD_DRAW_TEXT) {
         NSLog(@"WorkingSkiaGraphicsLayer: *** QUEUEING GRAPHICS_CMD_DRAW_TEXT: text='%s' ***", command.params.drawText.text);
     }
+    if (command.type != GRAPHICS_CMD_CLEAR) {
+        g_drawGeneration.store(superterminal_get_script_generation());
+    }
     NSData* commandData = [NSData dataWithBytes:&command length:sizeof(GraphicsCommand)];
     [self.queueCondition lock];
     [self.commandQueue addObject:commandData];
@@ -1718,6 +1727,17 @@ extern "C" {
         }
     }
 
+    // Clear the layer if a run up to this generation drew on it
+    int minimal_graphics_layer_release_generation(uint32_t generation) {
+        uint32_t drawn = g_drawGeneration.load();
+        if (!g_workingLayer || drawn == 0 || drawn > generation) {
+            return 0;
+        }
+        minimal_graphics_layer_clear();
+        g_drawGeneration.store(0);
+        return 1;
+    }
+
     void minimal_graphics_layer_set_color(float r, float g, float b, float a) {
         NSLog(@"minimal_graphics_layer_set_color: RGBA(%.2f, %.2f, %.2f, %.2f) - storing for next draw", r, g, b, a);
         // Store color in layer for next draw commands - no need to queue this
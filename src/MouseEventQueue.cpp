@@ -0,0 +1,168 @@
+//
+//  MouseEventQueue.cpp
+//  SuperTerminal Framework - Mouse Event Stream
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "MouseEventQueue.h"
+#include <algorithm>
+
+MouseEventQueue::MouseEventQueue(size_t capacity)
+    : m_capacity(capacity > 0 ? capacity : 1),
+      m_start(std::chrono::steady_clock::now()) {
+}
+
+uint64_t MouseEventQueue::push(MouseEvent event) {
+    if (event.timestamp == std::chrono::steady_clock::time_point()) {
+        event.timestamp = std::chrono::steady_clock::now();
+    }
+
+    uint64_t sequence;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        sequence = m_nextSequence++;
+        event.sequence = sequence;
+
+        // Coalesce runs of moves (newest position wins) and wheel steps
+        // (deltas add up). The merged event takes the new sequence so
+        // waiters still see it as new.
+        if (event.type == MouseEventType::Move && !m_events.empty() &&
+            m_events.back().type == MouseEventType::Move) {
+            m_events.back() = event;
+        } else if (event.type == MouseEventType::Wheel && !m_events.empty() &&
+                   m_events.back().type == MouseEventType::Wheel) {
+            event.deltaX += m_events.back().deltaX;
+            event.deltaY += m_events.back().deltaY;
+            m_events.back() = event;
+        } else {
+            if (m_events.size() >= m_capacity) {
+                m_events.pop_front();
+                m_dropped++;
+            }
+            m_events.push_back(event);
+        }
+    }
+    m_wake.notify_all();
+    return sequence;
+}
+
+size_t MouseEventQueue::drain(std::vector<MouseEvent>& out, size_t maxEvents) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t count = std::min(maxEvents, m_events.size());
+    out.insert(out.end(), m_events.begin(), m_events.begin() + count);
+    m_events.erase(m_events.begin(), m_events.begin() + count);
+    return count;
+}
+
+MouseWaitResult MouseEventQueue::waitUntil(std::unique_lock<std::mutex>& lock, int timeoutMs,
+                                           const CancelCheck& cancelled,
+                                           const std::function<bool()>& ready) {
+    uint64_t generation = m_interruptGeneration;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    for (;;) {
+        if (ready()) {
+            return MouseWaitResult::Event;
+        }
+        if (m_interruptGeneration != generation) {
+            return MouseWaitResult::Interrupted;
+        }
+        if (cancelled) {
+            // The predicate may take other locks; never hold ours while it runs
+            lock.unlock();
+            bool stop = cancelled();
+            lock.lock();
+            if (stop) {
+                return MouseWaitResult::Interrupted;
+            }
+            if (ready()) {
+                return MouseWaitResult::Event;
+            }
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (timeoutMs >= 0 && now >= deadline) {
+            return MouseWaitResult::Timeout;
+        }
+
+        // Events and interrupt() notify; the slice only bounds how long a
+        // cancel raised without interrupt() goes unnoticed
+        if (cancelled) {
+            auto wakeAt = now + std::chrono::milliseconds(CANCEL_POLL_MS);
+            m_wake.wait_until(lock, timeoutMs >= 0 ? std::min(wakeAt, deadline) : wakeAt);
+        } else if (timeoutMs >= 0) {
+            m_wake.wait_until(lock, deadline);
+        } else {
+            m_wake.wait(lock);
+        }
+    }
+}
+
+MouseWaitResult MouseEventQueue::waitPop(MouseEvent& out, int timeoutMs, const CancelCheck& cancelled) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    MouseWaitResult result = waitUntil(lock, timeoutMs, cancelled, [this] { return !m_events.empty(); });
+    if (result == MouseWaitResult::Event) {
+        out = m_events.front();
+        m_events.pop_front();
+    }
+    return result;
+}
+
+MouseWaitResult MouseEventQueue::waitFor(uint64_t afterSequence, uint32_t typeMask, int button, MouseEvent& out,
+                                         int timeoutMs, const CancelCheck& cancelled) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    // Remember how far the stream has been checked so each wake only
+    // tests events that arrived since
+    uint64_t examined = afterSequence;
+    auto match = [&]() {
+        for (const MouseEvent& event : m_events) {
+            if (event.sequence <= examined) {
+                continue;
+            }
+            if ((typeMask & maskOf(event.type)) && (button < 0 || event.button == button)) {
+                out = event;
+                return true;
+            }
+        }
+        if (!m_events.empty()) {
+            examined = std::max(examined, m_events.back().sequence);
+        }
+        return false;
+    };
+    return waitUntil(lock, timeoutMs, cancelled, match);
+}
+
+void MouseEventQueue::interrupt() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_interruptGeneration++;
+    }
+    m_wake.notify_all();
+}
+
+void MouseEventQueue::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_events.clear();
+}
+
+uint64_t MouseEventQueue::getLastSequence() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_nextSequence - 1;
+}
+
+size_t MouseEventQueue::getCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_events.size();
+}
+
+uint64_t MouseEventQueue::getDroppedCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_dropped;
+}
+
+double MouseEventQueue::secondsSinceStart(const MouseEvent& event) const {
+    return std::chrono::duration<double>(event.timestamp - m_start).count();
+}
@@ -0,0 +1,110 @@
+//
+//  MouseEventQueue.h
+//  SuperTerminal Framework - Mouse Event Stream
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+//  Bounded, timestamped stream of mouse presses, releases, moves and wheel
+//  steps. The window pushes events from the main thread; the script thread
+//  drains them in bulk or blocks in a wait that wakes as soon as an event is
+//  pushed or interrupt() is called, instead of polling button state.
+//
+//  Consecutive moves collapse into the newest position, and consecutive wheel
+//  steps into one summed delta, so a fast drag or fling cannot flood the
+//  queue. When full, the oldest event is dropped. Every event gets a
+//  sequence number, so waitFor() can look for an event newer than a point
+//  in the stream without consuming anything. One consumer thread.
+//
+
+#ifndef MouseEventQueue_h
+#define MouseEventQueue_h
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+enum class MouseEventType : uint8_t {
+    Press = 0,
+    Release = 1,
+    Move = 2,
+    Wheel = 3
+};
+
+struct MouseEvent {
+    MouseEventType type = MouseEventType::Move;
+    int button = -1;                // Press/Release only
+    float x = 0.0f, y = 0.0f;       // View position when the event happened
+    float deltaX = 0.0f, deltaY = 0.0f;     // Wheel only
+    std::chrono::steady_clock::time_point timestamp;
+    uint64_t sequence = 0;          // Assigned by push()
+};
+
+enum class MouseWaitResult : uint8_t {
+    Event = 0,
+    Timeout = 1,
+    Interrupted = 2
+};
+
+class MouseEventQueue {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 256;
+    static constexpr int CANCEL_POLL_MS = 100;     // How often a wait re-checks its cancel predicate
+
+    // Bit for each event type, for waitFor()
+    static constexpr uint32_t maskOf(MouseEventType type) { return 1u << static_cast<uint32_t>(type); }
+    static constexpr uint32_t ALL_EVENTS = 0xF;
+
+    using CancelCheck = std::function<bool()>;
+
+    explicit MouseEventQueue(size_t capacity = DEFAULT_CAPACITY);
+
+    // Stamp (if unset), sequence and queue an event; wakes all waiters.
+    // Returns the event's sequence number.
+    uint64_t push(MouseEvent event);
+
+    // Move up to maxEvents queued events to the caller, oldest first
+    size_t drain(std::vector<MouseEvent>& out, size_t maxEvents = SIZE_MAX);
+
+    // Pop the oldest event, blocking up to timeoutMs (negative waits forever)
+    MouseWaitResult waitPop(MouseEvent& out, int timeoutMs, const CancelCheck& cancelled = nullptr);
+
+    // Block until a queued event newer than afterSequence matches the type
+    // mask and button (-1 = any). The event is copied, not consumed.
+    MouseWaitResult waitFor(uint64_t afterSequence, uint32_t typeMask, int button, MouseEvent& out,
+                            int timeoutMs, const CancelCheck& cancelled = nullptr);
+
+    // Wake every current waiter with Interrupted (script stop, shutdown)
+    void interrupt();
+
+    void clear();
+
+    uint64_t getLastSequence() const;
+    size_t getCount() const;
+    uint64_t getDroppedCount() const;
+
+    // Seconds between the queue's creation and an event's timestamp
+    double secondsSinceStart(const MouseEvent& event) const;
+
+private:
+    size_t m_capacity;
+    std::chrono::steady_clock::time_point m_start;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<MouseEvent> m_events;
+    uint64_t m_nextSequence = 1;
+    uint64_t m_interruptGeneration = 0;
+    uint64_t m_dropped = 0;
+
+    // Shared wait loop: ready() is checked under the lock
+    MouseWaitResult waitUntil(std::unique_lock<std::mutex>& lock, int timeoutMs,
+                              const CancelCheck& cancelled, const std::function<bool()>& ready);
+};
+
+#endif /* MouseEventQueue_h */
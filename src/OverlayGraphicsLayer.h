@@ -12,6 +12,8 @@
 #ifndef OverlayGraphicsLayer_h
 #define OverlayGraphicsLayer_h
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -47,6 +49,30 @@ bool overlay_graphics_layer_is_visible(void);
 void overlay_graphics_layer_present(void);
 void overlay_graphics_layer_render_overlay(void* encoder, void* projectionMatrix);
 
+// Retained widgets (drawn above the immediate-mode overlay, repainted only
+// where they change). Parent 0 is the top level; creation returns 0 on error.
+uint32_t overlay_graphics_layer_widget_panel(uint32_t parent, float x, float y, float w, float h);
+uint32_t overlay_graphics_layer_widget_label(uint32_t parent, float x, float y, float w, float h,
+                                             const char* text, float fontSize);
+uint32_t overlay_graphics_layer_widget_bar(uint32_t parent, float x, float y, float w, float h, float value);
+uint32_t overlay_graphics_layer_widget_image(uint32_t parent, float x, float y, float w, float h,
+                                             uint16_t imageId);
+bool overlay_graphics_layer_widget_remove(uint32_t id);
+void overlay_graphics_layer_widget_clear(void);
+bool overlay_graphics_layer_widget_set_position(uint32_t id, float x, float y);
+bool overlay_graphics_layer_widget_set_size(uint32_t id, float w, float h);
+bool overlay_graphics_layer_widget_set_visible(uint32_t id, bool visible);
+bool overlay_graphics_layer_widget_set_z(uint32_t id, int z);
+bool overlay_graphics_layer_widget_set_color(uint32_t id, float r, float g, float b, float a);
+bool overlay_graphics_layer_widget_set_back_color(uint32_t id, float r, float g, float b, float a);
+bool overlay_graphics_layer_widget_set_border(uint32_t id, float width);
+bool overlay_graphics_layer_widget_set_text(uint32_t id, const char* text);
+bool overlay_graphics_layer_widget_set_font_size(uint32_t id, float fontSize);
+bool overlay_graphics_layer_widget_set_value(uint32_t id, float value);
+bool overlay_graphics_layer_widget_set_vertical(uint32_t id, bool vertical);
+bool overlay_graphics_layer_widget_set_image(uint32_t id, uint16_t imageId);
+bool overlay_graphics_layer_widget_invalidate(uint32_t id);
+
 #ifdef __cplusplus
 }
 #endif
@@ -12,8 +12,17 @@
 #import <Foundation/Foundation.h>
 #import <Metal/Metal.h>
 #import <simd/simd.h>
+#include <atomic>
 #include <vector>
 #include <map>
+#include <memory>
+#include <mutex>
+#include "OverlayWidgetTree.h"
+
+extern "C" uint32_t superterminal_get_script_generation(void);
+
+// Script run that last queued drawing here (0 = nothing since the last release)
+static std::atomic<uint32_t> g_drawGeneration{0};
 
 #ifdef USE_SKIA
 #include "skia.h"
@@ -321,10 +330,119 @@ static void applyFiltersToPaint(SkPaint& paint) {
     paint.setBlendMode(convertBlendMode(g_currentBlendMode));
 }
 
+// Retained widget tree, drawn into its own canvas above the immediate-mode
+// overlay. Script threads edit it; the render thread repaints its damage.
+static std::mutex g_widgetMutex;
+static std::unique_ptr<OverlayWidgetTree> g_widgetTree;
+
+static SkColor overlayWidgetSkColor(const OverlayWidgetColor& color) {
+    float r = fmax(0.0f, fmin(1.0f, color.r));
+    float g = fmax(0.0f, fmin(1.0f, color.g));
+    float b = fmax(0.0f, fmin(1.0f, color.b));
+    float a = fmax(0.0f, fmin(1.0f, color.a));
+    return SkColorSetARGB((int)(a * 255), (int)(r * 255), (int)(g * 255), (int)(b * 255));
+}
+
+// Same face as overlay_draw_text, looked up once instead of per draw
+static sk_sp<SkTypeface> overlayWidgetTypeface() {
+    static sk_sp<SkTypeface> typeface;
+    if (!typeface) {
+        sk_sp<SkFontMgr> fontMgr = SkFontMgr_New_CoreText(nullptr);
+        if (fontMgr) {
+            const char* families[] = {"Monaco", "Menlo", "SF Mono"};
+            for (const char* family : families) {
+                typeface = fontMgr->legacyMakeTypeface(family, SkFontStyle::Bold());
+                if (typeface) {
+                    break;
+                }
+            }
+        }
+        if (!typeface) {
+            typeface = SkTypeface::MakeEmpty();
+        }
+    }
+    return typeface;
+}
+
+// Paints damaged regions of the widget tree with Skia
+class OverlaySkiaWidgetPainter : public OverlayWidgetPainter {
+public:
+    OverlaySkiaWidgetPainter(SkCanvas* canvas, NSDictionary<NSNumber*, NSValue*>* images)
+        : m_canvas(canvas), m_images(images) {}
+
+    void beginRegion(const OverlayRect& region) override {
+        m_canvas->save();
+        m_canvas->clipRect(SkRect::MakeXYWH(region.x, region.y, region.w, region.h));
+        m_canvas->clear(SK_ColorTRANSPARENT);
+    }
+
+    void drawWidget(const OverlayWidget& widget) override {
+        SkRect box = SkRect::MakeXYWH(widget.worldX, widget.worldY, widget.width, widget.height);
+        SkPaint paint;
+        paint.setAntiAlias(true);
+
+        m_canvas->save();
+        m_canvas->clipRect(box);
+
+        switch (widget.kind) {
+            case OverlayWidgetKind::Panel: {
+                paint.setColor(overlayWidgetSkColor(widget.color));
+                m_canvas->drawRect(box, paint);
+                if (widget.borderWidth > 0.0f) {
+                    paint.setStyle(SkPaint::kStroke_Style);
+                    paint.setStrokeWidth(widget.borderWidth);
+                    paint.setColor(overlayWidgetSkColor(widget.backColor));
+                    m_canvas->drawRect(box.makeInset(widget.borderWidth * 0.5f, widget.borderWidth * 0.5f), paint);
+                }
+                break;
+            }
+
+            case OverlayWidgetKind::Label: {
+                SkFont font(overlayWidgetTypeface(), widget.fontSize);
+                paint.setColor(overlayWidgetSkColor(widget.color));
+                m_canvas->drawString(SkString(widget.text.c_str()),
+                                     widget.worldX, widget.worldY + widget.fontSize, font, paint);
+                break;
+            }
+
+            case OverlayWidgetKind::Bar: {
+                paint.setColor(overlayWidgetSkColor(widget.backColor));
+                m_canvas->drawRect(box, paint);
+                float x, y, w, h;
+                OverlayWidgetTree::barFillExtent(widget, x, y, w, h);
+                paint.setColor(overlayWidgetSkColor(widget.color));
+                m_canvas->drawRect(SkRect::MakeXYWH(x, y, w, h), paint);
+                break;
+            }
+
+            case OverlayWidgetKind::Image: {
+                NSValue* imageValue = m_images[@(widget.imageId)];
+                SkImage* image = imageValue ? (SkImage*)[imageValue pointerValue] : nullptr;
+                if (image) {
+                    paint.setAlphaf(fmax(0.0f, fmin(1.0f, widget.color.a)));
+                    m_canvas->drawImageRect(image, box, SkSamplingOptions(SkFilterMode::kLinear), &paint);
+                }
+                break;
+            }
+        }
+
+        m_canvas->restore();
+    }
+
+    void endRegion() override {
+        m_canvas->restore();
+    }
+
+private:
+    SkCanvas* m_canvas;
+    NSDictionary<NSNumber*, NSValue*>* m_images;
+};
+
 @interface OverlaySkiaGraphicsLayer : NSObject
 @property (nonatomic, strong) id<MTLDevice> device;
 @property (nonatomic, strong) id<MTLTexture> frontTexture;
 @property (nonatomic, strong) id<MTLTexture> backTexture;
+@property (nonatomic, strong) id<MTLTexture> widgetTexture;
 @property (nonatomic, strong) id<MTLRenderPipelineState> pipelineState;
 @property (nonatomic, strong) id<MTLBuffer> vertexBuffer;
 @property (nonatomic, assign) CGSize canvasSize;
@@ -341,6 +459,7 @@ static void applyFiltersToPaint(SkPaint& paint) {
 @property (nonatomic, assign) simd_float4 inkColor;
 @property (nonatomic, assign) simd_float4 paperColor;
 @property (nonatomic, assign) BOOL graphicsVisible;
+@property (nonatomic, assign) BOOL widgetsPresent;
 
 #ifdef USE_SKIA
 // Double buffered surfaces
@@ -352,6 +471,11 @@ static void applyFiltersToPaint(SkPaint& paint) {
 @property (nonatomic, assign) void* frontPixelData;
 @property (nonatomic, assign) void* backPixelData;
 
+// Retained widget canvas: single buffered, only damaged regions are repainted
+@property (nonatomic, assign) sk_sp<SkSurface> widgetSurface;
+@property (nonatomic, assign) SkCanvas* widgetCanvas;
+@property (nonatomic, assign) void* widgetPixelData;
+
 // Image storage (256 images max) - store raw SkImage pointers
 @property (nonatomic, strong) NSMutableDictionary<NSNumber*, NSValue*>* loadedImages;
 @property (nonatomic, assign) size_t rowBytes;
@@ -368,6 +492,7 @@ static void applyFiltersToPaint(SkPaint& paint) {
 - (void)drawTextX:(float)x y:(float)y text:(NSString*)text fontSize:(float)fontSize;
 - (void)renderWithEncoder:(id<MTLRenderCommandEncoder>)encoder viewport:(CGSize)viewport;
 - (void)processCommandQueue;
+- (void)renderWidgets;
 - (void)queueCommand:(GraphicsCommand)command;
 - (void)waitQueueEmpty;
 - (void)swapBuffers;
@@ -424,6 +549,7 @@ static void applyFiltersToPaint(SkPaint& paint) {
 
     self.frontTexture = [self.device newTextureWithDescriptor:textureDescriptor];
     self.backTexture = [self.device newTextureWithDescriptor:textureDescriptor];
+    self.widgetTexture = [self.device newTextureWithDescriptor:textureDescriptor];
 }
 
 - (void)createSkiaSurfaces {
@@ -449,6 +575,15 @@ static void applyFiltersToPaint(SkPaint& paint) {
     self.frontCanvas = self.frontSurface->getCanvas();
     self.backCanvas = self.backSurface->getCanvas();
 
+    // Widget buffer starts transparent; the texture is kept in step region by region
+    self.widgetPixelData = calloc(1, dataSize);
+    self.widgetSurface = SkSurfaces::WrapPixels(imageInfo, self.widgetPixelData, self.rowBytes);
+    self.widgetCanvas = self.widgetSurface->getCanvas();
+    [self.widgetTexture replaceRegion:MTLRegionMake2D(0, 0, width, height)
+                          mipmapLevel:0
+                            withBytes:self.widgetPixelData
+                          bytesPerRow:self.rowBytes];
+
     // Setup default paint with explicit properties
     self.paint.setAntiAlias(true);
     self.paint.setStyle(SkPaint::kFill_Style);  // Default to fill
@@ -648,6 +783,7 @@ static void applyFiltersToPaint(SkPaint& paint) {
 
     // Process queued commands on render thread
     [self processCommandQueue];
+    [self renderWidgets];
 
     // Only render if graphics are visible
     if (self.graphicsVisible) {
@@ -656,15 +792,46 @@ static void applyFiltersToPaint(SkPaint& paint) {
         [encoder setVertexBuffer:self.vertexBuffer offset:0 atIndex:0];
         [encoder setFragmentTexture:self.frontTexture atIndex:0];
         [encoder drawPrimitives:MTLPrimitiveTypeTriangle vertexStart:0 vertexCount:6];
+
+        // Retained widgets sit above the immediate-mode drawing
+        if (self.widgetsPresent) {
+            [encoder setFragmentTexture:self.widgetTexture atIndex:0];
+            [encoder drawPrimitives:MTLPrimitiveTypeTriangle vertexStart:0 vertexCount:6];
+        }
     }
 }
 
+- (void)renderWidgets {
+#ifdef USE_SKIA
+    std::lock_guard<std::mutex> lock(g_widgetMutex);
+    if (!g_widgetTree || !self.widgetCanvas || !self.widgetTexture) {
+        self.widgetsPresent = NO;
+        return;
+    }
+
+    // Repaint and upload only what changed; an unchanged HUD costs nothing
+    OverlaySkiaWidgetPainter painter(self.widgetCanvas, self.loadedImages);
+    const std::vector<OverlayRect>& regions = g_widgetTree->render(painter);
+    for (const OverlayRect& region : regions) {
+        const uint8_t* pixels = (const uint8_t*)self.widgetPixelData + region.y * self.rowBytes + region.x * 4;
+        [self.widgetTexture replaceRegion:MTLRegionMake2D(region.x, region.y, region.w, region.h)
+                              mipmapLevel:0
+                                withBytes:pixels
+                              bytesPerRow:self.rowBytes];
+    }
+    self.widgetsPresent = g_widgetTree->getCount() > 0;
+#endif
+}
+
 
 - (void)queueCommand:(GraphicsCommand)command {
     // NSLog(@"OverlaySkiaGraphicsLayer: Queueing command type %d on thread %@", command.type, [NSThread currentThread]);
     if (command.type == GRAPHICS_CMD_DRAW_TEXT) {
         // NSLog(@"OverlaySkiaGraphicsLayer: *** QUEUEING GRAPHICS_CMD_DRAW_TEXT: text='%s' ***", command.params.drawText.text);
     }
+    if (command.type != GRAPHICS_CMD_CLEAR) {
+        g_drawGeneration.store(superterminal_get_script_generation());
+    }
     NSData* commandData = [NSData dataWithBytes:&command length:sizeof(GraphicsCommand)];
     [self.queueCondition lock];
     [self.commandQueue addObject:commandData];
@@ -1665,6 +1832,11 @@ static void applyFiltersToPaint(SkPaint& paint) {
         free(self.backPixelData);
         self.backPixelData = nullptr;
     }
+    if (self.widgetPixelData) {
+        self.widgetSurface = nullptr;
+        free(self.widgetPixelData);
+        self.widgetPixelData = nullptr;
+    }
 #endif
 }
 
@@ -1695,6 +1867,11 @@ extern "C" {
         g_overlayLayer = [[OverlaySkiaGraphicsLayer alloc] initWithDevice:metalDevice canvasSize:CGSizeMake(width, height)];
         g_minimalGraphicsInitialized = (g_overlayLayer != nil);
 
+        {
+            std::lock_guard<std::mutex> lock(g_widgetMutex);
+            g_widgetTree = std::make_unique<OverlayWidgetTree>(width, height);
+        }
+
         NSLog(@"OverlayGraphicsLayer: initialize complete - success=%d", g_minimalGraphicsInitialized);
         return g_minimalGraphicsInitialized;
     }
@@ -1708,6 +1885,17 @@ extern "C" {
         }
     }
 
+    // Clear the overlay if a run up to this generation drew on it
+    int overlay_graphics_layer_release_generation(uint32_t generation) {
+        uint32_t drawn = g_drawGeneration.load();
+        if (!g_overlayLayer || drawn == 0 || drawn > generation) {
+            return 0;
+        }
+        overlay_graphics_layer_clear();
+        g_drawGeneration.store(0);
+        return 1;
+    }
+
     void overlay_graphics_layer_clear_with_color(float r, float g, float b, float a) {
         // NSLog(@"C API: overlay_graphics_layer_clear_with_color called with RGBA(%.2f,%.2f,%.2f,%.2f)", r, g, b, a);
         if (g_overlayLayer) {
@@ -1729,6 +1917,11 @@ extern "C" {
         NSLog(@"OverlayGraphicsLayer: shutdown called");
         g_overlayLayer = nil;
 
+        {
+            std::lock_guard<std::mutex> lock(g_widgetMutex);
+            g_widgetTree.reset();
+        }
+
         // Unregister from shutdown system
         unregister_active_subsystem();
         g_minimalGraphicsInitialized = NO;
@@ -2616,4 +2809,106 @@ extern "C" {
     bool overlay_graphics_layer_is_ui_rendering() {
         return g_creatingUiElement;
     }
+
+    // Retained widget functions. Edits only mark damage; the render thread
+    // repaints the affected regions on the next frame.
+
+    uint32_t overlay_graphics_layer_widget_panel(uint32_t parent, float x, float y, float w, float h) {
+        std::lock_guard<std::mutex> lock(g_widgetMutex);
+        return g_widgetTree ? g_widgetTree->createPanel(parent, x, y, w, h) : 0;
+    }
+
+    uint32_t overlay_graphics_layer_widget_label(uint32_t parent, float x, float y, float w, float h,
+                                                 const char* text, float fontSize) {
+        std::lock_guard<std::mutex> lock(g_widgetMutex);
+        return g_widgetTree ? g_widgetTree->createLabel(parent, x, y, w, h, text ? text : "", fontSize) : 0;
+    }
+
+    uint32_t overlay_graphics_layer_widget_bar(uint32_t parent, float x, float y, float w, float h, float value) {
+        std::lock_guard<std::mutex> lock(g_widgetMutex);
+        return g_widgetTree ? g_widgetTree->createBar(parent, x, y, w, h, value) : 0;
+    }
+
+    uint32_t overlay_graphics_layer_widget_image(uint32_t parent, float x, float y, float w, float h,
+                                                 uint16_t imageId) {
+        std::lock_guard<std::mutex> lock(g_widgetMutex);
+        return g_widgetTree ? g_widgetTree->createImage(parent, x, y, w, h, imageId) : 0;
+    }
+
+    bool overlay_graphics_layer_widget_remove(uint32_t id) {
+        std::lock_guard<std::mutex> lock(g_widgetMutex);
+        return g_widgetTree && g_widgetTree->remove(id);
+    }
+
+    void overlay_graphics_layer_widget_clear(void) {
+        std::lock_guard<std::mutex> lock(g_widgetMutex);
+        if (g_widgetTree) {
+            g_widgetTree->clear();
+        }
+    }
+
+    bool overlay_graphics_layer_widget_set_position(uint32_t id, float x, float y) {
+        std::lock_guard<std::mutex> lock(g_widgetMutex);
+        return g_widgetTree && g_widgetTree->setPosition(id, x, y);
+    }
+
+    bool overlay_graphics_layer_widget_set_size(uint32_t id, float w, float h) {
+        std::lock_guard<std::mutex> lock(g_widgetMutex);
+        return g_widgetTree && g_widgetTree->setSize(id, w, h);
+    }
+
+    bool overlay_graphics_layer_widget_set_visible(uint32_t id, bool visible) {
+        std::lock_guard<std::mutex> lock(g_widgetMutex);
+        return g_widgetTree && g_widgetTree->setVisible(id, visible);
+    }
+
+    bool overlay_graphics_layer_widget_set_z(uint32_t id, int z) {
+        std::lock_guard<std::mutex> lock(g_widgetMutex);
+        return g_widgetTree && g_widgetTree->setZ(id, z);
+    }
+
+    bool overlay_graphics_layer_widget_set_color(uint32_t id, float r, float g, float b, float a) {
+        std::lock_guard<std::mutex> lock(g_widgetMutex);
+        return g_widgetTree && g_widgetTree->setColor(id, {r, g, b, a});
+    }
+
+    bool overlay_graphics_layer_widget_set_back_color(uint32_t id, float r, float g, float b, float a) {
+        std::lock_guard<std::mutex> lock(g_widgetMutex);
+        return g_widgetTree && g_widgetTree->setBackColor(id, {r, g, b, a});
+    }
+
+    bool overlay_graphics_layer_widget_set_border(uint32_t id, float width) {
+        std::lock_guard<std::mutex> lock(g_widgetMutex);
+        return g_widgetTree && g_widgetTree->setBorderWidth(id, width);
+    }
+
+    bool overlay_graphics_layer_widget_set_text(uint32_t id, const char* text) {
+        std::lock_guard<std::mutex> lock(g_widgetMutex);
+        return g_widgetTree && g_widgetTree->setText(id, text ? text : "");
+    }
+
+    bool overlay_graphics_layer_widget_set_font_size(uint32_t id, float fontSize) {
+        std::lock_guard<std::mutex> lock(g_widgetMutex);
+        return g_widgetTree && g_widgetTree->setFontSize(id, fontSize);
+    }
+
+    bool overlay_graphics_layer_widget_set_value(uint32_t id, float value) {
+        std::lock_guard<std::mutex> lock(g_widgetMutex);
+        return g_widgetTree && g_widgetTree->setValue(id, value);
+    }
+
+    bool overlay_graphics_layer_widget_set_vertical(uint32_t id, bool vertical) {
+        std::lock_guard<std::mutex> lock(g_widgetMutex);
+        return g_widgetTree && g_widgetTree->setVertical(id, vertical);
+    }
+
+    bool overlay_graphics_layer_widget_set_image(uint32_t id, uint16_t imageId) {
+        std::lock_guard<std::mutex> lock(g_widgetMutex);
+        return g_widgetTree && g_widgetTree->setImage(id, imageId);
+    }
+
+    bool overlay_graphics_layer_widget_invalidate(uint32_t id) {
+        std::lock_guard<std::mutex> lock(g_widgetMutex);
+        return g_widgetTree && g_widgetTree->invalidate(id);
+    }
 }
@@ -0,0 +1,576 @@
+//
+//  OverlayWidgetTree.cpp
+//  SuperTerminal Framework - Retained Overlay Widgets
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "OverlayWidgetTree.h"
+#include <algorithm>
+#include <cmath>
+
+// =============================================================================
+// OverlayRect
+// =============================================================================
+
+bool OverlayRect::intersects(const OverlayRect& other) const {
+    return !isEmpty() && !other.isEmpty() &&
+           x < other.x + other.w && other.x < x + w &&
+           y < other.y + other.h && other.y < y + h;
+}
+
+bool OverlayRect::contains(const OverlayRect& other) const {
+    return !isEmpty() && !other.isEmpty() &&
+           other.x >= x && other.y >= y &&
+           other.x + other.w <= x + w && other.y + other.h <= y + h;
+}
+
+OverlayRect OverlayRect::intersect(const OverlayRect& other) const {
+    if (!intersects(other)) {
+        return OverlayRect();
+    }
+    OverlayRect result;
+    result.x = std::max(x, other.x);
+    result.y = std::max(y, other.y);
+    result.w = std::min(x + w, other.x + other.w) - result.x;
+    result.h = std::min(y + h, other.y + other.h) - result.y;
+    return result;
+}
+
+OverlayRect OverlayRect::unite(const OverlayRect& other) const {
+    if (isEmpty()) {
+        return other;
+    }
+    if (other.isEmpty()) {
+        return *this;
+    }
+    OverlayRect result;
+    result.x = std::min(x, other.x);
+    result.y = std::min(y, other.y);
+    result.w = std::max(x + w, other.x + other.w) - result.x;
+    result.h = std::max(y + h, other.y + other.h) - result.y;
+    return result;
+}
+
+bool OverlayRect::operator==(const OverlayRect& other) const {
+    if (isEmpty() || other.isEmpty()) {
+        return isEmpty() == other.isEmpty();
+    }
+    return x == other.x && y == other.y && w == other.w && h == other.h;
+}
+
+OverlayRect OverlayRect::covering(float x, float y, float w, float h) {
+    if (!(w > 0.0f) || !(h > 0.0f)) {
+        return OverlayRect();
+    }
+    OverlayRect result;
+    result.x = (int)std::floor(x);
+    result.y = (int)std::floor(y);
+    result.w = (int)std::ceil(x + w) - result.x;
+    result.h = (int)std::ceil(y + h) - result.y;
+    return result;
+}
+
+// Pixels a merged rectangle would repaint that neither input covers
+static int64_t mergeWaste(const OverlayRect& a, const OverlayRect& b) {
+    return a.unite(b).area() - (a.area() + b.area() - a.intersect(b).area());
+}
+
+// =============================================================================
+// Construction and widget creation
+// =============================================================================
+
+OverlayWidgetTree::OverlayWidgetTree(int canvasWidth, int canvasHeight)
+    : m_canvasWidth(std::max(canvasWidth, 0)),
+      m_canvasHeight(std::max(canvasHeight, 0)) {
+}
+
+void OverlayWidgetTree::resize(int canvasWidth, int canvasHeight) {
+    m_canvasWidth = std::max(canvasWidth, 0);
+    m_canvasHeight = std::max(canvasHeight, 0);
+
+    // Bounds are clipped to the canvas, so every widget needs a new layout
+    for (auto& entry : m_nodes) {
+        markDirty(entry.second, true);
+    }
+    m_damage.clear();
+    invalidateAll();
+}
+
+uint32_t OverlayWidgetTree::create(uint32_t parent, OverlayWidgetKind kind, float x, float y,
+                                   float width, float height) {
+    if (parent != 0 && !find(parent)) {
+        return 0;
+    }
+
+    uint32_t id = m_nextId++;
+    Node& node = m_nodes[id];
+    node.widget.id = id;
+    node.widget.parent = parent;
+    node.widget.kind = kind;
+    node.widget.x = x;
+    node.widget.y = y;
+    node.widget.width = width;
+    node.widget.height = height;
+
+    if (parent != 0) {
+        m_nodes[parent].children.push_back(id);
+    } else {
+        m_roots.push_back(id);
+    }
+    m_drawOrderDirty = true;
+    markDirty(node, true);
+    return id;
+}
+
+uint32_t OverlayWidgetTree::createPanel(uint32_t parent, float x, float y, float width, float height) {
+    return create(parent, OverlayWidgetKind::Panel, x, y, width, height);
+}
+
+uint32_t OverlayWidgetTree::createLabel(uint32_t parent, float x, float y, float width, float height,
+                                        const std::string& text, float fontSize) {
+    uint32_t id = create(parent, OverlayWidgetKind::Label, x, y, width, height);
+    if (id != 0) {
+        OverlayWidget& widget = m_nodes[id].widget;
+        widget.text = text;
+        widget.fontSize = fontSize;
+    }
+    return id;
+}
+
+uint32_t OverlayWidgetTree::createBar(uint32_t parent, float x, float y, float width, float height,
+                                      float value) {
+    uint32_t id = create(parent, OverlayWidgetKind::Bar, x, y, width, height);
+    if (id != 0) {
+        m_nodes[id].widget.value = std::max(0.0f, std::min(1.0f, value));
+    }
+    return id;
+}
+
+uint32_t OverlayWidgetTree::createImage(uint32_t parent, float x, float y, float width, float height,
+                                        uint16_t imageId) {
+    uint32_t id = create(parent, OverlayWidgetKind::Image, x, y, width, height);
+    if (id != 0) {
+        m_nodes[id].widget.imageId = imageId;
+    }
+    return id;
+}
+
+// =============================================================================
+// Removal
+// =============================================================================
+
+void OverlayWidgetTree::removeSubtree(uint32_t id) {
+    auto it = m_nodes.find(id);
+    if (it == m_nodes.end()) {
+        return;
+    }
+    std::vector<uint32_t> children = std::move(it->second.children);
+    addDamage(it->second.painted);
+    m_nodes.erase(it);
+    for (uint32_t child : children) {
+        removeSubtree(child);
+    }
+}
+
+bool OverlayWidgetTree::remove(uint32_t id) {
+    Node* node = find(id);
+    if (!node) {
+        return false;
+    }
+
+    uint32_t parent = node->widget.parent;
+    std::vector<uint32_t>& siblings = parent != 0 ? m_nodes[parent].children : m_roots;
+    siblings.erase(std::remove(siblings.begin(), siblings.end(), id), siblings.end());
+
+    removeSubtree(id);
+    m_drawOrderDirty = true;
+    return true;
+}
+
+void OverlayWidgetTree::clear() {
+    for (const auto& entry : m_nodes) {
+        addDamage(entry.second.painted);
+    }
+    m_nodes.clear();
+    m_roots.clear();
+    m_dirtyNodes.clear();
+    m_drawOrder.clear();
+    m_drawOrderDirty = false;
+}
+
+// =============================================================================
+// Setters
+// =============================================================================
+
+OverlayWidgetTree::Node* OverlayWidgetTree::find(uint32_t id) {
+    auto it = m_nodes.find(id);
+    return it != m_nodes.end() ? &it->second : nullptr;
+}
+
+const OverlayWidget* OverlayWidgetTree::get(uint32_t id) const {
+    auto it = m_nodes.find(id);
+    return it != m_nodes.end() ? &it->second.widget : nullptr;
+}
+
+void OverlayWidgetTree::markDirty(Node& node, bool layout) {
+    if (layout) {
+        node.layoutDirty = true;
+    } else {
+        node.dirty = true;
+    }
+    if (!node.queued) {
+        node.queued = true;
+        m_dirtyNodes.push_back(node.widget.id);
+    }
+}
+
+bool OverlayWidgetTree::setPosition(uint32_t id, float x, float y) {
+    Node* node = find(id);
+    if (!node) {
+        return false;
+    }
+    if (node->widget.x != x || node->widget.y != y) {
+        node->widget.x = x;
+        node->widget.y = y;
+        markDirty(*node, true);
+    }
+    return true;
+}
+
+bool OverlayWidgetTree::setSize(uint32_t id, float width, float height) {
+    Node* node = find(id);
+    if (!node) {
+        return false;
+    }
+    if (node->widget.width != width || node->widget.height != height) {
+        node->widget.width = width;
+        node->widget.height = height;
+        markDirty(*node, true);
+    }
+    return true;
+}
+
+bool OverlayWidgetTree::setVisible(uint32_t id, bool visible) {
+    Node* node = find(id);
+    if (!node) {
+        return false;
+    }
+    if (node->widget.visible != visible) {
+        node->widget.visible = visible;
+        markDirty(*node, true);
+    }
+    return true;
+}
+
+bool OverlayWidgetTree::setZ(uint32_t id, int z) {
+    Node* node = find(id);
+    if (!node) {
+        return false;
+    }
+    if (node->widget.z != z) {
+        // Only the overlap with siblings changes, which lies inside its box
+        node->widget.z = z;
+        m_drawOrderDirty = true;
+        markDirty(*node, false);
+    }
+    return true;
+}
+
+// Assign a content field; true when the value actually changed
+template <typename T>
+static bool assignChanged(T& field, const T& value) {
+    if (field == value) {
+        return false;
+    }
+    field = value;
+    return true;
+}
+
+bool OverlayWidgetTree::setColor(uint32_t id, const OverlayWidgetColor& color) {
+    Node* node = find(id);
+    if (!node) {
+        return false;
+    }
+    if (assignChanged(node->widget.color, color)) {
+        markDirty(*node, false);
+    }
+    return true;
+}
+
+bool OverlayWidgetTree::setBackColor(uint32_t id, const OverlayWidgetColor& color) {
+    Node* node = find(id);
+    if (!node) {
+        return false;
+    }
+    if (assignChanged(node->widget.backColor, color)) {
+        markDirty(*node, false);
+    }
+    return true;
+}
+
+bool OverlayWidgetTree::setBorderWidth(uint32_t id, float width) {
+    Node* node = find(id);
+    if (!node) {
+        return false;
+    }
+    if (assignChanged(node->widget.borderWidth, std::max(width, 0.0f))) {
+        markDirty(*node, false);
+    }
+    return true;
+}
+
+bool OverlayWidgetTree::setText(uint32_t id, const std::string& text) {
+    Node* node = find(id);
+    if (!node) {
+        return false;
+    }
+    if (assignChanged(node->widget.text, text)) {
+        markDirty(*node, false);
+    }
+    return true;
+}
+
+bool OverlayWidgetTree::setFontSize(uint32_t id, float fontSize) {
+    Node* node = find(id);
+    if (!node) {
+        return false;
+    }
+    if (assignChanged(node->widget.fontSize, fontSize)) {
+        markDirty(*node, false);
+    }
+    return true;
+}
+
+bool OverlayWidgetTree::setValue(uint32_t id, float value) {
+    Node* node = find(id);
+    if (!node) {
+        return false;
+    }
+    if (assignChanged(node->widget.value, std::max(0.0f, std::min(1.0f, value)))) {
+        markDirty(*node, false);
+    }
+    return true;
+}
+
+bool OverlayWidgetTree::setVertical(uint32_t id, bool vertical) {
+    Node* node = find(id);
+    if (!node) {
+        return false;
+    }
+    if (assignChanged(node->widget.vertical, vertical)) {
+        markDirty(*node, false);
+    }
+    return true;
+}
+
+bool OverlayWidgetTree::setImage(uint32_t id, uint16_t imageId) {
+    Node* node = find(id);
+    if (!node) {
+        return false;
+    }
+    if (assignChanged(node->widget.imageId, imageId)) {
+        markDirty(*node, false);
+    }
+    return true;
+}
+
+bool OverlayWidgetTree::invalidate(uint32_t id) {
+    Node* node = find(id);
+    if (!node) {
+        return false;
+    }
+    markDirty(*node, false);
+    return true;
+}
+
+void OverlayWidgetTree::invalidateAll() {
+    OverlayRect canvas;
+    canvas.w = m_canvasWidth;
+    canvas.h = m_canvasHeight;
+    addDamage(canvas);
+}
+
+// =============================================================================
+// Damage
+// =============================================================================
+
+void OverlayWidgetTree::addDamage(const OverlayRect& rect) {
+    OverlayRect canvas;
+    canvas.w = m_canvasWidth;
+    canvas.h = m_canvasHeight;
+    OverlayRect pending = rect.intersect(canvas);
+    if (pending.isEmpty()) {
+        return;
+    }
+
+    // Fold into existing rectangles while the union repaints little that
+    // neither already covers; repeat because a merge can reach further rects
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (size_t i = 0; i < m_damage.size(); i++) {
+            const OverlayRect& existing = m_damage[i];
+            if (existing.contains(pending)) {
+                return;
+            }
+            int64_t waste = mergeWaste(existing, pending);
+            if (pending.contains(existing) || waste <= (existing.area() + pending.area()) / 4) {
+                pending = existing.unite(pending);
+                m_damage.erase(m_damage.begin() + i);
+                merged = true;
+                break;
+            }
+        }
+    }
+
+    m_damage.push_back(pending);
+    capDamage();
+}
+
+void OverlayWidgetTree::capDamage() {
+    // Past the cap, merge whichever pair wastes the fewest pixels
+    while (m_damage.size() > MAX_DAMAGE_RECTS) {
+        size_t bestA = 0, bestB = 1;
+        int64_t bestWaste = INT64_MAX;
+        for (size_t a = 0; a < m_damage.size(); a++) {
+            for (size_t b = a + 1; b < m_damage.size(); b++) {
+                int64_t waste = mergeWaste(m_damage[a], m_damage[b]);
+                if (waste < bestWaste) {
+                    bestWaste = waste;
+                    bestA = a;
+                    bestB = b;
+                }
+            }
+        }
+        m_damage[bestA] = m_damage[bestA].unite(m_damage[bestB]);
+        m_damage.erase(m_damage.begin() + bestB);
+    }
+}
+
+void OverlayWidgetTree::relayout(Node& node, float parentX, float parentY, bool parentShown) {
+    OverlayWidget& widget = node.widget;
+    widget.worldX = parentX + widget.x;
+    widget.worldY = parentY + widget.y;
+    widget.shown = parentShown && widget.visible;
+
+    OverlayRect canvas;
+    canvas.w = m_canvasWidth;
+    canvas.h = m_canvasHeight;
+    widget.bounds = OverlayRect::covering(widget.worldX, widget.worldY, widget.width, widget.height)
+                        .intersect(canvas);
+
+    OverlayRect painted = widget.shown ? widget.bounds : OverlayRect();
+    if (painted != node.painted) {
+        addDamage(node.painted);
+        addDamage(painted);
+        node.painted = painted;
+    } else if (node.dirty) {
+        addDamage(painted);
+    }
+    node.dirty = false;
+    node.layoutDirty = false;
+
+    for (uint32_t child : node.children) {
+        relayout(m_nodes[child], widget.worldX, widget.worldY, widget.shown);
+    }
+}
+
+const std::vector<OverlayRect>& OverlayWidgetTree::collectDamage() {
+    for (size_t i = 0; i < m_dirtyNodes.size(); i++) {
+        Node* node = find(m_dirtyNodes[i]);
+        if (!node) {
+            continue;   // Removed after it was marked
+        }
+        node->queued = false;
+
+        if (node->layoutDirty) {
+            // Start from the highest ancestor that also moved, so the whole
+            // subtree is placed against up-to-date parent positions
+            Node* top = node;
+            for (Node* up = find(node->widget.parent); up; up = find(up->widget.parent)) {
+                if (up->layoutDirty) {
+                    top = up;
+                }
+            }
+            const Node* parent = find(top->widget.parent);
+            relayout(*top,
+                     parent ? parent->widget.worldX : 0.0f,
+                     parent ? parent->widget.worldY : 0.0f,
+                     parent ? parent->widget.shown : true);
+        } else if (node->dirty) {
+            addDamage(node->painted);
+            node->dirty = false;
+        }
+    }
+    m_dirtyNodes.clear();
+    return m_damage;
+}
+
+// =============================================================================
+// Rendering
+// =============================================================================
+
+void OverlayWidgetTree::appendDrawOrder(const std::vector<uint32_t>& siblings) {
+    std::vector<uint32_t> sorted = siblings;
+    std::sort(sorted.begin(), sorted.end(), [this](uint32_t a, uint32_t b) {
+        int za = m_nodes[a].widget.z;
+        int zb = m_nodes[b].widget.z;
+        return za != zb ? za < zb : a < b;
+    });
+    for (uint32_t id : sorted) {
+        m_drawOrder.push_back(id);
+        appendDrawOrder(m_nodes[id].children);
+    }
+}
+
+void OverlayWidgetTree::buildDrawOrder() {
+    m_drawOrder.clear();
+    appendDrawOrder(m_roots);
+    m_drawOrderDirty = false;
+}
+
+const std::vector<OverlayRect>& OverlayWidgetTree::render(OverlayWidgetPainter& painter) {
+    collectDamage();
+    m_regions.swap(m_damage);
+    m_damage.clear();
+
+    m_lastDamageArea = 0;
+    m_lastDrawCount = 0;
+    if (m_regions.empty()) {
+        return m_regions;
+    }
+    if (m_drawOrderDirty) {
+        buildDrawOrder();
+    }
+
+    for (const OverlayRect& region : m_regions) {
+        m_lastDamageArea += region.area();
+        painter.beginRegion(region);
+        for (uint32_t id : m_drawOrder) {
+            const OverlayWidget& widget = m_nodes[id].widget;
+            if (widget.shown && widget.bounds.intersects(region)) {
+                painter.drawWidget(widget);
+                m_lastDrawCount++;
+            }
+        }
+        painter.endRegion();
+    }
+    return m_regions;
+}
+
+void OverlayWidgetTree::barFillExtent(const OverlayWidget& bar, float& x, float& y, float& width,
+                                      float& height) {
+    float value = std::max(0.0f, std::min(1.0f, bar.value));
+    x = bar.worldX;
+    y = bar.worldY;
+    width = bar.width;
+    height = bar.height;
+    if (bar.vertical) {
+        height = bar.height * value;
+        y = bar.worldY + bar.height - height;
+    } else {
+        width = bar.width * value;
+    }
+}
@@ -0,0 +1,194 @@
+//
+//  OverlayWidgetTree.h
+//  SuperTerminal Framework - Retained Overlay Widgets
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+//  Retained tree of HUD widgets (panels, labels, bars, images) for the overlay
+//  layer. Setters only mark a widget dirty when a value actually changes;
+//  render() turns the dirty widgets into a short list of merged damage
+//  rectangles and repaints just those regions through a painter, so a static
+//  HUD costs nothing per frame and a score change repaints one label's box.
+//
+//  Widgets are positioned relative to their parent and never paint outside
+//  their own box; painters clip labels and images to it. Children draw above
+//  their parent, siblings in (z, creation) order. Hiding a widget hides its
+//  subtree.
+//
+//  Not thread-safe; the overlay layer serialises access.
+//
+
+#ifndef OverlayWidgetTree_h
+#define OverlayWidgetTree_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Integer pixel rectangle on the overlay canvas
+struct OverlayRect {
+    int x = 0, y = 0, w = 0, h = 0;
+
+    bool isEmpty() const { return w <= 0 || h <= 0; }
+    int64_t area() const { return isEmpty() ? 0 : (int64_t)w * h; }
+    bool intersects(const OverlayRect& other) const;
+    bool contains(const OverlayRect& other) const;
+    OverlayRect intersect(const OverlayRect& other) const;
+    OverlayRect unite(const OverlayRect& other) const;
+    bool operator==(const OverlayRect& other) const;
+    bool operator!=(const OverlayRect& other) const { return !(*this == other); }
+
+    // Smallest pixel rectangle covering a float rectangle
+    static OverlayRect covering(float x, float y, float w, float h);
+};
+
+struct OverlayWidgetColor {
+    float r = 1.0f, g = 1.0f, b = 1.0f, a = 1.0f;
+
+    bool operator==(const OverlayWidgetColor& other) const {
+        return r == other.r && g == other.g && b == other.b && a == other.a;
+    }
+    bool operator!=(const OverlayWidgetColor& other) const { return !(*this == other); }
+};
+
+enum class OverlayWidgetKind : uint8_t {
+    Panel = 0,
+    Label = 1,
+    Bar = 2,
+    Image = 3
+};
+
+struct OverlayWidget {
+    uint32_t id = 0;
+    uint32_t parent = 0;            // 0 = top level
+    OverlayWidgetKind kind = OverlayWidgetKind::Panel;
+    float x = 0.0f, y = 0.0f;       // Relative to the parent's origin
+    float width = 0.0f, height = 0.0f;
+    int z = 0;
+    bool visible = true;
+
+    OverlayWidgetColor color;       // Panel fill, label text, bar fill, image tint alpha
+    OverlayWidgetColor backColor = {0.0f, 0.0f, 0.0f, 0.0f};   // Panel border, bar track
+    float borderWidth = 0.0f;       // Panel only
+    std::string text;               // Label only
+    float fontSize = 16.0f;         // Label only
+    float value = 1.0f;             // Bar fill fraction, 0-1
+    bool vertical = false;          // Bar fills bottom-up instead of left-to-right
+    uint16_t imageId = 0;           // Image only
+
+    // Layout results, kept by the tree
+    float worldX = 0.0f, worldY = 0.0f;
+    bool shown = false;             // visible and every ancestor visible
+    OverlayRect bounds;             // Covering pixels, clipped to the canvas
+};
+
+// Backend that repaints damaged regions. beginRegion() must clear the region
+// to transparent and clip every draw to it until endRegion().
+class OverlayWidgetPainter {
+public:
+    virtual ~OverlayWidgetPainter() = default;
+    virtual void beginRegion(const OverlayRect& region) = 0;
+    virtual void drawWidget(const OverlayWidget& widget) = 0;
+    virtual void endRegion() = 0;
+};
+
+class OverlayWidgetTree {
+public:
+    static constexpr size_t MAX_DAMAGE_RECTS = 16;
+
+    OverlayWidgetTree(int canvasWidth, int canvasHeight);
+
+    // Damages the whole canvas
+    void resize(int canvasWidth, int canvasHeight);
+
+    // Create a widget under parent (0 = top level); returns 0 if the parent
+    // does not exist
+    uint32_t createPanel(uint32_t parent, float x, float y, float width, float height);
+    uint32_t createLabel(uint32_t parent, float x, float y, float width, float height,
+                         const std::string& text, float fontSize);
+    uint32_t createBar(uint32_t parent, float x, float y, float width, float height, float value);
+    uint32_t createImage(uint32_t parent, float x, float y, float width, float height, uint16_t imageId);
+
+    // Removes the widget and its subtree
+    bool remove(uint32_t id);
+    void clear();
+
+    // Setters return false for unknown ids; unchanged values cause no damage
+    bool setPosition(uint32_t id, float x, float y);
+    bool setSize(uint32_t id, float width, float height);
+    bool setVisible(uint32_t id, bool visible);
+    bool setZ(uint32_t id, int z);
+    bool setColor(uint32_t id, const OverlayWidgetColor& color);
+    bool setBackColor(uint32_t id, const OverlayWidgetColor& color);
+    bool setBorderWidth(uint32_t id, float width);
+    bool setText(uint32_t id, const std::string& text);
+    bool setFontSize(uint32_t id, float fontSize);
+    bool setValue(uint32_t id, float value);
+    bool setVertical(uint32_t id, bool vertical);
+    bool setImage(uint32_t id, uint16_t imageId);
+
+    // Repaint a widget whose content changed outside the tree (image reloaded)
+    bool invalidate(uint32_t id);
+    void invalidateAll();
+
+    const OverlayWidget* get(uint32_t id) const;
+    size_t getCount() const { return m_nodes.size(); }
+    int getCanvasWidth() const { return m_canvasWidth; }
+    int getCanvasHeight() const { return m_canvasHeight; }
+    bool hasDamage() const { return !m_dirtyNodes.empty() || !m_damage.empty(); }
+
+    // Resolve dirty widgets into merged damage without painting
+    const std::vector<OverlayRect>& collectDamage();
+
+    // Repaint every damaged region and return the regions painted (valid
+    // until the next call); empty when nothing changed
+    const std::vector<OverlayRect>& render(OverlayWidgetPainter& painter);
+
+    // Filled part of a bar, in canvas coordinates
+    static void barFillExtent(const OverlayWidget& bar, float& x, float& y, float& width, float& height);
+
+    // Statistics for the last render()
+    int64_t getLastDamageArea() const { return m_lastDamageArea; }
+    size_t getLastDrawCount() const { return m_lastDrawCount; }
+
+private:
+    struct Node {
+        OverlayWidget widget;
+        std::vector<uint32_t> children;
+        OverlayRect painted;        // Pixels currently showing this widget
+        bool dirty = false;         // Content changed
+        bool layoutDirty = false;   // Position, size or visibility changed
+        bool queued = false;        // In m_dirtyNodes
+    };
+
+    int m_canvasWidth;
+    int m_canvasHeight;
+    uint32_t m_nextId = 1;
+
+    std::unordered_map<uint32_t, Node> m_nodes;
+    std::vector<uint32_t> m_roots;
+    std::vector<uint32_t> m_dirtyNodes;
+    std::vector<OverlayRect> m_damage;
+    std::vector<OverlayRect> m_regions;
+
+    std::vector<uint32_t> m_drawOrder;
+    bool m_drawOrderDirty = true;
+
+    int64_t m_lastDamageArea = 0;
+    size_t m_lastDrawCount = 0;
+
+    uint32_t create(uint32_t parent, OverlayWidgetKind kind, float x, float y, float width, float height);
+    Node* find(uint32_t id);
+    void markDirty(Node& node, bool layout);
+    void relayout(Node& node, float parentX, float parentY, bool parentShown);
+    void addDamage(const OverlayRect& rect);
+    void capDamage();
+    void removeSubtree(uint32_t id);
+    void buildDrawOrder();
+    void appendDrawOrder(const std::vector<uint32_t>& siblings);
+};
+
+#endif /* OverlayWidgetTree_h */
@@ -14,11 +14,13 @@
 #import <Metal/Metal.h>
 #import <MetalKit/MetalKit.h>
 #import <simd/simd.h>
+#include "ParticleTileCollision.h"
 #include <vector>
 #include <map>
 
 // Forward declarations
 @class SuperTerminalSprite;
+class SimulationRandom;
 
 namespace SuperTerminal {
 
@@ -26,11 +28,13 @@ namespace SuperTerminal {
 struct Particle {
     // Position and physics
     simd_float2 position;
+    simd_float2 previousPosition;   // Start of the current fixed step (render interpolation)
     simd_float2 velocity;
     simd_float2 acceleration;
     
     // Rotation
     float rotation;
+    float previousRotation;
     float angularVelocity;
     
     // Visual properties
@@ -58,16 +62,18 @@ struct Particle {
     
     // State
     bool active;
+    bool stuck;                     // Stopped on a tile; keeps ageing in place
     uint16_t sourceSprite;
     
     // Constructor
-    Particle() : position(simd_make_float2(0,0)), velocity(simd_make_float2(0,0)), 
-                acceleration(simd_make_float2(0,0)), rotation(0), angularVelocity(0), 
+    Particle() : position(simd_make_float2(0,0)), previousPosition(simd_make_float2(0,0)),
+                velocity(simd_make_float2(0,0)), acceleration(simd_make_float2(0,0)),
+                rotation(0), previousRotation(0), angularVelocity(0), 
                 scale(1.0f), scaleVelocity(0), alpha(1.0f), alphaDecay(0.02f), 
                 texCoordMin(simd_make_float2(0,0)), texCoordMax(simd_make_float2(1,1)),
                 lifetime(0), maxLifetime(3.0f), mass(1.0f), drag(0.98f), bounce(0.3f),
                 color(simd_make_float4(1,1,1,1)), glowIntensity(0), active(false), 
-                sourceSprite(0) {}
+                stuck(false), sourceSprite(0) {}
 };
 
 // Explosion configuration
@@ -116,9 +122,17 @@ private:
     simd_float2 gravity;
     simd_float2 worldBounds;
     
+    // Optional collision with a tile layer's solid tiles (layer 0 = off)
+    ParticleTileCollider tileCollider;
+    int tileCollisionLayer;
+    
     // Performance monitoring
     uint64_t totalParticlesCreated;
     uint64_t activeExplosions;
+    uint64_t tileCollisionHits;
+    
+    // Seeded "particles" stream from the simulation scheduler
+    SimulationRandom& random;
     
     // Internal methods
     bool initializeMetalResources();
@@ -139,7 +153,8 @@ public:
     bool initialize();
     void shutdown();
     
-    // Main update - CALLED FROM MAIN LOOP (not background thread)
+    // Main update - one fixed simulation step, driven by the
+    // FixedTimestepScheduler from the main loop (not background thread)
     void update(float deltaTime);
     
     // Explosion API
@@ -156,6 +171,14 @@ public:
     void setTimeScale(float scale);
     void setWorldBounds(float width, float height);
     
+    // Tile collision: particles test their movement against solid tiles of
+    // a tile layer (1 or 2; 0 disables) and bounce, stick or die on contact
+    void setTileCollision(int layer, TileCollisionResponse response, float friction);
+    void setSolidTile(uint16_t tileId, bool solid);
+    void clearSolidTiles();
+    int getTileCollisionLayer() const { return tileCollisionLayer; }
+    uint64_t getTileCollisionHits() const { return tileCollisionHits; }
+    
     // Rendering integration
     void render(id<MTLRenderCommandEncoder> encoder, simd_float4x4 projectionMatrix);
     
@@ -225,6 +248,12 @@ extern "C" {
     void particle_system_set_world_bounds(float width, float height);
     void particle_system_set_enabled(bool enabled);
     
+    // Tile collision (layer 0 = off; response 0 = bounce, 1 = stick, 2 = die)
+    void particle_system_set_tile_collision(int layer, int response, float friction);
+    void particle_system_set_solid_tile(uint16_t tileId, bool solid);
+    void particle_system_clear_solid_tiles();
+    uint64_t particle_system_get_tile_hits();
+    
     // Queries
     uint32_t particle_system_get_active_count();
     uint64_t particle_system_get_total_created();
@@ -9,8 +9,8 @@
 //
 
 #import "ParticleSystem.h"
+#import "FixedTimestep.h"
 #import <Foundation/Foundation.h>
-#import <random>
 #import <chrono>
 #import <algorithm>
 
@@ -73,6 +73,8 @@ static void particle_log(const char* format, ...) {
 // External sprite interface
 extern "C" {
     extern SuperTerminalSprite* sprite_layer_get_sprite(uint16_t id);
+    extern bool tile_layer_get_collision_grid(int layer, const uint16_t** tiles, int* width, int* height, float* tileSize);
+    extern void tile_screen_to_world(int layer, float screenX, float screenY, float* worldX, float* worldY);
     extern void* superterminal_get_metal_device(void);
     extern void sprite_layer_init(void* device);
 
@@ -121,7 +123,9 @@ ParticleSystem::ParticleSystem(id<MTLDevice> device, size_t maxPart)
       systemEnabled(true), globalTimeScale(1.0f),
       gravity(simd_make_float2(0.0f, 98.0f)),
       worldBounds(simd_make_float2(1024.0f, 768.0f)),
-      totalParticlesCreated(0), activeExplosions(0) {
+      tileCollisionLayer(0),
+      totalParticlesCreated(0), activeExplosions(0), tileCollisionHits(0),
+      random(simulation_scheduler().getRandom("particles")) {
 
     PARTICLE_LOG(@"ParticleSystem: Constructor called (SIMPLIFIED - no threads)");
     particles.reserve(maxParticles);
@@ -336,11 +340,40 @@ void ParticleSystem::update(float deltaTime) {
     // Apply time scale
     deltaTime *= globalTimeScale;
 
+    // Refresh the tile map view once per step: the map may have been
+    // recreated and the layer scrolled since the last one
+    bool collideWithTiles = false;
+    if (tileCollisionLayer != 0 && tileCollider.getSolidCount() > 0) {
+        TileCollisionGrid grid;
+        if (tile_layer_get_collision_grid(tileCollisionLayer, &grid.tiles, &grid.width, &grid.height, &grid.tileSize)) {
+            tile_screen_to_world(tileCollisionLayer, 0.0f, 0.0f, &grid.originX, &grid.originY);
+            tileCollider.setGrid(grid);
+            collideWithTiles = tileCollider.isActive();
+        }
+    }
+
     // Update all active particles
     for (auto& particle : particles) {
         if (!particle.active) continue;
 
+        particle.previousPosition = particle.position;
+        particle.previousRotation = particle.rotation;
         updateParticlePhysics(particle, deltaTime);
+
+        if (collideWithTiles && particle.active && !particle.stuck) {
+            float x = particle.position.x, y = particle.position.y;
+            float vx = particle.velocity.x, vy = particle.velocity.y;
+            TileCollisionResult result = tileCollider.resolve(particle.previousPosition.x, particle.previousPosition.y,
+                                                              x, y, vx, vy, particle.bounce);
+            if (result != TileCollisionResult::None) {
+                particle.position = simd_make_float2(x, y);
+                particle.velocity = simd_make_float2(vx, vy);
+                particle.stuck = result == TileCollisionResult::Stuck;
+                particle.active = result != TileCollisionResult::Died;
+                tileCollisionHits++;
+            }
+        }
+
         handleCollisions(particle);
     }
 
@@ -360,18 +393,21 @@ void ParticleSystem::updateParticlePhysics(Particle& particle, float deltaTime)
         return;
     }
 
-    // Apply gravity
-    particle.acceleration = gravity * particle.mass;
+    // Stuck to a tile: stay put but keep ageing and fading
+    if (!particle.stuck) {
+        // Apply gravity
+        particle.acceleration = gravity * particle.mass;
 
-    // Update velocity
-    particle.velocity += particle.acceleration * deltaTime;
-    particle.velocity *= particle.drag; // Apply drag
+        // Update velocity
+        particle.velocity += particle.acceleration * deltaTime;
+        particle.velocity *= particle.drag; // Apply drag
 
-    // Update position
-    particle.position += particle.velocity * deltaTime;
+        // Update position
+        particle.position += particle.velocity * deltaTime;
 
-    // Update rotation
-    particle.rotation += particle.angularVelocity * deltaTime;
+        // Update rotation
+        particle.rotation += particle.angularVelocity * deltaTime;
+    }
 
     // Update scale
     particle.scale += particle.scaleVelocity * deltaTime;
@@ -400,10 +436,7 @@ void ParticleSystem::handleCollisions(Particle& particle) {
         particle.velocity.x *= 0.8f; // Friction
 
         // Add some random bounce variation
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        static std::uniform_real_distribution<float> dis(-10.0f, 10.0f);
-        particle.velocity.x += dis(gen);
+        particle.velocity.x += random.range(-10.0f, 10.0f);
     }
 
     // Remove particles that go too far off screen
@@ -483,14 +516,10 @@ void ParticleSystem::createParticlesFromSprite(uint16_t spriteId, const Explosio
     particle_log("ParticleSystem::createParticlesFromSprite: Creating %d particles for sprite %d",
           config.particleCount, spriteId);
 
-    // Random number generation
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * M_PI);
-    std::uniform_real_distribution<float> forceDist(0.5f, 1.5f);
-    std::uniform_real_distribution<float> sizeDist(config.fragmentSizeMin, config.fragmentSizeMax);
-    std::uniform_real_distribution<float> lifeDist(config.fadeTime * 0.8f, config.fadeTime * 1.2f);
-    std::uniform_real_distribution<float> rotDist(-config.rotationSpeed, config.rotationSpeed);
+    // Seeded simulation stream so replays reproduce the same explosion
+    const float twoPi = 2.0f * (float)M_PI;
+    float fadeMin = config.fadeTime * 0.8f;
+    float fadeMax = config.fadeTime * 1.2f;
 
     // Generate fragment texture coordinates
     auto fragCoords = generateFragmentTexCoords(config.particleCount,
@@ -502,10 +531,11 @@ void ParticleSystem::createParticlesFromSprite(uint16_t spriteId, const Explosio
 
         // Start at sprite position
         particle.position = simd_make_float2(sprite_get_x(sprite), sprite_get_y(sprite));
+        particle.previousPosition = particle.position;
 
         // Random explosion direction
-        float angle = angleDist(gen);
-        float force = config.explosionForce * forceDist(gen);
+        float angle = random.range(0.0f, twoPi);
+        float force = config.explosionForce * random.range(0.5f, 1.5f);
 
         // Apply directional bias
         simd_float2 direction = {cos(angle), sin(angle)};
@@ -519,11 +549,12 @@ void ParticleSystem::createParticlesFromSprite(uint16_t spriteId, const Explosio
         particle.acceleration = {0.0f, 0.0f};
 
         // Random rotation
-        particle.rotation = angleDist(gen);
-        particle.angularVelocity = rotDist(gen);
+        particle.rotation = random.range(0.0f, twoPi);
+        particle.previousRotation = particle.rotation;
+        particle.angularVelocity = random.range(-config.rotationSpeed, config.rotationSpeed);
 
         // Random scale
-        particle.scale = sizeDist(gen) * sprite_get_scale(sprite);
+        particle.scale = random.range(config.fragmentSizeMin, config.fragmentSizeMax) * sprite_get_scale(sprite);
         particle.scaleVelocity = -particle.scale / config.fadeTime;
 
         // Set alpha
@@ -532,7 +563,7 @@ void ParticleSystem::createParticlesFromSprite(uint16_t spriteId, const Explosio
 
         // Fragment texture coordinates
         if (i < fragCoords.size()) {
-            float fragSize = sizeDist(gen);
+            float fragSize = random.range(config.fragmentSizeMin, config.fragmentSizeMax);
             simd_float2 center = fragCoords[i];
             particle.texCoordMin = center - simd_float2{fragSize * 0.5f, fragSize * 0.5f};
             particle.texCoordMax = center + simd_float2{fragSize * 0.5f, fragSize * 0.5f};
@@ -543,7 +574,7 @@ void ParticleSystem::createParticlesFromSprite(uint16_t spriteId, const Explosio
         }
 
         // Set lifetime
-        particle.maxLifetime = lifeDist(gen);
+        particle.maxLifetime = random.range(fadeMin, fadeMax);
         particle.lifetime = 0.0f;
 
         // Physics properties
@@ -572,12 +603,10 @@ std::vector<simd_float2> ParticleSystem::generateFragmentTexCoords(uint16_t part
     std::vector<simd_float2> coords;
     coords.reserve(particleCount);
 
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> coordDist(0.0f, 1.0f);
-
     for (uint16_t i = 0; i < particleCount; ++i) {
-        coords.push_back(simd_make_float2(coordDist(gen), coordDist(gen)));
+        float u = random.nextFloat();
+        float v = random.nextFloat();
+        coords.push_back(simd_make_float2(u, v));
     }
 
     return coords;
@@ -628,6 +657,27 @@ void ParticleSystem::setWorldBounds(float width, float height) {
     worldBounds = {width, height};
 }
 
+void ParticleSystem::setTileCollision(int layer, TileCollisionResponse response, float friction) {
+    tileCollisionLayer = (layer == 1 || layer == 2) ? layer : 0;
+    tileCollider.setResponse(response);
+    tileCollider.setFriction(friction);
+
+    // Particles stuck under the old rules fall again
+    for (auto& particle : particles) {
+        particle.stuck = false;
+    }
+    PARTICLE_LOG(@"ParticleSystem: Tile collision layer=%d response=%d friction=%.2f",
+                 tileCollisionLayer, (int)response, tileCollider.getFriction());
+}
+
+void ParticleSystem::setSolidTile(uint16_t tileId, bool solid) {
+    tileCollider.setSolid(tileId, solid);
+}
+
+void ParticleSystem::clearSolidTiles() {
+    tileCollider.clearSolid();
+}
+
 void ParticleSystem::setEnabled(bool enabled) {
     systemEnabled = enabled;
     if (!enabled) {
@@ -698,20 +748,21 @@ void ParticleSystem::render(id<MTLRenderCommandEncoder> encoder, simd_float4x4 p
     // Bind texture
     [encoder setFragmentTexture:particleTexture atIndex:0];
 
-    // Populate instance data buffer
+    // Populate instance data buffer, interpolated between fixed steps
     ParticleInstanceData* instanceData = (ParticleInstanceData*)[particleInstanceBuffer contents];
     size_t instanceIndex = 0;
+    float alpha = (float)simulation_get_alpha();
 
     for (const auto& p : particles) {
         if (!p.active) continue;
 
-        instanceData[instanceIndex].position = p.position;
+        instanceData[instanceIndex].position = simd_mix(p.previousPosition, p.position, simd_make_float2(alpha, alpha));
         instanceData[instanceIndex].velocity = p.velocity;
         instanceData[instanceIndex].texCoordMin = p.texCoordMin;
         instanceData[instanceIndex].texCoordMax = p.texCoordMax;
         instanceData[instanceIndex].color = p.color;
         instanceData[instanceIndex].scale = p.scale * 32.0f; // Make particles much larger and visible
-        instanceData[instanceIndex].rotation = p.rotation;
+        instanceData[instanceIndex].rotation = p.previousRotation + (p.rotation - p.previousRotation) * alpha;
         instanceData[instanceIndex].alpha = p.alpha;
         instanceData[instanceIndex].lifetime = p.lifetime;
         instanceData[instanceIndex].glowIntensity = p.glowIntensity;
@@ -758,6 +809,8 @@ void ParticleSystem::dumpSystemStats() {
     NSLog(@"Max particles: %zu", maxParticles);
     NSLog(@"System enabled: %s", systemEnabled ? "YES" : "NO");
     NSLog(@"Time scale: %.2f", globalTimeScale);
+    NSLog(@"Tile collision: layer %d, %zu solid tile ids, %llu hits",
+          tileCollisionLayer, tileCollider.getSolidCount(), tileCollisionHits);
     NSLog(@"===========================");
 }
 
@@ -769,6 +822,7 @@ using namespace SuperTerminal;
 
 // Global instance (single source of truth)
 static ParticleSystem* g_particleSystem = nullptr;
+static int g_particleStepHandle = 0;
 
 extern "C" {
 
@@ -799,6 +853,14 @@ bool particle_system_initialize(void* metalDevice) {
         return false;
     }
 
+    // Physics advances on the fixed simulation step, not the frame delta
+    g_particleStepHandle = simulation_scheduler().registerStep("particles", SIM_STEP_ORDER_PARTICLES,
+        [](float dt, uint64_t) {
+            if (g_particleSystem) {
+                g_particleSystem->update(dt);
+            }
+        });
+
     particle_log("ParticleSystem C API: Initialized successfully");
     NSLog(@"ParticleSystem C API: Initialized successfully");
     return true;
@@ -808,6 +870,8 @@ void particle_system_shutdown() {
     if (g_particleSystem) {
         particle_log("ParticleSystem C API: Shutting down...");
         NSLog(@"ParticleSystem C API: Shutting down...");
+        simulation_scheduler().unregisterStep(g_particleStepHandle);
+        g_particleStepHandle = 0;
         g_particleSystem->shutdown();
         delete g_particleSystem;
         g_particleSystem = nullptr;
@@ -915,6 +979,31 @@ void particle_system_set_enabled(bool enabled) {
     }
 }
 
+void particle_system_set_tile_collision(int layer, int response, float friction) {
+    if (g_particleSystem) {
+        if (response < 0 || response > (int)TileCollisionResponse::Die) {
+            response = (int)TileCollisionResponse::Bounce;
+        }
+        g_particleSystem->setTileCollision(layer, (TileCollisionResponse)response, friction);
+    }
+}
+
+void particle_system_set_solid_tile(uint16_t tileId, bool solid) {
+    if (g_particleSystem) {
+        g_particleSystem->setSolidTile(tileId, solid);
+    }
+}
+
+void particle_system_clear_solid_tiles() {
+    if (g_particleSystem) {
+        g_particleSystem->clearSolidTiles();
+    }
+}
+
+uint64_t particle_system_get_tile_hits() {
+    return g_particleSystem ? g_particleSystem->getTileCollisionHits() : 0;
+}
+
 uint32_t particle_system_get_active_count() {
     return g_particleSystem ? (uint32_t)g_particleSystem->getActiveParticleCount() : 0;
 }
@@ -9,6 +9,7 @@
 //
 
 #include <lua.hpp>
+#include <cstring>
 #include <iostream>
 
 // Forward declarations of C API functions (defined in ParticleSystem.mm)
@@ -28,6 +29,10 @@ extern "C" {
     uint64_t particle_system_get_total_created();
     void particle_system_dump_stats();
     bool particle_system_is_ready();
+    void particle_system_set_tile_collision(int layer, int response, float friction);
+    void particle_system_set_solid_tile(uint16_t tileId, bool solid);
+    void particle_system_clear_solid_tiles();
+    uint64_t particle_system_get_tile_hits();
 }
 
 #pragma mark - Lua Binding Functions (Direct Calls)
@@ -336,6 +341,92 @@ static int l_particle_system_resume(lua_State* L) {
     return 0;
 }
 
+/**
+ * particle_set_tile_collision(layer, [response], [friction])
+ *
+ * Collide particles with the solid tiles of a tile layer.
+ *
+ * @param layer: Integer - Tile layer (1 or 2), 0 to turn collision off
+ * @param response: String - "bounce" (default), "stick" or "die"
+ * @param friction: Number - Fraction of sliding speed lost per bounce, 0-1 (default: 0.2)
+ */
+static int l_particle_system_set_tile_collision(lua_State* L) {
+    int layer = (int)luaL_checkinteger(L, 1);
+    const char* response = luaL_optstring(L, 2, "bounce");
+    float friction = (float)luaL_optnumber(L, 3, 0.2);
+
+    int mode;
+    if (strcmp(response, "bounce") == 0) {
+        mode = 0;
+    } else if (strcmp(response, "stick") == 0) {
+        mode = 1;
+    } else if (strcmp(response, "die") == 0) {
+        mode = 2;
+    } else {
+        return luaL_error(L, "particle_set_tile_collision: response must be \"bounce\", \"stick\" or \"die\"");
+    }
+
+    if (layer < 0 || layer > 2) {
+        return luaL_error(L, "particle_set_tile_collision: layer must be 0, 1 or 2");
+    }
+
+    particle_system_set_tile_collision(layer, mode, friction);
+    return 0;
+}
+
+/**
+ * particle_set_solid_tile(tile_id, [solid])
+ *
+ * Mark tile ids that particles collide with.
+ *
+ * @param tile_id: Integer or Table - Tile id (1-256), or an array of tile ids
+ * @param solid: Boolean - true to make solid, false to clear (default: true)
+ */
+static int l_particle_system_set_solid_tile(lua_State* L) {
+    bool solid = lua_isnoneornil(L, 2) ? true : lua_toboolean(L, 2);
+
+    if (lua_istable(L, 1)) {
+        size_t count = lua_objlen(L, 1);
+        for (size_t i = 1; i <= count; i++) {
+            lua_rawgeti(L, 1, (int)i);
+            if (!lua_isnumber(L, -1)) {
+                return luaL_error(L, "particle_set_solid_tile: tile ids must be integers");
+            }
+            particle_system_set_solid_tile((uint16_t)lua_tointeger(L, -1), solid);
+            lua_pop(L, 1);
+        }
+    } else {
+        int tile_id = (int)luaL_checkinteger(L, 1);
+        if (tile_id < 1 || tile_id > 256) {
+            return luaL_error(L, "particle_set_solid_tile: tile_id must be between 1 and 256");
+        }
+        particle_system_set_solid_tile((uint16_t)tile_id, solid);
+    }
+    return 0;
+}
+
+/**
+ * particle_clear_solid_tiles()
+ *
+ * Make every tile id non-solid.
+ */
+static int l_particle_system_clear_solid_tiles(lua_State* L) {
+    particle_system_clear_solid_tiles();
+    return 0;
+}
+
+/**
+ * particle_get_tile_hits()
+ *
+ * Get the number of particle-tile collisions since startup.
+ *
+ * @return Integer - Total tile hits
+ */
+static int l_particle_system_get_tile_hits(lua_State* L) {
+    lua_pushinteger(L, (lua_Integer)particle_system_get_tile_hits());
+    return 1;
+}
+
 #pragma mark - Registration
 
 /**
@@ -366,6 +457,12 @@ extern "C" void register_particle_system_lua_api(lua_State* L) {
     lua_register(L, "particle_dump_stats", l_particle_system_dump_stats);
     lua_register(L, "particle_info", l_particle_system_info);
 
+    // Tile collision
+    lua_register(L, "particle_set_tile_collision", l_particle_system_set_tile_collision);
+    lua_register(L, "particle_set_solid_tile", l_particle_system_set_solid_tile);
+    lua_register(L, "particle_clear_solid_tiles", l_particle_system_clear_solid_tiles);
+    lua_register(L, "particle_get_tile_hits", l_particle_system_get_tile_hits);
+
     // Export explosion mode constants
     lua_pushinteger(L, 1);
     lua_setglobal(L, "BASIC_EXPLOSION");
@@ -386,7 +483,7 @@ extern "C" void register_particle_system_lua_api(lua_State* L) {
     lua_setglobal(L, "RAPID_BURST");
 
     std::cout << "ParticleSystemLua: Registration complete ("
-              << "14 functions, 6 constants)" << std::endl;
+              << "18 functions, 6 constants)" << std::endl;
 
     // Create particle_system table for backward compatibility (e.g., breakout.lua)
     lua_newtable(L);
@@ -0,0 +1,182 @@
+//
+//  ParticleTileCollision.cpp
+//  SuperTerminal Framework - Particle vs Tilemap Collision
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "ParticleTileCollision.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+ParticleTileCollider::ParticleTileCollider()
+    : m_solid(MAX_TILE_ID + 1, 0) {
+}
+
+void ParticleTileCollider::setSolid(uint16_t tileId, bool solid) {
+    if (tileId == 0 || tileId > MAX_TILE_ID) {
+        return;     // 0 is the empty cell
+    }
+    uint8_t value = solid ? 1 : 0;
+    if (m_solid[tileId] != value) {
+        m_solid[tileId] = value;
+        if (solid) {
+            m_solidCount++;
+        } else {
+            m_solidCount--;
+        }
+    }
+}
+
+void ParticleTileCollider::clearSolid() {
+    std::fill(m_solid.begin(), m_solid.end(), 0);
+    m_solidCount = 0;
+}
+
+void ParticleTileCollider::setFriction(float friction) {
+    m_friction = std::max(0.0f, std::min(1.0f, friction));
+}
+
+bool ParticleTileCollider::cellSolid(int cellX, int cellY) const {
+    if (cellX < 0 || cellY < 0 || cellX >= m_grid.width || cellY >= m_grid.height) {
+        return false;
+    }
+    return isSolid(m_grid.tiles[(size_t)cellY * m_grid.width + cellX]);
+}
+
+bool ParticleTileCollider::isSolidAt(float x, float y) const {
+    if (!isActive()) {
+        return false;
+    }
+    float inverseSize = 1.0f / m_grid.tileSize;
+    return cellSolid((int)std::floor((x + m_grid.originX) * inverseSize),
+                     (int)std::floor((y + m_grid.originY) * inverseSize));
+}
+
+// =============================================================================
+// Grid traversal
+// =============================================================================
+
+bool ParticleTileCollider::sweep(float x0, float y0, float x1, float y1, TileHit& hit) const {
+    if (!isActive()) {
+        return false;
+    }
+
+    // Work in cell units
+    const float inverseSize = 1.0f / m_grid.tileSize;
+    const float gx0 = (x0 + m_grid.originX) * inverseSize;
+    const float gy0 = (y0 + m_grid.originY) * inverseSize;
+    const float gx1 = (x1 + m_grid.originX) * inverseSize;
+    const float gy1 = (y1 + m_grid.originY) * inverseSize;
+
+    int cellX = (int)std::floor(gx0);
+    int cellY = (int)std::floor(gy0);
+    const int endX = (int)std::floor(gx1);
+    const int endY = (int)std::floor(gy1);
+
+    // Most particles stay inside one cell per step
+    if (cellX == endX && cellY == endY) {
+        return false;
+    }
+
+    const float dx = gx1 - gx0;
+    const float dy = gy1 - gy0;
+    const float infinity = std::numeric_limits<float>::infinity();
+    const int stepX = dx > 0.0f ? 1 : (dx < 0.0f ? -1 : 0);
+    const int stepY = dy > 0.0f ? 1 : (dy < 0.0f ? -1 : 0);
+    const float deltaX = stepX ? 1.0f / std::fabs(dx) : infinity;
+    const float deltaY = stepY ? 1.0f / std::fabs(dy) : infinity;
+    float maxX = stepX > 0 ? (cellX + 1 - gx0) * deltaX : (stepX < 0 ? (gx0 - cellX) * deltaX : infinity);
+    float maxY = stepY > 0 ? (cellY + 1 - gy0) * deltaY : (stepY < 0 ? (gy0 - cellY) * deltaY : infinity);
+
+    const int steps = std::abs(endX - cellX) + std::abs(endY - cellY);
+    for (int i = 0; i < steps; i++) {
+        float t;
+        int normalX = 0, normalY = 0;
+        if (maxX < maxY) {
+            t = maxX;
+            cellX += stepX;
+            maxX += deltaX;
+            normalX = -stepX;
+        } else {
+            t = maxY;
+            cellY += stepY;
+            maxY += deltaY;
+            normalY = -stepY;
+        }
+        if (t > 1.0f) {
+            break;
+        }
+        if (!cellSolid(cellX, cellY)) {
+            continue;
+        }
+
+        // Contact on the entered face exactly, so rounding can't leave the
+        // point inside the cell
+        hit.t = t;
+        hit.cellX = cellX;
+        hit.cellY = cellY;
+        hit.normalX = normalX;
+        hit.normalY = normalY;
+        if (normalX != 0) {
+            float face = (normalX < 0 ? cellX : cellX + 1) * m_grid.tileSize;
+            hit.x = face - m_grid.originX;
+            hit.y = y0 + (y1 - y0) * t;
+        } else {
+            float face = (normalY < 0 ? cellY : cellY + 1) * m_grid.tileSize;
+            hit.x = x0 + (x1 - x0) * t;
+            hit.y = face - m_grid.originY;
+        }
+        return true;
+    }
+    return false;
+}
+
+// =============================================================================
+// Response
+// =============================================================================
+
+TileCollisionResult ParticleTileCollider::resolve(float x0, float y0, float& x, float& y,
+                                                  float& vx, float& vy, float restitution) const {
+    TileHit hit;
+    if (!sweep(x0, y0, x, y, hit)) {
+        return TileCollisionResult::None;
+    }
+
+    // The rest of the step's motion is dropped; at one contact per step
+    // that is at most a step's travel
+    x = hit.x + hit.normalX * CONTACT_OFFSET;
+    y = hit.y + hit.normalY * CONTACT_OFFSET;
+
+    switch (m_response) {
+        case TileCollisionResponse::Die:
+            return TileCollisionResult::Died;
+
+        case TileCollisionResponse::Stick:
+            vx = 0.0f;
+            vy = 0.0f;
+            return TileCollisionResult::Stuck;
+
+        case TileCollisionResponse::Bounce:
+        default:
+            break;
+    }
+
+    float keep = 1.0f - m_friction;
+    if (hit.normalX != 0) {
+        vx = -vx * restitution;
+        vy *= keep;
+        if (std::fabs(vx) < REST_SPEED) {
+            vx = 0.0f;
+        }
+    } else {
+        vy = -vy * restitution;
+        vx *= keep;
+        if (std::fabs(vy) < REST_SPEED) {
+            vy = 0.0f;
+        }
+    }
+    return TileCollisionResult::Bounced;
+}
@@ -0,0 +1,109 @@
+//
+//  ParticleTileCollision.h
+//  SuperTerminal Framework - Particle vs Tilemap Collision
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+//  Collision of point particles against the solid cells of a tile map.
+//  Each step, a particle's movement segment is walked through the grid with
+//  a DDA (Amanatides-Woo) that visits only the cells the segment crosses, so
+//  a particle moving less than a tile per step costs a couple of lookups and
+//  the whole pass stays linear in live particles, whatever the map size.
+//
+//  Solidity is per tile id. The collider reads the map in place through a
+//  TileCollisionGrid view; cells outside the map are empty. A particle that
+//  starts a step inside a solid cell is left alone until it leaves, so
+//  spawning inside geometry does not trap it.
+//
+//  Not thread-safe; the particle system serialises access.
+//
+
+#ifndef ParticleTileCollision_h
+#define ParticleTileCollision_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class TileCollisionResponse : uint8_t {
+    Bounce = 0,     // Reflect off the surface, losing energy to restitution and friction
+    Stick = 1,      // Stop at the surface
+    Die = 2         // Deactivate the particle
+};
+
+enum class TileCollisionResult : uint8_t {
+    None = 0,
+    Bounced = 1,
+    Stuck = 2,
+    Died = 3
+};
+
+// Read-only view of a row-major tile map in the particles' coordinate space
+struct TileCollisionGrid {
+    const uint16_t* tiles = nullptr;
+    int width = 0;
+    int height = 0;
+    float tileSize = 128.0f;
+    float originX = 0.0f;           // Map position of the particles' (0, 0),
+    float originY = 0.0f;           // e.g. the scrolled viewport origin
+};
+
+struct TileHit {
+    float t = 1.0f;                 // Fraction of the segment travelled
+    float x = 0.0f, y = 0.0f;       // Contact point, particle coordinates
+    int normalX = 0, normalY = 0;   // Surface normal of the face entered
+    int cellX = 0, cellY = 0;
+};
+
+class ParticleTileCollider {
+public:
+    static constexpr uint16_t MAX_TILE_ID = 256;       // Matches MAX_TILES in TileCommon.h
+    static constexpr float CONTACT_OFFSET = 0.05f;     // Kept between a particle and the face it hit
+    static constexpr float REST_SPEED = 2.0f;          // Bounces slower than this come to rest
+
+    ParticleTileCollider();
+
+    void setSolid(uint16_t tileId, bool solid);
+    bool isSolid(uint16_t tileId) const {
+        return tileId <= MAX_TILE_ID && m_solid[tileId] != 0;
+    }
+    void clearSolid();
+    size_t getSolidCount() const { return m_solidCount; }
+
+    void setGrid(const TileCollisionGrid& grid) { m_grid = grid; }
+    const TileCollisionGrid& getGrid() const { return m_grid; }
+
+    void setResponse(TileCollisionResponse response) { m_response = response; }
+    TileCollisionResponse getResponse() const { return m_response; }
+
+    // Fraction of tangential speed removed on each bounce, 0-1
+    void setFriction(float friction);
+    float getFriction() const { return m_friction; }
+
+    // True when there is a map and at least one solid tile id
+    bool isActive() const { return m_grid.tiles && m_grid.width > 0 && m_grid.height > 0 && m_solidCount > 0; }
+
+    bool isSolidAt(float x, float y) const;
+
+    // First solid cell entered by the segment (x0,y0)-(x1,y1), not counting
+    // the cell it starts in
+    bool sweep(float x0, float y0, float x1, float y1, TileHit& hit) const;
+
+    // Apply one step's movement from (x0,y0) to (x,y): on a hit, move the
+    // particle to the contact point and apply the response. Restitution is
+    // the fraction of normal speed kept by a bounce.
+    TileCollisionResult resolve(float x0, float y0, float& x, float& y,
+                                float& vx, float& vy, float restitution) const;
+
+private:
+    std::vector<uint8_t> m_solid;
+    size_t m_solidCount = 0;
+    TileCollisionGrid m_grid;
+    TileCollisionResponse m_response = TileCollisionResponse::Bounce;
+    float m_friction = 0.2f;
+
+    bool cellSolid(int cellX, int cellY) const;
+};
+
+#endif /* ParticleTileCollision_h */
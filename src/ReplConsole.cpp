@@ -34,7 +34,10 @@ extern "C" {
     void text_grid_get_dimensions(int* width, int* height);
     
     // Lua GCD Runtime execution
-    bool lua_gcd_exec_repl(const char* lua_code);
+    typedef void (*lua_gcd_repl_output_fn)(const char* line, void* context);
+    typedef bool (*lua_gcd_repl_cancel_fn)(void* context);
+    bool lua_gcd_exec_repl_streaming(const char* lua_code, lua_gcd_repl_output_fn output,
+                                     lua_gcd_repl_cancel_fn should_cancel, void* context);
     const char* lua_gcd_get_last_error();
     void lua_gcd_reset_repl();
 }
@@ -42,6 +45,24 @@ extern "C" {
 // Global instance
 static ReplConsole* g_repl_instance = nullptr;
 
+// REPL worker thread: stream print() lines and poll for Ctrl+C
+static void repl_stream_output(const char* line, void* context) {
+    static_cast<ReplExecutor::Context*>(context)->emit(line);
+}
+
+static bool repl_should_cancel(void* context) {
+    return static_cast<ReplExecutor::Context*>(context)->isCancelled();
+}
+
+static bool repl_evaluate(const std::string& code, ReplExecutor::Context& context) {
+    if (lua_gcd_exec_repl_streaming(code.c_str(), repl_stream_output, repl_should_cancel, &context)) {
+        return true;
+    }
+    const char* error = lua_gcd_get_last_error();
+    context.setError(error ? error : "");
+    return false;
+}
+
 ReplConsole::ReplConsole()
     : m_initialized(false)
     , m_active(false)
@@ -52,6 +73,9 @@ ReplConsole::ReplConsole()
     , m_history_index(-1)
     , m_history_temp_input("")
     , m_scroll_offset(0)
+    , m_output_index(MAX_OUTPUT_LINES + 1)
+    , m_search_match{0, 0, 0}
+    , m_search_active(false)
     , m_cursor_blink_timer(0.0f)
     , m_cursor_visible(true)
     , m_needs_redraw(true)
@@ -88,6 +112,8 @@ bool ReplConsole::initialize() {
     // Initialize with minimal status
     set_status_message("Ready");
     
+    m_executor.reset(new ReplExecutor(repl_evaluate));
+    
     m_initialized = true;
     m_needs_redraw = true;
     
@@ -103,6 +129,7 @@ void ReplConsole::shutdown() {
     std::cout << "ReplConsole: Shutting down..." << std::endl;
     
     deactivate();
+    m_executor.reset();   // Interrupts a running command
     clear_history();
     clear_output();
     
@@ -210,9 +237,6 @@ void ReplConsole::handle_key_input(int key, int modifiers) {
         return;
     }
     
-    std::cout << "ReplConsole::handle_key_input - key=0x" << std::hex << key << std::dec 
-              << " modifiers=0x" << std::hex << modifiers << std::dec << std::endl;
-    
     // Key codes (macOS hex keycodes)
     const int KEY_RETURN = 0x24;      // Return/Enter
     const int KEY_BACKSPACE = 0x33;   // Backspace
@@ -225,6 +249,8 @@ void ReplConsole::handle_key_input(int key, int modifiers) {
     const int KEY_END = 0x77;         // End
     const int KEY_ESCAPE = 0x35;      // Escape
     const int KEY_TAB = 0x30;         // Tab
+    const int KEY_F = 0x03;           // F (Ctrl+F = find in output)
+    const int KEY_C = 0x08;           // C (Ctrl+C = interrupt running command)
     
     bool ctrl = (modifiers & 0x40000) != 0;   // Control
     bool shift = (modifiers & 0x20000) != 0;  // Shift
@@ -235,11 +261,9 @@ void ReplConsole::handle_key_input(int key, int modifiers) {
         case KEY_RETURN:
             if (ctrl) {
                 // Ctrl+Return executes the command
-                std::cout << "ReplConsole: Ctrl+RETURN detected - executing command" << std::endl;
                 execute_current_command();
             } else {
                 // Plain Return adds a newline for multi-line input
-                std::cout << "ReplConsole: RETURN detected - adding newline" << std::endl;
                 insert_character('\n');
             }
             break;
@@ -280,6 +304,21 @@ void ReplConsole::handle_key_input(int key, int modifiers) {
             if (ctrl) {
                 clear_current_input();
             }
+            if (m_search_active) {
+                clear_search();
+            }
+            break;
+            
+        case KEY_F:
+            if (ctrl) {
+                find_in_output(m_current_input, !shift);
+            }
+            break;
+            
+        case KEY_C:
+            if (ctrl) {
+                cancel_running_command(shift);
+            }
             break;
             
         default:
@@ -293,9 +332,6 @@ void ReplConsole::handle_character_input(char ch) {
         return;
     }
     
-    std::cout << "ReplConsole::handle_character_input - ch='" << ch << "' (0x" 
-              << std::hex << (int)(unsigned char)ch << std::dec << ")" << std::endl;
-    
     // Only accept printable characters
     if (ch >= 32 && ch < 127) {
         insert_character(ch);
@@ -303,7 +339,14 @@ void ReplConsole::handle_character_input(char ch) {
 }
 
 void ReplConsole::update(float delta_time) {
-    if (!m_initialized || !m_active) {
+    if (!m_initialized) {
+        return;
+    }
+    
+    // Drain output even while hidden so nothing is dropped
+    process_executor_events();
+    
+    if (!m_active) {
         return;
     }
     
@@ -315,53 +358,25 @@ void ReplConsole::update(float delta_time) {
 }
 
 void ReplConsole::render() {
-    std::cout << "ReplConsole::render() called - initialized=" << m_initialized 
-              << " active=" << m_active << " needs_redraw=" << m_needs_redraw << std::endl;
-    
-    if (!m_initialized || !m_active) {
-        std::cout << "ReplConsole::render() - skipping (not initialized or not active)" << std::endl;
+    if (!m_initialized || !m_active || !m_needs_redraw) {
         return;
     }
     
-    if (!m_needs_redraw) {
-        std::cout << "ReplConsole::render() - skipping (no redraw needed)" << std::endl;
-        return;
-    }
-    
-    std::cout << "ReplConsole::render() - rendering REPL components..." << std::endl;
-    
     // Render REPL components
     render_box();
-    std::cout << "ReplConsole::render() - box rendered" << std::endl;
-    
     render_status_line();
-    std::cout << "ReplConsole::render() - status line rendered" << std::endl;
-    
     render_content_area();
-    std::cout << "ReplConsole::render() - content area rendered" << std::endl;
-    
     render_input_line();
-    std::cout << "ReplConsole::render() - input line rendered" << std::endl;
-    
     render_cursor();
-    std::cout << "ReplConsole::render() - cursor rendered" << std::endl;
     
     m_needs_redraw = false;
-    std::cout << "ReplConsole::render() - complete" << std::endl;
 }
 
 void ReplConsole::execute_current_command() {
-    std::cout << "ReplConsole::execute_current_command() called" << std::endl;
-    std::cout << "  m_current_input: '" << m_current_input << "'" << std::endl;
-    std::cout << "  input length: " << m_current_input.length() << std::endl;
-    
     if (m_current_input.empty()) {
-        std::cout << "ReplConsole: Cannot execute - input is empty" << std::endl;
         return;
     }
     
-    std::cout << "ReplConsole: Executing command: '" << m_current_input << "'" << std::endl;
-    
     std::string command = m_current_input;
     
     // Add command to output display
@@ -373,7 +388,7 @@ void ReplConsole::execute_current_command() {
         add_to_history(command);
     }
     
-    // Execute the command
+    // Queue the command; it runs on the REPL worker, typed-ahead commands wait
     execute_command(command);
     
     // Clear input
@@ -385,26 +400,99 @@ void ReplConsole::execute_current_command() {
 }
 
 void ReplConsole::execute_command(const std::string& command) {
+    if (!m_executor) {
+        set_status_message("Error: REPL not initialized");
+        return;
+    }
+    
     // Wrap command with start_of_repl and end_of_repl for persistent state
     std::string wrapped_command = "start_of_repl(\"interactive\")\n" + command + "\nend_of_repl(\"interactive\")";
     
-    std::cout << "ReplConsole: Executing REPL command" << std::endl;
+    if (m_executor->submit(wrapped_command) == 0) {
+        set_status_message("Busy: command queue full");
+        return;
+    }
+    update_busy_status();
+}
+
+bool ReplConsole::cancel_running_command(bool drop_queued) {
+    if (!m_executor) {
+        return false;
+    }
     
-    bool success = lua_gcd_exec_repl(wrapped_command.c_str());
+    size_t dropped = drop_queued ? m_executor->cancelAll() : 0;
+    bool interrupted = drop_queued ? m_executor->isRunning() : m_executor->cancel();
+    if (!interrupted && dropped == 0) {
+        return false;
+    }
     
-    if (success) {
-        set_status_message("OK");
-        std::cout << "ReplConsole: Command executed successfully" << std::endl;
-    } else {
-        const char* error = lua_gcd_get_last_error();
-        if (error && strlen(error) > 0) {
-            set_status_message("Error: " + std::string(error));
-            std::cout << "ReplConsole: Lua error: " << error << std::endl;
-        } else {
-            set_status_message("Error");
-            std::cout << "ReplConsole: Command execution failed - no error message" << std::endl;
+    std::string message = interrupted ? "Interrupting..." : "Cancelled";
+    if (dropped > 0) {
+        message += " (" + std::to_string(dropped) + " queued dropped)";
+    }
+    set_status_message(message);
+    return true;
+}
+
+bool ReplConsole::is_busy() const {
+    return m_executor && (m_executor->isRunning() || m_executor->getQueuedCount() > 0);
+}
+
+void ReplConsole::process_executor_events() {
+    if (!m_executor) {
+        return;
+    }
+    
+    m_executor_events.clear();
+    if (m_executor->poll(m_executor_events) == 0) {
+        return;
+    }
+    
+    for (const ReplEvent& event : m_executor_events) {
+        switch (event.type) {
+            case ReplEventType::Started:
+                update_busy_status();
+                break;
+                
+            case ReplEventType::Output:
+                add_output_line(event.text);
+                break;
+                
+            case ReplEventType::Finished:
+                if (event.success) {
+                    set_status_message("OK");
+                } else if (event.cancelled) {
+                    set_status_message("Cancelled");
+                } else if (!event.text.empty()) {
+                    set_status_message("Error: " + event.text);
+                } else {
+                    set_status_message("Error");
+                }
+                break;
+        }
+    }
+    
+    // A finished command's result stays visible until the next one reports
+    if (m_executor_events.back().type != ReplEventType::Finished) {
+        update_busy_status();
+    }
+}
+
+void ReplConsole::update_busy_status() {
+    if (!m_executor || !m_executor->isRunning()) {
+        size_t queued = m_executor ? m_executor->getQueuedCount() : 0;
+        if (queued > 0) {
+            set_status_message("Queued: " + std::to_string(queued));
         }
+        return;
+    }
+    
+    size_t queued = m_executor->getQueuedCount();
+    std::string message = "Running... Ctrl+C to interrupt";
+    if (queued > 0) {
+        message += " (" + std::to_string(queued) + " queued)";
     }
+    set_status_message(message);
 }
 
 void ReplConsole::add_to_history(const std::string& command) {
@@ -465,6 +553,10 @@ void ReplConsole::add_output_line(const std::string& line) {
     // Limit buffer size
     while (m_output_lines.size() > MAX_OUTPUT_LINES) {
         m_output_lines.pop_front();
+        m_output_index.dropFront(1);
+        if (m_search_active && --m_search_match.line < 0) {
+            m_search_active = false;
+        }
     }
     
     // Auto-scroll to bottom unless user has scrolled up
@@ -477,6 +569,8 @@ void ReplConsole::add_output_line(const std::string& line) {
 
 void ReplConsole::clear_output() {
     m_output_lines.clear();
+    m_output_index.clear();
+    m_search_active = false;
     m_scroll_offset = 0;
     m_needs_redraw = true;
 }
@@ -493,6 +587,53 @@ void ReplConsole::scroll_down() {
     m_needs_redraw = true;
 }
 
+bool ReplConsole::find_in_output(const std::string& query, bool backwards) {
+    if (query.empty()) {
+        return false;
+    }
+    
+    // Repeated searches for the same text step from the previous match
+    int from_line, from_column;
+    if (m_search_active && query == m_search_query) {
+        from_line = m_search_match.line;
+        from_column = backwards ? m_search_match.column : m_search_match.column + 1;
+    } else if (backwards) {
+        from_line = (int)m_output_lines.size() - 1;
+        from_column = -1;
+    } else {
+        from_line = 0;
+        from_column = 0;
+    }
+    
+    ScrollbackMatch match;
+    bool found = backwards
+        ? m_output_index.findPrevious(query, from_line, from_column, true, true, match)
+        : m_output_index.findNext(query, from_line, from_column, true, true, match);
+    
+    m_search_query = query;
+    m_search_active = found;
+    if (!found) {
+        set_status_message("Not found: " + query);
+        return false;
+    }
+    m_search_match = match;
+    
+    // Scroll so the matching line is the bottom visible output line
+    m_scroll_offset = (int)m_output_lines.size() - 1 - match.line;
+    clamp_scroll_offset();
+    
+    set_status_message("Found at line " + std::to_string(match.line + 1) + " of " +
+                       std::to_string(m_output_lines.size()));
+    return true;
+}
+
+void ReplConsole::clear_search() {
+    m_search_active = false;
+    m_search_query.clear();
+    m_scroll_offset = 0;
+    m_needs_redraw = true;
+}
+
 void ReplConsole::clear_history() {
     m_command_history.clear();
     m_history_index = -1;
@@ -611,15 +752,10 @@ void ReplConsole::restore_screen_area() {
 // ============================================================================
 
 void ReplConsole::render_box() {
-    std::cout << "ReplConsole::render_box() - drawing box at row " << get_row_top_border() << std::endl;
-    
     // Draw PETSCII box border
     uint32_t box_color = make_color(0, 255, 0, 255);  // Green
     uint32_t bg_color = make_color(0, 0, 50, 255);    // Dark blue background
     
-    std::cout << "ReplConsole::render_box() - box_color=" << std::hex << box_color 
-              << " bg_color=" << bg_color << std::dec << std::endl;
-    
     // Top border (row 19)
     int screen_cols, screen_rows;
     text_grid_get_dimensions(&screen_cols, &screen_rows);
@@ -722,7 +858,7 @@ void ReplConsole::render_content_area() {
     } else {
         // Show recent output in rows 20-22, reserve row 23 for single-line input
         int available_lines = CONTENT_LINES - 1;
-        int start_line = std::max(0, (int)m_output_lines.size() - available_lines);
+        int start_line = std::max(0, (int)m_output_lines.size() - available_lines - m_scroll_offset);
         
         for (int i = 0; i < available_lines; i++) {
             int line_idx = start_line + i;
@@ -738,6 +874,16 @@ void ReplConsole::render_content_area() {
                 }
                 
                 draw_text(2, row, line.c_str(), text_color, bg_color);
+                
+                // Highlight the current search match if it is on screen
+                if (m_search_active && line_idx == m_search_match.line) {
+                    size_t start = ScrollbackIndex::columnToByte(line, m_search_match.column);
+                    size_t end = ScrollbackIndex::columnToByte(line, m_search_match.column + m_search_match.length);
+                    if (end > start) {
+                        draw_text(2 + m_search_match.column, row, line.substr(start, end - start).c_str(),
+                                  bg_color, make_color(255, 200, 40, 255));
+                    }
+                }
             }
         }
         
@@ -851,19 +997,9 @@ void ReplConsole::draw_char(int x, int y, const char* ch, uint32_t ink, uint32_t
     int screen_cols, screen_rows;
     text_grid_get_dimensions(&screen_cols, &screen_rows);
     if (x < 0 || x >= screen_cols || y < 0 || y >= screen_rows) {
-        std::cout << "ReplConsole::draw_char() - out of bounds: x=" << x << " y=" << y 
-                  << " (screen=" << screen_cols << "x" << screen_rows << ")" << std::endl;
         return;
     }
     
-    static int call_count = 0;
-    if (call_count < 5) {
-        std::cout << "ReplConsole::draw_char() - x=" << x << " y=" << y 
-                  << " ch='" << ch << "' ink=" << std::hex << ink 
-                  << " paper=" << paper << std::dec << std::endl;
-        call_count++;
-    }
-    
     editor_set_color(ink, paper);
     editor_print_at(x, y, ch);
 }
@@ -890,6 +1026,7 @@ void ReplConsole::wrap_and_add_line(const std::string& line) {
     // For now, just add the line without wrapping
     // In the future, could wrap long lines
     m_output_lines.push_back(line);
+    m_output_index.appendLine(line);
 }
 
 std::vector<std::string> ReplConsole::wrap_text(const std::string& text, int max_width) {
@@ -1050,6 +1187,13 @@ void repl_execute_command(const char* command) {
     }
 }
 
+bool repl_cancel_command(void) {
+    if (g_repl_instance) {
+        return g_repl_instance->cancel_running_command();
+    }
+    return false;
+}
+
 void repl_add_output(const char* text) {
     if (g_repl_instance && text) {
         g_repl_instance->add_output_line(text);
@@ -1062,6 +1206,13 @@ void repl_clear_output() {
     }
 }
 
+bool repl_find(const char* query) {
+    if (g_repl_instance && query) {
+        return g_repl_instance->find_in_output(query);
+    }
+    return false;
+}
+
 void repl_set_prompt(const char* prompt) {
     if (g_repl_instance && prompt) {
         g_repl_instance->set_prompt(prompt);
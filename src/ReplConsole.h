@@ -14,6 +14,9 @@
 #include <vector>
 #include <deque>
 #include <cstdint>
+#include <memory>
+#include "ScrollbackIndex.h"
+#include "ReplExecutor.h"
 
 // Text screen dimensions (80x25 character grid)
 constexpr int SCREEN_COLS = 80;
@@ -52,9 +55,12 @@ public:
     void update(float delta_time);
     void render();
     
-    // Execution
+    // Execution (asynchronous: commands run on the REPL worker in order;
+    // Ctrl+C interrupts the running one, Ctrl+Shift+C also drops the queue)
     void execute_current_command();
     void execute_command(const std::string& command);
+    bool cancel_running_command(bool drop_queued = false);
+    bool is_busy() const;
     
     // History management
     void add_to_history(const std::string& command);
@@ -68,6 +74,10 @@ public:
     void scroll_up();
     void scroll_down();
     
+    // Output search (indexed; Ctrl+F searches backwards for the current input)
+    bool find_in_output(const std::string& query, bool backwards = true);
+    void clear_search();
+    
     // Configuration
     void set_prompt(const std::string& prompt) { m_prompt = prompt; }
     void set_status_message(const std::string& message);
@@ -123,6 +133,12 @@ private:
     std::deque<std::string> m_output_lines;
     int m_scroll_offset; // How many lines scrolled up from bottom
     
+    // Search index mirroring m_output_lines (line N of the index == m_output_lines[N])
+    ScrollbackIndex m_output_index;
+    std::string m_search_query;
+    ScrollbackMatch m_search_match;
+    bool m_search_active;
+    
     // Visual state
     float m_cursor_blink_timer;
     bool m_cursor_visible;
@@ -159,6 +175,12 @@ private:
     void wrap_and_add_line(const std::string& line);
     std::vector<std::string> wrap_text(const std::string& text, int max_width);
     
+    // Asynchronous execution
+    std::unique_ptr<ReplExecutor> m_executor;
+    std::vector<ReplEvent> m_executor_events;   // Reused each frame
+    void process_executor_events();
+    void update_busy_status();
+    
     // Lua integration
     bool execute_lua_command(const std::string& command, std::string& result, std::string& error);
     bool is_lua_command_complete(const std::string& command);
@@ -195,8 +217,10 @@ extern "C" {
     
     // Utility
     void repl_execute_command(const char* command);
+    bool repl_cancel_command(void);
     void repl_add_output(const char* text);
     void repl_clear_output();
+    bool repl_find(const char* query);
     void repl_set_prompt(const char* prompt);
     void repl_notify_state_reset();
     
@@ -0,0 +1,240 @@
+//
+//  ReplExecutor.cpp
+//  SuperTerminal Framework - Asynchronous REPL Execution
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "ReplExecutor.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <utility>
+
+struct ReplExecutor::Shared {
+    Evaluator evaluator;
+    size_t maxQueued;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;       // Worker: new command or stop
+    std::condition_variable idle;       // waitIdle/shutdown: command finished or worker exited
+    std::deque<std::pair<uint64_t, std::string>> queue;
+    std::deque<ReplEvent> events;
+    uint64_t nextId = 1;
+    uint64_t runningId = 0;
+    uint64_t droppedOutput = 0;
+    bool stopping = false;
+    bool exited = false;
+
+    // Id of the command to interrupt; compared against the running id so a
+    // late cancel never hits the next command
+    std::atomic<uint64_t> cancelId{0};
+};
+
+// =============================================================================
+// Context
+// =============================================================================
+
+void ReplExecutor::Context::emit(const std::string& text) {
+    std::lock_guard<std::mutex> lock(m_shared->mutex);
+
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string::npos) {
+            end = text.size();
+            if (start == end && start > 0) {
+                break;      // Trailing newline ends the last line
+            }
+        }
+        if (m_shared->events.size() >= MAX_PENDING_EVENTS) {
+            m_dropped++;
+            m_shared->droppedOutput++;
+        } else {
+            ReplEvent event;
+            event.type = ReplEventType::Output;
+            event.commandId = m_commandId;
+            event.text.assign(text, start, end - start);
+            m_shared->events.push_back(std::move(event));
+        }
+        if (end == text.size()) {
+            break;
+        }
+        start = end + 1;
+    }
+}
+
+bool ReplExecutor::Context::isCancelled() const {
+    return m_shared->cancelId.load(std::memory_order_relaxed) == m_commandId;
+}
+
+// =============================================================================
+// Executor
+// =============================================================================
+
+ReplExecutor::ReplExecutor(Evaluator evaluator, size_t maxQueued)
+    : m_shared(std::make_shared<Shared>()) {
+    m_shared->evaluator = std::move(evaluator);
+    m_shared->maxQueued = maxQueued > 0 ? maxQueued : 1;
+    m_worker = std::thread(workerLoop, m_shared);
+}
+
+ReplExecutor::~ReplExecutor() {
+    std::unique_lock<std::mutex> lock(m_shared->mutex);
+    m_shared->stopping = true;
+    m_shared->queue.clear();
+    m_shared->cancelId.store(m_shared->runningId);
+    m_shared->wake.notify_all();
+
+    bool exited = m_shared->idle.wait_for(lock, std::chrono::milliseconds(SHUTDOWN_GRACE_MS),
+                                          [this] { return m_shared->exited; });
+    lock.unlock();
+
+    // A chunk blocked outside Lua cannot see the cancel flag; the worker
+    // keeps its own reference to the shared state, so let it finish alone
+    if (exited) {
+        m_worker.join();
+    } else {
+        m_worker.detach();
+    }
+}
+
+uint64_t ReplExecutor::submit(const std::string& code) {
+    std::lock_guard<std::mutex> lock(m_shared->mutex);
+    if (m_shared->stopping || m_shared->queue.size() >= m_shared->maxQueued) {
+        return 0;
+    }
+    uint64_t id = m_shared->nextId++;
+    m_shared->queue.emplace_back(id, code);
+    m_shared->wake.notify_one();
+    return id;
+}
+
+bool ReplExecutor::cancel() {
+    std::lock_guard<std::mutex> lock(m_shared->mutex);
+    if (m_shared->runningId == 0) {
+        return false;
+    }
+    m_shared->cancelId.store(m_shared->runningId);
+    return true;
+}
+
+size_t ReplExecutor::cancelAll() {
+    std::lock_guard<std::mutex> lock(m_shared->mutex);
+    if (m_shared->runningId != 0) {
+        m_shared->cancelId.store(m_shared->runningId);
+    }
+
+    size_t dropped = m_shared->queue.size();
+    for (const auto& command : m_shared->queue) {
+        ReplEvent event;
+        event.type = ReplEventType::Finished;
+        event.commandId = command.first;
+        event.cancelled = true;
+        m_shared->events.push_back(std::move(event));
+    }
+    m_shared->queue.clear();
+    m_shared->idle.notify_all();
+    return dropped;
+}
+
+bool ReplExecutor::isRunning() const {
+    std::lock_guard<std::mutex> lock(m_shared->mutex);
+    return m_shared->runningId != 0;
+}
+
+uint64_t ReplExecutor::getRunningId() const {
+    std::lock_guard<std::mutex> lock(m_shared->mutex);
+    return m_shared->runningId;
+}
+
+size_t ReplExecutor::getQueuedCount() const {
+    std::lock_guard<std::mutex> lock(m_shared->mutex);
+    return m_shared->queue.size();
+}
+
+uint64_t ReplExecutor::getDroppedOutputLines() const {
+    std::lock_guard<std::mutex> lock(m_shared->mutex);
+    return m_shared->droppedOutput;
+}
+
+size_t ReplExecutor::poll(std::vector<ReplEvent>& events, size_t maxEvents) {
+    std::lock_guard<std::mutex> lock(m_shared->mutex);
+    size_t count = std::min(maxEvents, m_shared->events.size());
+    for (size_t i = 0; i < count; i++) {
+        events.push_back(std::move(m_shared->events.front()));
+        m_shared->events.pop_front();
+    }
+    return count;
+}
+
+bool ReplExecutor::waitIdle(int timeoutMs) {
+    std::unique_lock<std::mutex> lock(m_shared->mutex);
+    return m_shared->idle.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] {
+        return m_shared->exited || (m_shared->runningId == 0 && m_shared->queue.empty());
+    });
+}
+
+void ReplExecutor::workerLoop(std::shared_ptr<Shared> shared) {
+    std::unique_lock<std::mutex> lock(shared->mutex);
+
+    for (;;) {
+        shared->wake.wait(lock, [&] { return shared->stopping || !shared->queue.empty(); });
+        if (shared->stopping) {
+            break;
+        }
+
+        uint64_t id = shared->queue.front().first;
+        std::string code = std::move(shared->queue.front().second);
+        shared->queue.pop_front();
+        shared->runningId = id;
+
+        ReplEvent started;
+        started.type = ReplEventType::Started;
+        started.commandId = id;
+        shared->events.push_back(std::move(started));
+        lock.unlock();
+
+        Context context(shared.get(), id);
+        auto startTime = std::chrono::steady_clock::now();
+        bool success = false;
+        try {
+            success = shared->evaluator(code, context);
+        } catch (const std::exception& e) {
+            context.setError(e.what());
+        } catch (...) {
+            context.setError("Unknown exception");
+        }
+        double elapsedMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - startTime).count();
+
+        lock.lock();
+        if (context.m_dropped > 0) {
+            ReplEvent notice;
+            notice.type = ReplEventType::Output;
+            notice.commandId = id;
+            notice.text = "... " + std::to_string(context.m_dropped) + " output lines dropped";
+            shared->events.push_back(std::move(notice));
+        }
+
+        ReplEvent finished;
+        finished.type = ReplEventType::Finished;
+        finished.commandId = id;
+        finished.success = success;
+        finished.cancelled = !success && context.isCancelled();
+        finished.text = success ? std::string() : context.getError();
+        finished.elapsedMs = elapsedMs;
+        shared->events.push_back(std::move(finished));
+
+        shared->runningId = 0;
+        shared->idle.notify_all();
+    }
+
+    shared->exited = true;
+    shared->idle.notify_all();
+}
@@ -0,0 +1,111 @@
+//
+//  ReplExecutor.h
+//  SuperTerminal Framework - Asynchronous REPL Execution
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+//  Runs REPL commands on a worker thread so the console keeps taking input
+//  and redrawing while a long chunk evaluates. Commands typed ahead wait in
+//  a bounded FIFO. Output lines are queued as the chunk emits them and the
+//  UI thread drains them each frame with poll(), together with start and
+//  finish notices. cancel() raises a per-command flag that the evaluator
+//  polls (the Lua runtime checks it from its instruction-count hook).
+//
+//  The evaluator runs on the worker thread and must only report through its
+//  Context. If a chunk is stuck in a blocking call at destruction the worker
+//  is detached after a short grace period rather than hanging shutdown.
+//
+
+#ifndef ReplExecutor_h
+#define ReplExecutor_h
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class ReplEventType : uint8_t {
+    Started = 0,    // A queued command began executing
+    Output = 1,     // One line of output (no trailing newline)
+    Finished = 2    // Command done; see success/cancelled/text
+};
+
+struct ReplEvent {
+    ReplEventType type;
+    uint64_t commandId;
+    std::string text;           // Output line, or the error for a failed command
+    bool success = false;       // Finished only
+    bool cancelled = false;     // Finished only
+    double elapsedMs = 0.0;     // Finished only
+};
+
+class ReplExecutor {
+public:
+    static constexpr size_t DEFAULT_MAX_QUEUED = 32;
+    static constexpr size_t MAX_PENDING_EVENTS = 4096;   // Output beyond this is dropped until drained
+    static constexpr int SHUTDOWN_GRACE_MS = 500;
+
+    struct Shared;
+
+    // Handed to the evaluator for the command it is running
+    class Context {
+    public:
+        // Queue output; text containing newlines becomes several lines
+        void emit(const std::string& text);
+        bool isCancelled() const;
+        uint64_t getCommandId() const { return m_commandId; }
+        void setError(const std::string& error) { m_error = error; }
+        const std::string& getError() const { return m_error; }
+
+    private:
+        friend class ReplExecutor;
+        Context(Shared* shared, uint64_t commandId) : m_shared(shared), m_commandId(commandId) {}
+
+        Shared* m_shared;
+        uint64_t m_commandId;
+        std::string m_error;
+        uint64_t m_dropped = 0;
+    };
+
+    // Returns true on success; on failure set an error through the context
+    using Evaluator = std::function<bool(const std::string& code, Context& context)>;
+
+    explicit ReplExecutor(Evaluator evaluator, size_t maxQueued = DEFAULT_MAX_QUEUED);
+    ~ReplExecutor();
+
+    ReplExecutor(const ReplExecutor&) = delete;
+    ReplExecutor& operator=(const ReplExecutor&) = delete;
+
+    // Queue a command; returns its id, or 0 when the queue is full
+    uint64_t submit(const std::string& code);
+
+    // Interrupt the running command. Returns false when idle.
+    bool cancel();
+
+    // Interrupt the running command and drop everything queued behind it.
+    // Dropped commands report Finished with cancelled set.
+    size_t cancelAll();
+
+    bool isRunning() const;
+    uint64_t getRunningId() const;
+    size_t getQueuedCount() const;
+    uint64_t getDroppedOutputLines() const;
+
+    // Move pending events to the caller (UI thread), oldest first
+    size_t poll(std::vector<ReplEvent>& events, size_t maxEvents = SIZE_MAX);
+
+    // Block until nothing is running or queued; false on timeout
+    bool waitIdle(int timeoutMs);
+
+private:
+    std::shared_ptr<Shared> m_shared;   // Also owned by the worker
+    std::thread m_worker;
+
+    static void workerLoop(std::shared_ptr<Shared> shared);
+};
+
+#endif /* ReplExecutor_h */
@@ -0,0 +1,425 @@
+//
+//  ScrollbackIndex.cpp
+//  SuperTerminal Framework - Scrollback Search Index
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+//  Trigram index implementation. Postings are keyed on ASCII-folded byte
+//  trigrams so both case-sensitive and case-insensitive searches can use the
+//  same index; every candidate line is verified against its UTF-8 shadow.
+//
+
+#include "ScrollbackIndex.h"
+#include <algorithm>
+
+// Rebuild the postings once stale entries outnumber live ones by this margin
+static const size_t COMPACT_SLACK = 4096;
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+static inline unsigned char foldByte(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c + ('a' - 'A')) : c;
+}
+
+static inline uint32_t trigramKey(const std::string& text, size_t i) {
+    return ((uint32_t)foldByte((unsigned char)text[i]) << 16) |
+           ((uint32_t)foldByte((unsigned char)text[i + 1]) << 8) |
+           (uint32_t)foldByte((unsigned char)text[i + 2]);
+}
+
+static void collectTrigrams(const std::string& text, std::vector<uint32_t>& keys) {
+    keys.clear();
+    if (text.size() < 3) return;
+
+    keys.reserve(text.size() - 2);
+    for (size_t i = 0; i + 2 < text.size(); i++) {
+        keys.push_back(trigramKey(text, i));
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+}
+
+static bool matchesAt(const std::string& text, size_t pos, const std::string& query, bool ignoreCase) {
+    if (!ignoreCase) {
+        return text.compare(pos, query.size(), query) == 0;
+    }
+    for (size_t k = 0; k < query.size(); k++) {
+        if (foldByte((unsigned char)text[pos + k]) != foldByte((unsigned char)query[k])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+ScrollbackIndex::ScrollbackIndex(int maxLines)
+    : m_maxLines(maxLines > 0 ? maxLines : 1)
+    , m_base(0)
+    , m_postingCount(0)
+    , m_liveTrigramCount(0)
+{
+}
+
+void ScrollbackIndex::clear() {
+    m_base += m_lines.size();
+    m_lines.clear();
+    m_dirty.clear();
+    m_postings.clear();
+    m_postingCount = 0;
+    m_liveTrigramCount = 0;
+}
+
+// ============================================================================
+// LINE UPDATES
+// ============================================================================
+
+ScrollbackIndex::LineEntry& ScrollbackIndex::ensureLine(int line) {
+    while ((int)m_lines.size() <= line) {
+        m_lines.emplace_back();
+    }
+    return m_lines[line];
+}
+
+void ScrollbackIndex::indexLine(uint64_t seq, LineEntry& entry) {
+    std::vector<uint32_t> keys;
+    collectTrigrams(entry.text, keys);
+
+    for (uint32_t key : keys) {
+        std::vector<uint64_t>& list = m_postings[key];
+        // Lines are usually rewritten in place (terminal output grows the
+        // current row), so skip the append when this line is already last
+        if (list.empty() || list.back() != seq) {
+            list.push_back(seq);
+            m_postingCount++;
+        }
+    }
+
+    entry.trigramCount = (uint32_t)keys.size();
+    m_liveTrigramCount += keys.size();
+}
+
+void ScrollbackIndex::setLine(int line, const std::string& utf8) {
+    if (line < 0 || line >= m_maxLines) return;
+
+    LineEntry& entry = ensureLine(line);
+    if (entry.text == utf8) return;
+
+    m_liveTrigramCount -= entry.trigramCount;
+    entry.text = utf8;
+    indexLine(m_base + line, entry);
+    compactIfNeeded();
+}
+
+void ScrollbackIndex::setLineCodepoints(int line, const uint32_t* codepoints, int count) {
+    setLine(line, encodeCodepoints(codepoints, count));
+}
+
+void ScrollbackIndex::appendLine(const std::string& utf8) {
+    if ((int)m_lines.size() >= m_maxLines) {
+        dropFront((int)m_lines.size() - m_maxLines + 1);
+    }
+    m_lines.emplace_back();
+    m_lines.back().text = utf8;
+    indexLine(m_base + m_lines.size() - 1, m_lines.back());
+    compactIfNeeded();
+}
+
+void ScrollbackIndex::dropFront(int count) {
+    if (count <= 0) return;
+    if (count > (int)m_lines.size()) count = (int)m_lines.size();
+
+    for (int i = 0; i < count; i++) {
+        m_liveTrigramCount -= m_lines.front().trigramCount;
+        m_lines.pop_front();
+    }
+
+    // Remaining lines are renumbered by moving the base; their postings stay valid
+    m_base += count;
+    compactIfNeeded();
+}
+
+// ============================================================================
+// DIRTY TRACKING
+// ============================================================================
+
+void ScrollbackIndex::markDirty(int line) {
+    if (line < 0 || line >= m_maxLines) return;
+
+    LineEntry& entry = ensureLine(line);
+    if (!entry.dirty) {
+        entry.dirty = true;
+        m_dirty.push_back(m_base + line);
+    }
+}
+
+void ScrollbackIndex::refreshDirty(const std::function<void(int line)>& refresh) {
+    std::vector<uint64_t> pending;
+    pending.swap(m_dirty);
+
+    for (uint64_t seq : pending) {
+        if (seq < m_base) continue;   // Line was discarded since it was marked
+        uint64_t line = seq - m_base;
+        if (line >= m_lines.size()) continue;
+
+        m_lines[line].dirty = false;
+        refresh((int)line);
+    }
+}
+
+// ============================================================================
+// COMPACTION
+// ============================================================================
+
+void ScrollbackIndex::compactIfNeeded() {
+    if (m_postingCount > m_liveTrigramCount * 2 + COMPACT_SLACK) {
+        rebuild();
+    }
+}
+
+void ScrollbackIndex::rebuild() {
+    m_postings.clear();
+    m_postingCount = 0;
+    m_liveTrigramCount = 0;
+
+    for (size_t i = 0; i < m_lines.size(); i++) {
+        indexLine(m_base + i, m_lines[i]);
+    }
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+const std::string& ScrollbackIndex::lineText(int line) const {
+    static const std::string empty;
+    if (line < 0 || line >= (int)m_lines.size()) return empty;
+    return m_lines[line].text;
+}
+
+void ScrollbackIndex::collectCandidates(const std::string& query, std::vector<int>& lines) const {
+    lines.clear();
+
+    if (query.size() < 3) {
+        // Too short to use trigrams - every line is a candidate
+        lines.reserve(m_lines.size());
+        for (int i = 0; i < (int)m_lines.size(); i++) {
+            lines.push_back(i);
+        }
+        return;
+    }
+
+    // Walk the rarest trigram's postings; verification filters the rest
+    const std::vector<uint64_t>* rarest = nullptr;
+    for (size_t i = 0; i + 2 < query.size(); i++) {
+        auto it = m_postings.find(trigramKey(query, i));
+        if (it == m_postings.end()) return;
+        if (!rarest || it->second.size() < rarest->size()) {
+            rarest = &it->second;
+        }
+    }
+    if (!rarest) return;
+
+    lines.reserve(rarest->size());
+    for (uint64_t seq : *rarest) {
+        if (seq < m_base) continue;
+        uint64_t line = seq - m_base;
+        if (line < m_lines.size()) {
+            lines.push_back((int)line);
+        }
+    }
+    std::sort(lines.begin(), lines.end());
+    lines.erase(std::unique(lines.begin(), lines.end()), lines.end());
+}
+
+int ScrollbackIndex::findInLine(const std::string& text, const std::string& query, size_t fromByte,
+                                bool ignoreCase) const {
+    if (query.size() > text.size() || fromByte > text.size() - query.size()) return -1;
+
+    if (!ignoreCase) {
+        size_t pos = text.find(query, fromByte);
+        return pos == std::string::npos ? -1 : (int)pos;
+    }
+
+    for (size_t pos = fromByte; pos + query.size() <= text.size(); pos++) {
+        if (matchesAt(text, pos, query, true)) return (int)pos;
+    }
+    return -1;
+}
+
+int ScrollbackIndex::findLastInLine(const std::string& text, const std::string& query, size_t beforeByte,
+                                    bool ignoreCase) const {
+    if (query.size() > text.size() || beforeByte == 0) return -1;
+
+    size_t pos = std::min(beforeByte - 1, text.size() - query.size());
+    for (;;) {
+        if (matchesAt(text, pos, query, ignoreCase)) return (int)pos;
+        if (pos == 0) break;
+        pos--;
+    }
+    return -1;
+}
+
+bool ScrollbackIndex::findNext(const std::string& query, int fromLine, int fromColumn,
+                               bool ignoreCase, bool wrap, ScrollbackMatch& out) const {
+    if (query.empty() || m_lines.empty()) return false;
+    if (fromLine < 0) { fromLine = 0; fromColumn = 0; }
+
+    std::vector<int> candidates;
+    collectCandidates(query, candidates);
+    if (candidates.empty()) return false;
+
+    const int queryColumns = byteToColumn(query, query.size());
+    auto start = std::lower_bound(candidates.begin(), candidates.end(), fromLine);
+
+    // Forward from the start position to the end of the scrollback
+    for (auto it = start; it != candidates.end(); ++it) {
+        const std::string& text = m_lines[*it].text;
+        size_t fromByte = (*it == fromLine) ? columnToByte(text, fromColumn) : 0;
+        int pos = findInLine(text, query, fromByte, ignoreCase);
+        if (pos >= 0) {
+            out = { *it, byteToColumn(text, pos), queryColumns };
+            return true;
+        }
+    }
+
+    if (!wrap) return false;
+
+    // Wrap around to the top, finishing at the start position
+    for (auto it = candidates.begin(); it != candidates.end() && *it <= fromLine; ++it) {
+        const std::string& text = m_lines[*it].text;
+        int pos = findInLine(text, query, 0, ignoreCase);
+        if (pos < 0) continue;
+        if (*it == fromLine && pos >= (int)columnToByte(text, fromColumn)) break;
+        out = { *it, byteToColumn(text, pos), queryColumns };
+        return true;
+    }
+    return false;
+}
+
+bool ScrollbackIndex::findPrevious(const std::string& query, int fromLine, int fromColumn,
+                                   bool ignoreCase, bool wrap, ScrollbackMatch& out) const {
+    if (query.empty() || m_lines.empty()) return false;
+    if (fromLine >= (int)m_lines.size()) { fromLine = (int)m_lines.size() - 1; fromColumn = -1; }
+
+    std::vector<int> candidates;
+    collectCandidates(query, candidates);
+    if (candidates.empty()) return false;
+
+    const int queryColumns = byteToColumn(query, query.size());
+    auto start = std::upper_bound(candidates.begin(), candidates.end(), fromLine);
+
+    // Backward from the start position (matches must begin before it)
+    for (auto it = start; it != candidates.begin(); ) {
+        --it;
+        const std::string& text = m_lines[*it].text;
+        size_t beforeByte = (*it == fromLine && fromColumn >= 0) ? columnToByte(text, fromColumn)
+                                                                  : text.size() + 1;
+        int pos = findLastInLine(text, query, beforeByte, ignoreCase);
+        if (pos >= 0) {
+            out = { *it, byteToColumn(text, pos), queryColumns };
+            return true;
+        }
+    }
+
+    if (!wrap) return false;
+
+    // Wrap around to the bottom, finishing at the start position
+    for (auto it = candidates.end(); it != candidates.begin(); ) {
+        --it;
+        if (*it < fromLine) break;
+        const std::string& text = m_lines[*it].text;
+        int pos = findLastInLine(text, query, text.size() + 1, ignoreCase);
+        if (pos < 0) continue;
+        if (*it == fromLine && fromColumn >= 0 && pos < (int)columnToByte(text, fromColumn)) break;
+        out = { *it, byteToColumn(text, pos), queryColumns };
+        return true;
+    }
+    return false;
+}
+
+std::vector<ScrollbackMatch> ScrollbackIndex::findAll(const std::string& query, bool ignoreCase,
+                                                      size_t maxResults) const {
+    std::vector<ScrollbackMatch> matches;
+    if (query.empty()) return matches;
+
+    std::vector<int> candidates;
+    collectCandidates(query, candidates);
+
+    const int queryColumns = byteToColumn(query, query.size());
+    for (int line : candidates) {
+        const std::string& text = m_lines[line].text;
+        size_t fromByte = 0;
+        int pos;
+        while ((pos = findInLine(text, query, fromByte, ignoreCase)) >= 0) {
+            matches.push_back({ line, byteToColumn(text, pos), queryColumns });
+            if (maxResults && matches.size() >= maxResults) return matches;
+            fromByte = pos + query.size();
+        }
+    }
+    return matches;
+}
+
+// ============================================================================
+// UTF-8 HELPERS
+// ============================================================================
+
+std::string ScrollbackIndex::encodeCodepoints(const uint32_t* codepoints, int count) {
+    // Trailing blanks never match anything useful; drop them from the shadow
+    while (count > 0 && (codepoints[count - 1] == 0 || codepoints[count - 1] == ' ')) {
+        count--;
+    }
+
+    std::string out;
+    out.reserve(count);
+    for (int i = 0; i < count; i++) {
+        uint32_t cp = codepoints[i];
+        if (cp == 0) cp = ' ';   // Empty cells read as spaces so columns stay aligned
+        if (cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) cp = 0xFFFD;
+
+        if (cp < 0x80) {
+            out += (char)cp;
+        } else if (cp < 0x800) {
+            out += (char)(0xC0 | (cp >> 6));
+            out += (char)(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            out += (char)(0xE0 | (cp >> 12));
+            out += (char)(0x80 | ((cp >> 6) & 0x3F));
+            out += (char)(0x80 | (cp & 0x3F));
+        } else {
+            out += (char)(0xF0 | (cp >> 18));
+            out += (char)(0x80 | ((cp >> 12) & 0x3F));
+            out += (char)(0x80 | ((cp >> 6) & 0x3F));
+            out += (char)(0x80 | (cp & 0x3F));
+        }
+    }
+    return out;
+}
+
+int ScrollbackIndex::byteToColumn(const std::string& text, size_t byteOffset) {
+    if (byteOffset > text.size()) byteOffset = text.size();
+
+    int column = 0;
+    for (size_t i = 0; i < byteOffset; i++) {
+        if (((unsigned char)text[i] & 0xC0) != 0x80) column++;
+    }
+    return column;
+}
+
+size_t ScrollbackIndex::columnToByte(const std::string& text, int column) {
+    if (column <= 0) return 0;
+
+    int seen = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+        if (((unsigned char)text[i] & 0xC0) != 0x80) {
+            if (seen == column) return i;
+            seen++;
+        }
+    }
+    return text.size();
+}
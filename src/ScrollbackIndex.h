@@ -0,0 +1,98 @@
+//
+//  ScrollbackIndex.h
+//  SuperTerminal Framework - Scrollback Search Index
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+//  Incremental trigram index over scrollback text. Keeps a UTF-8 shadow of
+//  every line so searches never touch the TextCell grid, and survives the
+//  ring-buffer style discard of old lines (dropFront) without a rebuild.
+//
+
+#ifndef ScrollbackIndex_h
+#define ScrollbackIndex_h
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// A single search hit. Columns are codepoint offsets, which match grid cells
+// for the terminal layer and character positions for REPL output lines.
+struct ScrollbackMatch {
+    int line;      // Line number (0 = oldest line still retained)
+    int column;    // First column of the match
+    int length;    // Match length in columns
+};
+
+class ScrollbackIndex {
+public:
+    explicit ScrollbackIndex(int maxLines);
+
+    // Line updates
+    void setLine(int line, const std::string& utf8);
+    void setLineCodepoints(int line, const uint32_t* codepoints, int count);
+    void appendLine(const std::string& utf8);
+    void dropFront(int count);
+    void clear();
+
+    // Dirty tracking for sources that are refreshed lazily (the terminal grid).
+    // The refresh callback is expected to call setLine/setLineCodepoints.
+    void markDirty(int line);
+    bool hasDirtyLines() const { return !m_dirty.empty(); }
+    void refreshDirty(const std::function<void(int line)>& refresh);
+
+    // Queries (ignoreCase folds ASCII only)
+    bool findNext(const std::string& query, int fromLine, int fromColumn,
+                  bool ignoreCase, bool wrap, ScrollbackMatch& out) const;
+    bool findPrevious(const std::string& query, int fromLine, int fromColumn,
+                      bool ignoreCase, bool wrap, ScrollbackMatch& out) const;
+    std::vector<ScrollbackMatch> findAll(const std::string& query, bool ignoreCase,
+                                         size_t maxResults = 0) const;
+
+    // State queries
+    int lineCount() const { return (int)m_lines.size(); }
+    int maxLines() const { return m_maxLines; }
+    const std::string& lineText(int line) const;
+    size_t postingCount() const { return m_postingCount; }
+
+    // Helpers shared with callers that hold codepoint grids
+    static std::string encodeCodepoints(const uint32_t* codepoints, int count);
+    static int byteToColumn(const std::string& text, size_t byteOffset);
+    static size_t columnToByte(const std::string& text, int column);
+
+private:
+    struct LineEntry {
+        std::string text;
+        uint32_t trigramCount = 0;   // Distinct trigrams posted for this text
+        bool dirty = false;
+    };
+
+    int m_maxLines;
+    uint64_t m_base;                 // Sequence number of m_lines[0]
+    std::deque<LineEntry> m_lines;
+    std::vector<uint64_t> m_dirty;   // Sequence numbers awaiting refresh
+
+    // Trigram -> line sequence numbers. Lists are append-only; entries for
+    // dropped or rewritten lines go stale and are filtered at query time
+    // until the next compaction.
+    std::unordered_map<uint32_t, std::vector<uint64_t>> m_postings;
+    size_t m_postingCount;
+    size_t m_liveTrigramCount;
+
+    LineEntry& ensureLine(int line);
+    void indexLine(uint64_t seq, LineEntry& entry);
+    void compactIfNeeded();
+    void rebuild();
+
+    void collectCandidates(const std::string& query, std::vector<int>& lines) const;
+    int findInLine(const std::string& text, const std::string& query, size_t fromByte,
+                   bool ignoreCase) const;
+    int findLastInLine(const std::string& text, const std::string& query, size_t beforeByte,
+                       bool ignoreCase) const;
+};
+
+#endif /* ScrollbackIndex_h */
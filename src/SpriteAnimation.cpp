@@ -0,0 +1,389 @@
+//
+//  SpriteAnimation.cpp
+//  SuperTerminal Framework - Atlas Sprite Animation
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "SpriteAnimation.h"
+#include <algorithm>
+#include <cmath>
+
+// =============================================================================
+// SpriteAtlas
+// =============================================================================
+
+SpriteAtlas::SpriteAtlas(int textureWidth, int textureHeight)
+    : m_textureWidth(textureWidth), m_textureHeight(textureHeight) {
+}
+
+int SpriteAtlas::addFrame(int x, int y, int width, int height) {
+    if (m_textureWidth <= 0 || m_textureHeight <= 0 || width <= 0 || height <= 0 ||
+        x < 0 || y < 0 || x + width > m_textureWidth || y + height > m_textureHeight) {
+        return -1;
+    }
+
+    AtlasFrame frame;
+    frame.u0 = (float)x / m_textureWidth;
+    frame.v0 = (float)y / m_textureHeight;
+    frame.u1 = (float)(x + width) / m_textureWidth;
+    frame.v1 = (float)(y + height) / m_textureHeight;
+    frame.width = (uint16_t)width;
+    frame.height = (uint16_t)height;
+    m_frames.push_back(frame);
+    return (int)m_frames.size() - 1;
+}
+
+int SpriteAtlas::addGrid(int frameWidth, int frameHeight, int margin, int spacing) {
+    if (frameWidth <= 0 || frameHeight <= 0 || margin < 0 || spacing < 0) {
+        return 0;
+    }
+
+    int added = 0;
+    for (int y = margin; y + frameHeight <= m_textureHeight - margin; y += frameHeight + spacing) {
+        for (int x = margin; x + frameWidth <= m_textureWidth - margin; x += frameWidth + spacing) {
+            if (addFrame(x, y, frameWidth, frameHeight) >= 0) {
+                added++;
+            }
+        }
+    }
+    return added;
+}
+
+// =============================================================================
+// SpriteAnimator - definitions
+// =============================================================================
+
+SpriteAnimator::SpriteAnimator() = default;
+
+void SpriteAnimator::defineAtlas(uint32_t atlasId, const SpriteAtlas& atlas) {
+    m_atlases[atlasId] = atlas;
+}
+
+const SpriteAtlas* SpriteAnimator::getAtlas(uint32_t atlasId) const {
+    auto it = m_atlases.find(atlasId);
+    return it == m_atlases.end() ? nullptr : &it->second;
+}
+
+bool SpriteAnimator::defineClip(uint32_t clipId, uint32_t atlasId, uint32_t firstFrame, uint32_t lastFrame,
+                                float frameDuration, AnimationPlayMode mode) {
+    std::vector<uint32_t> frames;
+    if (firstFrame <= lastFrame) {
+        for (uint32_t frame = firstFrame; frame <= lastFrame; frame++) frames.push_back(frame);
+    } else {
+        for (uint32_t frame = firstFrame + 1; frame-- > lastFrame; ) frames.push_back(frame);
+    }
+    return defineClipFrames(clipId, atlasId, frames, std::vector<float>{frameDuration}, mode);
+}
+
+bool SpriteAnimator::defineClipFrames(uint32_t clipId, uint32_t atlasId, const std::vector<uint32_t>& frames,
+                                      const std::vector<float>& durations, AnimationPlayMode mode) {
+    const SpriteAtlas* atlas = getAtlas(atlasId);
+    if (!atlas || frames.empty() || (durations.size() != 1 && durations.size() != frames.size())) {
+        return false;
+    }
+    for (uint32_t frame : frames) {
+        if (frame >= atlas->getFrameCount()) {
+            return false;
+        }
+    }
+
+    Clip clip;
+    clip.atlasId = atlasId;
+    clip.mode = mode;
+    clip.frames = frames;
+    clip.durations.resize(frames.size());
+    for (size_t i = 0; i < frames.size(); i++) {
+        clip.durations[i] = std::max(MIN_FRAME_DURATION, durations.size() == 1 ? durations[0] : durations[i]);
+    }
+    finishClip(clip);
+
+    // Assign in place so instances keep a valid Clip pointer
+    Clip& stored = m_clips[clipId];
+    stored = std::move(clip);
+    restartInstancesOf(&stored);
+    return true;
+}
+
+bool SpriteAnimator::setFrameDuration(uint32_t clipId, uint32_t clipFrame, float seconds) {
+    auto it = m_clips.find(clipId);
+    if (it == m_clips.end() || clipFrame >= it->second.frames.size()) {
+        return false;
+    }
+    it->second.durations[clipFrame] = std::max(MIN_FRAME_DURATION, seconds);
+    finishClip(it->second);
+    return true;
+}
+
+bool SpriteAnimator::addClipEvent(uint32_t clipId, uint32_t clipFrame, int32_t eventId) {
+    auto it = m_clips.find(clipId);
+    if (it == m_clips.end() || clipFrame >= it->second.frames.size()) {
+        return false;
+    }
+    it->second.events.emplace_back(clipFrame, eventId);
+    it->second.hasEvents[clipFrame] = 1;
+    return true;
+}
+
+bool SpriteAnimator::removeClip(uint32_t clipId) {
+    auto it = m_clips.find(clipId);
+    if (it == m_clips.end()) {
+        return false;
+    }
+    for (size_t i = m_instances.size(); i-- > 0; ) {
+        if (m_instances[i].clip == &it->second) {
+            removeInstance(i);
+        }
+    }
+    m_clips.erase(it);
+    return true;
+}
+
+size_t SpriteAnimator::getClipLength(uint32_t clipId) const {
+    auto it = m_clips.find(clipId);
+    return it == m_clips.end() ? 0 : it->second.frames.size();
+}
+
+void SpriteAnimator::finishClip(Clip& clip) {
+    clip.hasEvents.resize(clip.frames.size(), 0);
+
+    float total = 0.0f;
+    for (float duration : clip.durations) total += duration;
+
+    // Time for the cursor to come back to the same frame and direction
+    if (clip.mode == AnimationPlayMode::PingPong && clip.frames.size() > 1) {
+        clip.cycleDuration = 2.0f * total - clip.durations.front() - clip.durations.back();
+    } else if (clip.mode == AnimationPlayMode::Once) {
+        clip.cycleDuration = 0.0f;
+    } else {
+        clip.cycleDuration = total;
+    }
+}
+
+// =============================================================================
+// SpriteAnimator - playback
+// =============================================================================
+
+SpriteAnimator::Instance* SpriteAnimator::findInstance(uint16_t spriteId) {
+    if (spriteId >= m_slotForSprite.size() || m_slotForSprite[spriteId] < 0) {
+        return nullptr;
+    }
+    return &m_instances[m_slotForSprite[spriteId]];
+}
+
+const SpriteAnimator::Instance* SpriteAnimator::findInstance(uint16_t spriteId) const {
+    if (spriteId >= m_slotForSprite.size() || m_slotForSprite[spriteId] < 0) {
+        return nullptr;
+    }
+    return &m_instances[m_slotForSprite[spriteId]];
+}
+
+void SpriteAnimator::removeInstance(size_t index) {
+    m_slotForSprite[m_instances[index].spriteId] = -1;
+    if (index + 1 != m_instances.size()) {
+        m_instances[index] = m_instances.back();
+        m_slotForSprite[m_instances[index].spriteId] = (int32_t)index;
+    }
+    m_instances.pop_back();
+}
+
+void SpriteAnimator::restartInstancesOf(const Clip* clip) {
+    for (Instance& instance : m_instances) {
+        if (instance.clip == clip) {
+            instance.cursor = 0;
+            instance.direction = 1;
+            instance.elapsed = 0.0f;
+            instance.playing = true;
+            instance.entered = true;
+        }
+    }
+}
+
+bool SpriteAnimator::play(uint16_t spriteId, uint32_t clipId, float speed, bool restart) {
+    auto it = m_clips.find(clipId);
+    if (it == m_clips.end()) {
+        return false;
+    }
+    speed = std::max(0.0f, speed);
+
+    Instance* instance = findInstance(spriteId);
+    if (instance && instance->clipId == clipId && instance->playing && !restart) {
+        instance->speed = speed;
+        instance->paused = false;
+        return true;
+    }
+
+    if (!instance) {
+        if (spriteId >= m_slotForSprite.size()) {
+            m_slotForSprite.resize(spriteId + 1, -1);
+        }
+        m_slotForSprite[spriteId] = (int32_t)m_instances.size();
+        m_instances.emplace_back();
+        instance = &m_instances.back();
+    }
+
+    instance->spriteId = spriteId;
+    instance->clipId = clipId;
+    instance->clip = &it->second;
+    instance->cursor = 0;
+    instance->direction = 1;
+    instance->playing = true;
+    instance->paused = false;
+    instance->entered = true;
+    instance->elapsed = 0.0f;
+    instance->speed = speed;
+    return true;
+}
+
+bool SpriteAnimator::stop(uint16_t spriteId) {
+    if (spriteId >= m_slotForSprite.size() || m_slotForSprite[spriteId] < 0) {
+        return false;
+    }
+    removeInstance(m_slotForSprite[spriteId]);
+    return true;
+}
+
+bool SpriteAnimator::setPaused(uint16_t spriteId, bool paused) {
+    Instance* instance = findInstance(spriteId);
+    if (!instance) return false;
+    instance->paused = paused;
+    return true;
+}
+
+bool SpriteAnimator::setSpeed(uint16_t spriteId, float speed) {
+    Instance* instance = findInstance(spriteId);
+    if (!instance) return false;
+    instance->speed = std::max(0.0f, speed);
+    return true;
+}
+
+bool SpriteAnimator::isPlaying(uint16_t spriteId) const {
+    const Instance* instance = findInstance(spriteId);
+    return instance && instance->playing && !instance->paused;
+}
+
+int SpriteAnimator::getClipFrame(uint16_t spriteId) const {
+    const Instance* instance = findInstance(spriteId);
+    return instance ? (int)instance->cursor : -1;
+}
+
+int SpriteAnimator::getAtlasFrame(uint16_t spriteId) const {
+    const Instance* instance = findInstance(spriteId);
+    return instance ? (int)instance->clip->frames[instance->cursor] : -1;
+}
+
+void SpriteAnimator::enterFrame(Instance& instance) {
+    instance.entered = false;
+    const Clip& clip = *instance.clip;
+    m_changes.push_back({instance.spriteId, clip.atlasId, clip.frames[instance.cursor]});
+    emitFrameEvents(instance);
+}
+
+void SpriteAnimator::emitFrameEvents(const Instance& instance) {
+    const Clip& clip = *instance.clip;
+    if (!clip.hasEvents[instance.cursor]) {
+        return;
+    }
+    for (const auto& event : clip.events) {
+        if (event.first == instance.cursor) {
+            m_events.push_back({instance.spriteId, instance.clipId, AnimationEventType::Frame,
+                                event.second, instance.cursor});
+        }
+    }
+}
+
+void SpriteAnimator::stepCursor(Instance& instance) {
+    const Clip& clip = *instance.clip;
+    uint32_t count = (uint32_t)clip.frames.size();
+
+    switch (clip.mode) {
+        case AnimationPlayMode::Once:
+            if (instance.cursor + 1 >= count) {
+                instance.playing = false;
+                instance.elapsed = 0.0f;
+                m_events.push_back({instance.spriteId, instance.clipId, AnimationEventType::Finished, 0, instance.cursor});
+                return;
+            }
+            instance.cursor++;
+            break;
+
+        case AnimationPlayMode::Loop:
+            if (++instance.cursor >= count) {
+                instance.cursor = 0;
+                m_events.push_back({instance.spriteId, instance.clipId, AnimationEventType::Loop, 0, 0});
+            }
+            break;
+
+        case AnimationPlayMode::PingPong:
+            if (count > 1) {
+                int next = (int)instance.cursor + instance.direction;
+                if (next < 0 || next >= (int)count) {
+                    instance.direction = (int8_t)-instance.direction;
+                    next = (int)instance.cursor + instance.direction;
+                }
+                instance.cursor = (uint32_t)next;
+            }
+            if (instance.cursor == 0) {
+                m_events.push_back({instance.spriteId, instance.clipId, AnimationEventType::Loop, 0, 0});
+            }
+            break;
+    }
+
+    emitFrameEvents(instance);
+}
+
+void SpriteAnimator::update(float dt) {
+    m_changes.clear();
+    m_events.clear();
+    if (!(dt > 0.0f)) {
+        dt = 0.0f;
+    }
+
+    for (Instance& instance : m_instances) {
+        if (instance.entered) {
+            enterFrame(instance);
+        }
+        if (!instance.playing || instance.paused) {
+            continue;
+        }
+
+        const Clip& clip = *instance.clip;
+        uint32_t startFrame = clip.frames[instance.cursor];
+        size_t cycleSteps = clip.mode == AnimationPlayMode::PingPong && clip.frames.size() > 1
+                                ? clip.frames.size() * 2 - 2 : clip.frames.size();
+        size_t steps = 0;
+        bool moved = false;
+
+        instance.elapsed += dt * instance.speed;
+        while (instance.playing && instance.elapsed >= clip.durations[instance.cursor]) {
+            instance.elapsed -= clip.durations[instance.cursor];
+            stepCursor(instance);
+            moved = true;
+
+            // A huge dt would walk the clip many times; after one full cycle
+            // the cursor is back where it started, so drop whole cycles
+            if (++steps >= cycleSteps && clip.cycleDuration > 0.0f) {
+                instance.elapsed = std::fmod(instance.elapsed, clip.cycleDuration);
+                steps = 0;
+            }
+        }
+
+        if (moved && clip.frames[instance.cursor] != startFrame) {
+            m_changes.push_back({instance.spriteId, clip.atlasId, clip.frames[instance.cursor]});
+        }
+    }
+}
+
+void SpriteAnimator::clearInstances() {
+    m_instances.clear();
+    std::fill(m_slotForSprite.begin(), m_slotForSprite.end(), -1);
+    m_changes.clear();
+    m_events.clear();
+}
+
+void SpriteAnimator::clear() {
+    clearInstances();
+    m_clips.clear();
+    m_atlases.clear();
+}
@@ -0,0 +1,162 @@
+//
+//  SpriteAnimation.h
+//  SuperTerminal Framework - Atlas Sprite Animation
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+//  Native animation clips over texture atlases. An atlas is a list of
+//  frame rectangles inside one sprite texture; a clip is a sequence of atlas
+//  frames with per-frame durations, a play mode and optional frame events.
+//  SpriteAnimator advances every playing sprite in one pass per simulation
+//  step and reports only the sprites whose frame changed, so the sprite layer
+//  updates a UV rectangle instead of swapping textures from Lua every frame.
+//
+//  Not thread-safe; the sprite layer serialises access.
+//
+
+#ifndef SpriteAnimation_h
+#define SpriteAnimation_h
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+enum class AnimationPlayMode : uint8_t {
+    Once = 0,       // Stop on the last frame
+    Loop = 1,       // Wrap to the first frame
+    PingPong = 2    // Run forwards then backwards
+};
+
+// One frame of an atlas: UVs (0..1, v down) and size in pixels
+struct AtlasFrame {
+    float u0, v0, u1, v1;
+    uint16_t width, height;
+};
+
+class SpriteAtlas {
+public:
+    SpriteAtlas(int textureWidth = 0, int textureHeight = 0);
+
+    // Pixel rectangle inside the texture; returns the frame index or -1
+    int addFrame(int x, int y, int width, int height);
+
+    // Row-major grid of equal frames; returns the number of frames added
+    int addGrid(int frameWidth, int frameHeight, int margin = 0, int spacing = 0);
+
+    size_t getFrameCount() const { return m_frames.size(); }
+    const AtlasFrame& getFrame(size_t index) const { return m_frames[index]; }
+    int getTextureWidth() const { return m_textureWidth; }
+    int getTextureHeight() const { return m_textureHeight; }
+
+private:
+    int m_textureWidth;
+    int m_textureHeight;
+    std::vector<AtlasFrame> m_frames;
+};
+
+enum class AnimationEventType : uint8_t {
+    Frame = 0,      // Entered a clip frame that carries an event id
+    Loop = 1,       // Completed a loop or ping-pong cycle
+    Finished = 2    // A Once clip reached its end
+};
+
+struct AnimationEvent {
+    uint16_t spriteId;
+    uint32_t clipId;
+    AnimationEventType type;
+    int32_t eventId;                // Frame events only
+    uint32_t clipFrame;
+};
+
+// A sprite whose displayed atlas frame changed during update()
+struct AnimationFrameChange {
+    uint16_t spriteId;
+    uint32_t atlasId;
+    uint32_t atlasFrame;
+};
+
+class SpriteAnimator {
+public:
+    static constexpr float MIN_FRAME_DURATION = 0.0001f;
+
+    SpriteAnimator();
+
+    // Atlases and clips, keyed by caller-chosen ids. Redefining a clip
+    // restarts sprites that are playing it.
+    void defineAtlas(uint32_t atlasId, const SpriteAtlas& atlas);
+    const SpriteAtlas* getAtlas(uint32_t atlasId) const;
+
+    // firstFrame > lastFrame plays the range backwards
+    bool defineClip(uint32_t clipId, uint32_t atlasId, uint32_t firstFrame, uint32_t lastFrame,
+                    float frameDuration, AnimationPlayMode mode);
+    bool defineClipFrames(uint32_t clipId, uint32_t atlasId, const std::vector<uint32_t>& frames,
+                          const std::vector<float>& durations, AnimationPlayMode mode);
+    bool setFrameDuration(uint32_t clipId, uint32_t clipFrame, float seconds);
+    bool addClipEvent(uint32_t clipId, uint32_t clipFrame, int32_t eventId);
+    bool removeClip(uint32_t clipId);
+    size_t getClipLength(uint32_t clipId) const;
+
+    // Per-sprite playback. play() with the clip already running and
+    // restart = false keeps the current position; a finished clip restarts.
+    bool play(uint16_t spriteId, uint32_t clipId, float speed = 1.0f, bool restart = true);
+    bool stop(uint16_t spriteId);
+    bool setPaused(uint16_t spriteId, bool paused);
+    bool setSpeed(uint16_t spriteId, float speed);
+    bool isPlaying(uint16_t spriteId) const;
+    int getClipFrame(uint16_t spriteId) const;     // -1 when not animated
+    int getAtlasFrame(uint16_t spriteId) const;    // -1 when not animated
+
+    // Advance every playing sprite by dt seconds. Results are valid until
+    // the next update() call.
+    void update(float dt);
+    const std::vector<AnimationFrameChange>& getFrameChanges() const { return m_changes; }
+    const std::vector<AnimationEvent>& getEvents() const { return m_events; }
+
+    size_t getInstanceCount() const { return m_instances.size(); }
+    void clearInstances();
+    void clear();
+
+private:
+    struct Clip {
+        uint32_t atlasId = 0;
+        AnimationPlayMode mode = AnimationPlayMode::Loop;
+        std::vector<uint32_t> frames;
+        std::vector<float> durations;
+        std::vector<uint8_t> hasEvents;                     // Per clip frame
+        std::vector<std::pair<uint32_t, int32_t>> events;   // (clip frame, id)
+        float cycleDuration = 0.0f;
+    };
+
+    struct Instance {
+        uint16_t spriteId;
+        uint32_t clipId;
+        const Clip* clip;
+        uint32_t cursor;
+        int8_t direction;
+        bool playing;
+        bool paused;
+        bool entered;               // Frame change/events pending for cursor
+        float elapsed;
+        float speed;
+    };
+
+    std::unordered_map<uint32_t, SpriteAtlas> m_atlases;
+    std::unordered_map<uint32_t, Clip> m_clips;     // Node based: Clip* stays valid
+    std::vector<Instance> m_instances;
+    std::vector<int32_t> m_slotForSprite;           // spriteId -> m_instances index
+    std::vector<AnimationFrameChange> m_changes;
+    std::vector<AnimationEvent> m_events;
+
+    Instance* findInstance(uint16_t spriteId);
+    const Instance* findInstance(uint16_t spriteId) const;
+    void removeInstance(size_t index);
+    void restartInstancesOf(const Clip* clip);
+    void enterFrame(Instance& instance);
+    void emitFrameEvents(const Instance& instance);
+    void stepCursor(Instance& instance);
+    static void finishClip(Clip& clip);
+};
+
+#endif /* SpriteAnimation_h */
@@ -7,8 +7,11 @@
 //
 
 #include "../SpriteEffectSystem.h"
+#include "FixedTimestep.h"
+#include "FrameArena.h"
 #import <Foundation/Foundation.h>
 #import <Metal/Metal.h>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <sys/stat.h>
@@ -311,13 +314,38 @@ void SpriteEffectManager::renderSpritesWithEffects(void* encoder,
                                                   const float viewProjection[16]) {
     if (spriteIds.empty()) return;
 
-    // Group sprites by effect
-    std::map<std::string, std::vector<uint16_t>> groupedSprites;
-    groupSpritesByEffect(spriteIds, groupedSprites);
+    // Group sprites by effect in frame scratch: pair each sprite with its
+    // effect name (no string copies), sort by name, then walk the runs.
+    // Groups come out in the same name order the old std::map gave.
+    static const std::string defaultEffect = "basic";
+    static thread_local std::vector<uint16_t> groupScratch;
+
+    FrameArenaScope scope;
+    FrameVector<std::pair<const std::string*, uint32_t>> tagged;
+    tagged.reserve(spriteIds.size());
+    for (uint32_t i = 0; i < spriteIds.size(); i++) {
+        auto it = _spriteEffectAssignments.find(spriteIds[i]);
+        tagged.emplace_back(it != _spriteEffectAssignments.end() ? &it->second : &defaultEffect, i);
+    }
+    // Index breaks ties so each group keeps submission order; std::sort
+    // rather than stable_sort, which takes a heap buffer
+    std::sort(tagged.begin(), tagged.end(), [](const auto& a, const auto& b) {
+        int order = a.first->compare(*b.first);
+        return order != 0 ? order < 0 : a.second < b.second;
+    });
 
     // Render each effect group
-    for (const auto& group : groupedSprites) {
-        renderEffectGroup(encoder, group.first, group.second, viewProjection);
+    size_t start = 0;
+    while (start < tagged.size()) {
+        const std::string& effectName = *tagged[start].first;
+        groupScratch.clear();
+        size_t end = start;
+        while (end < tagged.size() && *tagged[end].first == effectName) {
+            groupScratch.push_back(spriteIds[tagged[end].second]);
+            end++;
+        }
+        renderEffectGroup(encoder, effectName, groupScratch, viewProjection);
+        start = end;
     }
 }
 
@@ -968,6 +996,7 @@ void SepiaEffect::updateParameters(float deltaTime) {
 using namespace SuperTerminal;
 
 static SpriteEffectManager* g_effectManager = nullptr;
+static int g_effectStepHandle = 0;
 
 extern "C" {
 
@@ -975,11 +1004,21 @@ void sprite_effect_init(void* device, void* shaderLibrary) {
     if (!g_effectManager) {
         g_effectManager = new SpriteEffectManager((__bridge id<MTLDevice>)device,
                                                  (__bridge id<MTLLibrary>)shaderLibrary);
+
+        // Animated effect parameters advance on the fixed simulation step
+        g_effectStepHandle = simulation_scheduler().registerStep("sprite_effects", SIM_STEP_ORDER_SPRITE_EFFECTS,
+            [](float dt, uint64_t) {
+                if (g_effectManager) {
+                    g_effectManager->updateEffects(dt);
+                }
+            });
     }
 }
 
 void sprite_effect_shutdown() {
     if (g_effectManager) {
+        simulation_scheduler().unregisterStep(g_effectStepHandle);
+        g_effectStepHandle = 0;
         delete g_effectManager;
         g_effectManager = nullptr;
     }
@@ -12,6 +12,14 @@
 #import <simd/simd.h>
 #include "../SpriteEffectSystem.h"
 #include "GlobalShutdown.h"
+#include "FixedTimestep.h"
+#include "SpriteAnimation.h"
+#include "SpritePickIndex.h"
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <sys/stat.h>
+#include <vector>
 
 extern "C" {
     void sprite_effect_init(void* device, void* shaderLibrary);
@@ -20,6 +28,7 @@ extern "C" {
     void* sprite_effect_get_pipeline_state(uint16_t spriteId);
     void sprite_effect_bind_parameters(uint16_t spriteId, void* encoder);
     void sprite_clear_all_effects();
+    uint32_t superterminal_get_script_generation(void);
 }
 
 // Sprite command types for thread-safe operations
@@ -69,6 +78,12 @@ typedef struct {
 @property (nonatomic, assign) BOOL loaded;
 @property (nonatomic, assign) int textureWidth;
 @property (nonatomic, assign) int textureHeight;
+@property (nonatomic, assign) uint32_t generation;   // Script generation that loaded it
+@property (nonatomic, copy) NSString* sourcePath;    // Canonical file path, nil for pixel data
+@property (nonatomic, assign) simd_float4 uvRect;    // Texture region: origin xy, size zw
+@property (nonatomic, assign) int frameWidth;        // Atlas frame size, 0 = whole texture
+@property (nonatomic, assign) int frameHeight;
+@property (nonatomic, assign) uint32_t pickOrder;    // Draw order key, later shows are on top
 @end
 
 @implementation SuperTerminalSprite
@@ -86,11 +101,28 @@ typedef struct {
         self.loaded = NO;
         self.textureWidth = 0;
         self.textureHeight = 0;
+        self.generation = 0;
+        self.sourcePath = nil;
+        self.uvRect = simd_make_float4(0.0f, 0.0f, 1.0f, 1.0f);
+        self.frameWidth = 0;
+        self.frameHeight = 0;
+        self.pickOrder = 0;
     }
     return self;
 }
 @end
 
+// Decoded PNG texture kept across soft resets, keyed by file path
+@interface SpriteTextureCacheEntry : NSObject
+@property (nonatomic, strong) id<MTLTexture> texture;
+@property (nonatomic, assign) uint32_t generation;   // Last generation that used it
+@property (nonatomic, assign) int64_t fileSize;      // File identity when decoded;
+@property (nonatomic, assign) int64_t fileModified;  // a mismatch forces a re-decode
+@end
+
+@implementation SpriteTextureCacheEntry
+@end
+
 // Vertex structure for sprite rendering
 struct SpriteVertex {
     simd_float2 position;
@@ -103,8 +135,78 @@ struct SpriteUniforms {
     simd_float4x4 modelMatrix;
     simd_float4x4 viewProjectionMatrix;
     simd_float4 color; // RGBA with alpha channel
+    simd_float4 uvRect; // Texture region for atlas frames
 };
 
+// Atlas animation state. Lua defines clips and starts playback from the
+// script thread; the simulation step advances all sprites and applies frame
+// changes on the render thread.
+static SpriteAnimator g_spriteAnimator;
+static std::mutex g_spriteAnimatorMutex;
+static std::deque<AnimationEvent> g_spriteAnimationEvents;
+static const size_t MAX_PENDING_ANIMATION_EVENTS = 1024;
+static int g_spriteAnimationStepHandle = 0;
+
+static void sprite_animation_forget(uint16_t spriteId) {
+    std::lock_guard<std::mutex> lock(g_spriteAnimatorMutex);
+    g_spriteAnimator.stop(spriteId);
+}
+
+// Picking index over drawn sprites. Kept in step with the sprite state as
+// commands are applied on the render thread; queried from the script thread.
+static SpritePickIndex g_spritePickIndex;
+static std::mutex g_spritePickMutex;
+static uint32_t g_spritePickNextOrder = 0;
+
+static void sprite_pick_sync(SuperTerminalSprite* sprite) {
+    std::lock_guard<std::mutex> lock(g_spritePickMutex);
+    if (!sprite.visible || !sprite.loaded) {
+        g_spritePickIndex.remove(sprite.spriteId);
+        return;
+    }
+
+    // Same quad the renderer draws: atlas frame or whole texture, centred
+    int displayWidth = sprite.frameWidth > 0 ? sprite.frameWidth : sprite.textureWidth;
+    int displayHeight = sprite.frameHeight > 0 ? sprite.frameHeight : sprite.textureHeight;
+    SpritePickShape shape;
+    shape.x = sprite.x;
+    shape.y = sprite.y;
+    shape.halfWidth = fabsf(displayWidth * sprite.scale) * 0.5f;
+    shape.halfHeight = fabsf(displayHeight * sprite.scale) * 0.5f;
+    shape.rotation = sprite.rotation;
+    shape.u0 = sprite.uvRect.x;
+    shape.v0 = sprite.uvRect.y;
+    shape.uSize = sprite.uvRect.z;
+    shape.vSize = sprite.uvRect.w;
+    g_spritePickIndex.update(sprite.spriteId, shape, sprite.pickOrder);
+}
+
+static void sprite_pick_forget(uint16_t spriteId) {
+    std::lock_guard<std::mutex> lock(g_spritePickMutex);
+    g_spritePickIndex.remove(spriteId);
+    g_spritePickIndex.setMask(spriteId, nullptr);
+}
+
+// Alpha mask for pixel-accurate picks, read back from the uploaded texture
+static std::shared_ptr<const SpriteAlphaMask> sprite_pick_mask_from_texture(id<MTLTexture> texture) {
+    if (!texture || texture.pixelFormat != MTLPixelFormatRGBA8Unorm) {
+        return nullptr;
+    }
+    NSUInteger width = texture.width;
+    NSUInteger height = texture.height;
+    std::vector<uint8_t> pixels(width * height * 4);
+    [texture getBytes:pixels.data()
+          bytesPerRow:width * 4
+           fromRegion:MTLRegionMake2D(0, 0, width, height)
+          mipmapLevel:0];
+    return SpriteAlphaMask::fromRGBA(pixels.data(), (int)width, (int)height);
+}
+
+static void sprite_pick_set_mask(uint16_t spriteId, std::shared_ptr<const SpriteAlphaMask> mask) {
+    std::lock_guard<std::mutex> lock(g_spritePickMutex);
+    g_spritePickIndex.setMask(spriteId, std::move(mask));
+}
+
 @interface SpriteLayer : NSObject
 
 @property (nonatomic, strong) id<MTLDevice> device;
@@ -125,6 +227,9 @@ struct SpriteUniforms {
 @property (nonatomic, strong) NSMutableSet<NSNumber*>* freeIds;
 @property (nonatomic, assign) uint16_t nextId;
 
+// Texture cache for generation-based soft reset
+@property (nonatomic, strong) NSMutableDictionary<NSString*, SpriteTextureCacheEntry*>* textureCache;
+
 - (instancetype)initWithDevice:(id<MTLDevice>)device;
 - (BOOL)loadSprite:(uint16_t)spriteId fromFile:(const char*)filename;
 - (void)showSprite:(uint16_t)spriteId atX:(float)x y:(float)y;
@@ -146,6 +251,8 @@ struct SpriteUniforms {
 
 // Clear and shutdown methods
 - (void)clearAndReinitialize;
+- (int)releaseSpritesUpToGeneration:(uint32_t)generation;
+- (int)reloadSpritesFromFile:(const char*)filename;
 - (void)shutdownSpriteLayer;
 
 @end
@@ -171,6 +278,8 @@ struct SpriteUniforms {
         self.freeIds = [[NSMutableSet alloc] init];
         self.nextId = 1; // Start from ID 1
 
+        self.textureCache = [[NSMutableDictionary alloc] init];
+
         [self createRenderPipeline];
         [self createVertexBuffer];
         [self createSampler];
@@ -209,6 +318,7 @@ struct SpriteUniforms {
     "    float4x4 modelMatrix;\n"
     "    float4x4 viewProjectionMatrix;\n"
     "    float4 color;\n"
+    "    float4 uvRect;\n"
     "};\n"
     "\n"
     "vertex VertexOut sprite_vertex(VertexIn in [[stage_in]],\n"
@@ -216,7 +326,7 @@ struct SpriteUniforms {
     "    VertexOut out;\n"
     "    float4 worldPos = uniforms.modelMatrix * float4(in.position, 0.0, 1.0);\n"
     "    out.position = uniforms.viewProjectionMatrix * worldPos;\n"
-    "    out.texCoord = in.texCoord;\n"
+    "    out.texCoord = uniforms.uvRect.xy + in.texCoord * uniforms.uvRect.zw;\n"
     "    out.color = uniforms.color;\n"
     "    return out;\n"
     "}\n"
@@ -468,9 +578,35 @@ struct SpriteUniforms {
         return NO;
     }
 
-    id<MTLTexture> texture = [self loadTextureFromPNG:filename];
-    if (!texture) {
-        return NO;
+    // Reuse the texture decoded by an earlier run if the file is unchanged
+    uint32_t generation = superterminal_get_script_generation();
+    NSString* path = nil;
+    struct stat info;
+    bool haveInfo = filename && stat(filename, &info) == 0;
+    if (filename) {
+        char resolved[PATH_MAX];
+        path = [NSString stringWithUTF8String:realpath(filename, resolved) ? resolved : filename];
+    }
+
+    SpriteTextureCacheEntry* cached = path ? self.textureCache[path] : nil;
+    id<MTLTexture> texture = nil;
+    if (cached && haveInfo && cached.fileSize == (int64_t)info.st_size &&
+        cached.fileModified == (int64_t)info.st_mtimespec.tv_sec * 1000000000LL + info.st_mtimespec.tv_nsec) {
+        texture = cached.texture;
+        cached.generation = generation;
+    } else {
+        texture = [self loadTextureFromPNG:filename];
+        if (!texture) {
+            return NO;
+        }
+        if (path && haveInfo) {
+            SpriteTextureCacheEntry* entry = [[SpriteTextureCacheEntry alloc] init];
+            entry.texture = texture;
+            entry.generation = generation;
+            entry.fileSize = (int64_t)info.st_size;
+            entry.fileModified = (int64_t)info.st_mtimespec.tv_sec * 1000000000LL + info.st_mtimespec.tv_nsec;
+            self.textureCache[path] = entry;
+        }
     }
 
     // Create or update sprite
@@ -492,6 +628,10 @@ struct SpriteUniforms {
     sprite.alpha = 1.0f;
     sprite.textureWidth = texture.width;
     sprite.textureHeight = texture.height;
+    sprite.generation = generation;
+    sprite.sourcePath = path;
+    sprite_pick_set_mask(spriteId, sprite_pick_mask_from_texture(texture));
+    sprite_pick_sync(sprite);
 
     NSLog(@"SpriteLayer: Sprite %d loaded successfully from %s (%dx%d)", spriteId, filename, (int)texture.width, (int)texture.height);
     return YES;
@@ -551,8 +691,11 @@ struct SpriteUniforms {
 
     // Calculate texture-based scale factors for 1:1 pixel mapping
     // The base quad is 128x128 (-64 to +64), so we need to scale by actual_size/128
-    float textureScaleX = (float)sprite.textureWidth / 128.0f;
-    float textureScaleY = (float)sprite.textureHeight / 128.0f;
+    // Animated sprites draw one atlas frame, not the whole texture
+    int displayWidth = sprite.frameWidth > 0 ? sprite.frameWidth : sprite.textureWidth;
+    int displayHeight = sprite.frameHeight > 0 ? sprite.frameHeight : sprite.textureHeight;
+    float textureScaleX = (float)displayWidth / 128.0f;
+    float textureScaleY = (float)displayHeight / 128.0f;
 
     // Combine user scale with texture-based scale for correct pixel mapping
     float finalScaleX = sprite.scale * textureScaleX;
@@ -602,6 +745,8 @@ struct SpriteUniforms {
 
         // Add ID back to free pool
         [self.freeIds addObject:key];
+        sprite_animation_forget(spriteId);
+        sprite_pick_forget(spriteId);
 
         NSLog(@"SpriteLayer: Released sprite ID %d (added to free pool)", spriteId);
     } else {
@@ -698,6 +843,7 @@ struct SpriteUniforms {
         uniforms->modelMatrix = [self createTransformMatrix:sprite viewportSize:viewport];
         uniforms->viewProjectionMatrix = viewProjectionMatrix;
         uniforms->color = simd_make_float4(1.0f, 1.0f, 1.0f, sprite.alpha);
+        uniforms->uvRect = sprite.uvRect;
 
         // Upload uniforms buffer with unique offset for this sprite
         [encoder setVertexBuffer:self.uniformsBuffer offset:bufferOffset atIndex:1];
@@ -751,6 +897,10 @@ struct SpriteUniforms {
     sprite.visible = NO; // Start hidden by default
     sprite.textureWidth = width;
     sprite.textureHeight = height;
+    sprite.generation = superterminal_get_script_generation();
+    sprite.sourcePath = nil;
+    sprite_pick_set_mask(spriteId, SpriteAlphaMask::fromRGBA(pixels, width, height));
+    sprite_pick_sync(sprite);
 
     NSLog(@"SpriteLayer: Loaded sprite %d from pixel data (%dx%d)", spriteId, width, height);
     return YES;
@@ -818,6 +968,7 @@ struct SpriteUniforms {
                     sprite.visible = YES;
                     if (![self.renderOrder containsObject:key]) {
                         [self.renderOrder addObject:key];
+                        sprite.pickOrder = ++g_spritePickNextOrder;
                     }
                 }
                 break;
@@ -839,6 +990,9 @@ struct SpriteUniforms {
                 sprite.alpha = command.value;
                 break;
         }
+        if (command.type != SPRITE_CMD_ALPHA) {
+            sprite_pick_sync(sprite);
+        }
     }
 }
 
@@ -849,6 +1003,7 @@ struct SpriteUniforms {
     // Clear all sprites and their textures
     [self.sprites removeAllObjects];
     [self.renderOrder removeAllObjects];
+    [self.textureCache removeAllObjects];
     NSLog(@"SpriteLayer: All sprites cleared");
 
     // Reset sprite ID management
@@ -866,9 +1021,108 @@ struct SpriteUniforms {
     sprite_clear_all_effects();
     NSLog(@"SpriteLayer: All sprite effects cleared");
 
+    // Clips and atlases belong to the script that defined them
+    {
+        std::lock_guard<std::mutex> lock(g_spriteAnimatorMutex);
+        g_spriteAnimator.clear();
+        g_spriteAnimationEvents.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lock(g_spritePickMutex);
+        g_spritePickIndex.clear();
+        g_spritePickNextOrder = 0;
+    }
+
     NSLog(@"SpriteLayer: Ready for new sprite data");
 }
 
+// Soft reset: release sprites created by runs up to and including the given
+// generation, keeping pipelines, buffers and textures the last run still used
+- (int)releaseSpritesUpToGeneration:(uint32_t)generation {
+    NSMutableArray<NSNumber*>* stale = [NSMutableArray array];
+    for (NSNumber* key in self.sprites) {
+        if (self.sprites[key].generation <= generation) {
+            [stale addObject:key];
+        }
+    }
+
+    [self.sprites removeObjectsForKeys:stale];
+    [self.renderOrder removeObjectsInArray:stale];
+    {
+        std::lock_guard<std::mutex> lock(g_spriteAnimatorMutex);
+        for (NSNumber* key in stale) {
+            g_spriteAnimator.stop([key unsignedShortValue]);
+        }
+        g_spriteAnimationEvents.clear();
+    }
+    for (NSNumber* key in stale) {
+        sprite_pick_forget([key unsignedShortValue]);
+    }
+    if (self.sprites.count == 0) {
+        [self.freeIds removeAllObjects];
+        self.nextId = 1;
+    } else {
+        [self.freeIds addObjectsFromArray:stale];
+    }
+
+    // Drop cached textures the finished run did not touch
+    NSMutableArray<NSString*>* unused = [NSMutableArray array];
+    for (NSString* path in self.textureCache) {
+        if (self.textureCache[path].generation < generation) {
+            [unused addObject:path];
+        }
+    }
+    [self.textureCache removeObjectsForKeys:unused];
+
+    [self.queueLock lock];
+    [self.commandQueue removeAllObjects];
+    [self.queueLock unlock];
+
+    sprite_clear_all_effects();
+
+    NSLog(@"SpriteLayer: Soft reset released %d sprites, %d cached textures retained",
+          (int)stale.count, (int)self.textureCache.count);
+    return (int)stale.count;
+}
+
+// Hot reload: re-decode a changed file into every sprite loaded from it,
+// keeping position, scale, rotation, alpha and visibility
+- (int)reloadSpritesFromFile:(const char*)filename {
+    char resolved[PATH_MAX];
+    if (!filename || !realpath(filename, resolved)) {
+        return 0;
+    }
+    NSString* path = [NSString stringWithUTF8String:resolved];
+
+    NSMutableArray<SuperTerminalSprite*>* targets = [NSMutableArray array];
+    for (SuperTerminalSprite* sprite in self.sprites.allValues) {
+        if ([sprite.sourcePath isEqualToString:path]) {
+            [targets addObject:sprite];
+        }
+    }
+    if (targets.count == 0) {
+        return 0;
+    }
+
+    [self.textureCache removeObjectForKey:path];
+    id<MTLTexture> texture = [self loadTextureFromPNG:resolved];
+    if (!texture) {
+        NSLog(@"SpriteLayer: Hot reload of %s failed, keeping previous texture", resolved);
+        return -1;
+    }
+
+    std::shared_ptr<const SpriteAlphaMask> mask = sprite_pick_mask_from_texture(texture);
+    for (SuperTerminalSprite* sprite in targets) {
+        sprite.texture = texture;
+        sprite.textureWidth = texture.width;
+        sprite.textureHeight = texture.height;
+        sprite_pick_set_mask(sprite.spriteId, mask);
+        sprite_pick_sync(sprite);
+    }
+    NSLog(@"SpriteLayer: Hot reloaded %d sprites from %s", (int)targets.count, resolved);
+    return (int)targets.count;
+}
+
 - (void)shutdownSpriteLayer {
     NSLog(@"SpriteLayer: Shutting down sprite layer completely...");
 
@@ -1083,6 +1337,39 @@ void sprite_layer_init(void* device) {
         NSLog(@"SpriteLayer: WARNING - Could not load any Metal library for effects");
     }
 
+    // Atlas animations advance on the fixed simulation step, all sprites in
+    // one pass; only sprites whose frame changed are touched
+    if (!g_spriteAnimationStepHandle) {
+        g_spriteAnimationStepHandle = simulation_scheduler().registerStep("sprite_animation", SIM_STEP_ORDER_SPRITE_ANIMATION,
+            [](float dt, uint64_t) {
+                std::lock_guard<std::mutex> lock(g_spriteAnimatorMutex);
+                if (g_spriteAnimator.getInstanceCount() == 0) {
+                    return;
+                }
+                g_spriteAnimator.update(dt);
+
+                for (const AnimationFrameChange& change : g_spriteAnimator.getFrameChanges()) {
+                    SuperTerminalSprite* sprite = g_spriteLayer ? g_spriteLayer.sprites[@(change.spriteId)] : nil;
+                    const SpriteAtlas* atlas = g_spriteAnimator.getAtlas(change.atlasId);
+                    if (!sprite || !atlas || change.atlasFrame >= atlas->getFrameCount()) {
+                        continue;
+                    }
+                    const AtlasFrame& frame = atlas->getFrame(change.atlasFrame);
+                    sprite.uvRect = simd_make_float4(frame.u0, frame.v0, frame.u1 - frame.u0, frame.v1 - frame.v0);
+                    sprite.frameWidth = frame.width;
+                    sprite.frameHeight = frame.height;
+                    sprite_pick_sync(sprite);
+                }
+
+                for (const AnimationEvent& event : g_spriteAnimator.getEvents()) {
+                    if (g_spriteAnimationEvents.size() >= MAX_PENDING_ANIMATION_EVENTS) {
+                        g_spriteAnimationEvents.pop_front();
+                    }
+                    g_spriteAnimationEvents.push_back(event);
+                }
+            });
+    }
+
     NSLog(@"SpriteLayer: C interface ready");
 }
 
@@ -1091,6 +1378,10 @@ void sprite_layer_init(void* device) {
 void sprite_layer_cleanup() {
     NSLog(@"SpriteLayer: Cleaning up C interface...");
     sprite_effect_shutdown();
+    if (g_spriteAnimationStepHandle) {
+        simulation_scheduler().unregisterStep(g_spriteAnimationStepHandle);
+        g_spriteAnimationStepHandle = 0;
+    }
     g_spriteLayer = nil;
 
     // Unregister from shutdown system
@@ -1217,6 +1508,160 @@ void sprites_clear() {
     }
 }
 
+// Atlas animation
+
+bool sprite_atlas_create(uint32_t atlas_id, int texture_width, int texture_height) {
+    if (texture_width <= 0 || texture_height <= 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(g_spriteAnimatorMutex);
+    g_spriteAnimator.defineAtlas(atlas_id, SpriteAtlas(texture_width, texture_height));
+    return true;
+}
+
+int sprite_atlas_add_frame(uint32_t atlas_id, int x, int y, int width, int height) {
+    std::lock_guard<std::mutex> lock(g_spriteAnimatorMutex);
+    const SpriteAtlas* existing = g_spriteAnimator.getAtlas(atlas_id);
+    if (!existing) {
+        return -1;
+    }
+    SpriteAtlas atlas = *existing;
+    int frame = atlas.addFrame(x, y, width, height);
+    if (frame >= 0) {
+        g_spriteAnimator.defineAtlas(atlas_id, atlas);
+    }
+    return frame;
+}
+
+int sprite_atlas_define_grid(uint32_t atlas_id, int texture_width, int texture_height,
+                             int frame_width, int frame_height, int margin, int spacing) {
+    SpriteAtlas atlas(texture_width, texture_height);
+    int count = atlas.addGrid(frame_width, frame_height, margin, spacing);
+    if (count > 0) {
+        std::lock_guard<std::mutex> lock(g_spriteAnimatorMutex);
+        g_spriteAnimator.defineAtlas(atlas_id, atlas);
+    }
+    return count;
+}
+
+bool sprite_clip_define(uint32_t clip_id, uint32_t atlas_id, int first_frame, int last_frame,
+                        float frame_duration, int mode) {
+    if (first_frame < 0 || last_frame < 0 || mode < 0 || mode > (int)AnimationPlayMode::PingPong) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(g_spriteAnimatorMutex);
+    return g_spriteAnimator.defineClip(clip_id, atlas_id, first_frame, last_frame,
+                                       frame_duration, (AnimationPlayMode)mode);
+}
+
+bool sprite_clip_set_frame_duration(uint32_t clip_id, int clip_frame, float seconds) {
+    if (clip_frame < 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(g_spriteAnimatorMutex);
+    return g_spriteAnimator.setFrameDuration(clip_id, clip_frame, seconds);
+}
+
+bool sprite_clip_add_event(uint32_t clip_id, int clip_frame, int event_id) {
+    if (clip_frame < 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(g_spriteAnimatorMutex);
+    return g_spriteAnimator.addClipEvent(clip_id, clip_frame, event_id);
+}
+
+bool sprite_animation_play(uint16_t id, uint32_t clip_id, float speed, bool restart) {
+    std::lock_guard<std::mutex> lock(g_spriteAnimatorMutex);
+    return g_spriteAnimator.play(id, clip_id, speed, restart);
+}
+
+bool sprite_animation_stop(uint16_t id) {
+    std::lock_guard<std::mutex> lock(g_spriteAnimatorMutex);
+    return g_spriteAnimator.stop(id);
+}
+
+bool sprite_animation_pause(uint16_t id, bool paused) {
+    std::lock_guard<std::mutex> lock(g_spriteAnimatorMutex);
+    return g_spriteAnimator.setPaused(id, paused);
+}
+
+bool sprite_animation_set_speed(uint16_t id, float speed) {
+    std::lock_guard<std::mutex> lock(g_spriteAnimatorMutex);
+    return g_spriteAnimator.setSpeed(id, speed);
+}
+
+int sprite_animation_get_frame(uint16_t id) {
+    std::lock_guard<std::mutex> lock(g_spriteAnimatorMutex);
+    return g_spriteAnimator.getClipFrame(id);
+}
+
+bool sprite_animation_is_playing(uint16_t id) {
+    std::lock_guard<std::mutex> lock(g_spriteAnimatorMutex);
+    return g_spriteAnimator.isPlaying(id);
+}
+
+bool sprite_animation_poll_event(uint16_t* sprite_id, uint32_t* clip_id, int* type, int* event_id) {
+    std::lock_guard<std::mutex> lock(g_spriteAnimatorMutex);
+    if (g_spriteAnimationEvents.empty()) {
+        return false;
+    }
+    const AnimationEvent& event = g_spriteAnimationEvents.front();
+    if (sprite_id) *sprite_id = event.spriteId;
+    if (clip_id) *clip_id = event.clipId;
+    if (type) *type = (int)event.type;
+    if (event_id) *event_id = event.eventId;
+    g_spriteAnimationEvents.pop_front();
+    return true;
+}
+
+// Picking
+
+uint16_t sprite_pick(float x, float y, bool pixel_accurate) {
+    std::lock_guard<std::mutex> lock(g_spritePickMutex);
+    return (uint16_t)g_spritePickIndex.topmostAt(x, y, pixel_accurate);
+}
+
+static int sprite_pick_copy(const std::vector<uint32_t>& hits, uint16_t* ids, int max_ids) {
+    int count = (int)std::min(hits.size(), (size_t)std::max(max_ids, 0));
+    for (int i = 0; ids && i < count; i++) {
+        ids[i] = (uint16_t)hits[i];
+    }
+    return (int)hits.size();
+}
+
+int sprite_pick_all(float x, float y, bool pixel_accurate, uint16_t* ids, int max_ids) {
+    std::vector<uint32_t> hits;
+    std::lock_guard<std::mutex> lock(g_spritePickMutex);
+    g_spritePickIndex.queryPoint(x, y, hits, pixel_accurate);
+    return sprite_pick_copy(hits, ids, max_ids);
+}
+
+int sprite_pick_rect(float x, float y, float width, float height, uint16_t* ids, int max_ids) {
+    std::vector<uint32_t> hits;
+    std::lock_guard<std::mutex> lock(g_spritePickMutex);
+    g_spritePickIndex.queryRect(x, y, width, height, hits);
+    return sprite_pick_copy(hits, ids, max_ids);
+}
+
+bool sprite_hit_test(uint16_t id, float x, float y, bool pixel_accurate) {
+    std::lock_guard<std::mutex> lock(g_spritePickMutex);
+    return g_spritePickIndex.hitTest(id, x, y, pixel_accurate);
+}
+
+int sprite_layer_reload_file(const char* filename) {
+    if (!g_spriteLayer) {
+        return 0;
+    }
+    return [g_spriteLayer reloadSpritesFromFile:filename];
+}
+
+int sprite_layer_release_generation(uint32_t generation) {
+    if (!g_spriteLayer) {
+        return 0;
+    }
+    return [g_spriteLayer releaseSpritesUpToGeneration:generation];
+}
+
 void sprites_shutdown() {
     NSLog(@"SpriteLayer: sprites_shutdown() - Complete sprite system shutdown");
 
@@ -0,0 +1,305 @@
+//
+//  SpritePickIndex.cpp
+//  SuperTerminal Framework - Sprite Picking
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "SpritePickIndex.h"
+#include <algorithm>
+#include <cmath>
+
+// =============================================================================
+// SpriteAlphaMask
+// =============================================================================
+
+std::shared_ptr<const SpriteAlphaMask> SpriteAlphaMask::fromRGBA(const uint8_t* pixels, int width, int height,
+                                                                 size_t stride, uint8_t threshold) {
+    if (!pixels || width <= 0 || height <= 0) {
+        return nullptr;
+    }
+    if (stride == 0) {
+        stride = static_cast<size_t>(width) * 4;
+    }
+
+    auto mask = std::make_shared<SpriteAlphaMask>();
+    mask->m_width = width;
+    mask->m_height = height;
+    mask->m_wordsPerRow = (static_cast<size_t>(width) + 63) / 64;
+    mask->m_bits.assign(mask->m_wordsPerRow * height, 0);
+
+    for (int y = 0; y < height; y++) {
+        const uint8_t* row = pixels + stride * y;
+        uint64_t* bits = &mask->m_bits[mask->m_wordsPerRow * y];
+        for (int x = 0; x < width; x++) {
+            if (row[x * 4 + 3] >= threshold) {
+                bits[x >> 6] |= uint64_t(1) << (x & 63);
+            }
+        }
+    }
+    return mask;
+}
+
+bool SpriteAlphaMask::isOpaque(int x, int y) const {
+    if (x < 0 || y < 0 || x >= m_width || y >= m_height) {
+        return false;
+    }
+    return (m_bits[m_wordsPerRow * y + (x >> 6)] >> (x & 63)) & 1;
+}
+
+// =============================================================================
+// SpritePickIndex
+// =============================================================================
+
+SpritePickIndex::SpritePickIndex(float worldWidth, float worldHeight, float cellSize)
+    : m_cellSize(cellSize > 1.0f ? cellSize : 1.0f) {
+    m_invCellSize = 1.0f / m_cellSize;
+    m_columns = std::max(1, static_cast<int>(std::ceil(worldWidth * m_invCellSize)));
+    m_rows = std::max(1, static_cast<int>(std::ceil(worldHeight * m_invCellSize)));
+    m_cells.resize(static_cast<size_t>(m_columns) * m_rows);
+}
+
+// Off-screen bounds clamp into the border cells, so the grid stays bounded
+// and exact tests reject the far-away candidates
+int SpritePickIndex::cellColumn(float x) const {
+    int column = static_cast<int>(std::floor(x * m_invCellSize));
+    return std::min(std::max(column, 0), m_columns - 1);
+}
+
+int SpritePickIndex::cellRow(float y) const {
+    int row = static_cast<int>(std::floor(y * m_invCellSize));
+    return std::min(std::max(row, 0), m_rows - 1);
+}
+
+void SpritePickIndex::link(uint32_t id, const Entry& entry) {
+    for (int cy = entry.cy0; cy <= entry.cy1; cy++) {
+        for (int cx = entry.cx0; cx <= entry.cx1; cx++) {
+            m_cells[static_cast<size_t>(cy) * m_columns + cx].push_back(id);
+        }
+    }
+}
+
+void SpritePickIndex::unlink(uint32_t id, const Entry& entry) {
+    for (int cy = entry.cy0; cy <= entry.cy1; cy++) {
+        for (int cx = entry.cx0; cx <= entry.cx1; cx++) {
+            std::vector<uint32_t>& cell = m_cells[static_cast<size_t>(cy) * m_columns + cx];
+            auto it = std::find(cell.begin(), cell.end(), id);
+            if (it != cell.end()) {
+                *it = cell.back();
+                cell.pop_back();
+            }
+        }
+    }
+}
+
+void SpritePickIndex::update(uint32_t id, const SpritePickShape& shape, uint32_t z) {
+    float c = std::fabs(std::cos(shape.rotation));
+    float s = std::fabs(std::sin(shape.rotation));
+    float extentX = c * shape.halfWidth + s * shape.halfHeight;
+    float extentY = s * shape.halfWidth + c * shape.halfHeight;
+
+    Entry next;
+    next.shape = shape;
+    next.z = z;
+    next.minX = shape.x - extentX;
+    next.maxX = shape.x + extentX;
+    next.minY = shape.y - extentY;
+    next.maxY = shape.y + extentY;
+    next.cx0 = cellColumn(next.minX);
+    next.cx1 = cellColumn(next.maxX);
+    next.cy0 = cellRow(next.minY);
+    next.cy1 = cellRow(next.maxY);
+
+    auto it = m_entries.find(id);
+    if (it == m_entries.end()) {
+        link(id, next);
+        m_entries.emplace(id, next);
+        return;
+    }
+
+    Entry& current = it->second;
+    if (current.cx0 != next.cx0 || current.cx1 != next.cx1 ||
+        current.cy0 != next.cy0 || current.cy1 != next.cy1) {
+        unlink(id, current);
+        link(id, next);
+    }
+    current = next;
+}
+
+void SpritePickIndex::remove(uint32_t id) {
+    auto it = m_entries.find(id);
+    if (it == m_entries.end()) {
+        return;
+    }
+    unlink(id, it->second);
+    m_entries.erase(it);
+}
+
+void SpritePickIndex::clear() {
+    for (std::vector<uint32_t>& cell : m_cells) {
+        cell.clear();
+    }
+    m_entries.clear();
+    m_masks.clear();
+}
+
+void SpritePickIndex::setMask(uint32_t id, std::shared_ptr<const SpriteAlphaMask> mask) {
+    if (mask) {
+        m_masks[id] = std::move(mask);
+    } else {
+        m_masks.erase(id);
+    }
+}
+
+bool SpritePickIndex::hitEntry(uint32_t id, const Entry& entry, float x, float y, bool pixelAccurate) const {
+    if (x < entry.minX || x > entry.maxX || y < entry.minY || y > entry.maxY) {
+        return false;
+    }
+
+    // Into the quad's frame: the renderer maps local to world by rotating
+    // through +rotation, so undo it
+    const SpritePickShape& shape = entry.shape;
+    float c = std::cos(shape.rotation);
+    float s = std::sin(shape.rotation);
+    float dx = x - shape.x;
+    float dy = y - shape.y;
+    float localX = c * dx + s * dy;
+    float localY = -s * dx + c * dy;
+    if (std::fabs(localX) > shape.halfWidth || std::fabs(localY) > shape.halfHeight) {
+        return false;
+    }
+
+    if (!pixelAccurate || shape.halfWidth <= 0.0f || shape.halfHeight <= 0.0f) {
+        return true;
+    }
+    auto mask = m_masks.find(id);
+    if (mask == m_masks.end()) {
+        return true;
+    }
+
+    // Same texture coordinates as the sprite quad: u left to right, v = 0
+    // along the +y edge
+    float u = 0.5f + 0.5f * localX / shape.halfWidth;
+    float v = 0.5f - 0.5f * localY / shape.halfHeight;
+    float texU = shape.u0 + u * shape.uSize;
+    float texV = shape.v0 + v * shape.vSize;
+
+    const SpriteAlphaMask& alpha = *mask->second;
+    int px = std::min(std::max(static_cast<int>(texU * alpha.getWidth()), 0), alpha.getWidth() - 1);
+    int py = std::min(std::max(static_cast<int>(texV * alpha.getHeight()), 0), alpha.getHeight() - 1);
+    return alpha.isOpaque(px, py);
+}
+
+bool SpritePickIndex::hitTest(uint32_t id, float x, float y, bool pixelAccurate) const {
+    auto it = m_entries.find(id);
+    return it != m_entries.end() && hitEntry(id, it->second, x, y, pixelAccurate);
+}
+
+size_t SpritePickIndex::collect(std::vector<uint32_t>& out) const {
+    std::sort(m_hits.begin(), m_hits.end(),
+              [](const std::pair<uint32_t, uint32_t>& a, const std::pair<uint32_t, uint32_t>& b) {
+                  return a.first != b.first ? a.first > b.first : a.second > b.second;
+              });
+    for (const auto& hit : m_hits) {
+        out.push_back(hit.second);
+    }
+    return m_hits.size();
+}
+
+size_t SpritePickIndex::queryPoint(float x, float y, std::vector<uint32_t>& out, bool pixelAccurate) const {
+    m_hits.clear();
+    if (m_entries.empty()) {
+        return 0;
+    }
+
+    const std::vector<uint32_t>& cell = m_cells[static_cast<size_t>(cellRow(y)) * m_columns + cellColumn(x)];
+    for (uint32_t id : cell) {
+        const Entry& entry = m_entries.find(id)->second;
+        if (hitEntry(id, entry, x, y, pixelAccurate)) {
+            m_hits.emplace_back(entry.z, id);
+        }
+    }
+    return collect(out);
+}
+
+uint32_t SpritePickIndex::topmostAt(float x, float y, bool pixelAccurate) const {
+    if (m_entries.empty()) {
+        return 0;
+    }
+
+    uint32_t best = 0;
+    uint32_t bestZ = 0;
+    bool found = false;
+    const std::vector<uint32_t>& cell = m_cells[static_cast<size_t>(cellRow(y)) * m_columns + cellColumn(x)];
+    for (uint32_t id : cell) {
+        const Entry& entry = m_entries.find(id)->second;
+        if (found && (entry.z < bestZ || (entry.z == bestZ && id < best))) {
+            continue;       // Cannot beat the current hit; skip the exact test
+        }
+        if (hitEntry(id, entry, x, y, pixelAccurate)) {
+            best = id;
+            bestZ = entry.z;
+            found = true;
+        }
+    }
+    return best;
+}
+
+size_t SpritePickIndex::queryRect(float x, float y, float width, float height, std::vector<uint32_t>& out) const {
+    m_hits.clear();
+    if (m_entries.empty()) {
+        return 0;
+    }
+    if (width < 0.0f) {
+        x += width;
+        width = -width;
+    }
+    if (height < 0.0f) {
+        y += height;
+        height = -height;
+    }
+    float maxX = x + width;
+    float maxY = y + height;
+    float rectCenterX = x + width * 0.5f;
+    float rectCenterY = y + height * 0.5f;
+
+    int cx0 = cellColumn(x), cx1 = cellColumn(maxX);
+    int cy0 = cellRow(y), cy1 = cellRow(maxY);
+
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            for (uint32_t id : m_cells[static_cast<size_t>(cy) * m_columns + cx]) {
+                const Entry& entry = m_entries.find(id)->second;
+                if (entry.maxX < x || entry.minX > maxX || entry.maxY < y || entry.minY > maxY) {
+                    continue;
+                }
+                // A sprite spanning several cells is reported from the first
+                // of them inside the query range only
+                if (std::max(entry.cx0, cx0) != cx || std::max(entry.cy0, cy0) != cy) {
+                    continue;
+                }
+
+                // Bounds overlap; for a rotated quad also check the rectangle
+                // against the quad's own axes
+                const SpritePickShape& shape = entry.shape;
+                if (shape.rotation != 0.0f) {
+                    float c = std::cos(shape.rotation);
+                    float s = std::sin(shape.rotation);
+                    float dx = rectCenterX - shape.x;
+                    float dy = rectCenterY - shape.y;
+                    float halfW = width * 0.5f;
+                    float halfH = height * 0.5f;
+                    bool separated =
+                        std::fabs(c * dx + s * dy) > shape.halfWidth + std::fabs(c) * halfW + std::fabs(s) * halfH ||
+                        std::fabs(-s * dx + c * dy) > shape.halfHeight + std::fabs(s) * halfW + std::fabs(c) * halfH;
+                    if (separated) {
+                        continue;
+                    }
+                }
+                m_hits.emplace_back(entry.z, id);
+            }
+        }
+    }
+    return collect(out);
+}
@@ -0,0 +1,116 @@
+//
+//  SpritePickIndex.h
+//  SuperTerminal Framework - Sprite Picking
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+//  Uniform grid over the bounds of visible sprites for mouse picking and
+//  hit-testing. Each sprite is bucketed into the cells its axis-aligned
+//  bounds cover; update() only touches the grid when that cell range changes,
+//  so moving sprites costs a compare per frame. Queries test candidates from
+//  the covered cells against the rotated quad the renderer draws, and can
+//  optionally refine against a per-texture alpha mask.
+//
+//  Not thread-safe; the sprite layer serialises access.
+//
+
+#ifndef SpritePickIndex_h
+#define SpritePickIndex_h
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// One bit per texel: set where alpha passes the threshold
+class SpriteAlphaMask {
+public:
+    static constexpr uint8_t DEFAULT_ALPHA_THRESHOLD = 16;
+
+    // Tightly packed RGBA8 rows unless stride is given
+    static std::shared_ptr<const SpriteAlphaMask> fromRGBA(const uint8_t* pixels, int width, int height,
+                                                           size_t stride = 0,
+                                                           uint8_t threshold = DEFAULT_ALPHA_THRESHOLD);
+
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+    bool isOpaque(int x, int y) const;
+
+private:
+    int m_width = 0;
+    int m_height = 0;
+    std::vector<uint64_t> m_bits;   // Row-major, each row padded to whole words
+    size_t m_wordsPerRow = 0;
+};
+
+// Placement of a sprite quad as drawn: centre, half size after scale,
+// rotation in radians and the texture region (origin, size) it shows
+struct SpritePickShape {
+    float x = 0.0f, y = 0.0f;
+    float halfWidth = 0.0f, halfHeight = 0.0f;
+    float rotation = 0.0f;
+    float u0 = 0.0f, v0 = 0.0f, uSize = 1.0f, vSize = 1.0f;
+};
+
+class SpritePickIndex {
+public:
+    static constexpr float DEFAULT_WORLD_WIDTH = 1024.0f;
+    static constexpr float DEFAULT_WORLD_HEIGHT = 768.0f;
+    static constexpr float DEFAULT_CELL_SIZE = 64.0f;
+
+    SpritePickIndex(float worldWidth = DEFAULT_WORLD_WIDTH, float worldHeight = DEFAULT_WORLD_HEIGHT,
+                    float cellSize = DEFAULT_CELL_SIZE);
+
+    // Insert or move a sprite. Higher z is drawn later, so it is on top.
+    void update(uint32_t id, const SpritePickShape& shape, uint32_t z);
+    void remove(uint32_t id);
+    void clear();
+
+    // Alpha mask for pixel-accurate queries; kept while the sprite is hidden
+    void setMask(uint32_t id, std::shared_ptr<const SpriteAlphaMask> mask);
+
+    bool contains(uint32_t id) const { return m_entries.count(id) != 0; }
+    bool hitTest(uint32_t id, float x, float y, bool pixelAccurate) const;
+
+    // Sprites under a point, topmost first; returns the number found
+    size_t queryPoint(float x, float y, std::vector<uint32_t>& out, bool pixelAccurate) const;
+
+    // Topmost sprite under a point, or 0
+    uint32_t topmostAt(float x, float y, bool pixelAccurate) const;
+
+    // Sprites whose quad overlaps the rectangle, topmost first
+    size_t queryRect(float x, float y, float width, float height, std::vector<uint32_t>& out) const;
+
+    size_t getCount() const { return m_entries.size(); }
+    int getColumns() const { return m_columns; }
+    int getRows() const { return m_rows; }
+
+private:
+    struct Entry {
+        SpritePickShape shape;
+        uint32_t z;
+        float minX, minY, maxX, maxY;
+        int cx0, cy0, cx1, cy1;     // Covered cell range, inclusive
+    };
+
+    float m_cellSize;
+    float m_invCellSize;
+    int m_columns;
+    int m_rows;
+    std::vector<std::vector<uint32_t>> m_cells;
+    std::unordered_map<uint32_t, Entry> m_entries;
+    std::unordered_map<uint32_t, std::shared_ptr<const SpriteAlphaMask>> m_masks;
+    mutable std::vector<std::pair<uint32_t, uint32_t>> m_hits;  // (z, id) of the last query
+
+    int cellColumn(float x) const;
+    int cellRow(float y) const;
+    void link(uint32_t id, const Entry& entry);
+    void unlink(uint32_t id, const Entry& entry);
+    bool hitEntry(uint32_t id, const Entry& entry, float x, float y, bool pixelAccurate) const;
+    size_t collect(std::vector<uint32_t>& out) const;
+};
+
+#endif /* SpritePickIndex_h */
@@ -17,6 +17,8 @@
 #include <atomic>
 #include "CommandQueue.h"
 #include "ConsoleLogger.h"
+#include "MouseEventQueue.h"
+#include "TraceEvents.h"
 
 extern "C" {
     void _exit(int status);
@@ -55,10 +57,16 @@ extern "C" {
     // Mouse input functions
     bool input_system_is_mouse_pressed(int button);
     void input_system_get_mouse_position(float* x, float* y);
+    void input_system_get_view_size(float* width, float* height);
 
-
+    // Script cancellation (LuaRuntimeGCD.mm)
+    bool lua_gcd_is_script_running(void);
+    bool lua_gcd_is_on_lua_queue(void);
 }
 
+// Mouse event stream (SuperTerminalWindow.mm)
+MouseEventQueue& input_system_mouse_event_queue();
+
 // External functions from MetalRenderer.mm
 extern "C" {
     void metal_renderer_wait_frame();
@@ -97,6 +105,14 @@ extern "C" {
     void tile_get_map_size_impl(int layer, int* width, int* height);
     void tile_center_viewport_impl(int layer, int tile_x, int tile_y);
     bool tile_is_valid_position_impl(int layer, int x, int y);
+
+    // Animated tiles
+    bool tile_animation_define_impl(uint16_t base_tile, const uint16_t* frames, int frame_count, float frame_duration);
+    bool tile_animation_set_frame_duration_impl(uint16_t base_tile, int frame_index, float seconds);
+    bool tile_animation_remove_impl(uint16_t base_tile);
+    void tile_animation_clear_impl(void);
+    void tile_animation_set_paused_impl(bool paused);
+    uint16_t tile_animation_get_frame_impl(uint16_t tile_id);
 }
 
 // Note: TrueType functions now provided by CoreTextRenderer.h via compatibility macros
@@ -213,6 +229,27 @@ extern "C" {
     bool overlay_graphics_layer_is_visible(void);
     void overlay_graphics_layer_present(void);
     void overlay_graphics_layer_render_overlay(void* encoder, void* projectionMatrix);
+    uint32_t overlay_graphics_layer_widget_panel(uint32_t parent, float x, float y, float w, float h);
+    uint32_t overlay_graphics_layer_widget_label(uint32_t parent, float x, float y, float w, float h,
+                                                 const char* text, float fontSize);
+    uint32_t overlay_graphics_layer_widget_bar(uint32_t parent, float x, float y, float w, float h, float value);
+    uint32_t overlay_graphics_layer_widget_image(uint32_t parent, float x, float y, float w, float h,
+                                                 uint16_t imageId);
+    bool overlay_graphics_layer_widget_remove(uint32_t id);
+    void overlay_graphics_layer_widget_clear(void);
+    bool overlay_graphics_layer_widget_set_position(uint32_t id, float x, float y);
+    bool overlay_graphics_layer_widget_set_size(uint32_t id, float w, float h);
+    bool overlay_graphics_layer_widget_set_visible(uint32_t id, bool visible);
+    bool overlay_graphics_layer_widget_set_z(uint32_t id, int z);
+    bool overlay_graphics_layer_widget_set_color(uint32_t id, float r, float g, float b, float a);
+    bool overlay_graphics_layer_widget_set_back_color(uint32_t id, float r, float g, float b, float a);
+    bool overlay_graphics_layer_widget_set_border(uint32_t id, float width);
+    bool overlay_graphics_layer_widget_set_text(uint32_t id, const char* text);
+    bool overlay_graphics_layer_widget_set_font_size(uint32_t id, float fontSize);
+    bool overlay_graphics_layer_widget_set_value(uint32_t id, float value);
+    bool overlay_graphics_layer_widget_set_vertical(uint32_t id, bool vertical);
+    bool overlay_graphics_layer_widget_set_image(uint32_t id, uint16_t imageId);
+    bool overlay_graphics_layer_widget_invalidate(uint32_t id);
     
     // Tile creation functions
     bool tile_create_from_pixels_impl(uint16_t id, const uint8_t* pixels, int width, int height);
@@ -346,44 +383,101 @@ bool mouse_is_pressed(int button) {
     return input_system_is_mouse_pressed(button);
 }
 
-bool mouse_wait_click(int* button, float* x, float* y) {
-    // Forward declare interrupt check for graceful shutdown
-    // Note: g_lua_should_interrupt is static in LuaRuntime.cpp but we forward-declare
-    // it here to allow cross-compilation-unit interrupt checking
+// True once the running script should stop waiting for input
+static bool mouse_wait_cancelled() {
+    // g_lua_should_interrupt is defined in LuaRuntime.cpp
     extern std::atomic<bool> g_lua_should_interrupt;
-    
-    // Simple polling implementation - could be improved with semaphores later
-    while (true) {
-        // Check for shutdown/interrupt request
-        if (is_emergency_shutdown_requested() || g_lua_should_interrupt.load()) {
-            return false; // Return false to indicate interruption
+    return is_emergency_shutdown_requested() || g_lua_should_interrupt.load() ||
+           (lua_gcd_is_on_lua_queue() && !lua_gcd_is_script_running());
+}
+
+static void mouse_event_to_info(const MouseEventQueue& queue, const MouseEvent& event, MouseEventInfo* info) {
+    info->type = (int)event.type;
+    info->button = event.button;
+    info->x = event.x;
+    info->y = event.y;
+    info->delta_x = event.deltaX;
+    info->delta_y = event.deltaY;
+    info->time = queue.secondsSinceStart(event);
+}
+
+bool mouse_wait_click(int* button, float* x, float* y) {
+    MouseEventQueue& events = input_system_mouse_event_queue();
+    uint64_t since = events.getLastSequence();
+
+    // A button already held when called counts as the press
+    MouseEvent press;
+    for (int b = 0; b < 3 && press.button < 0; b++) {
+        if (mouse_is_pressed(b)) {
+            press.button = b;
+            mouse_get_position(&press.x, &press.y);
         }
-        
-        for (int b = 0; b < 3; b++) {
-            if (mouse_is_pressed(b)) {
-                if (button) *button = b;
-                mouse_get_position(x, y);
-                
-                // Wait for button release to avoid multiple clicks
-                while (mouse_is_pressed(b)) {
-                    // Check for interruption even while waiting for release
-                    if (is_emergency_shutdown_requested() || g_lua_should_interrupt.load()) {
-                        return false;
-                    }
-                    usleep(10000); // 10ms sleep
-                }
-                return true;
-            }
+    }
+    if (press.button < 0) {
+        if (events.waitFor(since, MouseEventQueue::maskOf(MouseEventType::Press), -1, press, -1,
+                           mouse_wait_cancelled) != MouseWaitResult::Event) {
+            return false;
         }
-        usleep(10000); // 10ms sleep to avoid busy waiting
+        since = press.sequence;
     }
-    return false;
+
+    // Wait for the matching release so one click is not reported twice
+    MouseEvent release;
+    if (events.waitFor(since, MouseEventQueue::maskOf(MouseEventType::Release), press.button, release, -1,
+                       mouse_wait_cancelled) != MouseWaitResult::Event) {
+        return false;
+    }
+
+    if (button) *button = press.button;
+    if (x) *x = press.x;
+    if (y) *y = press.y;
+    return true;
+}
+
+int mouse_poll_events(MouseEventInfo* events, int max_events) {
+    if (!events || max_events <= 0) {
+        return 0;
+    }
+    MouseEventQueue& queue = input_system_mouse_event_queue();
+    std::vector<MouseEvent> drained;
+    queue.drain(drained, (size_t)max_events);
+    for (size_t i = 0; i < drained.size(); i++) {
+        mouse_event_to_info(queue, drained[i], &events[i]);
+    }
+    return (int)drained.size();
+}
+
+bool mouse_wait_event(MouseEventInfo* event, int timeout_ms) {
+    MouseEventQueue& queue = input_system_mouse_event_queue();
+    MouseEvent next;
+    if (queue.waitPop(next, timeout_ms, mouse_wait_cancelled) != MouseWaitResult::Event) {
+        return false;
+    }
+    if (event) {
+        mouse_event_to_info(queue, next, event);
+    }
+    return true;
+}
+
+void mouse_get_sprite_position(float* x, float* y) {
+    // Sprites are laid out in a fixed 1024x768 space stretched over the view
+    float mouseX, mouseY, viewWidth, viewHeight;
+    input_system_get_mouse_position(&mouseX, &mouseY);
+    input_system_get_view_size(&viewWidth, &viewHeight);
+    if (x) *x = viewWidth > 0.0f ? mouseX * 1024.0f / viewWidth : mouseX;
+    if (y) *y = viewHeight > 0.0f ? mouseY * 768.0f / viewHeight : mouseY;
 }
 
 bool sprite_mouse_over(uint16_t sprite_id) {
-    // TODO: Implement sprite collision detection with mouse
-    // This requires access to sprite position and size data
-    return false;
+    float x, y;
+    mouse_get_sprite_position(&x, &y);
+    return sprite_hit_test(sprite_id, x, y, true);
+}
+
+uint16_t sprite_mouse_pick(void) {
+    float x, y;
+    mouse_get_sprite_position(&x, &y);
+    return sprite_pick(x, y, true);
 }
 
 void mouse_screen_to_text(float screen_x, float screen_y, int* text_x, int* text_y) {
@@ -1098,6 +1192,30 @@ bool tile_is_valid_position(int layer, int x, int y) {
     return tile_is_valid_position_impl(layer, x, y);
 }
 
+bool tile_animation_define(uint16_t base_tile, const uint16_t* frames, int frame_count, float frame_duration) {
+    return tile_animation_define_impl(base_tile, frames, frame_count, frame_duration);
+}
+
+bool tile_animation_set_frame_duration(uint16_t base_tile, int frame_index, float seconds) {
+    return tile_animation_set_frame_duration_impl(base_tile, frame_index, seconds);
+}
+
+bool tile_animation_remove(uint16_t base_tile) {
+    return tile_animation_remove_impl(base_tile);
+}
+
+void tile_animation_clear(void) {
+    tile_animation_clear_impl();
+}
+
+void tile_animation_set_paused(bool paused) {
+    tile_animation_set_paused_impl(paused);
+}
+
+uint16_t tile_animation_get_frame(uint16_t tile_id) {
+    return tile_animation_get_frame_impl(tile_id);
+}
+
 void background_color(uint32_t color) {
     if (g_window) {
         float r = ((color >> 0) & 0xFF) / 255.0f;
@@ -1275,6 +1393,114 @@ bool overlay_is_visible() {
     return overlay_graphics_layer_is_visible();
 }
 
+// Retained overlay widgets
+uint32_t overlay_widget_panel(uint32_t parent, float x, float y, float w, float h) {
+    return overlay_graphics_layer_widget_panel(parent, x, y, w, h);
+}
+
+uint32_t overlay_widget_label(uint32_t parent, float x, float y, float w, float h, const char* text, float fontSize) {
+    return overlay_graphics_layer_widget_label(parent, x, y, w, h, text, fontSize);
+}
+
+uint32_t overlay_widget_bar(uint32_t parent, float x, float y, float w, float h, float value) {
+    return overlay_graphics_layer_widget_bar(parent, x, y, w, h, value);
+}
+
+uint32_t overlay_widget_image(uint32_t parent, float x, float y, float w, float h, uint16_t imageId) {
+    return overlay_graphics_layer_widget_image(parent, x, y, w, h, imageId);
+}
+
+bool overlay_widget_remove(uint32_t id) {
+    return overlay_graphics_layer_widget_remove(id);
+}
+
+void overlay_widget_clear() {
+    overlay_graphics_layer_widget_clear();
+}
+
+bool overlay_widget_set_position(uint32_t id, float x, float y) {
+    return overlay_graphics_layer_widget_set_position(id, x, y);
+}
+
+bool overlay_widget_set_size(uint32_t id, float w, float h) {
+    return overlay_graphics_layer_widget_set_size(id, w, h);
+}
+
+bool overlay_widget_set_visible(uint32_t id, bool visible) {
+    return overlay_graphics_layer_widget_set_visible(id, visible);
+}
+
+bool overlay_widget_set_z(uint32_t id, int z) {
+    return overlay_graphics_layer_widget_set_z(id, z);
+}
+
+bool overlay_widget_set_color(uint32_t id, float r, float g, float b, float a) {
+    return overlay_graphics_layer_widget_set_color(id, r, g, b, a);
+}
+
+bool overlay_widget_set_back_color(uint32_t id, float r, float g, float b, float a) {
+    return overlay_graphics_layer_widget_set_back_color(id, r, g, b, a);
+}
+
+bool overlay_widget_set_border(uint32_t id, float width) {
+    return overlay_graphics_layer_widget_set_border(id, width);
+}
+
+bool overlay_widget_set_text(uint32_t id, const char* text) {
+    return overlay_graphics_layer_widget_set_text(id, text);
+}
+
+bool overlay_widget_set_font_size(uint32_t id, float fontSize) {
+    return overlay_graphics_layer_widget_set_font_size(id, fontSize);
+}
+
+bool overlay_widget_set_value(uint32_t id, float value) {
+    return overlay_graphics_layer_widget_set_value(id, value);
+}
+
+bool overlay_widget_set_vertical(uint32_t id, bool vertical) {
+    return overlay_graphics_layer_widget_set_vertical(id, vertical);
+}
+
+bool overlay_widget_set_image(uint32_t id, uint16_t imageId) {
+    return overlay_graphics_layer_widget_set_image(id, imageId);
+}
+
+bool overlay_widget_invalidate(uint32_t id) {
+    return overlay_graphics_layer_widget_invalidate(id);
+}
+
+// Trace capture
+void trace_start() {
+    TraceRecorder::instance().setEnabled(SUPERTERMINAL_TRACING != 0);
+}
+
+void trace_stop() {
+    TraceRecorder::instance().setEnabled(false);
+}
+
+bool trace_is_active() {
+    return TraceRecorder::instance().isEnabled();
+}
+
+void trace_clear() {
+    TraceRecorder::instance().clear();
+}
+
+bool trace_dump(const char* path) {
+    if (!path || !*path) {
+        return false;
+    }
+    TraceRecorder& recorder = TraceRecorder::instance();
+    if (!recorder.writeJSON(path)) {
+        std::cerr << "trace_dump: could not write " << path << std::endl;
+        return false;
+    }
+    std::cout << "trace_dump: " << recorder.getEventCount() << " events from "
+              << recorder.getThreadCount() << " threads written to " << path << std::endl;
+    return true;
+}
+
 // Text Grid Mode Functions
 void setVideoMode(int mode) {
     text_grid_set_mode(mode);
@@ -909,6 +909,9 @@ static SuperTerminalMenuDelegate* g_menuDelegate = nil;
         layer_set_enabled(6, false);  // Also disable editor layer
     }
 
+    // Release what the previous run left behind (engines and caches stay up)
+    superterminal_reset_soft();
+
     // Clear screen for script output
     cls();
     background_color(rgba(0, 0, 50, 255));
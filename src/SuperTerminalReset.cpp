@@ -10,6 +10,8 @@
 //
 
 #include "SuperTerminal.h"
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <vector>
 
@@ -24,14 +26,24 @@ extern "C" {
     // Sprite system internals
     void sprite_layer_cleanup(void);
     bool sprite_layer_initialize(void* device);
+    int sprite_layer_release_generation(uint32_t generation);
+    
+    // Audio playback control (engine stays initialized)
+    void audio_stop_all(void);
     
     // Tile system internals
     void tile_layer_cleanup(void);
     bool tile_layer_initialize(void* device);
+    int tile_layers_release_generation(uint32_t generation);
+    
+    // Graphics layer internals
+    int minimal_graphics_layer_release_generation(uint32_t generation);
+    int overlay_graphics_layer_release_generation(uint32_t generation);
     
     // Text system internals
     void text_layer_clear_all(void);
     void text_layer_reset_cursor(void);
+    int coretext_terminal_release_generation(uint32_t generation);
     
     // Input system internals
     void input_system_reset_all_keys(void);
@@ -44,6 +56,12 @@ extern "C" {
     void reset_lua(void);
     void reset_lua_complete(void);
     bool lua_is_executing(void);
+    bool lua_terminate_current_script(void);
+    
+    // GCD script runtime (Run Script)
+    bool lua_gcd_is_script_running(void);
+    bool lua_gcd_stop_script(void);
+    void lua_gcd_prepare_script_state(void);
     
     // Menu system cleanup
     void superterminal_cleanup_menus(void);
@@ -58,6 +76,23 @@ static int g_reset_count = 0;
 // Error tracking during reset
 static std::vector<std::string> g_reset_errors;
 
+// Script generation: resources record the generation that created them so a
+// soft reset can release only what the previous run made
+static std::atomic<uint32_t> g_script_generation{1};
+
+// Reset latency metrics
+static double g_last_reset_ms = 0.0;
+static double g_total_reset_ms = 0.0;
+static int g_timed_reset_count = 0;
+
+static void record_reset_latency(std::chrono::steady_clock::time_point start, const char* kind) {
+    auto end = std::chrono::steady_clock::now();
+    g_last_reset_ms = std::chrono::duration<double, std::milli>(end - start).count();
+    g_total_reset_ms += g_last_reset_ms;
+    g_timed_reset_count++;
+    std::cout << "SuperTerminalReset: " << kind << " reset took " << g_last_reset_ms << " ms" << std::endl;
+}
+
 // Helper function to log reset steps
 static void log_reset_step(const char* step, bool success = true) {
     if (success) {
@@ -234,6 +269,84 @@ static bool reset_lua_system() {
     }
 }
 
+// Soft reset helpers: stop and clear, but leave engines, pipelines and caches alive
+static bool soft_reset_audio_system() {
+    try {
+        music_stop();
+        music_clear_queue();
+        audio_stop_all();
+        
+        log_reset_step("Audio playback stopped (engine and sound cache kept)");
+        return true;
+    } catch (...) {
+        log_reset_step("Audio soft reset", false);
+        return false;
+    }
+}
+
+static bool soft_reset_sprite_system(uint32_t generation) {
+    try {
+        int released = sprite_layer_release_generation(generation);
+        
+        log_reset_step(("Released " + std::to_string(released) + " sprites from previous run").c_str());
+        return true;
+    } catch (...) {
+        log_reset_step("Sprite soft reset", false);
+        return false;
+    }
+}
+
+static bool soft_reset_tile_system(uint32_t generation) {
+    try {
+        int released = tile_layers_release_generation(generation);
+        
+        log_reset_step(("Cleared " + std::to_string(released) + " tile layers changed by previous run").c_str());
+        return true;
+    } catch (...) {
+        log_reset_step("Tile soft reset", false);
+        return false;
+    }
+}
+
+static bool soft_reset_graphics_system(uint32_t generation) {
+    try {
+        int released = minimal_graphics_layer_release_generation(generation) +
+                       overlay_graphics_layer_release_generation(generation);
+        
+        log_reset_step(("Cleared " + std::to_string(released) + " graphics layers drawn by previous run").c_str());
+        return true;
+    } catch (...) {
+        log_reset_step("Graphics soft reset", false);
+        return false;
+    }
+}
+
+static bool soft_reset_text_system(uint32_t generation) {
+    try {
+        if (coretext_terminal_release_generation(generation) > 0) {
+            log_reset_step("Terminal text cleared (glyph atlas kept)");
+        } else {
+            log_reset_step("Terminal text untouched by previous run");
+        }
+        return true;
+    } catch (...) {
+        log_reset_step("Text soft reset", false);
+        return false;
+    }
+}
+
+static bool soft_reset_lua_system() {
+    try {
+        // Each run gets a fresh state; make sure one is prepared ahead of it
+        lua_gcd_prepare_script_state();
+        log_reset_step("Lua script state prepared for next run");
+        return true;
+    } catch (...) {
+        log_reset_step("Lua soft reset", false);
+        return false;
+    }
+}
+
 static bool reinitialize_systems() {
     log_reset_step("Reinitializing core systems...");
     
@@ -282,6 +395,7 @@ void superterminal_reset_all(void) {
     g_reset_in_progress = true;
     g_reset_count++;
     g_reset_errors.clear();
+    auto start = std::chrono::steady_clock::now();
     
     std::cout << "\n" << std::string(60, '=') << std::endl;
     std::cout << "SuperTerminal: Starting comprehensive system reset #" << g_reset_count << std::endl;
@@ -325,6 +439,10 @@ void superterminal_reset_all(void) {
     // 6. Reinitialize systems that need it
     success &= reinitialize_systems();
     
+    // Everything was torn down, so the next run starts a new generation
+    g_script_generation++;
+    record_reset_latency(start, "Full");
+    
     // Report results
     std::cout << std::string(60, '=') << std::endl;
     if (success && g_reset_errors.empty()) {
@@ -379,6 +497,63 @@ void superterminal_reset_quick(void) {
     std::cout << "SuperTerminal: ✓ Quick reset complete" << std::endl;
 }
 
+void superterminal_reset_soft(void) {
+    if (g_reset_in_progress) {
+        std::cout << "SuperTerminalReset: Reset already in progress, ignoring..." << std::endl;
+        return;
+    }
+    
+    g_reset_in_progress = true;
+    g_reset_count++;
+    g_reset_errors.clear();
+    auto start = std::chrono::steady_clock::now();
+    
+    uint32_t finished = g_script_generation.load();
+    std::cout << "SuperTerminal: Soft reset #" << g_reset_count
+              << " (ending script generation " << finished << ")" << std::endl;
+    
+    try {
+        if (lua_gcd_is_script_running()) {
+            lua_gcd_stop_script();
+            log_reset_step("Running script stopped");
+        }
+    } catch (...) {
+        log_reset_step("Lua script interruption", false);
+    }
+    
+    // New resources belong to the next run from here on
+    g_script_generation++;
+    
+    // The editor is left alone: its buffer holds the script being re-run
+    bool success = true;
+    success &= soft_reset_audio_system();
+    success &= soft_reset_sprite_system(finished);
+    success &= soft_reset_tile_system(finished);
+    success &= soft_reset_graphics_system(finished);
+    success &= soft_reset_text_system(finished);
+    success &= reset_input_system();
+    success &= soft_reset_lua_system();
+    
+    record_reset_latency(start, "Soft");
+    if (!success || !g_reset_errors.empty()) {
+        std::cout << "SuperTerminal: ⚠ Soft reset completed with " << g_reset_errors.size() << " errors" << std::endl;
+    }
+    
+    g_reset_in_progress = false;
+}
+
+uint32_t superterminal_get_script_generation(void) {
+    return g_script_generation.load();
+}
+
+double superterminal_get_last_reset_ms(void) {
+    return g_last_reset_ms;
+}
+
+double superterminal_get_average_reset_ms(void) {
+    return g_timed_reset_count > 0 ? g_total_reset_ms / g_timed_reset_count : 0.0;
+}
+
 bool superterminal_is_reset_in_progress(void) {
     return g_reset_in_progress;
 }
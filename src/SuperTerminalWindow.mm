@@ -14,6 +14,7 @@
 #include <mutex>
 #include "CommandQueue.h"
 #include "GlobalShutdown.h"
+#include "MouseEventQueue.h"
 
 
 // External Metal renderer functions
@@ -48,8 +49,11 @@ extern "C" {
     void input_system_mouse_down(int button, float x, float y);
     void input_system_mouse_up(int button, float x, float y);
     void input_system_mouse_move(float x, float y);
+    void input_system_mouse_wheel(float delta_x, float delta_y);
+    void input_system_interrupt_mouse_waits(void);
     bool input_system_is_mouse_pressed(int button);
     void input_system_get_mouse_position(float* x, float* y);
+    void input_system_get_view_size(float* width, float* height);
     void input_system_get_viewport_size(float* width, float* height);
 
     // Overlay graphics layer functions
@@ -67,6 +71,7 @@ extern "C" {
     void editor_mouse_drag(float x, float y);
     void editor_mouse_up(float x, float y);
     void editor_scroll_vertical(int lines);
+    void editor_scroll_horizontal(int columns);
 
     // Metal device access
     void* superterminal_get_metal_device(void);
@@ -325,11 +330,10 @@ static bool g_esc_held = false;
 static bool g_mouseButtonStates[3] = {false, false, false}; // Left, Right, Middle
 static float g_mouseX = 0.0f;
 static float g_mouseY = 0.0f;
-static bool g_mouseWaiting = false;
-static dispatch_semaphore_t g_mouseSemaphore = nil;
-static int g_waitMouseButton = -1;
-static float g_waitMouseX = 0.0f;
-static float g_waitMouseY = 0.0f;
+
+// Timestamped press/release/move/wheel stream for scripts; waits on it wake
+// on the next event instead of polling the button state
+static MouseEventQueue g_mouseEvents;
 
 @interface SuperTerminalView : MTKView
 @end
@@ -412,16 +416,6 @@ static float g_waitMouseY = 0.0f;
     g_mouseX = x;
     g_mouseY = y;
 
-
-
-    // Signal waiting threads
-    if (g_mouseWaiting && g_mouseSemaphore) {
-        g_waitMouseButton = 0;
-        g_waitMouseX = x;
-        g_waitMouseY = y;
-        dispatch_semaphore_signal(g_mouseSemaphore);
-    }
-
     input_system_mouse_down(0, x, y);
 
     // If editor is active, start selection
@@ -461,16 +455,6 @@ static float g_waitMouseY = 0.0f;
     g_mouseX = x;
     g_mouseY = y;
 
-
-
-    // Signal waiting threads
-    if (g_mouseWaiting && g_mouseSemaphore) {
-        g_waitMouseButton = 1;
-        g_waitMouseX = x;
-        g_waitMouseY = y;
-        dispatch_semaphore_signal(g_mouseSemaphore);
-    }
-
     input_system_mouse_down(1, x, y);
 
     // Mouse click handled by input system only
@@ -535,6 +519,9 @@ static float g_waitMouseY = 0.0f;
 
 - (void)scrollWheel:(NSEvent *)event {
     CGFloat deltaY = [event deltaY];
+    CGFloat deltaX = [event deltaX];
+
+    input_system_mouse_wheel((float)deltaX, (float)deltaY);
 
     // NSLog(@"scrollWheel: deltaY=%.2f", deltaY);
 
@@ -545,6 +532,12 @@ static float g_waitMouseY = 0.0f;
         if (scroll_lines != 0) {
             editor_scroll_vertical(-scroll_lines); // Negative for natural scrolling
         }
+
+        // Sideways scrolling pans across long lines
+        int scroll_columns = (int)(deltaX * 0.5);
+        if (scroll_columns != 0) {
+            editor_scroll_horizontal(-scroll_columns);
+        }
     }
 }
 
@@ -563,11 +556,10 @@ extern "C" {
             memset(g_keyStates, 0, sizeof(g_keyStates));
 
             // Initialize mouse input system
-            g_mouseSemaphore = dispatch_semaphore_create(0);
             memset(g_mouseButtonStates, 0, sizeof(g_mouseButtonStates));
             g_mouseX = 0.0f;
             g_mouseY = 0.0f;
-            g_mouseWaiting = false;
+            g_mouseEvents.clear();
 
             // Make sure we have an app
             NSApplication* app = [NSApplication sharedApplication];
@@ -985,12 +977,24 @@ extern "C" {
     }
 
     // Mouse input system functions
+    static void input_system_push_mouse_event(MouseEventType type, int button, float x, float y,
+                                              float deltaX = 0.0f, float deltaY = 0.0f) {
+        MouseEvent event;
+        event.type = type;
+        event.button = button;
+        event.x = x;
+        event.y = y;
+        event.deltaX = deltaX;
+        event.deltaY = deltaY;
+        g_mouseEvents.push(event);
+    }
+
     void input_system_mouse_down(int button, float x, float y) {
         if (button >= 0 && button < 3) {
             g_mouseButtonStates[button] = true;
             g_mouseX = x;
             g_mouseY = y;
-            NSLog(@"Mouse button %d down at (%.1f, %.1f)", button, x, y);
+            input_system_push_mouse_event(MouseEventType::Press, button, x, y);
         }
     }
 
@@ -999,13 +1003,23 @@ extern "C" {
             g_mouseButtonStates[button] = false;
             g_mouseX = x;
             g_mouseY = y;
-            NSLog(@"Mouse button %d up at (%.1f, %.1f)", button, x, y);
+            input_system_push_mouse_event(MouseEventType::Release, button, x, y);
         }
     }
 
     void input_system_mouse_move(float x, float y) {
         g_mouseX = x;
         g_mouseY = y;
+        input_system_push_mouse_event(MouseEventType::Move, -1, x, y);
+    }
+
+    void input_system_mouse_wheel(float delta_x, float delta_y) {
+        input_system_push_mouse_event(MouseEventType::Wheel, -1, g_mouseX, g_mouseY, delta_x, delta_y);
+    }
+
+    // Wake script threads blocked on mouse input (script stop/shutdown)
+    void input_system_interrupt_mouse_waits(void) {
+        g_mouseEvents.interrupt();
     }
 
     bool input_system_is_mouse_pressed(int button) {
@@ -1020,6 +1034,18 @@ extern "C" {
         if (y) *y = g_mouseY;
     }
 
+    // View size in points, the space mouse positions are reported in
+    void input_system_get_view_size(float* width, float* height) {
+        if (g_metalView) {
+            NSSize size = g_metalView.bounds.size;
+            if (width) *width = size.width;
+            if (height) *height = size.height;
+        } else {
+            if (width) *width = 1024.0f;
+            if (height) *height = 768.0f;
+        }
+    }
+
     void input_system_get_viewport_size(float* width, float* height) {
         if (g_metalView) {
             CGSize drawableSize = g_metalView.drawableSize;
@@ -1488,3 +1514,8 @@ extern "C" {
     }
 
 } // extern "C"
+
+// Event stream for the API layer (mouse_wait_click, mouse_poll_events)
+MouseEventQueue& input_system_mouse_event_queue() {
+    return g_mouseEvents;
+}
@@ -10,6 +10,8 @@
 
 #include "SuperTerminal.h"
 #include "CoreTextRenderer.h"
+#include "EditorLineIndex.h"
+#include "EditorEditBatch.h"
 #include <iostream>
 #include <string>
 #include <vector>
@@ -140,10 +142,24 @@ struct TextEditorState {
     int selection_end_x;
     int selection_end_y;
     bool is_selecting; // Currently dragging to select
+    
+    // Multi-cursor editing (the primary caret is cursor_x/cursor_y)
+    std::vector<EditorPosition> extra_cursors;
 };
 
 static TextEditorState g_editor = {};
 
+// Line lengths and lexer checkpoints, kept in step with g_editor.lines
+static EditorLineIndex g_line_index;
+
+// Hard cap on a single line (bytes); long generated lines are kept whole
+static const int MAX_EDITOR_LINE_LENGTH = 1 << 20;
+
+// Rebuild the line index after the line vector was replaced wholesale
+static void editor_reindex_lines() {
+    g_line_index.reset(g_editor.lines);
+}
+
 // Forward declaration for overlay functions
 // Forward declarations for overlay system
 extern "C" {
@@ -245,7 +261,7 @@ static int get_content_lines() {
 }
 
 static int get_max_line_length() {
-    return get_editor_width() - 1;
+    return MAX_EDITOR_LINE_LENGTH;
 }
 
 // Dirty line tracking implementation
@@ -253,6 +269,9 @@ static void mark_line_dirty(int line_index) {
     if (line_index >= 0 && line_index < (int)g_editor.dirty_lines.size()) {
         g_editor.dirty_lines[line_index] = true;
     }
+    if (line_index >= 0 && line_index < (int)g_editor.lines.size()) {
+        g_line_index.lineChanged(line_index, g_editor.lines[line_index]);
+    }
 }
 
 static void mark_all_dirty() {
@@ -296,6 +315,7 @@ static void editor_save_undo_state(const std::string& description);
 static void editor_undo();
 static void editor_redo();
 static void editor_find();
+static void editor_replace_all();
 static void editor_goto_line();
 static void editor_page_up();
 static void editor_page_down();
@@ -306,6 +326,13 @@ static void render_line_with_syntax(const std::string& line, int screen_y);
 static bool is_lua_keyword(const std::string& word);
 static bool is_superterminal_function(const std::string& word);
 
+// Batched edits and multi-cursor editing
+static EditorBatchResult editor_apply_batch(const EditorEditBatch& batch, const std::string& description);
+static void editor_multi_cursor_add(int dy);
+static void editor_multi_cursor_clear();
+static void editor_multi_cursor_insert(const std::string& text);
+static void editor_multi_cursor_erase(bool forward);
+
 // Dirty line tracking helpers
 static void mark_line_dirty(int line_index);
 static void mark_all_dirty();
@@ -448,6 +475,7 @@ static void editor_delete_selection() {
             int actual_start_x = std::min(start_x, (int)line.length());
             if (actual_end_x > actual_start_x) {
                 line.erase(actual_start_x, actual_end_x - actual_start_x);
+                mark_line_dirty(start_y);
             }
             g_editor.cursor_x = actual_start_x;
             g_editor.cursor_y = start_y;
@@ -472,12 +500,14 @@ static void editor_delete_selection() {
             if (y < (int)g_editor.lines.size()) {
                 g_editor.lines.erase(g_editor.lines.begin() + y);
                 g_editor.dirty_lines.erase(g_editor.dirty_lines.begin() + y);
+                g_line_index.linesErased(y, 1);
             }
         }
         
         // Insert combined line
         g_editor.lines.insert(g_editor.lines.begin() + start_y, first_part + last_part);
         g_editor.dirty_lines.insert(g_editor.dirty_lines.begin() + start_y, true);
+        g_line_index.linesInserted(start_y, g_editor.lines, 1);
         
         g_editor.cursor_x = start_x;
         g_editor.cursor_y = start_y;
@@ -537,13 +567,16 @@ static uint32_t get_syntax_color_for_char(char c, char prev_char, char next_char
     
     // Check if we're in a keyword or function
     if (std::isalpha(c) || c == '_') {
-        // Extract word
+        // Extract word (bounded, so a huge identifier run stays cheap per column)
+        const size_t max_word = 64;
         size_t word_start = pos;
-        while (word_start > 0 && (std::isalnum(line[word_start - 1]) || line[word_start - 1] == '_')) {
+        while (word_start > 0 && pos - word_start < max_word &&
+               (std::isalnum(line[word_start - 1]) || line[word_start - 1] == '_')) {
             word_start--;
         }
         size_t word_end = pos;
-        while (word_end < line.length() && (std::isalnum(line[word_end]) || line[word_end] == '_')) {
+        while (word_end < line.length() && word_end - pos < max_word &&
+               (std::isalnum(line[word_end]) || line[word_end] == '_')) {
             word_end++;
         }
         
@@ -578,6 +611,11 @@ static void render_viewport_to_grid(struct TextCell* grid, int grid_width,
     uint32_t selection_paper = rgba(100, 150, 200, 255);
     simd_float4 selection_paper_color = color_to_float4(selection_paper);
     
+    // Safety check: the line index must mirror the line vector
+    if (g_line_index.lineCount() != (int)g_editor.lines.size()) {
+        editor_reindex_lines();
+    }
+    
     // Render visible portion of document with syntax highlighting
     for (int row = 0; row < viewport_height; row++) {
         int buffer_row = scroll_y + row;
@@ -587,16 +625,9 @@ static void render_viewport_to_grid(struct TextCell* grid, int grid_width,
         if (buffer_row >= 0 && buffer_row < (int)g_editor.lines.size()) {
             const std::string& line = g_editor.lines[buffer_row];
             
-            // Track syntax state for this line
-            bool in_string_double = false;
-            bool in_string_single = false;
-            bool in_comment = false;
-            
-            // Pre-scan line for comment start
-            size_t comment_pos = line.find("--");
-            if (comment_pos != std::string::npos) {
-                in_comment = false; // Will be set true after this position
-            }
+            // Resume the lexer from the nearest checkpoint before scroll_x
+            // instead of rescanning the line from column 0
+            EditorLexState lex = g_line_index.stateAt(buffer_row, line, scroll_x);
             
             // Render visible columns with syntax highlighting
             for (int col = 0; col < viewport_width; col++) {
@@ -606,20 +637,9 @@ static void render_viewport_to_grid(struct TextCell* grid, int grid_width,
                     char c = line[buffer_col];
                     
                     // Update syntax state
-                    if (buffer_col >= (int)comment_pos && comment_pos != std::string::npos) {
-                        in_comment = true;
-                    }
-                    
-                    if (!in_comment) {
-                        if (c == '"' && (buffer_col == 0 || line[buffer_col - 1] != '\\')) {
-                            in_string_double = !in_string_double;
-                        }
-                        if (c == '\'' && (buffer_col == 0 || line[buffer_col - 1] != '\\')) {
-                            in_string_single = !in_string_single;
-                        }
-                    }
-                    
-                    bool in_string = in_string_double || in_string_single;
+                    lex = EditorLineIndex::step(lex, line, buffer_col);
+                    bool in_string = lex.inString();
+                    bool in_comment = lex.inComment;
                     
                     // Get syntax color
                     char prev_char = (buffer_col > 0) ? line[buffer_col - 1] : ' ';
@@ -780,6 +800,7 @@ bool editor_toggle_impl(void) {
         g_editor.clipboard.clear();
         g_editor.undo_stack.clear();
         g_editor.redo_stack.clear();
+        g_editor.extra_cursors.clear();
         g_editor.max_undo_levels = 50;
         g_editor.search_term.clear();
         g_editor.search_start_x = 0;
@@ -828,6 +849,7 @@ bool editor_toggle_impl(void) {
                 
                 // Initialize dirty_lines to match lines size
                 g_editor.dirty_lines.resize(g_editor.lines.size(), true);
+                editor_reindex_lines();
                 g_editor.full_redraw_needed = true;
                 
                 editor_set_status("Editing Lua script - F2:Execute F8:Save ESC:Exit");
@@ -837,12 +859,14 @@ bool editor_toggle_impl(void) {
                 
                 // Initialize dirty_lines to match lines size
                 g_editor.dirty_lines.resize(g_editor.lines.size(), true);
+                editor_reindex_lines();
                 g_editor.full_redraw_needed = true;
             }
         } else {
             // Ensure dirty_lines is initialized if lines already exist
             if (g_editor.dirty_lines.size() != g_editor.lines.size()) {
                 g_editor.dirty_lines.resize(g_editor.lines.size(), true);
+                editor_reindex_lines();
                 g_editor.full_redraw_needed = true;
             }
             editor_set_status("Editor ready - F2:Execute F8:Save ESC:Exit");
@@ -1031,6 +1055,7 @@ bool editor_load(const char* filename) {
         }
         
         file.close();
+        editor_reindex_lines();
         
         g_editor.cursor_x = 0;
         g_editor.cursor_y = 0;
@@ -1062,6 +1087,7 @@ bool editor_load(const char* filename) {
                     g_editor.lines.push_back(line);
                 }
                 formatted_in.close();
+                editor_reindex_lines();
                 
                 char status[128];
                 snprintf(status, sizeof(status), "LOADED & FORMATTED: %s (%d lines)", filename, (int)g_editor.lines.size());
@@ -1127,6 +1153,7 @@ bool editor_load_file(const char* filepath) {
         
         // Initialize dirty tracking
         g_editor.dirty_lines.resize(g_editor.lines.size(), true);
+        editor_reindex_lines();
         g_editor.full_redraw_needed = true;
         g_editor.last_scroll_offset = 0;
         g_editor.last_horizontal_offset = 0;
@@ -1161,6 +1188,7 @@ bool editor_load_file(const char* filepath) {
                     g_editor.lines.push_back(line);
                 }
                 formatted_in.close();
+                editor_reindex_lines();
                 
                 char status[256];
                 snprintf(status, sizeof(status), "LOADED & FORMATTED: %s (%d lines)", filepath, (int)g_editor.lines.size());
@@ -1221,6 +1249,7 @@ void editor_set_content(const char* content, const char* filename) {
     
     // Initialize dirty tracking
     g_editor.dirty_lines.resize(g_editor.lines.size(), true);
+    editor_reindex_lines();
     g_editor.full_redraw_needed = true;
     g_editor.modified = false;
     
@@ -1282,6 +1311,7 @@ bool editor_load_content(const char* content, const char* filename) {
         
         // Initialize dirty tracking
         g_editor.dirty_lines.resize(g_editor.lines.size(), true);
+        editor_reindex_lines();
         g_editor.full_redraw_needed = true;
         g_editor.last_scroll_offset = 0;
         g_editor.last_horizontal_offset = 0;
@@ -1329,6 +1359,7 @@ bool editor_load_content(const char* content, const char* filename) {
                     g_editor.lines.push_back(line);
                 }
                 formatted_in.close();
+                editor_reindex_lines();
             
                 char status[256];
                 snprintf(status, sizeof(status), "LOADED & FORMATTED: %s (%d lines)", filename ? filename : "content", (int)g_editor.lines.size());
@@ -1403,6 +1434,7 @@ void editor_clear(void) {
     g_editor.lines.push_back("");
     g_editor.dirty_lines.clear();
     g_editor.dirty_lines.resize(1, true);
+    editor_reindex_lines();
     g_editor.full_redraw_needed = true;
     g_editor.cursor_x = 0;
     g_editor.cursor_y = 0;
@@ -1421,6 +1453,7 @@ void editor_clear(void) {
     // Clear undo/redo stacks and clipboard
     g_editor.undo_stack.clear();
     g_editor.redo_stack.clear();
+    g_editor.extra_cursors.clear();
     g_editor.clipboard.clear();
     g_editor.search_term.clear();
     g_editor.search_active = false;
@@ -1613,6 +1646,10 @@ void editor_key_pressed(int key, int keycode, bool shift, bool ctrl, bool alt, b
             case 'F':
                 editor_find();
                 break;
+            case 'r':
+            case 'R':
+                editor_replace_all();
+                break;
             case 'l':
             case 'L':
                 editor_goto_line();
@@ -1624,7 +1661,8 @@ void editor_key_pressed(int key, int keycode, bool shift, bool ctrl, bool alt, b
         // Don't process other keys when ctrl is pressed (except fall-through cases)
         if (key == 'k' || key == 'K' || key == 'd' || key == 'D' || 
             key == 'z' || key == 'Z' || key == 'y' || key == 'Y' ||
-            key == 'f' || key == 'F' || key == 'l' || key == 'L') {
+            key == 'f' || key == 'F' || key == 'r' || key == 'R' ||
+            key == 'l' || key == 'L') {
             if (g_editor.active) {
                 editor_update_buffer();
             }
@@ -1732,6 +1770,7 @@ void editor_key_pressed(int key, int keycode, bool shift, bool ctrl, bool alt, b
                             g_editor.lines.push_back(line);
                         }
                         formatted_in.close();
+                        editor_reindex_lines();
                         
                         g_editor.modified = true;
                         editor_set_status("Lua code formatted successfully");
@@ -1766,7 +1805,9 @@ void editor_key_pressed(int key, int keycode, bool shift, bool ctrl, bool alt, b
             break;
             
         case 0x35: // ESC
-            if (g_editor.modified) {
+            if (!g_editor.extra_cursors.empty()) {
+                editor_multi_cursor_clear();
+            } else if (g_editor.modified) {
                 editor_set_status("Unsaved changes! F7 to save, F1 to exit anyway");
             } else {
                 layer_set_enabled(6, false);
@@ -1775,21 +1816,34 @@ void editor_key_pressed(int key, int keycode, bool shift, bool ctrl, bool alt, b
             break;
             
         case 0x33: // Backspace/Delete
+            if (!g_editor.extra_cursors.empty()) {
+                editor_multi_cursor_erase(false);
+                break;
+            }
             editor_save_undo_state("Backspace");
             editor_handle_backspace();
             break;
             
         case 0x75: // Forward Delete (Fn+Delete on Mac laptop)
+            if (!g_editor.extra_cursors.empty()) {
+                editor_multi_cursor_erase(true);
+                break;
+            }
             editor_save_undo_state("Forward Delete");
             editor_handle_forward_delete();
             break;
             
         case 0x24: // Return/Enter
+            if (!g_editor.extra_cursors.empty()) {
+                editor_multi_cursor_insert("\n");
+                break;
+            }
             editor_new_line();
             break;
             
         case 0x7B: // Left arrow
             std::cout << "[ARROW KEY] LEFT pressed - moving cursor left" << std::endl;
+            editor_multi_cursor_clear();
             editor_clear_selection(); // Clear selection on arrow key
             editor_move_cursor(-1, 0);
             std::cout << "[ARROW KEY] After left: cursor_x=" << g_editor.cursor_x << " cursor_y=" << g_editor.cursor_y << std::endl;
@@ -1797,17 +1851,28 @@ void editor_key_pressed(int key, int keycode, bool shift, bool ctrl, bool alt, b
             
         case 0x7C: // Right arrow
             std::cout << "[ARROW KEY] RIGHT pressed - moving cursor right" << std::endl;
+            editor_multi_cursor_clear();
             editor_clear_selection(); // Clear selection on arrow key
             editor_move_cursor(1, 0);
             std::cout << "[ARROW KEY] After right: cursor_x=" << g_editor.cursor_x << " cursor_y=" << g_editor.cursor_y << std::endl;
             break;
             
         case 0x7E: // Up arrow
+            if (alt) {
+                editor_multi_cursor_add(-1); // Option+Up adds a caret on the line above
+                break;
+            }
+            editor_multi_cursor_clear();
             editor_clear_selection(); // Clear selection on arrow key
             editor_move_cursor(0, -1);
             break;
             
         case 0x7D: // Down arrow
+            if (alt) {
+                editor_multi_cursor_add(1); // Option+Down adds a caret on the line below
+                break;
+            }
+            editor_multi_cursor_clear();
             editor_clear_selection(); // Clear selection on arrow key
             editor_move_cursor(0, 1);
             break;
@@ -1823,7 +1888,11 @@ void editor_key_pressed(int key, int keycode, bool shift, bool ctrl, bool alt, b
         default:
             // Regular character input
             if (key >= 32 && key <= 126) { // Printable ASCII
-                editor_insert_char((char)key);
+                if (!g_editor.extra_cursors.empty()) {
+                    editor_multi_cursor_insert(std::string(1, (char)key));
+                } else {
+                    editor_insert_char((char)key);
+                }
             }
             break;
     }
@@ -1893,6 +1962,19 @@ static void editor_update_buffer() {
                                g_editor.horizontal_offset, g_editor.scroll_offset,  // scroll offsets
                                white, blue);  // colors
         
+        // Extra carets are drawn as highlighted cells (the shader cursor shows the primary)
+        simd_float4 caret_paper = color_to_float4(rgba(200, 200, 255, 255));
+        simd_float4 caret_ink = color_to_float4(blue);
+        for (const auto& caret : g_editor.extra_cursors) {
+            int screen_x = caret.column - g_editor.horizontal_offset;
+            int screen_y = caret.line - g_editor.scroll_offset;
+            if (screen_x >= 0 && screen_x < editorWidth && screen_y >= 0 && screen_y < content_lines) {
+                struct TextCell& cell = grid[(content_start_y + screen_y) * gridWidth + screen_x];
+                cell.paperColor = caret_paper;
+                cell.inkColor = caret_ink;
+            }
+        }
+        
         // Update tracking variables
         g_editor.last_scroll_offset = g_editor.scroll_offset;
         g_editor.last_horizontal_offset = g_editor.horizontal_offset;
@@ -2063,6 +2145,7 @@ void editor_new_file(void) {
     g_editor.lines.push_back("");
     g_editor.dirty_lines.clear();
     g_editor.dirty_lines.resize(1, true);
+    editor_reindex_lines();
     g_editor.full_redraw_needed = true;
     g_editor.cursor_x = 0;
     g_editor.cursor_y = 0;
@@ -2074,6 +2157,7 @@ void editor_new_file(void) {
     // Clear undo/redo stacks
     g_editor.undo_stack.clear();
     g_editor.redo_stack.clear();
+    g_editor.extra_cursors.clear();
     
     if (g_editor.active) {
         editor_set_status("New file created");
@@ -2125,6 +2209,7 @@ static void editor_insert_char(char c) {
     if (g_editor.cursor_y >= (int)g_editor.lines.size()) {
         g_editor.lines.resize(g_editor.cursor_y + 1);
         g_editor.dirty_lines.resize(g_editor.cursor_y + 1, true);
+        editor_reindex_lines();
     }
     
     std::string& line = g_editor.lines[g_editor.cursor_y];
@@ -2159,6 +2244,7 @@ static void editor_handle_backspace() {
         std::string current_line = g_editor.lines[g_editor.cursor_y];
         g_editor.lines.erase(g_editor.lines.begin() + g_editor.cursor_y);
         g_editor.dirty_lines.erase(g_editor.dirty_lines.begin() + g_editor.cursor_y);
+        g_line_index.linesErased(g_editor.cursor_y, 1);
         g_editor.cursor_y--;
         g_editor.cursor_x = g_editor.lines[g_editor.cursor_y].length();
         g_editor.lines[g_editor.cursor_y] += current_line;
@@ -2191,6 +2277,7 @@ static void editor_handle_forward_delete() {
         g_editor.lines[g_editor.cursor_y] += next_line;
         g_editor.lines.erase(g_editor.lines.begin() + g_editor.cursor_y + 1);
         g_editor.dirty_lines.erase(g_editor.dirty_lines.begin() + g_editor.cursor_y + 1);
+        g_line_index.linesErased(g_editor.cursor_y + 1, 1);
         g_editor.modified = true;
         mark_line_dirty(g_editor.cursor_y);
         mark_all_dirty(); // Line numbers changed
@@ -2209,6 +2296,7 @@ static void editor_new_line() {
     // Safety check: ensure dirty_lines is synchronized with lines
     if (g_editor.dirty_lines.size() != g_editor.lines.size()) {
         g_editor.dirty_lines.resize(g_editor.lines.size(), true);
+        editor_reindex_lines();
     }
     
     std::string& current_line = g_editor.lines[g_editor.cursor_y];
@@ -2217,6 +2305,7 @@ static void editor_new_line() {
     
     g_editor.lines.insert(g_editor.lines.begin() + g_editor.cursor_y + 1, new_line);
     g_editor.dirty_lines.insert(g_editor.dirty_lines.begin() + g_editor.cursor_y + 1, true);
+    g_line_index.linesInserted(g_editor.cursor_y + 1, g_editor.lines, 1);
     mark_line_dirty(g_editor.cursor_y);
     mark_line_dirty(g_editor.cursor_y + 1);
     mark_all_dirty(); // Line numbers changed
@@ -2242,6 +2331,7 @@ static void editor_delete_line() {
         // Delete the current line
         g_editor.lines.erase(g_editor.lines.begin() + g_editor.cursor_y);
         g_editor.dirty_lines.erase(g_editor.dirty_lines.begin() + g_editor.cursor_y);
+        g_line_index.linesErased(g_editor.cursor_y, 1);
         
         // Adjust cursor position
         if (g_editor.cursor_y >= (int)g_editor.lines.size()) {
@@ -2271,6 +2361,7 @@ static void editor_duplicate_line() {
     if (g_editor.lines.empty()) {
         g_editor.lines.push_back("");
         g_editor.dirty_lines.resize(1, true);
+        editor_reindex_lines();
         g_editor.cursor_y = 0;
         g_editor.cursor_x = 0;
         return;
@@ -2289,6 +2380,7 @@ static void editor_duplicate_line() {
     // Insert a copy of the current line below it
     g_editor.lines.insert(g_editor.lines.begin() + g_editor.cursor_y + 1, current_line);
     g_editor.dirty_lines.insert(g_editor.dirty_lines.begin() + g_editor.cursor_y + 1, true);
+    g_line_index.linesInserted(g_editor.cursor_y + 1, g_editor.lines, 1);
     
     // Move cursor to the duplicated line
     g_editor.cursor_y++;
@@ -2636,6 +2728,7 @@ static void editor_cut_line() {
         } else {
             g_editor.lines.erase(g_editor.lines.begin() + g_editor.cursor_y);
             g_editor.dirty_lines.erase(g_editor.dirty_lines.begin() + g_editor.cursor_y);
+            g_line_index.linesErased(g_editor.cursor_y, 1);
             
             if (g_editor.cursor_y >= (int)g_editor.lines.size()) {
                 g_editor.cursor_y = (int)g_editor.lines.size() - 1;
@@ -2692,12 +2785,14 @@ static void editor_paste_line() {
             // Insert first line below current line
             g_editor.lines.insert(g_editor.lines.begin() + g_editor.cursor_y + 1, line);
             g_editor.dirty_lines.insert(g_editor.dirty_lines.begin() + g_editor.cursor_y + 1, true);
+            g_line_index.linesInserted(g_editor.cursor_y + 1, g_editor.lines, 1);
             g_editor.cursor_y++;
             first_line = false;
         } else {
             // Insert subsequent lines
             g_editor.lines.insert(g_editor.lines.begin() + g_editor.cursor_y + 1, line);
             g_editor.dirty_lines.insert(g_editor.dirty_lines.begin() + g_editor.cursor_y + 1, true);
+            g_line_index.linesInserted(g_editor.cursor_y + 1, g_editor.lines, 1);
             g_editor.cursor_y++;
         }
         lines_pasted++;
@@ -2707,6 +2802,7 @@ static void editor_paste_line() {
     if (lines_pasted == 0) {
         g_editor.lines.insert(g_editor.lines.begin() + g_editor.cursor_y + 1, paste_text);
         g_editor.dirty_lines.insert(g_editor.dirty_lines.begin() + g_editor.cursor_y + 1, true);
+        g_line_index.linesInserted(g_editor.cursor_y + 1, g_editor.lines, 1);
         g_editor.cursor_y++;
         lines_pasted = 1;
     }
@@ -2775,6 +2871,8 @@ static void editor_undo() {
     // Restore previous state
     TextEditorState::EditorSnapshot& snapshot = g_editor.undo_stack.back();
     g_editor.lines = snapshot.lines;
+    editor_reindex_lines();
+    g_editor.extra_cursors.clear();
     g_editor.cursor_x = snapshot.cursor_x;
     g_editor.cursor_y = snapshot.cursor_y;
     g_editor.scroll_offset = snapshot.scroll_offset;
@@ -2801,6 +2899,8 @@ static void editor_redo() {
     // Restore next state
     TextEditorState::EditorSnapshot& snapshot = g_editor.redo_stack.back();
     g_editor.lines = snapshot.lines;
+    editor_reindex_lines();
+    g_editor.extra_cursors.clear();
     g_editor.cursor_x = snapshot.cursor_x;
     g_editor.cursor_y = snapshot.cursor_y;
     g_editor.scroll_offset = snapshot.scroll_offset;
@@ -2868,6 +2968,170 @@ static void editor_find() {
     if (search_input) free(search_input);
 }
 
+// Apply a batch of edits as one operation: one undo record, one rebuild of
+// the touched line range and one dirty-range update
+static EditorBatchResult editor_apply_batch(const EditorEditBatch& batch, const std::string& description) {
+    if (batch.empty()) {
+        return EditorBatchResult{};
+    }
+    
+    // A batch that leaves the text as it is (replacing a term with itself,
+    // backspacing at column 0) still moves carets, but must not take an
+    // undo record: saving one would clear the redo history
+    if (!batch.changes(g_editor.lines)) {
+        return batch.apply(g_editor.lines);
+    }
+    
+    editor_save_undo_state(description);
+    EditorBatchResult result = batch.apply(g_editor.lines);
+    
+    // Swap the touched range in the line index instead of rescanning
+    int old_count = result.oldLastLine - result.firstLine + 1;
+    int new_count = result.newLastLine - result.firstLine + 1;
+    g_line_index.linesErased(result.firstLine, old_count);
+    g_line_index.linesInserted(result.firstLine, g_editor.lines, new_count);
+    
+    g_editor.dirty_lines.resize(g_editor.lines.size(), true);
+    if (result.lineDelta == 0) {
+        mark_range_dirty(result.firstLine, result.newLastLine);
+    } else {
+        mark_range_dirty(result.firstLine, (int)g_editor.lines.size() - 1);
+    }
+    
+    g_editor.modified = true;
+    g_ui_needs_redraw = true;
+    return result;
+}
+
+// Add a caret one line above/below the outermost caret (Option+Up/Down)
+static void editor_multi_cursor_add(int dy) {
+    EditorPosition edge{g_editor.cursor_y, g_editor.cursor_x};
+    for (const auto& caret : g_editor.extra_cursors) {
+        if ((dy < 0 && caret.line < edge.line) || (dy > 0 && caret.line > edge.line)) {
+            edge = caret;
+        }
+    }
+    
+    int line = edge.line + dy;
+    if (line < 0 || line >= (int)g_editor.lines.size()) {
+        return;
+    }
+    
+    // Column carets keep the primary column, clamped to the line
+    int column = std::min(g_editor.cursor_x, (int)g_editor.lines[line].length());
+    g_editor.extra_cursors.push_back(EditorPosition{line, column});
+    mark_line_dirty(line);
+    editor_set_status(("Carets: " + std::to_string(g_editor.extra_cursors.size() + 1)).c_str());
+}
+
+static void editor_multi_cursor_clear() {
+    if (g_editor.extra_cursors.empty()) {
+        return;
+    }
+    for (const auto& caret : g_editor.extra_cursors) {
+        mark_line_dirty(caret.line);
+    }
+    g_editor.extra_cursors.clear();
+}
+
+// Carets after a batch: index 0 is the primary, the rest are extras. Carets
+// that landed on the same position are merged.
+static void editor_multi_cursor_update(const EditorBatchResult& result) {
+    if (result.carets.empty()) {
+        return;
+    }
+    g_editor.cursor_y = result.carets[0].line;
+    g_editor.cursor_x = result.carets[0].column;
+    
+    std::vector<EditorPosition> extras;
+    for (size_t i = 1; i < result.carets.size(); i++) {
+        const EditorPosition& caret = result.carets[i];
+        if (caret == result.carets[0] ||
+            std::find(extras.begin(), extras.end(), caret) != extras.end()) {
+            continue;
+        }
+        extras.push_back(caret);
+    }
+    g_editor.extra_cursors = extras;
+    editor_scroll_if_needed();
+}
+
+// Type the same text at every caret
+static void editor_multi_cursor_insert(const std::string& text) {
+    EditorEditBatch batch;
+    batch.insert(EditorPosition{g_editor.cursor_y, g_editor.cursor_x}, text);
+    for (const auto& caret : g_editor.extra_cursors) {
+        batch.insert(caret, text);
+    }
+    
+    EditorBatchResult result = editor_apply_batch(batch, "Multi-cursor typing");
+    editor_multi_cursor_update(result);
+}
+
+// Delete one character before (backspace) or after (forward) every caret.
+// Carets at a line boundary stay put rather than joining lines.
+static void editor_multi_cursor_erase(bool forward) {
+    std::vector<EditorPosition> carets;
+    carets.push_back(EditorPosition{g_editor.cursor_y, g_editor.cursor_x});
+    carets.insert(carets.end(), g_editor.extra_cursors.begin(), g_editor.extra_cursors.end());
+    
+    EditorEditBatch batch;
+    for (const auto& caret : carets) {
+        int length = (caret.line < (int)g_editor.lines.size()) ? (int)g_editor.lines[caret.line].length() : 0;
+        if (forward && caret.column < length) {
+            batch.erase(caret, EditorPosition{caret.line, caret.column + 1});
+        } else if (!forward && caret.column > 0) {
+            batch.erase(EditorPosition{caret.line, caret.column - 1}, caret);
+        } else {
+            batch.insert(caret, "");   // Keeps the caret's slot in the result
+        }
+    }
+    
+    EditorBatchResult result = editor_apply_batch(batch, forward ? "Multi-cursor delete" : "Multi-cursor backspace");
+    editor_multi_cursor_update(result);
+}
+
+// Replace every occurrence of a search term (Ctrl+R)
+static void editor_replace_all() {
+    const char* default_text = g_editor.search_term.empty() ? "" : g_editor.search_term.c_str();
+    char* find_input = show_macos_input_dialog("Replace All", "Find:", default_text);
+    if (!find_input || strlen(find_input) == 0) {
+        editor_set_status("Replace cancelled");
+        if (find_input) free(find_input);
+        return;
+    }
+    std::string find_text = find_input;
+    free(find_input);
+    
+    char* replace_input = show_macos_input_dialog("Replace All", ("Replace '" + find_text + "' with:").c_str(), "");
+    if (!replace_input) {
+        editor_set_status("Replace cancelled");
+        return;
+    }
+    std::string replace_text = replace_input;
+    free(replace_input);
+    
+    g_editor.search_term = find_text;
+    editor_clear_selection();
+    editor_multi_cursor_clear();
+    
+    EditorEditBatch batch = EditorEditBatch::replaceAll(g_editor.lines, find_text, replace_text);
+    if (batch.empty()) {
+        editor_set_status(("Not found: " + find_text).c_str());
+        return;
+    }
+    
+    EditorBatchResult result = editor_apply_batch(batch, "Replace all");
+    
+    // Keep the caret on a valid position of its (possibly shorter) line
+    g_editor.cursor_y = std::min(g_editor.cursor_y, (int)g_editor.lines.size() - 1);
+    g_editor.cursor_x = std::min(g_editor.cursor_x, (int)g_editor.lines[g_editor.cursor_y].length());
+    editor_scroll_if_needed();
+    editor_horizontal_scroll_if_needed();
+    
+    editor_set_status(("Replaced " + std::to_string(result.applied) + " occurrences").c_str());
+}
+
 // Go to line number (Ctrl+L)
 static void editor_goto_line() {
     std::string current_line_str = std::to_string(g_editor.cursor_y + 1);
@@ -3008,6 +3272,7 @@ extern "C" {
     void editor_mouse_drag(float x, float y);
     void editor_mouse_up(float x, float y);
     void editor_scroll_vertical(int lines);
+    void editor_scroll_horizontal(int columns);
     void input_system_get_viewport_size(float* width, float* height);
 }
 
@@ -3236,6 +3501,27 @@ void editor_scroll_vertical(int lines) {
     }
 }
 
+void editor_scroll_horizontal(int columns) {
+    if (!g_editor.active || columns == 0) {
+        return;
+    }
+    
+    int old_offset = g_editor.horizontal_offset;
+    
+    // Update horizontal offset
+    g_editor.horizontal_offset += columns;
+    
+    // Clamp to the longest line in the document (O(1) from the line index)
+    int max_offset = std::max(0, g_line_index.maxLineLength() - get_editor_width() + 1);
+    g_editor.horizontal_offset = std::max(0, std::min(g_editor.horizontal_offset, max_offset));
+    
+    if (g_editor.horizontal_offset != old_offset) {
+        g_ui_needs_redraw = true;
+        mark_all_dirty();
+        editor_update_buffer();
+    }
+}
+
 bool editor_is_loaded_from_database(void) {
     return g_editor.loaded_from_database;
 }
@@ -3314,6 +3600,7 @@ void editor_format_lua_code() {
                 g_editor.lines.push_back(line);
             }
             formatted_in.close();
+            editor_reindex_lines();
             
             // Mark as modified
             g_editor.modified = true;
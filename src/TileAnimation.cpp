@@ -0,0 +1,165 @@
+//
+//  TileAnimation.cpp
+//  SuperTerminal Framework - Animated Tiles
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "TileAnimation.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+TileAnimator::TileAnimator()
+    : m_slotForTile(REMAP_TABLE_SIZE, -1), m_remap(REMAP_TABLE_SIZE) {
+    for (size_t i = 0; i < REMAP_TABLE_SIZE; i++) {
+        m_remap[i] = (uint16_t)i;
+    }
+    m_nextChange = std::numeric_limits<double>::infinity();
+}
+
+// =============================================================================
+// Definitions
+// =============================================================================
+
+bool TileAnimator::define(uint16_t baseTile, const std::vector<uint16_t>& frames, float frameDuration) {
+    if (baseTile == 0 || baseTile > MAX_TILE_ID || frames.empty() || frames.size() > MAX_FRAMES) {
+        return false;
+    }
+    for (uint16_t frame : frames) {
+        if (frame == 0 || frame > MAX_TILE_ID) {
+            return false;
+        }
+    }
+
+    Animation* animation = find(baseTile);
+    if (!animation) {
+        m_slotForTile[baseTile] = (int32_t)m_animations.size();
+        m_animations.emplace_back();
+        animation = &m_animations.back();
+        animation->baseTile = baseTile;
+    }
+    animation->frames = frames;
+    animation->durations.assign(frames.size(), std::max(frameDuration, MIN_FRAME_DURATION));
+    animation->current = 0;
+    finishAnimation(*animation);
+
+    evaluate();
+    return true;
+}
+
+bool TileAnimator::setFrameDuration(uint16_t baseTile, size_t frameIndex, float seconds) {
+    Animation* animation = find(baseTile);
+    if (!animation || frameIndex >= animation->frames.size()) {
+        return false;
+    }
+    animation->durations[frameIndex] = std::max(seconds, MIN_FRAME_DURATION);
+    finishAnimation(*animation);
+
+    evaluate();
+    return true;
+}
+
+bool TileAnimator::remove(uint16_t baseTile) {
+    if (!find(baseTile)) {
+        return false;
+    }
+    size_t index = (size_t)m_slotForTile[baseTile];
+    if (index != m_animations.size() - 1) {
+        m_animations[index] = std::move(m_animations.back());
+        m_slotForTile[m_animations[index].baseTile] = (int32_t)index;
+    }
+    m_animations.pop_back();
+    m_slotForTile[baseTile] = -1;
+
+    if (m_remap[baseTile] != baseTile) {
+        m_remap[baseTile] = baseTile;
+        m_generation++;
+    }
+    evaluate();
+    return true;
+}
+
+void TileAnimator::clear() {
+    for (const Animation& animation : m_animations) {
+        m_slotForTile[animation.baseTile] = -1;
+        m_remap[animation.baseTile] = animation.baseTile;
+    }
+    if (!m_animations.empty()) {
+        m_generation++;
+    }
+    m_animations.clear();
+    m_nextChange = std::numeric_limits<double>::infinity();
+}
+
+bool TileAnimator::isAnimated(uint16_t baseTile) const {
+    return baseTile < REMAP_TABLE_SIZE && m_slotForTile[baseTile] >= 0;
+}
+
+TileAnimator::Animation* TileAnimator::find(uint16_t baseTile) {
+    if (baseTile >= REMAP_TABLE_SIZE || m_slotForTile[baseTile] < 0) {
+        return nullptr;
+    }
+    return &m_animations[(size_t)m_slotForTile[baseTile]];
+}
+
+void TileAnimator::finishAnimation(Animation& animation) {
+    animation.frameEnds.resize(animation.durations.size());
+    double end = 0.0;
+    for (size_t i = 0; i < animation.durations.size(); i++) {
+        end += animation.durations[i];
+        animation.frameEnds[i] = end;
+    }
+    animation.cycleDuration = end;
+}
+
+// =============================================================================
+// Clock
+// =============================================================================
+
+bool TileAnimator::update(double seconds) {
+    m_lastEvaluated = 0;
+    if (!m_hasClock) {
+        m_lastClock = seconds;
+        m_hasClock = true;
+    }
+    double delta = seconds - m_lastClock;
+    m_lastClock = seconds;
+    if (!m_paused && delta > 0.0) {
+        m_time += delta;
+    }
+
+    // Between frame boundaries no animation can have changed
+    if (m_time < m_nextChange) {
+        return false;
+    }
+    return evaluate();
+}
+
+bool TileAnimator::evaluate() {
+    bool changed = false;
+    double nextChange = std::numeric_limits<double>::infinity();
+
+    for (Animation& animation : m_animations) {
+        double phase = std::fmod(m_time, animation.cycleDuration);
+        size_t frame = (size_t)(std::upper_bound(animation.frameEnds.begin(), animation.frameEnds.end(), phase) -
+                                animation.frameEnds.begin());
+        frame = std::min(frame, animation.frames.size() - 1);
+        animation.current = (uint32_t)frame;
+        nextChange = std::min(nextChange, m_time - phase + animation.frameEnds[frame]);
+
+        uint16_t shown = animation.frames[frame];
+        if (m_remap[animation.baseTile] != shown) {
+            m_remap[animation.baseTile] = shown;
+            changed = true;
+        }
+    }
+
+    m_nextChange = nextChange;
+    m_lastEvaluated = m_animations.size();
+    if (changed) {
+        m_generation++;
+    }
+    return changed;
+}
@@ -0,0 +1,98 @@
+//
+//  TileAnimation.h
+//  SuperTerminal Framework - Animated Tiles
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+//  Animated tile types for the tile layers. An animation maps a base tile id
+//  to a sequence of atlas tiles with per-frame durations; the map keeps the
+//  base id and the renderer looks the displayed tile up in a remap table
+//  (one entry per tile id) that TileAnimator rebuilds from a global clock.
+//  Work per update is proportional to the number of animated tile types, and
+//  nothing at all happens between frame boundaries, however many cells of
+//  water or lava the map holds.
+//
+//  Every animation runs on the same clock, so all cells of a type stay in
+//  step. Frames are not resolved recursively: a frame that is itself an
+//  animated base tile shows as that tile's static image.
+//
+//  Not thread-safe; the tile layer serialises access.
+//
+
+#ifndef TileAnimation_h
+#define TileAnimation_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class TileAnimator {
+public:
+    static constexpr uint16_t MAX_TILE_ID = 256;       // Matches MAX_TILES in TileCommon.h
+    static constexpr size_t REMAP_TABLE_SIZE = MAX_TILE_ID + 1;
+    static constexpr size_t MAX_FRAMES = 256;
+    static constexpr float MIN_FRAME_DURATION = 0.001f;
+
+    TileAnimator();
+
+    // Replaces any animation on baseTile. Tile ids are 1..MAX_TILE_ID.
+    bool define(uint16_t baseTile, const std::vector<uint16_t>& frames, float frameDuration);
+    bool setFrameDuration(uint16_t baseTile, size_t frameIndex, float seconds);
+    bool remove(uint16_t baseTile);
+    void clear();
+
+    bool isAnimated(uint16_t baseTile) const;
+    size_t getCount() const { return m_animations.size(); }
+
+    // Advance to an absolute clock reading in seconds. Returns true if any
+    // displayed tile changed.
+    bool update(double seconds);
+
+    // A paused animator ignores clock time until resumed
+    void setPaused(bool paused) { m_paused = paused; }
+    bool isPaused() const { return m_paused; }
+    double getAnimationTime() const { return m_time; }
+
+    // Tile currently shown for a map cell holding tileId
+    uint16_t resolve(uint16_t tileId) const {
+        return tileId < REMAP_TABLE_SIZE ? m_remap[tileId] : tileId;
+    }
+
+    // REMAP_TABLE_SIZE entries, identity for static tiles
+    const uint16_t* getRemapTable() const { return m_remap.data(); }
+
+    // Changes whenever the remap table does, so renderers copy it only then
+    uint64_t getGeneration() const { return m_generation; }
+
+    // Animations evaluated by the last update() (0 between frame boundaries)
+    size_t getLastEvaluatedCount() const { return m_lastEvaluated; }
+
+private:
+    struct Animation {
+        uint16_t baseTile = 0;
+        std::vector<uint16_t> frames;
+        std::vector<float> durations;
+        std::vector<double> frameEnds;      // Cumulative, within one cycle
+        double cycleDuration = 0.0;
+        uint32_t current = 0;
+    };
+
+    std::vector<Animation> m_animations;
+    std::vector<int32_t> m_slotForTile;     // Tile id -> m_animations index, -1 if static
+    std::vector<uint16_t> m_remap;
+
+    double m_time = 0.0;                    // Animation clock; stops while paused
+    double m_lastClock = 0.0;
+    bool m_hasClock = false;
+    bool m_paused = false;
+    double m_nextChange = 0.0;              // Earliest frame boundary of any animation
+    uint64_t m_generation = 0;
+    size_t m_lastEvaluated = 0;
+
+    Animation* find(uint16_t baseTile);
+    static void finishAnimation(Animation& animation);
+    bool evaluate();
+};
+
+#endif /* TileAnimation_h */
@@ -61,6 +61,9 @@ public:
         tiles.resize(w * h, 0);
     }
     
+    // Row-major tile ids, width * height entries
+    const uint16_t* data() const { return tiles.data(); }
+
     uint16_t getTile(int x, int y) const {
         if (x < 0 || x >= width || y < 0 || y >= height) return 0;
         return tiles[y * width + x];
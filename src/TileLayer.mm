@@ -11,14 +11,31 @@
 #import <simd/simd.h>
 #import <ImageIO/ImageIO.h>
 #include "TileCommon.h"
+#include "TileAnimation.h"
+#include <chrono>
+#include <cstring>
 #include <iostream>
 #include <filesystem>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 // Simplified forward declarations
 extern "C" {
     bool tile_create_from_pixels_impl(uint16_t tileId, const uint8_t* pixels, int width, int height);
+    uint32_t superterminal_get_script_generation(void);
+}
+
+// Animated tile types, shared by both layers. Scripts define animations on
+// the script thread; each layer's render advances the animator from the
+// native clock and uploads the remap table only when a frame changed. Map
+// cells keep their base ids, so animation never rebuilds vertices.
+static TileAnimator g_tileAnimator;
+static std::mutex g_tileAnimatorMutex;
+
+static double tileAnimationClock() {
+    static const auto start = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 }
 
 @interface TileLayer : NSObject
@@ -27,6 +44,7 @@ extern "C" {
 @property (nonatomic, strong) id<MTLRenderPipelineState> pipelineState;
 @property (nonatomic, strong) id<MTLBuffer> vertexBuffer;
 @property (nonatomic, strong) id<MTLBuffer> uniformBuffer;
+@property (nonatomic, strong) id<MTLBuffer> remapBuffer;
 @property (nonatomic, strong) id<MTLTexture> tileAtlas;
 @property (nonatomic, strong) id<MTLSamplerState> samplerState;
 
@@ -38,6 +56,8 @@ extern "C" {
 
 @interface TileLayer() {
     std::unique_ptr<TileMap> _tileMap;
+    uint64_t _remapGeneration;      // Animator generation last copied to remapBuffer
+    uint32_t _scriptGeneration;     // Script run that last changed the map or viewport (0 = none)
 }
 
 - (instancetype)initWithDevice:(id<MTLDevice>)device;
@@ -57,6 +77,7 @@ extern "C" {
 - (void)setTileRegion:(int)startX y:(int)startY width:(int)width height:(int)height tileId:(uint16_t)tileId;
 - (void)centerViewport:(int)tileX y:(int)tileY;
 - (BOOL)isValidPosition:(int)x y:(int)y;
+- (BOOL)releaseGeneration:(uint32_t)generation;
 
 // Property getter for C interface
 - (TileMap*)getTileMapPtr;
@@ -114,6 +135,7 @@ extern "C" {
     // Release Metal resources
     self.vertexBuffer = nil;
     self.uniformBuffer = nil;
+    self.remapBuffer = nil;
     self.tileAtlas = nil;
     self.pipelineState = nil;
     self.samplerState = nil;
@@ -210,7 +232,8 @@ extern "C" {
     "\n"
     "vertex TileVertexOut tile_vertex(TileVertexIn in [[stage_in]],\n"
     "                                constant TileUniforms& uniforms [[buffer(1)]],\n"
-    "                                constant float2& viewportSize [[buffer(2)]]) {\n"
+    "                                constant float2& viewportSize [[buffer(2)]],\n"
+    "                                constant ushort* tileRemap [[buffer(3)]]) {\n"
     "    TileVertexOut out;\n"
     "    \n"
     "    // Convert world position to screen coordinates with sub-tile offset\n"
@@ -225,8 +248,14 @@ extern "C" {
     "    out.position.z = 0.0;\n"
     "    out.position.w = 1.0;\n"
     "    \n"
-    "    out.texCoord = in.texCoord;\n"
-    "    out.tileId = in.tileId;\n"
+    "    // Animated tiles: shift the UVs from the base tile's atlas cell to\n"
+    "    // the cell of the frame currently shown\n"
+    "    uint baseId = in.tileId;\n"
+    "    uint shownId = tileRemap[min(baseId, 256u)];\n"
+    "    float2 baseCell = float2((baseId - 1) % 16, (baseId - 1) / 16);\n"
+    "    float2 shownCell = float2((shownId - 1) % 16, (shownId - 1) / 16);\n"
+    "    out.texCoord = in.texCoord + (shownCell - baseCell) / 16.0;\n"
+    "    out.tileId = ushort(shownId);\n"
     "    \n"
     "    return out;\n"
     "}\n"
@@ -309,6 +338,16 @@ extern "C" {
                                                    options:MTLResourceStorageModeShared];
     self.uniformBuffer.label = @"Tile Uniforms";
 
+    // Tile id -> displayed tile, identity until an animation is defined
+    self.remapBuffer = [self.device newBufferWithLength:TileAnimator::REMAP_TABLE_SIZE * sizeof(uint16_t)
+                                                options:MTLResourceStorageModeShared];
+    self.remapBuffer.label = @"Tile Animation Remap";
+    uint16_t* remap = (uint16_t*)[self.remapBuffer contents];
+    for (size_t i = 0; i < TileAnimator::REMAP_TABLE_SIZE; i++) {
+        remap[i] = (uint16_t)i;
+    }
+    _remapGeneration = 0;
+
     NSLog(@"TileLayer: Vertex buffers created (max %d vertices)", VIEWPORT_WIDTH * VIEWPORT_HEIGHT * 6);
 }
 
@@ -454,6 +493,7 @@ extern "C" {
 }
 
 - (void)scroll:(float)dx dy:(float)dy {
+    _scriptGeneration = superterminal_get_script_generation();
     _viewport.offsetX += dx;
     _viewport.offsetY += dy;
 
@@ -493,6 +533,7 @@ extern "C" {
 
 - (void)setViewport:(int)x y:(int)y {
     if (_tileMap) {
+        _scriptGeneration = superterminal_get_script_generation();
         _viewport.x = std::max(0, std::min(x, _tileMap->width - VIEWPORT_WIDTH));
         _viewport.y = std::max(0, std::min(y, _tileMap->height - VIEWPORT_HEIGHT));
         _viewport.offsetX = 0.0f;
@@ -503,6 +544,7 @@ extern "C" {
 
 - (void)setTile:(int)mapX y:(int)mapY tileId:(uint16_t)tileId {
     if (_tileMap) {
+        _scriptGeneration = superterminal_get_script_generation();
         _tileMap->setTile(mapX, mapY, tileId);
 
         // Check if this tile is in current viewport
@@ -526,6 +568,7 @@ extern "C" {
     NSLog(@"TileLayer: Creating tile map %dx%d", width, height);
 
     _tileMap = std::make_unique<TileMap>(width, height);
+    _scriptGeneration = superterminal_get_script_generation();
 
     // Reset viewport to origin
     _viewport.x = 0;
@@ -545,6 +588,7 @@ extern "C" {
     NSLog(@"TileLayer: Resizing tile map from %dx%d to %dx%d", _tileMap->width, _tileMap->height, newWidth, newHeight);
 
     _tileMap->resize(newWidth, newHeight);
+    _scriptGeneration = superterminal_get_script_generation();
 
     // Adjust viewport to stay within bounds
     _viewport.x = std::max(0, std::min(_viewport.x, _tileMap->width - VIEWPORT_WIDTH));
@@ -572,6 +616,7 @@ extern "C" {
 
     NSLog(@"TileLayer: Filling tile map with tile %d", tileId);
     _tileMap->fill(tileId);
+    _scriptGeneration = superterminal_get_script_generation();
     self.needsUpdate = YES;
 }
 
@@ -590,6 +635,7 @@ extern "C" {
     NSLog(@"TileLayer: Setting region (%d,%d) to (%d,%d) with tile %d", startX, startY, endX, endY, tileId);
 
     bool needsViewportUpdate = false;
+    _scriptGeneration = superterminal_get_script_generation();
 
     for (int y = startY; y < endY; y++) {
         for (int x = startX; x < endX; x++) {
@@ -626,12 +672,25 @@ extern "C" {
     _viewport.y = newY;
     _viewport.offsetX = 0.0f;
     _viewport.offsetY = 0.0f;
+    _scriptGeneration = superterminal_get_script_generation();
 
     self.needsUpdate = YES;
 
     NSLog(@"TileLayer: Centered viewport on tile (%d,%d), viewport now at (%d,%d)", tileX, tileY, newX, newY);
 }
 
+// Clear the map and viewport if a run up to this generation changed them;
+// loaded tiles stay in the atlas for the next run
+- (BOOL)releaseGeneration:(uint32_t)generation {
+    if (_scriptGeneration == 0 || _scriptGeneration > generation) {
+        return NO;
+    }
+    [self clearTileMap];
+    [self setViewport:0 y:0];
+    _scriptGeneration = 0;
+    return YES;
+}
+
 - (BOOL)isValidPosition:(int)x y:(int)y {
     if (!_tileMap) {
         return NO;
@@ -727,7 +786,7 @@ extern "C" {
 }
 
 - (void)renderWithEncoder:(id<MTLRenderCommandEncoder>)encoder viewport:(CGSize)viewportSize {
-    if (!self.pipelineState || !self.vertexBuffer || !self.tileAtlas) {
+    if (!self.pipelineState || !self.vertexBuffer || !self.remapBuffer || !self.tileAtlas) {
         return;
     }
 
@@ -756,6 +815,18 @@ extern "C" {
     [encoder setVertexBuffer:self.uniformBuffer offset:0 atIndex:1];
     [encoder setVertexBuffer:self.uniformBuffer offset:sizeof(TileUniforms) atIndex:2];
 
+    // Advance tile animations; the table is copied only when a frame changed
+    {
+        std::lock_guard<std::mutex> lock(g_tileAnimatorMutex);
+        g_tileAnimator.update(tileAnimationClock());
+        if (_remapGeneration != g_tileAnimator.getGeneration()) {
+            memcpy([self.remapBuffer contents], g_tileAnimator.getRemapTable(),
+                   TileAnimator::REMAP_TABLE_SIZE * sizeof(uint16_t));
+            _remapGeneration = g_tileAnimator.getGeneration();
+        }
+    }
+    [encoder setVertexBuffer:self.remapBuffer offset:0 atIndex:3];
+
     [encoder setFragmentTexture:self.tileAtlas atIndex:0];
     [encoder setFragmentSamplerState:self.samplerState atIndex:0];
 
@@ -806,6 +877,19 @@ extern "C" {
         }
     }
 
+    int tile_layers_release_generation(uint32_t generation) {
+        @autoreleasepool {
+            int released = 0;
+            if (g_tileLayer1 && [g_tileLayer1 releaseGeneration:generation]) {
+                released++;
+            }
+            if (g_tileLayer2 && [g_tileLayer2 releaseGeneration:generation]) {
+                released++;
+            }
+            return released;
+        }
+    }
+
     void tile_layers_cleanup() {
         @autoreleasepool {
             g_tileLayer1 = nil;
@@ -925,6 +1009,21 @@ extern "C" {
         }
     }
 
+    // Read-only map view for particle collision; valid until the map is
+    // recreated or resized
+    bool tile_layer_get_collision_grid(int layer, const uint16_t** tiles, int* width, int* height, float* tileSize) {
+        TileLayer* tileLayer = (layer == 1) ? g_tileLayer1 : g_tileLayer2;
+        TileMap* tileMap = tileLayer ? [tileLayer getTileMapPtr] : nullptr;
+        if (!tileMap || !tiles || !width || !height || !tileSize) {
+            return false;
+        }
+        *tiles = tileMap->data();
+        *width = tileMap->width;
+        *height = tileMap->height;
+        *tileSize = TILE_SIZE;
+        return true;
+    }
+
     void tile_world_to_screen(int layer, float worldX, float worldY, float* screenX, float* screenY) {
         @autoreleasepool {
             TileLayer* tileLayer = (layer == 1) ? g_tileLayer1 : g_tileLayer2;
@@ -969,6 +1068,11 @@ extern "C" {
         @autoreleasepool {
             NSLog(@"TileLayer: tiles_clear() - Performing comprehensive cleanup");
 
+            {
+                std::lock_guard<std::mutex> lock(g_tileAnimatorMutex);
+                g_tileAnimator.clear();
+            }
+
             // Clear and reinitialize both layers (preserves objects but clears data)
             if (g_tileLayer1) {
                 [g_tileLayer1 clearAndReinitialize];
@@ -988,6 +1092,11 @@ extern "C" {
         @autoreleasepool {
             NSLog(@"TileLayer: tiles_shutdown() - Complete system shutdown");
 
+            {
+                std::lock_guard<std::mutex> lock(g_tileAnimatorMutex);
+                g_tileAnimator.clear();
+            }
+
             // Full shutdown and deallocation
             if (g_tileLayer1) {
                 [g_tileLayer1 shutdownTileLayer];
@@ -1057,4 +1166,50 @@ extern "C" {
             return false;
         }
     }
+
+    // Animated tiles
+
+    bool tile_animation_define_impl(uint16_t baseTile, const uint16_t* frames, int frameCount, float frameDuration) {
+        if (!frames || frameCount <= 0) {
+            return false;
+        }
+        std::vector<uint16_t> sequence(frames, frames + frameCount);
+        std::lock_guard<std::mutex> lock(g_tileAnimatorMutex);
+        bool defined = g_tileAnimator.define(baseTile, sequence, frameDuration);
+        if (!defined) {
+            NSLog(@"TileLayer: Invalid animation for tile %d (%d frames, ids must be 1-%d)",
+                  baseTile, frameCount, MAX_TILES);
+        }
+        return defined;
+    }
+
+    bool tile_animation_set_frame_duration_impl(uint16_t baseTile, int frameIndex, float seconds) {
+        if (frameIndex < 0) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(g_tileAnimatorMutex);
+        return g_tileAnimator.setFrameDuration(baseTile, (size_t)frameIndex, seconds);
+    }
+
+    bool tile_animation_remove_impl(uint16_t baseTile) {
+        std::lock_guard<std::mutex> lock(g_tileAnimatorMutex);
+        return g_tileAnimator.remove(baseTile);
+    }
+
+    void tile_animation_clear_impl() {
+        std::lock_guard<std::mutex> lock(g_tileAnimatorMutex);
+        g_tileAnimator.clear();
+    }
+
+    void tile_animation_set_paused_impl(bool paused) {
+        std::lock_guard<std::mutex> lock(g_tileAnimatorMutex);
+        g_tileAnimator.update(tileAnimationClock());    // Bank time up to now first
+        g_tileAnimator.setPaused(paused);
+    }
+
+    uint16_t tile_animation_get_frame_impl(uint16_t tileId) {
+        std::lock_guard<std::mutex> lock(g_tileAnimatorMutex);
+        g_tileAnimator.update(tileAnimationClock());
+        return g_tileAnimator.resolve(tileId);
+    }
 }
@@ -0,0 +1,285 @@
+//
+//  TraceEvents.cpp
+//  SuperTerminal Framework - Scoped Trace Events
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "TraceEvents.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+namespace {
+
+std::atomic<uint64_t> g_nextRecorderId{1};
+
+// Last buffer this thread used, tagged with its recorder's id so a recorder
+// created later at the same address never sees a stale entry
+struct ThreadCache {
+    uint64_t recorderId = 0;
+    void* buffer = nullptr;
+};
+thread_local ThreadCache t_cache;
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+void appendEscaped(std::string& out, const char* text) {
+    for (const char* c = text ? text : ""; *c; c++) {
+        switch (*c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if ((unsigned char)*c < 0x20) {
+                    char code[8];
+                    snprintf(code, sizeof(code), "\\u%04x", (unsigned char)*c);
+                    out += code;
+                } else {
+                    out += *c;
+                }
+                break;
+        }
+    }
+}
+
+} // namespace
+
+TraceRecorder::TraceRecorder(size_t eventsPerThread)
+    : m_id(g_nextRecorderId.fetch_add(1)),
+      m_mask(roundUpToPowerOfTwo(std::max<size_t>(eventsPerThread, 2)) - 1),
+      m_epoch(now()) {
+}
+
+TraceRecorder::~TraceRecorder() = default;
+
+TraceRecorder& TraceRecorder::instance() {
+    // Never destroyed: audio threads may still record during static teardown
+    static TraceRecorder* recorder = new TraceRecorder();
+    return *recorder;
+}
+
+uint64_t TraceRecorder::now() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// =============================================================================
+// Recording
+// =============================================================================
+
+TraceRecorder::ThreadBuffer& TraceRecorder::threadBuffer() {
+    if (t_cache.recorderId == m_id) {
+        return *static_cast<ThreadBuffer*>(t_cache.buffer);
+    }
+
+    std::lock_guard<std::mutex> lock(m_buffersMutex);
+    std::thread::id self = std::this_thread::get_id();
+    ThreadBuffer* buffer = nullptr;
+    for (const auto& existing : m_buffers) {
+        if (existing->owner == self) {
+            buffer = existing.get();
+            break;
+        }
+    }
+    if (!buffer) {
+        m_buffers.push_back(std::make_unique<ThreadBuffer>(m_mask + 1));
+        buffer = m_buffers.back().get();
+        buffer->owner = self;
+        buffer->threadId = (uint32_t)m_buffers.size();
+    }
+    t_cache.recorderId = m_id;
+    t_cache.buffer = buffer;
+    return *buffer;
+}
+
+void TraceRecorder::record(char phase, const char* category, const char* name,
+                           uint64_t start, uint64_t duration, double value) {
+    ThreadBuffer& buffer = threadBuffer();
+    uint64_t index = buffer.head.load(std::memory_order_relaxed);
+    Slot& slot = buffer.slots[index & m_mask];
+
+    // Seqlock write: odd stamp, fields, even stamp
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.category.store(category, std::memory_order_relaxed);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start.store(start, std::memory_order_relaxed);
+    slot.duration.store(duration, std::memory_order_relaxed);
+    slot.value.store(value, std::memory_order_relaxed);
+    slot.phase.store(phase, std::memory_order_relaxed);
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+
+    buffer.head.store(index + 1, std::memory_order_release);
+}
+
+void TraceRecorder::complete(const char* category, const char* name, uint64_t start, uint64_t end) {
+    if (!isEnabled()) {
+        return;
+    }
+    record('X', category, name, start, end > start ? end - start : 0, 0.0);
+}
+
+void TraceRecorder::instant(const char* category, const char* name) {
+    if (!isEnabled()) {
+        return;
+    }
+    record('i', category, name, now(), 0, 0.0);
+}
+
+void TraceRecorder::counter(const char* category, const char* name, double value) {
+    if (!isEnabled()) {
+        return;
+    }
+    record('C', category, name, now(), 0, value);
+}
+
+void TraceRecorder::setThreadName(const char* name) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(m_buffersMutex);
+    buffer.threadName = name ? name : "";
+}
+
+void TraceRecorder::clear() {
+    std::lock_guard<std::mutex> lock(m_buffersMutex);
+    for (const auto& buffer : m_buffers) {
+        buffer->clearedAt.store(buffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+// =============================================================================
+// Reading
+// =============================================================================
+
+void TraceRecorder::collect(const ThreadBuffer& buffer, std::vector<Event>& out) const {
+    const uint64_t head = buffer.head.load(std::memory_order_acquire);
+    const uint64_t capacity = m_mask + 1;
+    uint64_t first = std::max(buffer.clearedAt.load(std::memory_order_relaxed),
+                              head > capacity ? head - capacity : 0);
+
+    for (uint64_t index = first; index < head; index++) {
+        const Slot& slot = buffer.slots[index & m_mask];
+        uint64_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before != 2 * index + 2) {
+            continue;       // Overwritten by a newer event, or mid-write
+        }
+        Event event;
+        event.category = slot.category.load(std::memory_order_relaxed);
+        event.name = slot.name.load(std::memory_order_relaxed);
+        event.start = slot.start.load(std::memory_order_relaxed);
+        event.duration = slot.duration.load(std::memory_order_relaxed);
+        event.value = slot.value.load(std::memory_order_relaxed);
+        event.phase = slot.phase.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != before) {
+            continue;
+        }
+        out.push_back(event);
+    }
+}
+
+size_t TraceRecorder::getEventCount() const {
+    std::lock_guard<std::mutex> lock(m_buffersMutex);
+    size_t count = 0;
+    for (const auto& buffer : m_buffers) {
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t held = head - std::min(head, buffer->clearedAt.load(std::memory_order_relaxed));
+        count += (size_t)std::min<uint64_t>(held, m_mask + 1);
+    }
+    return count;
+}
+
+uint64_t TraceRecorder::getOverwrittenCount() const {
+    std::lock_guard<std::mutex> lock(m_buffersMutex);
+    uint64_t overwritten = 0;
+    for (const auto& buffer : m_buffers) {
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t held = head - std::min(head, buffer->clearedAt.load(std::memory_order_relaxed));
+        if (held > m_mask + 1) {
+            overwritten += held - (m_mask + 1);
+        }
+    }
+    return overwritten;
+}
+
+size_t TraceRecorder::getThreadCount() const {
+    std::lock_guard<std::mutex> lock(m_buffersMutex);
+    return m_buffers.size();
+}
+
+std::string TraceRecorder::toJSON() const {
+    std::lock_guard<std::mutex> lock(m_buffersMutex);
+
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    std::vector<Event> events;
+    char number[64];
+
+    for (const auto& buffer : m_buffers) {
+        if (!buffer->threadName.empty()) {
+            json += first ? "\n" : ",\n";
+            first = false;
+            snprintf(number, sizeof(number), "%u", buffer->threadId);
+            json += "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":";
+            json += number;
+            json += ",\"args\":{\"name\":\"";
+            appendEscaped(json, buffer->threadName.c_str());
+            json += "\"}}";
+        }
+
+        events.clear();
+        collect(*buffer, events);
+        for (const Event& event : events) {
+            json += first ? "\n" : ",\n";
+            first = false;
+            json += "{\"ph\":\"";
+            json += event.phase;
+            json += "\",\"cat\":\"";
+            appendEscaped(json, event.category);
+            json += "\",\"name\":\"";
+            appendEscaped(json, event.name);
+            // Microseconds from the recorder's creation
+            double start = event.start >= m_epoch ? (event.start - m_epoch) / 1000.0 : 0.0;
+            snprintf(number, sizeof(number), "\",\"pid\":1,\"tid\":%u,\"ts\":%.3f", buffer->threadId, start);
+            json += number;
+            switch (event.phase) {
+                case 'X':
+                    snprintf(number, sizeof(number), ",\"dur\":%.3f", event.duration / 1000.0);
+                    json += number;
+                    break;
+                case 'C':
+                    snprintf(number, sizeof(number), ",\"args\":{\"value\":%.6g}", event.value);
+                    json += number;
+                    break;
+                case 'i':
+                    json += ",\"s\":\"t\"";
+                    break;
+                default:
+                    break;
+            }
+            json += "}";
+        }
+    }
+
+    json += "\n]}\n";
+    return json;
+}
+
+bool TraceRecorder::writeJSON(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    std::string json = toJSON();
+    file.write(json.data(), (std::streamsize)json.size());
+    return (bool)file;
+}
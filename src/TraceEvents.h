@@ -0,0 +1,179 @@
+//
+//  TraceEvents.h
+//  SuperTerminal Framework - Scoped Trace Events
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+//  Low-overhead timeline tracing for the threads a frame profiler can't see:
+//  synth generation, the v2 audio graph, the command rings, the music timing
+//  thread and the Lua queue. Code marks work with TRACE_SCOPE (a timed slice),
+//  TRACE_INSTANT and TRACE_COUNTER; writeJSON() dumps everything recorded as
+//  Chrome trace-event JSON for chrome://tracing or Perfetto.
+//
+//  Each thread records into its own ring of events, so recording takes no
+//  lock: a slot write plus two clock reads for a scope. When a ring wraps the
+//  oldest events are overwritten. Slots are sequence-stamped, so a dump taken
+//  while threads are still recording skips any slot caught mid-write instead
+//  of reading a torn event. Tracing starts disabled; while disabled a marker
+//  costs one relaxed load. Building with SUPERTERMINAL_TRACING=0 removes the
+//  markers entirely.
+//
+//  Event names and categories are stored by pointer and must be string
+//  literals (or otherwise outlive the recorder).
+//
+
+#ifndef TraceEvents_h
+#define TraceEvents_h
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef SUPERTERMINAL_TRACING
+#define SUPERTERMINAL_TRACING 1
+#endif
+
+class TraceRecorder {
+public:
+    static constexpr size_t DEFAULT_EVENTS_PER_THREAD = 16384;
+
+    // Capacity per thread is rounded up to a power of two
+    explicit TraceRecorder(size_t eventsPerThread = DEFAULT_EVENTS_PER_THREAD);
+    ~TraceRecorder();
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    // The process-wide recorder the TRACE_* macros write to
+    static TraceRecorder& instance();
+
+    // Monotonic nanoseconds
+    static uint64_t now();
+
+    void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    // Any thread. Dropped silently while disabled.
+    void complete(const char* category, const char* name, uint64_t start, uint64_t end);
+    void instant(const char* category, const char* name);
+    void counter(const char* category, const char* name, double value);
+
+    // Label the calling thread in the dump
+    void setThreadName(const char* name);
+
+    // Forget everything recorded so far. Safe while other threads record.
+    void clear();
+
+    // Events currently held across all threads
+    size_t getEventCount() const;
+    // Events lost to ring wrap-around since the last clear()
+    uint64_t getOverwrittenCount() const;
+    size_t getThreadCount() const;
+
+    std::string toJSON() const;
+    bool writeJSON(const std::string& path) const;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};      // 2n+1 while writing event n, 2n+2 when done
+        std::atomic<const char*> category{nullptr};
+        std::atomic<const char*> name{nullptr};
+        std::atomic<uint64_t> start{0};
+        std::atomic<uint64_t> duration{0};
+        std::atomic<double> value{0.0};
+        std::atomic<char> phase{0};
+    };
+
+    struct ThreadBuffer {
+        explicit ThreadBuffer(size_t capacity) : slots(capacity) {}
+
+        std::vector<Slot> slots;
+        std::atomic<uint64_t> head{0};          // Events ever written; owner thread only
+        std::atomic<uint64_t> clearedAt{0};     // Events before this are forgotten
+        std::thread::id owner;
+        uint32_t threadId = 0;                  // Small sequential id for the dump
+        std::string threadName;                 // Guarded by m_buffersMutex
+    };
+
+    struct Event {
+        const char* category;
+        const char* name;
+        uint64_t start;
+        uint64_t duration;
+        double value;
+        char phase;
+    };
+
+    const uint64_t m_id;                        // Tells recorders apart in the thread-local cache
+    const size_t m_mask;
+    const uint64_t m_epoch;
+    std::atomic<bool> m_enabled{false};
+
+    mutable std::mutex m_buffersMutex;          // Taken once per thread, and by dumps
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+
+    ThreadBuffer& threadBuffer();
+    void record(char phase, const char* category, const char* name,
+                uint64_t start, uint64_t duration, double value);
+    void collect(const ThreadBuffer& buffer, std::vector<Event>& out) const;
+};
+
+// Times the enclosing block as a complete ("X") event
+class TraceScope {
+public:
+    TraceScope(const char* category, const char* name)
+        : m_category(category), m_name(name),
+          m_start(TraceRecorder::instance().isEnabled() ? TraceRecorder::now() : 0) {}
+    ~TraceScope() {
+        if (m_start != 0) {
+            TraceRecorder::instance().complete(m_category, m_name, m_start, TraceRecorder::now());
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_category;
+    const char* m_name;
+    uint64_t m_start;
+};
+
+#if SUPERTERMINAL_TRACING
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#define TRACE_ENABLED() TraceRecorder::instance().isEnabled()
+#define TRACE_NOW() TraceRecorder::now()
+#define TRACE_SCOPE(category, name) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(category, name)
+#define TRACE_COMPLETE(category, name, start, end) \
+    TraceRecorder::instance().complete(category, name, start, end)
+#define TRACE_INSTANT(category, name) TraceRecorder::instance().instant(category, name)
+#define TRACE_COUNTER(category, name, value) \
+    do { \
+        if (TRACE_ENABLED()) { \
+            TraceRecorder::instance().counter(category, name, (double)(value)); \
+        } \
+    } while (0)
+#define TRACE_THREAD_NAME(name) TraceRecorder::instance().setThreadName(name)
+
+#else
+
+#define TRACE_ENABLED() false
+#define TRACE_NOW() ((uint64_t)0)
+#define TRACE_SCOPE(category, name) do {} while (0)
+#define TRACE_COMPLETE(category, name, start, end) do {} while (0)
+#define TRACE_INSTANT(category, name) do {} while (0)
+#define TRACE_COUNTER(category, name, value) do {} while (0)
+#define TRACE_THREAD_NAME(name) do {} while (0)
+
+#endif
+
+#endif /* TraceEvents_h */
@@ -51,6 +51,17 @@ BEGIN
 END;
 )";
 
+static const char* INSERT_ASSET_SQL = R"(
+    INSERT INTO assets (name, kind, format, width, height, duration, length, i, j, k, data, tags, description, checksum, version, author, compressed)
+    VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+)";
+
+static const char* SELECT_ASSET_BY_NAME_SQL = R"(
+    SELECT id, name, kind, format, width, height, duration, length, i, j, k, data, tags, description, checksum,
+           version, author, compressed, strftime('%s', created_at), strftime('%s', updated_at)
+    FROM assets WHERE name = ?
+)";
+
 // Constructor
 AssetDatabase::AssetDatabase() = default;
 
@@ -184,36 +195,14 @@ DatabaseResult<int64_t> AssetDatabase::addAsset(const AssetMetadata& metadata) {
         return DatabaseResult<int64_t>(AssetDatabaseError::ALREADY_EXISTS, "Asset with this name already exists");
     }
     
-    const char* sql = R"(
-        INSERT INTO assets (name, kind, format, width, height, duration, length, i, j, k, data, tags, description, checksum, version, author, compressed)
-        VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
-    )";
-    
     sqlite3_stmt* stmt = nullptr;
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
+    int rc = sqlite3_prepare_v2(db, INSERT_ASSET_SQL, -1, &stmt, nullptr);
     
     if (rc != SQLITE_OK) {
         return DatabaseResult<int64_t>(AssetDatabaseError::INSERT_FAILED, sqlite3_errmsg(db));
     }
     
-    // Bind parameters
-    sqlite3_bind_text(stmt, 1, metadata.name.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 2, assetKindToString(metadata.kind), -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 3, assetFormatToString(metadata.format), -1, SQLITE_STATIC);
-    sqlite3_bind_int(stmt, 4, metadata.width);
-    sqlite3_bind_int(stmt, 5, metadata.height);
-    sqlite3_bind_double(stmt, 6, metadata.duration);
-    sqlite3_bind_int(stmt, 7, metadata.length);
-    sqlite3_bind_int(stmt, 8, metadata.i);
-    sqlite3_bind_int(stmt, 9, metadata.j);
-    sqlite3_bind_int(stmt, 10, metadata.k);
-    sqlite3_bind_blob(stmt, 11, metadata.data.data(), metadata.data.size(), SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 12, metadata.getTagsString().c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 13, metadata.description.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 14, metadata.checksum.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 15, metadata.version.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 16, metadata.author.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_int(stmt, 17, metadata.compressed ? 1 : 0);
+    bindMetadata(stmt, metadata);
     
     rc = sqlite3_step(stmt);
     sqlite3_finalize(stmt);
@@ -265,14 +254,8 @@ DatabaseResult<AssetMetadata> AssetDatabase::getAssetByName(const std::string& n
         return DatabaseResult<AssetMetadata>(AssetDatabaseError::QUERY_FAILED, "Database not open");
     }
     
-    const char* sql = R"(
-        SELECT id, name, kind, format, width, height, duration, length, i, j, k, data, tags, description, checksum,
-               version, author, compressed, strftime('%s', created_at), strftime('%s', updated_at)
-        FROM assets WHERE name = ?
-    )";
-    
     sqlite3_stmt* stmt = nullptr;
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
+    int rc = sqlite3_prepare_v2(db, SELECT_ASSET_BY_NAME_SQL, -1, &stmt, nullptr);
     
     if (rc != SQLITE_OK) {
         return DatabaseResult<AssetMetadata>(AssetDatabaseError::QUERY_FAILED, sqlite3_errmsg(db));
@@ -714,6 +697,125 @@ DatabaseResult<void> AssetDatabase::rollbackTransaction() {
     return DatabaseResult<void>(true);
 }
 
+// Add several assets atomically
+DatabaseResult<std::vector<int64_t>> AssetDatabase::addAssets(const std::vector<AssetMetadata>& assets) {
+    using Result = DatabaseResult<std::vector<int64_t>>;
+    
+    if (!db) {
+        return Result(AssetDatabaseError::QUERY_FAILED, "Database not open");
+    }
+    
+    if (readOnly) {
+        return Result(AssetDatabaseError::READONLY, "Database is read-only");
+    }
+    
+    for (const auto& metadata : assets) {
+        if (!metadata.isValid()) {
+            return Result(AssetDatabaseError::INVALID_DATA, "Invalid asset metadata: '" + metadata.name + "'");
+        }
+    }
+    
+    // A savepoint rather than BEGIN, so this also nests inside a caller's transaction
+    if (sqlite3_exec(db, "SAVEPOINT add_assets", nullptr, nullptr, nullptr) != SQLITE_OK) {
+        return Result(AssetDatabaseError::INSERT_FAILED, sqlite3_errmsg(db));
+    }
+    
+    sqlite3_stmt* stmt = nullptr;
+    int rc = sqlite3_prepare_v2(db, INSERT_ASSET_SQL, -1, &stmt, nullptr);
+    
+    Result result;
+    if (rc != SQLITE_OK) {
+        result = Result(AssetDatabaseError::INSERT_FAILED, sqlite3_errmsg(db));
+    } else {
+        std::vector<int64_t> ids;
+        ids.reserve(assets.size());
+        
+        for (const auto& metadata : assets) {
+            bindMetadata(stmt, metadata);
+            rc = sqlite3_step(stmt);
+            if (rc != SQLITE_DONE) {
+                // The UNIQUE constraint on name also catches duplicates within the batch
+                if (sqlite3_extended_errcode(db) == SQLITE_CONSTRAINT_UNIQUE) {
+                    result = Result(AssetDatabaseError::ALREADY_EXISTS,
+                                    "Asset with this name already exists: '" + metadata.name + "'");
+                } else {
+                    result = Result(AssetDatabaseError::INSERT_FAILED, sqlite3_errmsg(db));
+                }
+                break;
+            }
+            ids.push_back(sqlite3_last_insert_rowid(db));
+            sqlite3_reset(stmt);
+            sqlite3_clear_bindings(stmt);
+        }
+        
+        if (ids.size() == assets.size()) {
+            result = Result(ids);
+        }
+    }
+    sqlite3_finalize(stmt);
+    
+    if (!result) {
+        sqlite3_exec(db, "ROLLBACK TO add_assets", nullptr, nullptr, nullptr);
+        sqlite3_exec(db, "RELEASE add_assets", nullptr, nullptr, nullptr);
+        return result;
+    }
+    
+    if (sqlite3_exec(db, "RELEASE add_assets", nullptr, nullptr, nullptr) != SQLITE_OK) {
+        std::string error = sqlite3_errmsg(db);
+        sqlite3_exec(db, "ROLLBACK TO add_assets", nullptr, nullptr, nullptr);
+        sqlite3_exec(db, "RELEASE add_assets", nullptr, nullptr, nullptr);
+        return Result(AssetDatabaseError::INSERT_FAILED, error);
+    }
+    
+    return result;
+}
+
+// Get several assets by name
+DatabaseResult<std::vector<AssetMetadata>> AssetDatabase::getAssetsByName(const std::vector<std::string>& names) const {
+    using Result = DatabaseResult<std::vector<AssetMetadata>>;
+    
+    if (!db) {
+        return Result(AssetDatabaseError::QUERY_FAILED, "Database not open");
+    }
+    
+    // One read transaction: the file lock is taken once, not per name
+    if (sqlite3_exec(db, "SAVEPOINT get_assets", nullptr, nullptr, nullptr) != SQLITE_OK) {
+        return Result(AssetDatabaseError::QUERY_FAILED, sqlite3_errmsg(db));
+    }
+    
+    sqlite3_stmt* stmt = nullptr;
+    int rc = sqlite3_prepare_v2(db, SELECT_ASSET_BY_NAME_SQL, -1, &stmt, nullptr);
+    
+    if (rc != SQLITE_OK) {
+        std::string error = sqlite3_errmsg(db);
+        sqlite3_exec(db, "RELEASE get_assets", nullptr, nullptr, nullptr);
+        return Result(AssetDatabaseError::QUERY_FAILED, error);
+    }
+    
+    std::vector<AssetMetadata> assets(names.size());
+    bool failed = false;
+    for (size_t i = 0; i < names.size() && !failed; i++) {
+        sqlite3_bind_text(stmt, 1, names[i].c_str(), -1, SQLITE_TRANSIENT);
+        rc = sqlite3_step(stmt);
+        if (rc == SQLITE_ROW) {
+            assets[i] = readMetadata(stmt);
+        } else {
+            failed = (rc != SQLITE_DONE);
+        }
+        sqlite3_reset(stmt);
+    }
+    sqlite3_finalize(stmt);
+    
+    if (failed) {
+        std::string error = sqlite3_errmsg(db);
+        sqlite3_exec(db, "RELEASE get_assets", nullptr, nullptr, nullptr);
+        return Result(AssetDatabaseError::QUERY_FAILED, error);
+    }
+    
+    sqlite3_exec(db, "RELEASE get_assets", nullptr, nullptr, nullptr);
+    return Result(assets);
+}
+
 // Vacuum database
 DatabaseResult<void> AssetDatabase::vacuum() {
     if (!db) {
@@ -757,6 +859,27 @@ void AssetDatabase::Transaction::rollback() {
     }
 }
 
+// Helper: Bind metadata to the INSERT statement's parameters
+void AssetDatabase::bindMetadata(sqlite3_stmt* stmt, const AssetMetadata& metadata) const {
+    sqlite3_bind_text(stmt, 1, metadata.name.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 2, assetKindToString(metadata.kind), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 3, assetFormatToString(metadata.format), -1, SQLITE_STATIC);
+    sqlite3_bind_int(stmt, 4, metadata.width);
+    sqlite3_bind_int(stmt, 5, metadata.height);
+    sqlite3_bind_double(stmt, 6, metadata.duration);
+    sqlite3_bind_int(stmt, 7, metadata.length);
+    sqlite3_bind_int(stmt, 8, metadata.i);
+    sqlite3_bind_int(stmt, 9, metadata.j);
+    sqlite3_bind_int(stmt, 10, metadata.k);
+    sqlite3_bind_blob(stmt, 11, metadata.data.data(), metadata.data.size(), SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 12, metadata.getTagsString().c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 13, metadata.description.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 14, metadata.checksum.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 15, metadata.version.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 16, metadata.author.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt, 17, metadata.compressed ? 1 : 0);
+}
+
 // Helper: Read metadata from statement
 AssetMetadata AssetDatabase::readMetadata(sqlite3_stmt* stmt) const {
     AssetMetadata meta;
@@ -193,6 +193,16 @@ public:
     
     // === BATCH OPERATIONS ===
     
+    // Add several assets in one transaction with one prepared statement.
+    // All or nothing: on any failure (e.g. a duplicate name) none are added.
+    // Returns the new IDs in input order.
+    DatabaseResult<std::vector<int64_t>> addAssets(const std::vector<AssetMetadata>& assets);
+    
+    // Get several assets by name in one read transaction with one prepared
+    // statement. Results are parallel to names; a name with no asset gets
+    // default metadata (id 0).
+    DatabaseResult<std::vector<AssetMetadata>> getAssetsByName(const std::vector<std::string>& names) const;
+    
     // Delete all assets (use with caution!)
     DatabaseResult<void> deleteAllAssets();
     
@@ -9,6 +9,7 @@
 //
 
 #include "AssetsManager.h"
+#include "HotReload.h"
 #include "../audio/AudioDaemonIntegration.h"
 #include <iostream>
 #include <fstream>
@@ -51,6 +52,46 @@ static bool readFile(const std::string& filename, std::vector<uint8_t>& data) {
     return true;
 }
 
+// Helper: Read an array of asset names from the table at index
+static std::vector<std::string> checkNameArray(lua_State* L, int index, const char* function) {
+    luaL_checktype(L, index, LUA_TTABLE);
+    
+    std::vector<std::string> names;
+    int count = (int)lua_objlen(L, index);
+    names.reserve(count);
+    for (int i = 1; i <= count; i++) {
+        lua_rawgeti(L, index, i);
+        if (!lua_isstring(L, -1)) {
+            luaL_error(L, "%s() expects an array of asset names (entry %d is not a string)", function, i);
+        }
+        names.push_back(lua_tostring(L, -1));
+        lua_pop(L, 1);
+    }
+    
+    return names;
+}
+
+// Helper: Push the info table returned by asset_get_sound_info
+static void pushSoundInfo(lua_State* L, const SuperTerminal::AssetMetadata& metadata) {
+    lua_newtable(L);
+    
+    lua_pushstring(L, "name");
+    lua_pushstring(L, metadata.name.c_str());
+    lua_settable(L, -3);
+    
+    lua_pushstring(L, "description");
+    lua_pushstring(L, metadata.description.c_str());
+    lua_settable(L, -3);
+    
+    lua_pushstring(L, "size");
+    lua_pushinteger(L, metadata.data.size());
+    lua_settable(L, -3);
+    
+    lua_pushstring(L, "compressed");
+    lua_pushboolean(L, metadata.compressed);
+    lua_settable(L, -3);
+}
+
 // asset_save_sound(wav_filename, asset_name, [description])
 // Saves a WAV file to the asset database
 static int lua_asset_save_sound(lua_State* L) {
@@ -230,24 +271,137 @@ static int lua_asset_get_sound_info(lua_State* L) {
         return 1;
     }
     
-    // Create info table
+    pushSoundInfo(L, metadata);
+    return 1;
+}
+
+// success, [error] = asset_save_sounds({{file = wav_filename, name = asset_name, [description = text]}, ...})
+// Saves several WAV files in one database transaction; if any fails, none are saved
+static int lua_asset_save_sounds(lua_State* L) {
+    if (lua_gettop(L) != 1) {
+        return luaL_error(L, "asset_save_sounds() expects 1 argument: array of {file, name, [description]}");
+    }
+    luaL_checktype(L, 1, LUA_TTABLE);
+    
+    auto assetMgr = getAssetsManager();
+    if (!assetMgr) {
+        lua_pushboolean(L, false);
+        lua_pushstring(L, "AssetsManager not available");
+        return 2;
+    }
+    
+    std::vector<SuperTerminal::AssetMetadata> assets;
+    size_t total_bytes = 0;
+    int count = (int)lua_objlen(L, 1);
+    assets.reserve(count);
+    
+    for (int i = 1; i <= count; i++) {
+        lua_rawgeti(L, 1, i);
+        if (!lua_istable(L, -1)) {
+            return luaL_error(L, "asset_save_sounds() entry %d is not a table", i);
+        }
+        lua_getfield(L, -1, "file");
+        lua_getfield(L, -2, "name");
+        lua_getfield(L, -3, "description");
+        if (!lua_isstring(L, -3) || !lua_isstring(L, -2)) {
+            return luaL_error(L, "asset_save_sounds() entry %d needs string fields 'file' and 'name'", i);
+        }
+        std::string wav_filename = lua_tostring(L, -3);
+        
+        SuperTerminal::AssetMetadata metadata;
+        metadata.name = lua_tostring(L, -2);
+        metadata.kind = SuperTerminal::AssetKind::SOUND;
+        metadata.description = lua_isstring(L, -1) ? lua_tostring(L, -1) : "";
+        metadata.compressed = false;  // Same as asset_save_sound
+        lua_pop(L, 4);
+        
+        if (!readFile(wav_filename, metadata.data)) {
+            lua_pushboolean(L, false);
+            lua_pushstring(L, ("Failed to read WAV file: " + wav_filename).c_str());
+            return 2;
+        }
+        total_bytes += metadata.data.size();
+        assets.push_back(std::move(metadata));
+    }
+    
+    if (!assetMgr->addAssets(assets)) {
+        lua_pushboolean(L, false);
+        lua_pushstring(L, assetMgr->getLastError().c_str());
+        return 2;
+    }
+    
+    std::cout << "AssetsLua: Saved " << assets.size() << " sound assets ("
+              << total_bytes << " bytes)" << std::endl;
+    
+    lua_pushboolean(L, true);
+    return 1;
+}
+
+// ids = asset_load_sounds({asset_name, ...})
+// Loads several sounds with one database query; returns a table mapping
+// each name to its sound ID (0 if it failed to load)
+static int lua_asset_load_sounds(lua_State* L) {
+    if (lua_gettop(L) != 1) {
+        return luaL_error(L, "asset_load_sounds() expects 1 argument: array of asset names");
+    }
+    
+    std::vector<std::string> names = checkNameArray(L, 1, "asset_load_sounds");
+    
     lua_newtable(L);
+    auto assetMgr = getAssetsManager();
+    if (!assetMgr) {
+        for (const auto& name : names) {
+            lua_pushinteger(L, 0);
+            lua_setfield(L, -2, name.c_str());
+        }
+        return 1;
+    }
     
-    lua_pushstring(L, "name");
-    lua_pushstring(L, metadata.name.c_str());
-    lua_settable(L, -3);
+    std::vector<uint32_t> sound_ids;
+    std::vector<SuperTerminal::AssetLoadResult> results = assetMgr->loadSounds(names, sound_ids);
     
-    lua_pushstring(L, "description");
-    lua_pushstring(L, metadata.description.c_str());
-    lua_settable(L, -3);
+    int loaded = 0;
+    for (size_t i = 0; i < names.size(); i++) {
+        if (results[i] == SuperTerminal::AssetLoadResult::SUCCESS) {
+            loaded++;
+        } else {
+            std::cerr << "AssetsLua: Failed to load sound asset '" << names[i] << "': "
+                      << SuperTerminal::AssetsManager::loadResultToString(results[i]) << std::endl;
+        }
+        lua_pushinteger(L, sound_ids[i]);
+        lua_setfield(L, -2, names[i].c_str());
+    }
     
-    lua_pushstring(L, "size");
-    lua_pushinteger(L, metadata.data.size());
-    lua_settable(L, -3);
+    std::cout << "AssetsLua: Loaded " << loaded << " of " << names.size() << " sound assets" << std::endl;
     
-    lua_pushstring(L, "compressed");
-    lua_pushboolean(L, metadata.compressed);
-    lua_settable(L, -3);
+    return 1;
+}
+
+// infos = asset_get_sound_infos({asset_name, ...})
+// Returns a table mapping each found name to its asset_get_sound_info table
+static int lua_asset_get_sound_infos(lua_State* L) {
+    if (lua_gettop(L) != 1) {
+        return luaL_error(L, "asset_get_sound_infos() expects 1 argument: array of asset names");
+    }
+    
+    std::vector<std::string> names = checkNameArray(L, 1, "asset_get_sound_infos");
+    
+    lua_newtable(L);
+    auto assetMgr = getAssetsManager();
+    if (!assetMgr) {
+        return 1;
+    }
+    
+    std::vector<SuperTerminal::AssetMetadata> metadata;
+    assetMgr->getAssetMetadata(names, metadata);
+    
+    for (size_t i = 0; i < names.size(); i++) {
+        if (metadata[i].id == 0) {
+            continue;
+        }
+        pushSoundInfo(L, metadata[i]);
+        lua_setfield(L, -2, names[i].c_str());
+    }
     
     return 1;
 }
@@ -279,6 +433,50 @@ static int lua_asset_remove_sound(lua_State* L) {
     return 1;
 }
 
+// ok = hot_reload_start(dir, [dir2, ...])
+// Watches directories for changed Lua modules, sprites and sounds
+static int lua_hot_reload_start(lua_State* L) {
+    int argc = lua_gettop(L);
+    if (argc < 1) {
+        return luaL_error(L, "hot_reload_start() expects at least 1 argument: directory");
+    }
+    
+    std::vector<std::string> roots;
+    for (int i = 1; i <= argc; i++) {
+        roots.push_back(luaL_checkstring(L, i));
+    }
+    
+    auto reloader = SuperTerminal::GetGlobalHotReloader();
+    bool success = reloader->start(roots);
+    if (!success) {
+        std::cerr << "AssetsLua: hot_reload_start failed: " << reloader->getLastError() << std::endl;
+    }
+    
+    lua_pushboolean(L, success);
+    return 1;
+}
+
+// hot_reload_stop()
+static int lua_hot_reload_stop(lua_State* L) {
+    SuperTerminal::GetGlobalHotReloader()->stop();
+    return 0;
+}
+
+// count = hot_reload_poll()
+// Applies settled changes in the calling script's state; call once per frame.
+// Returns the number of modules, sprites and sounds reloaded.
+static int lua_hot_reload_poll(lua_State* L) {
+    auto reloader = SuperTerminal::GetGlobalHotReloader();
+    if (!reloader->isRunning()) {
+        lua_pushinteger(L, 0);
+        return 1;
+    }
+    
+    SuperTerminal::HotReloadStats stats = reloader->poll(L, getAssetsManager());
+    lua_pushinteger(L, stats.total());
+    return 1;
+}
+
 // Register all asset Lua bindings
 extern "C" void register_assets_lua_bindings(lua_State* L) {
     std::cout << "AssetsLua: Registering asset management functions..." << std::endl;
@@ -291,6 +489,16 @@ extern "C" void register_assets_lua_bindings(lua_State* L) {
     lua_register(L, "asset_get_sound_info", lua_asset_get_sound_info);
     lua_register(L, "asset_remove_sound", lua_asset_remove_sound);
     
+    // Batch variants: one binding call and one database round trip per batch
+    lua_register(L, "asset_save_sounds", lua_asset_save_sounds);
+    lua_register(L, "asset_load_sounds", lua_asset_load_sounds);
+    lua_register(L, "asset_get_sound_infos", lua_asset_get_sound_infos);
+    
+    // Live reloading
+    lua_register(L, "hot_reload_start", lua_hot_reload_start);
+    lua_register(L, "hot_reload_stop", lua_hot_reload_stop);
+    lua_register(L, "hot_reload_poll", lua_hot_reload_poll);
+    
     std::cout << "AssetsLua: Asset functions registered successfully" << std::endl;
 }
 
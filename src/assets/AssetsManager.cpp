@@ -9,6 +9,7 @@
 #include "AssetsManager.h"
 #include "AssetDatabase.h"
 #include "AssetMetadata.h"
+#include "FileWatcher.h"
 #include "../include/SuperTerminal.h"
 #include <fstream>
 #include <algorithm>
@@ -210,6 +211,7 @@ AssetLoadResult AssetsManager::loadSpriteInternal(const std::string& name, uint1
     
     // Try to load from database
     AssetMetadata metadata;
+    std::string sourcePath;   // Set when the filesystem copy was used
     AssetLoadResult result = loadFromDatabase(name, metadata);
     
     // Fallback to filesystem if enabled
@@ -217,6 +219,7 @@ AssetLoadResult AssetsManager::loadSpriteInternal(const std::string& name, uint1
         result = loadFromFilesystem(name, metadata);
         if (result == AssetLoadResult::SUCCESS) {
             loadStats.filesystemLoads++;
+            sourcePath = findFileInSearchPaths(name);
         }
     }
     
@@ -237,6 +240,7 @@ AssetLoadResult AssetsManager::loadSpriteInternal(const std::string& name, uint1
         CachedAsset cached(metadata);
         cached.loaded = true;
         cached.spriteId = spriteId;
+        cached.filePath = sourcePath;
         cached.lastAccess = std::time(nullptr);
         cached.accessCount = 1;
         addToCache(name, cached);
@@ -270,7 +274,65 @@ AssetLoadResult AssetsManager::loadSound(const std::string& name, uint32_t sound
     return loadSoundInternal(name, soundId);
 }
 
-AssetLoadResult AssetsManager::loadSoundInternal(const std::string& name, uint32_t soundId) {
+std::vector<AssetLoadResult> AssetsManager::loadSounds(const std::vector<std::string>& names,
+                                                       std::vector<uint32_t>& outSoundIds) {
+    outSoundIds.assign(names.size(), 0);
+    if (!initialized) {
+        setError("AssetsManager not initialized");
+        return std::vector<AssetLoadResult>(names.size(), AssetLoadResult::DATABASE_ERROR);
+    }
+    
+    // Fetch everything not already cached in one database round trip
+    std::vector<std::string> misses;
+    std::vector<size_t> missIndices;
+    for (size_t i = 0; i < names.size(); i++) {
+        const CachedAsset* cached = config.enableCache ? getCachedAsset(names[i]) : nullptr;
+        if (!cached || !cached->loaded) {
+            misses.push_back(names[i]);
+            missIndices.push_back(i);
+        }
+    }
+    
+    std::vector<AssetMetadata> fetched;
+    if (!misses.empty() && database && database->isOpen()) {
+        auto result = database->getAssetsByName(misses);
+        if (result) {
+            fetched = std::move(result.value);
+        }
+    }
+    // If the query failed, the misses go through the normal per-name path
+    bool prefetched = fetched.size() == misses.size();
+    
+    std::vector<AssetLoadResult> results(names.size(), AssetLoadResult::NOT_FOUND);
+    size_t nextMiss = 0;
+    for (size_t i = 0; i < names.size(); i++) {
+        AssetMetadata* metadata = nullptr;
+        if (nextMiss < missIndices.size() && missIndices[nextMiss] == i) {
+            metadata = prefetched ? &fetched[nextMiss] : nullptr;
+            nextMiss++;
+        }
+        
+        uint32_t id = allocateSoundId();
+        if (id == 0) {
+            setError("No sound IDs available");
+            results[i] = AssetLoadResult::CACHE_FULL;
+            continue;
+        }
+        
+        // A name repeated in the batch finds the first copy in the cache
+        results[i] = loadSoundInternal(names[i], id, metadata);
+        if (results[i] == AssetLoadResult::SUCCESS) {
+            outSoundIds[i] = id;
+        } else {
+            freeSoundId(id);
+        }
+    }
+    
+    return results;
+}
+
+AssetLoadResult AssetsManager::loadSoundInternal(const std::string& name, uint32_t soundId,
+                                                 AssetMetadata* prefetched) {
     if (!initialized) {
         setError("AssetsManager not initialized");
         return AssetLoadResult::DATABASE_ERROR;
@@ -292,12 +354,23 @@ AssetLoadResult AssetsManager::loadSoundInternal(const std::string& name, uint32
     
     // Load from database or filesystem
     AssetMetadata metadata;
-    AssetLoadResult result = loadFromDatabase(name, metadata);
+    std::string sourcePath;   // Set when the filesystem copy was used
+    AssetLoadResult result;
+    if (prefetched) {
+        // Already queried by loadSounds(); id 0 means the database has no such asset
+        result = prefetched->id != 0 ? AssetLoadResult::SUCCESS : AssetLoadResult::NOT_FOUND;
+        if (result == AssetLoadResult::SUCCESS) {
+            metadata = std::move(*prefetched);
+        }
+    } else {
+        result = loadFromDatabase(name, metadata);
+    }
     
     if (result != AssetLoadResult::SUCCESS && config.fallbackToFilesystem) {
         result = loadFromFilesystem(name, metadata);
         if (result == AssetLoadResult::SUCCESS) {
             loadStats.filesystemLoads++;
+            sourcePath = findFileInSearchPaths(name);
         }
     }
     
@@ -318,6 +391,7 @@ AssetLoadResult AssetsManager::loadSoundInternal(const std::string& name, uint32
         CachedAsset cached(metadata);
         cached.loaded = true;
         cached.soundId = soundId;
+        cached.filePath = sourcePath;
         cached.lastAccess = std::time(nullptr);
         cached.accessCount = 1;
         addToCache(name, cached);
@@ -529,6 +603,28 @@ bool AssetsManager::getAssetMetadata(const std::string& name, AssetMetadata& out
     return false;
 }
 
+int AssetsManager::getAssetMetadata(const std::vector<std::string>& names,
+                                    std::vector<AssetMetadata>& outMetadata) const {
+    outMetadata.assign(names.size(), AssetMetadata());
+    if (!initialized || !database || !database->isOpen()) {
+        return 0;
+    }
+    
+    auto result = database->getAssetsByName(names);
+    if (!result) {
+        return 0;
+    }
+    
+    outMetadata = std::move(result.value);
+    int found = 0;
+    for (const auto& metadata : outMetadata) {
+        if (metadata.id != 0) {
+            found++;
+        }
+    }
+    return found;
+}
+
 std::vector<std::string> AssetsManager::listAssets(AssetKind kind) const {
     std::vector<std::string> names;
     
@@ -609,6 +705,21 @@ const CachedAsset* AssetsManager::getCachedAsset(const std::string& name) const
     return nullptr;
 }
 
+std::vector<std::string> AssetsManager::getCachedAssetsForFile(const std::string& path) const {
+    std::vector<std::string> names;
+    std::string canonical = FileWatcher::canonicalPath(path);
+    
+    for (const auto& pair : cache) {
+        const CachedAsset& asset = pair.second;
+        if (asset.loaded && !asset.filePath.empty() &&
+            FileWatcher::canonicalPath(asset.filePath) == canonical) {
+            names.push_back(pair.first);
+        }
+    }
+    
+    return names;
+}
+
 void AssetsManager::uncache(const std::string& name) {
     auto it = cache.find(name);
     if (it != cache.end()) {
@@ -743,6 +854,21 @@ bool AssetsManager::addAsset(const AssetMetadata& metadata) {
     return true;
 }
 
+bool AssetsManager::addAssets(const std::vector<AssetMetadata>& assets) {
+    if (!initialized || !database || !database->isOpen()) {
+        setError("Database not available");
+        return false;
+    }
+    
+    auto result = database->addAssets(assets);
+    if (!result) {
+        setError(result.errorMessage);
+        return false;
+    }
+    
+    return true;
+}
+
 bool AssetsManager::removeAsset(const std::string& name) {
     if (!initialized || !database || !database->isOpen()) {
         setError("Database not available");
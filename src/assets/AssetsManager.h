@@ -118,6 +118,12 @@ public:
     // Load sound with explicit ID
     AssetLoadResult loadSound(const std::string& name, uint32_t soundId);
     
+    // Load several sounds, fetching every uncached one from the database in a
+    // single query. Results and IDs are parallel to names; a failed load gets
+    // sound ID 0.
+    std::vector<AssetLoadResult> loadSounds(const std::vector<std::string>& names,
+                                            std::vector<uint32_t>& outSoundIds);
+    
     // Load music by name (prepares for playback)
     AssetLoadResult loadMusic(const std::string& name, std::string& outMusicData);
     
@@ -151,6 +157,10 @@ public:
     // Get asset metadata (without loading data)
     bool getAssetMetadata(const std::string& name, AssetMetadata& outMetadata) const;
     
+    // Get metadata for several assets in one database query. Results are
+    // parallel to names (id 0 where not found); returns the number found.
+    int getAssetMetadata(const std::vector<std::string>& names, std::vector<AssetMetadata>& outMetadata) const;
+    
     // List all assets of a specific kind
     std::vector<std::string> listAssets(AssetKind kind) const;
     
@@ -171,6 +181,9 @@ public:
     // Get cached asset info
     const CachedAsset* getCachedAsset(const std::string& name) const;
     
+    // Names of cached assets that were loaded from the given file
+    std::vector<std::string> getCachedAssetsForFile(const std::string& path) const;
+    
     // Clear specific asset from cache
     void uncache(const std::string& name);
     
@@ -204,6 +217,9 @@ public:
     // Add asset to database
     bool addAsset(const AssetMetadata& metadata);
     
+    // Add several assets in one transaction; none are added if any fails
+    bool addAssets(const std::vector<AssetMetadata>& assets);
+    
     // Remove asset from database
     bool removeAsset(const std::string& name);
     
@@ -396,7 +412,8 @@ private:
     
     // Internal loading helpers (to avoid overload ambiguity)
     AssetLoadResult loadSpriteInternal(const std::string& name, uint16_t spriteId);
-    AssetLoadResult loadSoundInternal(const std::string& name, uint32_t soundId);
+    AssetLoadResult loadSoundInternal(const std::string& name, uint32_t soundId,
+                                      AssetMetadata* prefetched = nullptr);
     
     // Compression helpers (zstd)
     bool compressData(const std::vector<uint8_t>& input, std::vector<uint8_t>& output);
@@ -0,0 +1,358 @@
+//
+//  FileWatcher.cpp
+//  SuperTerminal Framework - Asset and Module File Watcher
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "FileWatcher.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+
+#if defined(__APPLE__)
+#include <CoreServices/CoreServices.h>
+#include <dispatch/dispatch.h>
+#elif defined(__linux__)
+#include <dirent.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <thread>
+#endif
+
+namespace SuperTerminal {
+
+// ============================================================================
+// ChangeBatcher
+// ============================================================================
+
+ChangeBatcher::ChangeBatcher(const FileWatcherConfig& config)
+    : config(config) {
+}
+
+void ChangeBatcher::record(const std::string& path, uint64_t nowMs) {
+    if (pending.empty()) {
+        firstEventMs = nowMs;
+    }
+    pending.emplace(path, nowMs);
+    lastEventMs = nowMs;
+}
+
+bool ChangeBatcher::ready(uint64_t nowMs) const {
+    if (pending.empty()) {
+        return false;
+    }
+    return nowMs - lastEventMs >= config.debounceMs ||
+           nowMs - firstEventMs >= config.maxLatencyMs;
+}
+
+std::vector<std::string> ChangeBatcher::take(uint64_t nowMs) {
+    std::vector<std::string> batch;
+    if (!ready(nowMs)) {
+        return batch;
+    }
+
+    batch.reserve(pending.size());
+    for (const auto& entry : pending) {
+        batch.push_back(entry.first);
+    }
+    std::sort(batch.begin(), batch.end());
+    pending.clear();
+    return batch;
+}
+
+void ChangeBatcher::clear() {
+    pending.clear();
+}
+
+// ============================================================================
+// Platform backends
+// ============================================================================
+
+#if defined(__APPLE__)
+
+struct FileWatcher::Backend {
+    FSEventStreamRef stream = nullptr;
+    dispatch_queue_t queue = nullptr;
+
+    static void callback(ConstFSEventStreamRef, void* info, size_t count, void* paths,
+                         const FSEventStreamEventFlags flags[], const FSEventStreamEventId[]) {
+        FileWatcher* watcher = static_cast<FileWatcher*>(info);
+        char** eventPaths = static_cast<char**>(paths);
+        const FSEventStreamEventFlags interesting = kFSEventStreamEventFlagItemModified |
+                                                    kFSEventStreamEventFlagItemCreated |
+                                                    kFSEventStreamEventFlagItemRenamed;
+        for (size_t i = 0; i < count; i++) {
+            if ((flags[i] & kFSEventStreamEventFlagItemIsFile) && (flags[i] & interesting)) {
+                watcher->notifyChanged(eventPaths[i]);
+            }
+        }
+    }
+
+    bool start(FileWatcher* owner, const std::vector<std::string>& roots, std::string& error) {
+        CFMutableArrayRef paths = CFArrayCreateMutable(nullptr, 0, &kCFTypeArrayCallBacks);
+        for (const auto& root : roots) {
+            CFStringRef path = CFStringCreateWithCString(nullptr, root.c_str(), kCFStringEncodingUTF8);
+            CFArrayAppendValue(paths, path);
+            CFRelease(path);
+        }
+
+        FSEventStreamContext context = {0, owner, nullptr, nullptr, nullptr};
+        stream = FSEventStreamCreate(nullptr, &Backend::callback, &context, paths,
+                                     kFSEventStreamEventIdSinceNow, 0.05,
+                                     kFSEventStreamCreateFlagFileEvents |
+                                     kFSEventStreamCreateFlagNoDefer);
+        CFRelease(paths);
+        if (!stream) {
+            error = "FSEventStreamCreate failed";
+            return false;
+        }
+
+        queue = dispatch_queue_create("com.superterminal.filewatcher", DISPATCH_QUEUE_SERIAL);
+        FSEventStreamSetDispatchQueue(stream, queue);
+        if (!FSEventStreamStart(stream)) {
+            error = "FSEventStreamStart failed";
+            stop();
+            return false;
+        }
+        return true;
+    }
+
+    void stop() {
+        if (stream) {
+            FSEventStreamStop(stream);
+            FSEventStreamInvalidate(stream);
+            FSEventStreamRelease(stream);
+            stream = nullptr;
+        }
+        if (queue) {
+            // Drain callbacks still in flight before the owner goes away
+            dispatch_sync(queue, ^{});
+            dispatch_release(queue);
+            queue = nullptr;
+        }
+    }
+};
+
+#elif defined(__linux__)
+
+struct FileWatcher::Backend {
+    int fd = -1;
+    int wakePipe[2] = {-1, -1};
+    std::thread thread;
+    std::unordered_map<int, std::string> watches;   // wd -> directory
+
+    void addTree(const std::string& dir, FileWatcher* owner, bool reportFiles) {
+        int wd = inotify_add_watch(fd, dir.c_str(),
+                                   IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR);
+        if (wd < 0) {
+            return;
+        }
+        watches[wd] = dir;
+
+        DIR* handle = opendir(dir.c_str());
+        if (!handle) {
+            return;
+        }
+        while (struct dirent* entry = readdir(handle)) {
+            std::string name = entry->d_name;
+            if (name == "." || name == "..") {
+                continue;
+            }
+            std::string path = dir + "/" + name;
+            struct stat info;
+            if (stat(path.c_str(), &info) != 0) {
+                continue;
+            }
+            if (S_ISDIR(info.st_mode)) {
+                addTree(path, owner, reportFiles);
+            } else if (reportFiles) {
+                // Files written into a new directory before its watch existed
+                owner->notifyChanged(path);
+            }
+        }
+        closedir(handle);
+    }
+
+    bool start(FileWatcher* owner, const std::vector<std::string>& roots, std::string& error) {
+        fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd < 0 || pipe(wakePipe) != 0) {
+            error = "inotify initialization failed";
+            stop();
+            return false;
+        }
+        for (const auto& root : roots) {
+            addTree(root, owner, false);
+        }
+        if (watches.empty()) {
+            error = "No watchable directories";
+            stop();
+            return false;
+        }
+
+        thread = std::thread([this, owner]() { run(owner); });
+        return true;
+    }
+
+    void run(FileWatcher* owner) {
+        alignas(struct inotify_event) char buffer[16 * 1024];
+        struct pollfd fds[2] = {{fd, POLLIN, 0}, {wakePipe[0], POLLIN, 0}};
+
+        while (true) {
+            if (::poll(fds, 2, -1) < 0) {
+                continue;
+            }
+            if (fds[1].revents & POLLIN) {
+                break;
+            }
+
+            ssize_t length;
+            while ((length = read(fd, buffer, sizeof(buffer))) > 0) {
+                for (char* ptr = buffer; ptr < buffer + length; ) {
+                    auto* event = reinterpret_cast<struct inotify_event*>(ptr);
+                    ptr += sizeof(struct inotify_event) + event->len;
+
+                    auto it = watches.find(event->wd);
+                    if (it == watches.end() || event->len == 0) {
+                        continue;
+                    }
+                    std::string path = it->second + "/" + event->name;
+                    if (event->mask & IN_ISDIR) {
+                        if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                            addTree(path, owner, true);
+                        }
+                    } else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                        owner->notifyChanged(path);
+                    }
+                }
+            }
+        }
+    }
+
+    void stop() {
+        if (thread.joinable()) {
+            char wake = 1;
+            (void)!write(wakePipe[1], &wake, 1);
+            thread.join();
+        }
+        int* handles[] = {&fd, &wakePipe[0], &wakePipe[1]};
+        for (int* handle : handles) {
+            if (*handle >= 0) {
+                close(*handle);
+                *handle = -1;
+            }
+        }
+        watches.clear();
+    }
+};
+
+#else
+
+struct FileWatcher::Backend {
+    bool start(FileWatcher*, const std::vector<std::string>&, std::string& error) {
+        error = "File watching is not supported on this platform";
+        return false;
+    }
+    void stop() {}
+};
+
+#endif
+
+// ============================================================================
+// FileWatcher
+// ============================================================================
+
+FileWatcher::FileWatcher()
+    : FileWatcher(FileWatcherConfig{}) {
+}
+
+FileWatcher::FileWatcher(const FileWatcherConfig& config)
+    : config(config), batcher(config) {
+}
+
+FileWatcher::~FileWatcher() {
+    stop();
+}
+
+bool FileWatcher::start(const std::vector<std::string>& newRoots) {
+    stop();
+
+    roots.clear();
+    for (const auto& root : newRoots) {
+        roots.push_back(canonicalPath(root));
+    }
+    if (roots.empty()) {
+        lastError = "No directories to watch";
+        return false;
+    }
+
+    backend = std::make_unique<Backend>();
+    if (!backend->start(this, roots, lastError)) {
+        backend.reset();
+        std::cerr << "FileWatcher: " << lastError << std::endl;
+        return false;
+    }
+
+    running = true;
+    std::cout << "FileWatcher: Watching " << roots.size() << " director"
+              << (roots.size() == 1 ? "y" : "ies") << std::endl;
+    return true;
+}
+
+void FileWatcher::stop() {
+    if (backend) {
+        backend->stop();
+        backend.reset();
+    }
+    running = false;
+
+    std::lock_guard<std::mutex> lock(batcherMutex);
+    batcher.clear();
+}
+
+std::vector<std::string> FileWatcher::poll() {
+    std::lock_guard<std::mutex> lock(batcherMutex);
+    return batcher.take(nowMs());
+}
+
+void FileWatcher::notifyChanged(const std::string& path) {
+    if (isIgnoredPath(path)) {
+        return;
+    }
+    std::string canonical = canonicalPath(path);
+
+    std::lock_guard<std::mutex> lock(batcherMutex);
+    batcher.record(canonical, nowMs());
+}
+
+std::string FileWatcher::canonicalPath(const std::string& path) {
+    char resolved[PATH_MAX];
+    if (realpath(path.c_str(), resolved)) {
+        return resolved;
+    }
+    return path;
+}
+
+bool FileWatcher::isIgnoredPath(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    if (name.empty() || name[0] == '.' || name.back() == '~') {
+        return true;
+    }
+
+    size_t dot = name.find_last_of('.');
+    std::string ext = dot == std::string::npos ? "" : name.substr(dot + 1);
+    return ext == "swp" || ext == "swx" || ext == "tmp";
+}
+
+uint64_t FileWatcher::nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace SuperTerminal
@@ -0,0 +1,106 @@
+//
+//  FileWatcher.h
+//  SuperTerminal Framework - Asset and Module File Watcher
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+//  Watches directory trees for changed files (FSEvents on macOS, inotify on
+//  Linux) and hands them out in debounced batches, so a bulk export that
+//  rewrites many files is reported once per file after the writes settle.
+//
+
+#ifndef FILE_WATCHER_H
+#define FILE_WATCHER_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace SuperTerminal {
+
+// Debounce configuration
+struct FileWatcherConfig {
+    uint32_t debounceMs = 150;      // Batch is released after this much quiet
+    uint32_t maxLatencyMs = 1000;   // ...or once the oldest change is this old
+};
+
+// Collects change notifications and releases them as de-duplicated batches.
+// Time is passed in by the caller so the policy can be tested headlessly.
+class ChangeBatcher {
+public:
+    explicit ChangeBatcher(const FileWatcherConfig& config = FileWatcherConfig{});
+
+    // Record a change to path at time nowMs
+    void record(const std::string& path, uint64_t nowMs);
+
+    // True if take() would return a non-empty batch at nowMs
+    bool ready(uint64_t nowMs) const;
+
+    // Release the pending batch (sorted, each path once) if it is ready
+    std::vector<std::string> take(uint64_t nowMs);
+
+    size_t pendingCount() const { return pending.size(); }
+    void clear();
+
+private:
+    FileWatcherConfig config;
+    std::unordered_map<std::string, uint64_t> pending;   // path -> first seen
+    uint64_t firstEventMs = 0;
+    uint64_t lastEventMs = 0;
+};
+
+// Recursive directory watcher with one interface across platforms
+class FileWatcher {
+public:
+    FileWatcher();
+    explicit FileWatcher(const FileWatcherConfig& config);
+    ~FileWatcher();
+
+    // No copy
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    // Start watching the given directory trees (replaces any previous roots)
+    bool start(const std::vector<std::string>& roots);
+    void stop();
+    bool isRunning() const { return running; }
+
+    // Non-blocking: returns the next settled batch of changed files, if any.
+    // Paths are absolute and canonical.
+    std::vector<std::string> poll();
+
+    // Get last error message
+    std::string getLastError() const { return lastError; }
+
+    // Canonical absolute form of path (symlinks resolved) or path unchanged
+    static std::string canonicalPath(const std::string& path);
+
+    // Editor swap files, dotfiles and backups are never reported
+    static bool isIgnoredPath(const std::string& path);
+
+    // Milliseconds on the monotonic clock used for debouncing
+    static uint64_t nowMs();
+
+    // Called by the platform backend from its own thread
+    void notifyChanged(const std::string& path);
+
+private:
+    struct Backend;
+
+    FileWatcherConfig config;
+    std::unique_ptr<Backend> backend;
+    std::vector<std::string> roots;
+    bool running = false;
+    std::string lastError;
+
+    std::mutex batcherMutex;
+    ChangeBatcher batcher;
+};
+
+} // namespace SuperTerminal
+
+#endif // FILE_WATCHER_H
@@ -0,0 +1,230 @@
+//
+//  HotReload.cpp
+//  SuperTerminal Framework - Live Asset and Module Reloading
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "HotReload.h"
+#include "AssetsManager.h"
+#include <iostream>
+
+extern "C" {
+#include <lua.h>
+#include <lualib.h>
+#include <lauxlib.h>
+
+    int sprite_layer_reload_file(const char* filename);
+    int audio_reload_sound_file(const char* filename);
+}
+
+namespace SuperTerminal {
+
+static bool hasExtension(const std::string& path, const char* ext) {
+    size_t dot = path.find_last_of('.');
+    return dot != std::string::npos && path.compare(dot + 1, std::string::npos, ext) == 0;
+}
+
+// Does module `name` resolve to `path` through the package.path templates?
+static bool moduleResolvesTo(const std::string& name, const std::string& searchPath,
+                             const std::string& path) {
+    std::string relative = name;
+    for (char& c : relative) {
+        if (c == '.') c = '/';
+    }
+
+    size_t start = 0;
+    while (start <= searchPath.size()) {
+        size_t end = searchPath.find(';', start);
+        if (end == std::string::npos) end = searchPath.size();
+        std::string candidate = searchPath.substr(start, end - start);
+        start = end + 1;
+
+        size_t mark;
+        while ((mark = candidate.find('?')) != std::string::npos) {
+            candidate.replace(mark, 1, relative);
+        }
+        if (!candidate.empty() && FileWatcher::canonicalPath(candidate) == path) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ============================================================================
+// HotReloader
+// ============================================================================
+
+HotReloader::HotReloader(const FileWatcherConfig& config)
+    : watcher(config) {
+}
+
+bool HotReloader::start(const std::vector<std::string>& roots) {
+    return watcher.start(roots);
+}
+
+void HotReloader::stop() {
+    watcher.stop();
+}
+
+HotReloadStats HotReloader::poll(lua_State* L, AssetsManager* assets) {
+    std::vector<std::string> batch = watcher.poll();
+    if (batch.empty()) {
+        return HotReloadStats{};
+    }
+    return apply(batch, L, assets);
+}
+
+HotReloadStats HotReloader::apply(const std::vector<std::string>& paths, lua_State* L,
+                                  AssetsManager* assets) {
+    HotReloadStats stats;
+
+    for (const auto& changed : paths) {
+        std::string path = FileWatcher::canonicalPath(changed);
+        bool handled = false;
+
+        if (hasExtension(path, "lua")) {
+            bool matched = false;
+            if (L && reloadModule(L, path, matched)) {
+                stats.modules++;
+            } else if (matched) {
+                stats.failures++;
+            }
+            handled = matched;
+        } else {
+            // Assets loaded by name through AssetsManager go back into their IDs
+            if (assets && assets->isInitialized()) {
+                for (const auto& name : assets->getCachedAssetsForFile(path)) {
+                    const CachedAsset* cached = assets->getCachedAsset(name);
+                    uint16_t spriteId = cached->spriteId;
+                    uint32_t soundId = cached->soundId;
+                    assets->uncache(name);
+
+                    AssetLoadResult result = AssetLoadResult::NOT_FOUND;
+                    if (spriteId != 0) {
+                        result = assets->loadSprite(name, static_cast<uint16_t>(spriteId));
+                        if (result == AssetLoadResult::SUCCESS) stats.sprites++;
+                    } else if (soundId != 0) {
+                        result = assets->loadSound(name, static_cast<uint32_t>(soundId));
+                        if (result == AssetLoadResult::SUCCESS) stats.sounds++;
+                    }
+                    if (result != AssetLoadResult::SUCCESS) {
+                        std::cerr << "HotReload: Failed to reload asset '" << name << "': "
+                                  << AssetsManager::loadResultToString(result) << std::endl;
+                        stats.failures++;
+                    }
+                    handled = true;
+                }
+            }
+
+            // Sprites and sounds loaded straight from the file
+            int sprites = sprite_layer_reload_file(path.c_str());
+            if (sprites > 0) {
+                stats.sprites += sprites;
+                handled = true;
+            } else if (sprites < 0) {
+                stats.failures++;
+                handled = true;
+            }
+
+            int sounds = audio_reload_sound_file(path.c_str());
+            if (sounds > 0) {
+                stats.sounds += sounds;
+                handled = true;
+            }
+        }
+
+        if (!handled) {
+            stats.ignored++;
+        }
+    }
+
+    std::cout << "HotReload: " << paths.size() << " changed files -> "
+              << stats.modules << " modules, " << stats.sprites << " sprites, "
+              << stats.sounds << " sounds reloaded";
+    if (stats.failures > 0) {
+        std::cout << " (" << stats.failures << " failed)";
+    }
+    std::cout << std::endl;
+
+    return stats;
+}
+
+bool HotReloader::reloadModule(lua_State* L, const std::string& path, bool& matched) {
+    matched = false;
+    int top = lua_gettop(L);
+
+    lua_getglobal(L, "package");
+    if (!lua_istable(L, -1)) {
+        lua_settop(L, top);
+        return false;
+    }
+    lua_getfield(L, -1, "path");
+    std::string searchPath = lua_isstring(L, -1) ? lua_tostring(L, -1) : "";
+    lua_pop(L, 1);
+    lua_getfield(L, -1, "loaded");
+    int loaded = lua_gettop(L);
+
+    // Only modules that are already required are re-executed
+    std::vector<std::string> names;
+    lua_pushnil(L);
+    while (lua_next(L, loaded) != 0) {
+        if (lua_type(L, -2) == LUA_TSTRING &&
+            moduleResolvesTo(lua_tostring(L, -2), searchPath, path)) {
+            names.push_back(lua_tostring(L, -2));
+        }
+        lua_pop(L, 1);
+    }
+
+    bool success = true;
+    for (const auto& name : names) {
+        matched = true;
+        if (luaL_loadfile(L, path.c_str()) != 0) {
+            std::cerr << "HotReload: " << lua_tostring(L, -1) << std::endl;
+            lua_pop(L, 1);
+            success = false;
+            continue;
+        }
+        lua_pushstring(L, name.c_str());
+        if (lua_pcall(L, 1, 1, 0) != 0) {
+            std::cerr << "HotReload: Error re-running module '" << name << "': "
+                      << lua_tostring(L, -1) << std::endl;
+            lua_pop(L, 1);
+            success = false;
+            continue;
+        }
+
+        // Patch the existing module table in place so code holding the old
+        // reference (local m = require "m") sees the new functions
+        lua_getfield(L, loaded, name.c_str());
+        if (lua_istable(L, -1) && lua_istable(L, -2)) {
+            int oldTable = lua_gettop(L);
+            lua_pushnil(L);
+            while (lua_next(L, oldTable - 1) != 0) {
+                lua_pushvalue(L, -2);
+                lua_insert(L, -2);
+                lua_rawset(L, oldTable);
+            }
+            lua_pop(L, 2);
+        } else {
+            lua_pop(L, 1);
+            if (lua_isnil(L, -1)) {
+                lua_pop(L, 1);
+            } else {
+                lua_setfield(L, loaded, name.c_str());
+            }
+        }
+        std::cout << "HotReload: Re-executed module '" << name << "'" << std::endl;
+    }
+
+    lua_settop(L, top);
+    return matched && success;
+}
+
+HotReloader* GetGlobalHotReloader() {
+    static HotReloader reloader;
+    return &reloader;
+}
+
+} // namespace SuperTerminal
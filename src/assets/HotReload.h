@@ -0,0 +1,67 @@
+//
+//  HotReload.h
+//  SuperTerminal Framework - Live Asset and Module Reloading
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+//  Applies batches from FileWatcher to the running program: changed Lua
+//  modules are re-executed in the live state and changed sprite/sound files
+//  are re-decoded into the IDs they were originally loaded into.
+//
+
+#ifndef HOT_RELOAD_H
+#define HOT_RELOAD_H
+
+#include "FileWatcher.h"
+#include <string>
+#include <vector>
+
+struct lua_State;
+
+namespace SuperTerminal {
+
+class AssetsManager;
+
+// Result of applying one batch
+struct HotReloadStats {
+    int modules = 0;        // Lua modules re-executed
+    int sprites = 0;        // Sprite IDs re-decoded
+    int sounds = 0;         // Sound IDs re-decoded
+    int failures = 0;       // Reloads that failed (old data kept)
+    int ignored = 0;        // Changed files nothing had loaded
+
+    int total() const { return modules + sprites + sounds; }
+};
+
+class HotReloader {
+public:
+    explicit HotReloader(const FileWatcherConfig& config = FileWatcherConfig{});
+
+    // Start/stop watching directory trees
+    bool start(const std::vector<std::string>& roots);
+    void stop();
+    bool isRunning() const { return watcher.isRunning(); }
+
+    // Apply the next settled batch. Must be called on the thread that owns L
+    // (the script thread); L may be null to reload assets only.
+    HotReloadStats poll(lua_State* L, AssetsManager* assets);
+
+    // Apply an explicit list of changed files (also used by poll)
+    HotReloadStats apply(const std::vector<std::string>& paths, lua_State* L,
+                         AssetsManager* assets);
+
+    std::string getLastError() const { return watcher.getLastError(); }
+
+private:
+    FileWatcher watcher;
+
+    bool reloadModule(lua_State* L, const std::string& path, bool& matched);
+};
+
+// Global instance used by the Lua bindings
+HotReloader* GetGlobalHotReloader();
+
+} // namespace SuperTerminal
+
+#endif // HOT_RELOAD_H
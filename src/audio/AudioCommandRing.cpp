@@ -0,0 +1,190 @@
+//
+//  AudioCommandRing.cpp
+//  SuperTerminal Framework - Lock-Free Audio Command Ring
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "AudioCommandRing.h"
+#include "../TraceEvents.h"
+#include <algorithm>
+
+static size_t roundUpPowerOfTwo(size_t value) {
+    size_t result = 2;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+// ============================================================================
+// AudioCommandRing (bounded MPSC, per-cell sequence numbers)
+// ============================================================================
+
+AudioCommandRing::AudioCommandRing(size_t requestedCapacity, const char* traceName)
+    : cells(roundUpPowerOfTwo(requestedCapacity))
+    , mask(cells.size() - 1)
+    , traceName(traceName)
+{
+    for (size_t i = 0; i < cells.size(); i++) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool AudioCommandRing::push(const AudioCommand& command) {
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = cells[pos & mask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+        if (diff == 0) {
+            // Cell is free for this lap: claim the position
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.command = command;
+                cell.enqueuedAt = TRACE_ENABLED() ? TRACE_NOW() : 0;
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                enqueued.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        } else if (diff < 0) {
+            // Consumer has not freed this cell yet: ring is full
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool AudioCommandRing::pop(AudioCommand& command) {
+    size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    Cell& cell = cells[pos & mask];
+    size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    if ((intptr_t)sequence - (intptr_t)(pos + 1) < 0) {
+        return false;   // Empty, or the producer holding this cell is mid-write
+    }
+
+    command = cell.command;
+    lastEnqueuedAt = cell.enqueuedAt;
+    cell.sequence.store(pos + mask + 1, std::memory_order_release);
+    dequeuePos.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+size_t AudioCommandRing::drain(std::vector<AudioCommand>& out, size_t maxCommands) {
+    size_t count = 0;
+    AudioCommand command;
+    uint64_t oldest = UINT64_MAX;
+    while (count < maxCommands && pop(command)) {
+        out.push_back(command);
+        count++;
+        if (lastEnqueuedAt != 0) {
+            oldest = std::min(oldest, lastEnqueuedAt);
+        }
+    }
+    if (oldest != UINT64_MAX) {
+        TRACE_COUNTER("audio", traceName, (TRACE_NOW() - oldest) / 1000.0);
+    }
+    return count;
+}
+
+size_t AudioCommandRing::size() const {
+    size_t tail = dequeuePos.load(std::memory_order_acquire);
+    size_t head = enqueuePos.load(std::memory_order_acquire);
+    return head >= tail ? head - tail : 0;
+}
+
+// ============================================================================
+// AudioCommandCoalescer
+// ============================================================================
+
+AudioCommandCoalescer::AudioCommandCoalescer(size_t maxBatch)
+    : table(roundUpPowerOfTwo(maxBatch * 2))
+{
+    keep.reserve(maxBatch);
+}
+
+bool AudioCommandCoalescer::contains(uint64_t key) const {
+    size_t tableMask = table.size() - 1;
+    size_t index = (size_t)((key * 0x9E3779B97F4A7C15ull) >> 32) & tableMask;
+    while (table[index].stamp == stamp) {
+        if (table[index].key == key) return true;
+        index = (index + 1) & tableMask;
+    }
+    return false;
+}
+
+bool AudioCommandCoalescer::testAndSet(uint64_t key) {
+    size_t tableMask = table.size() - 1;
+    size_t index = (size_t)((key * 0x9E3779B97F4A7C15ull) >> 32) & tableMask;
+    while (table[index].stamp == stamp) {
+        if (table[index].key == key) return true;
+        index = (index + 1) & tableMask;
+    }
+    table[index].key = key;
+    table[index].stamp = stamp;
+    return false;
+}
+
+static uint64_t commandKey(AudioCommandType type, uint32_t id) {
+    return ((uint64_t)type << 32) | id;
+}
+
+size_t AudioCommandCoalescer::coalesce(std::vector<AudioCommand>& batch) {
+    if (batch.size() < 2) {
+        return 0;
+    }
+    if (batch.size() * 2 > table.size()) {
+        table.assign(roundUpPowerOfTwo(batch.size() * 2), Slot{});
+        stamp = 0;
+    }
+    if (++stamp == 0) {
+        // Stamp wrapped: old entries could alias the new stamp
+        table.assign(table.size(), Slot{});
+        stamp = 1;
+    }
+    keep.assign(batch.size(), 1);
+
+    // Walk backwards so "a later command exists" is a table lookup
+    for (size_t i = batch.size(); i-- > 0;) {
+        const AudioCommand& command = batch[i];
+        switch (command.type) {
+            // Last write wins per target
+            case AUDIO_SET_MUSIC_VOLUME:
+                keep[i] = !testAndSet(commandKey(command.type, command.target_id));
+                break;
+            case AUDIO_SET_OSC_VOLUME:
+                keep[i] = !testAndSet(commandKey(command.type, command.set_volume.osc_id));
+                break;
+            case AUDIO_SET_OSC_FREQUENCY:
+                keep[i] = !testAndSet(commandKey(command.type, command.set_frequency.osc_id));
+                break;
+            case AUDIO_SET_OSC_WAVEFORM:
+                keep[i] = !testAndSet(commandKey(command.type, command.set_waveform.osc_id));
+                break;
+
+            // Music stops are always kept; they cancel earlier plays of the
+            // same track. Sound stops name a playing instance, not the asset
+            // a play names, so they cancel nothing.
+            case AUDIO_STOP_MUSIC:
+                testAndSet(commandKey(command.type, command.target_id));
+                break;
+            case AUDIO_PLAY_MUSIC:
+                keep[i] = !contains(commandKey(AUDIO_STOP_MUSIC, command.play_music.music_id));
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    size_t write = 0;
+    for (size_t read = 0; read < batch.size(); read++) {
+        if (keep[read]) {
+            if (write != read) batch[write] = batch[read];
+            write++;
+        }
+    }
+    size_t removed = batch.size() - write;
+    batch.resize(write);
+    return removed;
+}
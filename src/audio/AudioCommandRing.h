@@ -0,0 +1,88 @@
+//
+//  AudioCommandRing.h
+//  SuperTerminal Framework - Lock-Free Audio Command Ring
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+//  Bounded multi-producer / single-consumer ring carrying AudioCommands from
+//  script threads to an AudioSystem processing thread, plus the per-frame
+//  coalescer that drops commands made redundant by later ones in the same
+//  drain. Producers never take a lock; a full ring drops the command and
+//  counts it. While tracing is on, each drain reports how long its oldest
+//  command waited as a trace counter.
+//
+
+#pragma once
+
+#include "AudioSystem.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class AudioCommandRing {
+public:
+    // Capacity is rounded up to a power of two. traceName labels the
+    // latency counter and must be a string literal.
+    explicit AudioCommandRing(size_t capacity, const char* traceName = "command latency (us)");
+
+    // Any thread. Returns false (and counts a drop) when the ring is full.
+    bool push(const AudioCommand& command);
+
+    // Consumer thread only
+    bool pop(AudioCommand& command);
+    size_t drain(std::vector<AudioCommand>& out, size_t maxCommands);
+
+    bool empty() const { return size() == 0; }
+    size_t size() const;
+    size_t capacity() const { return mask + 1; }
+
+    uint64_t getEnqueuedCount() const { return enqueued.load(std::memory_order_relaxed); }
+    uint64_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        AudioCommand command;
+        uint64_t enqueuedAt;            // Trace clock, 0 while tracing is off
+    };
+
+    std::vector<Cell> cells;
+    size_t mask;
+    const char* traceName;
+    uint64_t lastEnqueuedAt = 0;        // Consumer only: stamp of the last pop
+
+    // Producer and consumer positions on separate cache lines
+    alignas(64) std::atomic<size_t> enqueuePos{0};
+    alignas(64) std::atomic<size_t> dequeuePos{0};
+    alignas(64) std::atomic<uint64_t> enqueued{0};
+    std::atomic<uint64_t> dropped{0};
+};
+
+// Collapses redundant commands within one drained batch:
+//   - repeated volume/frequency/waveform sets on the same target keep the last
+//   - a music play followed by a stop of the same music drops the play
+// Sound plays and stops are never coalesced: a play names a sound asset and
+// a stop names a playing instance, so their IDs are unrelated.
+// Everything else keeps its original order.
+class AudioCommandCoalescer {
+public:
+    explicit AudioCommandCoalescer(size_t maxBatch = 1024);
+
+    // Removes redundant commands in place; returns how many were removed
+    size_t coalesce(std::vector<AudioCommand>& batch);
+
+private:
+    struct Slot {
+        uint64_t key = 0;
+        uint32_t stamp = 0;
+    };
+
+    std::vector<Slot> table;            // Open addressing, cleared by stamp
+    std::vector<uint8_t> keep;
+    uint32_t stamp = 0;
+
+    bool testAndSet(uint64_t key);
+    bool contains(uint64_t key) const;
+};
@@ -48,6 +48,8 @@ extern "C" {
     uint32_t synth_create_physical_bar(float frequency, float damping, float brightness, float duration);
     uint32_t synth_create_physical_tube(float frequency, float airPressure, float brightness, float duration);
     uint32_t synth_create_physical_drum(float frequency, float damping, float excitation, float duration);
+    bool synth_create_batch(const char** presets, const float* params, const float* durations,
+                            const uint32_t* seeds, int count, uint32_t* outSoundIds, float* outTimesMs);
     
     bool synth_add_effect(uint32_t soundId, const char* effectType);
     bool synth_remove_effect(uint32_t soundId, const char* effectType);
@@ -80,6 +82,7 @@ int lua_synth_create_physical_string(lua_State* L);
 int lua_synth_create_physical_bar(lua_State* L);
 int lua_synth_create_physical_tube(lua_State* L);
 int lua_synth_create_physical_drum(lua_State* L);
+int lua_synth_create_batch(lua_State* L);
 
 int lua_synth_add_effect(lua_State* L);
 int lua_synth_remove_effect(lua_State* L);
@@ -833,6 +836,33 @@ int lua_audio_get_cpu_usage(lua_State* L) {
     return 1;
 }
 
+int lua_audio_get_command_stats(lua_State* L) {
+    uint64_t enqueued = 0, dropped = 0, coalesced = 0, processed = 0;
+    if (AudioLuaHelpers::checkAudioInitialized(L)) {
+        audio_get_command_stats(&enqueued, &dropped, &coalesced, &processed);
+    }
+
+    lua_newtable(L);
+
+    lua_pushstring(L, "enqueued");
+    lua_pushnumber(L, (double)enqueued);
+    lua_settable(L, -3);
+
+    lua_pushstring(L, "dropped");
+    lua_pushnumber(L, (double)dropped);
+    lua_settable(L, -3);
+
+    lua_pushstring(L, "coalesced");
+    lua_pushnumber(L, (double)coalesced);
+    lua_settable(L, -3);
+
+    lua_pushstring(L, "processed");
+    lua_pushnumber(L, (double)processed);
+    lua_settable(L, -3);
+
+    return 1;
+}
+
 // Utility functions
 
 int lua_audio_set_master_volume(lua_State* L) {
@@ -2616,6 +2646,7 @@ extern "C" void register_audio_lua_bindings(lua_State* L) {
     lua_register(L, "audio_get_loaded_sound_count", lua_audio_get_loaded_sound_count);
     lua_register(L, "audio_get_active_voice_count", lua_audio_get_active_voice_count);
     lua_register(L, "audio_get_cpu_usage", lua_audio_get_cpu_usage);
+    lua_register(L, "audio_get_command_stats", lua_audio_get_command_stats);
     
     // Utility functions
     lua_register(L, "set_master_volume", lua_audio_set_master_volume);
@@ -2758,6 +2789,7 @@ extern "C" void register_audio_lua_bindings(lua_State* L) {
     lua_register(L, "create_physical_bar", lua_synth_create_physical_bar);
     lua_register(L, "create_physical_tube", lua_synth_create_physical_tube);
     lua_register(L, "create_physical_drum", lua_synth_create_physical_drum);
+    lua_register(L, "create_batch", lua_synth_create_batch);
     
     // Real-time effects control
     lua_register(L, "sound_add_effect", lua_synth_add_effect);
@@ -3052,6 +3084,50 @@ int lua_synth_create_physical_drum(lua_State* L) {
     return 1;
 }
 
+// create_batch({{"coin", 1.0, 0.4}, {"explode", 2.0, 1.0, seed}, ...})
+// Returns a table of sound IDs and a table of per-sound generation times (ms)
+int lua_synth_create_batch(lua_State* L) {
+    luaL_checktype(L, 1, LUA_TTABLE);
+    int count = (int)lua_objlen(L, 1);
+    if (count <= 0) return luaL_error(L, "create_batch() requires a non-empty list of {preset, param, duration[, seed]}");
+    
+    std::vector<std::string> presets(count);
+    std::vector<const char*> presetNames(count);
+    std::vector<float> params(count), durations(count);
+    std::vector<uint32_t> seeds(count, 0), soundIds(count, 0);
+    std::vector<float> times(count, 0.0f);
+    
+    for (int i = 0; i < count; i++) {
+        lua_rawgeti(L, 1, i + 1);
+        if (!lua_istable(L, -1)) return luaL_error(L, "create_batch(): entry %d must be {preset, param, duration[, seed]}", i + 1);
+        lua_rawgeti(L, -1, 1);
+        lua_rawgeti(L, -2, 2);
+        lua_rawgeti(L, -3, 3);
+        lua_rawgeti(L, -4, 4);
+        presets[i] = luaL_checkstring(L, -4);
+        params[i] = (float)luaL_checknumber(L, -3);
+        durations[i] = (float)luaL_checknumber(L, -2);
+        seeds[i] = (uint32_t)luaL_optinteger(L, -1, 0);
+        presetNames[i] = presets[i].c_str();
+        lua_pop(L, 5);
+    }
+    
+    synth_create_batch(presetNames.data(), params.data(), durations.data(), seeds.data(),
+                       count, soundIds.data(), times.data());
+    
+    lua_createtable(L, count, 0);
+    for (int i = 0; i < count; i++) {
+        lua_pushinteger(L, soundIds[i]);
+        lua_rawseti(L, -2, i + 1);
+    }
+    lua_createtable(L, count, 0);
+    for (int i = 0; i < count; i++) {
+        lua_pushnumber(L, times[i]);
+        lua_rawseti(L, -2, i + 1);
+    }
+    return 2;
+}
+
 // Effects control
 int lua_synth_add_effect(lua_State* L) {
     if (lua_gettop(L) != 2) return luaL_error(L, "sound_add_effect() requires 2 arguments: sound_id, effect_type");
@@ -60,6 +60,7 @@ extern "C" {
     int lua_audio_get_loaded_sound_count(lua_State* L);
     int lua_audio_get_active_voice_count(lua_State* L);
     int lua_audio_get_cpu_usage(lua_State* L);
+    int lua_audio_get_command_stats(lua_State* L);
     
     // Utility functions
     int lua_audio_set_master_volume(lua_State* L);
@@ -12,6 +12,7 @@
 #include <string>
 #include <unordered_map>
 #include <queue>
+#include <vector>
 #include <mutex>
 #include <atomic>
 #include <thread>
@@ -34,6 +35,8 @@ struct AVAudioFile;
 // Forward declarations
 class CoreAudioEngine;
 class SynthEngine;
+class AudioCommandRing;
+class AudioCommandCoalescer;
 namespace SuperTerminal {
     class MidiEngine;
     class ST_MusicPlayer;
@@ -170,6 +173,7 @@ struct AudioConfig {
     uint32_t sampleRate = 44100;
     uint32_t bufferSize = 512;      // Low latency
     uint32_t maxVoices = 64;        // Simultaneous sounds
+    uint32_t commandQueueCapacity = 4096;  // Per command ring; full rings drop
     
     // Memory limits
     size_t maxCachedSounds = 100 * 1024 * 1024;  // 100MB
@@ -196,6 +200,15 @@ enum WaveformType {
     WAVE_NOISE = 4
 };
 
+// Command path counters (snapshot)
+struct AudioCommandStats {
+    uint64_t enqueued = 0;      // Accepted into a ring
+    uint64_t dropped = 0;       // Rejected because a ring was full
+    uint64_t coalesced = 0;     // Removed as redundant before processing
+    uint64_t processed = 0;     // Handed to processCommand
+    size_t pending = 0;         // Currently waiting in the rings
+};
+
 // Audio asset information
 struct AudioAsset {
     uint32_t id;
@@ -221,6 +234,7 @@ public:
     void processAudioCommands();  // Called from audio thread
     bool isQueueEmpty() const;
     void waitQueueEmpty();  // Like your wait_queue_empty()
+    AudioCommandStats getCommandStats() const;
     
     // Emergency shutdown detection (should be called from main thread)
     void checkEmergencyShutdown();
@@ -250,6 +264,7 @@ public:
     bool loadSound(const std::string& filename, uint32_t sound_id);
     void playSound(uint32_t sound_id, float volume = 1.0f, float pitch = 1.0f, float pan = 0.0f);
     void stopSound(uint32_t sound_id);
+    void stopAllSounds();  // Stops playback only; engine and sound cache stay live
     
     // Real-time Synthesis
     uint32_t createOscillator(float frequency, WaveformType waveform = WAVE_SINE);
@@ -281,6 +296,7 @@ public:
     // Asset Management
     std::vector<AudioAsset> getLoadedAssets() const;
     void unloadAsset(uint32_t asset_id);
+    int reloadSoundFile(const std::string& filename);  // Re-decode into the same IDs
     void clearCache();
     
 private:
@@ -294,14 +310,21 @@ private:
     AudioConfig config;
     std::atomic<bool> initialized{false};
     
-    // Dual command queues for better performance
-    std::queue<AudioCommand> effectsQueue;      // High priority, low latency
-    std::queue<AudioCommand> musicQueue;        // Lower priority, buffered
-    mutable std::mutex effectsQueueMutex;
-    mutable std::mutex musicQueueMutex;
-    std::condition_variable effectsQueueCondition;
-    std::condition_variable musicQueueCondition;
+    // Dual lock-free command rings (many script threads -> one thread each)
+    std::unique_ptr<AudioCommandRing> effectsRing;  // High priority, low latency
+    std::unique_ptr<AudioCommandRing> musicRing;    // Lower priority, buffered
     std::atomic<uint32_t> frameCounter{0};
+    std::atomic<uint64_t> coalescedCommands{0};
+    std::atomic<uint64_t> processedCommands{0};
+    
+    // Sleep/wake for the processing threads; producers only touch the mutex
+    // when a thread is actually waiting
+    std::mutex effectsWakeMutex;
+    std::mutex musicWakeMutex;
+    std::condition_variable effectsWakeCondition;
+    std::condition_variable musicWakeCondition;
+    std::atomic<bool> effectsThreadWaiting{false};
+    std::atomic<bool> musicThreadWaiting{false};
     
     // Dual background processing threads
     std::unique_ptr<std::thread> effectsProcessingThread;
@@ -326,7 +349,11 @@ private:
     void processCommand(const AudioCommand& command);
     void effectsProcessingThreadFunction();  // High-priority effects thread
     void musicProcessingThreadFunction();    // Lower-priority music thread
-    void routeCommandToQueue(const AudioCommand& command);  // Route to appropriate queue
+    void routeCommandToQueue(const AudioCommand& command);  // Route to appropriate ring
+    static bool isEffectCommand(AudioCommandType type);
+    size_t processCommandFrame(AudioCommandRing& ring, AudioCommandCoalescer& coalescer,
+                               std::vector<AudioCommand>& batch, size_t maxCommands,
+                               const std::atomic<bool>& stopFlag);
     
     // Thread safety
     mutable std::mutex systemMutex;
@@ -358,8 +385,11 @@ extern "C" {
     bool audio_load_sound_from_buffer_with_id(const float* samples, size_t sampleCount,
                                               uint32_t sampleRate, uint32_t channels,
                                               uint32_t sound_id);
+    void audio_unload_sound(uint32_t sound_id);
     void audio_play_sound(uint32_t sound_id, float volume, float pitch, float pan);
     void audio_stop_sound(uint32_t sound_id);
+    void audio_stop_all();
+    int audio_reload_sound_file(const char* filename);
     
     // Synthesis
     uint32_t audio_create_oscillator(float frequency, int waveform);
@@ -408,4 +438,6 @@ extern "C" {
     size_t audio_get_loaded_sound_count();
     size_t audio_get_active_voice_count();
     float audio_get_cpu_usage();
+    void audio_get_command_stats(uint64_t* enqueued, uint64_t* dropped,
+                                 uint64_t* coalesced, uint64_t* processed);
 }
\ No newline at end of file
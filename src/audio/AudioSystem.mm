@@ -7,14 +7,18 @@
 //
 
 #include "AudioSystem.h"
+#include "AudioCommandRing.h"
 #include "CoreAudioEngine.h"
 #include "SynthEngine.h"
 #include "MidiEngine.h"
 #include "MusicPlayer.h"
 #include "../GlobalShutdown.h"
+#include "../TraceEvents.h"
 #include <iostream>
 #include <thread>
 #include <chrono>
+#include <climits>
+#include <cstdlib>
 
 using namespace SuperTerminal;
 
@@ -61,6 +65,10 @@ bool AudioSystem::initialize(const AudioConfig& audioConfig) {
     // Store configuration
     config = audioConfig;
 
+    // Command rings (fixed size, allocated once)
+    effectsRing = std::make_unique<AudioCommandRing>(config.commandQueueCapacity, "effects command latency (us)");
+    musicRing = std::make_unique<AudioCommandRing>(config.commandQueueCapacity, "music command latency (us)");
+
     // Initialize Core Audio engine
     coreAudioEngine = std::make_unique<::CoreAudioEngine>();
     if (!coreAudioEngine->initialize(config)) {
@@ -127,8 +135,14 @@ void AudioSystem::shutdown() {
     // Stop both background processing threads
     stopEffectsProcessing.store(true);
     stopMusicProcessing.store(true);
-    effectsQueueCondition.notify_all();
-    musicQueueCondition.notify_all();
+    {
+        std::lock_guard<std::mutex> effectsLock(effectsWakeMutex);
+        effectsWakeCondition.notify_all();
+    }
+    {
+        std::lock_guard<std::mutex> musicLock(musicWakeMutex);
+        musicWakeCondition.notify_all();
+    }
 
     if (effectsProcessingThread && effectsProcessingThread->joinable()) {
         effectsProcessingThread->join();
@@ -140,19 +154,10 @@ void AudioSystem::shutdown() {
     }
     musicProcessingThread.reset();
 
-    // Clear both command queues
-    {
-        std::lock_guard<std::mutex> effectsLock(effectsQueueMutex);
-        while (!effectsQueue.empty()) {
-            effectsQueue.pop();
-        }
-    }
-    {
-        std::lock_guard<std::mutex> musicLock(musicQueueMutex);
-        while (!musicQueue.empty()) {
-            musicQueue.pop();
-        }
-    }
+    // Discard anything left in both command rings (no consumer is running now)
+    AudioCommand discarded;
+    while (effectsRing && effectsRing->pop(discarded)) {}
+    while (musicRing && musicRing->pop(discarded)) {}
 
     // Shutdown components in reverse order
     if (musicPlayer) {
@@ -208,41 +213,64 @@ void AudioSystem::processAudioCommands() {
         return;
     }
 
-    std::queue<AudioCommand> effectsToProcess;
-    std::queue<AudioCommand> musicToProcess;
-
-    // Extract commands from both queues
-    {
-        std::lock_guard<std::mutex> effectsLock(effectsQueueMutex);
-        effectsToProcess.swap(effectsQueue);
+    // The rings are single-consumer: while the processing threads run they own them
+    if (effectsProcessingThread || musicProcessingThread) {
+        frameCounter.fetch_add(1);
+        return;
     }
-    {
-        std::lock_guard<std::mutex> musicLock(musicQueueMutex);
-        musicToProcess.swap(musicQueue);
+
+    // One frame: everything currently queued, effects first (higher priority)
+    static thread_local std::vector<AudioCommand> batch;
+    static thread_local AudioCommandCoalescer coalescer(1024);
+    std::atomic<bool> notStopping{false};
+    processCommandFrame(*effectsRing, coalescer, batch, 1024, notStopping);
+    processCommandFrame(*musicRing, coalescer, batch, 1024, notStopping);
+
+    // Increment frame counter
+    frameCounter.fetch_add(1);
+}
+
+// Drain up to maxCommands from a ring, drop redundant ones, process the rest
+size_t AudioSystem::processCommandFrame(AudioCommandRing& ring, AudioCommandCoalescer& coalescer,
+                                        std::vector<AudioCommand>& batch, size_t maxCommands,
+                                        const std::atomic<bool>& stopFlag) {
+    batch.clear();
+    if (ring.drain(batch, maxCommands) == 0) {
+        return 0;
     }
+    TRACE_SCOPE("audio", "command batch");
 
-    // Process effects commands first (higher priority)
-    while (!effectsToProcess.empty()) {
-        const AudioCommand& command = effectsToProcess.front();
-        processCommand(command);
-        effectsToProcess.pop();
+    size_t removed = coalescer.coalesce(batch);
+    if (removed > 0) {
+        coalescedCommands.fetch_add(removed, std::memory_order_relaxed);
     }
 
-    // Process music commands
-    while (!musicToProcess.empty()) {
-        const AudioCommand& command = musicToProcess.front();
+    for (const AudioCommand& command : batch) {
+        if (stopFlag.load() || is_emergency_shutdown_requested()) {
+            break;
+        }
         processCommand(command);
-        musicToProcess.pop();
+        processedCommands.fetch_add(1, std::memory_order_relaxed);
     }
-
-    // Increment frame counter
-    frameCounter.fetch_add(1);
+    return batch.size();
 }
 
 bool AudioSystem::isQueueEmpty() const {
-    std::lock_guard<std::mutex> effectsLock(effectsQueueMutex);
-    std::lock_guard<std::mutex> musicLock(musicQueueMutex);
-    return effectsQueue.empty() && musicQueue.empty();
+    return (!effectsRing || effectsRing->empty()) && (!musicRing || musicRing->empty());
+}
+
+AudioCommandStats AudioSystem::getCommandStats() const {
+    AudioCommandStats stats;
+    for (const AudioCommandRing* ring : {effectsRing.get(), musicRing.get()}) {
+        if (ring) {
+            stats.enqueued += ring->getEnqueuedCount();
+            stats.dropped += ring->getDroppedCount();
+            stats.pending += ring->size();
+        }
+    }
+    stats.coalesced = coalescedCommands.load(std::memory_order_relaxed);
+    stats.processed = processedCommands.load(std::memory_order_relaxed);
+    return stats;
 }
 
 void AudioSystem::waitQueueEmpty() {
@@ -264,17 +292,17 @@ void AudioSystem::waitQueueEmpty() {
 
     if (waitedMs >= maxWaitMs) {
         std::cerr << "AudioSystem: Warning - waitQueueEmpty() timed out after " << maxWaitMs << "ms" << std::endl;
-        std::cerr << "  Effects queue empty: " << effectsQueue.empty() << std::endl;
-        std::cerr << "  Music queue empty: " << musicQueue.empty() << std::endl;
+        std::cerr << "  Effects queue empty: " << (!effectsRing || effectsRing->empty()) << std::endl;
+        std::cerr << "  Music queue empty: " << (!musicRing || musicRing->empty()) << std::endl;
         std::cerr << "  Active voices: " << getActiveVoiceCount() << std::endl;
     }
 }
 
-void AudioSystem::routeCommandToQueue(const AudioCommand& command) {
-    // Route commands to appropriate queue based on type
+bool AudioSystem::isEffectCommand(AudioCommandType type) {
+    // Route commands to appropriate ring based on type
     bool isEffectCommand = false;
 
-    switch (command.type) {
+    switch (type) {
         // Sound effects - high priority, low latency
         case AUDIO_LOAD_SOUND:
         case AUDIO_PLAY_SOUND:
@@ -312,67 +340,84 @@ void AudioSystem::routeCommandToQueue(const AudioCommand& command) {
             break;
     }
 
-    if (isEffectCommand) {
-        {
-            std::lock_guard<std::mutex> lock(effectsQueueMutex);
-            effectsQueue.push(command);
+    return isEffectCommand;
+}
+
+void AudioSystem::routeCommandToQueue(const AudioCommand& command) {
+    bool effects = isEffectCommand(command.type);
+    AudioCommandRing* ring = effects ? effectsRing.get() : musicRing.get();
+    if (!ring || !ring->push(command)) {
+        // Ring full: dropped and counted, never blocks the script thread
+        return;
+    }
+
+    // Only wake the consumer if it is asleep; the fence pairs with the one
+    // the consumer issues after raising its waiting flag
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (effects) {
+        if (effectsThreadWaiting.load()) {
+            std::lock_guard<std::mutex> lock(effectsWakeMutex);
+            effectsWakeCondition.notify_one();
         }
-        effectsQueueCondition.notify_one();
     } else {
-        {
-            std::lock_guard<std::mutex> lock(musicQueueMutex);
-            musicQueue.push(command);
+        if (musicThreadWaiting.load()) {
+            std::lock_guard<std::mutex> lock(musicWakeMutex);
+            musicWakeCondition.notify_one();
         }
-        musicQueueCondition.notify_one();
     }
 }
 
 void AudioSystem::effectsProcessingThreadFunction() {
     std::cout << "AudioSystem: Effects processing thread started (high priority)" << std::endl;
+    TRACE_THREAD_NAME("Audio effects commands");
 
-    while (!stopEffectsProcessing.load() && !is_emergency_shutdown_requested()) {
-        std::unique_lock<std::mutex> lock(effectsQueueMutex);
-
-        // Wait for commands or shutdown signal
-        effectsQueueCondition.wait(lock, [this]() {
-            return !effectsQueue.empty() || stopEffectsProcessing.load() || is_emergency_shutdown_requested();
-        });
+    std::vector<AudioCommand> batch;
+    batch.reserve(1024);
+    AudioCommandCoalescer coalescer(1024);
 
-        // Check for emergency shutdown
-        if (is_emergency_shutdown_requested()) {
-            std::cout << "AudioSystem: Effects thread detected emergency shutdown, exiting..." << std::endl;
-            break;
+    while (!stopEffectsProcessing.load() && !is_emergency_shutdown_requested()) {
+        // Process everything queued since the last frame with minimal latency
+        if (processCommandFrame(*effectsRing, coalescer, batch, 1024, stopEffectsProcessing) > 0) {
+            continue;
         }
 
-        // Process all available effects commands with minimal latency
-        while (!effectsQueue.empty() && !stopEffectsProcessing.load() && !is_emergency_shutdown_requested()) {
-            AudioCommand command = effectsQueue.front();
-            effectsQueue.pop();
-
-            // Release lock while processing command (allows new commands to be queued)
-            lock.unlock();
-
-            // Process the command immediately
-            processCommand(command);
-
-            // Reacquire lock for next iteration
-            lock.lock();
+        // Nothing queued: sleep until a producer wakes us (timeout as a safety net)
+        effectsThreadWaiting.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> lock(effectsWakeMutex);
+            effectsWakeCondition.wait_for(lock, std::chrono::milliseconds(10), [this]() {
+                return !effectsRing->empty() || stopEffectsProcessing.load() || is_emergency_shutdown_requested();
+            });
         }
+        effectsThreadWaiting.store(false);
     }
 
+    if (is_emergency_shutdown_requested()) {
+        std::cout << "AudioSystem: Effects thread detected emergency shutdown, exiting..." << std::endl;
+    }
     std::cout << "AudioSystem: Effects processing thread finished" << std::endl;
 }
 
 void AudioSystem::musicProcessingThreadFunction() {
     std::cout << "AudioSystem: Music processing thread started (lower priority)" << std::endl;
+    TRACE_THREAD_NAME("Audio music commands");
 
-    while (!stopMusicProcessing.load() && !is_emergency_shutdown_requested()) {
-        std::unique_lock<std::mutex> lock(musicQueueMutex);
+    std::vector<AudioCommand> batch;
+    batch.reserve(64);
+    AudioCommandCoalescer coalescer(64);
 
+    while (!stopMusicProcessing.load() && !is_emergency_shutdown_requested()) {
         // Wait for commands or shutdown signal (with longer timeout for batching)
-        musicQueueCondition.wait_for(lock, std::chrono::milliseconds(50), [this]() {
-            return !musicQueue.empty() || stopMusicProcessing.load() || is_emergency_shutdown_requested();
-        });
+        musicThreadWaiting.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> lock(musicWakeMutex);
+            musicWakeCondition.wait_for(lock, std::chrono::milliseconds(50), [this]() {
+                return !musicRing->empty() || stopMusicProcessing.load() || is_emergency_shutdown_requested();
+            });
+        }
+        musicThreadWaiting.store(false);
 
         // Check for emergency shutdown
         if (is_emergency_shutdown_requested()) {
@@ -380,21 +425,9 @@ void AudioSystem::musicProcessingThreadFunction() {
             break;
         }
 
-        // Process available music commands in batches
-        int processedCount = 0;
-        while (!musicQueue.empty() && !stopMusicProcessing.load() && !is_emergency_shutdown_requested() && processedCount < 5) {
-            AudioCommand command = musicQueue.front();
-            musicQueue.pop();
-            processedCount++;
-
-            // Release lock while processing command
-            lock.unlock();
-
-            // Process the command
-            processCommand(command);
-
-            // Reacquire lock for next iteration
-            lock.lock();
+        // Process available music commands in batches, coalesced per batch
+        while (processCommandFrame(*musicRing, coalescer, batch, 64, stopMusicProcessing) > 0 &&
+               !stopMusicProcessing.load()) {
         }
     }
 
@@ -629,6 +662,12 @@ void AudioSystem::stopSound(uint32_t sound_id) {
     enqueueCommand(command);
 }
 
+void AudioSystem::stopAllSounds() {
+    if (coreAudioEngine) {
+        coreAudioEngine->stopAllSounds();
+    }
+}
+
 uint32_t AudioSystem::loadSoundFromBuffer(const float* samples, size_t sampleCount,
                                          uint32_t sampleRate, uint32_t channels) {
     if (!coreAudioEngine || !samples || sampleCount == 0) {
@@ -723,8 +762,10 @@ void AudioSystem::deleteOscillator(uint32_t osc_id) {
 // MIDI API (Phase 2 - stubs for now)
 
 bool AudioSystem::loadMIDI(const std::string& filename, uint32_t midi_id) {
-    std::cout << "AudioSystem: loadMIDI() - Phase 2 feature" << std::endl;
-    return false;  // TODO: Implement in Phase 2
+    if (!midiEngine) {
+        return false;
+    }
+    return midiEngine->loadMidiFile(filename, static_cast<int>(midi_id));
 }
 
 void AudioSystem::playMIDI(uint32_t midi_id, float tempo) {
@@ -799,11 +840,41 @@ std::vector<AudioAsset> AudioSystem::getLoadedAssets() const {
     return assets;
 }
 
+int AudioSystem::reloadSoundFile(const std::string& filename) {
+    char target[PATH_MAX];
+    if (!realpath(filename.c_str(), target)) {
+        return 0;
+    }
+
+    // Collect matches first: loadSound() re-enters assetsMutex on the audio thread
+    std::vector<std::pair<std::string, uint32_t>> matches;
+    {
+        std::lock_guard<std::mutex> lock(assetsMutex);
+        for (const auto& pair : loadedAssets) {
+            char resolved[PATH_MAX];
+            if (realpath(pair.second.filename.c_str(), resolved) && strcmp(resolved, target) == 0) {
+                matches.emplace_back(pair.second.filename, pair.first);
+            }
+        }
+    }
+
+    // The engine keeps the first load of an ID, so drop it before decoding again
+    for (const auto& match : matches) {
+        if (coreAudioEngine) {
+            coreAudioEngine->unloadSound(match.second);
+        }
+        loadSound(match.first, match.second);
+    }
+    return static_cast<int>(matches.size());
+}
+
 void AudioSystem::unloadAsset(uint32_t asset_id) {
     std::lock_guard<std::mutex> lock(assetsMutex);
     loadedAssets.erase(asset_id);
 
-    // TODO: Also unload from core audio engine
+    if (coreAudioEngine) {
+        coreAudioEngine->unloadSound(asset_id);
+    }
 }
 
 void AudioSystem::clearCache() {
@@ -929,6 +1000,12 @@ bool audio_load_sound_from_buffer_with_id(const float* samples, size_t sampleCou
     return g_audioSystem->loadSoundFromBuffer(samples, sampleCount, sampleRate, channels, sound_id);
 }
 
+void audio_unload_sound(uint32_t sound_id) {
+    if (g_audioSystem) {
+        g_audioSystem->unloadAsset(sound_id);
+    }
+}
+
 void audio_play_sound(uint32_t sound_id, float volume, float pitch, float pan) {
     if (g_audioSystem) {
         g_audioSystem->playSound(sound_id, volume, pitch, pan);
@@ -941,6 +1018,19 @@ void audio_stop_sound(uint32_t sound_id) {
     }
 }
 
+int audio_reload_sound_file(const char* filename) {
+    if (g_audioSystem && filename) {
+        return g_audioSystem->reloadSoundFile(filename);
+    }
+    return 0;
+}
+
+void audio_stop_all() {
+    if (g_audioSystem) {
+        g_audioSystem->stopAllSounds();
+    }
+}
+
 // Synthesis functions (Phase 2)
 
 uint32_t audio_create_oscillator(float frequency, int waveform) {
@@ -1076,6 +1166,18 @@ float audio_get_cpu_usage() {
     return 0.0f;
 }
 
+void audio_get_command_stats(uint64_t* enqueued, uint64_t* dropped,
+                             uint64_t* coalesced, uint64_t* processed) {
+    AudioCommandStats stats;
+    if (g_audioSystem) {
+        stats = g_audioSystem->getCommandStats();
+    }
+    if (enqueued) *enqueued = stats.enqueued;
+    if (dropped) *dropped = stats.dropped;
+    if (coalesced) *coalesced = stats.coalesced;
+    if (processed) *processed = stats.processed;
+}
+
 // High-level music functions (ABC notation)
 
 bool music_play(const char* abc_notation, const char* name, int tempo_bpm, int instrument) {
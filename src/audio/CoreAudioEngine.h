@@ -9,6 +9,7 @@
 #pragma once
 
 #include "AudioSystem.h"
+#include "VoicePool.h"
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -64,18 +65,12 @@ struct SoundEffect {
     SoundEffect() : id(0), buffer(nullptr), format(nullptr), duration(0.0f), frameLength(0) {}
 };
 
-// Active sound instance
-struct ActiveSound {
-    uint32_t instance_id;
-    uint32_t sound_id;
+// Pooled sound effect voice - the player node stays attached to the graph
+struct SoundVoice {
     AVAudioPlayerNode* playerNode;
-    float volume;
-    float pitch;
-    float pan;
-    bool isPlaying;
+    AVAudioFormat* format;      // Format the node is currently connected with
     
-    ActiveSound() : instance_id(0), sound_id(0), playerNode(nullptr),
-                    volume(1.0f), pitch(1.0f), pan(0.0f), isPlaying(false) {}
+    SoundVoice() : playerNode(nullptr), format(nullptr) {}
 };
 
 // Core Audio Engine - handles native macOS audio playback
@@ -114,6 +109,7 @@ public:
     
     void stopSoundEffect(uint32_t instance_id);
     void stopAllSounds();
+    void setVoiceStealPolicy(VoiceStealPolicy policy);
     
     // 3D Spatial Audio (future expansion)
     void setSoundPosition(uint32_t instance_id, float x, float y, float z);
@@ -165,10 +161,10 @@ private:
     std::unordered_map<uint32_t, std::unique_ptr<SoundEffect>> soundEffects;
     mutable std::mutex soundsMutex;
     
-    // Active sound instances
-    std::unordered_map<uint32_t, std::unique_ptr<ActiveSound>> activeSounds;
-    mutable std::mutex activesoundsMutex;
-    std::atomic<uint32_t> nextInstanceId{1};
+    // Sound effect voices (fixed pool, one connected player node per slot)
+    std::vector<SoundVoice> voices;
+    VoicePool voicePool;
+    mutable std::mutex voicesMutex;
     
     // System state
     std::atomic<float> masterVolume{1.0f};
@@ -187,9 +183,12 @@ private:
     SoundEffect* getSoundEffect(uint32_t sound_id);
     const SoundEffect* getSoundEffect(uint32_t sound_id) const;
     void cleanupSoundEffect(SoundEffect* sound);
-    uint32_t generateInstanceId();
-    void cleanupActiveSound(uint32_t instance_id);
-    void cleanupFinishedSounds();
+    void normalizeSoundFormat(SoundEffect* sound);
+    
+    // Voice pool helpers
+    bool setupVoices();
+    void cleanupVoices();
+    static uint64_t nowMs();
     
     // Audio file loading
     AVAudioFile* loadAudioFile(const std::string& filename);
@@ -9,6 +9,7 @@
 #include "CoreAudioEngine.h"
 #include <iostream>
 #include <algorithm>
+#include <chrono>
 #import <AVFoundation/AVFoundation.h>
 #import <AudioToolbox/AudioToolbox.h>
 
@@ -20,7 +21,6 @@ CoreAudioEngine::CoreAudioEngine()
     , spatialMixer(nil)
     , standardFormat(nil)
     , initialized(false)
-    , nextInstanceId(1)
     , masterVolume(1.0f)
     , mutedState(false)
     , memoryUsage(0)
@@ -120,6 +120,12 @@ bool CoreAudioEngine::setupAudioEngine() {
             return false;
         }
 
+        // Attach the sound effect voices once, before the engine starts
+        if (!setupVoices()) {
+            std::cerr << "CoreAudioEngine: Failed to create sound effect voices" << std::endl;
+            return false;
+        }
+
         // Start the audio engine
         NSError* error = nil;
         BOOL success = [audioEngine startAndReturnError:&error];
@@ -135,6 +141,8 @@ bool CoreAudioEngine::setupAudioEngine() {
 }
 
 void CoreAudioEngine::cleanupAudioEngine() {
+    cleanupVoices();
+
     @autoreleasepool {
         if (audioEngine) {
             [audioEngine stop];
@@ -314,6 +322,9 @@ bool CoreAudioEngine::loadSoundFile(const std::string& filename, uint32_t sound_
             return false;
         }
 
+        // Match the voices' format so triggering never reconnects a node
+        normalizeSoundFormat(sound.get());
+
         // Get buffer info
         sound->frameLength = [sound->buffer frameLength];
         sound->duration = (float)sound->frameLength / [sound->format sampleRate];
@@ -384,6 +395,10 @@ bool CoreAudioEngine::loadSoundFromBuffer(const float* samples, size_t sampleCou
         sound->frameLength = frameCount;
         sound->duration = static_cast<float>(frameCount) / sampleRate;
 
+        // Match the voices' format so triggering never reconnects a node
+        normalizeSoundFormat(sound.get());
+        sound->frameLength = [sound->buffer frameLength];
+
         // Store the sound
         soundEffects[sound_id] = std::move(sound);
 
@@ -520,81 +535,61 @@ bool CoreAudioEngine::exportSoundToPCMBytes(uint32_t sound_id, std::vector<uint8
 }
 
 uint32_t CoreAudioEngine::playSoundEffect(uint32_t sound_id, float volume, float pitch, float pan) {
-    std::lock_guard<std::mutex> soundsLock(soundsMutex);
+    AVAudioPCMBuffer* buffer = nil;
+    AVAudioFormat* format = nil;
+    uint64_t durationMs = 0;
+    {
+        std::lock_guard<std::mutex> soundsLock(soundsMutex);
+        SoundEffect* sound = getSoundEffect(sound_id);
+        if (!sound || !sound->buffer) {
+            std::cerr << "CoreAudioEngine: Cannot play sound - ID " << sound_id << " not found" << std::endl;
+            return 0;
+        }
+        buffer = sound->buffer;
+        format = sound->format;
+        durationMs = (uint64_t)(sound->duration * 1000.0f) + 1;
+    }
 
-    SoundEffect* sound = getSoundEffect(sound_id);
-    if (!sound) {
-        std::cerr << "CoreAudioEngine: Cannot play sound - ID " << sound_id << " not found" << std::endl;
+    // Trigger path: claim a pooled voice and reschedule its node. No node is
+    // created or attached here and nothing is allocated on our side.
+    std::lock_guard<std::mutex> lock(voicesMutex);
+    VoiceTrigger trigger = voicePool.trigger(sound_id, volume, nowMs(), durationMs);
+    if (trigger.slot < 0) {
         return 0;
     }
+    SoundVoice& voice = voices[trigger.slot];
 
     @autoreleasepool {
-        // Create active sound instance
-        auto activeSound = std::make_unique<ActiveSound>();
-        activeSound->instance_id = generateInstanceId();
-        activeSound->sound_id = sound_id;
-        activeSound->volume = volume;
-        activeSound->pitch = pitch;
-        activeSound->pan = pan;
-
-        // Create player node for this instance
-        activeSound->playerNode = createPlayerNode();
-        if (!activeSound->playerNode) {
-            std::cerr << "CoreAudioEngine: Failed to create player node for sound " << sound_id << std::endl;
-            return 0;
+        // Only sounds that could not be converted to the standard format
+        // need the node reconnected
+        if (voice.format != format && ![voice.format isEqual:format]) {
+            AVAudioNode* targetNode = config.enableSpatialAudio ? spatialMixer : mainMixer;
+            [audioEngine disconnectNodeOutput:voice.playerNode];
+            [audioEngine connect:voice.playerNode to:targetNode format:format];
+            voice.format = format;
         }
 
-        // Configure the player node
-        configurePlayerNode(activeSound->playerNode, volume, pitch, pan);
-
-        // Connect to mixer
-        AVAudioNode* targetNode = config.enableSpatialAudio ? spatialMixer : mainMixer;
-        [audioEngine connect:activeSound->playerNode to:targetNode format:sound->format];
-
-        // Schedule the buffer
-        uint32_t instance_id_capture = activeSound->instance_id;
-        [activeSound->playerNode scheduleBuffer:sound->buffer completionHandler:^{
-            // Mark as finished - find the sound by ID since activeSound pointer may be invalid
-            std::lock_guard<std::mutex> lock(activesoundsMutex);
-            auto it = activeSounds.find(instance_id_capture);
-            if (it != activeSounds.end()) {
-                it->second->isPlaying = false;
-            }
-        }];
+        configurePlayerNode(voice.playerNode, volume, pitch, pan);
 
-        // Start playback
-        [activeSound->playerNode play];
-        activeSound->isPlaying = true;
-
-        uint32_t instance_id = activeSound->instance_id;
-
-        // Store active sound
-        {
-            std::lock_guard<std::mutex> activeLock(activesoundsMutex);
-            activeSounds[instance_id] = std::move(activeSound);
+        // Interrupts whatever the voice was playing (including a stolen voice)
+        [voice.playerNode scheduleBuffer:buffer
+                                  atTime:nil
+                                 options:AVAudioPlayerNodeBufferInterrupts
+                       completionHandler:nil];
+        if (![voice.playerNode isPlaying]) {
+            [voice.playerNode play];
         }
-
-        std::cout << "CoreAudioEngine: Playing sound ID " << sound_id
-                  << " (instance: " << instance_id
-                  << ", volume: " << volume
-                  << ", pitch: " << pitch
-                  << ", pan: " << pan << ")" << std::endl;
-
-        return instance_id;
     }
+
+    return trigger.instanceId;
 }
 
 void CoreAudioEngine::stopSoundEffect(uint32_t instance_id) {
-    std::lock_guard<std::mutex> lock(activesoundsMutex);
+    std::lock_guard<std::mutex> lock(voicesMutex);
 
-    auto it = activeSounds.find(instance_id);
-    if (it != activeSounds.end()) {
-        ActiveSound* activeSound = it->second.get();
-        if (activeSound->isPlaying) {
-            [activeSound->playerNode stop];
-            activeSound->isPlaying = false;
-            std::cout << "CoreAudioEngine: Stopped sound instance " << instance_id << std::endl;
-        }
+    int slot = voicePool.release(instance_id);
+    if (slot >= 0) {
+        [voices[slot].playerNode stop];
     }
 }
 
@@ -614,21 +609,23 @@ void CoreAudioEngine::stopAllSounds() {
         }
     }
 
-    // Stop all active sound effects
+    // Stop all sound effect voices (nodes stay attached)
     {
-        std::lock_guard<std::mutex> lock(activesoundsMutex);
-        for (auto& pair : activeSounds) {
-            ActiveSound* activeSound = pair.second.get();
-            if (activeSound->isPlaying) {
-                [activeSound->playerNode stop];
-                activeSound->isPlaying = false;
-            }
+        std::lock_guard<std::mutex> lock(voicesMutex);
+        for (auto& voice : voices) {
+            [voice.playerNode stop];
         }
+        voicePool.releaseAll();
     }
 
     std::cout << "CoreAudioEngine: All sounds stopped" << std::endl;
 }
 
+void CoreAudioEngine::setVoiceStealPolicy(VoiceStealPolicy policy) {
+    std::lock_guard<std::mutex> lock(voicesMutex);
+    voicePool.setPolicy(policy);
+}
+
 // System control
 
 void CoreAudioEngine::setMasterVolume(float volume) {
@@ -672,17 +669,8 @@ size_t CoreAudioEngine::getLoadedSoundCount() const {
 }
 
 size_t CoreAudioEngine::getActiveSoundCount() const {
-    std::lock_guard<std::mutex> lock(activesoundsMutex);
-
-    // Clean up finished sounds and count active ones
-    size_t activeCount = 0;
-    for (const auto& pair : activeSounds) {
-        if (pair.second->isPlaying) {
-            activeCount++;
-        }
-    }
-
-    return activeCount;
+    std::lock_guard<std::mutex> lock(voicesMutex);
+    return voicePool.activeCount(nowMs());
 }
 
 // Memory management
@@ -709,6 +697,15 @@ void CoreAudioEngine::clearSoundCache() {
     updateMemoryUsage();
 }
 
+void CoreAudioEngine::unloadSound(uint32_t sound_id) {
+    std::lock_guard<std::mutex> lock(soundsMutex);
+
+    // Instances already playing keep their own reference to the buffer
+    if (soundEffects.erase(sound_id) > 0) {
+        updateMemoryUsage();
+    }
+}
+
 size_t CoreAudioEngine::getMemoryUsage() const {
     return memoryUsage.load();
 }
@@ -753,8 +750,113 @@ void CoreAudioEngine::cleanupMusicTrack(AudioMusicTrack* track) {
     }
 }
 
-uint32_t CoreAudioEngine::generateInstanceId() {
-    return nextInstanceId.fetch_add(1);
+// Voice pool
+
+bool CoreAudioEngine::setupVoices() {
+    std::lock_guard<std::mutex> lock(voicesMutex);
+
+    @autoreleasepool {
+        voicePool = VoicePool(config.maxVoices, voicePool.getPolicy());
+        voices.assign(voicePool.capacity(), SoundVoice());
+
+        AVAudioNode* targetNode = config.enableSpatialAudio ? spatialMixer : mainMixer;
+        for (auto& voice : voices) {
+            voice.playerNode = createPlayerNode();
+            if (!voice.playerNode) {
+                return false;
+            }
+            [audioEngine connect:voice.playerNode to:targetNode format:standardFormat];
+            voice.format = standardFormat;
+        }
+
+        std::cout << "CoreAudioEngine: Attached " << voices.size() << " sound effect voices" << std::endl;
+        return true;
+    }
+}
+
+void CoreAudioEngine::cleanupVoices() {
+    std::lock_guard<std::mutex> lock(voicesMutex);
+
+    @autoreleasepool {
+        for (auto& voice : voices) {
+            if (voice.playerNode) {
+                [voice.playerNode stop];
+                if (audioEngine) {
+                    [audioEngine detachNode:voice.playerNode];
+                }
+                voice.playerNode = nil;
+            }
+        }
+        voices.clear();
+        voicePool.releaseAll();
+    }
+}
+
+uint64_t CoreAudioEngine::nowMs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Convert a loaded sound to the standard format the voices are connected with
+void CoreAudioEngine::normalizeSoundFormat(SoundEffect* sound) {
+    if (!sound || !sound->buffer || !standardFormat || [sound->format isEqual:standardFormat]) {
+        return;
+    }
+
+    AVAudioPCMBuffer* converted = nil;
+    if (convertFormat(sound->buffer, standardFormat, &converted)) {
+        // The sound owns its buffer; nothing has scheduled the original yet
+        [sound->buffer release];
+        sound->buffer = converted;
+        sound->format = standardFormat;
+    }
+}
+
+bool CoreAudioEngine::convertFormat(AVAudioPCMBuffer* sourceBuffer, AVAudioFormat* targetFormat,
+                                    AVAudioPCMBuffer** outBuffer) {
+    @autoreleasepool {
+        AVAudioFormat* sourceFormat = sourceBuffer.format;
+        AVAudioConverter* converter = [[AVAudioConverter alloc] initFromFormat:sourceFormat toFormat:targetFormat];
+        if (!converter) {
+            return false;
+        }
+
+        // Mono sounds play on both channels
+        if (sourceFormat.channelCount == 1 && targetFormat.channelCount == 2) {
+            converter.channelMap = @[@0, @0];
+        }
+
+        double ratio = targetFormat.sampleRate / sourceFormat.sampleRate;
+        AVAudioFrameCount capacity = (AVAudioFrameCount)(sourceBuffer.frameLength * ratio) + 1024;
+        AVAudioPCMBuffer* converted = [[AVAudioPCMBuffer alloc] initWithPCMFormat:targetFormat frameCapacity:capacity];
+
+        __block BOOL supplied = NO;
+        NSError* error = nil;
+        AVAudioConverterOutputStatus status =
+            [converter convertToBuffer:converted
+                                 error:&error
+                    withInputFromBlock:^AVAudioBuffer*(AVAudioPacketCount inNumberOfPackets,
+                                                       AVAudioConverterInputStatus* outStatus) {
+                if (supplied) {
+                    *outStatus = AVAudioConverterInputStatus_EndOfStream;
+                    return nil;
+                }
+                supplied = YES;
+                *outStatus = AVAudioConverterInputStatus_HaveData;
+                return sourceBuffer;
+            }];
+        [converter release];
+
+        if (status == AVAudioConverterOutputStatus_Error) {
+            std::cerr << "CoreAudioEngine: Failed to convert sound to standard format: "
+                      << [[error localizedDescription] UTF8String] << std::endl;
+            [converted release];
+            return false;
+        }
+
+        *outBuffer = converted;
+        return true;
+    }
 }
 
 AVAudioFile* CoreAudioEngine::loadAudioFile(const std::string& filename) {
@@ -818,18 +920,11 @@ void CoreAudioEngine::configurePlayerNode(AVAudioPlayerNode* node, float volume,
     node.volume = volume * masterVolume.load();
 
     // Set pitch (rate)
-    if (pitch != 1.0f) {
-        // TODO: Implement pitch shifting using AVAudioUnitTimePitch in Phase 2
-        // For now, just log that pitch is requested
-        if (pitch != 1.0f) {
-            std::cout << "CoreAudioEngine: Pitch shifting (" << pitch << ") not implemented yet - Phase 2 feature" << std::endl;
-        }
-    }
+    // TODO: Implement pitch shifting using AVAudioUnitTimePitch in Phase 2.
+    // Not logged: this runs on the sound effect trigger path.
 
-    // Set pan
-    if (pan != 0.0f) {
-        node.pan = std::clamp(pan, -1.0f, 1.0f);
-    }
+    // Set pan (always, pooled nodes keep the previous sound's pan)
+    node.pan = std::clamp(pan, -1.0f, 1.0f);
 }
 
 void CoreAudioEngine::updateMemoryUsage() {
@@ -0,0 +1,166 @@
+//
+//  GrainScheduler.cpp
+//  SuperTerminal Framework - Granular Synthesis Grain Scheduler
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "GrainScheduler.h"
+#include <algorithm>
+#include <cmath>
+
+GrainScheduler::GrainScheduler(const GrainSchedulerConfig& schedulerConfig)
+    : config(schedulerConfig)
+{
+    config.overlap = std::min(std::max(config.overlap, 0.0f), 0.99f);
+    config.onsetJitter = std::min(std::max(config.onsetJitter, 0.0f), 1.0f);
+
+    uint32_t grainLength = std::max<uint32_t>(1, (uint32_t)std::lround(config.grainSize * config.sampleRate));
+    window.resize(grainLength);
+    for (uint32_t i = 0; i < grainLength; i++) {
+        window[i] = 0.5f * (1.0f - std::cos(2.0f * (float)M_PI * i / grainLength));
+    }
+
+    // Wavetable lookups mask with a power-of-two size
+    if (!config.wavetable.empty()) {
+        size_t size = 1;
+        while (size * 2 <= config.wavetable.size()) {
+            size *= 2;
+            tableBits++;
+        }
+        config.wavetable.resize(size);
+    }
+
+    spacing = std::max(1.0, grainLength * (1.0 - config.overlap));
+
+    // Jittered onsets stay within half a spacing of nominal, so at most
+    // ceil(length / spacing) + 2 grains ever overlap one sample
+    grains.resize((size_t)std::ceil(grainLength / spacing) + 3);
+
+    reset();
+}
+
+void GrainScheduler::reset() {
+    head = 0;
+    activeCount = 0;
+    nextGrainIndex = 0;
+    position = 0;
+    grainsStarted = 0;
+    rngState = config.seed ? config.seed : 1;
+    scheduleNextOnset();
+}
+
+float GrainScheduler::nextRandom() {
+    // xorshift32: cheap and identical on every platform
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return (rngState >> 8) * (1.0f / 16777216.0f);
+}
+
+void GrainScheduler::scheduleNextOnset() {
+    double nominal = nextGrainIndex * spacing;
+    double jitter = config.onsetJitter * spacing * (nextRandom() - 0.5);
+    nextOnset = (uint64_t)std::max(0.0, std::floor(nominal + jitter));
+    nextGrainIndex++;
+}
+
+void GrainScheduler::spawn(uint64_t onset) {
+    size_t capacity = grains.size();
+    if (activeCount == capacity) {
+        // Cannot happen with the sizing above; drop the oldest rather than grow
+        head = (head + 1) % capacity;
+        activeCount--;
+    }
+
+    float frequency = config.frequency * (1.0f + config.pitchJitter * 2.0f * (nextRandom() - 0.5f));
+    double cyclesPerSample = std::max(0.0f, frequency) / config.sampleRate;
+
+    Grain& grain = grains[(head + activeCount) % capacity];
+    grain.onset = onset;
+    grain.phase = 0;
+    grain.increment = (uint32_t)std::min(4294967295.0, cyclesPerSample * 4294967296.0);
+    grain.noiseState = rngState ^ 0x9E3779B9u;
+    if (grain.noiseState == 0) grain.noiseState = 1;
+    activeCount++;
+    grainsStarted++;
+}
+
+void GrainScheduler::mixGrain(Grain& grain, float* out, uint64_t blockStart, size_t frames) {
+    uint64_t grainEnd = grain.onset + window.size();
+    uint64_t blockEnd = blockStart + frames;
+    uint64_t start = std::max(grain.onset, blockStart);
+    uint64_t end = std::min(grainEnd, blockEnd);
+    if (start >= end) return;
+
+    const float* env = window.data() + (start - grain.onset);
+    float* dst = out + (start - blockStart);
+    size_t count = (size_t)(end - start);
+    float gain = config.gain;
+
+    if (config.wavetable.empty()) {
+        uint32_t state = grain.noiseState;
+        for (size_t i = 0; i < count; i++) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            float noise = (state >> 8) * (2.0f / 16777216.0f) - 1.0f;
+            dst[i] += noise * env[i] * gain;
+        }
+        grain.noiseState = state;
+        return;
+    }
+
+    const float* table = config.wavetable.data();
+    uint32_t tableMask = (1u << tableBits) - 1;
+    uint32_t shift = 32 - tableBits;
+    uint32_t phase = grain.phase;
+    uint32_t increment = grain.increment;
+    const float fracScale = 1.0f / (float)(1ull << shift);
+    uint32_t fracMask = (uint32_t)((1ull << shift) - 1);
+
+    for (size_t i = 0; i < count; i++) {
+        uint32_t index = tableBits ? (phase >> shift) : 0;
+        float frac = (float)(phase & fracMask) * fracScale;
+        float a = table[index];
+        float b = table[(index + 1) & tableMask];
+        dst[i] += (a + (b - a) * frac) * env[i] * gain;
+        phase += increment;
+    }
+    grain.phase = phase;
+}
+
+void GrainScheduler::render(float* out, size_t frames) {
+    uint64_t blockStart = position;
+    uint64_t blockEnd = blockStart + frames;
+    size_t capacity = grains.size();
+
+    // Walk the block onset to onset so the active list only ever holds the
+    // grains overlapping the current segment
+    uint64_t segmentStart = blockStart;
+    while (segmentStart < blockEnd) {
+        uint64_t segmentEnd = std::min(blockEnd, std::max(nextOnset, segmentStart));
+        if (segmentEnd > segmentStart) {
+            for (size_t i = 0; i < activeCount; i++) {
+                mixGrain(grains[(head + i) % capacity], out + (segmentStart - blockStart),
+                         segmentStart, (size_t)(segmentEnd - segmentStart));
+            }
+
+            // Retire finished grains from the front (earliest onset finishes first)
+            while (activeCount > 0 && grains[head].onset + window.size() <= segmentEnd) {
+                head = (head + 1) % capacity;
+                activeCount--;
+            }
+        }
+
+        // Start every grain due at this point
+        while (nextOnset <= segmentEnd && nextOnset < blockEnd) {
+            spawn(nextOnset);
+            scheduleNextOnset();
+        }
+        segmentStart = segmentEnd;
+    }
+
+    position = blockEnd;
+}
@@ -0,0 +1,82 @@
+//
+//  GrainScheduler.h
+//  SuperTerminal Framework - Granular Synthesis Grain Scheduler
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+//  Streaming grain scheduler for granular synthesis. Grains are spawned at
+//  a fixed spacing (with seeded onset and pitch jitter drawn once per grain)
+//  and kept in an active list ordered by onset, so rendering a block costs
+//  the number of overlapping grains rather than every grain in the sound.
+//  The window and grain waveform are tables built once at construction.
+//  Output depends only on the config and seed, not on the block sizes used
+//  to render it. No platform dependencies.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct GrainSchedulerConfig {
+    uint32_t sampleRate = 44100;
+    float grainSize = 0.05f;        // Grain length in seconds
+    float overlap = 0.5f;           // 0 = back to back, 0.9 = ten grains deep
+    float frequency = 440.0f;       // Grain oscillator frequency
+    float pitchJitter = 0.0f;       // +/- fraction of frequency, per grain
+    float onsetJitter = 0.0f;       // +/- fraction of grain spacing, per grain (0-1)
+    float gain = 1.0f;              // Per-grain amplitude
+    uint32_t seed = 12345;
+
+    // One cycle of the grain waveform; empty = white noise grains
+    std::vector<float> wavetable;
+};
+
+class GrainScheduler {
+public:
+    explicit GrainScheduler(const GrainSchedulerConfig& config);
+
+    // Mix the next `frames` mono samples into out (out is added to, not cleared)
+    void render(float* out, size_t frames);
+
+    // Restart from sample 0 with the original seed
+    void reset();
+
+    uint64_t getPosition() const { return position; }
+    size_t getActiveGrainCount() const { return activeCount; }
+    size_t getMaxActiveGrains() const { return grains.size(); }
+    uint64_t getGrainsStarted() const { return grainsStarted; }
+    uint32_t getGrainLength() const { return (uint32_t)window.size(); }
+
+private:
+    struct Grain {
+        uint64_t onset;         // Absolute sample index
+        uint32_t phase;         // 32-bit fixed-point cycle position
+        uint32_t increment;
+        uint32_t noiseState;    // Noise grains only
+    };
+
+    GrainSchedulerConfig config;
+    std::vector<float> window;          // Hann, one entry per grain sample
+    uint32_t tableBits = 0;
+
+    // Active grains as a ring ordered by onset (all grains share one length,
+    // so they also finish in this order)
+    std::vector<Grain> grains;
+    size_t head = 0;
+    size_t activeCount = 0;
+
+    double spacing = 1.0;               // Samples between nominal onsets
+    uint64_t nextGrainIndex = 0;
+    uint64_t nextOnset = 0;             // Onset of the next grain to spawn
+    uint64_t position = 0;              // Next sample to render
+    uint64_t grainsStarted = 0;
+    uint32_t rngState = 0;
+
+    float nextRandom();                 // [0, 1)
+    void scheduleNextOnset();
+    void spawn(uint64_t onset);
+    void mixGrain(Grain& grain, float* out, uint64_t blockStart, size_t frames);
+};
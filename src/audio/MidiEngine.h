@@ -64,6 +64,14 @@ struct MidiProgramChange {
         : channel(ch), program(prog), time(t) {}
 };
 
+struct MidiTempoChange {
+    double time;       // Time in beats
+    double bpm;
+    
+    MidiTempoChange(double t = 0.0, double b = 120.0)
+        : time(t), bpm(b) {}
+};
+
 // MIDI Track for tracker-style composition
 class MidiTrack {
 public:
@@ -105,6 +113,7 @@ public:
     int timeSignatureDen;   // Time signature denominator
     double length;          // Total length in beats
     std::vector<std::unique_ptr<MidiTrack>> tracks;
+    std::vector<MidiTempoChange> tempoChanges;  // Tempo map from loaded files (after the initial tempo)
     
     MidiSequence(const std::string& seqName = "Sequence", double bpm = 120.0);
     ~MidiSequence();
@@ -139,6 +148,7 @@ public:
     bool isInitialized() const { return initialized; }
     
     // File-based MIDI playback
+    // loadMidiFile reads a type 0/1 SMF into sequence sequenceId (replacing it)
     bool loadMidiFile(const std::string& filename, int sequenceId);
     bool playMidiFile(int sequenceId, float volume = 1.0, bool loop = false);
     void stopMidiFile(int sequenceId);
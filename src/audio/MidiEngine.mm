@@ -7,6 +7,7 @@
 //
 
 #include "MidiEngine.h"
+#include "MidiFileReader.h"
 #include "CoreAudioEngine.h"
 #include "SynthEngine.h"
 #include <iostream>
@@ -259,42 +260,93 @@ void MidiEngine::shutdown() {
 }
 
 bool MidiEngine::loadMidiFile(const std::string& filename, int sequenceId) {
-#ifdef __APPLE__
     logInfo("MidiEngine: Loading MIDI file: " + filename);
 
-    CFURLRef fileURL = CFURLCreateFromFileSystemRepresentation(kCFAllocatorDefault,
-                                                                (const UInt8*)filename.c_str(),
-                                                                filename.length(),
-                                                                false);
-    if (!fileURL) {
-        logError("MidiEngine: Could not create URL for file: " + filename);
+    MidiFileReader reader;
+    std::vector<MidiFileEvent> events;
+    if (!reader.open(filename) || !reader.readMerged(events)) {
+        logError("MidiEngine: " + reader.getError());
         return false;
     }
 
-    MusicSequence musicSequence;
-    OSStatus result = NewMusicSequence(&musicSequence);
-    if (result != noErr) {
-        logError("MidiEngine: Could not create music sequence");
-        CFRelease(fileURL);
-        return false;
+    const MidiTempoMap& tempoMap = reader.getTempoMap();
+    size_t nameStart = filename.find_last_of('/');
+    auto sequence = std::make_unique<MidiSequence>(
+        nameStart == std::string::npos ? filename : filename.substr(nameStart + 1),
+        tempoMap.getBpmAt(0));
+    for (size_t i = 0; i < reader.getTrackCount(); i++) {
+        sequence->addTrack("Track " + std::to_string(i + 1));
     }
 
-    result = MusicSequenceFileLoad(musicSequence, fileURL, kMusicSequenceFile_MIDIType, kMusicSequenceLoadSMF_ChannelsToTracks);
-    CFRelease(fileURL);
+    // Pair note on/off per track, channel and key (first on, first off)
+    struct PendingNote {
+        double startTime;
+        int velocity;
+    };
+    std::unordered_map<uint32_t, std::vector<PendingNote>> pendingNotes;
+    std::vector<bool> channelAssigned(reader.getTrackCount(), false);
+
+    for (const MidiFileEvent& event : events) {
+        MidiTrack* track = sequence->getTrack(event.track);
+        double beats = tempoMap.ticksToBeats(event.tick);
+
+        if (event.isChannelEvent()) {
+            int channel = event.getChannel() + 1;
+            if (!channelAssigned[event.track]) {
+                track->channel = channel;
+                channelAssigned[event.track] = true;
+            }
 
-    if (result != noErr) {
-        logError("MidiEngine: Could not load MIDI file");
-        DisposeMusicSequence(musicSequence);
-        return false;
+            uint32_t key = (uint32_t(event.track) << 16) | (uint32_t(event.getChannel()) << 8) | event.data1;
+            if (event.isNoteOn()) {
+                pendingNotes[key].push_back({beats, event.data2});
+            } else if (event.isNoteOff()) {
+                auto it = pendingNotes.find(key);
+                if (it != pendingNotes.end() && !it->second.empty()) {
+                    PendingNote note = it->second.front();
+                    it->second.erase(it->second.begin());
+                    track->notes.emplace_back(channel, event.data1, note.velocity, note.startTime, beats - note.startTime);
+                }
+            } else if (event.getType() == 0xB0) {
+                track->controlChanges.emplace_back(channel, event.data1, event.data2, beats);
+            } else if (event.getType() == 0xC0) {
+                track->programChanges.emplace_back(channel, event.data1, beats);
+            }
+        } else if (event.isTempo()) {
+            if (event.tick > 0) {
+                sequence->tempoChanges.emplace_back(beats, 60000000.0 / event.getMicrosPerQuarter());
+            }
+        } else if (event.isMeta() && event.metaType == 0x58 && event.payloadLength >= 2 && event.tick == 0) {
+            sequence->setTimeSignature(event.payload[0], 1 << std::min<int>(event.payload[1], 6));
+        } else if (event.isMeta() && event.metaType == 0x03 && event.payloadLength > 0) {
+            track->name.assign(reinterpret_cast<const char*>(event.payload), event.payloadLength);
+        }
+    }
+
+    // Notes never released run to the end of the file
+    double endBeats = events.empty() ? 0.0 : tempoMap.ticksToBeats(events.back().tick);
+    for (const auto& entry : pendingNotes) {
+        MidiTrack* track = sequence->getTrack(entry.first >> 16);
+        for (const PendingNote& note : entry.second) {
+            track->notes.emplace_back(int((entry.first >> 8) & 0xFF) + 1, int(entry.first & 0xFF), note.velocity,
+                                      note.startTime, endBeats - note.startTime);
+        }
+    }
+    for (auto& track : sequence->tracks) {
+        std::stable_sort(track->notes.begin(), track->notes.end(),
+                         [](const MidiNote& a, const MidiNote& b) { return a.startTime < b.startTime; });
     }
+    sequence->calculateLength();
 
-    // Store the loaded sequence (simplified - would need proper management)
-    logInfo("MidiEngine: MIDI file loaded successfully");
+    std::lock_guard<std::mutex> lock(sequenceMutex);
+    logInfo("MidiEngine: Loaded " + std::to_string(events.size()) + " events in " +
+            std::to_string(reader.getTrackCount()) + " tracks into sequence ID " + std::to_string(sequenceId));
+    sequences[sequenceId] = std::move(sequence);
+    sequencePlaying[sequenceId] = false;
+    sequenceVolumes[sequenceId] = 1.0f;
+    sequenceLooping[sequenceId] = false;
+    nextSequenceId = std::max(nextSequenceId, sequenceId + 1);
     return true;
-#else
-    logError("MidiEngine: MIDI file loading not implemented for this platform");
-    return false;
-#endif
 }
 
 int MidiEngine::createSequence(const std::string& name, double tempo) {
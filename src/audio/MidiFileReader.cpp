@@ -0,0 +1,470 @@
+//
+//  MidiFileReader.cpp
+//  SuperTerminal - Standard MIDI File Reader
+//
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "MidiFileReader.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <queue>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SuperTerminal {
+
+namespace {
+
+inline uint32_t readBigEndian32(const uint8_t* p) {
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+inline uint16_t readBigEndian16(const uint8_t* p) {
+    return uint16_t((p[0] << 8) | p[1]);
+}
+
+} // namespace
+
+// =====================================================
+// MidiFileEvent
+// =====================================================
+
+uint32_t MidiFileEvent::getMicrosPerQuarter() const {
+    if (!isTempo()) return MidiTempoMap::DEFAULT_MICROS_PER_QUARTER;
+    return (uint32_t(payload[0]) << 16) | (uint32_t(payload[1]) << 8) | uint32_t(payload[2]);
+}
+
+// =====================================================
+// MidiTempoMap
+// =====================================================
+
+MidiTempoMap::MidiTempoMap(uint16_t division) {
+    if (division & 0x8000) {
+        // SMPTE: high byte is -frames per second, low byte ticks per frame.
+        // Tempo changes do not move the clock.
+        smpte = true;
+        int framesPerSecond = -static_cast<int8_t>(division >> 8);
+        uint32_t ticksPerFrame = std::max<uint32_t>(1, division & 0xFF);
+        if (framesPerSecond == 29) {
+            // 29.97 drop frame
+            smpteMicrosNumerator = 1000000ull * 1001;
+            smpteMicrosDenominator = 30000ull * ticksPerFrame;
+        } else {
+            smpteMicrosNumerator = 1000000ull;
+            smpteMicrosDenominator = uint64_t(std::max(1, framesPerSecond)) * ticksPerFrame;
+        }
+    } else {
+        ticksPerQuarter = std::max<uint16_t>(1, division);
+    }
+    segments.push_back({0, DEFAULT_MICROS_PER_QUARTER, 0});
+}
+
+void MidiTempoMap::addTempo(uint64_t tick, uint32_t microsPerQuarter) {
+    if (microsPerQuarter == 0) return;
+
+    Segment& last = segments.back();
+    tick = std::max(tick, last.tick);
+    if (tick == last.tick) {
+        last.microsPerQuarter = microsPerQuarter;
+        return;
+    }
+    uint64_t scaled = last.scaledMicros + (tick - last.tick) * last.microsPerQuarter;
+    segments.push_back({tick, microsPerQuarter, scaled});
+}
+
+size_t MidiTempoMap::findSegment(uint64_t tick) const {
+    auto it = std::upper_bound(segments.begin(), segments.end(), tick,
+                               [](uint64_t t, const Segment& segment) { return t < segment.tick; });
+    return static_cast<size_t>(it - segments.begin()) - 1;
+}
+
+void MidiTempoMap::getExactMicros(uint64_t tick, uint64_t& microsNumerator, uint64_t& microsDenominator) const {
+    if (smpte) {
+        microsNumerator = tick * smpteMicrosNumerator;
+        microsDenominator = smpteMicrosDenominator;
+        return;
+    }
+    const Segment& segment = segments[findSegment(tick)];
+    microsNumerator = segment.scaledMicros + (tick - segment.tick) * segment.microsPerQuarter;
+    microsDenominator = ticksPerQuarter;
+}
+
+uint64_t MidiTempoMap::ticksToMicros(uint64_t tick) const {
+    uint64_t numerator, denominator;
+    getExactMicros(tick, numerator, denominator);
+    return (numerator + denominator / 2) / denominator;
+}
+
+double MidiTempoMap::ticksToSeconds(uint64_t tick) const {
+    // Split before converting so long files keep full double precision
+    uint64_t numerator, denominator;
+    getExactMicros(tick, numerator, denominator);
+    uint64_t whole = numerator / denominator;
+    uint64_t remainder = numerator % denominator;
+    return (static_cast<double>(whole) + static_cast<double>(remainder) / denominator) * 1e-6;
+}
+
+uint64_t MidiTempoMap::secondsToTicks(double seconds) const {
+    if (seconds <= 0.0) return 0;
+    if (smpte) {
+        return static_cast<uint64_t>(std::floor(seconds * 1e6 * smpteMicrosDenominator / smpteMicrosNumerator));
+    }
+
+    // scaledMicros is monotonic, so search on it directly
+    uint64_t target = static_cast<uint64_t>(std::floor(seconds * 1e6 * ticksPerQuarter));
+    auto it = std::upper_bound(segments.begin(), segments.end(), target,
+                               [](uint64_t t, const Segment& segment) { return t < segment.scaledMicros; });
+    const Segment& segment = *(it - 1);
+    return segment.tick + (target - segment.scaledMicros) / segment.microsPerQuarter;
+}
+
+double MidiTempoMap::ticksToBeats(uint64_t tick) const {
+    if (smpte) {
+        // No beat grid in SMPTE files; measure against the tempo in effect
+        return static_cast<double>(ticksToMicros(tick)) / getMicrosPerQuarterAt(tick);
+    }
+    return static_cast<double>(tick) / ticksPerQuarter;
+}
+
+uint32_t MidiTempoMap::getMicrosPerQuarterAt(uint64_t tick) const {
+    return segments[findSegment(tick)].microsPerQuarter;
+}
+
+// =====================================================
+// MidiFileReader::TrackCursor
+// =====================================================
+
+bool MidiFileReader::TrackCursor::readVariableLength(uint32_t& value) {
+    value = 0;
+    for (int i = 0; i < 4; i++) {
+        if (position >= end) return false;
+        uint8_t byte = *position++;
+        value = (value << 7) | (byte & 0x7F);
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+bool MidiFileReader::TrackCursor::next(MidiFileEvent& event) {
+    if (finished || error) return false;
+    if (position >= end) {
+        // Missing end-of-track meta is common enough to tolerate
+        finished = true;
+        return false;
+    }
+
+    uint32_t delta;
+    if (!readVariableLength(delta) || position >= end) {
+        error = true;
+        return false;
+    }
+    tick += delta;
+
+    uint8_t status;
+    if (*position & 0x80) {
+        status = *position++;
+    } else if (runningStatus != 0) {
+        status = runningStatus;
+    } else {
+        error = true;
+        return false;
+    }
+
+    event = MidiFileEvent();
+    event.tick = tick;
+    event.track = trackIndex;
+    event.status = status;
+
+    if (status < 0xF0) {
+        runningStatus = status;
+        uint8_t type = status & 0xF0;
+        ptrdiff_t length = (type == 0xC0 || type == 0xD0) ? 1 : 2;
+        if (end - position < length) {
+            error = true;
+            return false;
+        }
+        event.data1 = position[0] & 0x7F;
+        event.data2 = length == 2 ? (position[1] & 0x7F) : 0;
+        position += length;
+        return true;
+    }
+
+    // Meta and sysex events cancel running status
+    runningStatus = 0;
+    if (status == 0xFF) {
+        if (position >= end) {
+            error = true;
+            return false;
+        }
+        event.metaType = *position++;
+    } else if (status != 0xF0 && status != 0xF7) {
+        error = true;
+        return false;
+    }
+
+    uint32_t length;
+    if (!readVariableLength(length) || length > static_cast<size_t>(end - position)) {
+        error = true;
+        return false;
+    }
+    event.payload = position;
+    event.payloadLength = length;
+    position += length;
+
+    if (event.isEndOfTrack()) {
+        finished = true;
+    }
+    return true;
+}
+
+// =====================================================
+// MidiFileReader
+// =====================================================
+
+MidiFileReader::MidiFileReader() {
+}
+
+MidiFileReader::~MidiFileReader() {
+    close();
+}
+
+bool MidiFileReader::fail(const std::string& message) const {
+    errorMessage = message;
+    return false;
+}
+
+bool MidiFileReader::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return fail("Cannot open MIDI file: " + path);
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return fail("Cannot read MIDI file: " + path);
+    }
+
+    void* mapping = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return fail("Cannot map MIDI file: " + path);
+    }
+    posix_madvise(mapping, static_cast<size_t>(info.st_size), POSIX_MADV_SEQUENTIAL);
+
+    data = static_cast<const uint8_t*>(mapping);
+    size = static_cast<size_t>(info.st_size);
+    mapped = true;
+
+    if (!parseChunks()) {
+        std::string message = errorMessage;
+        close();
+        errorMessage = message;
+        return false;
+    }
+    return true;
+}
+
+bool MidiFileReader::openMemory(const uint8_t* bytes, size_t byteCount) {
+    close();
+    if (!bytes || byteCount == 0) {
+        return fail("Empty MIDI data");
+    }
+
+    data = bytes;
+    size = byteCount;
+    mapped = false;
+
+    if (!parseChunks()) {
+        std::string message = errorMessage;
+        close();
+        errorMessage = message;
+        return false;
+    }
+    return true;
+}
+
+void MidiFileReader::close() {
+    if (mapped && data) {
+        munmap(const_cast<uint8_t*>(data), size);
+    }
+    data = nullptr;
+    size = 0;
+    mapped = false;
+    format = 0;
+    division = 0;
+    tracks.clear();
+    errorMessage.clear();
+    tempoMap = MidiTempoMap();
+    tempoMapBuilt = false;
+}
+
+bool MidiFileReader::parseChunks() {
+    if (size < 14 || std::memcmp(data, "MThd", 4) != 0) {
+        return fail("Not a Standard MIDI File");
+    }
+
+    uint32_t headerLength = readBigEndian32(data + 4);
+    if (headerLength < 6 || headerLength > size - 8) {
+        return fail("Invalid MIDI header");
+    }
+
+    format = readBigEndian16(data + 8);
+    division = readBigEndian16(data + 12);
+    if (format > 1) {
+        return fail("Unsupported MIDI file format " + std::to_string(format));
+    }
+
+    // Index MTrk chunks; unknown chunks are skipped, a truncated last
+    // chunk is read up to the end of the file
+    size_t position = 8 + headerLength;
+    while (size - position >= 8) {
+        uint32_t chunkLength = readBigEndian32(data + position + 4);
+        size_t chunkStart = position + 8;
+        size_t available = size - chunkStart;
+        size_t chunkEnd = chunkStart + std::min<size_t>(chunkLength, available);
+
+        if (std::memcmp(data + position, "MTrk", 4) == 0) {
+            tracks.push_back({data + chunkStart, data + chunkEnd});
+        }
+        if (chunkLength > available) break;
+        position = chunkEnd;
+    }
+
+    if (tracks.empty()) {
+        return fail("MIDI file has no tracks");
+    }
+
+    tempoMap = MidiTempoMap(division);
+    tempoMapBuilt = false;
+    return true;
+}
+
+MidiFileReader::TrackCursor MidiFileReader::openTrack(size_t index) const {
+    TrackCursor cursor;
+    if (index < tracks.size()) {
+        cursor.position = tracks[index].start;
+        cursor.end = tracks[index].end;
+        cursor.trackIndex = static_cast<uint16_t>(index);
+        cursor.finished = false;
+    }
+    return cursor;
+}
+
+bool MidiFileReader::readTrack(size_t index, std::vector<MidiFileEvent>& events) const {
+    if (index >= tracks.size()) {
+        return fail("Track index out of range");
+    }
+
+    TrackCursor cursor = openTrack(index);
+    MidiFileEvent event;
+    while (cursor.next(event)) {
+        events.push_back(event);
+    }
+    if (cursor.hasError()) {
+        return fail("Malformed data in track " + std::to_string(index));
+    }
+    return true;
+}
+
+bool MidiFileReader::readMerged(std::vector<MidiFileEvent>& events) const {
+    if (!isOpen()) {
+        return fail("No MIDI file open");
+    }
+
+    // K-way merge over per-track cursors; each track is already in tick order
+    struct Head {
+        MidiFileEvent event;
+        size_t cursor;
+    };
+    auto later = [](const Head& a, const Head& b) {
+        if (a.event.tick != b.event.tick) return a.event.tick > b.event.tick;
+        return a.event.track > b.event.track;
+    };
+
+    std::vector<TrackCursor> cursors;
+    cursors.reserve(tracks.size());
+    std::vector<Head> heap;
+    heap.reserve(tracks.size());
+    for (size_t i = 0; i < tracks.size(); i++) {
+        cursors.push_back(openTrack(i));
+        Head head;
+        head.cursor = i;
+        if (cursors[i].next(head.event)) {
+            heap.push_back(head);
+        }
+    }
+    std::make_heap(heap.begin(), heap.end(), later);
+
+    // Roughly three bytes per event with running status
+    events.reserve(events.size() + size / 3);
+
+    MidiTempoMap map(division);
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        Head& head = heap.back();
+        if (head.event.isTempo()) {
+            map.addTempo(head.event.tick, head.event.getMicrosPerQuarter());
+        }
+        events.push_back(head.event);
+
+        if (cursors[head.cursor].next(head.event)) {
+            std::push_heap(heap.begin(), heap.end(), later);
+        } else {
+            heap.pop_back();
+        }
+    }
+
+    for (const TrackCursor& cursor : cursors) {
+        if (cursor.hasError()) {
+            return fail("Malformed data in track " + std::to_string(cursor.getTrackIndex()));
+        }
+    }
+
+    tempoMap = map;
+    tempoMapBuilt = true;
+    return true;
+}
+
+const MidiTempoMap& MidiFileReader::getTempoMap() const {
+    if (tempoMapBuilt || !isOpen()) {
+        return tempoMap;
+    }
+
+    // Collect tempo metas from every track, then apply in time order
+    // (ties in track order, matching readMerged)
+    struct TempoChange {
+        uint64_t tick;
+        uint16_t track;
+        uint32_t microsPerQuarter;
+    };
+    std::vector<TempoChange> changes;
+    for (size_t i = 0; i < tracks.size(); i++) {
+        TrackCursor cursor = openTrack(i);
+        MidiFileEvent event;
+        while (cursor.next(event)) {
+            if (event.isTempo()) {
+                changes.push_back({event.tick, event.track, event.getMicrosPerQuarter()});
+            }
+        }
+    }
+    std::stable_sort(changes.begin(), changes.end(), [](const TempoChange& a, const TempoChange& b) {
+        return a.tick < b.tick;
+    });
+
+    MidiTempoMap map(division);
+    for (const TempoChange& change : changes) {
+        map.addTempo(change.tick, change.microsPerQuarter);
+    }
+    tempoMap = map;
+    tempoMapBuilt = true;
+    return tempoMap;
+}
+
+} // namespace SuperTerminal
@@ -0,0 +1,164 @@
+//
+//  MidiFileReader.h
+//  SuperTerminal - Standard MIDI File Reader
+//
+//  Zero-copy reader for type 0 and type 1 SMF files. The file is memory
+//  mapped, only chunk boundaries are indexed on open, and tracks are decoded
+//  on demand through cursors. Meta and sysex payloads point straight into
+//  the mapping, so events are only valid while the reader stays open.
+//
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SuperTerminal {
+
+// One decoded event, absolute tick time
+struct MidiFileEvent {
+    uint64_t tick = 0;
+    uint16_t track = 0;
+    uint8_t status = 0;                 // 0x80-0xEF channel, 0xF0/0xF7 sysex, 0xFF meta
+    uint8_t data1 = 0;
+    uint8_t data2 = 0;
+    uint8_t metaType = 0;               // Meta events only
+    const uint8_t* payload = nullptr;   // Meta/sysex bytes inside the file
+    uint32_t payloadLength = 0;
+
+    bool isChannelEvent() const { return status >= 0x80 && status < 0xF0; }
+    bool isMeta() const { return status == 0xFF; }
+    bool isSysex() const { return status == 0xF0 || status == 0xF7; }
+    uint8_t getType() const { return status & 0xF0; }
+    uint8_t getChannel() const { return status & 0x0F; }
+    bool isNoteOn() const { return getType() == 0x90 && data2 > 0; }
+    bool isNoteOff() const { return getType() == 0x80 || (getType() == 0x90 && data2 == 0); }
+    bool isTempo() const { return isMeta() && metaType == 0x51 && payloadLength == 3; }
+    bool isEndOfTrack() const { return isMeta() && metaType == 0x2F; }
+    uint32_t getMicrosPerQuarter() const;
+};
+
+// Tick -> time conversion. Time is kept as an exact integer sum of
+// ticks x microseconds-per-quarter, so a value late in a long file is one
+// division away from exact instead of an accumulation of rounding errors.
+class MidiTempoMap {
+public:
+    struct Segment {
+        uint64_t tick;
+        uint32_t microsPerQuarter;
+        uint64_t scaledMicros;          // Microseconds x ticksPerQuarter at tick
+    };
+
+    static constexpr uint32_t DEFAULT_MICROS_PER_QUARTER = 500000;  // 120 BPM
+
+    explicit MidiTempoMap(uint16_t division = 480);
+
+    // Changes must arrive in tick order; a later change at the same tick wins
+    void addTempo(uint64_t tick, uint32_t microsPerQuarter);
+
+    // Exact time is microsNumerator / microsDenominator
+    void getExactMicros(uint64_t tick, uint64_t& microsNumerator, uint64_t& microsDenominator) const;
+    uint64_t ticksToMicros(uint64_t tick) const;     // Rounded to nearest
+    double ticksToSeconds(uint64_t tick) const;
+    uint64_t secondsToTicks(double seconds) const;   // Last tick at or before
+    double ticksToBeats(uint64_t tick) const;
+
+    uint32_t getMicrosPerQuarterAt(uint64_t tick) const;
+    double getBpmAt(uint64_t tick) const { return 60000000.0 / getMicrosPerQuarterAt(tick); }
+
+    bool isSmpte() const { return smpte; }
+    uint16_t getTicksPerQuarter() const { return ticksPerQuarter; }
+    const std::vector<Segment>& getSegments() const { return segments; }
+
+private:
+    bool smpte = false;
+    uint16_t ticksPerQuarter = 480;
+    uint64_t smpteMicrosNumerator = 0;  // SMPTE: micros per tick as a ratio
+    uint64_t smpteMicrosDenominator = 1;
+    std::vector<Segment> segments;
+
+    size_t findSegment(uint64_t tick) const;
+};
+
+class MidiFileReader {
+public:
+    // Decodes one track chunk on demand
+    class TrackCursor {
+    public:
+        // False at end of track or on malformed data (see hasError)
+        bool next(MidiFileEvent& event);
+        bool hasError() const { return error; }
+        bool isFinished() const { return finished; }
+        uint16_t getTrackIndex() const { return trackIndex; }
+
+    private:
+        friend class MidiFileReader;
+        const uint8_t* position = nullptr;
+        const uint8_t* end = nullptr;
+        uint64_t tick = 0;
+        uint16_t trackIndex = 0;
+        uint8_t runningStatus = 0;
+        bool finished = true;
+        bool error = false;
+
+        bool readVariableLength(uint32_t& value);
+    };
+
+    MidiFileReader();
+    ~MidiFileReader();
+    MidiFileReader(const MidiFileReader&) = delete;
+    MidiFileReader& operator=(const MidiFileReader&) = delete;
+
+    // Map a file from disk
+    bool open(const std::string& path);
+    // Parse bytes owned by the caller (must outlive the reader)
+    bool openMemory(const uint8_t* data, size_t size);
+    void close();
+
+    bool isOpen() const { return data != nullptr; }
+    const std::string& getError() const { return errorMessage; }
+
+    uint16_t getFormat() const { return format; }
+    size_t getTrackCount() const { return tracks.size(); }
+    uint16_t getDivision() const { return division; }
+    size_t getFileSize() const { return size; }
+
+    TrackCursor openTrack(size_t index) const;
+
+    // Decode a single track
+    bool readTrack(size_t index, std::vector<MidiFileEvent>& events) const;
+
+    // All tracks merged into one time-ordered list. Events at the same tick
+    // keep track order, then file order.
+    bool readMerged(std::vector<MidiFileEvent>& events) const;
+
+    // Tempo changes from every track, built on first use
+    const MidiTempoMap& getTempoMap() const;
+
+private:
+    struct TrackChunk {
+        const uint8_t* start;
+        const uint8_t* end;
+    };
+
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    bool mapped = false;
+
+    uint16_t format = 0;
+    uint16_t division = 0;
+    std::vector<TrackChunk> tracks;
+    mutable std::string errorMessage;
+
+    mutable MidiTempoMap tempoMap;
+    mutable bool tempoMapBuilt = false;
+
+    bool parseChunks();
+    bool fail(const std::string& message) const;
+};
+
+} // namespace SuperTerminal
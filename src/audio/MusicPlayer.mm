@@ -12,6 +12,7 @@
 #include "AudioSystem.h"
 #include "SuperTerminal.h"
 #include "../GlobalShutdown.h"
+#include "../TraceEvents.h"
 #include <iostream>
 #include <sstream>
 #include <regex>
@@ -1833,6 +1834,8 @@ void ST_MusicPlayer::update() {
 }
 
 void ST_MusicPlayer::updateMusicTiming() {
+    TRACE_SCOPE("midi", "music timing update");
+
     // Check for emergency shutdown before acquiring locks
     if (is_emergency_shutdown_requested()) {
         std::cout << "MusicPlayer: Emergency shutdown detected in timing update, signaling thread exit..." << std::endl;
@@ -2361,6 +2364,7 @@ void ST_MusicPlayer::stopMusicThread() {
 
 void ST_MusicPlayer::musicTimingThreadLoop() {
     console("MusicPlayer: Background music thread started");
+    TRACE_THREAD_NAME("Music timing");
 
     while (musicThreadRunning.load()) {
         if (isPlaying.load() && !isPaused.load()) {
@@ -105,6 +105,7 @@ struct GranularParams {
     float density = 20.0f;          // Grains per second
     WaveformType grainWave = WAVE_SINE;
     float randomness = 0.2f;        // Position randomness
+    uint32_t seed = 12345;          // Jitter seed (same seed = same output)
 };
 
 // Physical modeling parameters
@@ -247,6 +248,10 @@ struct SynthSoundEffect {
     float echoDelay = 0.0f;         // Echo delay in seconds
     float echoDecay = 0.0f;         // Echo decay factor
     int echoCount = 0;              // Number of echoes
+    
+    // Noise seed; 0 = continue the engine's running sequence
+    // (batch generation starts those from the default seed instead)
+    uint32_t seed = 0;
 };
 
 // Predefined sound effect types
@@ -284,6 +289,12 @@ struct SynthAudioBuffer {
     void clear();
 };
 
+// One sound from a batch, in input order
+struct SynthBatchResult {
+    std::unique_ptr<SynthAudioBuffer> buffer;   // nullptr if generation failed
+    float generationTime = 0.0f;                // Seconds on the worker that rendered it
+};
+
 // WAV file export parameters
 struct WAVExportParams {
     uint32_t sampleRate = 44100;
@@ -343,6 +354,24 @@ public:
     
     // Sound effect generation
     std::unique_ptr<SynthAudioBuffer> generateSound(const SynthSoundEffect& effect);
+    
+    // Batch generation: renders every effect concurrently into its own buffer
+    // (maxThreads 0 = one worker per core). Output is bit-identical to calling
+    // generateSound on each effect with the same seed.
+    std::vector<SynthBatchResult> generateSoundBatch(const std::vector<SynthSoundEffect>& effects,
+                                                     unsigned maxThreads = 0);
+    
+    // Renders a batch, then registers it with the audio system in one pass.
+    // All or nothing: nothing is registered unless every sound rendered, and
+    // if a registration fails the ones before it are unloaded and every ID
+    // comes back 0.
+    bool generateSoundBatchToMemory(const std::vector<SynthSoundEffect>& effects,
+                                    std::vector<uint32_t>& outSoundIds,
+                                    std::vector<float>* outGenerationTimes = nullptr);
+    
+    // Named predefined effect ("beep", "coin", "explode", ...) for batch lists
+    bool createPresetEffect(const std::string& preset, float param, float duration,
+                            SynthSoundEffect& outEffect);
     std::unique_ptr<SynthAudioBuffer> generatePredefinedSound(SoundEffectType type, float duration = 0.0f);
     
     // Predefined sound effects
@@ -422,6 +451,12 @@ private:
     // Thread safety
     mutable std::mutex synthMutex;
     
+    // Batch registration (keeps concurrent batches from interleaving IDs)
+    std::mutex batchRegisterMutex;
+    
+    // Renders one sound; seed 0 uses the engine's running noise sequence
+    std::unique_ptr<SynthAudioBuffer> renderSound(const SynthSoundEffect& effect, uint32_t seed);
+    
     // Internal synthesis functions
     float generateWaveform(WaveformType type, float phase, float pulseWidth = 0.5f);
     float generateNoise();
@@ -487,7 +522,8 @@ private:
     void convertFloatToInt32(const std::vector<float>& input, std::vector<int32_t>& output, float volume = 1.0f);
     
     // Random number generation
-    uint32_t randomSeed = 12345;
+    static const uint32_t DEFAULT_RANDOM_SEED = 12345;
+    uint32_t randomSeed = DEFAULT_RANDOM_SEED;
     float random01();  // Generate random float between 0.0 and 1.0
     float randomRange(float min, float max);
     
@@ -572,6 +608,11 @@ extern "C" {
     uint32_t synth_create_physical_tube(float frequency, float airPressure, float brightness, float duration);
     uint32_t synth_create_physical_drum(float frequency, float damping, float excitation, float duration);
     
+    // Batch generation (renders concurrently, registers all or nothing).
+    // seeds and outTimesMs may be null; returns false if any sound failed.
+    bool synth_create_batch(const char** presets, const float* params, const float* durations,
+                            const uint32_t* seeds, int count, uint32_t* outSoundIds, float* outTimesMs);
+    
     // Real-time parameter control
     bool synth_set_effect_param(uint32_t soundId, const char* effectType, const char* paramName, float value);
     bool synth_add_effect(uint32_t soundId, const char* effectType);
@@ -7,6 +7,8 @@
 //
 
 #include "SynthEngine.h"
+#include "GrainScheduler.h"
+#include "../TraceEvents.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -14,6 +16,7 @@
 #include <cstring>
 #include <cmath>
 #include <chrono>
+#include <thread>
 
 // Global instance
 std::unique_ptr<SynthEngine> g_synthEngine = nullptr;
@@ -22,6 +25,10 @@ std::unique_ptr<SynthEngine> g_synthEngine = nullptr;
 static std::unordered_map<uint32_t, EffectsParams> g_soundEffects;
 static std::mutex g_soundEffectsMutex;
 
+// Noise state of the sound being rendered on this thread. Seeded sounds and
+// batch workers point it at their own seed; otherwise the engine's is used.
+static thread_local uint32_t* t_renderSeed = nullptr;
+
 // EnvelopeADSR Implementation
 
 float EnvelopeADSR::getValue(float time, float noteDuration) const {
@@ -76,7 +83,7 @@ SynthEngine::SynthEngine()
     : initialized(false)
     , lastGenerationTime(0.0f)
     , generatedSoundCount(0)
-    , randomSeed(12345)
+    , randomSeed(DEFAULT_RANDOM_SEED)
 {
     std::cout << "SynthEngine: Constructor called" << std::endl;
 }
@@ -273,10 +280,7 @@ std::unique_ptr<SynthAudioBuffer> SynthEngine::generateSound(const SynthSoundEff
 
     auto startTime = std::chrono::high_resolution_clock::now();
 
-    auto buffer = std::make_unique<SynthAudioBuffer>(config.sampleRate, config.channels);
-    buffer->resize(effect.duration);
-
-    applySynthesis(*buffer, effect);
+    auto buffer = renderSound(effect, effect.seed);
 
     auto endTime = std::chrono::high_resolution_clock::now();
     float generationTime = std::chrono::duration<float>(endTime - startTime).count();
@@ -289,6 +293,128 @@ std::unique_ptr<SynthAudioBuffer> SynthEngine::generateSound(const SynthSoundEff
     return buffer;
 }
 
+std::unique_ptr<SynthAudioBuffer> SynthEngine::renderSound(const SynthSoundEffect& effect, uint32_t seed) {
+    TRACE_SCOPE("synth", "render sound");
+    auto buffer = std::make_unique<SynthAudioBuffer>(config.sampleRate, config.channels);
+    buffer->resize(effect.duration);
+
+    // Everything below only touches this buffer and the noise state
+    uint32_t localSeed = seed;
+    uint32_t* previousSeed = t_renderSeed;
+    t_renderSeed = seed != 0 ? &localSeed : nullptr;
+
+    applySynthesis(*buffer, effect);
+
+    t_renderSeed = previousSeed;
+    return buffer;
+}
+
+std::vector<SynthBatchResult> SynthEngine::generateSoundBatch(const std::vector<SynthSoundEffect>& effects,
+                                                              unsigned maxThreads) {
+    std::vector<SynthBatchResult> results(effects.size());
+    if (!initialized.load()) {
+        std::cerr << "SynthEngine: Cannot generate batch - not initialized" << std::endl;
+        return results;
+    }
+
+    TRACE_SCOPE("synth", "generate batch");
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    unsigned workerCount = maxThreads ? maxThreads : std::max(1u, std::thread::hardware_concurrency());
+    workerCount = std::min<unsigned>(workerCount, (unsigned)effects.size());
+
+    // Workers pull the next unrendered sound; each writes only its own result
+    std::atomic<size_t> nextIndex{0};
+    auto worker = [&]() {
+        for (size_t i = nextIndex.fetch_add(1); i < effects.size(); i = nextIndex.fetch_add(1)) {
+            const SynthSoundEffect& effect = effects[i];
+            auto soundStart = std::chrono::high_resolution_clock::now();
+            results[i].buffer = renderSound(effect, effect.seed ? effect.seed : DEFAULT_RANDOM_SEED);
+            auto soundEnd = std::chrono::high_resolution_clock::now();
+            results[i].generationTime = std::chrono::duration<float>(soundEnd - soundStart).count();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < workerCount; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    float generationTime = std::chrono::duration<float>(endTime - startTime).count();
+    lastGenerationTime.store(generationTime);
+    generatedSoundCount.fetch_add(effects.size());
+
+    std::cout << "SynthEngine: Generated batch of " << effects.size() << " sounds on "
+              << std::max(1u, workerCount) << " threads in " << generationTime * 1000.0f << "ms" << std::endl;
+
+    return results;
+}
+
+bool SynthEngine::generateSoundBatchToMemory(const std::vector<SynthSoundEffect>& effects,
+                                             std::vector<uint32_t>& outSoundIds,
+                                             std::vector<float>* outGenerationTimes) {
+    outSoundIds.assign(effects.size(), 0);
+    if (outGenerationTimes) {
+        outGenerationTimes->assign(effects.size(), 0.0f);
+    }
+
+    std::vector<SynthBatchResult> results = generateSoundBatch(effects);
+    bool allRendered = true;
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (outGenerationTimes) {
+            (*outGenerationTimes)[i] = results[i].generationTime;
+        }
+        if (!results[i].buffer || results[i].buffer->samples.empty()) {
+            allRendered = false;
+        }
+    }
+    if (!allRendered) {
+        return false;
+    }
+
+    // Register the whole set in one pass so callers never see half a batch
+    std::lock_guard<std::mutex> lock(batchRegisterMutex);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const SynthAudioBuffer& buffer = *results[i].buffer;
+        outSoundIds[i] = audio_load_sound_from_buffer(buffer.samples.data(), buffer.samples.size(),
+                                                      buffer.sampleRate, buffer.channels);
+        if (outSoundIds[i] == 0) {
+            // Undo the sounds registered so far
+            for (size_t j = 0; j < i; ++j) {
+                audio_unload_sound(outSoundIds[j]);
+            }
+            outSoundIds.assign(effects.size(), 0);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SynthEngine::createPresetEffect(const std::string& preset, float param, float duration,
+                                     SynthSoundEffect& outEffect) {
+    if (preset == "beep") outEffect = createBeepEffect(param, duration);
+    else if (preset == "bang") outEffect = createBangEffect(param, duration);
+    else if (preset == "explode") outEffect = createExplodeEffect(param, duration);
+    else if (preset == "big_explosion") outEffect = createBigExplosionEffect(param, duration);
+    else if (preset == "small_explosion") outEffect = createSmallExplosionEffect(param, duration);
+    else if (preset == "distant_explosion") outEffect = createDistantExplosionEffect(param, duration);
+    else if (preset == "metal_explosion") outEffect = createMetalExplosionEffect(param, duration);
+    else if (preset == "zap") outEffect = createZapEffect(param, duration);
+    else if (preset == "coin") outEffect = createCoinEffect(param, duration);
+    else if (preset == "jump") outEffect = createJumpEffect(param, duration);
+    else if (preset == "powerup") outEffect = createPowerUpEffect(param, duration);
+    else if (preset == "hurt") outEffect = createHurtEffect(param, duration);
+    else if (preset == "shoot") outEffect = createShootEffect(param, duration);
+    else if (preset == "click") outEffect = createClickEffect(param, duration);
+    else return false;
+    return true;
+}
+
 void SynthEngine::applySynthesis(SynthAudioBuffer& buffer, const SynthSoundEffect& effect) {
     size_t frameCount = buffer.getFrameCount();
     float dt = 1.0f / buffer.sampleRate;
@@ -431,8 +557,9 @@ float SynthEngine::generateWaveform(WaveformType type, float phase, float pulseW
 
 float SynthEngine::generateNoise() {
     // Simple linear congruential generator
-    randomSeed = (randomSeed * 1103515245 + 12345) & 0x7fffffff;
-    return 2.0f * (randomSeed / float(0x7fffffff)) - 1.0f;
+    uint32_t& seed = t_renderSeed ? *t_renderSeed : randomSeed;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return 2.0f * (seed / float(0x7fffffff)) - 1.0f;
 }
 
 // Effect processing
@@ -657,8 +784,9 @@ float SynthEngine::linearToDb(float linear) {
 }
 
 float SynthEngine::random01() {
-    randomSeed = (randomSeed * 1103515245 + 12345) & 0x7fffffff;
-    return randomSeed / float(0x7fffffff);
+    uint32_t& seed = t_renderSeed ? *t_renderSeed : randomSeed;
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return seed / float(0x7fffffff);
 }
 
 float SynthEngine::randomRange(float min, float max) {
@@ -1541,6 +1669,34 @@ uint32_t synth_create_random_beep(uint32_t seed, float duration) {
     return g_synthEngine ? g_synthEngine->generateRandomBeepToMemory(seed, duration) : 0;
 }
 
+bool synth_create_batch(const char** presets, const float* params, const float* durations,
+                        const uint32_t* seeds, int count, uint32_t* outSoundIds, float* outTimesMs) {
+    if (!g_synthEngine || !presets || !params || !durations || !outSoundIds || count <= 0) {
+        return false;
+    }
+
+    std::vector<SynthSoundEffect> effects(count);
+    for (int i = 0; i < count; ++i) {
+        outSoundIds[i] = 0;
+        if (!presets[i] || !g_synthEngine->createPresetEffect(presets[i], params[i], durations[i], effects[i])) {
+            std::cerr << "synth_create_batch: Unknown preset '" << (presets[i] ? presets[i] : "") << "'" << std::endl;
+            return false;
+        }
+        effects[i].seed = seeds ? seeds[i] : 0;
+    }
+
+    std::vector<uint32_t> soundIds;
+    std::vector<float> times;
+    bool success = g_synthEngine->generateSoundBatchToMemory(effects, soundIds, &times);
+    for (int i = 0; i < count; ++i) {
+        outSoundIds[i] = soundIds[i];
+        if (outTimesMs) {
+            outTimesMs[i] = times[i] * 1000.0f;
+        }
+    }
+    return success;
+}
+
 // Memory-based sound generation functions
 uint32_t SynthEngine::generateBeepToMemory(float frequency, float duration) {
     if (!initialized.load()) {
@@ -2450,43 +2606,45 @@ void SynthEngine::synthesizeGranular(SynthAudioBuffer& buffer, const SynthSoundE
     size_t frameCount = buffer.getFrameCount();
     float dt = 1.0f / buffer.sampleRate;
 
-    float grain_samples = effect.granular.grainSize * buffer.sampleRate;
-    float grain_spacing = grain_samples * (1.0f - effect.granular.overlap);
-
-    for (size_t frame = 0; frame < frameCount; ++frame) {
-        float time = frame * dt;
-        float sample = 0.0f;
-
-        // Calculate which grains are active at this time
-        int grain_start = static_cast<int>((frame - grain_samples) / grain_spacing);
-        int grain_end = static_cast<int>(frame / grain_spacing) + 1;
+    GrainSchedulerConfig grainConfig;
+    grainConfig.sampleRate = buffer.sampleRate;
+    grainConfig.grainSize = effect.granular.grainSize;
+    grainConfig.overlap = effect.granular.overlap;
+    grainConfig.frequency = 440.0f * effect.granular.pitch;
+    grainConfig.pitchJitter = effect.granular.spread;
+    grainConfig.onsetJitter = effect.granular.randomness;
+    grainConfig.gain = 1.0f / std::max(effect.granular.density, 1.0f);
+    grainConfig.seed = effect.granular.seed;
+
+    // One cycle of the grain waveform (noise grains use no table)
+    if (effect.granular.grainWave != WAVE_NOISE) {
+        const size_t tableSize = 2048;
+        grainConfig.wavetable.resize(tableSize);
+        for (size_t i = 0; i < tableSize; ++i) {
+            grainConfig.wavetable[i] = generateWaveform(effect.granular.grainWave,
+                                                        2.0f * M_PI * i / tableSize, 0.5f);
+        }
+    }
 
-        for (int g = std::max(0, grain_start); g <= grain_end; ++g) {
-            float grain_start_time = g * grain_spacing * dt;
-            float grain_time = time - grain_start_time;
+    // Render in blocks; cost follows the number of overlapping grains
+    GrainScheduler scheduler(grainConfig);
+    const size_t blockFrames = 1024;
+    float block[blockFrames];
 
-            if (grain_time >= 0.0f && grain_time <= effect.granular.grainSize) {
-                // Generate grain envelope (Hann window)
-                float grain_phase = grain_time / effect.granular.grainSize;
-                float grain_env = 0.5f * (1.0f - std::cos(2.0f * M_PI * grain_phase));
+    for (size_t blockStart = 0; blockStart < frameCount; blockStart += blockFrames) {
+        size_t frames = std::min(blockFrames, frameCount - blockStart);
+        std::fill(block, block + frames, 0.0f);
+        scheduler.render(block, frames);
 
-                // Generate grain content
-                float base_freq = 440.0f * effect.granular.pitch;
-                float grain_freq = base_freq * (1.0f + effect.granular.randomness * (random01() - 0.5f));
-                float grain_sample = generateWaveform(effect.granular.grainWave,
-                                                    2.0f * M_PI * grain_freq * grain_time, 0.5f);
+        for (size_t i = 0; i < frames; ++i) {
+            size_t frame = blockStart + i;
+            float sample = block[i] * effect.envelope.getValue(frame * dt, effect.duration);
 
-                sample += grain_sample * grain_env / effect.granular.density;
+            // Write to both channels (stereo)
+            for (uint32_t ch = 0; ch < buffer.channels; ++ch) {
+                buffer.samples[frame * buffer.channels + ch] = sample;
             }
         }
-
-        // Apply envelope
-        sample *= effect.envelope.getValue(time, effect.duration);
-
-        // Write to both channels (stereo)
-        for (uint32_t ch = 0; ch < buffer.channels; ++ch) {
-            buffer.samples[frame * buffer.channels + ch] = sample;
-        }
     }
 }
 
@@ -2517,6 +2675,9 @@ void SynthEngine::synthesizePhysical(SynthAudioBuffer& buffer, const SynthSoundE
         }
     }
 
+    // Brightness filter state belongs to this sound alone
+    float prev_sample = 0.0f;
+
     for (size_t frame = 0; frame < frameCount; ++frame) {
         float time = frame * dt;
 
@@ -2528,7 +2689,6 @@ void SynthEngine::synthesizePhysical(SynthAudioBuffer& buffer, const SynthSoundE
 
         // Apply brightness filter
         if (effect.physical.brightness < 1.0f) {
-            static float prev_sample = 0.0f;
             filtered_sample = filtered_sample * effect.physical.brightness +
                             prev_sample * (1.0f - effect.physical.brightness);
             prev_sample = filtered_sample;
@@ -0,0 +1,110 @@
+//
+//  VoicePool.cpp
+//  SuperTerminal Framework - Sound Effect Voice Pool
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "VoicePool.h"
+#include <algorithm>
+
+VoicePool::VoicePool(uint32_t voiceCount, VoiceStealPolicy stealPolicy)
+    : slots(std::min(voiceCount, MAX_VOICES))
+    , policy(stealPolicy)
+{
+}
+
+bool VoicePool::isPlaying(const VoiceSlot& voice, uint64_t nowMs) const {
+    return voice.active && (voice.endMs == 0 || nowMs < voice.endMs);
+}
+
+uint32_t VoicePool::makeInstanceId(int slotIndex) {
+    // 24-bit serial above the slot index; never returns 0
+    uint32_t id = (nextSerial << 8) | (uint32_t)slotIndex;
+    nextSerial = (nextSerial + 1) & 0xFFFFFF;
+    if (nextSerial == 0) nextSerial = 1;
+    return id;
+}
+
+VoiceTrigger VoicePool::trigger(uint32_t soundId, float volume, uint64_t nowMs, uint64_t durationMs) {
+    VoiceTrigger result;
+    if (slots.empty()) {
+        return result;
+    }
+
+    // One pass: first free slot, else the best steal candidate
+    int freeSlot = -1;
+    int victim = -1;
+    for (int i = 0; i < (int)slots.size(); i++) {
+        const VoiceSlot& voice = slots[i];
+        if (!isPlaying(voice, nowMs)) {
+            freeSlot = i;
+            break;
+        }
+        if (victim < 0) {
+            victim = i;
+            continue;
+        }
+        const VoiceSlot& best = slots[victim];
+        bool better;
+        if (policy == VoiceStealPolicy::Quietest && voice.volume != best.volume) {
+            better = voice.volume < best.volume;
+        } else {
+            better = voice.startMs < best.startMs;
+        }
+        if (better) victim = i;
+    }
+
+    int index = freeSlot;
+    if (index < 0) {
+        index = victim;
+        result.stolenInstanceId = slots[index].instanceId;
+        stats.steals++;
+    }
+
+    VoiceSlot& voice = slots[index];
+    voice.instanceId = makeInstanceId(index);
+    voice.soundId = soundId;
+    voice.volume = volume;
+    voice.startMs = nowMs;
+    voice.endMs = durationMs > 0 ? nowMs + durationMs : 0;
+    voice.active = true;
+    stats.triggers++;
+
+    result.slot = index;
+    result.instanceId = voice.instanceId;
+    return result;
+}
+
+int VoicePool::slotForInstance(uint32_t instanceId, uint64_t nowMs) const {
+    uint32_t index = instanceId & 0xFF;
+    if (instanceId == 0 || index >= slots.size()) {
+        return -1;
+    }
+    const VoiceSlot& voice = slots[index];
+    return (voice.instanceId == instanceId && isPlaying(voice, nowMs)) ? (int)index : -1;
+}
+
+int VoicePool::release(uint32_t instanceId) {
+    uint32_t index = instanceId & 0xFF;
+    if (instanceId == 0 || index >= slots.size() || slots[index].instanceId != instanceId) {
+        return -1;
+    }
+    slots[index].active = false;
+    return (int)index;
+}
+
+void VoicePool::releaseAll() {
+    for (auto& voice : slots) {
+        voice.active = false;
+    }
+}
+
+size_t VoicePool::activeCount(uint64_t nowMs) const {
+    size_t count = 0;
+    for (const auto& voice : slots) {
+        if (isPlaying(voice, nowMs)) count++;
+    }
+    return count;
+}
@@ -0,0 +1,84 @@
+//
+//  VoicePool.h
+//  SuperTerminal Framework - Sound Effect Voice Pool
+//
+//  Created by SuperTerminal Project
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+//  Fixed-size slot allocator for sound-effect voices. The engine keeps one
+//  player node per slot attached to the graph for its whole life; this class
+//  only decides which slot a trigger lands in and which voice is stolen when
+//  all slots are busy. It never allocates after construction and has no
+//  platform dependencies, so it can be tested off macOS.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Which voice to cut off when every slot is busy
+enum class VoiceStealPolicy {
+    Oldest,     // Voice that started first
+    Quietest    // Lowest volume, oldest on ties
+};
+
+// One pooled voice
+struct VoiceSlot {
+    uint32_t instanceId = 0;    // 0 when the slot has never been used
+    uint32_t soundId = 0;
+    float volume = 0.0f;
+    uint64_t startMs = 0;
+    uint64_t endMs = 0;         // 0 = plays until released
+    bool active = false;
+};
+
+// Result of a trigger
+struct VoiceTrigger {
+    int slot = -1;                  // -1 if the pool has no slots
+    uint32_t instanceId = 0;
+    uint32_t stolenInstanceId = 0;  // Voice cut off to make room (0 if none)
+};
+
+struct VoicePoolStats {
+    uint64_t triggers = 0;
+    uint64_t steals = 0;
+};
+
+class VoicePool {
+public:
+    // Instance IDs carry the slot index in their low byte
+    static const uint32_t MAX_VOICES = 256;
+
+    explicit VoicePool(uint32_t voiceCount = 64, VoiceStealPolicy policy = VoiceStealPolicy::Oldest);
+
+    // Claim a slot for a sound lasting durationMs (0 = until released).
+    // Finished voices are reclaimed first; otherwise one is stolen.
+    VoiceTrigger trigger(uint32_t soundId, float volume, uint64_t nowMs, uint64_t durationMs);
+
+    // Slot currently playing instanceId, or -1 if it finished, was stopped
+    // or was stolen
+    int slotForInstance(uint32_t instanceId, uint64_t nowMs) const;
+
+    // Free the slot playing instanceId; returns the slot or -1
+    int release(uint32_t instanceId);
+    void releaseAll();
+
+    size_t activeCount(uint64_t nowMs) const;
+    uint32_t capacity() const { return (uint32_t)slots.size(); }
+    const VoiceSlot& slot(int index) const { return slots[index]; }
+
+    void setPolicy(VoiceStealPolicy newPolicy) { policy = newPolicy; }
+    VoiceStealPolicy getPolicy() const { return policy; }
+    const VoicePoolStats& getStats() const { return stats; }
+
+private:
+    std::vector<VoiceSlot> slots;
+    VoiceStealPolicy policy;
+    uint32_t nextSerial = 1;
+    VoicePoolStats stats;
+
+    bool isPlaying(const VoiceSlot& voice, uint64_t nowMs) const;
+    uint32_t makeInstanceId(int slotIndex);
+};
@@ -105,6 +105,7 @@ bool Player::loadABC(const std::string& abc_content) {
         tune_loaded_ = validateTune();
         if (tune_loaded_) {
             calculateTotalDuration();
+            rebuildSeekIndex();
             resetPlaybackState();
         }
         
@@ -180,6 +181,7 @@ bool Player::pause() {
         if (playback_thread_.joinable()) {
             playback_thread_.join();
         }
+        silenceAllChannels();
 #endif
         
         if (verbose_) {
@@ -231,6 +233,31 @@ void Player::setTempo(int bpm) {
         
         // Update tempo in current tune
         current_tune_.default_tempo.bpm = bpm;
+        
+        if (tune_loaded_) {
+            bool restart = false;
+#ifdef __APPLE__
+            if (playback_state_ == PlaybackState::PLAYING && !synchronous_mode_) {
+                should_stop_playback_ = true;
+                if (playback_thread_.joinable()) {
+                    playback_thread_.join();
+                }
+                silenceAllChannels();
+                restart = true;
+            }
+#endif
+            // Event times in seconds change with the tempo; keep the same
+            // place in the tune
+            double fraction = total_duration_ > 0.0 ? current_position_ / total_duration_ : 0.0;
+            calculateTotalDuration();
+            rebuildSeekIndex();
+            current_position_ = fraction * total_duration_;
+#ifdef __APPLE__
+            if (restart) {
+                restartPlaybackThread();
+            }
+#endif
+        }
     }
 }
 
@@ -239,7 +266,24 @@ void Player::setVolume(float volume) {
 }
 
 void Player::seek(double position_seconds) {
-    current_position_ = std::max(0.0, std::min(total_duration_, position_seconds));
+    double target = std::max(0.0, std::min(total_duration_, position_seconds));
+    
+#ifdef __APPLE__
+    if (playback_state_ == PlaybackState::PLAYING && !synchronous_mode_) {
+        // Stop the scheduler, cut sounding notes and restart from the target;
+        // scheduleMIDIEvents() chases state from the nearest checkpoint
+        should_stop_playback_ = true;
+        if (playback_thread_.joinable()) {
+            playback_thread_.join();
+        }
+        silenceAllChannels();
+        current_position_ = target;
+        restartPlaybackThread();
+        return;
+    }
+#endif
+    
+    current_position_ = target;
 }
 
 double Player::getCurrentPosition() const {
@@ -640,28 +684,21 @@ void Player::scheduleMIDIEvents() {
     auto start_time = std::chrono::steady_clock::now();
     double playback_start_seconds = current_position_;
     
-    // Sort all events by timestamp across all tracks
-    std::vector<std::pair<double, const MIDIEvent*>> all_events;
+    // Jump to the first event at the start position and re-send the
+    // program, controller and held-note state in effect there
+    ChaseState chase;
+    size_t first_event = seek_index_.seek(playback_start_seconds, chase);
+    sendChaseState(chase, playback_start_seconds);
     
-    for (const MIDITrack& track : midi_tracks_) {
-        for (const MIDIEvent& event : track.events) {
-            // Convert event timestamp from beats to seconds
-            double event_time_seconds = convertBeatsToSeconds(event.timestamp, current_tune_.default_tempo, current_tune_.default_unit_length);
-            if (event_time_seconds >= playback_start_seconds) {
-                all_events.push_back(std::make_pair(event_time_seconds, &event));
-            }
-        }
-    }
-    
-    std::sort(all_events.begin(), all_events.end());
+    const std::vector<ScheduledEvent>& all_events = seek_index_.getEvents();
     
-    for (const auto& pair : all_events) {
+    for (size_t i = first_event; i < all_events.size(); i++) {
         if (should_stop_playback_) {
             break;
         }
         
-        double event_time_seconds = pair.first;
-        const MIDIEvent* event = pair.second;
+        double event_time_seconds = all_events[i].seconds;
+        const MIDIEvent* event = all_events[i].event;
         
         // Calculate when to play this event relative to playback start
         double relative_time_seconds = event_time_seconds - playback_start_seconds;
@@ -681,14 +718,19 @@ void Player::scheduleMIDIEvents() {
         current_position_ = event_time_seconds;
     }
     
+    if (should_stop_playback_) {
+        // Resume from the clock rather than the last event sent
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+        current_position_ = std::min(total_duration_, playback_start_seconds + elapsed.count());
+        return;
+    }
+    
     // Playback completed
-    if (!should_stop_playback_) {
-        playback_state_ = PlaybackState::STOPPED;
-        current_position_ = 0.0;
-        
-        if (audio_callback_) {
-            audio_callback_->onPlaybackStopped();
-        }
+    playback_state_ = PlaybackState::STOPPED;
+    current_position_ = 0.0;
+    
+    if (audio_callback_) {
+        audio_callback_->onPlaybackStopped();
     }
 }
 
@@ -748,6 +790,15 @@ void Player::sendMIDIEvent(const MIDIEvent& event) {
             break;
         }
         
+        case MIDIEventType::PITCH_BEND: {
+            result = MusicDeviceMIDIEvent(synth_unit_,
+                                        0xE0 | (event.channel & 0x0F),
+                                        event.data1 & 0x7F,
+                                        event.data2 & 0x7F,
+                                        0);
+            break;
+        }
+        
         case MIDIEventType::META_TEMPO: {
             if (!event.meta_data.empty() && event.meta_data.size() >= 3) {
                 uint32_t mpq = (event.meta_data[0] << 16) | 
@@ -775,6 +826,56 @@ void Player::sendMIDIEvent(const MIDIEvent& event) {
         std::cerr << "Warning: Failed to send MIDI event, result=" << result << std::endl;
     }
 }
+
+void Player::sendChaseState(const ChaseState& state, double position_seconds) {
+    double seconds_per_beat = seek_index_.getSecondsPerBeat();
+    double timestamp = seconds_per_beat > 0.0 ? position_seconds / seconds_per_beat : 0.0;
+    
+    if (state.tempo_mpq > 0) {
+        MIDIEvent tempo(MIDIEventType::META_TEMPO, timestamp);
+        tempo.meta_data = {
+            static_cast<uint8_t>((state.tempo_mpq >> 16) & 0xFF),
+            static_cast<uint8_t>((state.tempo_mpq >> 8) & 0xFF),
+            static_cast<uint8_t>(state.tempo_mpq & 0xFF)
+        };
+        sendMIDIEvent(tempo);
+    }
+    
+    for (int ch = 0; ch < ChaseState::NUM_CHANNELS; ch++) {
+        if (state.program[ch] >= 0) {
+            sendMIDIEvent(MIDIEvent(MIDIEventType::PROGRAM_CHANGE, timestamp, ch, state.program[ch]));
+        }
+        for (int cc = 0; cc < 128; cc++) {
+            if (state.controller[ch][cc] >= 0) {
+                sendMIDIEvent(MIDIEvent(MIDIEventType::CONTROL_CHANGE, timestamp, ch, cc, state.controller[ch][cc]));
+            }
+        }
+        if (state.pitch_bend[ch] >= 0) {
+            sendMIDIEvent(MIDIEvent(MIDIEventType::PITCH_BEND, timestamp, ch,
+                                    state.pitch_bend[ch] & 0x7F, (state.pitch_bend[ch] >> 7) & 0x7F));
+        }
+    }
+    
+    // Notes that started before the seek point and are still sounding
+    for (const auto& held : state.held_notes) {
+        sendMIDIEvent(MIDIEvent(MIDIEventType::NOTE_ON, timestamp, held.first >> 7, held.first & 0x7F, held.second));
+    }
+}
+
+void Player::silenceAllChannels() {
+    if (!synth_unit_) {
+        return;
+    }
+    
+    for (int ch = 0; ch < ChaseState::NUM_CHANNELS; ch++) {
+        MusicDeviceMIDIEvent(synth_unit_, 0xB0 | ch, 123, 0, 0);  // All Notes Off
+    }
+}
+
+void Player::restartPlaybackThread() {
+    should_stop_playback_ = false;
+    playback_thread_ = std::thread(&Player::playbackThreadFunc, this);
+}
 #endif
 
 bool Player::validateTune() {
@@ -821,6 +922,11 @@ void Player::calculateTotalDuration() {
     }
 }
 
+void Player::rebuildSeekIndex() {
+    double seconds_per_beat = convertBeatsToSeconds(1.0, current_tune_.default_tempo, current_tune_.default_unit_length);
+    seek_index_.build(midi_tracks_, seconds_per_beat);
+}
+
 void Player::resetPlaybackState() {
     current_position_ = 0.0;
     playback_state_ = PlaybackState::STOPPED;
@@ -846,6 +952,7 @@ bool Player::generatePhase() {
         return false;
     }
     
+    seek_index_.clear();  // Points into midi_tracks_
     midi_tracks_.clear();
     if (!midi_generator_->generateMIDI(current_tune_, midi_tracks_)) {
         addError("Failed to generate MIDI tracks");
@@ -4,6 +4,7 @@
 #include "ABCTypes.h"
 #include "ABCParser.h"
 #include "MIDIGenerator.h"
+#include "ABCSeekIndex.h"
 #include <string>
 #include <vector>
 #include <memory>
@@ -58,7 +59,7 @@ public:
     // Playback control
     void setTempo(int bpm);
     void setVolume(float volume);        // 0.0 to 1.0
-    void seek(double position_seconds);
+    void seek(double position_seconds);  // Chases program/controller/held-note state
     double getCurrentPosition() const;   // in seconds
     double getTotalDuration() const;     // in seconds
     
@@ -114,6 +115,7 @@ private:
     // Current state
     ABCTune current_tune_;
     std::vector<MIDITrack> midi_tracks_;
+    SeekIndex seek_index_;           // Merged event stream with chase checkpoints
     PlaybackState playback_state_;
     bool tune_loaded_;
     bool verbose_;
@@ -159,6 +161,9 @@ private:
     void playbackThreadFunc();
     void scheduleMIDIEvents();
     void sendMIDIEvent(const MIDIEvent& event);
+    void sendChaseState(const ChaseState& state, double position_seconds);
+    void silenceAllChannels();
+    void restartPlaybackThread();
     
     // Synchronous playback (main thread)
     bool playSynchronous();
@@ -175,6 +180,7 @@ private:
     // Internal methods
     bool validateTune();
     void calculateTotalDuration();
+    void rebuildSeekIndex();
     void resetPlaybackState();
     void updateVoiceSettings();
     
@@ -0,0 +1,152 @@
+#include "ABCSeekIndex.h"
+#include <algorithm>
+#include <cstring>
+
+namespace ABCPlayer {
+
+void ChaseState::reset() {
+    std::memset(program, -1, sizeof(program));
+    std::memset(controller, -1, sizeof(controller));
+    for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+        pitch_bend[ch] = -1;
+    }
+    tempo_mpq = 0;
+    held_notes.clear();
+}
+
+void ChaseState::apply(const MIDIEvent& event) {
+    int ch = event.channel & 0x0F;
+
+    switch (event.type) {
+        case MIDIEventType::NOTE_ON:
+        case MIDIEventType::NOTE_OFF: {
+            uint16_t key = static_cast<uint16_t>((ch << 7) | (event.data1 & 0x7F));
+            auto it = std::lower_bound(held_notes.begin(), held_notes.end(), key,
+                                       [](const std::pair<uint16_t, uint8_t>& held, uint16_t k) {
+                                           return held.first < k;
+                                       });
+            bool found = it != held_notes.end() && it->first == key;
+            int velocity = event.data2 & 0x7F;
+
+            if (event.type == MIDIEventType::NOTE_ON && velocity > 0) {
+                if (found) {
+                    it->second = static_cast<uint8_t>(velocity);
+                } else {
+                    held_notes.insert(it, std::make_pair(key, static_cast<uint8_t>(velocity)));
+                }
+            } else if (found) {
+                held_notes.erase(it);
+            }
+            break;
+        }
+
+        case MIDIEventType::PROGRAM_CHANGE:
+            program[ch] = static_cast<int8_t>(event.data1 & 0x7F);
+            break;
+
+        case MIDIEventType::CONTROL_CHANGE:
+            controller[ch][event.data1 & 0x7F] = static_cast<int8_t>(event.data2 & 0x7F);
+            break;
+
+        case MIDIEventType::PITCH_BEND:
+            pitch_bend[ch] = static_cast<int16_t>((event.data1 & 0x7F) | ((event.data2 & 0x7F) << 7));
+            break;
+
+        case MIDIEventType::META_TEMPO:
+            if (event.meta_data.size() >= 3) {
+                tempo_mpq = (static_cast<uint32_t>(event.meta_data[0]) << 16) |
+                            (static_cast<uint32_t>(event.meta_data[1]) << 8) |
+                            event.meta_data[2];
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+bool ChaseState::operator==(const ChaseState& other) const {
+    return std::memcmp(program, other.program, sizeof(program)) == 0 &&
+           std::memcmp(controller, other.controller, sizeof(controller)) == 0 &&
+           std::memcmp(pitch_bend, other.pitch_bend, sizeof(pitch_bend)) == 0 &&
+           tempo_mpq == other.tempo_mpq &&
+           held_notes == other.held_notes;
+}
+
+SeekIndex::SeekIndex()
+    : interval_(DEFAULT_CHECKPOINT_INTERVAL), seconds_per_beat_(0.0) {
+}
+
+void SeekIndex::build(const std::vector<MIDITrack>& tracks, double seconds_per_beat,
+                      size_t checkpoint_interval) {
+    clear();
+    interval_ = std::max<size_t>(1, checkpoint_interval);
+    seconds_per_beat_ = seconds_per_beat;
+
+    size_t total = 0;
+    for (const MIDITrack& track : tracks) {
+        total += track.events.size();
+    }
+    events_.reserve(total);
+
+    for (const MIDITrack& track : tracks) {
+        for (const MIDIEvent& event : track.events) {
+            events_.push_back({event.timestamp * seconds_per_beat, &event});
+        }
+    }
+
+    std::stable_sort(events_.begin(), events_.end(),
+                     [](const ScheduledEvent& a, const ScheduledEvent& b) {
+                         return a.seconds < b.seconds;
+                     });
+
+    // One pass over the stream, snapshotting before every interval_-th event
+    checkpoints_.reserve(events_.size() / interval_ + 1);
+    ChaseState state;
+    for (size_t i = 0; i < events_.size(); i++) {
+        if (i % interval_ == 0) {
+            checkpoints_.push_back(state);
+        }
+        state.apply(*events_[i].event);
+    }
+    // Closing checkpoint so a seek to the end never replays a full interval
+    if (events_.size() % interval_ == 0) {
+        checkpoints_.push_back(state);
+    }
+}
+
+void SeekIndex::clear() {
+    events_.clear();
+    checkpoints_.clear();
+}
+
+size_t SeekIndex::findEvent(double position_seconds) const {
+    auto it = std::lower_bound(events_.begin(), events_.end(), position_seconds,
+                               [](const ScheduledEvent& e, double t) {
+                                   return e.seconds < t;
+                               });
+    return static_cast<size_t>(it - events_.begin());
+}
+
+size_t SeekIndex::seek(double position_seconds, ChaseState& state, size_t* replayed) const {
+    size_t target = findEvent(position_seconds);
+
+    if (checkpoints_.empty()) {
+        state.reset();
+        if (replayed) *replayed = 0;
+        return target;
+    }
+
+    size_t checkpoint = target / interval_;
+    state = checkpoints_[checkpoint];
+
+    size_t start = checkpoint * interval_;
+    for (size_t i = start; i < target; i++) {
+        state.apply(*events_[i].event);
+    }
+
+    if (replayed) *replayed = target - start;
+    return target;
+}
+
+} // namespace ABCPlayer
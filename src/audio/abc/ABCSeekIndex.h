@@ -0,0 +1,78 @@
+#ifndef ABC_SEEK_INDEX_H
+#define ABC_SEEK_INDEX_H
+
+#include "MIDIGenerator.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ABCPlayer {
+
+// Channel state that must be re-sent when playback starts mid-tune:
+// the last program, controller values, pitch bend and tempo seen so far,
+// plus the notes that are still sounding.
+struct ChaseState {
+    static const int NUM_CHANNELS = 16;
+
+    int8_t program[NUM_CHANNELS];               // -1 = never set
+    int8_t controller[NUM_CHANNELS][128];       // -1 = never set
+    int16_t pitch_bend[NUM_CHANNELS];           // -1 = never set, else 0..16383
+    uint32_t tempo_mpq;                         // Microseconds per quarter, 0 = never set
+
+    // Sounding notes, sorted by (channel << 7 | note), with their velocity
+    std::vector<std::pair<uint16_t, uint8_t>> held_notes;
+
+    ChaseState() { reset(); }
+
+    void reset();
+    void apply(const MIDIEvent& event);
+    bool operator==(const ChaseState& other) const;
+    bool operator!=(const ChaseState& other) const { return !(*this == other); }
+};
+
+// An event of the merged, time-ordered playback stream
+struct ScheduledEvent {
+    double seconds;
+    const MIDIEvent* event;
+};
+
+// Merged event stream with a ChaseState snapshot every few hundred events.
+// Seeking is a binary search for the first event at the target time, a copy
+// of the nearest checkpoint before it and a replay of at most one interval.
+// Events point into the tracks given to build(); rebuild when they change.
+class SeekIndex {
+public:
+    static const size_t DEFAULT_CHECKPOINT_INTERVAL = 256;
+
+    SeekIndex();
+
+    // Merge all tracks; event times are beats * seconds_per_beat. Events at
+    // the same time keep track order, then event order within the track.
+    void build(const std::vector<MIDITrack>& tracks, double seconds_per_beat,
+               size_t checkpoint_interval = DEFAULT_CHECKPOINT_INTERVAL);
+    void clear();
+
+    // Index of the first event at or after position_seconds
+    size_t findEvent(double position_seconds) const;
+
+    // Fill state with everything before position_seconds and return the index
+    // of the first event still to be played. replayed, if given, receives the
+    // number of events applied on top of the checkpoint.
+    size_t seek(double position_seconds, ChaseState& state, size_t* replayed = nullptr) const;
+
+    const std::vector<ScheduledEvent>& getEvents() const { return events_; }
+    size_t getCheckpointCount() const { return checkpoints_.size(); }
+    size_t getCheckpointInterval() const { return interval_; }
+    double getSecondsPerBeat() const { return seconds_per_beat_; }
+
+private:
+    std::vector<ScheduledEvent> events_;
+    std::vector<ChaseState> checkpoints_;       // checkpoints_[i] = state before events_[i * interval_]
+    size_t interval_;
+    double seconds_per_beat_;
+};
+
+} // namespace ABCPlayer
+
+#endif // ABC_SEEK_INDEX_H
@@ -545,6 +545,35 @@ void AudioBuffer::convertToNonInterleaved() {
     interleaved = false;
 }
 
+AudioBuffer AudioBuffer::resample(uint32_t newSampleRate, ResamplerQuality quality) const {
+    if (newSampleRate == sampleRate || newSampleRate == 0 || isEmpty()) {
+        return *this;
+    }
+    
+    // The resampler works on interleaved frames
+    AudioBuffer source(*this);
+    if (!source.interleaved) {
+        source.convertToInterleaved();
+    }
+    
+    std::vector<float> converted = ResamplerUtils::resampleInterleaved(
+        source.samples.data(), frameCount, channelCount, sampleRate, newSampleRate, quality);
+    
+    AudioBuffer result(static_cast<uint32_t>(converted.size() / channelCount), channelCount, newSampleRate);
+    std::copy(converted.begin(), converted.end(), result.samples.begin());
+    if (!interleaved) {
+        result.convertToNonInterleaved();
+    }
+    return result;
+}
+
+void AudioBuffer::resampleInPlace(uint32_t newSampleRate, ResamplerQuality quality) {
+    if (newSampleRate == sampleRate || newSampleRate == 0 || isEmpty()) {
+        return;
+    }
+    *this = resample(newSampleRate, quality);
+}
+
 AudioBuffer AudioBuffer::convertToMono() const {
     if (channelCount == 1) return *this;
     
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "Resampler.h"
 #include <vector>
 #include <memory>
 #include <cstring>
@@ -143,9 +144,9 @@ public:
     void convertToInterleaved();
     void convertToNonInterleaved();
     
-    // Convert sample rate (simple linear interpolation)
-    AudioBuffer resample(uint32_t newSampleRate) const;
-    void resampleInPlace(uint32_t newSampleRate);
+    // Convert sample rate (polyphase windowed sinc, see Resampler.h)
+    AudioBuffer resample(uint32_t newSampleRate, ResamplerQuality quality = ResamplerQuality::High) const;
+    void resampleInPlace(uint32_t newSampleRate, ResamplerQuality quality = ResamplerQuality::High);
     
     // Convert channel count
     AudioBuffer convertToMono() const;           // Mix all channels to mono
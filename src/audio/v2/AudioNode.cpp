@@ -8,8 +8,11 @@
 
 #include "AudioNode.h"
 #include "AudioBuffer.h"
+#include "../../FrameArena.h"
+#include "../../TraceEvents.h"
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <iostream>
 
 
@@ -206,6 +209,7 @@ void AudioSourceNode::process(const AudioBuffer& inputBuffer, AudioBuffer& outpu
         return;
     }
     
+    TRACE_SCOPE("audio", "source node block");
     auto startTime = std::chrono::high_resolution_clock::now();
     
     // Generate audio (implemented by derived classes)
@@ -230,6 +234,7 @@ void AudioEffectNode::process(const AudioBuffer& inputBuffer, AudioBuffer& outpu
         return;
     }
     
+    TRACE_SCOPE("audio", "effect node block");
     auto startTime = std::chrono::high_resolution_clock::now();
     
     // Process audio (implemented by derived classes)
@@ -265,15 +270,20 @@ void AudioMixerNode::process(const AudioBuffer& inputBuffer, AudioBuffer& output
         return;
     }
     
+    TRACE_SCOPE("audio", "mixer node block");
     auto startTime = std::chrono::high_resolution_clock::now();
     
+    // Scratch for this callback comes from the audio thread's arena
+    FrameArenaScope scope;
+    
     // Clear output buffer
     outputBuffer.clear();
     
     // Get all input connections
-    std::vector<std::shared_ptr<AudioNode>> inputNodes;
+    FrameVector<std::shared_ptr<AudioNode>> inputNodes;
     {
         std::lock_guard<std::mutex> lock(getConnectionMutexRef());
+        inputNodes.reserve(getInputsRef().size());
         for (const auto& weakInput : getInputsRef()) {
             if (auto input = weakInput.lock()) {
                 inputNodes.push_back(input);
@@ -281,28 +291,50 @@ void AudioMixerNode::process(const AudioBuffer& inputBuffer, AudioBuffer& output
         }
     }
     
-    // Mix inputs
-    AudioBuffer tempBuffer(outputBuffer.getFrameCount(), outputBuffer.getChannelCount(), outputBuffer.getSampleRate());
+    // Mix inputs. Volume and pan fold into one gain per output channel, so
+    // each channel is accumulated straight into the output with no temp copy.
+    const uint32_t channelCount = outputBuffer.getChannelCount();
+    const uint32_t frameCount = outputBuffer.getFrameCount();
+    const uint32_t inputChannels = inputBuffer.getChannelCount();
+    const bool sameFormat = inputChannels == channelCount &&
+                            inputBuffer.getFrameCount() == frameCount;
+    FrameVector<float> channelGains(channelCount, 0.0f);
     
     for (size_t i = 0; i < inputNodes.size() && i < channels.size(); ++i) {
         // Process input node (this would normally be done by the audio graph)
         // For now, we'll assume the input buffer contains the processed audio
         
         std::lock_guard<std::mutex> channelLock(channelMutex);
-        if (channels[i].enabled) {
-            float channelVolume = channels[i].volume;
-            float channelPan = channels[i].pan;
-            
-            // Copy input and apply channel settings
-            tempBuffer.copyFrom(inputBuffer);
-            tempBuffer.applyGain(channelVolume);
-            
-            if (outputBuffer.getChannelCount() >= 2) {
-                tempBuffer.applyPan(channelPan);
+        if (!channels[i].enabled) {
+            continue;
+        }
+        
+        // Pan law: -3dB center, same as AudioBuffer::applyPan
+        float channelVolume = channels[i].volume;
+        float channelPan = channels[i].pan;
+        std::fill(channelGains.begin(), channelGains.end(), channelVolume);
+        if (channelCount >= 2) {
+            channelGains[0] *= std::sqrt(0.5f * (1.0f - channelPan));
+            channelGains[1] *= std::sqrt(0.5f * (1.0f + channelPan));
+        }
+        
+        if (sameFormat && inputBuffer.isInterleaved() && outputBuffer.isInterleaved()) {
+            const float* source = inputBuffer.getInterleavedData();
+            float* dest = outputBuffer.getInterleavedData();
+            for (uint32_t frame = 0; frame < frameCount; ++frame) {
+                for (uint32_t ch = 0; ch < channelCount; ++ch) {
+                    dest[ch] += source[ch] * channelGains[ch];
+                }
+                source += channelCount;
+                dest += channelCount;
+            }
+        } else {
+            // Mismatched formats mix the common frames; a mono input feeds
+            // every output channel, and extra input channels are dropped
+            for (uint32_t ch = 0; ch < channelCount; ++ch) {
+                uint32_t sourceChannel = inputChannels == 1 ? 0 : ch;
+                outputBuffer.mixFromChannel(inputBuffer, sourceChannel, ch, channelGains[ch]);
             }
-            
-            // Mix into output
-            outputBuffer.mixFrom(tempBuffer, 1.0f);
         }
     }
     
@@ -312,9 +344,9 @@ void AudioMixerNode::process(const AudioBuffer& inputBuffer, AudioBuffer& output
         outputBuffer.applyGain(masterVol);
     }
     
-    // Apply node volume and bypass
-    AudioBuffer originalOutput = outputBuffer;
-    applyVolumeAndBypass(originalOutput, outputBuffer);
+    // Apply node volume and bypass; the mix is both input and output here,
+    // so bypass leaves it as is
+    applyVolumeAndBypass(outputBuffer, outputBuffer);
     
     // Update CPU usage
     auto endTime = std::chrono::high_resolution_clock::now();
@@ -0,0 +1,304 @@
+//
+//  Resampler.cpp
+//  SuperTerminal Framework - Audio Graph v2.0
+//
+//  Streaming polyphase windowed-sinc sample rate converter
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "Resampler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define RESAMPLER_NEON 1
+#elif defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define RESAMPLER_SSE 1
+#endif
+
+namespace {
+
+// Ratios whose reduced output rate fits get one exact kernel per phase
+constexpr uint64_t MAX_EXACT_PHASES = 1024;
+constexpr uint32_t INTERPOLATED_PHASES = 256;
+
+struct QualitySettings {
+    uint32_t taps;
+    double beta;        // Kaiser window shape
+};
+
+QualitySettings settingsFor(ResamplerQuality quality) {
+    switch (quality) {
+        case ResamplerQuality::Fast:   return {16, 5.0};
+        case ResamplerQuality::Medium: return {32, 7.0};
+        case ResamplerQuality::High:   return {64, 9.0};
+        case ResamplerQuality::Best:   return {128, 11.5};
+    }
+    return {64, 9.0};
+}
+
+uint64_t greatestCommonDivisor(uint64_t a, uint64_t b) {
+    while (b != 0) {
+        uint64_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// Zeroth-order modified Bessel function (Kaiser window)
+double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    double halfX = x * 0.5;
+    for (int k = 1; k < 64; k++) {
+        term *= (halfX / k) * (halfX / k);
+        sum += term;
+        if (term < sum * 1e-12) break;
+    }
+    return sum;
+}
+
+// taps is always a multiple of 4
+inline float dotProduct(const float* a, const float* b, size_t taps) {
+#if defined(RESAMPLER_NEON)
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + 8 <= taps; i += 8) {
+        acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+        acc1 = vmlaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    for (; i < taps; i += 4) {
+        acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+    }
+    float32x4_t acc = vaddq_f32(acc0, acc1);
+    float32x2_t pair = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+    return vget_lane_f32(vpadd_f32(pair, pair), 0);
+#elif defined(RESAMPLER_SSE)
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= taps; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    for (; i < taps; i += 4) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    __m128 acc = _mm_add_ps(acc0, acc1);
+    __m128 shuffled = _mm_movehl_ps(acc, acc);
+    acc = _mm_add_ps(acc, shuffled);
+    shuffled = _mm_shuffle_ps(acc, acc, 0x55);
+    return _mm_cvtss_f32(_mm_add_ss(acc, shuffled));
+#else
+    float acc[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (size_t i = 0; i < taps; i += 4) {
+        acc[0] += a[i] * b[i];
+        acc[1] += a[i + 1] * b[i + 1];
+        acc[2] += a[i + 2] * b[i + 2];
+        acc[3] += a[i + 3] * b[i + 3];
+    }
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+#endif
+}
+
+} // namespace
+
+uint32_t Resampler::tapsForQuality(ResamplerQuality quality) {
+    return settingsFor(quality).taps;
+}
+
+Resampler::Resampler(uint32_t inRate, uint32_t outRate, uint32_t channelCount, ResamplerQuality resamplerQuality)
+    : inputRate(std::max<uint32_t>(1, inRate))
+    , outputRate(std::max<uint32_t>(1, outRate))
+    , channels(std::max<uint32_t>(1, channelCount))
+    , quality(resamplerQuality)
+{
+    uint64_t divisor = greatestCommonDivisor(inputRate, outputRate);
+    phaseCount = outputRate / divisor;
+    step = inputRate / divisor;
+
+    // Downsampling stretches the kernel so it still spans the same number
+    // of zero crossings of the lower cutoff
+    uint32_t baseTaps = settingsFor(quality).taps;
+    double stretch = std::max(1.0, (double)inputRate / outputRate);
+    taps = ((uint32_t)std::ceil(baseTaps * stretch) + 3) & ~3u;
+
+    exactPhases = phaseCount <= MAX_EXACT_PHASES;
+    tableRows = exactPhases ? (uint32_t)phaseCount : INTERPOLATED_PHASES + 1;
+    buildKernels();
+
+    history.resize(channels);
+    scratchKernel.resize(taps);
+    reset();
+}
+
+void Resampler::buildKernels() {
+    QualitySettings settings = settingsFor(quality);
+    double ratio = std::min(1.0, (double)outputRate / inputRate);
+
+    // Put the stopband edge at the lower Nyquist: the Kaiser transition
+    // width for this attenuation and length is centred just below it
+    double attenuation = settings.beta / 0.1102 + 8.7;
+    double transition = 2.0 * (attenuation - 7.95) / (14.36 * settings.taps);
+    double cutoff = ratio * std::max(0.5, 1.0 - transition * 0.5);
+
+    double half = taps / 2.0;
+    double windowNorm = besselI0(settings.beta);
+    kernels.assign((size_t)tableRows * taps, 0.0f);
+
+    for (uint32_t row = 0; row < tableRows; row++) {
+        double fraction = exactPhases ? (double)row / phaseCount : (double)row / INTERPOLATED_PHASES;
+        float* kernel = kernels.data() + (size_t)row * taps;
+        double sum = 0.0;
+        for (uint32_t j = 0; j < taps; j++) {
+            // Tap j reads input (readIndex + j), which sits at j - (half - 1) - fraction
+            double x = (double)j - (half - 1.0) - fraction;
+            double sinc = x == 0.0 ? 1.0 : std::sin(M_PI * cutoff * x) / (M_PI * cutoff * x);
+            double t = x / half;
+            double window = std::fabs(t) >= 1.0 ? 0.0 : besselI0(settings.beta * std::sqrt(1.0 - t * t)) / windowNorm;
+            double value = cutoff * sinc * window;
+            kernel[j] = (float)value;
+            sum += value;
+        }
+
+        // Unity DC gain for every phase
+        if (sum != 0.0) {
+            for (uint32_t j = 0; j < taps; j++) {
+                kernel[j] = (float)(kernel[j] / sum);
+            }
+        }
+    }
+}
+
+void Resampler::reset() {
+    // Prime with half a filter of silence so output 0 lines up with input 0
+    size_t primeFrames = taps / 2 - 1;
+    ensureCapacity(primeFrames);
+    for (auto& channel : history) {
+        std::fill(channel.begin(), channel.begin() + primeFrames, 0.0f);
+    }
+    historyFrames = primeFrames;
+    readIndex = 0;
+    phase = 0;
+}
+
+void Resampler::ensureCapacity(size_t frames) {
+    for (auto& channel : history) {
+        if (channel.size() < frames) {
+            channel.resize(std::max(frames, channel.size() * 2));
+        }
+    }
+}
+
+void Resampler::prepare(size_t maxInputFrames) {
+    ensureCapacity(taps + maxInputFrames + 1);
+}
+
+const float* Resampler::kernelForPhase(uint64_t currentPhase) {
+    if (exactPhases) {
+        return kernels.data() + (size_t)currentPhase * taps;
+    }
+
+    // Blend the two nearest precomputed phases
+    uint64_t position = currentPhase * INTERPOLATED_PHASES;
+    uint64_t row = position / phaseCount;
+    float blend = (float)(position % phaseCount) / (float)phaseCount;
+    const float* a = kernels.data() + (size_t)row * taps;
+    const float* b = a + taps;
+    for (uint32_t j = 0; j < taps; j++) {
+        scratchKernel[j] = a[j] + (b[j] - a[j]) * blend;
+    }
+    return scratchKernel.data();
+}
+
+size_t Resampler::getOutputFramesFor(size_t inputFrames) const {
+    size_t available = historyFrames + inputFrames;
+    if (readIndex + taps > available) {
+        return 0;
+    }
+    // Output m (from the current one) needs floor((phase + m * step) / phaseCount)
+    // more input frames than the current one
+    uint64_t spare = available - taps - readIndex;
+    return (size_t)(((spare + 1) * phaseCount - phase - 1) / step) + 1;
+}
+
+size_t Resampler::getInputFramesFor(size_t outputFrames) const {
+    if (outputFrames == 0) {
+        return 0;
+    }
+    // The last of outputFrames outputs reads through this history frame
+    size_t needed = readIndex + taps + (size_t)((phase + (uint64_t)(outputFrames - 1) * step) / phaseCount);
+    return needed > historyFrames ? needed - historyFrames : 0;
+}
+
+size_t Resampler::getMaxInputFramesFor(size_t outputFrames) const {
+    return taps + (size_t)(((uint64_t)outputFrames * step + phaseCount - 1) / phaseCount) + 1;
+}
+
+size_t Resampler::process(const float* input, size_t inputFrames, float* output, size_t maxOutputFrames) {
+    // Append the new input to each channel's history
+    ensureCapacity(historyFrames + inputFrames);
+    for (uint32_t ch = 0; ch < channels; ch++) {
+        float* dst = history[ch].data() + historyFrames;
+        for (size_t i = 0; i < inputFrames; i++) {
+            dst[i] = input[i * channels + ch];
+        }
+    }
+    historyFrames += inputFrames;
+
+    size_t produced = 0;
+    while (produced < maxOutputFrames && readIndex + taps <= historyFrames) {
+        const float* kernel = kernelForPhase(phase);
+        float* frame = output + produced * channels;
+        for (uint32_t ch = 0; ch < channels; ch++) {
+            frame[ch] = dotProduct(history[ch].data() + readIndex, kernel, taps);
+        }
+        produced++;
+
+        phase += step;
+        readIndex += (size_t)(phase / phaseCount);
+        phase %= phaseCount;
+    }
+
+    // Drop history no future output can reach
+    size_t discard = std::min(readIndex, historyFrames);
+    if (discard > 0) {
+        size_t keep = historyFrames - discard;
+        for (auto& channel : history) {
+            std::memmove(channel.data(), channel.data() + discard, keep * sizeof(float));
+        }
+        historyFrames = keep;
+        readIndex -= discard;
+    }
+    return produced;
+}
+
+namespace ResamplerUtils {
+
+std::vector<float> resampleInterleaved(const float* input, size_t inputFrames, uint32_t channels,
+                                       uint32_t inputRate, uint32_t outputRate, ResamplerQuality quality) {
+    size_t outputFrames = (size_t)(((uint64_t)inputFrames * outputRate + inputRate - 1) / inputRate);
+    std::vector<float> output((size_t)outputFrames * channels, 0.0f);
+    if (inputFrames == 0 || channels == 0) {
+        return output;
+    }
+
+    Resampler resampler(inputRate, outputRate, channels, quality);
+    resampler.prepare(inputFrames);
+    size_t produced = resampler.process(input, inputFrames, output.data(), outputFrames);
+
+    // Flush the tail with silence until every output frame is written
+    std::vector<float> silence((size_t)resampler.getLatencyFrames() * channels, 0.0f);
+    while (produced < outputFrames) {
+        produced += resampler.process(silence.data(), resampler.getLatencyFrames(),
+                                      output.data() + produced * channels, outputFrames - produced);
+    }
+    return output;
+}
+
+} // namespace ResamplerUtils
@@ -0,0 +1,102 @@
+//
+//  Resampler.h
+//  SuperTerminal Framework - Audio Graph v2.0
+//
+//  Streaming polyphase windowed-sinc sample rate converter. Kernels are
+//  Kaiser-windowed sincs precomputed per phase; common rate pairs (44.1k,
+//  48k, 22.05k, 32k, 96k...) get an exact phase per output position, other
+//  ratios interpolate between 256 phases. The dot product runs 4 lanes wide
+//  (NEON or SSE, scalar fallback). Works on interleaved float frames and
+//  keeps its history between calls, so it can sit inside the graph.
+//
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Filter length and stopband trade-off
+enum class ResamplerQuality {
+    Fast,       // 16 taps,  ~50 dB alias rejection
+    Medium,     // 32 taps,  ~70 dB
+    High,       // 64 taps,  ~90 dB
+    Best        // 128 taps, ~110 dB
+};
+
+class Resampler {
+public:
+    Resampler(uint32_t inputRate, uint32_t outputRate, uint32_t channels,
+              ResamplerQuality quality = ResamplerQuality::High);
+
+    // Pre-size internal storage for blocks up to maxInputFrames so process()
+    // never allocates (call off the audio thread)
+    void prepare(size_t maxInputFrames);
+
+    // Consume all inputFrames interleaved frames; write at most
+    // maxOutputFrames. Returns frames written. Anything that did not fit
+    // is kept and emitted by the next call.
+    size_t process(const float* input, size_t inputFrames, float* output, size_t maxOutputFrames);
+
+    // Output frames the next process() call can produce for inputFrames
+    size_t getOutputFramesFor(size_t inputFrames) const;
+
+    // Fewest input frames for which the next process() call yields
+    // outputFrames (the inverse of getOutputFramesFor)
+    size_t getInputFramesFor(size_t outputFrames) const;
+
+    // Upper bound of getInputFramesFor(outputFrames) in any stream state,
+    // for sizing buffers up front
+    size_t getMaxInputFramesFor(size_t outputFrames) const;
+
+    // Drop all history (start of a new stream)
+    void reset();
+
+    uint32_t getInputRate() const { return inputRate; }
+    uint32_t getOutputRate() const { return outputRate; }
+    uint32_t getChannelCount() const { return channels; }
+    ResamplerQuality getQuality() const { return quality; }
+    uint32_t getTapCount() const { return taps; }       // Widened when downsampling
+    bool usesExactPhases() const { return exactPhases; }
+
+    // Input frames held back until the filter can see them (half the filter).
+    // Output is time aligned: frame n sits at input time n * inRate / outRate.
+    uint32_t getLatencyFrames() const { return taps / 2; }
+
+    static uint32_t tapsForQuality(ResamplerQuality quality);
+
+private:
+    uint32_t inputRate;
+    uint32_t outputRate;
+    uint32_t channels;
+    ResamplerQuality quality;
+    uint32_t taps = 0;
+
+    // Output n sits at input position n * step / phaseCount
+    uint64_t step = 0;                  // Input advance per output, in 1/phaseCount units
+    uint64_t phaseCount = 0;            // Exact: reduced output rate; else interpolated
+    bool exactPhases = false;
+    uint32_t tableRows = 0;
+    std::vector<float> kernels;         // tableRows x taps
+    std::vector<float> scratchKernel;   // Interpolated kernel (inexact ratios)
+
+    // Deinterleaved history per channel: [taps - 1 history][pending input]
+    std::vector<std::vector<float>> history;
+    size_t historyFrames = 0;
+    size_t readIndex = 0;               // First tap of the next output
+    uint64_t phase = 0;                 // 0 .. phaseCount-1
+
+    void buildKernels();
+    void ensureCapacity(size_t frames);
+    const float* kernelForPhase(uint64_t currentPhase);
+};
+
+namespace ResamplerUtils {
+    // Whole-buffer conversion of interleaved frames, latency compensated:
+    // output frame n lines up with input time n * inputRate / outputRate
+    std::vector<float> resampleInterleaved(const float* input, size_t inputFrames, uint32_t channels,
+                                           uint32_t inputRate, uint32_t outputRate,
+                                           ResamplerQuality quality = ResamplerQuality::High);
+}
@@ -0,0 +1,96 @@
+//
+//  ResamplerNode.cpp
+//  SuperTerminal Framework - Audio Graph v2.0
+//
+//  Sample rate conversion node
+//
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "ResamplerNode.h"
+#include "AudioBuffer.h"
+#include <algorithm>
+#include <cstring>
+
+ResamplerNode::ResamplerNode(uint32_t inputRate, uint32_t outputRate, uint32_t channels, ResamplerQuality quality)
+    : resampler(inputRate, outputRate, channels, quality)
+{
+    setNodeName("Resampler");
+}
+
+void ResamplerNode::prepare(size_t maxBlockFrames) {
+    uint32_t channels = resampler.getChannelCount();
+    size_t maxNeed = resampler.getMaxInputFramesFor(maxBlockFrames);
+    resampler.prepare(maxNeed);
+    // Room for a full block on top of what one output block can draw
+    fifo.resize((maxBlockFrames + maxNeed) * channels);
+    outputScratch.resize(maxBlockFrames * channels);
+    preparedFrames = maxBlockFrames;
+}
+
+void ResamplerNode::reset() {
+    resampler.reset();
+    fifoFrames = 0;
+    underrunFrames.store(0);
+    overrunFrames.store(0);
+}
+
+size_t ResamplerNode::getInputFramesFor(size_t outputFrames) const {
+    size_t needed = resampler.getInputFramesFor(outputFrames);
+    return needed > fifoFrames ? needed - fifoFrames : 0;
+}
+
+void ResamplerNode::processAudio(const AudioBuffer& inputBuffer, AudioBuffer& outputBuffer) {
+    uint32_t channels = resampler.getChannelCount();
+    if (inputBuffer.getChannelCount() != channels || outputBuffer.getChannelCount() != channels) {
+        outputBuffer.clear();
+        return;
+    }
+
+    uint32_t inputFrames = inputBuffer.getFrameCount();
+    uint32_t outputFrames = outputBuffer.getFrameCount();
+    if (std::max(inputFrames, outputFrames) > preparedFrames) {
+        prepare(std::max(inputFrames, outputFrames));
+    }
+
+    // Queue the new input behind what earlier blocks left over
+    size_t fifoCapacity = fifo.size() / channels;
+    size_t accepted = std::min((size_t)inputFrames, fifoCapacity - fifoFrames);
+    float* tail = fifo.data() + fifoFrames * channels;
+    if (inputBuffer.isInterleaved()) {
+        std::memcpy(tail, inputBuffer.getInterleavedData(), accepted * channels * sizeof(float));
+    } else {
+        for (size_t frame = 0; frame < accepted; ++frame) {
+            inputBuffer.getFrame((uint32_t)frame, tail + frame * channels);
+        }
+    }
+    fifoFrames += accepted;
+    if (accepted < inputFrames) {
+        overrunFrames.fetch_add(inputFrames - accepted);
+    }
+
+    float* output = outputBuffer.getInterleavedData();
+    if (!outputBuffer.isInterleaved()) {
+        output = outputScratch.data();
+    }
+
+    // Feed only what this block's output needs, so history never grows
+    size_t consumed = std::min(resampler.getInputFramesFor(outputFrames), fifoFrames);
+    size_t produced = resampler.process(fifo.data(), consumed, output, outputFrames);
+    fifoFrames -= consumed;
+    if (fifoFrames > 0) {
+        std::memmove(fifo.data(), fifo.data() + consumed * channels, fifoFrames * channels * sizeof(float));
+    }
+
+    // Anything the queued input could not cover is silence
+    if (produced < outputFrames) {
+        std::fill(output + produced * channels, output + (size_t)outputFrames * channels, 0.0f);
+        underrunFrames.fetch_add(outputFrames - produced);
+    }
+
+    if (!outputBuffer.isInterleaved()) {
+        for (uint32_t frame = 0; frame < outputFrames; ++frame) {
+            outputBuffer.setFrame(frame, output + (size_t)frame * channels);
+        }
+    }
+}
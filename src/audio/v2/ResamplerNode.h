@@ -0,0 +1,58 @@
+//
+//  ResamplerNode.h
+//  SuperTerminal Framework - Audio Graph v2.0
+//
+//  Effect node that converts a stream between sample rates with the
+//  polyphase Resampler (e.g. 44.1k assets into a 48k device graph).
+//  Input queues in a bounded FIFO and each block draws only the frames
+//  its output needs; upstream sizes its blocks with getInputFramesFor().
+//
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#pragma once
+
+#include "AudioNode.h"
+#include "Resampler.h"
+#include <atomic>
+#include <vector>
+
+class ResamplerNode : public AudioEffectNode {
+public:
+    ResamplerNode(uint32_t inputRate, uint32_t outputRate, uint32_t channels = 2,
+                  ResamplerQuality quality = ResamplerQuality::High);
+
+    std::string getNodeType() const override { return "Resampler"; }
+
+    // Reserve the input FIFO, history and scratch for blocks up to
+    // maxBlockFrames on either side (not on the audio thread)
+    void prepare(size_t maxBlockFrames);
+    void reset();
+
+    const Resampler& getResampler() const { return resampler; }
+
+    // Input frames upstream should supply so the next outputFrames block
+    // is fully covered (input and output blocks differ in size across rates)
+    size_t getInputFramesFor(size_t outputFrames) const;
+
+    // Input frames queued for later blocks
+    size_t getBufferedFrames() const { return fifoFrames; }
+
+    // Output frames zero-filled because too little input had arrived
+    uint64_t getUnderrunFrames() const { return underrunFrames.load(); }
+
+    // Input frames dropped because the FIFO was full
+    uint64_t getOverrunFrames() const { return overrunFrames.load(); }
+
+protected:
+    void processAudio(const AudioBuffer& inputBuffer, AudioBuffer& outputBuffer) override;
+
+private:
+    Resampler resampler;
+    size_t preparedFrames = 0;
+    std::vector<float> fifo;            // Interleaved input not yet resampled
+    size_t fifoFrames = 0;
+    std::vector<float> outputScratch;   // Used for non-interleaved buffers
+    std::atomic<uint64_t> underrunFrames{0};
+    std::atomic<uint64_t> overrunFrames{0};
+};
@@ -85,7 +85,7 @@ void SynthNode::generateAudio(AudioBuffer& outputBuffer) {
         return;
     }
     
-    auto startTime = std::chrono::high_resolution_clock::now();
+    auto startTime = std::chrono::steady_clock::now();
     
     // Process commands from other threads
     processCommands();
@@ -695,7 +695,8 @@ void SynthNode::applyGlobalEffects(AudioBuffer& outputBuffer) {
 void SynthNode::limitVoices() {
     std::lock_guard<std::mutex> lock(voicesMutex);
     
-    if (activeVoices.size() <= maxVoices) {
+    size_t limit = maxVoices.load();
+    if (activeVoices.size() <= limit) {
         return;
     }
     
@@ -705,7 +706,7 @@ void SynthNode::limitVoices() {
             return a->startTime < b->startTime;
         });
     
-    while (activeVoices.size() > maxVoices) {
+    while (activeVoices.size() > limit) {
         activeVoices.erase(activeVoices.begin());
     }
 }
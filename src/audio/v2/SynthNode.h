@@ -149,7 +149,7 @@ public:
     // Voice management
     size_t getActiveVoiceCount() const;
     size_t getMaxVoices() const { return maxVoices; }
-    void setMaxVoices(size_t max) { maxVoices = max; }
+    void setMaxVoices(size_t max) { maxVoices.store(max); }
     void clearAllVoices();
     
     // === REAL-TIME SYNTHESIS (NEW CAPABILITIES) ===
@@ -201,7 +201,7 @@ private:
     std::vector<std::unique_ptr<SynthVoice>> activeVoices;
     mutable std::mutex voicesMutex;
     std::atomic<uint32_t> nextSoundId{1};
-    size_t maxVoices = 64;
+    std::atomic<size_t> maxVoices{64};  // Set from any thread, read under voicesMutex
     
     // Real-time oscillators
     struct RealTimeOscillator {
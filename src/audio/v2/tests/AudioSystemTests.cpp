@@ -8,6 +8,7 @@
 //
 
 #include "AudioSystemTests.h"
+#include "PerformanceHarness.h"
 #include <iostream>
 #include <iomanip>
 #include <fstream>
@@ -1280,21 +1281,45 @@ bool fullValidationTest(bool generateReport) {
 }
 
 bool performanceRegressionTest(const std::string& baselineFile) {
-    // Placeholder implementation
-    std::cout << "Performance regression test not implemented yet" << std::endl;
-    return true;
+    PerformanceHarness harness;
+    std::vector<PerfMeasurement> measurements = harness.runWorkloads();
+
+    if (baselineFile.empty()) {
+        std::map<std::string, PerfBaselineEntry> none;
+        PerformanceHarness::compareToBaseline(measurements, none, std::cout);
+        std::cout << "No baseline given, measurements only" << std::endl;
+        return true;
+    }
+
+    std::map<std::string, PerfBaselineEntry> baseline;
+    std::string error;
+    if (!PerformanceHarness::loadBaseline(baselineFile, baseline, error)) {
+        std::cout << "❌ " << error << std::endl;
+        return false;
+    }
+    return PerformanceHarness::compareToBaseline(measurements, baseline, std::cout);
 }
 
 bool memoryLeakTest() {
-    // Placeholder implementation
-    std::cout << "Memory leak test not implemented yet" << std::endl;
+    PerformanceHarness harness;
+    int64_t drift = harness.measureLiveAllocationDrift(10);
+    if (drift != 0) {
+        std::cout << "❌ " << drift << " allocations leaked over 10 node lifecycles" << std::endl;
+        return false;
+    }
     return true;
 }
 
 bool threadSafetyTest() {
-    // Placeholder implementation
-    std::cout << "Thread safety test not implemented yet" << std::endl;
-    return true;
+    PerformanceHarness harness;
+    PerfStressResult result = harness.runParameterStress(2.0, 3);
+    std::cout << "Rendered " << result.blocksRendered << " blocks during "
+              << result.parameterChanges << " parameter changes, worst block "
+              << result.worstBlockUs << " us" << std::endl;
+    if (result.nonFiniteSamples > 0) {
+        std::cout << "❌ " << result.nonFiniteSamples << " non-finite samples" << std::endl;
+    }
+    return result.passed;
 }
 
 size_t getCurrentMemoryUsage() {
@@ -0,0 +1,666 @@
+//
+//  PerformanceHarness.cpp
+//  SuperTerminal Framework - Audio Graph v2.0
+//
+//  Performance regression, leak and parameter stress harness for the v2 graph
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "PerformanceHarness.h"
+#include "../AudioBuffer.h"
+#include "../AudioNode.h"
+#include "../ResamplerNode.h"
+#include "../SynthNode.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <thread>
+
+// =====================================================
+// Allocation counting
+// =====================================================
+
+namespace {
+std::atomic<int64_t> g_liveAllocations{0};
+thread_local uint64_t t_allocations = 0;
+}
+
+namespace {
+void* countedAllocate(std::size_t size) {
+    void* pointer = std::malloc(size ? size : 1);
+    if (pointer) {
+        t_allocations++;
+        g_liveAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    return pointer;
+}
+
+// GCC cannot tell these are the replacement operators and flags the free()
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void countedRelease(void* pointer) {
+    if (pointer) {
+        g_liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+        std::free(pointer);
+    }
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+}
+
+void* operator new(std::size_t size) {
+    void* pointer = countedAllocate(size);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept { countedRelease(pointer); }
+void operator delete[](void* pointer) noexcept { countedRelease(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { countedRelease(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { countedRelease(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { countedRelease(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { countedRelease(pointer); }
+
+namespace PerfAllocationCounter {
+    uint64_t threadAllocations() { return t_allocations; }
+    int64_t liveAllocations() { return g_liveAllocations.load(std::memory_order_relaxed); }
+}
+
+// =====================================================
+// Workloads
+// =====================================================
+
+namespace {
+
+// SynthEngine and SynthNode log to stdout on every construction
+class QuietOutput {
+public:
+    QuietOutput() : saved(std::cout.rdbuf(nullptr)) {}
+    ~QuietOutput() { std::cout.rdbuf(saved); }
+private:
+    std::streambuf* saved;
+};
+
+void fillTone(AudioBuffer& buffer, float frequency, float gain) {
+    for (uint32_t frame = 0; frame < buffer.getFrameCount(); ++frame) {
+        float sample = gain * std::sin(2.0f * float(M_PI) * frequency * frame / buffer.getSampleRate());
+        for (uint32_t ch = 0; ch < buffer.getChannelCount(); ++ch) {
+            buffer.setSample(frame, ch, sample);
+        }
+    }
+}
+
+// Stand-in source so the mixer sees real connections
+class HarnessToneNode : public AudioSourceNode {
+public:
+    std::string getNodeType() const override { return "HarnessTone"; }
+protected:
+    void generateAudio(AudioBuffer& outputBuffer) override { fillTone(outputBuffer, 220.0f, 0.1f); }
+};
+
+struct Workload {
+    virtual ~Workload() = default;
+    virtual void beginRepetition() {}
+    virtual void block() = 0;
+};
+
+struct BufferMixWorkload : Workload {
+    std::vector<AudioBuffer> sources;
+    AudioBuffer output;
+
+    explicit BufferMixWorkload(const PerfHarnessConfig& config)
+        : output(config.blockFrames, config.channels, config.sampleRate) {
+        for (int i = 0; i < 16; i++) {
+            sources.emplace_back(config.blockFrames, config.channels, config.sampleRate);
+            fillTone(sources.back(), 110.0f * (i + 1), 0.05f);
+        }
+    }
+
+    void block() override {
+        output.clear();
+        for (size_t i = 0; i < sources.size(); i++) {
+            output.mixFrom(sources[i], 0.5f + 0.03f * i);
+        }
+        output.applyGain(0.8f);
+    }
+};
+
+struct BufferPanRampWorkload : Workload {
+    AudioBuffer source;
+    AudioBuffer work;
+
+    explicit BufferPanRampWorkload(const PerfHarnessConfig& config)
+        : source(config.blockFrames, config.channels, config.sampleRate)
+        , work(config.blockFrames, config.channels, config.sampleRate) {
+        fillTone(source, 440.0f, 0.5f);
+    }
+
+    void block() override {
+        work.copyFrom(source);
+        work.applyGainRamp(0.2f, 0.9f);
+        work.applyPan(-0.35f);
+        work.fade(true, work.getFrameCount() / 4);
+    }
+};
+
+struct BufferAnalysisWorkload : Workload {
+    AudioBuffer source;
+    volatile float sink = 0.0f;
+
+    explicit BufferAnalysisWorkload(const PerfHarnessConfig& config)
+        : source(config.blockFrames, config.channels, config.sampleRate) {
+        fillTone(source, 330.0f, 0.7f);
+    }
+
+    void block() override {
+        float value = source.getPeakLevel() + source.getRMSLevel();
+        value += source.hasClipping() ? 1.0f : 0.0f;
+        value += source.isSilent() ? 1.0f : 0.0f;
+        sink = value;
+    }
+};
+
+struct BufferLayoutWorkload : Workload {
+    AudioBuffer work;
+
+    explicit BufferLayoutWorkload(const PerfHarnessConfig& config)
+        : work(config.blockFrames, config.channels, config.sampleRate) {
+        fillTone(work, 550.0f, 0.5f);
+    }
+
+    void block() override {
+        work.convertToNonInterleaved();
+        work.convertToInterleaved();
+    }
+};
+
+struct MixerNodeWorkload : Workload {
+    std::shared_ptr<AudioMixerNode> mixer = std::make_shared<AudioMixerNode>(8);
+    std::vector<std::shared_ptr<AudioNode>> inputs;
+    AudioBuffer input;
+    AudioBuffer output;
+
+    explicit MixerNodeWorkload(const PerfHarnessConfig& config)
+        : input(config.blockFrames, config.channels, config.sampleRate)
+        , output(config.blockFrames, config.channels, config.sampleRate) {
+        fillTone(input, 440.0f, 0.2f);
+        for (size_t i = 0; i < 8; i++) {
+            inputs.push_back(std::make_shared<HarnessToneNode>());
+            inputs.back()->connect(mixer);
+            mixer->setChannelVolume(i, 0.5f + 0.1f * i);
+            mixer->setChannelPan(i, -0.8f + 0.2f * i);
+        }
+    }
+
+    void block() override { mixer->process(input, output); }
+};
+
+struct SynthVoicesWorkload : Workload {
+    std::shared_ptr<SynthNode> synth;
+    std::vector<uint32_t> sounds;
+    AudioBuffer silence;
+    AudioBuffer output;
+
+    explicit SynthVoicesWorkload(const PerfHarnessConfig& config)
+        : silence(config.blockFrames, config.channels, config.sampleRate)
+        , output(config.blockFrames, config.channels, config.sampleRate) {
+        QuietOutput quiet;
+        synth = std::make_shared<SynthNode>();
+        synth->initialize();
+        for (int i = 0; i < 16; i++) {
+            sounds.push_back(synth->generateBeepToMemory(220.0f + 40.0f * i, 3.0f));
+        }
+    }
+
+    void beginRepetition() override {
+        // Restart every voice so each repetition renders the same material
+        for (size_t i = 0; i < sounds.size(); i++) {
+            synth->playSound(sounds[i], 0.5f, 1.0f, -0.5f + float(i) / sounds.size());
+        }
+    }
+
+    void block() override { synth->process(silence, output); }
+};
+
+struct SynthOscillatorsWorkload : Workload {
+    std::shared_ptr<SynthNode> synth;
+    AudioBuffer silence;
+    AudioBuffer output;
+
+    explicit SynthOscillatorsWorkload(const PerfHarnessConfig& config)
+        : silence(config.blockFrames, config.channels, config.sampleRate)
+        , output(config.blockFrames, config.channels, config.sampleRate) {
+        QuietOutput quiet;
+        synth = std::make_shared<SynthNode>();
+        synth->initialize();
+        const WaveformType waves[] = {WAVE_SINE, WAVE_SQUARE, WAVE_SAWTOOTH, WAVE_TRIANGLE};
+        for (int i = 0; i < 8; i++) {
+            uint32_t osc = synth->createRealTimeOscillator(waves[i % 4], 110.0f * (i + 1));
+            synth->setOscillatorAmplitude(osc, 0.1f);
+            synth->triggerOscillator(osc);
+        }
+    }
+
+    void block() override { synth->process(silence, output); }
+};
+
+struct ResamplerNodeWorkload : Workload {
+    ResamplerNode node;
+    AudioBuffer input;
+    AudioBuffer output;
+
+    explicit ResamplerNodeWorkload(const PerfHarnessConfig& config)
+        : node(config.sampleRate, 48000, config.channels)
+        , input(config.blockFrames, config.channels, config.sampleRate)
+        , output(config.blockFrames, config.channels, 48000) {
+        fillTone(input, 1000.0f, 0.5f);
+        node.prepare(config.blockFrames * 2);
+        input.reserve(config.blockFrames * 2);
+    }
+
+    void block() override {
+        // Pull exactly the source frames this device block needs (no reallocation)
+        input.resize(static_cast<uint32_t>(node.getInputFramesFor(output.getFrameCount())));
+        node.process(input, output);
+    }
+};
+
+struct GraphWorkload : Workload {
+    std::shared_ptr<SynthNode> synth;
+    std::shared_ptr<AudioMixerNode> mixer = std::make_shared<AudioMixerNode>(4);
+    std::shared_ptr<AudioOutputNode> outputNode = std::make_shared<AudioOutputNode>();
+    std::vector<uint32_t> sounds;
+    AudioBuffer silence;
+    AudioBuffer synthOut;
+    AudioBuffer mixOut;
+    AudioBuffer finalOut;
+
+    explicit GraphWorkload(const PerfHarnessConfig& config)
+        : silence(config.blockFrames, config.channels, config.sampleRate)
+        , synthOut(config.blockFrames, config.channels, config.sampleRate)
+        , mixOut(config.blockFrames, config.channels, config.sampleRate)
+        , finalOut(config.blockFrames, config.channels, config.sampleRate) {
+        QuietOutput quiet;
+        synth = std::make_shared<SynthNode>();
+        synth->initialize();
+        for (int i = 0; i < 4; i++) {
+            sounds.push_back(synth->generateBeepToMemory(330.0f + 55.0f * i, 3.0f));
+        }
+        uint32_t osc = synth->createRealTimeOscillator(WAVE_SINE, 220.0f);
+        synth->setOscillatorAmplitude(osc, 0.1f);
+        synth->triggerOscillator(osc);
+        synth->connect(mixer);
+        mixer->connect(outputNode);
+    }
+
+    void beginRepetition() override {
+        for (uint32_t sound : sounds) {
+            synth->playSound(sound, 0.4f);
+        }
+    }
+
+    void block() override {
+        synth->process(silence, synthOut);
+        mixer->process(synthOut, mixOut);
+        outputNode->process(mixOut, finalOut);
+    }
+};
+
+std::unique_ptr<Workload> makeWorkload(const std::string& name, const PerfHarnessConfig& config) {
+    if (name == "buffer_mix_16") return std::make_unique<BufferMixWorkload>(config);
+    if (name == "buffer_pan_ramp") return std::make_unique<BufferPanRampWorkload>(config);
+    if (name == "buffer_analysis") return std::make_unique<BufferAnalysisWorkload>(config);
+    if (name == "buffer_layout") return std::make_unique<BufferLayoutWorkload>(config);
+    if (name == "mixer_node_8") return std::make_unique<MixerNodeWorkload>(config);
+    if (name == "synth_voices_16") return std::make_unique<SynthVoicesWorkload>(config);
+    if (name == "synth_oscillators_8") return std::make_unique<SynthOscillatorsWorkload>(config);
+    if (name == "resampler_node") return std::make_unique<ResamplerNodeWorkload>(config);
+    if (name == "graph_synth_mixer_output") return std::make_unique<GraphWorkload>(config);
+    return nullptr;
+}
+
+double microsecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+// =====================================================
+// PerformanceHarness
+// =====================================================
+
+PerformanceHarness::PerformanceHarness(const PerfHarnessConfig& harnessConfig)
+    : config(harnessConfig) {
+}
+
+std::vector<std::string> PerformanceHarness::getWorkloadNames() {
+    return {"buffer_mix_16", "buffer_pan_ramp", "buffer_analysis", "buffer_layout", "mixer_node_8",
+            "synth_voices_16", "synth_oscillators_8", "resampler_node", "graph_synth_mixer_output"};
+}
+
+PerfMeasurement PerformanceHarness::runWorkload(const std::string& name) {
+    PerfMeasurement measurement;
+    measurement.name = name;
+
+    std::unique_ptr<Workload> workload = makeWorkload(name, config);
+    if (!workload) {
+        return measurement;
+    }
+
+    // Warm up caches and any lazily sized state outside the measurement
+    workload->beginRepetition();
+    for (int i = 0; i < 20; i++) {
+        workload->block();
+    }
+
+    double bestNs = 1e300;
+    uint64_t allocations = 0;
+    for (uint32_t rep = 0; rep < config.repetitions; rep++) {
+        workload->beginRepetition();
+
+        uint64_t allocationsBefore = PerfAllocationCounter::threadAllocations();
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t b = 0; b < config.blocksPerRepetition; b++) {
+            auto blockStart = std::chrono::steady_clock::now();
+            workload->block();
+            measurement.worstBlockUs = std::max(measurement.worstBlockUs, microsecondsSince(blockStart));
+        }
+        double elapsedNs = microsecondsSince(start) * 1000.0;
+        allocations += PerfAllocationCounter::threadAllocations() - allocationsBefore;
+
+        double frames = double(config.blocksPerRepetition) * config.blockFrames;
+        bestNs = std::min(bestNs, elapsedNs / frames);
+        measurement.blocks += config.blocksPerRepetition;
+    }
+
+    measurement.nsPerSample = bestNs;
+    measurement.allocationsPerBlock = double(allocations) / measurement.blocks;
+
+    QuietOutput quiet;
+    workload.reset();
+    return measurement;
+}
+
+std::vector<PerfMeasurement> PerformanceHarness::runWorkloads() {
+    std::vector<PerfMeasurement> measurements;
+    for (const std::string& name : getWorkloadNames()) {
+        measurements.push_back(runWorkload(name));
+    }
+    return measurements;
+}
+
+bool PerformanceHarness::loadBaseline(const std::string& path, std::map<std::string, PerfBaselineEntry>& baseline,
+                                      std::string& error) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        error = "Cannot open baseline file: " + path;
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+
+        std::istringstream fields(line);
+        PerfBaselineEntry entry;
+        if (!(fields >> entry.name)) {
+            continue;
+        }
+        if (!(fields >> entry.nsPerSample >> entry.nsTolerance >> entry.allocationsPerBlock >> entry.allocationTolerance)) {
+            error = path + ":" + std::to_string(lineNumber) + ": expected name ns tolerance allocs allocTolerance";
+            return false;
+        }
+        baseline[entry.name] = entry;
+    }
+    return true;
+}
+
+bool PerformanceHarness::writeBaseline(const std::string& path, const std::vector<PerfMeasurement>& measurements,
+                                       const std::map<std::string, PerfBaselineEntry>& previous) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << "# SuperTerminal audio v2 performance baseline\n";
+    file << "# Regenerate with: test_audio_v2_performance --update-baseline <this file>\n";
+    file << "#\n";
+    file << "# name  ns_per_sample_frame  ns_tolerance(x)  allocs_per_block  alloc_tolerance(+)\n";
+    for (const PerfMeasurement& measurement : measurements) {
+        // Keep hand-tuned tolerance bands when refreshing numbers
+        PerfBaselineEntry entry;
+        auto it = previous.find(measurement.name);
+        if (it != previous.end()) {
+            entry = it->second;
+        }
+        file << std::left << std::setw(28) << measurement.name << std::right << std::fixed
+             << std::setprecision(3) << std::setw(10) << measurement.nsPerSample
+             << std::setprecision(1) << std::setw(6) << entry.nsTolerance
+             << std::setprecision(2) << std::setw(8) << measurement.allocationsPerBlock
+             << std::setprecision(1) << std::setw(6) << entry.allocationTolerance << "\n";
+    }
+    return file.good();
+}
+
+bool PerformanceHarness::compareToBaseline(const std::vector<PerfMeasurement>& measurements,
+                                           const std::map<std::string, PerfBaselineEntry>& baseline,
+                                           std::ostream& report) {
+    bool passed = true;
+    for (const PerfMeasurement& measurement : measurements) {
+        report << "  " << std::left << std::setw(26) << measurement.name << std::right << std::fixed
+               << std::setprecision(3) << std::setw(9) << measurement.nsPerSample << " ns/sample"
+               << std::setprecision(2) << std::setw(8) << measurement.allocationsPerBlock << " allocs/block"
+               << std::setprecision(1) << std::setw(8) << measurement.worstBlockUs << " us worst";
+
+        auto it = baseline.find(measurement.name);
+        if (it == baseline.end()) {
+            report << "  MISSING FROM BASELINE" << std::endl;
+            passed = false;
+            continue;
+        }
+
+        const PerfBaselineEntry& entry = it->second;
+        double nsLimit = entry.nsPerSample * entry.nsTolerance;
+        double allocationLimit = entry.allocationsPerBlock + entry.allocationTolerance;
+        bool slow = measurement.nsPerSample > nsLimit;
+        bool allocating = measurement.allocationsPerBlock > allocationLimit + 1e-9;
+
+        if (slow || allocating) {
+            passed = false;
+            report << "  REGRESSION";
+            if (slow) report << " (time limit " << std::setprecision(3) << nsLimit << ")";
+            if (allocating) report << " (allocation limit " << std::setprecision(2) << allocationLimit << ")";
+        } else if (measurement.allocationsPerBlock + 1e-9 < entry.allocationsPerBlock) {
+            report << "  ok, fewer allocations than baseline";
+        } else {
+            report << "  ok";
+        }
+        report << std::endl;
+    }
+    return passed;
+}
+
+int64_t PerformanceHarness::measureLiveAllocationDrift(int cycles) {
+    auto cycle = [this]() {
+        QuietOutput quiet;
+        auto synth = std::make_shared<SynthNode>();
+        synth->initialize();
+        auto mixer = std::make_shared<AudioMixerNode>(4);
+        auto outputNode = std::make_shared<AudioOutputNode>();
+        ResamplerNode resampler(config.sampleRate, 48000, config.channels);
+
+        std::vector<uint32_t> sounds;
+        for (int i = 0; i < 4; i++) {
+            sounds.push_back(synth->generateBeepToMemory(300.0f + 50.0f * i, 0.2f));
+        }
+        uint32_t osc = synth->createRealTimeOscillator(WAVE_SAWTOOTH, 110.0f);
+        synth->triggerOscillator(osc);
+        synth->connect(mixer);
+        mixer->connect(outputNode);
+
+        AudioBuffer silence(config.blockFrames, config.channels, config.sampleRate);
+        AudioBuffer synthOut(silence), mixOut(silence), finalOut(silence);
+        AudioBuffer resampled(config.blockFrames * 2, config.channels, 48000);
+        for (int b = 0; b < 20; b++) {
+            if (b == 5) synth->playSound(sounds[0]);
+            synth->process(silence, synthOut);
+            mixer->process(synthOut, mixOut);
+            outputNode->process(mixOut, finalOut);
+            resampler.process(finalOut, resampled);
+        }
+        synth->releaseOscillator(osc);
+        synth->runGarbageCollection();
+        synth->disconnectAll();
+        mixer->disconnectAll();
+        synth->shutdown();
+    };
+
+    // First cycle may size process-wide state (tables, iostream buffers)
+    cycle();
+    int64_t before = PerfAllocationCounter::liveAllocations();
+    for (int i = 0; i < cycles; i++) {
+        cycle();
+    }
+    return PerfAllocationCounter::liveAllocations() - before;
+}
+
+PerfStressResult PerformanceHarness::runParameterStress(double seconds, int writerThreads) {
+    PerfStressResult result;
+
+    std::shared_ptr<SynthNode> synth;
+    std::vector<uint32_t> sounds;
+    std::vector<uint32_t> oscillators;
+    {
+        QuietOutput quiet;
+        synth = std::make_shared<SynthNode>();
+        synth->initialize();
+        for (int i = 0; i < 8; i++) {
+            sounds.push_back(synth->generateBeepToMemory(200.0f + 60.0f * i, 0.5f));
+        }
+        for (int i = 0; i < 4; i++) {
+            oscillators.push_back(synth->createRealTimeOscillator(WAVE_SINE, 220.0f * (i + 1)));
+            synth->triggerOscillator(oscillators.back());
+        }
+    }
+    auto mixer = std::make_shared<AudioMixerNode>(4);
+    auto outputNode = std::make_shared<AudioOutputNode>();
+    synth->connect(mixer);
+    mixer->connect(outputNode);
+
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> changes{0};
+
+    std::thread audioThread([&]() {
+        AudioBuffer silence(config.blockFrames, config.channels, config.sampleRate);
+        AudioBuffer synthOut(silence), mixOut(silence), finalOut(silence);
+        while (running.load(std::memory_order_relaxed)) {
+            auto blockStart = std::chrono::steady_clock::now();
+            synth->process(silence, synthOut);
+            mixer->process(synthOut, mixOut);
+            outputNode->process(mixOut, finalOut);
+            result.worstBlockUs = std::max(result.worstBlockUs, microsecondsSince(blockStart));
+
+            const float* samples = finalOut.getInterleavedData();
+            for (uint32_t i = 0; i < finalOut.getSampleCount(); i++) {
+                if (!std::isfinite(samples[i])) {
+                    result.nonFiniteSamples++;
+                }
+            }
+            result.blocksRendered++;
+        }
+    });
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < writerThreads; w++) {
+        writers.emplace_back([&, w]() {
+            uint32_t state = 0x9E3779B9u * (w + 1);
+            auto next = [&state]() {
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                return state;
+            };
+            auto unit = [&next]() { return (next() & 0xFFFF) / 65535.0f; };
+
+            uint64_t count = 0;
+            while (running.load(std::memory_order_relaxed)) {
+                switch (next() % 13) {
+                    case 0: mixer->setChannelVolume(next() % 4, unit() * 2.0f); break;
+                    case 1: mixer->setChannelPan(next() % 4, unit() * 2.0f - 1.0f); break;
+                    case 2: mixer->setParameter("master_volume", unit() * 2.0f); break;
+                    case 3: synth->setParameter("global_volume", unit() * 2.0f); break;
+                    case 4: synth->setParameter("filter_cutoff", 20.0f + unit() * 15000.0f); break;
+                    case 5: synth->setOscillatorFrequency(oscillators[next() % oscillators.size()], 50.0f + unit() * 2000.0f); break;
+                    case 6: synth->setOscillatorAmplitude(oscillators[next() % oscillators.size()], unit()); break;
+                    case 7:
+                        if (next() & 1) synth->triggerOscillator(oscillators[next() % oscillators.size()]);
+                        else synth->releaseOscillator(oscillators[next() % oscillators.size()]);
+                        break;
+                    case 8: synth->playSound(sounds[next() % sounds.size()], unit(), 1.0f, unit() * 2.0f - 1.0f); break;
+                    case 9: synth->setVolume(unit()); mixer->setVolume(0.5f + unit()); break;
+                    case 10: {
+                        uint32_t temporary = synth->createRealTimeOscillator(WAVE_SQUARE, 440.0f);
+                        synth->triggerOscillator(temporary);
+                        std::this_thread::yield();
+                        synth->deleteOscillator(temporary);
+                        break;
+                    }
+                    case 11: synth->setParameter("max_voices", 4.0f + (next() % 60)); break;
+                    case 12: outputNode->setMasterVolume(unit()); break;
+                }
+                count++;
+                if ((count & 63) == 0) {
+                    std::this_thread::yield();
+                }
+            }
+            changes.fetch_add(count);
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    running.store(false);
+    for (std::thread& writer : writers) {
+        writer.join();
+    }
+    audioThread.join();
+
+    QuietOutput quiet;
+    synth->disconnectAll();
+    mixer->disconnectAll();
+    synth->shutdown();
+    synth.reset();
+
+    result.parameterChanges = changes.load();
+    result.passed = result.blocksRendered > 0 && result.parameterChanges > 0 && result.nonFiniteSamples == 0;
+    return result;
+}
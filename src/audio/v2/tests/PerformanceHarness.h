@@ -0,0 +1,98 @@
+//
+//  PerformanceHarness.h
+//  SuperTerminal Framework - Audio Graph v2.0
+//
+//  Headless performance regression harness for the v2 graph. Runs buffer
+//  math, mixer, synth, resampler and output nodes on fixed workloads,
+//  records ns per sample frame and heap allocations per block, and checks
+//  them against a checked-in baseline with tolerance bands. Also has a leak
+//  check (live allocation drift over create/render/destroy cycles) and a
+//  stress mode that changes parameters on live nodes from several threads
+//  while an audio thread renders.
+//
+//  Allocation counts come from replacement global operator new/delete in
+//  PerformanceHarness.cpp, so link it only into test executables.
+//
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+struct PerfMeasurement {
+    std::string name;
+    double nsPerSample = 0.0;           // Per sample frame, best repetition
+    double allocationsPerBlock = 0.0;
+    double worstBlockUs = 0.0;
+    uint64_t blocks = 0;
+};
+
+struct PerfBaselineEntry {
+    std::string name;
+    double nsPerSample = 0.0;
+    double nsTolerance = 3.0;           // Fail above nsPerSample x nsTolerance
+    double allocationsPerBlock = 0.0;
+    double allocationTolerance = 0.0;   // Fail above allocationsPerBlock + this
+};
+
+struct PerfStressResult {
+    uint64_t blocksRendered = 0;
+    uint64_t parameterChanges = 0;
+    uint64_t nonFiniteSamples = 0;
+    double worstBlockUs = 0.0;
+    bool passed = false;
+};
+
+struct PerfHarnessConfig {
+    uint32_t sampleRate = 44100;
+    uint32_t channels = 2;
+    uint32_t blockFrames = 512;
+    uint32_t blocksPerRepetition = 200;
+    uint32_t repetitions = 5;
+};
+
+class PerformanceHarness {
+public:
+    explicit PerformanceHarness(const PerfHarnessConfig& config = PerfHarnessConfig{});
+
+    // Workload names in run order
+    static std::vector<std::string> getWorkloadNames();
+
+    std::vector<PerfMeasurement> runWorkloads();
+    PerfMeasurement runWorkload(const std::string& name);
+
+    // Baseline file: one "name ns tolerance allocs allocTolerance" line per
+    // workload, '#' comments
+    static bool loadBaseline(const std::string& path, std::map<std::string, PerfBaselineEntry>& baseline,
+                             std::string& error);
+    static bool writeBaseline(const std::string& path, const std::vector<PerfMeasurement>& measurements,
+                              const std::map<std::string, PerfBaselineEntry>& previous = {});
+
+    // Prints one line per workload; returns false on any regression or a
+    // workload missing from the baseline
+    static bool compareToBaseline(const std::vector<PerfMeasurement>& measurements,
+                                  const std::map<std::string, PerfBaselineEntry>& baseline,
+                                  std::ostream& report);
+
+    // Live allocations left behind by create/render/destroy cycles (0 = no leak)
+    int64_t measureLiveAllocationDrift(int cycles);
+
+    // Concurrent parameter changes on live nodes while one thread renders
+    PerfStressResult runParameterStress(double seconds, int writerThreads);
+
+    const PerfHarnessConfig& getConfig() const { return config; }
+
+private:
+    PerfHarnessConfig config;
+};
+
+// Counters maintained by the replacement operator new/delete
+namespace PerfAllocationCounter {
+    uint64_t threadAllocations();       // Allocations made by the calling thread
+    int64_t liveAllocations();          // Process-wide outstanding allocations
+}
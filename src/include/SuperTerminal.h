@@ -656,6 +656,104 @@ float sprite_get_aspect_ratio(uint16_t id);
  */
 bool sprite_create_from_pixels(uint16_t id, const uint8_t* pixels, int width, int height);
 
+/**
+ * Define an atlas: a list of frame rectangles inside a sprite texture.
+ * Replaces any atlas with the same id.
+ *
+ * @param atlas_id Caller-chosen atlas ID
+ * @param texture_width Texture width in pixels
+ * @param texture_height Texture height in pixels
+ * @return true if the atlas was created
+ */
+bool sprite_atlas_create(uint32_t atlas_id, int texture_width, int texture_height);
+
+/**
+ * Add one frame rectangle to an atlas.
+ *
+ * @return Frame index (0-based), or -1 if the atlas does not exist or the
+ *         rectangle lies outside the texture
+ */
+int sprite_atlas_add_frame(uint32_t atlas_id, int x, int y, int width, int height);
+
+/**
+ * Define an atlas as a row-major grid of equal frames.
+ *
+ * @param margin Border around the grid in pixels
+ * @param spacing Gap between frames in pixels
+ * @return Number of frames in the atlas (0 on failure)
+ */
+int sprite_atlas_define_grid(uint32_t atlas_id, int texture_width, int texture_height,
+                             int frame_width, int frame_height, int margin, int spacing);
+
+/**
+ * Define an animation clip over a range of atlas frames. A first frame
+ * greater than the last plays the range backwards. Redefining a clip
+ * restarts the sprites playing it.
+ *
+ * @param frame_duration Seconds per frame
+ * @param mode 0 = once, 1 = loop, 2 = ping-pong
+ * @return true if the atlas exists and the frames are in range
+ */
+bool sprite_clip_define(uint32_t clip_id, uint32_t atlas_id, int first_frame, int last_frame,
+                        float frame_duration, int mode);
+
+/**
+ * Override the duration of one clip frame (0-based index within the clip).
+ */
+bool sprite_clip_set_frame_duration(uint32_t clip_id, int clip_frame, float seconds);
+
+/**
+ * Attach an event id to a clip frame; it is reported through
+ * sprite_animation_poll_event each time a sprite enters that frame.
+ */
+bool sprite_clip_add_event(uint32_t clip_id, int clip_frame, int event_id);
+
+/**
+ * Play a clip on a sprite. Animations advance natively on the fixed
+ * simulation step, with no per-frame script calls.
+ *
+ * @param speed Playback rate multiplier (1.0 = clip timing)
+ * @param restart false keeps the position if the clip is already playing
+ * @return true if the clip exists
+ */
+bool sprite_animation_play(uint16_t id, uint32_t clip_id, float speed, bool restart);
+
+/**
+ * Stop animating a sprite; it keeps showing its current frame.
+ */
+bool sprite_animation_stop(uint16_t id);
+
+/**
+ * Pause or resume a sprite's animation.
+ */
+bool sprite_animation_pause(uint16_t id, bool paused);
+
+/**
+ * Change a sprite's playback rate multiplier.
+ */
+bool sprite_animation_set_speed(uint16_t id, float speed);
+
+/**
+ * Get the current 0-based frame within the playing clip.
+ *
+ * @return Clip frame, or -1 if the sprite is not animated
+ */
+int sprite_animation_get_frame(uint16_t id);
+
+/**
+ * Check whether a sprite's animation is running (not finished or paused).
+ */
+bool sprite_animation_is_playing(uint16_t id);
+
+/**
+ * Pop the oldest pending animation event.
+ *
+ * @param type 0 = frame event, 1 = loop completed, 2 = once clip finished
+ * @param event_id Event id for frame events, 0 otherwise
+ * @return false if no events are pending
+ */
+bool sprite_animation_poll_event(uint16_t* sprite_id, uint32_t* clip_id, int* type, int* event_id);
+
 /**
  * Check if two sprites are colliding using AABB collision detection.
  *
@@ -675,6 +773,36 @@ bool sprite_check_collision(uint16_t id1, uint16_t id2);
  */
 bool sprite_check_point_collision(uint16_t id, float x, float y);
 
+/**
+ * Find the topmost visible sprite at a point, using the native pick index
+ * (a grid over sprite bounds updated as sprites move). Rotation and scale
+ * are honoured.
+ *
+ * @param pixel_accurate Ignore texels whose alpha is (nearly) transparent
+ * @return Sprite ID, or 0 if no sprite is under the point
+ */
+uint16_t sprite_pick(float x, float y, bool pixel_accurate);
+
+/**
+ * Find every visible sprite at a point, topmost first.
+ *
+ * @param ids Receives up to max_ids sprite IDs (may be NULL)
+ * @return Number of sprites found, which may exceed max_ids
+ */
+int sprite_pick_all(float x, float y, bool pixel_accurate, uint16_t* ids, int max_ids);
+
+/**
+ * Find every visible sprite overlapping a rectangle, topmost first.
+ *
+ * @return Number of sprites found, which may exceed max_ids
+ */
+int sprite_pick_rect(float x, float y, float width, float height, uint16_t* ids, int max_ids);
+
+/**
+ * Hit-test one visible sprite against a point.
+ */
+bool sprite_hit_test(uint16_t id, float x, float y, bool pixel_accurate);
+
 /**
  * Clear all sprite data and free allocated memory.
  * Clears all sprites and resets the system for new sprite data.
@@ -826,6 +954,46 @@ void tile_center_viewport(int layer, int tile_x, int tile_y);
  */
 bool tile_is_valid_position(int layer, int x, int y);
 
+/**
+ * Animate every cell holding a base tile through a sequence of tiles.
+ * The map keeps the base id; the displayed tile is chosen at render time
+ * from a global clock, so all cells of the type animate in step without
+ * any per-frame script work. Redefining replaces the sequence.
+ *
+ * @param base_tile Tile id placed in the map (1-256)
+ * @param frames Tile ids to show in order (1-256); may include base_tile
+ * @param frame_count Number of frames (1-256)
+ * @param frame_duration Seconds per frame
+ * @return true if all ids are valid
+ */
+bool tile_animation_define(uint16_t base_tile, const uint16_t* frames, int frame_count, float frame_duration);
+
+/**
+ * Override the duration of one animation frame (0-based).
+ */
+bool tile_animation_set_frame_duration(uint16_t base_tile, int frame_index, float seconds);
+
+/**
+ * Stop animating a base tile; its cells show the base tile again.
+ */
+bool tile_animation_remove(uint16_t base_tile);
+
+/**
+ * Remove all tile animations.
+ */
+void tile_animation_clear(void);
+
+/**
+ * Freeze or resume all tile animations.
+ */
+void tile_animation_set_paused(bool paused);
+
+/**
+ * Tile currently displayed for cells holding tile_id (tile_id itself when
+ * it is not animated).
+ */
+uint16_t tile_animation_get_frame(uint16_t tile_id);
+
 // MARK: - Background Layer (Layer 1)
 
 /**
@@ -1490,6 +1658,21 @@ void console(const char* message);
 #define ST_MOUSE_RIGHT   1
 #define ST_MOUSE_MIDDLE  2
 
+// Mouse event types
+#define ST_MOUSE_EVENT_PRESS    0
+#define ST_MOUSE_EVENT_RELEASE  1
+#define ST_MOUSE_EVENT_MOVE     2
+#define ST_MOUSE_EVENT_WHEEL    3
+
+// One entry of the mouse event stream
+typedef struct {
+    int type;               // ST_MOUSE_EVENT_*
+    int button;             // Press/release button code, -1 otherwise
+    float x, y;             // Mouse position when the event happened
+    float delta_x, delta_y; // Wheel scroll amount
+    double time;            // Seconds on a monotonic clock
+} MouseEventInfo;
+
 /**
  * Get current mouse position.
  *
@@ -1508,7 +1691,9 @@ bool mouse_is_pressed(int button);
 
 /**
  * Wait for mouse click (blocking).
- * This function blocks until a mouse button is clicked.
+ * This function blocks until a mouse button is clicked and released. It
+ * sleeps on the mouse event stream rather than polling, and does not remove
+ * events from it.
  *
  * @param button Pointer to store button code that was clicked
  * @param x Pointer to store X coordinate of click
@@ -1518,13 +1703,44 @@ bool mouse_is_pressed(int button);
 bool mouse_wait_click(int* button, float* x, float* y);
 
 /**
- * Check if mouse cursor is over a sprite.
+ * Drain queued mouse events, oldest first. Presses, releases and wheel
+ * steps are kept in order with their timestamps; consecutive moves collapse
+ * into the latest position.
+ *
+ * @param events Receives up to max_events events
+ * @return Number of events copied
+ */
+int mouse_poll_events(MouseEventInfo* events, int max_events);
+
+/**
+ * Wait for the next mouse event and remove it from the queue. Wakes as soon
+ * as an event arrives or the script is interrupted.
+ *
+ * @param timeout_ms Maximum wait, negative to wait indefinitely
+ * @return true if an event was received, false on timeout or interruption
+ */
+bool mouse_wait_event(MouseEventInfo* event, int timeout_ms);
+
+/**
+ * Get the mouse position in sprite coordinates (1024x768 screen space).
+ */
+void mouse_get_sprite_position(float* x, float* y);
+
+/**
+ * Check if mouse cursor is over a sprite. Transparent texels do not count.
  *
  * @param sprite_id Sprite ID to check collision with
  * @return true if mouse is over the sprite, false otherwise
  */
 bool sprite_mouse_over(uint16_t sprite_id);
 
+/**
+ * Get the topmost sprite under the mouse cursor, ignoring transparent texels.
+ *
+ * @return Sprite ID, or 0 if none
+ */
+uint16_t sprite_mouse_pick(void);
+
 /**
  * Convert screen coordinates to text grid coordinates.
  *
@@ -1766,6 +1982,94 @@ void overlay_hide(void);
  */
 bool overlay_is_visible(void);
 
+// MARK: - Overlay Widgets (retained)
+
+/**
+ * Create a filled panel widget on the overlay. Widgets are retained: they
+ * stay on screen until removed, and only the parts that change are redrawn.
+ * Positions are relative to the parent widget.
+ *
+ * @param parent Parent widget ID, or 0 for the top level
+ * @param x X position relative to the parent
+ * @param y Y position relative to the parent
+ * @param w Width
+ * @param h Height
+ * @return Widget ID, or 0 if the parent does not exist
+ */
+uint32_t overlay_widget_panel(uint32_t parent, float x, float y, float w, float h);
+
+/**
+ * Create a text label widget. Text is clipped to the label's box.
+ *
+ * @param parent Parent widget ID, or 0 for the top level
+ * @param x X position relative to the parent
+ * @param y Y position relative to the parent
+ * @param w Width of the label box
+ * @param h Height of the label box
+ * @param text Text to show
+ * @param fontSize Font size
+ * @return Widget ID, or 0 on error
+ */
+uint32_t overlay_widget_label(uint32_t parent, float x, float y, float w, float h, const char* text, float fontSize);
+
+/**
+ * Create a progress/health bar widget. The widget color fills the bar,
+ * the back color draws the track.
+ *
+ * @param parent Parent widget ID, or 0 for the top level
+ * @param value Fill fraction (0.0-1.0)
+ * @return Widget ID, or 0 on error
+ */
+uint32_t overlay_widget_bar(uint32_t parent, float x, float y, float w, float h, float value);
+
+/**
+ * Create an image widget showing an overlay image scaled to its box.
+ *
+ * @param parent Parent widget ID, or 0 for the top level
+ * @param imageId Overlay image ID
+ * @return Widget ID, or 0 on error
+ */
+uint32_t overlay_widget_image(uint32_t parent, float x, float y, float w, float h, uint16_t imageId);
+
+/**
+ * Remove a widget and all of its children.
+ *
+ * @param id Widget ID
+ * @return true if the widget existed
+ */
+bool overlay_widget_remove(uint32_t id);
+
+/**
+ * Remove all widgets.
+ */
+void overlay_widget_clear(void);
+
+/**
+ * Widget property setters. Each returns false for an unknown ID; setting a
+ * value the widget already has does not cause a redraw.
+ */
+bool overlay_widget_set_position(uint32_t id, float x, float y);
+bool overlay_widget_set_size(uint32_t id, float w, float h);
+bool overlay_widget_set_visible(uint32_t id, bool visible);
+bool overlay_widget_set_z(uint32_t id, int z);
+bool overlay_widget_set_color(uint32_t id, float r, float g, float b, float a);
+bool overlay_widget_set_back_color(uint32_t id, float r, float g, float b, float a);
+bool overlay_widget_set_border(uint32_t id, float width);
+bool overlay_widget_set_text(uint32_t id, const char* text);
+bool overlay_widget_set_font_size(uint32_t id, float fontSize);
+bool overlay_widget_set_value(uint32_t id, float value);
+bool overlay_widget_set_vertical(uint32_t id, bool vertical);
+bool overlay_widget_set_image(uint32_t id, uint16_t imageId);
+
+/**
+ * Redraw a widget whose content changed outside the widget system,
+ * such as an image widget after its image was reloaded.
+ *
+ * @param id Widget ID
+ * @return true if the widget exists
+ */
+bool overlay_widget_invalidate(uint32_t id);
+
 // MARK: - Audio Functions
 
 /**
@@ -2066,6 +2370,41 @@ void music_shutdown(void);
  */
 const char* music_get_test_song(const char* song_name);
 
+// MARK: - Trace Capture
+
+/**
+ * Start recording trace events from the audio, MIDI and Lua threads.
+ * Recording keeps the most recent events per thread; it has no effect in
+ * builds made with SUPERTERMINAL_TRACING=0.
+ */
+void trace_start(void);
+
+/**
+ * Stop recording trace events. Events recorded so far are kept for dumping.
+ */
+void trace_stop(void);
+
+/**
+ * Check whether trace events are being recorded.
+ *
+ * @return true while recording
+ */
+bool trace_is_active(void);
+
+/**
+ * Discard all recorded trace events.
+ */
+void trace_clear(void);
+
+/**
+ * Write the recorded events as Chrome trace-event JSON, viewable in
+ * chrome://tracing or Perfetto. Can be called while recording.
+ *
+ * @param path Output file path
+ * @return true if the file was written
+ */
+bool trace_dump(const char* path);
+
 // MARK: - System Reset Functions
 
 /**
@@ -2083,6 +2422,18 @@ void superterminal_reset_all(void);
  */
 void superterminal_reset_quick(void);
 
+/**
+ * Generation-based soft reset for fast script re-runs (used by Run Script).
+ * Stops audio and releases only what the previous run created or changed:
+ * its sprites, and the tile layers, graphics layers and terminal text it
+ * wrote to. Metal pipelines, glyph atlases, loaded tiles, the audio engine,
+ * sound cache and the editor buffer are kept. The running GCD script is
+ * stopped and the next run starts from a Lua state prepared while the queue
+ * was idle. Textures the previous run loaded from files are reused if the
+ * next run loads them again.
+ */
+void superterminal_reset_soft(void);
+
 /**
  * Reset audio subsystems and Lua state.
  * Stops music, shuts down audio/synth engines, reinitializes them,
@@ -2118,6 +2469,29 @@ bool superterminal_is_reset_in_progress(void);
  */
 int superterminal_get_reset_count(void);
 
+/**
+ * Get the current script generation.
+ * Incremented by every full or soft reset; resources are tagged with the
+ * generation that created them.
+ *
+ * @return Current script generation (starts at 1)
+ */
+uint32_t superterminal_get_script_generation(void);
+
+/**
+ * Get the wall-clock duration of the most recent full or soft reset.
+ *
+ * @return Reset latency in milliseconds, or 0 if no reset has run
+ */
+double superterminal_get_last_reset_ms(void);
+
+/**
+ * Get the mean latency of all full and soft resets since startup.
+ *
+ * @return Average reset latency in milliseconds, or 0 if no reset has run
+ */
+double superterminal_get_average_reset_ms(void);
+
 /**
  * Set external run script callback function.
  * This allows applications to register a custom callback for the Run Script menu.
@@ -0,0 +1,309 @@
+//
+//  test_abc_seek.cpp
+//  SuperTerminal Framework - ABC Seek Index Test
+//
+//  Headless checks for ABC playback seeking: the chased program, controller,
+//  pitch-bend, tempo and held-note state at any seek point must match
+//  playing the merged event stream from the start, and a jump must replay
+//  no more than one checkpoint interval
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "src/audio/abc/ABCSeekIndex.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <tuple>
+#include <vector>
+
+using ABCPlayer::ChaseState;
+using ABCPlayer::MIDIEvent;
+using ABCPlayer::MIDIEventType;
+using ABCPlayer::MIDITrack;
+using ABCPlayer::SeekIndex;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cout << "ERROR: " << #cond << " (line " << __LINE__ << ")" << std::endl; \
+            return false; \
+        } \
+    } while (0)
+
+static const double SECONDS_PER_BEAT = 2.0;    // Q:1/4=120, timestamps in whole notes
+
+static MIDIEvent makeTempo(double time, uint32_t microsPerQuarter) {
+    MIDIEvent event(MIDIEventType::META_TEMPO, time);
+    event.meta_data = {uint8_t(microsPerQuarter >> 16), uint8_t(microsPerQuarter >> 8), uint8_t(microsPerQuarter)};
+    return event;
+}
+
+// Tracks shaped like MIDIGenerator output: a tempo track, then one track
+// per voice with a program change, controllers and overlapping notes on a
+// sixteenth-note grid (so many events share a timestamp)
+static std::vector<MIDITrack> makeTune(int voices, int notesPerVoice, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<MIDITrack> tracks;
+
+    MIDITrack tempo(0);
+    tempo.events.push_back(makeTempo(0.0, 500000));
+    for (int i = 1; i < notesPerVoice / 64; i++) {
+        tempo.events.push_back(makeTempo(i * 4.0, 400000 + (rng() % 200000)));
+    }
+    tracks.push_back(tempo);
+
+    for (int v = 0; v < voices; v++) {
+        MIDITrack track(v + 1);
+        int channel = v % 16;
+        track.channel = channel;
+        track.events.emplace_back(MIDIEventType::PROGRAM_CHANGE, 0.0, channel, v * 7 % 128);
+        track.events.emplace_back(MIDIEventType::CONTROL_CHANGE, 0.0, channel, 7, 100);
+
+        double time = 0.0;
+        for (int n = 0; n < notesPerVoice; n++) {
+            int note = 40 + (rng() % 48);
+            double length = 0.0625 * (1 + rng() % 8);
+            track.events.emplace_back(MIDIEventType::NOTE_ON, time, channel, note, 40 + (rng() % 80));
+            track.events.emplace_back(MIDIEventType::NOTE_OFF, time + length, channel, note, 0);
+
+            switch (rng() % 16) {
+                case 0: track.events.emplace_back(MIDIEventType::PROGRAM_CHANGE, time, channel, rng() % 128); break;
+                case 1: track.events.emplace_back(MIDIEventType::CONTROL_CHANGE, time, channel, 10, rng() % 128); break;
+                case 2: track.events.emplace_back(MIDIEventType::CONTROL_CHANGE, time, channel, 64, (rng() % 2) * 127); break;
+                case 3: track.events.emplace_back(MIDIEventType::PITCH_BEND, time, channel, rng() % 128, rng() % 128); break;
+                default: break;
+            }
+            time += 0.0625 * (1 + rng() % 4);
+        }
+        track.events.emplace_back(MIDIEventType::META_END_OF_TRACK, time + 1.0);
+
+        // Generator output is ordered per track
+        std::stable_sort(track.events.begin(), track.events.end(),
+                         [](const MIDIEvent& a, const MIDIEvent& b) { return a.timestamp < b.timestamp; });
+        tracks.push_back(track);
+    }
+    return tracks;
+}
+
+// Reference: merge by (time, track, event) and play from the start
+static void playFromStart(const std::vector<MIDITrack>& tracks, double position, ChaseState& state, size_t& played) {
+    std::vector<std::tuple<double, size_t, size_t>> order;
+    for (size_t t = 0; t < tracks.size(); t++) {
+        for (size_t e = 0; e < tracks[t].events.size(); e++) {
+            order.emplace_back(tracks[t].events[e].timestamp * SECONDS_PER_BEAT, t, e);
+        }
+    }
+    std::sort(order.begin(), order.end());
+
+    state.reset();
+    played = 0;
+    for (const auto& entry : order) {
+        if (std::get<0>(entry) >= position) break;
+        state.apply(tracks[std::get<1>(entry)].events[std::get<2>(entry)]);
+        played++;
+    }
+}
+
+bool testChaseState() {
+    std::cout << "Testing chase state..." << std::endl;
+
+    ChaseState state;
+    CHECK(state.program[0] == -1 && state.controller[3][7] == -1 && state.pitch_bend[0] == -1);
+    CHECK(state.tempo_mpq == 0 && state.held_notes.empty());
+
+    state.apply(MIDIEvent(MIDIEventType::PROGRAM_CHANGE, 0.0, 2, 41));
+    state.apply(MIDIEvent(MIDIEventType::CONTROL_CHANGE, 0.0, 2, 7, 90));
+    state.apply(MIDIEvent(MIDIEventType::PITCH_BEND, 0.0, 2, 0x10, 0x40));
+    state.apply(makeTempo(0.0, 600000));
+    state.apply(MIDIEvent(MIDIEventType::NOTE_ON, 0.0, 2, 64, 100));
+    state.apply(MIDIEvent(MIDIEventType::NOTE_ON, 0.0, 0, 60, 80));
+    state.apply(MIDIEvent(MIDIEventType::NOTE_ON, 0.0, 2, 60, 70));
+    CHECK(state.program[2] == 41);
+    CHECK(state.controller[2][7] == 90);
+    CHECK(state.pitch_bend[2] == (0x10 | (0x40 << 7)));
+    CHECK(state.tempo_mpq == 600000);
+    CHECK(state.held_notes.size() == 3);
+    CHECK(std::is_sorted(state.held_notes.begin(), state.held_notes.end()));
+
+    // Note-on with velocity 0 and note-off both release
+    state.apply(MIDIEvent(MIDIEventType::NOTE_ON, 0.0, 2, 64, 0));
+    state.apply(MIDIEvent(MIDIEventType::NOTE_OFF, 0.0, 0, 60, 0));
+    CHECK(state.held_notes.size() == 1);
+    CHECK(state.held_notes[0].first == ((2 << 7) | 60) && state.held_notes[0].second == 70);
+
+    // Releasing a note that is not held is harmless
+    state.apply(MIDIEvent(MIDIEventType::NOTE_OFF, 0.0, 5, 10, 0));
+    CHECK(state.held_notes.size() == 1);
+
+    ChaseState copy = state;
+    CHECK(copy == state);
+    copy.apply(MIDIEvent(MIDIEventType::CONTROL_CHANGE, 0.0, 2, 7, 91));
+    CHECK(copy != state);
+
+    std::cout << "✅ chase state passed!" << std::endl;
+    return true;
+}
+
+bool testSeekBoundaries() {
+    std::cout << "Testing seek boundaries..." << std::endl;
+
+    // A single held note from 1s to 2s
+    std::vector<MIDITrack> tracks(1);
+    tracks[0].events.emplace_back(MIDIEventType::PROGRAM_CHANGE, 0.0, 0, 19);
+    tracks[0].events.emplace_back(MIDIEventType::NOTE_ON, 0.5, 0, 60, 90);
+    tracks[0].events.emplace_back(MIDIEventType::NOTE_OFF, 1.0, 0, 60, 0);
+
+    SeekIndex index;
+    index.build(tracks, SECONDS_PER_BEAT);
+    CHECK(index.getEvents().size() == 3);
+    CHECK(index.getCheckpointCount() == 1);
+
+    ChaseState state;
+    CHECK(index.seek(0.0, state) == 0);                 // Nothing before the start
+    CHECK(state.program[0] == -1 && state.held_notes.empty());
+
+    CHECK(index.seek(1.0, state) == 1);                 // Note-on at 1s is still to play
+    CHECK(state.program[0] == 19 && state.held_notes.empty());
+
+    CHECK(index.seek(1.5, state) == 2);                 // Inside the note: chase it
+    CHECK(state.held_notes.size() == 1 && state.held_notes[0].second == 90);
+
+    CHECK(index.seek(2.0, state) == 2);                 // Note-off at 2s is still to play
+    CHECK(state.held_notes.size() == 1);
+
+    CHECK(index.seek(2.5, state) == 3);                 // Past the end
+    CHECK(state.held_notes.empty() && state.program[0] == 19);
+
+    CHECK(index.seek(-1.0, state) == 0);
+
+    // Empty tune
+    SeekIndex empty;
+    empty.build(std::vector<MIDITrack>(), SECONDS_PER_BEAT);
+    size_t replayed = 99;
+    CHECK(empty.seek(3.0, state, &replayed) == 0);
+    CHECK(replayed == 0 && state == ChaseState());
+
+    std::cout << "✅ seek boundaries passed!" << std::endl;
+    return true;
+}
+
+bool testMergeOrder() {
+    std::cout << "Testing merge order..." << std::endl;
+
+    // Same timestamp across tracks: track order, then event order
+    std::vector<MIDITrack> tracks(3);
+    tracks[0].events.emplace_back(MIDIEventType::CONTROL_CHANGE, 0.25, 0, 1, 10);
+    tracks[1].events.emplace_back(MIDIEventType::CONTROL_CHANGE, 0.25, 0, 1, 20);
+    tracks[1].events.emplace_back(MIDIEventType::CONTROL_CHANGE, 0.25, 0, 1, 30);
+    tracks[2].events.emplace_back(MIDIEventType::CONTROL_CHANGE, 0.125, 0, 1, 5);
+
+    SeekIndex index;
+    index.build(tracks, SECONDS_PER_BEAT);
+    const auto& events = index.getEvents();
+    CHECK(events.size() == 4);
+    CHECK(events[0].event->data2 == 5 && events[0].seconds == 0.25);
+    CHECK(events[1].event->data2 == 10);
+    CHECK(events[2].event->data2 == 20);
+    CHECK(events[3].event->data2 == 30);
+    CHECK(index.findEvent(0.5) == 1);
+    CHECK(index.findEvent(0.5000001) == 4);
+
+    ChaseState state;
+    index.seek(1.0, state);
+    CHECK(state.controller[0][1] == 30);
+
+    std::cout << "✅ merge order passed!" << std::endl;
+    return true;
+}
+
+bool testSeekMatchesPlayback() {
+    std::cout << "Testing seek matches playback from the start..." << std::endl;
+
+    std::vector<MIDITrack> tracks = makeTune(6, 600, 1234);
+
+    for (size_t interval : {size_t(1), size_t(7), size_t(64), SeekIndex::DEFAULT_CHECKPOINT_INTERVAL, size_t(1u << 20)}) {
+        SeekIndex index;
+        index.build(tracks, SECONDS_PER_BEAT, interval);
+        const auto& events = index.getEvents();
+        double end = events.back().seconds;
+        CHECK(index.getCheckpointCount() == events.size() / interval + 1);
+
+        // Random points, every event time and the points just either side of it
+        std::vector<double> positions = {0.0, end, end + 1.0};
+        std::mt19937 rng(static_cast<uint32_t>(interval));
+        std::uniform_real_distribution<double> pick(0.0, end);
+        for (int i = 0; i < 300; i++) positions.push_back(pick(rng));
+        for (size_t i = 0; i < events.size(); i += 37) {
+            positions.push_back(events[i].seconds);
+            positions.push_back(events[i].seconds + 1e-9);
+        }
+
+        for (double position : positions) {
+            ChaseState expected;
+            size_t played;
+            playFromStart(tracks, position, expected, played);
+
+            ChaseState state;
+            size_t replayed;
+            size_t next = index.seek(position, state, &replayed);
+            CHECK(next == played);
+            CHECK(state == expected);
+            CHECK(replayed < interval);
+        }
+    }
+
+    std::cout << "✅ seek matches playback passed!" << std::endl;
+    return true;
+}
+
+bool testSeekBenchmark() {
+    std::cout << "Testing seek cost on a long tune..." << std::endl;
+
+    std::vector<MIDITrack> tracks = makeTune(16, 8000, 99);
+
+    auto start = std::chrono::steady_clock::now();
+    SeekIndex index;
+    index.build(tracks, SECONDS_PER_BEAT);
+    auto built = std::chrono::steady_clock::now();
+
+    const size_t seeks = 20000;
+    double end = index.getEvents().back().seconds;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> pick(0.0, end);
+    size_t maxReplayed = 0;
+    size_t checksum = 0;
+    ChaseState state;
+    for (size_t i = 0; i < seeks; i++) {
+        size_t replayed;
+        checksum += index.seek(pick(rng), state, &replayed);
+        maxReplayed = std::max(maxReplayed, replayed);
+    }
+    auto done = std::chrono::steady_clock::now();
+
+    double buildMs = std::chrono::duration<double, std::milli>(built - start).count();
+    double seekUs = std::chrono::duration<double, std::micro>(done - built).count() / seeks;
+    std::cout << "  " << index.getEvents().size() << " events, " << index.getCheckpointCount()
+              << " checkpoints: build " << buildMs << " ms, " << seekUs << " us per seek, max replay "
+              << maxReplayed << " events" << std::endl;
+    CHECK(checksum > 0);
+    CHECK(maxReplayed < SeekIndex::DEFAULT_CHECKPOINT_INTERVAL);
+
+    std::cout << "✅ seek benchmark passed!" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "SuperTerminal ABC Seek Index Test" << std::endl;
+    std::cout << "=================================" << std::endl;
+
+    bool success = true;
+    success = testChaseState() && success;
+    success = testSeekBoundaries() && success;
+    success = testMergeOrder() && success;
+    success = testSeekMatchesPlayback() && success;
+    success = testSeekBenchmark() && success;
+
+    std::cout << (success ? "All ABC seek tests passed" : "ABC seek tests FAILED") << std::endl;
+    return success ? 0 : 1;
+}
@@ -0,0 +1,239 @@
+//
+//  test_asset_batch.cpp
+//  SuperTerminal Framework - Asset Batch Operations Test
+//
+//  Headless checks for the batch asset database calls behind asset_save_sounds,
+//  asset_load_sounds and asset_get_sound_infos: results come back parallel to
+//  the names asked for, missing names get id 0, and a batch add is all or
+//  nothing (a duplicate, an invalid entry or an outer rollback leaves no
+//  partial batch). The throughput test compares per-item and batch insert and
+//  fetch against an on-disk database.
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "src/assets/AssetDatabase.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace SuperTerminal;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cout << "ERROR: " << #cond << " (line " << __LINE__ << ")" << std::endl; \
+            return false; \
+        } \
+    } while (0)
+
+// Level-sized batch of small sound effects
+static const int BENCH_ASSETS = 200;
+static const size_t BENCH_ASSET_BYTES = 4096;
+
+static AssetMetadata makeSound(const std::string& name, size_t bytes = 64) {
+    AssetMetadata metadata;
+    metadata.name = name;
+    metadata.kind = AssetKind::SOUND;
+    metadata.format = AssetFormat::WAV;
+    metadata.description = "sound " + name;
+    metadata.data.resize(bytes);
+    for (size_t i = 0; i < bytes; i++) {
+        metadata.data[i] = (uint8_t)(i * 31 + name.size());
+    }
+    return metadata;
+}
+
+// Fresh on-disk database in its own temporary directory
+struct TempDatabase {
+    std::string dir;
+    std::string path;
+    AssetDatabase db;
+
+    bool open() {
+        char dirTemplate[] = "/tmp/st_assets_XXXXXX";
+        if (!mkdtemp(dirTemplate)) {
+            return false;
+        }
+        dir = dirTemplate;
+        path = dir + "/assets.db";
+        return db.open(path) && db.createSchema();
+    }
+
+    ~TempDatabase() {
+        db.close();
+        remove(path.c_str());
+        remove((path + "-journal").c_str());
+        rmdir(dir.c_str());
+    }
+};
+
+bool testAddAndGetBatch() {
+    std::cout << "Testing batch add and get..." << std::endl;
+
+    TempDatabase temp;
+    CHECK(temp.open());
+
+    auto added = temp.db.addAssets({makeSound("jump"), makeSound("coin", 100), makeSound("hit")});
+    CHECK(added);
+    CHECK(added.value.size() == 3);
+    CHECK(added.value[0] < added.value[1] && added.value[1] < added.value[2]);
+    CHECK(temp.db.getAssetCount() == 3);
+
+    auto single = temp.db.getAssetByName("coin");
+    CHECK(single);
+    CHECK(single.value.id == added.value[1]);
+    CHECK(single.value.data == makeSound("coin", 100).data);
+
+    // Parallel to the names asked for, including repeats and misses
+    auto fetched = temp.db.getAssetsByName({"hit", "missing", "jump", "hit"});
+    CHECK(fetched);
+    CHECK(fetched.value.size() == 4);
+    CHECK(fetched.value[0].name == "hit" && fetched.value[0].id == added.value[2]);
+    CHECK(fetched.value[1].id == 0 && fetched.value[1].name.empty());
+    CHECK(fetched.value[2].name == "jump" && fetched.value[2].description == "sound jump");
+    CHECK(fetched.value[2].data == makeSound("jump").data);
+    CHECK(fetched.value[2].kind == AssetKind::SOUND);
+    CHECK(fetched.value[3].id == fetched.value[0].id);
+
+    auto none = temp.db.getAssetsByName({});
+    CHECK(none);
+    CHECK(none.value.empty());
+    auto nothingAdded = temp.db.addAssets({});
+    CHECK(nothingAdded);
+    CHECK(nothingAdded.value.empty());
+
+    std::cout << "✅ Batch add and get test passed!" << std::endl;
+    return true;
+}
+
+bool testAddBatchIsAtomic() {
+    std::cout << "Testing batch add rollback..." << std::endl;
+
+    TempDatabase temp;
+    CHECK(temp.open());
+    CHECK(temp.db.addAsset(makeSound("existing")));
+
+    // A name already in the database fails the whole batch
+    auto clash = temp.db.addAssets({makeSound("a"), makeSound("existing"), makeSound("b")});
+    CHECK(!clash);
+    CHECK(clash.error == AssetDatabaseError::ALREADY_EXISTS);
+    CHECK(clash.errorMessage.find("existing") != std::string::npos);
+    CHECK(!temp.db.hasAsset("a"));
+    CHECK(!temp.db.hasAsset("b"));
+
+    // So does a name repeated within the batch
+    auto repeated = temp.db.addAssets({makeSound("c"), makeSound("c")});
+    CHECK(!repeated);
+    CHECK(repeated.error == AssetDatabaseError::ALREADY_EXISTS);
+    CHECK(!temp.db.hasAsset("c"));
+
+    // Invalid entries are rejected before anything is written
+    AssetMetadata unnamed = makeSound("");
+    auto invalid = temp.db.addAssets({makeSound("d"), unnamed});
+    CHECK(!invalid);
+    CHECK(invalid.error == AssetDatabaseError::INVALID_DATA);
+    CHECK(!temp.db.hasAsset("d"));
+    CHECK(temp.db.getAssetCount() == 1);
+
+    // Inside a caller's transaction the batch commits or rolls back with it
+    {
+        AssetDatabase::Transaction transaction(temp.db);
+        CHECK(temp.db.addAssets({makeSound("e"), makeSound("f")}));
+        CHECK(temp.db.hasAsset("e"));
+        transaction.rollback();
+    }
+    CHECK(!temp.db.hasAsset("e"));
+    {
+        AssetDatabase::Transaction transaction(temp.db);
+        CHECK(temp.db.addAssets({makeSound("g")}));
+        CHECK(!temp.db.addAssets({makeSound("h"), makeSound("g")}));
+        transaction.commit();
+    }
+    CHECK(temp.db.hasAsset("g"));
+    CHECK(!temp.db.hasAsset("h"));
+    CHECK(temp.db.getAssetCount() == 2);
+
+    std::cout << "✅ Batch add rollback test passed!" << std::endl;
+    return true;
+}
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool testBatchThroughput() {
+    std::cout << "Testing per-item vs batch throughput..." << std::endl;
+
+    std::vector<AssetMetadata> assets;
+    std::vector<std::string> names;
+    for (int i = 0; i < BENCH_ASSETS; i++) {
+        std::string name = "sfx_" + std::to_string(i);
+        assets.push_back(makeSound(name, BENCH_ASSET_BYTES));
+        names.push_back(name);
+    }
+
+    TempDatabase perItem;
+    TempDatabase batch;
+    CHECK(perItem.open());
+    CHECK(batch.open());
+
+    // Insert: one implicit transaction per asset vs one for the batch
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& metadata : assets) {
+        CHECK(perItem.db.addAsset(metadata));
+    }
+    double perItemInsert = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    CHECK(batch.db.addAssets(assets));
+    double batchInsert = secondsSince(start);
+
+    // Fetch: best of several passes, since reads come from the page cache
+    const int passes = 5;
+    double perItemFetch = 1e9;
+    double batchFetch = 1e9;
+    for (int pass = 0; pass < passes; pass++) {
+        start = std::chrono::steady_clock::now();
+        for (const auto& name : names) {
+            auto result = batch.db.getAssetByName(name);
+            CHECK(result && result.value.data.size() == BENCH_ASSET_BYTES);
+        }
+        perItemFetch = std::min(perItemFetch, secondsSince(start));
+
+        start = std::chrono::steady_clock::now();
+        auto result = batch.db.getAssetsByName(names);
+        CHECK(result && result.value.size() == names.size());
+        CHECK(result.value.back().data.size() == BENCH_ASSET_BYTES);
+        batchFetch = std::min(batchFetch, secondsSince(start));
+    }
+
+    std::cout << "  " << BENCH_ASSETS << " assets of " << BENCH_ASSET_BYTES << " bytes" << std::endl;
+    std::cout << "  Insert: per-item " << perItemInsert * 1000.0 << " ms, batch " << batchInsert * 1000.0
+              << " ms (" << perItemInsert / batchInsert << "x)" << std::endl;
+    std::cout << "  Fetch:  per-item " << perItemFetch * 1000.0 << " ms, batch " << batchFetch * 1000.0
+              << " ms (" << perItemFetch / batchFetch << "x)" << std::endl;
+    CHECK(perItem.db.getAssetCount() == batch.db.getAssetCount());
+    CHECK(batchInsert < perItemInsert);
+    CHECK(batchFetch < perItemFetch);
+
+    std::cout << "✅ Throughput test passed!" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "SuperTerminal Asset Batch Test" << std::endl;
+    std::cout << "==============================" << std::endl;
+
+    bool success = true;
+    success = testAddAndGetBatch() && success;
+    success = testAddBatchIsAtomic() && success;
+    success = testBatchThroughput() && success;
+
+    std::cout << (success ? "All asset batch tests passed" : "Asset batch tests FAILED") << std::endl;
+    return success ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+//
+//  test_audio_v2_performance.cpp
+//  SuperTerminal Framework - Audio v2 Performance Regression Test
+//
+//  Headless regression gate for the v2 graph: runs the PerformanceHarness
+//  workloads and fails if ns/sample or allocations per block leave the
+//  tolerance bands in tests/cpp/baselines/audio_v2_performance.txt, if node
+//  lifecycles leak, or if concurrent parameter changes on live nodes produce
+//  non-finite output.
+//
+//  Usage:
+//    test_audio_v2_performance [--baseline file] [--stress seconds]
+//    test_audio_v2_performance --update-baseline file
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "src/audio/v2/tests/PerformanceHarness.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#ifndef AUDIO_V2_PERFORMANCE_BASELINE
+#define AUDIO_V2_PERFORMANCE_BASELINE "tests/cpp/baselines/audio_v2_performance.txt"
+#endif
+
+// SynthEngine registers generated sounds with the legacy audio system; the
+// harness renders them through SynthNode voices instead
+extern "C" uint32_t audio_load_sound_from_buffer(const float* samples, size_t sampleCount,
+                                                 uint32_t sampleRate, uint32_t channels) {
+    (void)samples; (void)sampleCount; (void)sampleRate; (void)channels;
+    static uint32_t nextId = 1000;
+    return nextId++;
+}
+
+extern "C" void audio_unload_sound(uint32_t sound_id) {
+    (void)sound_id;
+}
+
+static bool testBaselineRegression(const std::string& baselinePath) {
+    std::cout << "Testing workloads against " << baselinePath << "..." << std::endl;
+
+    std::map<std::string, PerfBaselineEntry> baseline;
+    std::string error;
+    if (!PerformanceHarness::loadBaseline(baselinePath, baseline, error)) {
+        std::cout << "ERROR: " << error << std::endl;
+        return false;
+    }
+
+    PerformanceHarness harness;
+    std::vector<PerfMeasurement> measurements = harness.runWorkloads();
+    if (!PerformanceHarness::compareToBaseline(measurements, baseline, std::cout)) {
+        std::cout << "ERROR: performance regression against baseline" << std::endl;
+        return false;
+    }
+
+    std::cout << "✅ Baseline regression test passed!" << std::endl;
+    return true;
+}
+
+static bool testLifecycleLeaks() {
+    std::cout << "Testing node lifecycles for leaked allocations..." << std::endl;
+
+    PerformanceHarness harness;
+    int64_t drift = harness.measureLiveAllocationDrift(10);
+    std::cout << "  live allocation drift over 10 cycles: " << drift << std::endl;
+    if (drift != 0) {
+        std::cout << "ERROR: node create/render/destroy cycles leak" << std::endl;
+        return false;
+    }
+
+    std::cout << "✅ Lifecycle leak test passed!" << std::endl;
+    return true;
+}
+
+static bool testParameterStress(double seconds) {
+    std::cout << "Testing concurrent parameter changes for " << seconds << "s..." << std::endl;
+
+    PerformanceHarness harness;
+    PerfStressResult result = harness.runParameterStress(seconds, 3);
+    std::cout << "  " << result.blocksRendered << " blocks, " << result.parameterChanges
+              << " parameter changes, worst block " << result.worstBlockUs << " us" << std::endl;
+    if (!result.passed) {
+        std::cout << "ERROR: stress run failed (" << result.nonFiniteSamples << " non-finite samples)" << std::endl;
+        return false;
+    }
+
+    std::cout << "✅ Parameter stress test passed!" << std::endl;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::string baselinePath = AUDIO_V2_PERFORMANCE_BASELINE;
+    double stressSeconds = 2.0;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--stress") == 0 && i + 1 < argc) {
+            stressSeconds = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--update-baseline") == 0 && i + 1 < argc) {
+            std::string path = argv[++i];
+            std::map<std::string, PerfBaselineEntry> previous;
+            std::string error;
+            PerformanceHarness::loadBaseline(path, previous, error);
+
+            PerformanceHarness harness;
+            std::vector<PerfMeasurement> measurements = harness.runWorkloads();
+            if (!PerformanceHarness::writeBaseline(path, measurements, previous)) {
+                std::cout << "ERROR: cannot write " << path << std::endl;
+                return 1;
+            }
+            std::cout << "Wrote " << measurements.size() << " workloads to " << path << std::endl;
+            return 0;
+        } else {
+            std::cout << "Usage: " << argv[0] << " [--baseline file] [--stress seconds] [--update-baseline file]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "SuperTerminal Audio v2 Performance Regression Test" << std::endl;
+    std::cout << "==================================================" << std::endl;
+
+    bool success = true;
+    success = testBaselineRegression(baselinePath) && success;
+    success = testLifecycleLeaks() && success;
+    success = testParameterStress(stressSeconds) && success;
+
+    std::cout << (success ? "All audio v2 performance tests passed" : "Audio v2 performance tests FAILED") << std::endl;
+    return success ? 0 : 1;
+}
@@ -0,0 +1,329 @@
+//
+//  test_bullet_pattern.cpp
+//  SuperTerminal Framework - Bullet Pattern Emitter Test
+//
+//  Headless checks for BulletPatternField: ring, spiral, fan and aimed
+//  geometry, rotation and speed ramps, step-rate independent volley timing,
+//  seeded determinism, culling and hit tests, plus spawn throughput and
+//  steady-state update cost at 10k live bullets
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "src/BulletPattern.h"
+#include "src/FixedTimestep.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cout << "ERROR: " << #cond << " (line " << __LINE__ << ")" << std::endl; \
+            return false; \
+        } \
+    } while (0)
+
+static const float PI = 3.14159265359f;
+
+static bool near(float a, float b, float epsilon = 1e-3f) {
+    return std::fabs(a - b) < epsilon;
+}
+
+static float headingOf(const PatternBullet& bullet) {
+    return std::atan2(bullet.dirY, bullet.dirX);
+}
+
+static bool sameAngle(float a, float b) {
+    float d = std::fmod(std::fabs(a - b), 2.0f * PI);
+    return d < 1e-3f || d > 2.0f * PI - 1e-3f;
+}
+
+static uint64_t hashBullets(const std::vector<PatternBullet>& bullets) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (const PatternBullet& bullet : bullets) {
+        float fields[4] = {bullet.x, bullet.y, bullet.dirX, bullet.dirY};
+        unsigned char bytes[sizeof(fields)];
+        std::memcpy(bytes, fields, sizeof(fields));
+        for (unsigned char b : bytes) {
+            hash = (hash ^ b) * 0x100000001B3ull;
+        }
+    }
+    return hash;
+}
+
+bool testRingAndSpiral() {
+    std::cout << "Testing ring and spiral volleys..." << std::endl;
+
+    SimulationRandom random(1);
+    BulletPatternField field(random);
+
+    BulletPatternDesc ring;
+    ring.shape = BulletPatternShape::Ring;
+    ring.count = 8;
+    ring.volleys = 1;
+    ring.speed = 100.0f;
+    field.createEmitter(ring, 500.0f, 400.0f);
+    CHECK(field.getEmitterCount() == 1);
+
+    field.update(0.1f);
+    CHECK(field.getBulletCount() == 8);
+    CHECK(field.getEmitterCount() == 0);     // Volley limit reached
+    for (int i = 0; i < 8; i++) {
+        const PatternBullet& bullet = field.getBullets()[i];
+        CHECK(sameAngle(headingOf(bullet), i * PI / 4.0f));
+        CHECK(near(std::hypot(bullet.x - 500.0f, bullet.y - 400.0f), 10.0f));
+    }
+
+    // Spiral: base angle turns between volleys and spawn speed ramps
+    field.clear();
+    BulletPatternDesc spiral;
+    spiral.shape = BulletPatternShape::Spiral;
+    spiral.count = 2;
+    spiral.interval = 0.1f;
+    spiral.volleys = 2;
+    spiral.rotationSpeed = 1.0f;
+    spiral.speed = 100.0f;
+    spiral.speedStep = 50.0f;
+    field.createEmitter(spiral, 500.0f, 400.0f);
+    field.update(0.05f);
+    field.update(0.05f);
+    CHECK(field.getBulletCount() == 4);
+    CHECK(sameAngle(headingOf(field.getBullets()[0]), 0.0f));
+    CHECK(sameAngle(headingOf(field.getBullets()[2]), 0.1f));
+    CHECK(sameAngle(headingOf(field.getBullets()[3]), 0.1f + PI));
+    CHECK(near(field.getBullets()[0].speed, 100.0f));
+    CHECK(near(field.getBullets()[2].speed, 150.0f));
+
+    std::cout << "✅ Ring and spiral test passed!" << std::endl;
+    return true;
+}
+
+bool testFanAndAimed() {
+    std::cout << "Testing fan and aimed volleys..." << std::endl;
+
+    SimulationRandom random(1);
+    BulletPatternField field(random);
+
+    BulletPatternDesc fan;
+    fan.shape = BulletPatternShape::Fan;
+    fan.count = 5;
+    fan.spread = 1.0f;
+    fan.angle = PI / 2.0f;
+    fan.volleys = 1;
+    field.createEmitter(fan, 100.0f, 100.0f);
+    field.update(1.0f / 60.0f);
+    CHECK(field.getBulletCount() == 5);
+    CHECK(sameAngle(headingOf(field.getBullets()[0]), PI / 2.0f - 0.5f));
+    CHECK(sameAngle(headingOf(field.getBullets()[2]), PI / 2.0f));
+    CHECK(sameAngle(headingOf(field.getBullets()[4]), PI / 2.0f + 0.5f));
+
+    // Aimed re-reads the target every volley
+    field.clear();
+    BulletPatternDesc aimed;
+    aimed.shape = BulletPatternShape::Aimed;
+    aimed.count = 1;
+    aimed.interval = 0.5f;
+    uint32_t emitter = field.createEmitter(aimed, 100.0f, 100.0f);
+    CHECK(field.setEmitterTarget(emitter, 100.0f, 300.0f));
+    field.update(0.1f);
+    CHECK(field.getBulletCount() == 1);
+    CHECK(sameAngle(headingOf(field.getBullets()[0]), PI / 2.0f));
+
+    CHECK(field.setEmitterTarget(emitter, 0.0f, 100.0f));
+    field.update(0.5f);
+    CHECK(field.getBulletCount() == 2);
+    CHECK(sameAngle(headingOf(field.getBullets()[1]), PI));
+
+    // Paused emitters hold their timer
+    CHECK(field.setEmitterPaused(emitter, true));
+    CHECK(!field.isEmitterActive(emitter));
+    field.update(6.0f);
+    CHECK(field.getBulletCount() == 0);      // Old bullets expired
+    CHECK(field.destroyEmitter(emitter));
+    CHECK(!field.setEmitterPosition(emitter, 0.0f, 0.0f));
+
+    std::cout << "✅ Fan and aimed test passed!" << std::endl;
+    return true;
+}
+
+bool testStepRateIndependence() {
+    std::cout << "Testing volley timing across step rates..." << std::endl;
+
+    auto run = [](int stepsPerSecond) {
+        SimulationRandom random(1);
+        BulletPatternField field(random);
+        field.setWorldBounds(100000.0f, 100000.0f);
+
+        BulletPatternDesc desc;
+        desc.shape = BulletPatternShape::Ring;
+        desc.count = 4;
+        desc.interval = 0.0125f;                 // Faster than a 60Hz step
+        desc.speed = 300.0f;
+        desc.lifetime = 10.0f;
+        field.createEmitter(desc, 50000.0f, 50000.0f);
+        for (int i = 0; i < stepsPerSecond; i++) {
+            field.update(1.0f / stepsPerSecond);
+        }
+        return field.getBullets();
+    };
+
+    std::vector<PatternBullet> at60 = run(60);
+    std::vector<PatternBullet> at240 = run(240);
+    CHECK(at60.size() == at240.size());
+    CHECK(at60.size() >= 4 * 80 && at60.size() <= 4 * 81);   // t = 0 .. 1s
+
+    // Same spawn times, so the same spacing along each arm
+    for (size_t i = 0; i < at60.size(); i++) {
+        CHECK(near(at60[i].x, at240[i].x, 0.05f));
+        CHECK(near(at60[i].y, at240[i].y, 0.05f));
+    }
+
+    std::cout << "✅ Step rate independence test passed!" << std::endl;
+    return true;
+}
+
+bool testDeterminism() {
+    std::cout << "Testing seeded determinism..." << std::endl;
+
+    auto run = [](uint64_t seed) {
+        FixedTimestepScheduler scheduler;
+        scheduler.reset(seed);
+        BulletPatternField field(scheduler.getRandom("bullet_patterns"));
+
+        BulletPatternDesc desc;
+        desc.shape = BulletPatternShape::Spiral;
+        desc.count = 6;
+        desc.interval = 0.03f;
+        desc.rotationSpeed = 2.0f;
+        desc.rotationAccel = 0.5f;
+        desc.jitter = 0.2f;
+        desc.acceleration = 40.0f;
+        desc.turnRate = 0.3f;
+        field.createEmitter(desc, 512.0f, 384.0f);
+
+        scheduler.registerStep("patterns", SIM_STEP_ORDER_BULLETS,
+                               [&field](float dt, uint64_t) { field.update(dt); });
+        for (int i = 0; i < 300; i++) scheduler.step();
+        return hashBullets(field.getBullets());
+    };
+
+    uint64_t a = run(7);
+    CHECK(a == run(7));
+    CHECK(a != run(8));
+
+    std::cout << "✅ Determinism test passed!" << std::endl;
+    return true;
+}
+
+bool testCullingAndHits() {
+    std::cout << "Testing culling, cap and hit tests..." << std::endl;
+
+    SimulationRandom random(1);
+    BulletPatternField field(random, 10);
+
+    BulletPatternDesc desc;
+    desc.count = 6;
+    desc.interval = 0.1f;
+    desc.speed = 0.0f;
+    desc.lifetime = 0.25f;
+    desc.owner = 3;
+    field.createEmitter(desc, 200.0f, 200.0f);
+
+    field.update(0.05f);
+    CHECK(field.getBulletCount() == 6);
+    field.update(0.1f);
+    CHECK(field.getBulletCount() == 10);     // Cap
+    CHECK(field.getStats().totalDropped == 2);
+
+    // Owner is ignored, others hit and are removed
+    CHECK(field.collideCircle(200.0f, 200.0f, 5.0f, 3, true) == 0);
+    CHECK(field.collideCircle(200.0f, 200.0f, 5.0f, 9, false) == 10);
+    CHECK(field.getBulletCount() == 10);
+    CHECK(field.collideCircle(200.0f, 200.0f, 5.0f, 9, true) == 10);
+    CHECK(field.getBulletCount() == 0);
+    CHECK(field.getStats().totalHits == 20);
+
+    // Lifetime expiry
+    field.update(0.1f);
+    CHECK(field.getBulletCount() == 6);
+    field.update(0.3f);
+    CHECK(field.getBulletCount() <= 10);
+    field.destroyEmitter(1);
+    field.update(0.3f);
+    CHECK(field.getBulletCount() == 0);
+
+    std::cout << "✅ Culling and hit test passed!" << std::endl;
+    return true;
+}
+
+bool testThroughput() {
+    std::cout << "Testing spawn throughput and 10k bullet update cost..." << std::endl;
+
+    SimulationRandom random(1);
+    BulletPatternField field(random, 20000);
+    field.setWorldBounds(1.0e6f, 1.0e6f);
+
+    // 16 spirals x 32 bullets every 20ms = 25.6k bullets/s
+    for (int i = 0; i < 16; i++) {
+        BulletPatternDesc desc;
+        desc.shape = BulletPatternShape::Spiral;
+        desc.count = 32;
+        desc.interval = 0.02f;
+        desc.rotationSpeed = 1.0f + i * 0.1f;
+        desc.speed = 120.0f;
+        desc.acceleration = 10.0f;
+        desc.turnRate = (i % 2) ? 0.2f : 0.0f;
+        desc.lifetime = 0.39f;
+        field.createEmitter(desc, 5.0e5f, 5.0e5f);
+    }
+
+    const float dt = 1.0f / 60.0f;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 60; i++) field.update(dt);
+    double spawnSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t spawned = field.getStats().totalSpawned;
+    CHECK(spawned > 20000);
+
+    // Steady state: 10k live bullets, no spawning
+    field.clear();
+    BulletPatternDesc fill;
+    fill.count = 10000;
+    fill.volleys = 1;
+    fill.speed = 50.0f;
+    fill.acceleration = 5.0f;
+    fill.lifetime = 1000.0f;
+    field.createEmitter(fill, 5.0e5f, 5.0e5f);
+    field.update(dt);
+    CHECK(field.getBulletCount() == 10000);
+
+    const int steps = 600;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < steps; i++) field.update(dt);
+    double updateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    CHECK(field.getBulletCount() == 10000);
+
+    std::cout << "  spawns: " << spawned << " in " << spawnSeconds * 1000.0 << " ms ("
+              << (uint64_t)(spawned / spawnSeconds) << " spawns/s of CPU time)" << std::endl;
+    std::cout << "  10k live bullets: " << (updateMs * 1000.0 / steps) << " us/step" << std::endl;
+
+    std::cout << "✅ Throughput test passed!" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "SuperTerminal Bullet Pattern Test" << std::endl;
+    std::cout << "=================================" << std::endl;
+
+    bool success = true;
+    success = testRingAndSpiral() && success;
+    success = testFanAndAimed() && success;
+    success = testStepRateIndependence() && success;
+    success = testDeterminism() && success;
+    success = testCullingAndHits() && success;
+    success = testThroughput() && success;
+
+    std::cout << (success ? "All bullet pattern tests passed" : "Bullet pattern tests FAILED") << std::endl;
+    return success ? 0 : 1;
+}
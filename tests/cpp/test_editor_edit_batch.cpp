@@ -0,0 +1,202 @@
+//
+//  test_editor_edit_batch.cpp
+//  SuperTerminal Framework - Editor Edit Batch Test
+//
+//  Checks batched edits against applying the same edits one at a time, the
+//  caret mapping used by multi-cursor typing, detection of batches that
+//  leave the text unchanged, and replace-all throughput
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "src/EditorEditBatch.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cout << "ERROR: " << #cond << " (line " << __LINE__ << ")" << std::endl; \
+            return false; \
+        } \
+    } while (0)
+
+static std::string joinLines(const std::vector<std::string>& lines) {
+    std::string text;
+    for (size_t i = 0; i < lines.size(); i++) {
+        if (i > 0) text += '\n';
+        text += lines[i];
+    }
+    return text;
+}
+
+static size_t offsetOf(const std::vector<std::string>& lines, EditorPosition p) {
+    size_t offset = 0;
+    for (int i = 0; i < p.line; i++) offset += lines[i].length() + 1;
+    return offset + p.column;
+}
+
+bool testMatchesSequentialEdits() {
+    std::cout << "Testing batch matches sequential edits..." << std::endl;
+
+    std::vector<std::string> lines = {"local a = 1", "print(a)", "", "return a"};
+    std::string text = joinLines(lines);
+
+    // Edits in arbitrary order, including multi-line replacements
+    std::vector<EditorEdit> edits = {
+        {{3, 0}, {3, 6}, "os.exit("},
+        {{0, 6}, {0, 7}, "alpha"},
+        {{1, 6}, {2, 0}, "alpha)\n-- gap\n"},
+        {{0, 0}, {0, 0}, "-- header\n"},
+    };
+
+    EditorEditBatch batch;
+    for (const auto& edit : edits) batch.replace(edit.start, edit.end, edit.text);
+
+    // Reference: apply back to front on the flat text
+    std::vector<EditorEdit> sorted = edits;
+    std::sort(sorted.begin(), sorted.end(), [](const EditorEdit& a, const EditorEdit& b) {
+        return b.start < a.start;
+    });
+    for (const auto& edit : sorted) {
+        size_t start = offsetOf(lines, edit.start);
+        size_t end = offsetOf(lines, edit.end);
+        text.replace(start, end - start, edit.text);
+    }
+
+    EditorBatchResult result = batch.apply(lines);
+    CHECK(result.applied == 4 && result.dropped == 0);
+    CHECK(joinLines(lines) == text);
+    CHECK(result.firstLine == 0);
+    CHECK(result.oldLastLine == 3);
+    CHECK(result.newLastLine == (int)lines.size() - 1);
+    CHECK(result.lineDelta == 2);
+
+    std::cout << "✅ sequential equivalence test passed!" << std::endl;
+    return true;
+}
+
+bool testMultiCursorCarets() {
+    std::cout << "Testing multi-cursor carets and overlaps..." << std::endl;
+
+    // Column edit: type "x" at column 2 of three lines, cursors added bottom-up
+    std::vector<std::string> lines = {"abcd", "efgh", "ij"};
+    EditorEditBatch batch;
+    batch.insert({2, 2}, "x");
+    batch.insert({1, 2}, "x");
+    batch.insert({0, 2}, "x");
+    EditorBatchResult result = batch.apply(lines);
+    CHECK(lines[0] == "abxcd" && lines[1] == "efxgh" && lines[2] == "ijx");
+    CHECK(result.carets[0] == (EditorPosition{2, 3}));
+    CHECK(result.carets[2] == (EditorPosition{0, 3}));
+    CHECK(result.lineDelta == 0);
+
+    // Two cursors on one line: carets shift by earlier insertions
+    lines = {"a = b"};
+    batch.clear();
+    batch.insert({0, 0}, "local ");
+    batch.insert({0, 5}, "()");
+    result = batch.apply(lines);
+    CHECK(lines[0] == "local a = b()");
+    CHECK(result.carets[1] == (EditorPosition{0, 13}));
+
+    // Overlapping erase is dropped and shares the earlier caret
+    lines = {"0123456789"};
+    batch.clear();
+    batch.erase({0, 2}, {0, 6});
+    batch.erase({0, 4}, {0, 8});
+    result = batch.apply(lines);
+    CHECK(lines[0] == "016789");
+    CHECK(result.applied == 1 && result.dropped == 1);
+    CHECK(result.carets[1] == result.carets[0]);
+
+    // Out of range positions are clamped to the document
+    lines = {"end"};
+    batch.clear();
+    batch.insert({5, 99}, "!");
+    batch.apply(lines);
+    CHECK(lines.size() == 1 && lines[0] == "end!");
+
+    std::cout << "✅ multi-cursor caret test passed!" << std::endl;
+    return true;
+}
+
+bool testNoOpDetection() {
+    std::cout << "Testing no-op batch detection..." << std::endl;
+
+    std::vector<std::string> lines = {"local x = 1", "x = x + 1", "print(x)"};
+
+    // Replacing a term with itself, and empty inserts
+    CHECK(!EditorEditBatch::replaceAll(lines, "x", "x").changes(lines));
+    CHECK(EditorEditBatch::replaceAll(lines, "x", "y").changes(lines));
+    EditorEditBatch inserts;
+    inserts.insert(EditorPosition{0, 0}, "");
+    inserts.insert(EditorPosition{2, 3}, "");
+    CHECK(!inserts.changes(lines));
+    CHECK(!EditorEditBatch().changes(lines));
+
+    // Multi-line ranges compare across the line break
+    EditorEditBatch span;
+    span.replace(EditorPosition{0, 6}, EditorPosition{1, 1}, "x = 1\nx");
+    CHECK(!span.changes(lines));
+    span.clear();
+    span.replace(EditorPosition{0, 6}, EditorPosition{1, 1}, "x = 1 x");
+    CHECK(span.changes(lines));
+
+    // An edit dropped for overlapping changes nothing
+    EditorEditBatch overlap;
+    overlap.replace(EditorPosition{1, 0}, EditorPosition{1, 5}, "x = x");
+    overlap.replace(EditorPosition{1, 2}, EditorPosition{1, 3}, "+");
+    CHECK(!overlap.changes(lines));
+
+    // changes() agrees with what apply() does
+    std::vector<std::string> copy = lines;
+    EditorBatchResult result = overlap.apply(copy);
+    CHECK(result.applied == 1 && result.dropped == 1);
+    CHECK(copy == lines);
+
+    std::cout << "✅ no-op detection test passed!" << std::endl;
+    return true;
+}
+
+bool testReplaceAllThroughput() {
+    std::cout << "Testing replace-all over 100k matches..." << std::endl;
+
+    std::vector<std::string> lines;
+    for (int i = 0; i < 50000; i++) {
+        lines.push_back("  sprite_move(id, x, y) -- sprite_move " + std::to_string(i));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    EditorEditBatch batch = EditorEditBatch::replaceAll(lines, "sprite_move", "sprite_set_position");
+    EditorBatchResult result = batch.apply(lines);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double ms = std::chrono::duration<double, std::milli>(elapsed).count();
+
+    CHECK(result.applied == 100000);
+    CHECK(lines.size() == 50000);
+    CHECK(lines[123] == "  sprite_set_position(id, x, y) -- sprite_set_position 123");
+    CHECK(EditorEditBatch::replaceAll(lines, "sprite_move", "").empty());
+
+    std::cout << "  100000 replacements: " << ms << " ms" << std::endl;
+    CHECK(ms < 500.0);
+
+    std::cout << "✅ replace-all throughput test passed!" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "SuperTerminal Editor Edit Batch Test" << std::endl;
+    std::cout << "====================================" << std::endl;
+
+    bool success = true;
+    success = testMatchesSequentialEdits() && success;
+    success = testMultiCursorCarets() && success;
+    success = testNoOpDetection() && success;
+    success = testReplaceAllThroughput() && success;
+
+    std::cout << (success ? "All editor edit batch tests passed" : "Editor edit batch tests FAILED") << std::endl;
+    return success ? 0 : 1;
+}
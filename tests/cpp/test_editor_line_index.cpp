@@ -0,0 +1,151 @@
+//
+//  test_editor_line_index.cpp
+//  SuperTerminal Framework - Editor Line Index Test
+//
+//  Checks that the editor's side index tracks the longest line across edits
+//  and that checkpointed lexing matches a full scan at any column
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "src/EditorLineIndex.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cout << "ERROR: " << #cond << " (line " << __LINE__ << ")" << std::endl; \
+            return false; \
+        } \
+    } while (0)
+
+// Reference: lex from column 0 every time
+static EditorLexState fullScan(const std::string& text, int column) {
+    EditorLexState state;
+    for (int pos = 0; pos < column; pos++) {
+        state = EditorLineIndex::step(state, text, pos);
+    }
+    return state;
+}
+
+bool testMaxLineLength() {
+    std::cout << "Testing max line length tracking..." << std::endl;
+
+    std::vector<std::string> lines = {"print(1)", std::string(500, 'x'), "", "local a = 1"};
+    EditorLineIndex index;
+    index.reset(lines);
+    CHECK(index.lineCount() == 4);
+    CHECK(index.maxLineLength() == 500);
+
+    // Shrinking the longest line falls back to the next longest
+    lines[1] = "short";
+    index.lineChanged(1, lines[1]);
+    CHECK(index.maxLineLength() == 11);
+
+    // Insert a long line, then erase it
+    lines.insert(lines.begin() + 2, std::string(2000, 'y'));
+    index.linesInserted(2, lines, 1);
+    CHECK(index.lineCount() == 5);
+    CHECK(index.maxLineLength() == 2000);
+
+    lines.erase(lines.begin() + 2);
+    index.linesErased(2, 1);
+    CHECK(index.lineCount() == 4);
+    CHECK(index.maxLineLength() == 11);
+
+    // Two lines of equal length: removing one keeps the other
+    lines.push_back("local a = 2");
+    index.linesInserted(4, lines, 1);
+    lines.erase(lines.begin() + 3);
+    index.linesErased(3, 1);
+    CHECK(index.maxLineLength() == 11);
+
+    index.reset({});
+    CHECK(index.maxLineLength() == 0);
+
+    std::cout << "✅ max line length test passed!" << std::endl;
+    return true;
+}
+
+bool testCheckpointLexing() {
+    std::cout << "Testing checkpoint lexing matches full scan..." << std::endl;
+
+    // A long generated line mixing strings, escapes and a late comment
+    std::string line;
+    for (int i = 0; i < 400; i++) {
+        line += "t[" + std::to_string(i) + "] = \"v\\\"" + std::to_string(i) + "\" .. 'x'; ";
+    }
+    line += "-- trailing \"comment\"";
+    std::vector<std::string> lines = {line};
+
+    EditorLineIndex index;
+    index.reset(lines);
+    for (int column = 0; column <= (int)line.length(); column += 97) {
+        CHECK(index.stateAt(0, line, column) == fullScan(line, column));
+    }
+    CHECK(index.stateAt(0, line, (int)line.length()).inComment);
+    CHECK(index.checkpointCount() == line.length() / EditorLineIndex::CHECKPOINT_INTERVAL + 1);
+
+    // "--" inside a string is not a comment
+    std::string quoted = "s = \"a--b\" x";
+    CHECK(!fullScan(quoted, 9).inComment);
+    CHECK(fullScan(quoted, 9).inDoubleString);
+    CHECK(!fullScan(quoted, (int)quoted.length()).inString());
+
+    // Editing the line drops its checkpoints; a stale length is detected
+    line.insert(0, "\"");
+    CHECK(index.stateAt(0, line, 5000) == fullScan(line, 5000));
+    lines[0] = line;
+    index.lineChanged(0, line);
+    CHECK(index.checkpointCount() == 0);
+
+    std::cout << "✅ checkpoint lexing test passed!" << std::endl;
+    return true;
+}
+
+bool testLongLineScrolling() {
+    std::cout << "Testing horizontal scroll on a 100k-column line..." << std::endl;
+
+    std::string line;
+    while (line.length() < 100000) {
+        line += "x = \"abc\" + 1 ";
+    }
+    std::vector<std::string> lines = {line};
+    EditorLineIndex index;
+    index.reset(lines);
+
+    // First visit builds checkpoints up to the column
+    index.stateAt(0, line, 99000);
+
+    // Subsequent frames at a far scroll offset only lex from the nearest checkpoint
+    auto start = std::chrono::steady_clock::now();
+    const int frames = 1000;
+    EditorLexState state;
+    for (int frame = 0; frame < frames; frame++) {
+        state = index.stateAt(0, line, 99000 + (frame % 100));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double perFrameUs = std::chrono::duration<double, std::micro>(elapsed).count() / frames;
+
+    CHECK(state == fullScan(line, 99000 + ((frames - 1) % 100)));
+    std::cout << "  stateAt(99000): " << perFrameUs << " us per frame" << std::endl;
+    CHECK(perFrameUs < 1000.0);
+
+    std::cout << "✅ long line scrolling test passed!" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "SuperTerminal Editor Line Index Test" << std::endl;
+    std::cout << "====================================" << std::endl;
+
+    bool success = true;
+    success = testMaxLineLength() && success;
+    success = testCheckpointLexing() && success;
+    success = testLongLineScrolling() && success;
+
+    std::cout << (success ? "All editor line index tests passed" : "Editor line index tests FAILED") << std::endl;
+    return success ? 0 : 1;
+}
@@ -0,0 +1,151 @@
+//
+//  test_file_watcher.cpp
+//  SuperTerminal Framework - File Watcher Test
+//
+//  Headless checks for the hot-reload watcher: debounce/batch policy with
+//  synthetic time, and a live watch of a temporary directory tree
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "src/assets/FileWatcher.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace SuperTerminal;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cout << "ERROR: " << #cond << " (line " << __LINE__ << ")" << std::endl; \
+            return false; \
+        } \
+    } while (0)
+
+static void writeFile(const std::string& path, const std::string& content) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << content;
+}
+
+// Poll until a batch arrives or the timeout expires
+static std::vector<std::string> waitForBatch(FileWatcher& watcher, int timeoutMs) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (std::chrono::steady_clock::now() < deadline) {
+        std::vector<std::string> batch = watcher.poll();
+        if (!batch.empty()) {
+            return batch;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return {};
+}
+
+bool testDebounceAndBatch() {
+    std::cout << "Testing debounce / batch policy..." << std::endl;
+
+    FileWatcherConfig config;
+    config.debounceMs = 100;
+    config.maxLatencyMs = 500;
+    ChangeBatcher batcher(config);
+
+    // A bulk export touching each file several times collapses to one entry each
+    for (int pass = 0; pass < 3; pass++) {
+        batcher.record("/a/sprite.png", 1000 + pass * 10);
+        batcher.record("/a/boom.wav", 1005 + pass * 10);
+    }
+    CHECK(batcher.pendingCount() == 2);
+    CHECK(!batcher.ready(1050));
+    CHECK(batcher.take(1100).empty());
+
+    std::vector<std::string> batch = batcher.take(1125);
+    CHECK(batch.size() == 2);
+    CHECK(batch[0] == "/a/boom.wav" && batch[1] == "/a/sprite.png");
+    CHECK(batcher.pendingCount() == 0);
+    CHECK(batcher.take(5000).empty());
+
+    // Continuous churn still flushes once the oldest change hits max latency
+    for (uint64_t t = 2000; t < 2600; t += 50) {
+        batcher.record("/a/module.lua", t);
+        if (t - 2000 < 500) {
+            CHECK(!batcher.ready(t));
+        }
+    }
+    CHECK(batcher.ready(2550));
+    CHECK(batcher.take(2550).size() == 1);
+
+    CHECK(FileWatcher::isIgnoredPath("/a/.main.lua.swp"));
+    CHECK(FileWatcher::isIgnoredPath("/a/main.lua~"));
+    CHECK(!FileWatcher::isIgnoredPath("/a/main.lua"));
+
+    std::cout << "✅ debounce / batch test passed!" << std::endl;
+    return true;
+}
+
+bool testLiveWatch() {
+    std::cout << "Testing live directory watch..." << std::endl;
+
+    char dirTemplate[] = "/tmp/st_watch_XXXXXX";
+    CHECK(mkdtemp(dirTemplate) != nullptr);
+    std::string root = FileWatcher::canonicalPath(dirTemplate);
+    std::string sub = root + "/sprites";
+    mkdir(sub.c_str(), 0755);
+
+    FileWatcherConfig config;
+    config.debounceMs = 100;
+    FileWatcher watcher(config);
+    CHECK(watcher.start({root}));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    // Several writes to the same files inside one debounce window
+    for (int i = 0; i < 5; i++) {
+        writeFile(root + "/main.lua", "return " + std::to_string(i));
+        writeFile(sub + "/hero.png", std::string(64 + i, 'x'));
+    }
+    writeFile(root + "/.main.lua.swp", "ignored");
+
+    std::vector<std::string> batch = waitForBatch(watcher, 3000);
+    CHECK(batch.size() == 2);
+    CHECK(batch[0] == root + "/main.lua");
+    CHECK(batch[1] == sub + "/hero.png");
+
+    // Files in a directory created after start are picked up too
+    std::string late = root + "/late";
+    mkdir(late.c_str(), 0755);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    writeFile(late + "/boom.wav", "RIFF");
+    batch = waitForBatch(watcher, 3000);
+    CHECK(batch.size() == 1 && batch[0] == late + "/boom.wav");
+
+    watcher.stop();
+    CHECK(!watcher.isRunning());
+
+    remove((late + "/boom.wav").c_str());
+    remove((sub + "/hero.png").c_str());
+    remove((root + "/main.lua").c_str());
+    remove((root + "/.main.lua.swp").c_str());
+    rmdir(late.c_str());
+    rmdir(sub.c_str());
+    rmdir(root.c_str());
+
+    std::cout << "✅ live watch test passed!" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "SuperTerminal File Watcher Test" << std::endl;
+    std::cout << "===============================" << std::endl;
+
+    bool success = true;
+    success = testDebounceAndBatch() && success;
+    success = testLiveWatch() && success;
+
+    std::cout << (success ? "All file watcher tests passed" : "File watcher tests FAILED") << std::endl;
+    return success ? 0 : 1;
+}
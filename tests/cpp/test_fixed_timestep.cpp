@@ -0,0 +1,310 @@
+//
+//  test_fixed_timestep.cpp
+//  SuperTerminal Framework - Fixed Timestep Scheduler Test
+//
+//  Headless checks for FixedTimestepScheduler: accumulator and interpolation
+//  alpha, catch-up cap, step ordering, seeded random streams, and bit-identical
+//  simulation state across runs and across different frame rates
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "src/FixedTimestep.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cout << "ERROR: " << #cond << " (line " << __LINE__ << ")" << std::endl; \
+            return false; \
+        } \
+    } while (0)
+
+static uint64_t hashBytes(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+// Stand-ins for the particle and bullet steps, using the same update rules
+// (gravity, drag, bounce with random variation, spread on fire)
+struct SimParticle {
+    float x, y, vx, vy, rotation, spin, life;
+};
+
+struct SimBullet {
+    float x, y, vx, vy, lifetime;
+};
+
+class MiniSimulation {
+public:
+    MiniSimulation(FixedTimestepScheduler& scheduler)
+        : particleRandom(scheduler.getRandom("particles"))
+        , bulletRandom(scheduler.getRandom("bullets")) {
+        scheduler.registerStep("bullets", SIM_STEP_ORDER_BULLETS,
+                               [this](float dt, uint64_t step) { stepBullets(dt, step); });
+        scheduler.registerStep("particles", SIM_STEP_ORDER_PARTICLES,
+                               [this](float dt, uint64_t step) { stepParticles(dt, step); });
+        scheduler.registerStep("record", 1000,
+                               [this](float, uint64_t) { stateHashes.push_back(hashState()); });
+    }
+
+    std::vector<uint64_t> stateHashes;     // One entry per step
+    std::vector<SimParticle> particles;
+    std::vector<SimBullet> bullets;
+
+private:
+    SimulationRandom& particleRandom;
+    SimulationRandom& bulletRandom;
+
+    // Scripted input keyed to step index, as a replay would be
+    void stepBullets(float dt, uint64_t step) {
+        if (step % 7 == 0) {
+            float spread = (bulletRandom.nextFloat() - 0.5f) * 0.3f;
+            bullets.push_back({512.0f, 700.0f, 600.0f * std::sin(spread), -600.0f * std::cos(spread), 2.0f});
+        }
+        for (SimBullet& b : bullets) {
+            b.vy += 980.0f * 0.1f * dt;
+            float speed = std::sqrt(b.vx * b.vx + b.vy * b.vy);
+            float drag = 1.0f - 0.02f * speed * dt / std::max(speed, 0.001f);
+            b.vx *= drag;
+            b.vy *= drag;
+            b.x += b.vx * dt;
+            b.y += b.vy * dt;
+            b.lifetime -= dt;
+        }
+        bullets.erase(std::remove_if(bullets.begin(), bullets.end(),
+                                     [](const SimBullet& b) { return b.lifetime <= 0.0f; }),
+                      bullets.end());
+    }
+
+    void stepParticles(float dt, uint64_t step) {
+        if (step % 45 == 3) {
+            for (int i = 0; i < 64; i++) {
+                float angle = particleRandom.range(0.0f, 6.2831853f);
+                float force = 200.0f * particleRandom.range(0.5f, 1.5f);
+                float spin = particleRandom.range(-2.0f, 2.0f);
+                float life = particleRandom.range(1.6f, 2.4f);
+                particles.push_back({300.0f, 200.0f, std::cos(angle) * force, std::sin(angle) * force,
+                                     0.0f, spin, life});
+            }
+        }
+        for (SimParticle& p : particles) {
+            p.vy += 98.0f * dt;
+            p.vx *= 0.995f;
+            p.vy *= 0.995f;
+            p.x += p.vx * dt;
+            p.y += p.vy * dt;
+            p.rotation += p.spin * dt;
+            p.life -= dt;
+            if (p.y >= 400.0f && p.vy > 0.0f) {
+                p.y = 400.0f;
+                p.vy = -p.vy * 0.4f;
+                p.vx = p.vx * 0.8f + particleRandom.range(-10.0f, 10.0f);
+            }
+        }
+        particles.erase(std::remove_if(particles.begin(), particles.end(),
+                                       [](const SimParticle& p) { return p.life <= 0.0f; }),
+                        particles.end());
+    }
+
+    uint64_t hashState() const {
+        uint64_t hash = 0xCBF29CE484222325ull;
+        hash = hashBytes(hash, particles.data(), particles.size() * sizeof(SimParticle));
+        hash = hashBytes(hash, bullets.data(), bullets.size() * sizeof(SimBullet));
+        return hash;
+    }
+};
+
+// Drive a fresh scheduler with a sequence of wall-clock frame deltas
+static std::vector<uint64_t> runSimulation(uint64_t seed, const std::vector<double>& frames) {
+    FixedTimestepScheduler scheduler;
+    scheduler.reset(seed);
+    MiniSimulation simulation(scheduler);
+    for (double frame : frames) {
+        scheduler.advance(frame);
+    }
+    return simulation.stateHashes;
+}
+
+static std::vector<double> steadyFrames(double hz, double seconds) {
+    return std::vector<double>((size_t)(seconds * hz), 1.0 / hz);
+}
+
+static std::vector<double> jitteredFrames(uint32_t seed, double seconds) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(0.004, 0.040);
+    std::vector<double> frames;
+    double total = 0.0;
+    while (total < seconds) {
+        frames.push_back(dist(gen));
+        total += frames.back();
+    }
+    return frames;
+}
+
+static bool samePrefix(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b, size_t count) {
+    if (a.size() < count || b.size() < count) {
+        return false;
+    }
+    return std::memcmp(a.data(), b.data(), count * sizeof(uint64_t)) == 0;
+}
+
+bool testAccumulatorAndAlpha() {
+    std::cout << "Testing accumulator and interpolation alpha..." << std::endl;
+
+    FixedTimestepScheduler scheduler;
+    int steps = 0;
+    scheduler.registerStep("count", 0, [&steps](float, uint64_t) { steps++; });
+
+    CHECK(scheduler.advance(1.0 / 120.0) == 0);
+    CHECK(std::fabs(scheduler.getAlpha() - 0.5) < 1e-9);
+    CHECK(scheduler.advance(1.0 / 120.0) == 1);
+    CHECK(scheduler.getAlpha() < 1e-9);
+    CHECK(scheduler.advance(1.0 / 30.0 + 1.0 / 240.0) == 2);
+    CHECK(std::fabs(scheduler.getAlpha() - 0.25) < 1e-9);
+    CHECK(steps == 3 && scheduler.getStepIndex() == 3);
+    CHECK(std::fabs(scheduler.getSimulationTime() - 3.0 / 60.0) < 1e-12);
+
+    // Bad deltas do nothing
+    CHECK(scheduler.advance(-1.0) == 0);
+    CHECK(scheduler.advance(std::nan("")) == 0);
+    CHECK(steps == 3);
+
+    // dt handed to steps is the fixed step
+    FixedTimestepScheduler fast;
+    fast.setStepRate(120.0);
+    float seenDt = 0.0f;
+    fast.registerStep("dt", 0, [&seenDt](float dt, uint64_t) { seenDt = dt; });
+    CHECK(fast.advance(1.0 / 60.0) == 2);
+    CHECK(seenDt == (float)(1.0 / 120.0));
+
+    std::cout << "✅ Accumulator test passed!" << std::endl;
+    return true;
+}
+
+bool testCatchUpCap() {
+    std::cout << "Testing catch-up cap and stall handling..." << std::endl;
+
+    FixedTimestepScheduler scheduler;
+    scheduler.setMaxCatchUpSteps(4);
+    scheduler.registerStep("noop", 0, [](float, uint64_t) {});
+
+    // 12 steps worth of time, only 4 run; the rest is dropped, not queued
+    CHECK(scheduler.advance(12.0 / 60.0) == 4);
+    CHECK(scheduler.getAlpha() < 1.0);
+    CHECK(std::fabs(scheduler.getDroppedTime() - 8.0 / 60.0) < 1e-9);
+    CHECK(scheduler.advance(1.0 / 60.0) == 1);
+
+    // A multi-second stall is clamped to the max frame delta first
+    FixedTimestepScheduler stalled;
+    stalled.registerStep("noop", 0, [](float, uint64_t) {});
+    CHECK(stalled.advance(5.0) == FixedTimestepScheduler::DEFAULT_MAX_CATCH_UP_STEPS);
+    CHECK(stalled.getDroppedTime() > 4.75);
+
+    std::cout << "✅ Catch-up cap test passed!" << std::endl;
+    return true;
+}
+
+bool testStepOrdering() {
+    std::cout << "Testing step ordering and unregistration..." << std::endl;
+
+    FixedTimestepScheduler scheduler;
+    std::string trace;
+    scheduler.registerStep("effects", SIM_STEP_ORDER_SPRITE_EFFECTS, [&trace](float, uint64_t) { trace += "e"; });
+    int particles = scheduler.registerStep("particles", SIM_STEP_ORDER_PARTICLES, [&trace](float, uint64_t) { trace += "p"; });
+    scheduler.registerStep("bullets", SIM_STEP_ORDER_BULLETS, [&trace](float, uint64_t) { trace += "b"; });
+    scheduler.registerStep("particles2", SIM_STEP_ORDER_PARTICLES, [&trace](float, uint64_t) { trace += "q"; });
+    CHECK(scheduler.getStepCount() == 4);
+
+    scheduler.step();
+    CHECK(trace == "bpqe");
+
+    CHECK(scheduler.unregisterStep(particles));
+    CHECK(!scheduler.unregisterStep(particles));
+    trace.clear();
+    scheduler.step();
+    CHECK(trace == "bqe");
+
+    std::cout << "✅ Step ordering test passed!" << std::endl;
+    return true;
+}
+
+bool testRandomStreams() {
+    std::cout << "Testing seeded random streams..." << std::endl;
+
+    FixedTimestepScheduler scheduler;
+    scheduler.reset(42);
+    SimulationRandom& a = scheduler.getRandom("particles");
+    SimulationRandom& b = scheduler.getRandom("bullets");
+    CHECK(&a == &scheduler.getRandom("particles"));
+
+    std::vector<uint32_t> first;
+    for (int i = 0; i < 16; i++) first.push_back(a.nextU32());
+    CHECK(a.nextU32() != b.nextU32());
+
+    // Reset rewinds every stream to the seed
+    scheduler.reset(42);
+    for (int i = 0; i < 16; i++) CHECK(a.nextU32() == first[i]);
+
+    scheduler.reset(43);
+    CHECK(a.nextU32() != first[0]);
+
+    for (int i = 0; i < 100000; i++) {
+        float value = a.nextFloat();
+        CHECK(value >= 0.0f && value < 1.0f);
+    }
+
+    std::cout << "✅ Random stream test passed!" << std::endl;
+    return true;
+}
+
+bool testDeterminism() {
+    std::cout << "Testing bit-identical state across runs and frame rates..." << std::endl;
+
+    const double seconds = 20.0;
+    const size_t steps = (size_t)(seconds * 60.0) - 2;
+
+    std::vector<uint64_t> reference = runSimulation(1234, steadyFrames(60.0, seconds));
+    std::vector<uint64_t> again = runSimulation(1234, steadyFrames(60.0, seconds));
+    std::vector<uint64_t> at144 = runSimulation(1234, steadyFrames(144.0, seconds));
+    std::vector<uint64_t> at30 = runSimulation(1234, steadyFrames(30.0, seconds));
+    std::vector<uint64_t> jitterA = runSimulation(1234, jitteredFrames(7, seconds));
+    std::vector<uint64_t> jitterB = runSimulation(1234, jitteredFrames(99, seconds));
+    std::vector<uint64_t> otherSeed = runSimulation(1235, steadyFrames(60.0, seconds));
+
+    std::cout << "  steps: 60Hz " << reference.size() << ", 144Hz " << at144.size()
+              << ", 30Hz " << at30.size() << ", jittered " << jitterA.size() << "/" << jitterB.size() << std::endl;
+
+    CHECK(reference == again);
+    CHECK(samePrefix(reference, at144, steps));
+    CHECK(samePrefix(reference, at30, steps));
+    CHECK(samePrefix(reference, jitterA, steps));
+    CHECK(samePrefix(reference, jitterB, steps));
+    CHECK(!samePrefix(reference, otherSeed, steps));
+
+    std::cout << "✅ Determinism test passed!" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "SuperTerminal Fixed Timestep Scheduler Test" << std::endl;
+    std::cout << "===========================================" << std::endl;
+
+    bool success = true;
+    success = testAccumulatorAndAlpha() && success;
+    success = testCatchUpCap() && success;
+    success = testStepOrdering() && success;
+    success = testRandomStreams() && success;
+    success = testDeterminism() && success;
+
+    std::cout << (success ? "All fixed timestep tests passed" : "Fixed timestep tests FAILED") << std::endl;
+    return success ? 0 : 1;
+}
@@ -0,0 +1,388 @@
+//
+//  test_frame_arena.cpp
+//  SuperTerminal Framework - Frame Arena Test
+//
+//  Checks for FrameArena and its STL adapters: allocations are aligned and
+//  never overlap, the newest allocation can be reclaimed so a growing vector
+//  reuses its space, scopes rewind, overflow falls back to the heap, is
+//  reported and grows the block for the next frame. The benchmark counts
+//  heap allocations per frame (global operator new is replaced) for the hot
+//  paths moved onto the arena: sprite grouping by effect and the audio mixer,
+//  which must also still mix inputs whose format differs from its output.
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "src/FrameArena.h"
+#include "src/audio/v2/AudioBuffer.h"
+#include "src/audio/v2/AudioNode.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cout << "ERROR: " << #cond << " (line " << __LINE__ << ")" << std::endl; \
+            return false; \
+        } \
+    } while (0)
+
+// =============================================================================
+// Heap allocation counter
+// =============================================================================
+
+static size_t g_heapAllocations = 0;
+
+void* operator new(size_t size) {
+    g_heapAllocations++;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+// Library code such as std::stable_sort's temporary buffer uses these
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    g_heapAllocations++;
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+// =============================================================================
+// Arena behaviour
+// =============================================================================
+
+bool testAllocation() {
+    std::cout << "Testing allocation and alignment..." << std::endl;
+
+    FrameArena arena(4096, false);
+    CHECK(arena.getCapacity() == 4096);
+
+    void* a = arena.allocate(3);
+    void* b = arena.allocate(10, 64);
+    void* c = arena.allocate(0);
+    CHECK(arena.owns(a) && arena.owns(b) && arena.owns(c));
+    CHECK(((uintptr_t)a % FrameArena::DEFAULT_ALIGNMENT) == 0);
+    CHECK(((uintptr_t)b % 64) == 0);
+    CHECK((uint8_t*)b >= (uint8_t*)a + 3);
+    CHECK((uint8_t*)c >= (uint8_t*)b + 10);
+
+    // Only the newest allocation is reclaimed
+    size_t used = arena.getUsed();
+    arena.deallocate(a, 3);
+    CHECK(arena.getUsed() == used);
+    arena.deallocate(c, 0);
+    CHECK(arena.getUsed() < used);
+    CHECK(arena.allocate(1) == c);
+
+    arena.reset();
+    CHECK(arena.getUsed() == 0);
+    CHECK(arena.getFrameCount() == 1);
+    CHECK(arena.getFrameHighWater() >= used);
+    CHECK(arena.getOverflowCount() == 0);
+
+    std::cout << "✅ Allocation test passed!" << std::endl;
+    return true;
+}
+
+bool testScopesAndAdapters() {
+    std::cout << "Testing scopes and STL adapters..." << std::endl;
+
+    FrameArena arena(64 * 1024);
+    arena.allocate(100);
+    size_t before = arena.getUsed();
+    {
+        FrameArenaScope scope(arena);
+        FrameArenaAllocator<int> allocator(arena);
+
+        // Growth reclaims the previous buffer each time, so the vector
+        // costs about its final size rather than the sum of every step
+        FrameVector<int> values(allocator);
+        for (int i = 0; i < 1000; i++) {
+            values.push_back(i);
+        }
+        CHECK(values.back() == 999);
+        CHECK(arena.getUsed() - before < 1024 * sizeof(int) * 2);
+
+        FrameMap<int, int> squares{std::less<int>(), FrameArenaAllocator<std::pair<const int, int>>(arena)};
+        for (int i = 0; i < 100; i++) {
+            squares[i] = i * i;
+        }
+        CHECK(squares.size() == 100 && squares[9] == 81);
+        CHECK(arena.owns(&squares.begin()->second));
+        CHECK(arena.getUsed() > before);
+    }
+    CHECK(arena.getUsed() == before);
+
+    // Nested scopes unwind in order
+    {
+        FrameArenaScope outer(arena);
+        arena.allocate(500);
+        size_t middle = arena.getUsed();
+        {
+            FrameArenaScope inner(arena);
+            arena.allocate(500);
+        }
+        CHECK(arena.getUsed() == middle);
+    }
+    CHECK(arena.getUsed() == before);
+
+    std::cout << "✅ Scope and adapter test passed!" << std::endl;
+    return true;
+}
+
+bool testOverflow() {
+    std::cout << "Testing overflow reporting and growth..." << std::endl;
+
+    FrameArena arena(1024);
+    void* inBlock = arena.allocate(512);
+    void* spilled = arena.allocate(2000, 128);
+    CHECK(arena.owns(inBlock));
+    CHECK(!arena.owns(spilled));
+    CHECK(((uintptr_t)spilled % 128) == 0);
+    CHECK(arena.getOverflowCount() == 1);
+    CHECK(arena.getUsed() == 2512);
+    std::memset(spilled, 0xAB, 2000);
+
+    arena.reset();
+    CHECK(arena.getLastFrameOverflowBytes() == 2000);
+    CHECK(arena.getFrameHighWater() == 2512);
+    CHECK(arena.getCapacity() >= 2512);     // Grew to cover the peak
+
+    // The same frame now fits
+    arena.allocate(512);
+    CHECK(arena.owns(arena.allocate(2000, 128)));
+    arena.reset();
+    CHECK(arena.getLastFrameOverflowBytes() == 0);
+    CHECK(arena.getOverflowCount() == 1);
+
+    // Without growth the block stays put and every frame reports overflow
+    FrameArena fixed(256, false);
+    fixed.allocate(1000);
+    fixed.reset();
+    CHECK(fixed.getLastFrameOverflowBytes() == 1000);
+    CHECK(fixed.getCapacity() == 256);
+
+    // Scopes release their overflow and, once the arena is empty, grow it
+    // (the path the audio thread takes, since it never calls reset)
+    FrameArena scoped(256);
+    {
+        FrameArenaScope scope(scoped);
+        scoped.allocate(4000);
+        CHECK(scoped.getUsed() == 4000);
+    }
+    CHECK(scoped.getUsed() == 0);
+    CHECK(scoped.getCapacity() >= 4000);
+
+    std::cout << "✅ Overflow test passed!" << std::endl;
+    return true;
+}
+
+// =============================================================================
+// Per-frame heap allocation benchmark
+// =============================================================================
+
+static const int SPRITE_COUNT = 512;
+static const int FRAME_COUNT = 200;
+
+// SpriteEffectManager before: getSpriteEffect() by value into a map of vectors
+static void groupLegacy(const std::vector<uint16_t>& spriteIds,
+                        const std::map<uint16_t, std::string>& assignments,
+                        std::vector<std::pair<std::string, size_t>>& groups) {
+    std::map<std::string, std::vector<uint16_t>> grouped;
+    for (uint16_t spriteId : spriteIds) {
+        auto it = assignments.find(spriteId);
+        std::string effectName = it != assignments.end() ? it->second : "basic";
+        grouped[effectName].push_back(spriteId);
+    }
+    groups.clear();
+    for (const auto& group : grouped) {
+        groups.emplace_back(group.first, group.second.size());
+    }
+}
+
+// SpriteEffectManager after: tagged runs in frame scratch
+static void groupArena(const std::vector<uint16_t>& spriteIds,
+                       const std::map<uint16_t, std::string>& assignments,
+                       std::vector<std::pair<std::string, size_t>>& groups) {
+    static const std::string defaultEffect = "basic";
+    static thread_local std::vector<uint16_t> groupScratch;
+
+    FrameArenaScope scope;
+    FrameVector<std::pair<const std::string*, uint32_t>> tagged;
+    tagged.reserve(spriteIds.size());
+    for (uint32_t i = 0; i < spriteIds.size(); i++) {
+        auto it = assignments.find(spriteIds[i]);
+        tagged.emplace_back(it != assignments.end() ? &it->second : &defaultEffect, i);
+    }
+    // Index breaks ties so each group keeps submission order; std::sort
+    // rather than stable_sort, which takes a heap buffer
+    std::sort(tagged.begin(), tagged.end(), [](const auto& a, const auto& b) {
+        int order = a.first->compare(*b.first);
+        return order != 0 ? order < 0 : a.second < b.second;
+    });
+
+    groups.clear();
+    size_t start = 0;
+    while (start < tagged.size()) {
+        const std::string& effectName = *tagged[start].first;
+        groupScratch.clear();
+        size_t end = start;
+        while (end < tagged.size() && *tagged[end].first == effectName) {
+            groupScratch.push_back(spriteIds[tagged[end].second]);
+            end++;
+        }
+        groups.emplace_back(effectName, groupScratch.size());
+        start = end;
+    }
+}
+
+// AudioMixerNode::process before: temp buffer per call plus a copy for bypass
+static void mixLegacy(const std::vector<std::shared_ptr<AudioNode>>& sources, AudioMixerNode& mixer,
+                      const AudioBuffer& inputBuffer, AudioBuffer& outputBuffer) {
+    outputBuffer.clear();
+    std::vector<std::shared_ptr<AudioNode>> inputNodes;
+    for (const auto& source : sources) {
+        inputNodes.push_back(source);
+    }
+    AudioBuffer tempBuffer(outputBuffer.getFrameCount(), outputBuffer.getChannelCount(), outputBuffer.getSampleRate());
+    for (size_t i = 0; i < inputNodes.size(); ++i) {
+        if (mixer.isChannelEnabled(i)) {
+            tempBuffer.copyFrom(inputBuffer);
+            tempBuffer.applyGain(mixer.getChannelVolume(i));
+            tempBuffer.applyPan(mixer.getChannelPan(i));
+            outputBuffer.mixFrom(tempBuffer, 1.0f);
+        }
+    }
+    AudioBuffer originalOutput = outputBuffer;
+    outputBuffer.copyFrom(originalOutput);
+}
+
+template <typename Frame>
+static double heapAllocationsPerFrame(Frame frame) {
+    frame();    // Warm up thread-local arenas and scratch
+    size_t start = g_heapAllocations;
+    for (int i = 0; i < FRAME_COUNT; i++) {
+        frame();
+    }
+    return (double)(g_heapAllocations - start) / FRAME_COUNT;
+}
+
+bool testHotPathAllocations() {
+    std::cout << "Testing per-frame heap allocations..." << std::endl;
+
+    // Sprite grouping: a quarter on the default effect, the rest on three others
+    const char* effectNames[] = {"glow", "outline", "sepia"};
+    std::map<uint16_t, std::string> assignments;
+    std::vector<uint16_t> spriteIds;
+    for (int i = 0; i < SPRITE_COUNT; i++) {
+        spriteIds.push_back((uint16_t)i);
+        if (i % 4 != 0) {
+            assignments[(uint16_t)i] = effectNames[i % 3];
+        }
+    }
+    std::vector<std::pair<std::string, size_t>> legacyGroups, arenaGroups;
+    legacyGroups.reserve(8);
+    arenaGroups.reserve(8);
+    groupLegacy(spriteIds, assignments, legacyGroups);
+    groupArena(spriteIds, assignments, arenaGroups);
+    CHECK(legacyGroups == arenaGroups);
+    CHECK(arenaGroups.size() == 4 && arenaGroups[0].first == "basic");
+
+    double groupBefore = heapAllocationsPerFrame([&] { groupLegacy(spriteIds, assignments, legacyGroups); });
+    double groupAfter = heapAllocationsPerFrame([&] { groupArena(spriteIds, assignments, arenaGroups); });
+
+    // Mixer: four stereo inputs with assorted volume and pan
+    auto mixer = std::make_shared<AudioMixerNode>(4);
+    std::vector<std::shared_ptr<AudioNode>> sources;
+    for (size_t i = 0; i < 4; i++) {
+        auto source = std::make_shared<AudioMixerNode>(1);
+        source->connect(mixer);
+        sources.push_back(source);
+        mixer->setChannelVolume(i, 0.25f + 0.2f * i);
+        mixer->setChannelPan(i, -0.75f + 0.5f * i);
+    }
+    mixer->setChannelEnabled(2, false);
+
+    AudioBuffer input(512, 2, 48000);
+    for (uint32_t frame = 0; frame < 512; frame++) {
+        input.setSample(frame, 0, std::sin(frame * 0.05f));
+        input.setSample(frame, 1, std::cos(frame * 0.03f));
+    }
+    AudioBuffer legacyOut(512, 2, 48000), arenaOut(512, 2, 48000);
+    mixLegacy(sources, *mixer, input, legacyOut);
+    mixer->process(input, arenaOut);
+    for (uint32_t frame = 0; frame < 512; frame++) {
+        for (uint32_t ch = 0; ch < 2; ch++) {
+            CHECK(std::fabs(legacyOut.getSample(frame, ch) - arenaOut.getSample(frame, ch)) < 1e-5f);
+        }
+    }
+
+    // A mono input of a different length still reaches both output channels
+    auto monoMixer = std::make_shared<AudioMixerNode>(1);
+    auto monoSource = std::make_shared<AudioMixerNode>(1);
+    monoSource->connect(monoMixer);
+    AudioBuffer monoInput(256, 1, 48000);
+    for (uint32_t frame = 0; frame < 256; frame++) {
+        monoInput.setSample(frame, 0, std::sin(frame * 0.05f));
+    }
+    AudioBuffer monoOut(512, 2, 48000);
+    monoMixer->process(monoInput, monoOut);
+    for (uint32_t frame = 0; frame < 512; frame++) {
+        float expected = frame < 256 ? monoInput.getSample(frame, 0) * std::sqrt(0.5f) : 0.0f;
+        CHECK(std::fabs(monoOut.getSample(frame, 0) - expected) < 1e-5f);
+        CHECK(std::fabs(monoOut.getSample(frame, 1) - expected) < 1e-5f);
+    }
+
+    double mixBefore = heapAllocationsPerFrame([&] { mixLegacy(sources, *mixer, input, legacyOut); });
+    double mixAfter = heapAllocationsPerFrame([&] { mixer->process(input, arenaOut); });
+
+    std::cout << "  Sprite grouping (" << SPRITE_COUNT << " sprites): "
+              << groupBefore << " -> " << groupAfter << " heap allocations/frame" << std::endl;
+    std::cout << "  Mixer (4 inputs x 512 frames):  "
+              << mixBefore << " -> " << mixAfter << " heap allocations/frame" << std::endl;
+    std::cout << "  Thread arena high water: " << FrameArena::forThread().getHighWater()
+              << " bytes, overflows: " << FrameArena::forThread().getOverflowCount() << std::endl;
+
+    CHECK(groupAfter == 0.0);
+    CHECK(mixAfter == 0.0);
+    CHECK(groupBefore >= 4.0);
+    CHECK(mixBefore >= 3.0);
+    CHECK(FrameArena::forThread().getOverflowCount() == 0);
+
+    std::cout << "✅ Per-frame allocation test passed!" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "SuperTerminal Frame Arena Test" << std::endl;
+    std::cout << "==============================" << std::endl;
+
+    bool success = true;
+    success = testAllocation() && success;
+    success = testScopesAndAdapters() && success;
+    success = testOverflow() && success;
+    success = testHotPathAllocations() && success;
+
+    std::cout << (success ? "All frame arena tests passed" : "Frame arena tests FAILED") << std::endl;
+    return success ? 0 : 1;
+}
@@ -0,0 +1,389 @@
+//
+//  test_midi_file_reader.cpp
+//  SuperTerminal Framework - MIDI File Reader Test
+//
+//  Headless checks for the memory-mapped SMF reader: round trips through
+//  the ABC MIDI writer, exact tempo map conversion, merge order, malformed
+//  input and parse throughput on a large orchestral-sized file
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "src/audio/MidiFileReader.h"
+#include "src/audio/abc/MIDIGenerator.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+using namespace SuperTerminal;
+using ABCPlayer::MIDIEvent;
+using ABCPlayer::MIDIEventType;
+using ABCPlayer::MIDIGenerator;
+using ABCPlayer::MIDITrack;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cout << "ERROR: " << #cond << " (line " << __LINE__ << ")" << std::endl; \
+            return false; \
+        } \
+    } while (0)
+
+static MIDIEvent makeMeta(MIDIEventType type, double time, std::vector<uint8_t> bytes) {
+    MIDIEvent event(type, time);
+    event.meta_data = std::move(bytes);
+    return event;
+}
+
+static MIDIEvent makeTempo(double time, uint32_t microsPerQuarter) {
+    return makeMeta(MIDIEventType::META_TEMPO, time,
+                    {uint8_t(microsPerQuarter >> 16), uint8_t(microsPerQuarter >> 8), uint8_t(microsPerQuarter)});
+}
+
+// Comparable form of an event: tick, status, data, meta type, payload
+using EventKey = std::tuple<uint64_t, int, int, int, int, std::vector<uint8_t>>;
+
+static EventKey keyFor(const MidiFileEvent& event) {
+    return EventKey(event.tick, event.status, event.data1, event.data2, event.metaType,
+                    std::vector<uint8_t>(event.payload, event.payload + event.payloadLength));
+}
+
+static EventKey keyFor(const MIDIEvent& event, int ticksPerQuarter) {
+    uint64_t tick = static_cast<uint64_t>(event.timestamp * 4.0 * ticksPerQuarter);
+    switch (event.type) {
+        case MIDIEventType::NOTE_ON: return EventKey(tick, 0x90 | event.channel, event.data1, event.data2, 0, {});
+        case MIDIEventType::NOTE_OFF: return EventKey(tick, 0x80 | event.channel, event.data1, event.data2, 0, {});
+        case MIDIEventType::PROGRAM_CHANGE: return EventKey(tick, 0xC0 | event.channel, event.data1, 0, 0, {});
+        case MIDIEventType::CONTROL_CHANGE: return EventKey(tick, 0xB0 | event.channel, event.data1, event.data2, 0, {});
+        case MIDIEventType::META_TEMPO: return EventKey(tick, 0xFF, 0, 0, 0x51, event.meta_data);
+        case MIDIEventType::META_TIME_SIGNATURE: return EventKey(tick, 0xFF, 0, 0, 0x58, event.meta_data);
+        case MIDIEventType::META_KEY_SIGNATURE: return EventKey(tick, 0xFF, 0, 0, 0x59, event.meta_data);
+        case MIDIEventType::META_TEXT: return EventKey(tick, 0xFF, 0, 0, 0x01, event.meta_data);
+        case MIDIEventType::META_END_OF_TRACK: return EventKey(tick, 0xFF, 0, 0, 0x2F, {});
+        default: return EventKey(tick, 0, 0, 0, 0, {});
+    }
+}
+
+static std::vector<MIDITrack> makeTracks() {
+    std::vector<MIDITrack> tracks(3);
+
+    // Conductor track: tempo changes, meter, key, text
+    MIDITrack& conductor = tracks[0];
+    conductor.events.push_back(makeTempo(0.0, 500000));
+    conductor.events.push_back(makeMeta(MIDIEventType::META_TIME_SIGNATURE, 0.0, {3, 2, 24, 8}));
+    conductor.events.push_back(makeMeta(MIDIEventType::META_KEY_SIGNATURE, 0.0, {0xFE, 1}));
+    conductor.events.push_back(makeMeta(MIDIEventType::META_TEXT, 0.5, {'A', 'd', 'a', 'g', 'i', 'o'}));
+    conductor.events.push_back(makeTempo(1.0, 428571));
+    conductor.events.push_back(makeTempo(2.25, 923077));
+    conductor.events.push_back(MIDIEvent(MIDIEventType::META_END_OF_TRACK, 4.0));
+
+    // Two parts with running status, program and controller changes
+    for (int part = 1; part <= 2; part++) {
+        MIDITrack& track = tracks[part];
+        int channel = part == 1 ? 0 : 9;
+        track.events.push_back(MIDIEvent(MIDIEventType::PROGRAM_CHANGE, 0.0, channel, 40 + part));
+        track.events.push_back(MIDIEvent(MIDIEventType::CONTROL_CHANGE, 0.0, channel, 7, 100));
+        for (int i = 0; i < 32; i++) {
+            double start = i * 0.125;
+            int note = 48 + part * 7 + (i * 5) % 24;
+            track.events.push_back(MIDIEvent(MIDIEventType::NOTE_ON, start, channel, note, 60 + i));
+            track.events.push_back(MIDIEvent(MIDIEventType::NOTE_OFF, start + 0.0625, channel, note, 0));
+        }
+        track.events.push_back(MIDIEvent(MIDIEventType::CONTROL_CHANGE, 3.5, channel, 64, 127));
+        track.events.push_back(MIDIEvent(MIDIEventType::META_END_OF_TRACK, 4.0));
+    }
+    return tracks;
+}
+
+bool testRoundTrip() {
+    std::cout << "Testing round trip through the ABC MIDI writer..." << std::endl;
+
+    const std::string path = "/tmp/superterminal_test_roundtrip.mid";
+    std::vector<MIDITrack> tracks = makeTracks();
+    MIDIGenerator generator;
+    CHECK(generator.writeMIDIFile(tracks, path));
+
+    MidiFileReader reader;
+    CHECK(reader.open(path));
+    CHECK(reader.getFormat() == 1);
+    CHECK(reader.getTrackCount() == tracks.size());
+    CHECK(reader.getDivision() == MIDIGenerator::DEFAULT_TICKS_PER_QUARTER);
+
+    size_t totalEvents = 0;
+    for (size_t t = 0; t < tracks.size(); t++) {
+        std::vector<MidiFileEvent> events;
+        CHECK(reader.readTrack(t, events));
+        CHECK(events.size() == tracks[t].events.size());
+        totalEvents += events.size();
+
+        // The writer sorts by time without a stable order; compare as sets
+        std::vector<EventKey> expected, actual;
+        for (const MIDIEvent& event : tracks[t].events) expected.push_back(keyFor(event, reader.getDivision()));
+        for (const MidiFileEvent& event : events) actual.push_back(keyFor(event));
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        CHECK(expected == actual);
+        CHECK(events.back().isEndOfTrack());
+    }
+
+    // Merged stream is time ordered with ties in track order
+    std::vector<MidiFileEvent> merged;
+    CHECK(reader.readMerged(merged));
+    CHECK(merged.size() == totalEvents);
+    for (size_t i = 1; i < merged.size(); i++) {
+        CHECK(merged[i - 1].tick < merged[i].tick ||
+              (merged[i - 1].tick == merged[i].tick && merged[i - 1].track <= merged[i].track));
+    }
+
+    const MidiTempoMap& tempo = reader.getTempoMap();
+    CHECK(tempo.getSegments().size() == 3);
+    CHECK(tempo.getMicrosPerQuarterAt(1919) == 500000);
+    CHECK(tempo.getMicrosPerQuarterAt(1920) == 428571);
+
+    reader.close();
+    std::remove(path.c_str());
+
+    std::cout << "  " << tracks.size() << " tracks, " << totalEvents << " events identical" << std::endl;
+    std::cout << "✅ round trip test passed!" << std::endl;
+    return true;
+}
+
+bool testTempoMapExact() {
+    std::cout << "Testing exact tempo map conversion..." << std::endl;
+
+    MidiTempoMap map(480);
+    map.addTempo(0, 500000);
+    map.addTempo(960, 400000);
+    map.addTempo(1920, 666667);
+    CHECK(map.ticksToMicros(960) == 1000000);
+    CHECK(map.ticksToMicros(1920) == 1800000);
+    CHECK(map.ticksToMicros(2400) == 2466667);
+
+    uint64_t numerator, denominator;
+    map.getExactMicros(2401, numerator, denominator);
+    CHECK(numerator == 2466667ull * 480 + 666667 && denominator == 480);
+    CHECK(map.secondsToTicks(map.ticksToSeconds(2401)) == 2401);
+    CHECK(map.secondsToTicks(1.8) == 1920);
+
+    // A long file with an awkward tempo change every bar must match an
+    // integer reference to the last bit
+    MidiTempoMap longMap(960);
+    uint64_t referenceScaled = 0;
+    double runningSeconds = 0.0;
+    uint32_t tempo = 500000;
+    const uint64_t bar = 3840;
+    for (uint64_t b = 0; b < 20000; b++) {
+        tempo = 350000 + (uint32_t)((b * 7919) % 400000) + 1;
+        longMap.addTempo(b * bar, tempo);
+        referenceScaled += bar * tempo;
+        runningSeconds += 4.0 * tempo / 1e6;
+    }
+    uint64_t endTick = 20000 * bar;
+    double exactSeconds = (double)(referenceScaled / 960) * 1e-6 + (double)(referenceScaled % 960) / 960.0 * 1e-6;
+    double mapped = longMap.ticksToSeconds(endTick);
+    std::cout << "  " << exactSeconds << " s after 20000 tempo changes: map error "
+              << std::fabs(mapped - exactSeconds) * 1e9 << " ns, running sum error "
+              << std::fabs(runningSeconds - exactSeconds) * 1e9 << " ns" << std::endl;
+    CHECK(mapped == exactSeconds);
+    CHECK(longMap.ticksToMicros(endTick) == (referenceScaled + 480) / 960);
+    for (uint64_t tick : {(uint64_t)0, bar * 1234 + 17, endTick - 1}) {
+        CHECK(longMap.secondsToTicks(longMap.ticksToSeconds(tick)) == tick);
+    }
+
+    // SMPTE 25 fps x 40 ticks is one millisecond per tick; 29.97 drop frame
+    MidiTempoMap smpte((uint16_t)((uint8_t)(-25) << 8 | 40));
+    smpte.addTempo(100, 250000);
+    CHECK(smpte.isSmpte());
+    CHECK(smpte.ticksToMicros(1000) == 1000000);
+    MidiTempoMap dropFrame((uint16_t)((uint8_t)(-29) << 8 | 4));
+    CHECK(dropFrame.ticksToMicros(30000 * 4) == 1001000000);
+
+    std::cout << "✅ tempo map test passed!" << std::endl;
+    return true;
+}
+
+static void putVariableLength(std::vector<uint8_t>& out, uint32_t value) {
+    uint8_t bytes[5];
+    int count = 0;
+    bytes[count++] = value & 0x7F;
+    while ((value >>= 7) > 0) bytes[count++] = (value & 0x7F) | 0x80;
+    while (count > 0) out.push_back(bytes[--count]);
+}
+
+static void putBigEndian(std::vector<uint8_t>& out, uint32_t value, int bytes) {
+    for (int i = bytes - 1; i >= 0; i--) out.push_back(uint8_t(value >> (i * 8)));
+}
+
+static std::vector<uint8_t> makeFile(uint16_t format, const std::vector<std::vector<uint8_t>>& tracks, uint16_t division = 96) {
+    std::vector<uint8_t> file = {'M', 'T', 'h', 'd'};
+    putBigEndian(file, 6, 4);
+    putBigEndian(file, format, 2);
+    putBigEndian(file, (uint32_t)tracks.size(), 2);
+    putBigEndian(file, division, 2);
+    for (const auto& track : tracks) {
+        file.insert(file.end(), {'M', 'T', 'r', 'k'});
+        putBigEndian(file, (uint32_t)track.size(), 4);
+        file.insert(file.end(), track.begin(), track.end());
+    }
+    return file;
+}
+
+bool testFormatsAndErrors() {
+    std::cout << "Testing type 0, sysex, running status and malformed input..." << std::endl;
+
+    // Type 0: running status across a sysex must not be reused
+    std::vector<uint8_t> track = {0x00, 0x90, 60, 100,
+                                  0x10, 62, 100,                 // Running status
+                                  0x00, 0xF0, 0x03, 0x7E, 0x09, 0xF7,
+                                  0x10, 0x80, 60, 0,
+                                  0x00, 0xC5, 12,
+                                  0x83, 0x60, 0xFF, 0x51, 0x03, 0x07, 0xA1, 0x20,
+                                  0x00, 0xFF, 0x2F, 0x00};
+    std::vector<uint8_t> file = makeFile(0, {track});
+    MidiFileReader reader;
+    CHECK(reader.openMemory(file.data(), file.size()));
+    std::vector<MidiFileEvent> events;
+    CHECK(reader.readMerged(events));
+    CHECK(events.size() == 7);
+    CHECK(events[1].isNoteOn() && events[1].data1 == 62 && events[1].tick == 16);
+    CHECK(events[2].isSysex() && events[2].payloadLength == 3 && events[2].payload[1] == 0x09);
+    CHECK(events[3].isNoteOff() && events[3].tick == 32);
+    CHECK(events[4].getType() == 0xC0 && events[4].getChannel() == 5 && events[4].data1 == 12);
+    CHECK(events[5].isTempo() && events[5].tick == 32 + 480 && events[5].getMicrosPerQuarter() == 500000);
+    CHECK(reader.getTempoMap().getSegments().size() == 2);
+    CHECK(reader.getTempoMap().ticksToMicros(512) == 2666667);
+
+    // Data byte right after a sysex has no running status to use
+    std::vector<uint8_t> bad = {0x00, 0xF0, 0x01, 0xF7, 0x00, 60, 100};
+    file = makeFile(0, {bad});
+    CHECK(reader.openMemory(file.data(), file.size()));
+    CHECK(!reader.readMerged(events));
+    CHECK(!reader.getError().empty());
+
+    // Truncated meta length, overlong variable length quantity
+    for (std::vector<uint8_t> broken : {std::vector<uint8_t>{0x00, 0xFF, 0x01, 0x40, 'a'},
+                                        std::vector<uint8_t>{0xFF, 0xFF, 0xFF, 0xFF, 0x7F, 0x90, 60, 1}}) {
+        file = makeFile(1, {broken});
+        CHECK(reader.openMemory(file.data(), file.size()));
+        std::vector<MidiFileEvent> out;
+        CHECK(!reader.readTrack(0, out));
+    }
+
+    // Missing end-of-track and a truncated last chunk are tolerated
+    file = makeFile(1, {{0x00, 0x90, 60, 100, 0x60, 0x80, 60, 0}});
+    file.resize(file.size() - 3);
+    CHECK(reader.openMemory(file.data(), file.size()));
+    std::vector<MidiFileEvent> partial;
+    CHECK(!reader.readTrack(0, partial));
+    CHECK(partial.size() == 1);
+
+    // Not a MIDI file, format 2, missing file
+    const uint8_t junk[] = "RIFF....WAVEfmt ";
+    CHECK(!reader.openMemory(junk, sizeof(junk)));
+    file = makeFile(2, {track});
+    CHECK(!reader.openMemory(file.data(), file.size()));
+    CHECK(!reader.open("/tmp/superterminal_no_such_file.mid"));
+
+    std::cout << "✅ formats and errors test passed!" << std::endl;
+    return true;
+}
+
+bool testParseBenchmark() {
+    std::cout << "Testing parse throughput on a large orchestral-sized file..." << std::endl;
+
+    // 32 parts x 60000 notes with controller sweeps and a conductor track
+    // with a tempo change per bar: ~4.7M events, similar in shape to a
+    // long orchestral score
+    const int parts = 32;
+    const int notesPerPart = 60000;
+    std::vector<std::vector<uint8_t>> tracks;
+
+    std::vector<uint8_t> conductor;
+    for (int bar = 0; bar < notesPerPart / 8; bar++) {
+        putVariableLength(conductor, bar == 0 ? 0 : 1920);
+        uint32_t tempo = 400000 + (bar * 3301) % 300000;
+        conductor.insert(conductor.end(), {0xFF, 0x51, 0x03, uint8_t(tempo >> 16), uint8_t(tempo >> 8), uint8_t(tempo)});
+    }
+    conductor.insert(conductor.end(), {0x00, 0xFF, 0x2F, 0x00});
+    tracks.push_back(conductor);
+
+    for (int part = 0; part < parts; part++) {
+        std::vector<uint8_t> track;
+        uint8_t channel = uint8_t(part % 16);
+        track.insert(track.end(), {0x00, uint8_t(0xC0 | channel), uint8_t(part)});
+        for (int i = 0; i < notesPerPart; i++) {
+            uint8_t note = uint8_t(36 + (i * 7 + part * 5) % 60);
+            track.insert(track.end(), {0x00, uint8_t(0x90 | channel), note, uint8_t(40 + i % 80)});
+            if (i % 4 == 0) track.insert(track.end(), {0x00, uint8_t(0xB0 | channel), 11, uint8_t(i % 128)});
+            putVariableLength(track, 240);
+            track.insert(track.end(), {uint8_t(0x80 | channel), note, 0});
+        }
+        track.insert(track.end(), {0x00, 0xFF, 0x2F, 0x00});
+        tracks.push_back(track);
+    }
+
+    const std::string path = "/tmp/superterminal_test_orchestral.mid";
+    {
+        std::vector<uint8_t> file = makeFile(1, tracks, 480);
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(file.data()), file.size());
+    }
+
+    double bestOpenMs = 1e9, bestScanMs = 1e9, bestMergeMs = 1e9;
+    size_t scanned = 0, merged = 0, fileSize = 0;
+    for (int run = 0; run < 3; run++) {
+        auto start = std::chrono::steady_clock::now();
+        MidiFileReader reader;
+        CHECK(reader.open(path));
+        auto opened = std::chrono::steady_clock::now();
+
+        // Lazy decode: walk every track cursor without storing events
+        scanned = 0;
+        for (size_t t = 0; t < reader.getTrackCount(); t++) {
+            MidiFileReader::TrackCursor cursor = reader.openTrack(t);
+            MidiFileEvent event;
+            while (cursor.next(event)) scanned++;
+            CHECK(!cursor.hasError());
+        }
+        auto scannedAt = std::chrono::steady_clock::now();
+
+        std::vector<MidiFileEvent> events;
+        CHECK(reader.readMerged(events));
+        auto mergedAt = std::chrono::steady_clock::now();
+        merged = events.size();
+        fileSize = reader.getFileSize();
+
+        bestOpenMs = std::min(bestOpenMs, std::chrono::duration<double, std::milli>(opened - start).count());
+        bestScanMs = std::min(bestScanMs, std::chrono::duration<double, std::milli>(scannedAt - opened).count());
+        bestMergeMs = std::min(bestMergeMs, std::chrono::duration<double, std::milli>(mergedAt - scannedAt).count());
+    }
+    std::remove(path.c_str());
+
+    double megabytes = fileSize / 1e6;
+    std::cout << "  " << megabytes << " MB, " << merged << " events: open " << bestOpenMs << " ms, scan "
+              << bestScanMs << " ms (" << megabytes / (bestScanMs / 1000.0) << " MB/s), merged "
+              << bestMergeMs << " ms (" << merged / (bestMergeMs / 1000.0) / 1e6 << " M events/s)" << std::endl;
+    CHECK(scanned == merged);
+    CHECK(merged == (size_t)(notesPerPart / 8 + 1) + parts * (2 + notesPerPart * 2 + notesPerPart / 4));
+
+    std::cout << "✅ parse benchmark passed!" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "SuperTerminal MIDI File Reader Test" << std::endl;
+    std::cout << "===================================" << std::endl;
+
+    bool success = true;
+    success = testRoundTrip() && success;
+    success = testTempoMapExact() && success;
+    success = testFormatsAndErrors() && success;
+    success = testParseBenchmark() && success;
+
+    std::cout << (success ? "All MIDI file reader tests passed" : "MIDI file reader tests FAILED") << std::endl;
+    return success ? 0 : 1;
+}
@@ -0,0 +1,278 @@
+//
+//  test_mouse_events.cpp
+//  SuperTerminal Framework - Mouse Event Stream Test
+//
+//  Headless checks for MouseEventQueue: ordering, move and wheel coalescing,
+//  overflow, waiting for a press/release newer than a sequence number without
+//  consuming, timeouts, interrupt and cancel wake-ups, plus wake latency for
+//  synthetic events injected from another thread
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "src/MouseEventQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cout << "ERROR: " << #cond << " (line " << __LINE__ << ")" << std::endl; \
+            return false; \
+        } \
+    } while (0)
+
+static MouseEvent makeEvent(MouseEventType type, int button = -1, float x = 0.0f, float y = 0.0f) {
+    MouseEvent event;
+    event.type = type;
+    event.button = button;
+    event.x = x;
+    event.y = y;
+    return event;
+}
+
+static MouseEvent wheel(float dx, float dy) {
+    MouseEvent event = makeEvent(MouseEventType::Wheel);
+    event.deltaX = dx;
+    event.deltaY = dy;
+    return event;
+}
+
+static double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool testOrderingAndCoalescing() {
+    std::cout << "Testing ordering and coalescing..." << std::endl;
+
+    MouseEventQueue queue;
+    queue.push(makeEvent(MouseEventType::Press, 0, 10, 10));
+    queue.push(makeEvent(MouseEventType::Move, -1, 11, 12));
+    queue.push(makeEvent(MouseEventType::Move, -1, 13, 14));
+    queue.push(makeEvent(MouseEventType::Move, -1, 15, 16));
+    queue.push(wheel(0.0f, 1.5f));
+    queue.push(wheel(0.5f, 2.0f));
+    uint64_t last = queue.push(makeEvent(MouseEventType::Release, 0, 15, 16));
+    CHECK(last == 7);
+    CHECK(queue.getLastSequence() == 7);
+    CHECK(queue.getCount() == 4);
+
+    std::vector<MouseEvent> events;
+    CHECK(queue.drain(events) == 4);
+    CHECK(events[0].type == MouseEventType::Press && events[0].button == 0);
+    CHECK(events[1].type == MouseEventType::Move && events[1].x == 15.0f && events[1].y == 16.0f);
+    CHECK(events[1].sequence == 4);
+    CHECK(events[2].type == MouseEventType::Wheel);
+    CHECK(std::fabs(events[2].deltaX - 0.5f) < 1e-6f && std::fabs(events[2].deltaY - 3.5f) < 1e-6f);
+    CHECK(events[3].type == MouseEventType::Release && events[3].sequence == 7);
+    for (size_t i = 1; i < events.size(); i++) {
+        CHECK(events[i].sequence > events[i - 1].sequence);
+        CHECK(events[i].timestamp >= events[i - 1].timestamp);
+    }
+    CHECK(queue.secondsSinceStart(events[0]) >= 0.0);
+    CHECK(queue.getCount() == 0);
+
+    // A press between moves breaks the run
+    queue.push(makeEvent(MouseEventType::Move, -1, 1, 1));
+    queue.push(makeEvent(MouseEventType::Press, 1, 1, 1));
+    queue.push(makeEvent(MouseEventType::Move, -1, 2, 2));
+    events.clear();
+    CHECK(queue.drain(events, 2) == 2);
+    CHECK(queue.getCount() == 1);
+    CHECK(events[1].type == MouseEventType::Press && events[1].button == 1);
+
+    // Caller timestamps are kept
+    auto stamped = std::chrono::steady_clock::now() - std::chrono::seconds(1);
+    MouseEvent old = makeEvent(MouseEventType::Press, 2);
+    old.timestamp = stamped;
+    queue.clear();
+    queue.push(old);
+    events.clear();
+    queue.drain(events);
+    CHECK(events.size() == 1 && events[0].timestamp == stamped);
+
+    std::cout << "✅ Ordering test passed!" << std::endl;
+    return true;
+}
+
+bool testOverflow() {
+    std::cout << "Testing overflow..." << std::endl;
+
+    MouseEventQueue queue(4);
+    for (int i = 0; i < 6; i++) {
+        queue.push(makeEvent(i % 2 ? MouseEventType::Release : MouseEventType::Press, 0, (float)i, 0));
+    }
+    CHECK(queue.getCount() == 4);
+    CHECK(queue.getDroppedCount() == 2);
+
+    std::vector<MouseEvent> events;
+    queue.drain(events);
+    CHECK(events.front().x == 2.0f && events.back().x == 5.0f);
+
+    std::cout << "✅ Overflow test passed!" << std::endl;
+    return true;
+}
+
+bool testWaitFor() {
+    std::cout << "Testing waits for newer events..." << std::endl;
+
+    MouseEventQueue queue;
+    queue.push(makeEvent(MouseEventType::Press, 0, 1, 1));
+    uint64_t since = queue.getLastSequence();
+
+    // The press already queued is older than the wait
+    MouseEvent found;
+    auto start = std::chrono::steady_clock::now();
+    CHECK(queue.waitFor(since, MouseEventQueue::maskOf(MouseEventType::Press), -1, found, 20) ==
+          MouseWaitResult::Timeout);
+    CHECK(msSince(start) >= 19.0);
+
+    // Release of another button and moves do not satisfy a left release
+    std::thread producer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        queue.push(makeEvent(MouseEventType::Move, -1, 2, 2));
+        queue.push(makeEvent(MouseEventType::Release, 1, 3, 3));
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        queue.push(makeEvent(MouseEventType::Release, 0, 4, 4));
+    });
+    MouseWaitResult result = queue.waitFor(since, MouseEventQueue::maskOf(MouseEventType::Release), 0, found, 2000);
+    producer.join();
+    CHECK(result == MouseWaitResult::Event);
+    CHECK(found.button == 0 && found.x == 4.0f);
+
+    // Nothing was consumed
+    CHECK(queue.getCount() == 4);
+
+    // An event already newer than the sequence returns immediately
+    CHECK(queue.waitFor(since, MouseEventQueue::ALL_EVENTS, -1, found, 0) == MouseWaitResult::Event);
+    CHECK(found.type == MouseEventType::Move);
+
+    // waitPop consumes in order, then times out when empty
+    MouseEvent popped;
+    for (int i = 0; i < 4; i++) {
+        CHECK(queue.waitPop(popped, 0) == MouseWaitResult::Event);
+    }
+    CHECK(popped.type == MouseEventType::Release && popped.button == 0);
+    CHECK(queue.waitPop(popped, 10) == MouseWaitResult::Timeout);
+
+    std::cout << "✅ Wait test passed!" << std::endl;
+    return true;
+}
+
+bool testInterrupt() {
+    std::cout << "Testing interrupt and cancel wake-ups..." << std::endl;
+
+    MouseEventQueue queue;
+    MouseEvent event;
+
+    // interrupt() releases an unbounded wait at once
+    std::chrono::steady_clock::time_point interruptedAt;
+    std::thread stopper([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        interruptedAt = std::chrono::steady_clock::now();
+        queue.interrupt();
+    });
+    MouseWaitResult result = queue.waitPop(event, -1);
+    double interruptMs = msSince(interruptedAt);
+    stopper.join();
+    CHECK(result == MouseWaitResult::Interrupted);
+    CHECK(interruptMs < 50.0);
+
+    // An interrupt before a wait starts does not cancel it
+    CHECK(queue.waitPop(event, 5) == MouseWaitResult::Timeout);
+
+    // A cancel raised without interrupt() is seen within one poll slice
+    std::atomic<bool> cancelled{false};
+    std::thread canceller([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        cancelled = true;
+    });
+    auto start = std::chrono::steady_clock::now();
+    result = queue.waitFor(0, MouseEventQueue::ALL_EVENTS, -1, event, -1, [&] { return cancelled.load(); });
+    double cancelMs = msSince(start);
+    canceller.join();
+    CHECK(result == MouseWaitResult::Interrupted);
+    CHECK(cancelMs < 20.0 + MouseEventQueue::CANCEL_POLL_MS + 100.0);
+
+    // A cancelled check does not delay events
+    std::thread producer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        queue.push(makeEvent(MouseEventType::Press, 2));
+    });
+    start = std::chrono::steady_clock::now();
+    result = queue.waitPop(event, -1, [] { return false; });
+    double eventMs = msSince(start);
+    producer.join();
+    CHECK(result == MouseWaitResult::Event && event.button == 2);
+    CHECK(eventMs < MouseEventQueue::CANCEL_POLL_MS);
+
+    std::cout << "  interrupt wake: " << interruptMs << " ms, cancel poll: " << cancelMs << " ms" << std::endl;
+    std::cout << "✅ Interrupt test passed!" << std::endl;
+    return true;
+}
+
+bool testWakeLatency() {
+    std::cout << "Testing wake latency for injected events..." << std::endl;
+
+    const int samples = 300;
+    MouseEventQueue queue;
+    std::vector<double> latencies;
+    latencies.reserve(samples);
+
+    std::atomic<bool> ready{false};
+    std::thread producer([&] {
+        for (int i = 0; i < samples; i++) {
+            // Wait until the consumer is (about to be) blocked again
+            while (!ready.exchange(false)) {
+                std::this_thread::yield();
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+            queue.push(makeEvent(i % 2 ? MouseEventType::Release : MouseEventType::Press, 0, (float)i, 0));
+        }
+    });
+
+    for (int i = 0; i < samples; i++) {
+        ready = true;
+        MouseEvent event;
+        if (queue.waitPop(event, 2000, [] { return false; }) != MouseWaitResult::Event) {
+            producer.join();
+            CHECK(false);
+        }
+        latencies.push_back(std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - event.timestamp).count());
+    }
+    producer.join();
+
+    std::sort(latencies.begin(), latencies.end());
+    double median = latencies[samples / 2];
+    double p99 = latencies[samples * 99 / 100];
+    double worst = latencies.back();
+
+    // The polling loop slept 10 ms per check; an event wait should be far
+    // below that even on a loaded machine
+    CHECK(median < 10000.0);
+
+    std::cout << "  wake latency: median " << median << " us, p99 " << p99 << " us, max " << worst
+              << " us (was up to 10000 us per poll)" << std::endl;
+    std::cout << "✅ Wake latency test passed!" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "SuperTerminal Mouse Event Test" << std::endl;
+    std::cout << "==============================" << std::endl;
+
+    bool success = true;
+    success = testOrderingAndCoalescing() && success;
+    success = testOverflow() && success;
+    success = testWaitFor() && success;
+    success = testInterrupt() && success;
+    success = testWakeLatency() && success;
+
+    std::cout << (success ? "All mouse event tests passed" : "Mouse event tests FAILED") << std::endl;
+    return success ? 0 : 1;
+}
@@ -0,0 +1,399 @@
+//
+//  test_overlay_widgets.cpp
+//  SuperTerminal Framework - Retained Overlay Widget Test
+//
+//  Headless checks for OverlayWidgetTree: an unchanged HUD repaints nothing,
+//  typical HUD updates (score text, health bar, moving and hiding panels)
+//  repaint only their own boxes, setters with unchanged values cause no
+//  damage, damage lists stay merged and capped, and every partial repaint
+//  leaves the canvas identical to a full redraw. A software painter counts
+//  the pixels each frame actually touches.
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "src/OverlayWidgetTree.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cout << "ERROR: " << #cond << " (line " << __LINE__ << ")" << std::endl; \
+            return false; \
+        } \
+    } while (0)
+
+static const int CANVAS_WIDTH = 1024;
+static const int CANVAS_HEIGHT = 768;
+static const int64_t CANVAS_AREA = (int64_t)CANVAS_WIDTH * CANVAS_HEIGHT;
+
+static uint32_t packColor(const OverlayWidgetColor& color) {
+    auto channel = [](float v) { return (uint32_t)(std::max(0.0f, std::min(1.0f, v)) * 255.0f); };
+    return channel(color.r) << 24 | channel(color.g) << 16 | channel(color.b) << 8 | channel(color.a);
+}
+
+// Flat-shaded stand-in for the Skia painter: every widget writes a value
+// derived from its content, so any missed repaint shows up as a pixel diff
+class CountingPainter : public OverlayWidgetPainter {
+public:
+    std::vector<uint32_t> pixels;
+    int64_t pixelsWritten = 0;
+
+    CountingPainter() : pixels((size_t)CANVAS_AREA, 0) {}
+
+    void beginRegion(const OverlayRect& region) override {
+        m_clip = region;
+        fill(region, 0);
+    }
+
+    void drawWidget(const OverlayWidget& widget) override {
+        OverlayRect box = widget.bounds;
+        switch (widget.kind) {
+            case OverlayWidgetKind::Panel: {
+                fill(box, packColor(widget.color));
+                if (widget.borderWidth > 0.0f) {
+                    int border = (int)widget.borderWidth;
+                    uint32_t edge = packColor(widget.backColor);
+                    fill({box.x, box.y, box.w, border}, edge);
+                    fill({box.x, box.y + box.h - border, box.w, border}, edge);
+                }
+                break;
+            }
+            case OverlayWidgetKind::Label: {
+                // Text covers a run of fixed-width cells inside the box
+                uint32_t ink = packColor(widget.color) ^ (uint32_t)std::hash<std::string>()(widget.text);
+                int textWidth = (int)(widget.text.size() * widget.fontSize * 0.6f);
+                fill(OverlayRect::covering(widget.worldX, widget.worldY, (float)textWidth, widget.fontSize)
+                         .intersect(box), ink);
+                break;
+            }
+            case OverlayWidgetKind::Bar: {
+                fill(box, packColor(widget.backColor));
+                float fx, fy, fw, fh;
+                OverlayWidgetTree::barFillExtent(widget, fx, fy, fw, fh);
+                fill(OverlayRect::covering(fx, fy, fw, fh).intersect(box), packColor(widget.color));
+                break;
+            }
+            case OverlayWidgetKind::Image:
+                fill(box, 0xA0000000u | widget.imageId);
+                break;
+        }
+    }
+
+    void endRegion() override {
+        m_clip = OverlayRect();
+    }
+
+private:
+    OverlayRect m_clip;
+
+    void fill(const OverlayRect& rect, uint32_t value) {
+        OverlayRect area = rect.intersect(m_clip);
+        for (int y = area.y; y < area.y + area.h; y++) {
+            for (int x = area.x; x < area.x + area.w; x++) {
+                pixels[(size_t)y * CANVAS_WIDTH + x] = value;
+            }
+        }
+        pixelsWritten += area.area();
+    }
+};
+
+// A typical HUD: top bar with score and lives, health bar, minimap, menu
+struct Hud {
+    OverlayWidgetTree tree{CANVAS_WIDTH, CANVAS_HEIGHT};
+    uint32_t topBar, score, lives, health, minimap, menu, menuTitle, menuItem;
+
+    Hud() {
+        topBar = tree.createPanel(0, 0, 0, CANVAS_WIDTH, 40);
+        tree.setColor(topBar, {0.1f, 0.1f, 0.2f, 0.8f});
+        tree.setBorderWidth(topBar, 2);
+        tree.setBackColor(topBar, {1.0f, 1.0f, 1.0f, 1.0f});
+        score = tree.createLabel(topBar, 10, 8, 200, 24, "SCORE 000000", 20);
+        lives = tree.createLabel(topBar, 824, 8, 190, 24, "LIVES 3", 20);
+        health = tree.createBar(topBar, 300, 12, 300, 16, 1.0f);
+        tree.setColor(health, {0.0f, 1.0f, 0.0f, 1.0f});
+        tree.setBackColor(health, {0.3f, 0.0f, 0.0f, 1.0f});
+        minimap = tree.createImage(0, 864, 608, 150, 150, 7);
+        menu = tree.createPanel(0, 312, 200, 400, 300);
+        tree.setColor(menu, {0.0f, 0.0f, 0.0f, 0.7f});
+        menuTitle = tree.createLabel(menu, 20, 20, 360, 32, "PAUSED", 28);
+        menuItem = tree.createLabel(menu, 20, 80, 360, 24, "Resume", 20);
+    }
+};
+
+// Replays the tree's current state into a fresh tree and paints it whole
+static bool matchesFullRedraw(OverlayWidgetTree& tree, const CountingPainter& partial) {
+    CountingPainter full;
+    OverlayWidgetTree fresh(CANVAS_WIDTH, CANVAS_HEIGHT);
+    std::vector<std::pair<uint32_t, uint32_t>> idMap;   // old -> new
+    auto mapped = [&](uint32_t oldId) -> uint32_t {
+        for (auto& entry : idMap) {
+            if (entry.first == oldId) {
+                return entry.second;
+            }
+        }
+        return 0;
+    };
+    // Ids grow with creation order, so parents always come first
+    for (uint32_t id = 1; id < 10000; id++) {
+        const OverlayWidget* w = tree.get(id);
+        if (!w) {
+            continue;
+        }
+        uint32_t copy = 0;
+        uint32_t parent = w->parent ? mapped(w->parent) : 0;
+        switch (w->kind) {
+            case OverlayWidgetKind::Panel:
+                copy = fresh.createPanel(parent, w->x, w->y, w->width, w->height);
+                break;
+            case OverlayWidgetKind::Label:
+                copy = fresh.createLabel(parent, w->x, w->y, w->width, w->height, w->text, w->fontSize);
+                break;
+            case OverlayWidgetKind::Bar:
+                copy = fresh.createBar(parent, w->x, w->y, w->width, w->height, w->value);
+                break;
+            case OverlayWidgetKind::Image:
+                copy = fresh.createImage(parent, w->x, w->y, w->width, w->height, w->imageId);
+                break;
+        }
+        fresh.setColor(copy, w->color);
+        fresh.setBackColor(copy, w->backColor);
+        fresh.setBorderWidth(copy, w->borderWidth);
+        fresh.setVertical(copy, w->vertical);
+        fresh.setVisible(copy, w->visible);
+        fresh.setZ(copy, w->z);
+        idMap.push_back({id, copy});
+    }
+    fresh.render(full);
+    return full.pixels == partial.pixels;
+}
+
+// Render one frame and return the pixels it touched
+static int64_t frame(OverlayWidgetTree& tree, CountingPainter& painter) {
+    painter.pixelsWritten = 0;
+    tree.render(painter);
+    return painter.pixelsWritten;
+}
+
+bool testStaticHud() {
+    std::cout << "Testing static HUD..." << std::endl;
+
+    Hud hud;
+    CountingPainter painter;
+    int64_t first = frame(hud.tree, painter);
+    CHECK(first > 0);
+    CHECK(hud.tree.getLastDrawCount() >= 8);
+    CHECK(matchesFullRedraw(hud.tree, painter));
+
+    // Nothing changed: no regions, no pixels
+    for (int i = 0; i < 60; i++) {
+        CHECK(frame(hud.tree, painter) == 0);
+        CHECK(hud.tree.getLastDrawCount() == 0);
+    }
+
+    // Setting the same values again is not a change
+    hud.tree.setText(hud.score, "SCORE 000000");
+    hud.tree.setValue(hud.health, 1.0f);
+    hud.tree.setPosition(hud.menu, 312, 200);
+    hud.tree.setColor(hud.menu, {0.0f, 0.0f, 0.0f, 0.7f});
+    hud.tree.setValue(hud.health, 5.0f);    // Clamped to the current 1.0
+    CHECK(!hud.tree.hasDamage());
+    CHECK(frame(hud.tree, painter) == 0);
+
+    std::cout << "  first frame " << first << " px, idle frames 0 px (immediate mode: "
+              << CANVAS_AREA << " px clear + redraw every frame)" << std::endl;
+    std::cout << "✅ Static HUD test passed!" << std::endl;
+    return true;
+}
+
+bool testTypicalUpdates() {
+    std::cout << "Testing typical HUD updates..." << std::endl;
+
+    Hud hud;
+    CountingPainter painter;
+    frame(hud.tree, painter);
+
+    // Score change repaints the label's box (and the panel behind it)
+    hud.tree.setText(hud.score, "SCORE 001250");
+    const std::vector<OverlayRect>& damage = hud.tree.collectDamage();
+    CHECK(damage.size() == 1);
+    CHECK(damage[0] == hud.tree.get(hud.score)->bounds);
+    int64_t scorePixels = frame(hud.tree, painter);
+    CHECK(hud.tree.getLastDamageArea() == 200 * 24);
+    CHECK(scorePixels < 4 * 200 * 24);
+    CHECK(matchesFullRedraw(hud.tree, painter));
+
+    // Health bar change repaints only the bar
+    hud.tree.setValue(hud.health, 0.35f);
+    int64_t healthPixels = frame(hud.tree, painter);
+    CHECK(hud.tree.getLastDamageArea() == 300 * 16);
+    CHECK(matchesFullRedraw(hud.tree, painter));
+
+    // Both in one frame: two separate regions, not their bounding box
+    hud.tree.setText(hud.score, "SCORE 001500");
+    hud.tree.setValue(hud.health, 0.30f);
+    int64_t bothPixels = frame(hud.tree, painter);
+    CHECK(hud.tree.getLastDamageArea() == 200 * 24 + 300 * 16);
+    CHECK(matchesFullRedraw(hud.tree, painter));
+
+    // Moving the menu damages where it was and where it is
+    hud.tree.setPosition(hud.menu, 332, 210);
+    int64_t movePixels = frame(hud.tree, painter);
+    CHECK(hud.tree.getLastDamageArea() <= 420 * 310);
+    CHECK(hud.tree.getLastDamageArea() >= 400 * 300);
+    CHECK(hud.tree.get(hud.menuTitle)->worldX == 352.0f);
+    CHECK(matchesFullRedraw(hud.tree, painter));
+
+    // Hiding the menu clears its box and hides its labels
+    hud.tree.setVisible(hud.menu, false);
+    int64_t hidePixels = frame(hud.tree, painter);
+    CHECK(hud.tree.getLastDamageArea() == 400 * 300);
+    CHECK(!hud.tree.get(hud.menuItem)->shown);
+    CHECK(matchesFullRedraw(hud.tree, painter));
+
+    // Content changes on hidden widgets cost nothing until shown
+    hud.tree.setText(hud.menuItem, "Quit");
+    CHECK(frame(hud.tree, painter) == 0);
+    hud.tree.setVisible(hud.menu, true);
+    frame(hud.tree, painter);
+    CHECK(matchesFullRedraw(hud.tree, painter));
+
+    // Removing a subtree clears it
+    hud.tree.remove(hud.menu);
+    CHECK(hud.tree.get(hud.menuTitle) == nullptr);
+    CHECK(hud.tree.getCount() == 5);
+    frame(hud.tree, painter);
+    CHECK(matchesFullRedraw(hud.tree, painter));
+
+    std::cout << "  score " << scorePixels << " px, health " << healthPixels << " px, both "
+              << bothPixels << " px, move " << movePixels << " px, hide " << hidePixels
+              << " px (full redraw " << CANVAS_AREA << " px)" << std::endl;
+    std::cout << "✅ Typical updates test passed!" << std::endl;
+    return true;
+}
+
+bool testOverlapAndZOrder() {
+    std::cout << "Testing overlap and z order..." << std::endl;
+
+    OverlayWidgetTree tree(CANVAS_WIDTH, CANVAS_HEIGHT);
+    CountingPainter painter;
+    uint32_t back = tree.createPanel(0, 100, 100, 200, 200);
+    tree.setColor(back, {1.0f, 0.0f, 0.0f, 1.0f});
+    uint32_t front = tree.createPanel(0, 150, 150, 200, 200);
+    tree.setColor(front, {0.0f, 0.0f, 1.0f, 1.0f});
+    uint32_t badge = tree.createImage(back, 20, 20, 64, 64, 3);
+    frame(tree, painter);
+    CHECK(painter.pixels[250 * CANVAS_WIDTH + 250] == packColor({0.0f, 0.0f, 1.0f, 1.0f}));
+
+    // Raising the back panel repaints only its box, and the overlap flips
+    tree.setZ(back, 1);
+    frame(tree, painter);
+    CHECK(tree.getLastDamageArea() == 200 * 200);
+    CHECK(painter.pixels[250 * CANVAS_WIDTH + 250] == packColor({1.0f, 0.0f, 0.0f, 1.0f}));
+    CHECK(matchesFullRedraw(tree, painter));
+
+    // Children follow their parent's visibility and position
+    tree.setPosition(back, 400, 400);
+    frame(tree, painter);
+    CHECK(tree.get(badge)->bounds == (OverlayRect{420, 420, 64, 64}));
+    CHECK(matchesFullRedraw(tree, painter));
+
+    // A child moving under an ancestor that moves in the same frame
+    tree.setPosition(badge, 0, 0);
+    tree.setPosition(back, 500, 300);
+    frame(tree, painter);
+    CHECK(tree.get(badge)->bounds == (OverlayRect{500, 300, 64, 64}));
+    CHECK(matchesFullRedraw(tree, painter));
+
+    // Off-canvas parts are clipped out of the damage
+    tree.setPosition(front, 950, 700);
+    frame(tree, painter);
+    CHECK(tree.get(front)->bounds == (OverlayRect{950, 700, 74, 68}));
+    CHECK(matchesFullRedraw(tree, painter));
+
+    // An image reloaded outside the tree
+    CHECK(tree.invalidate(badge));
+    frame(tree, painter);
+    CHECK(tree.getLastDamageArea() == 64 * 64);
+
+    // Unknown ids
+    CHECK(!tree.setText(999, "x"));
+    CHECK(tree.createLabel(999, 0, 0, 10, 10, "x", 10) == 0);
+    CHECK(!tree.remove(999));
+
+    std::cout << "✅ Overlap test passed!" << std::endl;
+    return true;
+}
+
+bool testDamageMerging() {
+    std::cout << "Testing damage merging..." << std::endl;
+
+    OverlayWidgetTree tree(CANVAS_WIDTH, CANVAS_HEIGHT);
+    CountingPainter painter;
+
+    // A row of adjacent digit cells merges into one strip
+    std::vector<uint32_t> digits;
+    for (int i = 0; i < 8; i++) {
+        digits.push_back(tree.createLabel(0, 10.0f + i * 12, 10, 12, 20, "0", 20));
+    }
+    frame(tree, painter);
+    for (uint32_t id : digits) {
+        tree.setText(id, "9");
+    }
+    const std::vector<OverlayRect>& strip = tree.collectDamage();
+    CHECK(strip.size() == 1);
+    CHECK(strip[0] == (OverlayRect{10, 10, 96, 20}));
+    frame(tree, painter);
+
+    // Far-apart updates stay separate
+    uint32_t a = tree.createPanel(0, 0, 700, 20, 20);
+    uint32_t b = tree.createPanel(0, 1000, 0, 20, 20);
+    CHECK(tree.collectDamage().size() == 2);
+    frame(tree, painter);
+
+    // Scattered updates are capped, wasting as little as possible
+    std::vector<uint32_t> dots;
+    for (int i = 0; i < 64; i++) {
+        dots.push_back(tree.createPanel(0, (float)((i * 149) % 1000), (float)(100 + (i * 89) % 600), 8, 8));
+    }
+    const std::vector<OverlayRect>& capped = tree.collectDamage();
+    size_t regionCount = capped.size();
+    CHECK(regionCount <= OverlayWidgetTree::MAX_DAMAGE_RECTS);
+    int64_t covered = 0;
+    for (const OverlayRect& rect : capped) {
+        covered += rect.area();
+    }
+    CHECK(covered < CANVAS_AREA);
+    frame(tree, painter);
+    CHECK(matchesFullRedraw(tree, painter));
+
+    // Resize and clear damage everything
+    tree.resize(CANVAS_WIDTH, CANVAS_HEIGHT);
+    CHECK(frame(tree, painter) > 0);
+    CHECK(tree.getLastDamageArea() == CANVAS_AREA);
+    tree.clear();
+    frame(tree, painter);
+    CHECK(std::all_of(painter.pixels.begin(), painter.pixels.end(), [](uint32_t p) { return p == 0; }));
+    CHECK(!tree.get(a) && !tree.get(b));
+
+    std::cout << "  64 scattered updates -> " << regionCount << " regions, " << covered << " px" << std::endl;
+    std::cout << "✅ Damage merging test passed!" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "SuperTerminal Overlay Widget Test" << std::endl;
+    std::cout << "=================================" << std::endl;
+
+    bool success = true;
+    success = testStaticHud() && success;
+    success = testTypicalUpdates() && success;
+    success = testOverlapAndZOrder() && success;
+    success = testDamageMerging() && success;
+
+    std::cout << (success ? "All overlay widget tests passed" : "Overlay widget tests FAILED") << std::endl;
+    return success ? 0 : 1;
+}
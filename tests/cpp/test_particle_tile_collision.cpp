@@ -0,0 +1,309 @@
+//
+//  test_particle_tile_collision.cpp
+//  SuperTerminal Framework - Particle vs Tilemap Collision Test
+//
+//  Headless checks for ParticleTileCollider: the grid walk finds the same
+//  first solid cell as brute-force sampling, bounce/stick/die responses and
+//  friction do what they say, bounced particles never end a step inside a
+//  solid cell, and particles starting inside geometry are left alone. A
+//  benchmark steps 50k particles over a dense 256x256 map to show the
+//  collision overhead per particle.
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "src/ParticleTileCollision.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cout << "ERROR: " << #cond << " (line " << __LINE__ << ")" << std::endl; \
+            return false; \
+        } \
+    } while (0)
+
+static const uint16_t ROCK = 5;
+static const uint16_t GRASS = 7;
+
+static std::vector<uint16_t> makeMap(int width, int height, float density, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<uint16_t> tiles((size_t)width * height);
+    for (uint16_t& tile : tiles) {
+        float roll = unit(rng);
+        tile = roll < density ? ROCK : (roll < density + 0.2f ? GRASS : 0);
+    }
+    return tiles;
+}
+
+bool testSweepMatchesSampling() {
+    std::cout << "Testing grid walk against sampling..." << std::endl;
+
+    std::vector<uint16_t> tiles = makeMap(16, 16, 0.3f, 1);
+    ParticleTileCollider collider;
+    collider.setSolid(ROCK, true);
+    collider.setGrid({tiles.data(), 16, 16, 32.0f, 40.0f, -24.0f});
+    CHECK(collider.isActive());
+    CHECK(!collider.isSolid(GRASS) && !collider.isSolid(0));
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> position(-80.0f, 560.0f);
+    std::uniform_real_distribution<float> offset(-100.0f, 100.0f);
+    int hits = 0;
+    for (int i = 0; i < 5000; i++) {
+        float x0 = position(rng), y0 = position(rng);
+        float x1 = x0 + offset(rng), y1 = y0 + offset(rng);
+
+        // Reference: first solid cell other than the start cell, sampled
+        // finely along the segment
+        int startX = (int)std::floor((x0 + 40.0f) / 32.0f);
+        int startY = (int)std::floor((y0 - 24.0f) / 32.0f);
+        bool expected = false;
+        int expectedX = 0, expectedY = 0;
+        float expectedT = 1.0f;
+        for (int s = 1; s <= 4000 && !expected; s++) {
+            float t = s / 4000.0f;
+            float x = x0 + (x1 - x0) * t, y = y0 + (y1 - y0) * t;
+            int cx = (int)std::floor((x + 40.0f) / 32.0f);
+            int cy = (int)std::floor((y - 24.0f) / 32.0f);
+            if ((cx != startX || cy != startY) && collider.isSolidAt(x, y)) {
+                expected = true;
+                expectedX = cx;
+                expectedY = cy;
+                expectedT = t;
+            }
+        }
+
+        TileHit hit;
+        bool found = collider.sweep(x0, y0, x1, y1, hit);
+        CHECK(found == expected);
+        if (found) {
+            hits++;
+            CHECK(hit.cellX == expectedX && hit.cellY == expectedY);
+            CHECK(hit.t <= expectedT + 0.001f);
+            CHECK(std::abs(hit.normalX) + std::abs(hit.normalY) == 1);
+            // Just outside the face, the contact point is in the previous cell
+            CHECK(!collider.isSolidAt(hit.x + hit.normalX * 0.01f, hit.y + hit.normalY * 0.01f) ||
+                  ((int)std::floor((hit.x + hit.normalX * 0.01f + 40.0f) / 32.0f) == startX &&
+                   (int)std::floor((hit.y + hit.normalY * 0.01f - 24.0f) / 32.0f) == startY));
+        }
+    }
+    std::cout << "  5000 segments, " << hits << " hits" << std::endl;
+    CHECK(hits > 500);
+
+    std::cout << "✅ Grid walk test passed!" << std::endl;
+    return true;
+}
+
+bool testResponses() {
+    std::cout << "Testing responses..." << std::endl;
+
+    // A floor of rock along row 2 of a 4x4 map of 10 px tiles
+    std::vector<uint16_t> tiles(16, 0);
+    for (int x = 0; x < 4; x++) {
+        tiles[2 * 4 + x] = ROCK;
+    }
+    ParticleTileCollider collider;
+    CHECK(!collider.isActive());
+    collider.setGrid({tiles.data(), 4, 4, 10.0f, 0.0f, 0.0f});
+    CHECK(!collider.isActive());        // No solid ids yet
+    collider.setSolid(ROCK, true);
+    collider.setSolid(0, true);         // Ignored: 0 is the empty cell
+    collider.setSolid(ParticleTileCollider::MAX_TILE_ID + 1, true);
+    CHECK(collider.getSolidCount() == 1);
+    CHECK(collider.isActive());
+
+    // Bounce: normal speed reflected by restitution, tangential by friction
+    collider.setFriction(0.25f);
+    float x = 15.0f, y = 25.0f, vx = 40.0f, vy = 100.0f;
+    CHECK(collider.resolve(15.0f, 15.0f, x, y, vx, vy, 0.5f) == TileCollisionResult::Bounced);
+    CHECK(std::fabs(y - (20.0f - ParticleTileCollider::CONTACT_OFFSET)) < 1e-4f);
+    CHECK(std::fabs(x - 15.0f) < 1e-4f);
+    CHECK(std::fabs(vy + 50.0f) < 1e-4f);
+    CHECK(std::fabs(vx - 30.0f) < 1e-4f);
+
+    // A slow bounce comes to rest
+    x = 12.0f; y = 21.0f; vx = 0.0f; vy = 3.0f;
+    CHECK(collider.resolve(12.0f, 19.99f, x, y, vx, vy, 0.5f) == TileCollisionResult::Bounced);
+    CHECK(vy == 0.0f);
+
+    // Stick
+    collider.setResponse(TileCollisionResponse::Stick);
+    x = 5.0f; y = 30.0f; vx = 10.0f; vy = 80.0f;
+    CHECK(collider.resolve(5.0f, 10.0f, x, y, vx, vy, 0.5f) == TileCollisionResult::Stuck);
+    CHECK(vx == 0.0f && vy == 0.0f);
+    CHECK(!collider.isSolidAt(x, y));
+
+    // Die
+    collider.setResponse(TileCollisionResponse::Die);
+    x = 5.0f; y = 30.0f; vx = 0.0f; vy = 80.0f;
+    CHECK(collider.resolve(5.0f, 10.0f, x, y, vx, vy, 0.5f) == TileCollisionResult::Died);
+
+    // No contact: nothing changes
+    x = 35.0f; y = 5.0f; vx = 1.0f; vy = 0.0f;
+    CHECK(collider.resolve(5.0f, 5.0f, x, y, vx, vy, 0.5f) == TileCollisionResult::None);
+    CHECK(x == 35.0f && vx == 1.0f);
+
+    // Starting inside rock: left alone while it stays in the same cell,
+    // and moving out of it is free
+    x = 15.0f; y = 26.0f;
+    CHECK(collider.resolve(15.0f, 25.0f, x, y, vx, vy, 0.5f) == TileCollisionResult::None);
+    x = 15.0f; y = 35.0f;
+    CHECK(collider.resolve(15.0f, 25.0f, x, y, vx, vy, 0.5f) == TileCollisionResult::None);
+
+    // Off the map is empty
+    x = 15.0f; y = 60.0f;
+    CHECK(collider.resolve(15.0f, 45.0f, x, y, vx, vy, 0.5f) == TileCollisionResult::None);
+
+    // Friction is clamped, and clearing solids turns collision off
+    collider.setFriction(3.0f);
+    CHECK(collider.getFriction() == 1.0f);
+    collider.setSolid(ROCK, false);
+    CHECK(collider.getSolidCount() == 0 && !collider.isActive());
+    collider.setSolid(ROCK, true);
+    collider.clearSolid();
+    CHECK(!collider.isActive());
+
+    std::cout << "✅ Response test passed!" << std::endl;
+    return true;
+}
+
+struct SimParticle {
+    float x, y, vx, vy;
+    bool active;
+    bool stuck;
+};
+
+static void spawn(std::vector<SimParticle>& particles, size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(100.0f, 16000.0f);
+    std::uniform_real_distribution<float> speed(-600.0f, 600.0f);
+    particles.resize(count);
+    for (SimParticle& p : particles) {
+        p = {position(rng), position(rng), speed(rng), speed(rng), true, false};
+    }
+}
+
+// Same integration as ParticleSystem::updateParticlePhysics, with the tile
+// pass the particle system runs after it
+static uint64_t step(std::vector<SimParticle>& particles, const ParticleTileCollider* collider,
+                     float deltaTime, size_t& insideAfterBounce) {
+    uint64_t hits = 0;
+    for (SimParticle& p : particles) {
+        if (!p.active || p.stuck) continue;
+        float x0 = p.x, y0 = p.y;
+        p.vy += 400.0f * deltaTime;
+        p.vx *= 0.995f;
+        p.vy *= 0.995f;
+        p.x += p.vx * deltaTime;
+        p.y += p.vy * deltaTime;
+        if (!collider) continue;
+
+        bool startedInside = collider->isSolidAt(x0, y0);
+        TileCollisionResult result = collider->resolve(x0, y0, p.x, p.y, p.vx, p.vy, 0.4f);
+        if (result != TileCollisionResult::None) {
+            hits++;
+            p.stuck = result == TileCollisionResult::Stuck;
+            p.active = result != TileCollisionResult::Died;
+            if (result == TileCollisionResult::Bounced && !startedInside && collider->isSolidAt(p.x, p.y)) {
+                insideAfterBounce++;
+            }
+        }
+    }
+    return hits;
+}
+
+bool testBouncedParticlesStayOut() {
+    std::cout << "Testing bounced particles stay out of solids..." << std::endl;
+
+    std::vector<uint16_t> tiles = makeMap(64, 64, 0.35f, 3);
+    ParticleTileCollider collider;
+    collider.setSolid(ROCK, true);
+    collider.setGrid({tiles.data(), 64, 64, 32.0f, 0.0f, 0.0f});
+
+    std::vector<SimParticle> particles;
+    spawn(particles, 4000, 11);
+    for (SimParticle& p : particles) {
+        p.x = std::fmod(p.x, 2048.0f);
+        p.y = std::fmod(p.y, 2048.0f);
+    }
+    size_t insideAfterBounce = 0;
+    uint64_t hits = 0;
+    for (int frame = 0; frame < 120; frame++) {
+        hits += step(particles, &collider, 1.0f / 60.0f, insideAfterBounce);
+    }
+
+    // Particles that spawned outside rock never got into it
+    size_t inside = 0;
+    std::vector<SimParticle> fresh;
+    spawn(fresh, 4000, 11);
+    for (size_t i = 0; i < particles.size(); i++) {
+        bool spawnedInside = collider.isSolidAt(std::fmod(fresh[i].x, 2048.0f), std::fmod(fresh[i].y, 2048.0f));
+        if (!spawnedInside && collider.isSolidAt(particles[i].x, particles[i].y)) {
+            inside++;
+        }
+    }
+    std::cout << "  4000 particles, 120 steps: " << hits << " hits, " << inside
+              << " ended inside rock" << std::endl;
+    CHECK(hits > 1000);
+    CHECK(insideAfterBounce == 0);
+    CHECK(inside == 0);
+
+    std::cout << "✅ Bounce containment test passed!" << std::endl;
+    return true;
+}
+
+bool testBenchmark() {
+    std::cout << "Testing collision overhead..." << std::endl;
+
+    const size_t count = 50000;
+    const int steps = 60;
+    std::vector<uint16_t> tiles = makeMap(256, 256, 0.35f, 5);
+    ParticleTileCollider collider;
+    collider.setSolid(ROCK, true);
+    collider.setGrid({tiles.data(), 256, 256, 64.0f, 0.0f, 0.0f});
+
+    auto run = [&](const ParticleTileCollider* active, uint64_t& hits) {
+        std::vector<SimParticle> particles;
+        spawn(particles, count, 21);
+        size_t insideAfterBounce = 0;
+        hits = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < steps; frame++) {
+            hits += step(particles, active, 1.0f / 60.0f, insideAfterBounce);
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / ((double)count * steps);
+    };
+
+    uint64_t noHits = 0, hits = 0;
+    double baseline = run(nullptr, noHits);
+    double colliding = run(&collider, hits);
+    std::cout << "  50000 particles, 256x256 map at 35% solid, 60 steps: "
+              << baseline << " ns/particle without collision, " << colliding
+              << " ns/particle with (+" << (colliding - baseline) << " ns), "
+              << hits << " hits" << std::endl;
+    CHECK(noHits == 0);
+    CHECK(hits > 0);
+
+    std::cout << "✅ Collision overhead test passed!" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "SuperTerminal Particle Tile Collision Test" << std::endl;
+    std::cout << "==========================================" << std::endl;
+
+    bool success = true;
+    success = testSweepMatchesSampling() && success;
+    success = testResponses() && success;
+    success = testBouncedParticlesStayOut() && success;
+    success = testBenchmark() && success;
+
+    std::cout << (success ? "All particle tile collision tests passed" : "Particle tile collision tests FAILED") << std::endl;
+    return success ? 0 : 1;
+}
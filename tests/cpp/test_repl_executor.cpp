@@ -0,0 +1,428 @@
+//
+//  test_repl_executor.cpp
+//  SuperTerminal Framework - Asynchronous REPL Test
+//
+//  Headless checks for ReplExecutor (ordering, streamed output, cancellation,
+//  type-ahead queue, output cap, shutdown with a stuck command) and a harness
+//  that drives the real ReplConsole against a stub text grid and a stub Lua
+//  runtime, measuring input-to-echo latency while a busy loop runs
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "src/ReplConsole.h"
+#include "src/ReplExecutor.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cout << "ERROR: " << #cond << " (line " << __LINE__ << ")" << std::endl; \
+            return false; \
+        } \
+    } while (0)
+
+using Clock = std::chrono::steady_clock;
+
+static double millisSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// =============================================================================
+// Stub text grid and Lua runtime for ReplConsole
+// =============================================================================
+
+static const int GRID_COLS = 80;
+static const int GRID_ROWS = 25;
+static std::vector<std::vector<std::string>> g_grid(GRID_ROWS, std::vector<std::string>(GRID_COLS, " "));
+static std::string g_last_error;
+
+static std::string gridRow(int y) {
+    std::string row;
+    for (const std::string& cell : g_grid[y]) row += cell;
+    return row;
+}
+
+static bool gridContains(const std::string& text) {
+    for (int y = 0; y < GRID_ROWS; y++) {
+        if (gridRow(y).find(text) != std::string::npos) return true;
+    }
+    return false;
+}
+
+extern "C" {
+    void editor_cls() {}
+    void editor_set_color(uint32_t, uint32_t) {}
+    void editor_background_color(uint32_t) {}
+    void layer_set_enabled(int, bool) {}
+    bool layer_is_enabled(int) { return true; }
+    void coretext_editor_set_viewport(int, int) {}
+    int text_mode_get_rows(void) { return GRID_ROWS; }
+    void text_grid_get_dimensions(int* width, int* height) { *width = GRID_COLS; *height = GRID_ROWS; }
+
+    void editor_print_at(int x, int y, const char* text) {
+        if (y < 0 || y >= GRID_ROWS) return;
+        for (const char* p = text; *p && x < GRID_COLS; x++) {
+            int length = 1;
+            unsigned char lead = static_cast<unsigned char>(*p);
+            if (lead >= 0xF0) length = 4;
+            else if (lead >= 0xE0) length = 3;
+            else if (lead >= 0xC0) length = 2;
+            if (x >= 0) g_grid[y][x].assign(p, length);
+            p += length;
+        }
+    }
+
+    typedef void (*lua_gcd_repl_output_fn)(const char* line, void* context);
+    typedef bool (*lua_gcd_repl_cancel_fn)(void* context);
+
+    // Understands three statements: busy() spins until cancelled,
+    // print('text') streams a line and error('text') fails
+    bool lua_gcd_exec_repl_streaming(const char* lua_code, lua_gcd_repl_output_fn output,
+                                     lua_gcd_repl_cancel_fn should_cancel, void* context) {
+        std::string code(lua_code);
+        if (code.find("busy()") != std::string::npos) {
+            auto start = Clock::now();
+            while (!should_cancel(context)) {
+                if (millisSince(start) > 5000) {
+                    g_last_error = "busy() was never cancelled";
+                    return false;
+                }
+            }
+            g_last_error = "REPL command cancelled";
+            return false;
+        }
+        size_t pos = 0;
+        while ((pos = code.find("print('", pos)) != std::string::npos) {
+            size_t end = code.find("')", pos);
+            output(code.substr(pos + 7, end - pos - 7).c_str(), context);
+            pos = end;
+        }
+        size_t err = code.find("error('");
+        if (err != std::string::npos) {
+            g_last_error = code.substr(err + 7, code.find("')", err) - err - 7);
+            return false;
+        }
+        return true;
+    }
+
+    const char* lua_gcd_get_last_error() { return g_last_error.c_str(); }
+    void lua_gcd_reset_repl() {}
+}
+
+// =============================================================================
+// ReplExecutor
+// =============================================================================
+
+static std::vector<ReplEvent> drainUntilIdle(ReplExecutor& executor) {
+    std::vector<ReplEvent> events;
+    executor.waitIdle(5000);
+    executor.poll(events);
+    return events;
+}
+
+bool testOrderingAndOutput() {
+    std::cout << "Testing ordering and streamed output..." << std::endl;
+
+    ReplExecutor executor([](const std::string& code, ReplExecutor::Context& context) {
+        context.emit(code + " line 1\n" + code + " line 2\n");
+        if (code == "bad") {
+            context.setError("bad command");
+            return false;
+        }
+        return true;
+    });
+
+    uint64_t a = executor.submit("a");
+    uint64_t b = executor.submit("bad");
+    uint64_t c = executor.submit("c");
+    CHECK(a != 0 && b == a + 1 && c == b + 1);
+
+    std::vector<ReplEvent> events = drainUntilIdle(executor);
+    CHECK(events.size() == 12);
+    for (int i = 0; i < 3; i++) {
+        const ReplEvent* e = &events[i * 4];
+        uint64_t id = a + i;
+        CHECK(e[0].type == ReplEventType::Started && e[0].commandId == id);
+        CHECK(e[1].type == ReplEventType::Output && e[1].commandId == id);
+        CHECK(e[2].type == ReplEventType::Output && e[2].text.find("line 2") != std::string::npos);
+        CHECK(e[3].type == ReplEventType::Finished && e[3].commandId == id);
+        CHECK(!e[3].cancelled);
+    }
+    CHECK(events[1].text == "a line 1");        // Trailing newline adds no empty line
+    CHECK(events[3].success && events[11].success);
+    CHECK(!events[7].success && events[7].text == "bad command");
+
+    std::cout << "✅ ordering and streamed output passed!" << std::endl;
+    return true;
+}
+
+bool testStreamingAndCancel() {
+    std::cout << "Testing streaming while running and cancellation..." << std::endl;
+
+    std::atomic<int> iterations{0};
+    ReplExecutor executor([&](const std::string& code, ReplExecutor::Context& context) {
+        if (code != "spin") {
+            context.emit("ran " + code);
+            return true;
+        }
+        context.emit("spinning");
+        while (!context.isCancelled()) {
+            iterations++;
+        }
+        context.setError("cancelled");
+        return false;
+    });
+
+    CHECK(!executor.cancel());                  // Idle: nothing to interrupt
+    uint64_t spin = executor.submit("spin");
+    uint64_t after = executor.submit("after");
+
+    // Output arrives while the command is still running
+    std::vector<ReplEvent> events;
+    auto start = Clock::now();
+    while (events.size() < 2 && millisSince(start) < 2000) {
+        executor.poll(events);
+    }
+    CHECK(events.size() == 2);
+    CHECK(events[1].type == ReplEventType::Output && events[1].text == "spinning");
+    CHECK(executor.isRunning() && executor.getRunningId() == spin);
+    CHECK(executor.getQueuedCount() == 1);
+
+    auto cancelAt = Clock::now();
+    CHECK(executor.cancel());
+    events.clear();
+    double cancelMs = 0.0;
+    while (millisSince(cancelAt) < 2000 && cancelMs == 0.0) {
+        executor.poll(events);
+        for (const ReplEvent& event : events) {
+            if (event.type == ReplEventType::Finished && event.commandId == spin) cancelMs = millisSince(cancelAt);
+        }
+    }
+    CHECK(cancelMs > 0.0);
+    CHECK(events[0].type == ReplEventType::Finished && events[0].commandId == spin);
+    CHECK(events[0].cancelled && !events[0].success);
+    CHECK(iterations.load() > 0);
+
+    // The queued command still runs and is not affected by the earlier cancel
+    executor.waitIdle(5000);
+    executor.poll(events);
+    CHECK(events.size() == 4);
+    CHECK(events[1].commandId == after && events[2].text == "ran after");
+    CHECK(events[3].success && !events[3].cancelled);
+
+    std::cout << "  cancel to finished: " << cancelMs << " ms" << std::endl;
+    std::cout << "✅ streaming and cancellation passed!" << std::endl;
+    return true;
+}
+
+bool testQueueLimitsAndCancelAll() {
+    std::cout << "Testing type-ahead queue limits and cancel-all..." << std::endl;
+
+    ReplExecutor executor([](const std::string&, ReplExecutor::Context& context) {
+        while (!context.isCancelled()) {
+            std::this_thread::yield();
+        }
+        return false;
+    }, 4);
+
+    uint64_t first = executor.submit("1");
+    auto start = Clock::now();
+    while (!executor.isRunning() && millisSince(start) < 2000) {
+        std::this_thread::yield();
+    }
+    CHECK(executor.isRunning());
+    for (int i = 0; i < 4; i++) {
+        CHECK(executor.submit("queued") != 0);
+    }
+    CHECK(executor.submit("overflow") == 0);    // Bounded queue
+    CHECK(executor.getQueuedCount() == 4);
+
+    CHECK(executor.cancelAll() == 4);
+    std::vector<ReplEvent> events = drainUntilIdle(executor);
+    int cancelled = 0;
+    bool firstCancelled = false;
+    for (const ReplEvent& event : events) {
+        if (event.type == ReplEventType::Finished && event.cancelled) {
+            cancelled++;
+            if (event.commandId == first) firstCancelled = true;
+        }
+    }
+    CHECK(cancelled == 5 && firstCancelled);
+    CHECK(executor.getQueuedCount() == 0 && !executor.isRunning());
+
+    std::cout << "✅ queue limits and cancel-all passed!" << std::endl;
+    return true;
+}
+
+bool testOutputCap() {
+    std::cout << "Testing pending output cap..." << std::endl;
+
+    const size_t lines = ReplExecutor::MAX_PENDING_EVENTS + 500;
+    ReplExecutor executor([&](const std::string&, ReplExecutor::Context& context) {
+        for (size_t i = 0; i < lines; i++) {
+            context.emit("line " + std::to_string(i));
+        }
+        return true;
+    });
+
+    executor.submit("flood");
+    std::vector<ReplEvent> events = drainUntilIdle(executor);
+    CHECK(executor.getDroppedOutputLines() > 0);
+    CHECK(events.size() <= ReplExecutor::MAX_PENDING_EVENTS + 2);
+    CHECK(events.back().type == ReplEventType::Finished && events.back().success);
+    const ReplEvent& notice = events[events.size() - 2];
+    CHECK(notice.text == "... " + std::to_string(executor.getDroppedOutputLines()) + " output lines dropped");
+
+    std::cout << "✅ pending output cap passed!" << std::endl;
+    return true;
+}
+
+bool testShutdownWithStuckCommand() {
+    std::cout << "Testing shutdown with a command that ignores cancellation..." << std::endl;
+
+    auto start = Clock::now();
+    {
+        ReplExecutor executor([](const std::string&, ReplExecutor::Context&) {
+            std::this_thread::sleep_for(std::chrono::seconds(3));
+            return true;
+        });
+        executor.submit("blocked");
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    double shutdownMs = millisSince(start);
+    std::cout << "  destroyed after " << shutdownMs << " ms" << std::endl;
+    CHECK(shutdownMs < 2000);
+
+    // A cooperative command is interrupted and joined promptly
+    start = Clock::now();
+    {
+        ReplExecutor executor([](const std::string&, ReplExecutor::Context& context) {
+            while (!context.isCancelled()) {
+                std::this_thread::yield();
+            }
+            return false;
+        });
+        executor.submit("spin");
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    CHECK(millisSince(start) < 500);
+
+    std::cout << "✅ shutdown passed!" << std::endl;
+    return true;
+}
+
+// =============================================================================
+// ReplConsole harness
+// =============================================================================
+
+static const int KEY_RETURN = 0x24;
+static const int KEY_C = 0x08;
+static const int MOD_CTRL = 0x40000;
+static const int MOD_SHIFT = 0x20000;
+
+static void typeText(ReplConsole& console, const std::string& text) {
+    for (char ch : text) console.handle_character_input(ch);
+}
+
+static bool waitForGrid(ReplConsole& console, const std::string& text, int timeoutMs) {
+    auto start = Clock::now();
+    while (millisSince(start) < timeoutMs) {
+        console.update(0.001f);
+        if (gridContains(text)) return true;
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    return false;
+}
+
+bool testConsoleEchoWhileBusy() {
+    std::cout << "Testing console input-to-echo latency while a busy loop runs..." << std::endl;
+
+    ReplConsole console;
+    CHECK(console.initialize());
+    console.activate();
+
+    // Start a command that never yields on its own
+    typeText(console, "busy()");
+    console.handle_key_input(KEY_RETURN, MOD_CTRL);
+    CHECK(console.get_current_input().empty());     // Input returned immediately
+    CHECK(waitForGrid(console, "Running", 2000));
+    CHECK(console.is_busy());
+
+    // Keystroke -> visible on the input row, one frame each
+    std::vector<double> latencies;
+    int inputRow = GRID_ROWS - 1 - 1;               // Row above the bottom border
+    for (int i = 0; i < 200; i++) {
+        char ch = static_cast<char>('a' + i % 26);
+        auto start = Clock::now();
+        console.handle_character_input(ch);
+        console.update(0.001f);
+        latencies.push_back(millisSince(start));
+        std::string row = gridRow(inputRow);
+        CHECK(row.find("lua> ") != std::string::npos);
+        if (i < 40) {
+            CHECK(row.find(console.get_current_input()) != std::string::npos);
+        }
+    }
+
+    // Typed-ahead command is echoed at once and queued behind the busy loop
+    std::string input = console.get_current_input();
+    for (size_t i = 0; i < input.size(); i++) console.handle_key_input(0x33, 0);   // Backspace
+    typeText(console, "print('typed ahead')");
+    auto submitAt = Clock::now();
+    console.handle_key_input(KEY_RETURN, MOD_CTRL);
+    console.update(0.001f);
+    double echoMs = millisSince(submitAt);
+    CHECK(gridContains("lua> print('typed ahead')"));
+    CHECK(gridContains("(1 queued)"));
+    CHECK(!gridContains("│ typed ahead"));
+
+    // Ctrl+C interrupts the busy loop; the queued command then streams its output
+    auto cancelAt = Clock::now();
+    console.handle_key_input(KEY_C, MOD_CTRL);
+    CHECK(waitForGrid(console, " typed ahead", 2000));
+    double cancelMs = millisSince(cancelAt);
+    CHECK(waitForGrid(console, " OK ", 2000));
+    CHECK(!console.is_busy());
+
+    // Errors land in the status line; Ctrl+Shift+C with nothing running is a no-op
+    typeText(console, "error('boom')");
+    console.handle_key_input(KEY_RETURN, MOD_CTRL);
+    CHECK(waitForGrid(console, "Error: boom", 2000));
+    CHECK(!console.cancel_running_command(true));
+    console.handle_key_input(KEY_C, MOD_CTRL | MOD_SHIFT);
+
+    console.shutdown();
+
+    std::sort(latencies.begin(), latencies.end());
+    double p50 = latencies[latencies.size() / 2];
+    double p99 = latencies[latencies.size() * 99 / 100];
+    std::cout << "  keystroke to echo while busy: p50 " << p50 << " ms, p99 " << p99 << " ms, max "
+              << latencies.back() << " ms" << std::endl;
+    std::cout << "  submit to echo " << echoMs << " ms, Ctrl+C to queued output " << cancelMs << " ms" << std::endl;
+    CHECK(p99 < 16.0);                              // Well inside one 60 Hz frame
+
+    std::cout << "✅ console echo while busy passed!" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "SuperTerminal REPL Executor Test" << std::endl;
+    std::cout << "================================" << std::endl;
+
+    bool success = true;
+    success = testOrderingAndOutput() && success;
+    success = testStreamingAndCancel() && success;
+    success = testQueueLimitsAndCancelAll() && success;
+    success = testOutputCap() && success;
+    success = testShutdownWithStuckCommand() && success;
+    success = testConsoleEchoWhileBusy() && success;
+
+    std::cout << (success ? "All REPL executor tests passed" : "REPL executor tests FAILED") << std::endl;
+    return success ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+//
+//  test_scrollback_index.cpp
+//  SuperTerminal Framework - Scrollback Search Index Test
+//
+//  Headless checks for ScrollbackIndex: find-next/find-all, dirty refresh
+//  and correctness across ring-buffer wraparound
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "src/ScrollbackIndex.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cout << "ERROR: " << #cond << " (line " << __LINE__ << ")" << std::endl; \
+            return false; \
+        } \
+    } while (0)
+
+bool testFindNextAndAll() {
+    std::cout << "Testing find-next / find-all..." << std::endl;
+
+    ScrollbackIndex index(100);
+    index.appendLine("hello world");
+    index.appendLine("nothing here");
+    index.appendLine("Hello again, world of worlds");
+
+    ScrollbackMatch match;
+    CHECK(index.findNext("world", 0, 0, false, false, match));
+    CHECK(match.line == 0 && match.column == 6 && match.length == 5);
+
+    CHECK(index.findNext("world", 0, 7, false, false, match));
+    CHECK(match.line == 2 && match.column == 13);
+
+    // Wrap back to the top from the last match
+    CHECK(index.findNext("world", 2, 23, false, true, match));
+    CHECK(match.line == 0 && match.column == 6);
+
+    CHECK(!index.findNext("hello", 1, 0, false, false, match));
+    CHECK(index.findNext("hello", 1, 0, true, false, match));
+    CHECK(match.line == 2 && match.column == 0);
+
+    CHECK(index.findPrevious("world", 2, 13, false, false, match));
+    CHECK(match.line == 0 && match.column == 6);
+
+    std::vector<ScrollbackMatch> all = index.findAll("world", false);
+    CHECK(all.size() == 3);
+    CHECK(all[2].line == 2 && all[2].column == 22);
+
+    CHECK(index.findAll("o", false).size() == 7);
+    CHECK(index.findAll("zebra", false).empty());
+
+    std::cout << "✅ find-next / find-all test passed!" << std::endl;
+    return true;
+}
+
+bool testWraparound() {
+    std::cout << "Testing ring-buffer wraparound..." << std::endl;
+
+    ScrollbackIndex index(50);
+    for (int i = 0; i < 500; i++) {
+        index.appendLine("line " + std::to_string(i) + " marker" + std::to_string(i % 7));
+    }
+    CHECK(index.lineCount() == 50);
+    CHECK(index.lineText(0) == "line 450 marker2");
+
+    // Dropped lines must never surface, retained ones are renumbered
+    ScrollbackMatch match;
+    CHECK(!index.findNext("line 449 ", 0, 0, false, true, match));
+    CHECK(index.findNext("line 451 ", 0, 0, false, true, match));
+    CHECK(match.line == 1);
+
+    // Terminal-style bulk discard followed by in-place rewrites
+    index.dropFront(20);
+    CHECK(index.lineCount() == 30);
+    index.setLine(0, "rewritten needle");
+    std::vector<ScrollbackMatch> all = index.findAll("needle", false);
+    CHECK(all.size() == 1 && all[0].line == 0 && all[0].column == 10);
+    CHECK(index.findAll("line 470 ", false).empty());
+    CHECK(index.findAll("marker3", false).size() == 4);
+
+    // Stale postings are compacted rather than growing without bound
+    for (int i = 0; i < 20000; i++) {
+        index.setLine(i % 30, "churn " + std::to_string(i));
+    }
+    CHECK(index.postingCount() < 30 * 16 * 2 + 4096 + 64);
+
+    std::cout << "✅ wraparound test passed!" << std::endl;
+    return true;
+}
+
+bool testDirtyRefreshAndUnicode() {
+    std::cout << "Testing dirty refresh with codepoint grid..." << std::endl;
+
+    const int width = 16;
+    std::vector<uint32_t> grid(width * 4, 0);
+    const uint32_t row1[] = { 0x2588, 'a', 'b', 'c', 0x00E9, 'x', 'y', 'z' };
+    for (int i = 0; i < 8; i++) grid[width + i] = row1[i];
+
+    ScrollbackIndex index(4);
+    index.markDirty(1);
+    CHECK(index.hasDirtyLines());
+    index.refreshDirty([&](int line) {
+        index.setLineCodepoints(line, &grid[line * width], width);
+    });
+    CHECK(!index.hasDirtyLines());
+
+    ScrollbackMatch match;
+    CHECK(index.findNext("\xC3\xA9xyz", 0, 0, false, false, match));
+    CHECK(match.line == 1 && match.column == 4 && match.length == 4);
+
+    // A discarded dirty line must not be refreshed
+    index.markDirty(0);
+    index.dropFront(1);
+    int refreshed = 0;
+    index.refreshDirty([&](int) { refreshed++; });
+    CHECK(refreshed == 0);
+
+    std::cout << "✅ dirty refresh test passed!" << std::endl;
+    return true;
+}
+
+bool benchmarkSearch() {
+    std::cout << "Benchmarking indexed search..." << std::endl;
+
+    ScrollbackIndex index(2000);
+    for (int i = 0; i < 2000; i++) {
+        std::string line;
+        for (int w = 0; w < 16; w++) {
+            line += "word" + std::to_string((i * 31 + w * 7) % 997) + " ";
+        }
+        index.appendLine(line);
+    }
+    index.setLine(1500, "the unique needle lives here");
+
+    auto start = std::chrono::high_resolution_clock::now();
+    int found = 0;
+    for (int i = 0; i < 1000; i++) {
+        ScrollbackMatch match;
+        if (index.findNext("unique needle", 0, 0, false, true, match)) found++;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double us = std::chrono::duration<double, std::micro>(end - start).count() / 1000.0;
+
+    CHECK(found == 1000);
+    std::cout << "  find-next over 2000 lines: " << us << " us/query" << std::endl;
+    std::cout << "✅ benchmark complete" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "SuperTerminal Scrollback Index Test" << std::endl;
+    std::cout << "===================================" << std::endl;
+
+    bool success = true;
+    success = testFindNextAndAll() && success;
+    success = testWraparound() && success;
+    success = testDirtyRefreshAndUnicode() && success;
+    success = benchmarkSearch() && success;
+
+    std::cout << (success ? "All scrollback index tests passed" : "Scrollback index tests FAILED") << std::endl;
+    return success ? 0 : 1;
+}
@@ -0,0 +1,319 @@
+//
+//  test_sprite_animation.cpp
+//  SuperTerminal Framework - Atlas Sprite Animation Test
+//
+//  Headless checks for SpriteAtlas and SpriteAnimator: grid UVs, loop, once
+//  and ping-pong sequencing, frame/loop/finished events, large time steps,
+//  reverse ranges, clip redefinition, and a many-sprite update benchmark
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "src/SpriteAnimation.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cout << "ERROR: " << #cond << " (line " << __LINE__ << ")" << std::endl; \
+            return false; \
+        } \
+    } while (0)
+
+static bool near(float a, float b) {
+    return std::fabs(a - b) < 1e-6f;
+}
+
+// 4x2 grid of 32x32 frames in a 128x64 texture
+static SpriteAnimator makeAnimator() {
+    SpriteAnimator animator;
+    SpriteAtlas atlas(128, 64);
+    atlas.addGrid(32, 32);
+    animator.defineAtlas(1, atlas);
+    return animator;
+}
+
+static int countEvents(const SpriteAnimator& animator, AnimationEventType type) {
+    int count = 0;
+    for (const AnimationEvent& event : animator.getEvents()) {
+        if (event.type == type) count++;
+    }
+    return count;
+}
+
+bool testAtlasGrid() {
+    std::cout << "Testing atlas grid frames..." << std::endl;
+
+    SpriteAtlas atlas(128, 64);
+    CHECK(atlas.addGrid(32, 32) == 8);
+    CHECK(atlas.getFrameCount() == 8);
+
+    const AtlasFrame& first = atlas.getFrame(0);
+    CHECK(near(first.u0, 0.0f) && near(first.v0, 0.0f));
+    CHECK(near(first.u1, 0.25f) && near(first.v1, 0.5f));
+    CHECK(first.width == 32 && first.height == 32);
+
+    // Row-major: frame 5 is column 1 of row 1
+    const AtlasFrame& fifth = atlas.getFrame(5);
+    CHECK(near(fifth.u0, 0.25f) && near(fifth.v0, 0.5f));
+
+    // Margin and spacing shrink the grid
+    SpriteAtlas padded(100, 34);
+    CHECK(padded.addGrid(30, 30, 2, 2) == 3);
+    CHECK(near(padded.getFrame(1).u0, 34.0f / 100.0f));
+
+    CHECK(atlas.addFrame(120, 0, 16, 16) == -1);
+    CHECK(atlas.addFrame(96, 32, 32, 32) == 8);
+
+    std::cout << "✅ Atlas grid test passed!" << std::endl;
+    return true;
+}
+
+bool testLoopSequencing() {
+    std::cout << "Testing loop sequencing and events..." << std::endl;
+
+    SpriteAnimator animator = makeAnimator();
+    CHECK(animator.defineClip(10, 1, 0, 3, 0.1f, AnimationPlayMode::Loop));
+    CHECK(animator.addClipEvent(10, 2, 77));
+    CHECK(!animator.defineClip(11, 1, 0, 8, 0.1f, AnimationPlayMode::Loop));
+    CHECK(!animator.defineClip(11, 2, 0, 1, 0.1f, AnimationPlayMode::Loop));
+
+    CHECK(animator.play(5, 10));
+    CHECK(animator.isPlaying(5));
+
+    // First update reports the starting frame even with no time passing
+    animator.update(0.0f);
+    CHECK(animator.getFrameChanges().size() == 1);
+    CHECK(animator.getFrameChanges()[0].spriteId == 5);
+    CHECK(animator.getFrameChanges()[0].atlasFrame == 0);
+
+    // Frames advance on duration boundaries; unchanged frames are not reported
+    animator.update(0.05f);
+    CHECK(animator.getFrameChanges().empty());
+    animator.update(0.06f);
+    CHECK(animator.getClipFrame(5) == 1);
+    CHECK(animator.getFrameChanges().size() == 1);
+
+    animator.update(0.1f);
+    CHECK(animator.getClipFrame(5) == 2);
+    CHECK(animator.getEvents().size() == 1);
+    CHECK(animator.getEvents()[0].type == AnimationEventType::Frame);
+    CHECK(animator.getEvents()[0].eventId == 77);
+
+    animator.update(0.1f);
+    animator.update(0.1f);
+    CHECK(animator.getClipFrame(5) == 0);
+    CHECK(countEvents(animator, AnimationEventType::Loop) == 1);
+
+    // Per-frame durations
+    CHECK(animator.setFrameDuration(10, 0, 0.5f));
+    animator.update(0.2f);
+    CHECK(animator.getClipFrame(5) == 0);
+    animator.update(0.31f);
+    CHECK(animator.getClipFrame(5) == 1);
+
+    std::cout << "✅ Loop sequencing test passed!" << std::endl;
+    return true;
+}
+
+bool testOnceAndPingPong() {
+    std::cout << "Testing once and ping-pong modes..." << std::endl;
+
+    SpriteAnimator animator = makeAnimator();
+    CHECK(animator.defineClip(1, 1, 4, 6, 0.1f, AnimationPlayMode::Once));
+    CHECK(animator.defineClip(2, 1, 0, 3, 0.1f, AnimationPlayMode::PingPong));
+
+    animator.play(1, 1);
+    animator.update(0.0f);
+    animator.update(0.25f);
+    CHECK(animator.getAtlasFrame(1) == 6);
+    CHECK(animator.isPlaying(1));
+    animator.update(0.1f);
+    CHECK(!animator.isPlaying(1));
+    CHECK(animator.getAtlasFrame(1) == 6);
+    CHECK(countEvents(animator, AnimationEventType::Finished) == 1);
+    animator.update(1.0f);
+    CHECK(animator.getEvents().empty());
+
+    // Playing a finished clip again restarts it even without restart
+    CHECK(animator.play(1, 1, 1.0f, false));
+    CHECK(animator.getClipFrame(1) == 0 && animator.isPlaying(1));
+
+    // 0 1 2 3 2 1 0 1 ...
+    animator.play(2, 2);
+    animator.update(0.0f);
+    std::vector<int> sequence;
+    int loops = 0;
+    for (int i = 0; i < 8; i++) {
+        animator.update(0.1f);
+        sequence.push_back(animator.getClipFrame(2));
+        loops += countEvents(animator, AnimationEventType::Loop);
+    }
+    CHECK((sequence == std::vector<int>{1, 2, 3, 2, 1, 0, 1, 2}));
+    CHECK(loops == 1);
+
+    std::cout << "✅ Once and ping-pong test passed!" << std::endl;
+    return true;
+}
+
+bool testLargeTimeStep() {
+    std::cout << "Testing large time steps..." << std::endl;
+
+    SpriteAnimator animator = makeAnimator();
+    CHECK(animator.defineClip(1, 1, 0, 3, 0.1f, AnimationPlayMode::Loop));
+    CHECK(animator.defineClip(2, 1, 0, 3, 0.1f, AnimationPlayMode::PingPong));
+    animator.play(1, 1);
+    animator.play(2, 2);
+    animator.update(0.0f);
+
+    // An hour in one call lands where stepping would and stays cheap
+    auto start = std::chrono::steady_clock::now();
+    animator.update(3600.05f);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    CHECK(ms < 50.0);
+
+    SpriteAnimator stepped = makeAnimator();
+    stepped.defineClip(1, 1, 0, 3, 0.1f, AnimationPlayMode::Loop);
+    stepped.defineClip(2, 1, 0, 3, 0.1f, AnimationPlayMode::PingPong);
+    stepped.play(1, 1);
+    stepped.play(2, 2);
+    for (int i = 0; i < 2500; i++) stepped.update(0.1f);
+
+    // 2500 frames: loop of 4 -> 0, ping-pong cycle of 6 -> position 4 (frame 2)
+    CHECK(stepped.getClipFrame(1) == 0);
+    CHECK(stepped.getClipFrame(2) == 2);
+
+    // 3600.05s: whole loop (0.4s) and ping-pong (0.6s) cycles plus 0.05s
+    CHECK(animator.getClipFrame(1) == 0);
+    CHECK(animator.getClipFrame(2) == 0);
+    std::cout << "  1 hour update: " << ms << " ms" << std::endl;
+
+    std::cout << "✅ Large time step test passed!" << std::endl;
+    return true;
+}
+
+bool testReverseRestartAndRedefine() {
+    std::cout << "Testing reverse ranges, restart and redefinition..." << std::endl;
+
+    SpriteAnimator animator = makeAnimator();
+    CHECK(animator.defineClip(1, 1, 3, 0, 0.1f, AnimationPlayMode::Loop));
+    CHECK(animator.getClipLength(1) == 4);
+    animator.play(7, 1);
+    animator.update(0.0f);
+    CHECK(animator.getAtlasFrame(7) == 3);
+    animator.update(0.1f);
+    CHECK(animator.getAtlasFrame(7) == 2);
+
+    // restart = false keeps the position, restart = true rewinds
+    animator.play(7, 1, 2.0f, false);
+    CHECK(animator.getAtlasFrame(7) == 2);
+    animator.update(0.05f);
+    CHECK(animator.getAtlasFrame(7) == 1);
+    animator.play(7, 1);
+    CHECK(animator.getClipFrame(7) == 0);
+
+    // Redefining the clip restarts sprites that play it
+    animator.update(0.15f);
+    CHECK(animator.defineClip(1, 1, 4, 7, 0.1f, AnimationPlayMode::Loop));
+    animator.update(0.0f);
+    CHECK(animator.getAtlasFrame(7) == 4);
+    CHECK(animator.getFrameChanges().size() == 1);
+
+    // Pause and speed
+    CHECK(animator.setPaused(7, true));
+    CHECK(!animator.isPlaying(7));
+    animator.update(1.0f);
+    CHECK(animator.getAtlasFrame(7) == 4);
+    CHECK(animator.setPaused(7, false));
+    CHECK(animator.setSpeed(7, 0.5f));
+    animator.update(0.15f);
+    CHECK(animator.getAtlasFrame(7) == 4);
+    animator.update(0.06f);
+    CHECK(animator.getAtlasFrame(7) == 5);
+
+    CHECK(animator.removeClip(1));
+    CHECK(animator.getClipFrame(7) == -1);
+    CHECK(!animator.play(7, 1));
+
+    std::cout << "✅ Reverse, restart and redefine test passed!" << std::endl;
+    return true;
+}
+
+bool testStopAndSlots() {
+    std::cout << "Testing stop and instance slots..." << std::endl;
+
+    SpriteAnimator animator = makeAnimator();
+    animator.defineClip(1, 1, 0, 3, 0.1f, AnimationPlayMode::Loop);
+    animator.defineClip(2, 1, 4, 7, 0.1f, AnimationPlayMode::Loop);
+    for (uint16_t sprite = 1; sprite <= 5; sprite++) {
+        animator.play(sprite, sprite % 2 ? 1 : 2);
+    }
+    CHECK(animator.getInstanceCount() == 5);
+
+    // Removing from the middle moves the last instance into the hole
+    CHECK(animator.stop(2));
+    CHECK(!animator.stop(2));
+    CHECK(animator.getInstanceCount() == 4);
+    CHECK(animator.getClipFrame(2) == -1);
+    animator.update(0.1f);
+    CHECK(animator.getAtlasFrame(5) == 1);
+    CHECK(animator.getAtlasFrame(4) == 5);
+
+    animator.clearInstances();
+    CHECK(animator.getInstanceCount() == 0);
+    CHECK(animator.getClipFrame(1) == -1);
+    CHECK(animator.play(1, 1));
+
+    std::cout << "✅ Stop and slot test passed!" << std::endl;
+    return true;
+}
+
+bool testThroughput() {
+    std::cout << "Testing update throughput..." << std::endl;
+
+    SpriteAnimator animator = makeAnimator();
+    animator.defineClip(1, 1, 0, 7, 1.0f / 12.0f, AnimationPlayMode::Loop);
+    animator.defineClip(2, 1, 0, 7, 1.0f / 8.0f, AnimationPlayMode::PingPong);
+
+    const int spriteCount = 10000;
+    for (int sprite = 0; sprite < spriteCount; sprite++) {
+        animator.play((uint16_t)sprite, sprite % 2 ? 1 : 2, 0.5f + (sprite % 7) * 0.25f);
+    }
+    animator.update(0.0f);
+    CHECK(animator.getFrameChanges().size() == (size_t)spriteCount);
+
+    const int steps = 600;
+    size_t changes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < steps; i++) {
+        animator.update(1.0f / 60.0f);
+        changes += animator.getFrameChanges().size();
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "  " << spriteCount << " sprites x " << steps << " steps: " << ms << " ms ("
+              << (ms * 1000.0 / steps) << " us/step, " << changes / steps << " frame changes/step)" << std::endl;
+    CHECK(changes > 0);
+
+    std::cout << "✅ Throughput test passed!" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "SuperTerminal Sprite Animation Test" << std::endl;
+    std::cout << "===================================" << std::endl;
+
+    bool success = true;
+    success = testAtlasGrid() && success;
+    success = testLoopSequencing() && success;
+    success = testOnceAndPingPong() && success;
+    success = testLargeTimeStep() && success;
+    success = testReverseRestartAndRedefine() && success;
+    success = testStopAndSlots() && success;
+    success = testThroughput() && success;
+
+    std::cout << (success ? "All sprite animation tests passed" : "Sprite animation tests FAILED") << std::endl;
+    return success ? 0 : 1;
+}
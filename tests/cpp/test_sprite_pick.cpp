@@ -0,0 +1,348 @@
+//
+//  test_sprite_pick.cpp
+//  SuperTerminal Framework - Sprite Picking Test
+//
+//  Headless checks for SpritePickIndex: z-ordered point picks, rotated
+//  quads, rectangle queries, incremental moves across grid cells against a
+//  brute-force scan, pixel-accurate refinement through alpha masks and atlas
+//  UVs, plus query and update cost with thousands of sprites
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "src/SpritePickIndex.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cout << "ERROR: " << #cond << " (line " << __LINE__ << ")" << std::endl; \
+            return false; \
+        } \
+    } while (0)
+
+static SpritePickShape box(float x, float y, float width, float height, float rotation = 0.0f) {
+    SpritePickShape shape;
+    shape.x = x;
+    shape.y = y;
+    shape.halfWidth = width * 0.5f;
+    shape.halfHeight = height * 0.5f;
+    shape.rotation = rotation;
+    return shape;
+}
+
+struct Reference {
+    uint32_t id;
+    SpritePickShape shape;
+    uint32_t z;
+};
+
+// Linear scan over unrotated boxes, topmost first; what scripts did in Lua
+static std::vector<uint32_t> scanPoint(const std::vector<Reference>& sprites, float x, float y) {
+    std::vector<const Reference*> hits;
+    for (const Reference& sprite : sprites) {
+        if (std::fabs(x - sprite.shape.x) <= sprite.shape.halfWidth &&
+            std::fabs(y - sprite.shape.y) <= sprite.shape.halfHeight) {
+            hits.push_back(&sprite);
+        }
+    }
+    std::sort(hits.begin(), hits.end(), [](const Reference* a, const Reference* b) { return a->z > b->z; });
+    std::vector<uint32_t> ids;
+    for (const Reference* hit : hits) ids.push_back(hit->id);
+    return ids;
+}
+
+static std::vector<uint32_t> scanRect(const std::vector<Reference>& sprites, float x, float y, float w, float h) {
+    std::vector<const Reference*> hits;
+    for (const Reference& sprite : sprites) {
+        const SpritePickShape& s = sprite.shape;
+        if (s.x + s.halfWidth >= x && s.x - s.halfWidth <= x + w &&
+            s.y + s.halfHeight >= y && s.y - s.halfHeight <= y + h) {
+            hits.push_back(&sprite);
+        }
+    }
+    std::sort(hits.begin(), hits.end(), [](const Reference* a, const Reference* b) { return a->z > b->z; });
+    std::vector<uint32_t> ids;
+    for (const Reference* hit : hits) ids.push_back(hit->id);
+    return ids;
+}
+
+bool testPointAndZOrder() {
+    std::cout << "Testing point picks and z order..." << std::endl;
+
+    SpritePickIndex index;
+    index.update(1, box(100, 100, 64, 64), 1);
+    index.update(2, box(120, 110, 64, 64), 2);
+    index.update(3, box(500, 400, 32, 32), 3);
+    CHECK(index.getCount() == 3);
+
+    CHECK(index.topmostAt(110, 105, false) == 2);
+    CHECK(index.topmostAt(75, 75, false) == 1);
+    CHECK(index.topmostAt(300, 300, false) == 0);
+    CHECK(index.topmostAt(500, 400, false) == 3);
+
+    std::vector<uint32_t> hits;
+    CHECK(index.queryPoint(110, 105, hits, false) == 2);
+    CHECK(hits.size() == 2 && hits[0] == 2 && hits[1] == 1);
+
+    // Re-showing a sprite gives it a higher order key and brings it forward
+    index.update(1, box(100, 100, 64, 64), 4);
+    CHECK(index.topmostAt(110, 105, false) == 1);
+
+    // Edges are inclusive, one step outside misses
+    CHECK(index.hitTest(3, 516, 416, false));
+    CHECK(!index.hitTest(3, 516.5f, 400, false));
+
+    index.remove(1);
+    CHECK(index.topmostAt(110, 105, false) == 2);
+    CHECK(!index.contains(1));
+    index.remove(1);    // Removing twice is harmless
+
+    // Off-screen sprites are still pickable at their real position only
+    index.update(5, box(-200, -200, 50, 50), 5);
+    CHECK(index.topmostAt(-200, -200, false) == 5);
+    CHECK(index.topmostAt(10, 10, false) == 0);
+
+    index.clear();
+    CHECK(index.getCount() == 0);
+    CHECK(index.topmostAt(120, 110, false) == 0);
+
+    std::cout << "✅ Point pick test passed!" << std::endl;
+    return true;
+}
+
+bool testRotation() {
+    std::cout << "Testing rotated sprites..." << std::endl;
+
+    const float quarterTurn = 0.78539816f;
+    SpritePickIndex index;
+    index.update(1, box(300, 300, 100, 100, quarterTurn), 1);
+
+    // A diamond: tips reach ~70.7 along the axes, corners of the bounds miss
+    CHECK(index.hitTest(1, 300, 300, false));
+    CHECK(index.hitTest(1, 368, 300, false));
+    CHECK(index.hitTest(1, 300, 232, false));
+    CHECK(!index.hitTest(1, 360, 360, false));
+    CHECK(!index.hitTest(1, 245, 245, false));
+
+    // A long thin bar turned upright
+    index.update(2, box(600, 300, 200, 10, 2.0f * quarterTurn), 2);
+    CHECK(index.hitTest(2, 600, 390, false));
+    CHECK(!index.hitTest(2, 690, 300, false));
+
+    // Rectangle in the empty corner of the diamond's bounds misses it;
+    // one touching the tip hits
+    std::vector<uint32_t> hits;
+    CHECK(index.queryRect(350, 350, 15, 15, hits) == 0);
+    CHECK(index.queryRect(365, 295, 20, 10, hits) == 1 && hits[0] == 1);
+
+    // Negative sizes select the same area
+    hits.clear();
+    CHECK(index.queryRect(385, 305, -20, -10, hits) == 1 && hits[0] == 1);
+
+    std::cout << "✅ Rotation test passed!" << std::endl;
+    return true;
+}
+
+bool testIncrementalMoves() {
+    std::cout << "Testing incremental moves against a linear scan..." << std::endl;
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> px(-50.0f, 1074.0f);
+    std::uniform_real_distribution<float> py(-50.0f, 818.0f);
+    std::uniform_real_distribution<float> size(4.0f, 180.0f);
+    std::uniform_real_distribution<float> step(-40.0f, 40.0f);
+
+    SpritePickIndex index(1024.0f, 768.0f, 48.0f);
+    std::vector<Reference> sprites;
+    for (uint32_t id = 1; id <= 400; id++) {
+        Reference sprite = {id, box(px(rng), py(rng), size(rng), size(rng)), id};
+        sprites.push_back(sprite);
+        index.update(sprite.id, sprite.shape, sprite.z);
+    }
+
+    for (int frame = 0; frame < 50; frame++) {
+        for (Reference& sprite : sprites) {
+            sprite.shape.x += step(rng);
+            sprite.shape.y += step(rng);
+            if (frame % 10 == 0) {
+                sprite.shape.halfWidth = size(rng) * 0.5f;
+            }
+            index.update(sprite.id, sprite.shape, sprite.z);
+        }
+        // Hide and re-show a few so removal and re-insertion stay coherent
+        if (frame % 7 == 0) {
+            Reference hidden = sprites.back();
+            sprites.pop_back();
+            index.remove(hidden.id);
+            hidden.z = 1000 + frame;
+            sprites.insert(sprites.begin(), hidden);
+            index.update(hidden.id, hidden.shape, hidden.z);
+        }
+
+        for (int q = 0; q < 40; q++) {
+            float x = px(rng), y = py(rng);
+            std::vector<uint32_t> hits;
+            index.queryPoint(x, y, hits, false);
+            CHECK(hits == scanPoint(sprites, x, y));
+            uint32_t top = index.topmostAt(x, y, false);
+            CHECK(top == (hits.empty() ? 0 : hits[0]));
+
+            float w = size(rng), h = size(rng);
+            std::vector<uint32_t> inRect;
+            index.queryRect(x, y, w, h, inRect);
+            CHECK(inRect == scanRect(sprites, x, y, w, h));
+        }
+    }
+    CHECK(index.getCount() == sprites.size());
+
+    std::cout << "✅ Incremental move test passed!" << std::endl;
+    return true;
+}
+
+bool testPixelAccurate() {
+    std::cout << "Testing pixel-accurate refinement..." << std::endl;
+
+    // 4x2 texture: left column pair transparent, right pair opaque on the
+    // top row only
+    const int width = 4, height = 2;
+    std::vector<uint8_t> rgba(width * height * 4, 255);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            bool opaque = x >= 2 && y == 0;
+            rgba[(y * width + x) * 4 + 3] = opaque ? 255 : 0;
+        }
+    }
+    auto mask = SpriteAlphaMask::fromRGBA(rgba.data(), width, height);
+    CHECK(mask && mask->getWidth() == 4 && mask->getHeight() == 2);
+    CHECK(mask->isOpaque(2, 0) && mask->isOpaque(3, 0));
+    CHECK(!mask->isOpaque(0, 0) && !mask->isOpaque(3, 1));
+    CHECK(!mask->isOpaque(4, 0) && !mask->isOpaque(-1, 0));
+
+    // Drawn at 40x20 centred on (100, 100). The quad maps v = 0 to its +y
+    // edge, so texture row 0 covers y in [100, 110].
+    SpritePickIndex index;
+    index.update(7, box(100, 100, 40, 20), 1);
+    CHECK(index.hitTest(7, 85, 95, false));
+    CHECK(index.hitTest(7, 85, 95, true));      // No mask: the whole quad counts
+    index.setMask(7, mask);
+    CHECK(!index.hitTest(7, 85, 95, true));
+    CHECK(!index.hitTest(7, 110, 95, true));
+    CHECK(index.hitTest(7, 110, 105, true));
+    CHECK(!index.hitTest(7, 90, 105, true));
+    CHECK(index.hitTest(7, 90, 105, false));
+
+    // The topmost opaque sprite wins; a transparent one on top is skipped
+    index.update(8, box(100, 100, 40, 20), 2);
+    CHECK(index.topmostAt(110, 105, false) == 8);
+    index.setMask(8, SpriteAlphaMask::fromRGBA(std::vector<uint8_t>(width * height * 4, 0).data(), width, height));
+    CHECK(index.topmostAt(110, 105, true) == 7);
+    CHECK(index.topmostAt(90, 105, true) == 0);
+
+    // Atlas frame: show only the right half of the texture
+    SpritePickShape frame = box(300, 300, 20, 20);
+    frame.u0 = 0.5f;
+    frame.uSize = 0.5f;
+    index.update(9, frame, 3);
+    index.setMask(9, mask);
+    CHECK(index.hitTest(9, 292, 305, true));
+    CHECK(!index.hitTest(9, 292, 295, true));
+
+    // Masks survive hide/show and go away when cleared
+    index.remove(9);
+    index.update(9, frame, 4);
+    CHECK(!index.hitTest(9, 292, 295, true));
+    index.setMask(9, nullptr);
+    CHECK(index.hitTest(9, 292, 295, true));
+
+    std::cout << "✅ Pixel-accurate test passed!" << std::endl;
+    return true;
+}
+
+bool testQueryCost() {
+    std::cout << "Testing query cost with thousands of sprites..." << std::endl;
+
+    const int spriteCount = 5000;
+    const int queries = 20000;
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> px(0.0f, 1024.0f);
+    std::uniform_real_distribution<float> py(0.0f, 768.0f);
+    std::uniform_real_distribution<float> size(8.0f, 48.0f);
+    std::uniform_real_distribution<float> step(-3.0f, 3.0f);
+
+    SpritePickIndex index;
+    std::vector<Reference> sprites;
+    for (uint32_t id = 1; id <= (uint32_t)spriteCount; id++) {
+        Reference sprite = {id, box(px(rng), py(rng), size(rng), size(rng)), id};
+        sprites.push_back(sprite);
+        index.update(sprite.id, sprite.shape, sprite.z);
+    }
+
+    std::vector<std::pair<float, float>> points;
+    for (int i = 0; i < queries; i++) points.emplace_back(px(rng), py(rng));
+
+    uint64_t indexedHits = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& p : points) {
+        indexedHits += index.topmostAt(p.first, p.second, false);
+    }
+    double indexedUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    uint64_t scannedHits = 0;
+    start = std::chrono::steady_clock::now();
+    for (const auto& p : points) {
+        std::vector<uint32_t> ids = scanPoint(sprites, p.first, p.second);
+        scannedHits += ids.empty() ? 0 : ids[0];
+    }
+    double scanUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    CHECK(indexedHits == scannedHits);
+
+    // Every sprite moving a little each frame
+    const int frames = 60;
+    start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        for (Reference& sprite : sprites) {
+            sprite.shape.x += step(rng);
+            sprite.shape.y += step(rng);
+            index.update(sprite.id, sprite.shape, sprite.z);
+        }
+    }
+    double updateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<uint32_t> hits;
+    start = std::chrono::steady_clock::now();
+    size_t rectHits = 0;
+    for (int i = 0; i < 1000; i++) {
+        hits.clear();
+        rectHits += index.queryRect(px(rng), py(rng), 64.0f, 64.0f, hits);
+    }
+    double rectUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    CHECK(rectHits > 0);
+
+    std::cout << "  " << spriteCount << " sprites, topmost pick: " << indexedUs / queries << " us/query (linear scan "
+              << scanUs / queries << " us/query)" << std::endl;
+    std::cout << "  64x64 rect query: " << rectUs / 1000 << " us/query" << std::endl;
+    std::cout << "  moving all sprites: " << updateMs / frames << " ms/frame" << std::endl;
+
+    std::cout << "✅ Query cost test passed!" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "SuperTerminal Sprite Pick Test" << std::endl;
+    std::cout << "==============================" << std::endl;
+
+    bool success = true;
+    success = testPointAndZOrder() && success;
+    success = testRotation() && success;
+    success = testIncrementalMoves() && success;
+    success = testPixelAccurate() && success;
+    success = testQueryCost() && success;
+
+    std::cout << (success ? "All sprite pick tests passed" : "Sprite pick tests FAILED") << std::endl;
+    return success ? 0 : 1;
+}
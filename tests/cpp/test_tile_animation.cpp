@@ -0,0 +1,169 @@
+//
+//  test_tile_animation.cpp
+//  SuperTerminal Framework - Animated Tile Test
+//
+//  Headless checks for TileAnimator: frames follow their timings on the
+//  global clock, per-frame durations and pause work, removing an animation
+//  restores the base tile, invalid definitions are rejected, and the remap
+//  table only changes (and only costs work) at frame boundaries. A simulated
+//  viewport full of animated cells shows the per-frame cost depends on the
+//  number of animated tile types, not on the number of cells.
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "src/TileAnimation.h"
+#include <iostream>
+#include <vector>
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cout << "ERROR: " << #cond << " (line " << __LINE__ << ")" << std::endl; \
+            return false; \
+        } \
+    } while (0)
+
+static const uint16_t WATER = 10;
+static const uint16_t LAVA = 20;
+
+bool testTimings() {
+    std::cout << "Testing frame timings..." << std::endl;
+
+    TileAnimator animator;
+    CHECK(animator.resolve(WATER) == WATER);
+    CHECK(animator.define(WATER, {11, 12, 13}, 0.25f));
+    animator.update(100.0);     // First reading only sets the clock origin
+    CHECK(animator.resolve(WATER) == 11);
+    CHECK(animator.resolve(11) == 11);
+
+    animator.update(100.24);
+    CHECK(animator.resolve(WATER) == 11);
+    animator.update(100.26);
+    CHECK(animator.resolve(WATER) == 12);
+    animator.update(100.51);
+    CHECK(animator.resolve(WATER) == 13);
+    animator.update(100.76);
+    CHECK(animator.resolve(WATER) == 11);      // Wrapped
+
+    // Long middle frame: 0.25 / 1.0 / 0.25, a 1.5 s cycle
+    CHECK(animator.setFrameDuration(WATER, 1, 1.0f));
+    CHECK(!animator.setFrameDuration(WATER, 3, 1.0f));
+    CHECK(!animator.setFrameDuration(LAVA, 0, 1.0f));
+    CHECK(animator.resolve(WATER) == 12);      // t = 0.76
+    animator.update(101.2);
+    CHECK(animator.resolve(WATER) == 12);
+    animator.update(101.3);
+    CHECK(animator.resolve(WATER) == 13);
+    animator.update(101.6);
+    CHECK(animator.resolve(WATER) == 11);
+
+    std::cout << "✅ Timing test passed!" << std::endl;
+    return true;
+}
+
+bool testPauseRemoveAndValidation() {
+    std::cout << "Testing pause, remove and validation..." << std::endl;
+
+    TileAnimator animator;
+    CHECK(animator.define(LAVA, {21, 22}, 0.5f));
+    animator.update(0.0);
+    CHECK(animator.resolve(LAVA) == 21);
+
+    animator.setPaused(true);
+    animator.update(10.0);
+    CHECK(animator.resolve(LAVA) == 21);
+    CHECK(animator.getAnimationTime() == 0.0);
+    animator.setPaused(false);
+    animator.update(10.6);
+    CHECK(animator.resolve(LAVA) == 22);
+
+    // Redefining replaces the sequence
+    CHECK(animator.define(LAVA, {23}, 1.0f));
+    CHECK(animator.resolve(LAVA) == 23);
+    CHECK(animator.getCount() == 1);
+
+    CHECK(animator.define(WATER, {11, 12}, 0.5f));
+    CHECK(animator.remove(LAVA));
+    CHECK(!animator.remove(LAVA));
+    CHECK(animator.resolve(LAVA) == LAVA);
+    CHECK(animator.isAnimated(WATER) && !animator.isAnimated(LAVA));
+    animator.update(10.7);
+    CHECK(animator.resolve(WATER) == 11 || animator.resolve(WATER) == 12);
+
+    animator.clear();
+    CHECK(animator.getCount() == 0);
+    CHECK(animator.resolve(WATER) == WATER);
+
+    // Ids outside 1..MAX_TILE_ID and empty sequences are rejected
+    CHECK(!animator.define(0, {1}, 0.1f));
+    CHECK(!animator.define(TileAnimator::MAX_TILE_ID + 1, {1}, 0.1f));
+    CHECK(!animator.define(WATER, {}, 0.1f));
+    CHECK(!animator.define(WATER, {11, 0}, 0.1f));
+    CHECK(!animator.define(WATER, {11, TileAnimator::MAX_TILE_ID + 1}, 0.1f));
+    CHECK(animator.define(TileAnimator::MAX_TILE_ID, {1, TileAnimator::MAX_TILE_ID}, 0.1f));
+    CHECK(animator.resolve(TileAnimator::MAX_TILE_ID + 7) == TileAnimator::MAX_TILE_ID + 7);
+
+    std::cout << "✅ Pause, remove and validation test passed!" << std::endl;
+    return true;
+}
+
+bool testCostScalesWithTypes() {
+    std::cout << "Testing per-frame cost..." << std::endl;
+
+    // 32x24 viewport: water everywhere except a lava river and static rock
+    std::vector<uint16_t> viewport(32 * 24, WATER);
+    for (int y = 0; y < 24; y++) {
+        viewport[y * 32 + 15] = LAVA;
+        viewport[y * 32 + 0] = 1;
+    }
+
+    TileAnimator animator;
+    CHECK(animator.define(WATER, {11, 12, 13, 14}, 0.2f));
+    CHECK(animator.define(LAVA, {21, 22, 23}, 0.3f));
+    animator.update(0.0);
+
+    // 60 fps for 3 seconds, sampled just off the frame boundaries
+    size_t evaluated = 0;
+    size_t tableChanges = 0;
+    uint64_t generation = animator.getGeneration();
+    for (int frame = 1; frame <= 180; frame++) {
+        animator.update(frame / 60.0 + 0.001);
+        evaluated += animator.getLastEvaluatedCount();
+        if (animator.getGeneration() != generation) {
+            generation = animator.getGeneration();
+            tableChanges++;
+        }
+
+        // Every cell resolves through the table; the map itself never changes
+        double t = animator.getAnimationTime();
+        uint16_t water = 11 + (uint16_t)((int)(t / 0.2) % 4);
+        uint16_t lava = 21 + (uint16_t)((int)(t / 0.3) % 3);
+        for (uint16_t cell : viewport) {
+            uint16_t shown = animator.resolve(cell);
+            CHECK(shown == (cell == WATER ? water : cell == LAVA ? lava : cell));
+        }
+    }
+
+    // Water changes 15 times and lava 10 in 3 s, together every 0.6 s:
+    // 20 boundaries, each evaluating both types and nothing in between
+    std::cout << "  768 cells, 2 animated types, 180 frames: " << tableChanges
+              << " table uploads, " << evaluated << " animation evaluations" << std::endl;
+    CHECK(tableChanges == 20);
+    CHECK(evaluated == 2 * 20);
+
+    std::cout << "✅ Per-frame cost test passed!" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "SuperTerminal Animated Tile Test" << std::endl;
+    std::cout << "================================" << std::endl;
+
+    bool success = true;
+    success = testTimings() && success;
+    success = testPauseRemoveAndValidation() && success;
+    success = testCostScalesWithTypes() && success;
+
+    std::cout << (success ? "All animated tile tests passed" : "Animated tile tests FAILED") << std::endl;
+    return success ? 0 : 1;
+}
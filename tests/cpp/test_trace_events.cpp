@@ -0,0 +1,236 @@
+//
+//  test_trace_events.cpp
+//  SuperTerminal Framework - Trace Event Test
+//
+//  Headless checks for TraceRecorder: scopes, instants, counters and thread
+//  names come out as Chrome trace-event JSON, nothing is recorded while
+//  disabled, a full ring keeps the newest events, and dumps taken while
+//  several threads record never contain torn events. The overhead test holds
+//  a traced scope (and a disabled one) to a fixed per-event budget, on one
+//  thread and on four at once.
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "src/TraceEvents.h"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <time.h>
+#include <vector>
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cout << "ERROR: " << #cond << " (line " << __LINE__ << ")" << std::endl; \
+            return false; \
+        } \
+    } while (0)
+
+// Per-event budgets, generous enough for a loaded CI machine
+static const double ENABLED_BUDGET_NS = 250.0;
+static const double DISABLED_BUDGET_NS = 10.0;
+
+static size_t countOf(const std::string& text, const std::string& pattern) {
+    size_t count = 0;
+    for (size_t at = text.find(pattern); at != std::string::npos; at = text.find(pattern, at + 1)) {
+        count++;
+    }
+    return count;
+}
+
+bool testRecordAndDump() {
+    std::cout << "Testing record and dump..." << std::endl;
+
+    TraceRecorder recorder;
+    recorder.instant("test", "ignored");            // Disabled: dropped
+    CHECK(recorder.getEventCount() == 0);
+
+    recorder.setEnabled(true);
+    recorder.setThreadName("main \"test\" thread");
+    uint64_t start = TraceRecorder::now();
+    recorder.complete("audio", "block", start, start + 2500);
+    recorder.instant("lua", "script start");
+    recorder.counter("audio", "latency", 42.5);
+    std::thread worker([&]() {
+        recorder.setThreadName("worker");
+        recorder.instant("lua", "call");
+    });
+    worker.join();
+
+    CHECK(recorder.getEventCount() == 4);
+    CHECK(recorder.getThreadCount() == 2);
+
+    std::string json = recorder.toJSON();
+    CHECK(json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") == 0);
+    CHECK(json.find("\n]}\n") == json.size() - 4);
+    CHECK(json.find("\"args\":{\"name\":\"main \\\"test\\\" thread\"}") != std::string::npos);
+    CHECK(json.find("\"args\":{\"name\":\"worker\"}") != std::string::npos);
+    CHECK(json.find("{\"ph\":\"X\",\"cat\":\"audio\",\"name\":\"block\"") != std::string::npos);
+    CHECK(json.find("\"dur\":2.500") != std::string::npos);
+    CHECK(json.find("{\"ph\":\"i\",\"cat\":\"lua\",\"name\":\"script start\"") != std::string::npos);
+    CHECK(json.find("\"args\":{\"value\":42.5}") != std::string::npos);
+    CHECK(json.find("\"tid\":2") != std::string::npos);
+    CHECK(countOf(json, "\"ph\":\"M\"") == 2);
+    CHECK(countOf(json, "\n{") == 6);
+
+    recorder.setEnabled(false);
+    recorder.instant("test", "ignored");
+    CHECK(recorder.getEventCount() == 4);
+
+    recorder.clear();
+    CHECK(recorder.getEventCount() == 0);
+    CHECK(countOf(recorder.toJSON(), "\"ph\":\"i\"") == 0);
+
+    std::cout << "✅ Record and dump test passed!" << std::endl;
+    return true;
+}
+
+bool testRingKeepsNewest() {
+    std::cout << "Testing ring wrap-around..." << std::endl;
+
+    TraceRecorder recorder(6);          // Rounded up to 8
+    recorder.setEnabled(true);
+    for (int i = 0; i < 20; i++) {
+        recorder.counter("test", "n", i);
+    }
+    CHECK(recorder.getEventCount() == 8);
+    CHECK(recorder.getOverwrittenCount() == 12);
+
+    std::string json = recorder.toJSON();
+    CHECK(countOf(json, "\"ph\":\"C\"") == 8);
+    CHECK(json.find("\"value\":11}") == std::string::npos);
+    CHECK(json.find("\"value\":12}") != std::string::npos);
+    CHECK(json.find("\"value\":19}") != std::string::npos);
+
+    std::cout << "✅ Ring wrap-around test passed!" << std::endl;
+    return true;
+}
+
+bool testDumpWhileRecording() {
+    std::cout << "Testing dumps during recording..." << std::endl;
+
+    TraceRecorder recorder(1024);       // Small, so writers wrap during the dumps
+    recorder.setEnabled(true);
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; t++) {
+        writers.emplace_back([&]() {
+            uint64_t n = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                // Bursts, like an audio callback, rather than a flat-out loop
+                for (int i = 0; i < 64; i++) {
+                    uint64_t start = TraceRecorder::now();
+                    recorder.complete("work", "alpha", start, start + 1000);
+                    recorder.counter("work", "beta", (double)(n++ % 1000));
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        });
+    }
+
+    size_t events = 0;
+    for (int dump = 0; dump < 200; dump++) {
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+        std::istringstream lines(recorder.toJSON());
+        std::string line;
+        std::getline(lines, line);
+        while (std::getline(lines, line) && line != "]}") {
+            if (!line.empty() && line.back() == ',') {
+                line.pop_back();
+            }
+            // Every event is whole: an X slice with its duration or a counter
+            bool slice = line.find("\"ph\":\"X\",\"cat\":\"work\",\"name\":\"alpha\"") != std::string::npos &&
+                         line.find("\"dur\":1.000}") != std::string::npos;
+            bool counter = line.find("\"ph\":\"C\",\"cat\":\"work\",\"name\":\"beta\"") != std::string::npos &&
+                           line.find("\"args\":{\"value\":") != std::string::npos;
+            CHECK(slice || counter);
+            events++;
+        }
+    }
+    stop = true;
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    std::cout << "  200 dumps under 4 writers: " << events << " events, all intact" << std::endl;
+    CHECK(events > 0);
+
+    std::cout << "✅ Dump during recording test passed!" << std::endl;
+    return true;
+}
+
+// CPU time of the calling thread, so threads sharing a core aren't charged
+// for each other's time slices
+static double threadCpuNanoseconds() {
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+static double scopeCost(int count) {
+    double start = threadCpuNanoseconds();
+    for (int i = 0; i < count; i++) {
+        TRACE_SCOPE("bench", "scope");
+    }
+    return (threadCpuNanoseconds() - start) / count;
+}
+
+bool testOverheadBudget() {
+    std::cout << "Testing per-event overhead..." << std::endl;
+
+    const int count = 1000000;
+    TraceRecorder& recorder = TraceRecorder::instance();
+
+    recorder.setEnabled(false);
+    scopeCost(count / 10);              // Warm up
+    double disabled = scopeCost(count);
+
+    recorder.setEnabled(true);
+    scopeCost(count / 10);
+    double enabled = scopeCost(count);
+
+    // Four threads tracing at once share nothing on the recording path
+    std::atomic<double> worst{0.0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&]() {
+            scopeCost(count / 10);
+            double cost = scopeCost(count);
+            double seen = worst.load();
+            while (cost > seen && !worst.compare_exchange_weak(seen, cost)) {
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    recorder.setEnabled(false);
+    recorder.clear();
+
+    std::cout << "  Traced scope: " << enabled << " ns (4 threads: " << worst.load()
+              << " ns), disabled: " << disabled << " ns; budget " << ENABLED_BUDGET_NS
+              << " / " << DISABLED_BUDGET_NS << " ns" << std::endl;
+    CHECK(enabled < ENABLED_BUDGET_NS);
+    CHECK(worst.load() < ENABLED_BUDGET_NS);
+    CHECK(disabled < DISABLED_BUDGET_NS);
+
+    std::cout << "✅ Per-event overhead test passed!" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "SuperTerminal Trace Event Test" << std::endl;
+    std::cout << "==============================" << std::endl;
+
+    bool success = true;
+    success = testRecordAndDump() && success;
+    success = testRingKeepsNewest() && success;
+    success = testDumpWhileRecording() && success;
+    success = testOverheadBudget() && success;
+
+    std::cout << (success ? "All trace event tests passed" : "Trace event tests FAILED") << std::endl;
+    return success ? 0 : 1;
+}
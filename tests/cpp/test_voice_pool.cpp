@@ -0,0 +1,132 @@
+//
+//  test_voice_pool.cpp
+//  SuperTerminal Framework - Voice Pool Test
+//
+//  Headless checks for the sound effect voice pool: slot reuse, instance
+//  handles, oldest/quietest stealing and trigger throughput
+//  Copyright © 2024 SuperTerminal. All rights reserved.
+//
+
+#include "src/audio/VoicePool.h"
+#include <chrono>
+#include <iostream>
+#include <set>
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cout << "ERROR: " << #cond << " (line " << __LINE__ << ")" << std::endl; \
+            return false; \
+        } \
+    } while (0)
+
+bool testSlotReuse() {
+    std::cout << "Testing slot allocation and reuse..." << std::endl;
+
+    VoicePool pool(4);
+    CHECK(pool.capacity() == 4);
+
+    std::set<int> used;
+    VoiceTrigger first;
+    for (int i = 0; i < 4; i++) {
+        VoiceTrigger t = pool.trigger(1, 1.0f, 100, 500);
+        CHECK(t.slot >= 0 && t.instanceId != 0 && t.stolenInstanceId == 0);
+        used.insert(t.slot);
+        if (i == 0) first = t;
+    }
+    CHECK(used.size() == 4);
+    CHECK(pool.activeCount(100) == 4);
+    CHECK(pool.slotForInstance(first.instanceId, 100) == first.slot);
+
+    // Finished voices are reclaimed without stealing
+    CHECK(pool.activeCount(600) == 0);
+    CHECK(pool.slotForInstance(first.instanceId, 600) == -1);
+    VoiceTrigger reused = pool.trigger(2, 1.0f, 600, 500);
+    CHECK(reused.stolenInstanceId == 0);
+    CHECK(pool.getStats().steals == 0);
+
+    // A reused slot gets a new instance ID; the old handle is stale
+    VoicePool small(1);
+    VoiceTrigger a = small.trigger(1, 1.0f, 0, 10);
+    VoiceTrigger b = small.trigger(1, 1.0f, 20, 10);
+    CHECK(a.slot == b.slot && a.instanceId != b.instanceId);
+    CHECK(small.release(a.instanceId) == -1);
+    CHECK(small.release(b.instanceId) == b.slot);
+    CHECK(small.activeCount(21) == 0);
+
+    // Duration 0 plays until released
+    VoiceTrigger held = small.trigger(3, 1.0f, 0, 0);
+    CHECK(small.slotForInstance(held.instanceId, 1000000) == held.slot);
+    small.releaseAll();
+    CHECK(small.activeCount(0) == 0);
+
+    CHECK(VoicePool(0).trigger(1, 1.0f, 0, 10).slot == -1);
+    CHECK(VoicePool(1000).capacity() == VoicePool::MAX_VOICES);
+
+    std::cout << "✅ slot reuse test passed!" << std::endl;
+    return true;
+}
+
+bool testStealing() {
+    std::cout << "Testing voice stealing policies..." << std::endl;
+
+    // Oldest: the first voice started is cut off
+    VoicePool oldest(3, VoiceStealPolicy::Oldest);
+    VoiceTrigger v0 = oldest.trigger(1, 0.2f, 10, 1000);
+    oldest.trigger(2, 0.1f, 20, 1000);
+    oldest.trigger(3, 0.9f, 30, 1000);
+    VoiceTrigger s = oldest.trigger(4, 1.0f, 40, 1000);
+    CHECK(s.stolenInstanceId == v0.instanceId);
+    CHECK(s.slot == v0.slot);
+    CHECK(oldest.slotForInstance(v0.instanceId, 40) == -1);
+    CHECK(oldest.getStats().steals == 1);
+
+    // Quietest: lowest volume goes first, oldest breaks ties
+    VoicePool quietest(3, VoiceStealPolicy::Quietest);
+    quietest.trigger(1, 0.5f, 10, 1000);
+    VoiceTrigger q1 = quietest.trigger(2, 0.1f, 20, 1000);
+    VoiceTrigger q2 = quietest.trigger(3, 0.1f, 30, 1000);
+    s = quietest.trigger(4, 1.0f, 40, 1000);
+    CHECK(s.stolenInstanceId == q1.instanceId);
+    s = quietest.trigger(5, 1.0f, 50, 1000);
+    CHECK(s.stolenInstanceId == q2.instanceId);
+    CHECK(quietest.activeCount(50) == 3);
+
+    std::cout << "✅ voice stealing test passed!" << std::endl;
+    return true;
+}
+
+bool testTriggerThroughput() {
+    std::cout << "Testing trigger throughput under constant stealing..." << std::endl;
+
+    VoicePool pool(64, VoiceStealPolicy::Quietest);
+    const int triggers = 1000000;
+    auto start = std::chrono::steady_clock::now();
+    uint32_t checksum = 0;
+    for (int i = 0; i < triggers; i++) {
+        VoiceTrigger t = pool.trigger(i & 7, (float)(i % 10) / 10.0f, (uint64_t)i, 100000);
+        checksum ^= t.instanceId;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double nsPerTrigger = std::chrono::duration<double, std::nano>(elapsed).count() / triggers;
+
+    CHECK(pool.getStats().triggers == (uint64_t)triggers);
+    CHECK(pool.getStats().steals == (uint64_t)(triggers - 64));
+    std::cout << "  " << nsPerTrigger << " ns per trigger (checksum " << checksum << ")" << std::endl;
+
+    std::cout << "✅ trigger throughput test passed!" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "SuperTerminal Voice Pool Test" << std::endl;
+    std::cout << "=============================" << std::endl;
+
+    bool success = true;
+    success = testSlotReuse() && success;
+    success = testStealing() && success;
+    success = testTriggerThroughput() && success;
+
+    std::cout << (success ? "All voice pool tests passed" : "Voice pool tests FAILED") << std::endl;
+    return success ? 0 : 1;
+}